@@ -0,0 +1,112 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "DeflateOutputStream.h"
+
+// Common project headers
+#include "../crt_ext/compiler_defs.h"
+#include "../stl_ext/sstream_ext.h"
+
+// CRT headers
+#include <cerrno>
+#include <cstring>
+
+// STL headers
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace siodb::io {
+
+DeflateOutputStream::DeflateOutputStream(
+        OutputStream& out, ZlibStreamFormat format, int level, std::size_t bufferSize)
+    : OutputStreamWrapperStream(out)
+    , m_buffer(std::max(bufferSize, static_cast<std::size_t>(1)))
+{
+    std::memset(&m_zstream, 0, sizeof(m_zstream));
+    const int rc = ::deflateInit2(&m_zstream, level, Z_DEFLATED, getZlibWindowBits(format), 8,
+            Z_DEFAULT_STRATEGY);
+    if (rc != Z_OK) {
+        throw std::runtime_error(
+                stdext::concat("Can't initialize deflate compressor, zlib error ", rc));
+    }
+}
+
+DeflateOutputStream::~DeflateOutputStream()
+{
+    if (m_out) close();
+    ::deflateEnd(&m_zstream);
+}
+
+int DeflateOutputStream::close() noexcept
+{
+    int res = -1;
+    if (m_out) {
+        m_zstream.next_in = nullptr;
+        m_zstream.avail_in = 0;
+        res = deflateAndWrite(Z_FINISH);
+        m_out = nullptr;
+    } else {
+        errno = EIO;
+    }
+    return res;
+}
+
+std::ptrdiff_t DeflateOutputStream::write(const void* buffer, std::size_t size) noexcept
+{
+    if (!isValid()) {
+        errno = EIO;
+        return -1;
+    }
+
+    // zlib takes input size as uInt, so huge buffers are fed in parts
+    auto data = static_cast<const std::uint8_t*>(buffer);
+    std::size_t remaining = size;
+    while (remaining > 0) {
+        const auto n = std::min(
+                remaining, static_cast<std::size_t>(std::numeric_limits<uInt>::max()));
+        m_zstream.next_in = const_cast<Bytef*>(data);
+        m_zstream.avail_in = static_cast<uInt>(n);
+        if (SIODB_UNLIKELY(deflateAndWrite(Z_NO_FLUSH) != 0)) return -1;
+        data += n;
+        remaining -= n;
+    }
+    return size;
+}
+
+int DeflateOutputStream::flush() noexcept
+{
+    if (!isValid()) {
+        errno = EIO;
+        return -1;
+    }
+    m_zstream.next_in = nullptr;
+    m_zstream.avail_in = 0;
+    return deflateAndWrite(Z_SYNC_FLUSH);
+}
+
+// --- internals ---
+
+int DeflateOutputStream::deflateAndWrite(int flushMode) noexcept
+{
+    // Deflate until there is no more output, which means that all input is consumed
+    // and requested flush is completed.
+    do {
+        m_zstream.next_out = m_buffer.data();
+        m_zstream.avail_out = static_cast<uInt>(m_buffer.size());
+        if (SIODB_UNLIKELY(::deflate(&m_zstream, flushMode) == Z_STREAM_ERROR)) {
+            m_out = nullptr;
+            errno = EIO;
+            return -1;
+        }
+        const auto n = static_cast<std::ptrdiff_t>(m_buffer.size() - m_zstream.avail_out);
+        if (n > 0 && SIODB_UNLIKELY(m_out->write(m_buffer.data(), n) != n)) {
+            m_out = nullptr;
+            return -1;
+        }
+    } while (m_zstream.avail_out == 0);
+    return 0;
+}
+
+}  // namespace siodb::io
@@ -0,0 +1,105 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "OutputStreamWrapperStream.h"
+#include "ZlibStreamFormat.h"
+
+// Common project headers
+#include "../stl_ext/buffer.h"
+#include "../utils/HelperMacros.h"
+
+// zlib headers
+#include <zlib.h>
+
+namespace siodb::io {
+
+/** Output stream which compresses data with deflate and writes it to another output stream. */
+class DeflateOutputStream : public OutputStreamWrapperStream {
+public:
+    /** Default compression level, favors speed over compression ratio */
+    static constexpr int kDefaultCompressionLevel = 1;
+
+    /** Default compressed data buffer size */
+    static constexpr std::size_t kDefaultBufferSize = 16384;
+
+public:
+    /**
+     * Initializes object of class DeflateOutputStream.
+     * @param out Underlying output stream.
+     * @param format Compressed stream format.
+     * @param level Compression level 0...9.
+     * @param bufferSize Compressed data buffer size.
+     * @throw std::runtime_error if compressor initialization fails.
+     */
+    DeflateOutputStream(OutputStream& out, ZlibStreamFormat format,
+            int level = kDefaultCompressionLevel, std::size_t bufferSize = kDefaultBufferSize);
+
+    /** De-initialized object of class DeflateOutputStream */
+    ~DeflateOutputStream();
+
+    DECLARE_NONCOPYABLE(DeflateOutputStream);
+
+    /**
+     * Returns total number of uncompressed bytes written to this stream.
+     * @return Number of uncompressed bytes.
+     */
+    std::uint64_t getTotalIn() const noexcept
+    {
+        return m_zstream.total_in;
+    }
+
+    /**
+     * Returns total number of compressed bytes produced.
+     * @return Number of compressed bytes.
+     */
+    std::uint64_t getTotalOut() const noexcept
+    {
+        return m_zstream.total_out;
+    }
+
+    /**
+     * Completes compressed stream and closes this stream.
+     * Underlying stream is not closed.
+     * @return Zero on success, nonzero otherwise.
+     */
+    int close() noexcept override;
+
+    /**
+     * Compresses data and writes compressed data to the underlying stream
+     * when compressed data buffer is full.
+     * @param buffer Data buffer.
+     * @param size Data size in bytes.
+     * @return Number of written bytes. Negative value indicates error.
+     */
+    std::ptrdiff_t write(const void* buffer, std::size_t size) noexcept override;
+
+    /**
+     * Writes all pending compressed data to the underlying stream, so that
+     * the receiver can decompress everything written so far.
+     * Frequent flushes degrade compression.
+     * @return Zero on success, nonzero otherwise.
+     */
+    int flush() noexcept;
+
+private:
+    /**
+     * Runs compressor on the current input and writes produced data
+     * to the underlying stream.
+     * @param flushMode zlib flush mode.
+     * @return Zero on success, nonzero otherwise.
+     */
+    int deflateAndWrite(int flushMode) noexcept;
+
+private:
+    /** Compressor state */
+    ::z_stream m_zstream;
+
+    /** Compressed data buffer */
+    stdext::buffer<std::uint8_t> m_buffer;
+};
+
+}  // namespace siodb::io
@@ -47,7 +47,7 @@ std::ptrdiff_t DynamicMemoryOutputStream::write(const void* buffer, std::size_t
             if (r > 0) n += m_growStep - r;
             try {
                 const auto dataSize = this->size();
-                m_buffer.resize(n);
+                m_buffer.resize(m_buffer.size() + n);
                 m_current = m_buffer.data() + dataSize;
                 m_remaining = m_buffer.size() - dataSize;
             } catch (std::bad_alloc& ex) {
@@ -0,0 +1,84 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "InflateInputStream.h"
+
+// Common project headers
+#include "../crt_ext/compiler_defs.h"
+#include "../stl_ext/sstream_ext.h"
+
+// CRT headers
+#include <cerrno>
+#include <cstring>
+
+// STL headers
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace siodb::io {
+
+InflateInputStream::InflateInputStream(
+        InputStream& in, ZlibStreamFormat format, std::size_t bufferSize)
+    : InputStreamWrapperStream(in)
+    , m_buffer(std::max(bufferSize, static_cast<std::size_t>(1)))
+    , m_eof(false)
+{
+    std::memset(&m_zstream, 0, sizeof(m_zstream));
+    const int rc = ::inflateInit2(&m_zstream, getZlibWindowBits(format));
+    if (rc != Z_OK) {
+        throw std::runtime_error(
+                stdext::concat("Can't initialize inflate decompressor, zlib error ", rc));
+    }
+}
+
+InflateInputStream::~InflateInputStream()
+{
+    ::inflateEnd(&m_zstream);
+}
+
+std::ptrdiff_t InflateInputStream::read(void* buffer, std::size_t size) noexcept
+{
+    if (!isValid()) {
+        errno = EIO;
+        return -1;
+    }
+
+    if (m_eof || size == 0) return 0;
+
+    m_zstream.next_out = static_cast<Bytef*>(buffer);
+    m_zstream.avail_out = static_cast<uInt>(
+            std::min(size, static_cast<std::size_t>(std::numeric_limits<uInt>::max())));
+    const auto requested = m_zstream.avail_out;
+
+    // Return as soon as some data is available, like the other streams do
+    while (m_zstream.avail_out == requested) {
+        if (m_zstream.avail_in == 0) {
+            const auto n = m_in->read(m_buffer.data(), m_buffer.size());
+            if (SIODB_UNLIKELY(n < 1)) {
+                // Underlying stream ended before compressed stream
+                m_in = nullptr;
+                errno = EIO;
+                return -1;
+            }
+            m_zstream.next_in = m_buffer.data();
+            m_zstream.avail_in = static_cast<uInt>(n);
+        }
+
+        const int rc = ::inflate(&m_zstream, Z_NO_FLUSH);
+        if (rc == Z_STREAM_END) {
+            m_eof = true;
+            break;
+        }
+        if (SIODB_UNLIKELY(rc != Z_OK && rc != Z_BUF_ERROR)) {
+            m_in = nullptr;
+            errno = EIO;
+            return -1;
+        }
+    }
+
+    return requested - m_zstream.avail_out;
+}
+
+}  // namespace siodb::io
@@ -0,0 +1,75 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "InputStreamWrapperStream.h"
+#include "ZlibStreamFormat.h"
+
+// Common project headers
+#include "../stl_ext/buffer.h"
+#include "../utils/HelperMacros.h"
+
+// zlib headers
+#include <zlib.h>
+
+namespace siodb::io {
+
+/**
+ * Input stream which decompresses deflate stream read from another input stream.
+ * Compressed data is read ahead, so underlying stream should end where
+ * compressed stream ends, for example it can be a chunked stream.
+ */
+class InflateInputStream : public InputStreamWrapperStream {
+public:
+    /** Default compressed data buffer size */
+    static constexpr std::size_t kDefaultBufferSize = 16384;
+
+public:
+    /**
+     * Initializes object of class InflateInputStream.
+     * @param in Underlying input stream.
+     * @param format Compressed stream format.
+     * @param bufferSize Compressed data buffer size.
+     * @throw std::runtime_error if decompressor initialization fails.
+     */
+    InflateInputStream(
+            InputStream& in, ZlibStreamFormat format, std::size_t bufferSize = kDefaultBufferSize);
+
+    /** De-initialized object of class InflateInputStream */
+    ~InflateInputStream();
+
+    DECLARE_NONCOPYABLE(InflateInputStream);
+
+    /**
+     * Returns end of compressed stream flag.
+     * @return true if end of compressed stream reached, false otherwise.
+     */
+    bool isEof() const noexcept
+    {
+        return m_eof;
+    }
+
+    /**
+     * Reads and decompresses data.
+     * @param buffer Data buffer.
+     * @param size Size of data in bytes.
+     * @return Number of read bytes, zero at the end of compressed stream.
+     *         Negative value indicates error.
+     */
+    std::ptrdiff_t read(void* buffer, std::size_t size) noexcept override;
+
+private:
+    /** Decompressor state */
+    ::z_stream m_zstream;
+
+    /** Compressed data buffer */
+    stdext::buffer<std::uint8_t> m_buffer;
+
+    /** End of compressed stream flag */
+    bool m_eof;
+};
+
+}  // namespace siodb::io
@@ -12,6 +12,19 @@
 // CRT headers
 #include <cfloat>
 #include <cstdio>
+#include <cstdlib>
+
+// System headers
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif  // __SSE2__
+
+// Floating point std::to_chars() is not available in older standard libraries
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define SIODB_HAVE_FLOATING_POINT_TO_CHARS 1
+#else
+#define SIODB_HAVE_FLOATING_POINT_TO_CHARS 0
+#endif
 
 namespace siodb::io {
 
@@ -96,58 +109,60 @@ void JsonWriter::writeValue(bool value)
 
 void JsonWriter::writeValue(int value)
 {
-    char buffer[16];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%d", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    writeInteger(value);
 }
 
 void JsonWriter::writeValue(long value)
 {
-    char buffer[32];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%ld", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    writeInteger(value);
 }
 
 void JsonWriter::writeValue(long long value)
 {
-    char buffer[32];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%lld", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    writeInteger(value);
 }
 
 void JsonWriter::writeValue(unsigned int value)
 {
-    char buffer[16];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%u", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    writeInteger(value);
 }
 
 void JsonWriter::writeValue(unsigned long value)
 {
-    char buffer[32];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%lu", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    writeInteger(value);
 }
 
 void JsonWriter::writeValue(unsigned long long value)
 {
-    char buffer[32];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%llu", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    writeInteger(value);
 }
 
 void JsonWriter::writeValue(float value)
 {
-    char buffer[DBL_MANT_DIG - DBL_MIN_EXP + 20];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%.7f", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    char buffer[kMaxFloatingPointLength];
+#if SIODB_HAVE_FLOATING_POINT_TO_CHARS
+    const auto n = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer;
+#else
+    // Shortest of two precisions which is still convertible back to the same value
+    auto n = std::snprintf(buffer, sizeof(buffer), "%.*g", FLT_DIG, value);
+    if (std::strtof(buffer, nullptr) != value)
+        n = std::snprintf(buffer, sizeof(buffer), "%.*g", FLT_DECIMAL_DIG, value);
+#endif
+    writeBytes(buffer, n);
 }
 
 void JsonWriter::writeValue(double value)
 {
-    char buffer[DBL_MANT_DIG - DBL_MIN_EXP + 20];
-    const auto n = std::snprintf(buffer, sizeof(buffer), "%.16f", value);
-    if (SIODB_UNLIKELY(m_out.write(buffer, n) != n)) reportJsonWriteError();
+    char buffer[kMaxFloatingPointLength];
+#if SIODB_HAVE_FLOATING_POINT_TO_CHARS
+    const auto n = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer;
+#else
+    // Shortest of two precisions which is still convertible back to the same value
+    auto n = std::snprintf(buffer, sizeof(buffer), "%.*g", DBL_DIG, value);
+    if (std::strtod(buffer, nullptr) != value)
+        n = std::snprintf(buffer, sizeof(buffer), "%.*g", DBL_DECIMAL_DIG, value);
+#endif
+    writeBytes(buffer, n);
 }
 
 void JsonWriter::writeValue(const char* value, std::size_t length)
@@ -163,109 +178,12 @@ void JsonWriter::writeValue(const char* value, std::size_t length)
 void JsonWriter::writeRawString(const char* s, std::size_t length)
 {
     const auto end = s + length;
-    auto p = s;
-
-    char ubuffer[6];
-    ubuffer[0] = '\\';
-    ubuffer[1] = 'u';
-    ubuffer[2] = '0';
-    ubuffer[3] = '0';
-
-    while (p != end) {
-        if (p - s == kStringChunkSize) {
-            if (SIODB_UNLIKELY(m_out.write(s, kStringChunkSize) != kStringChunkSize))
-                reportJsonWriteError();
-            s = p;
-        }
-
-        const char c = *p;
-        if (static_cast<unsigned char>(c) >= static_cast<unsigned char>(' ') && c != '"'
-                && c != '\\') {
-            ++p;
-            continue;
-        }
-
-        if (p != s) {
-            const auto n = p - s;
-            if (SIODB_UNLIKELY(m_out.write(s, n) != n)) reportJsonWriteError();
-            s = p;
-        }
-
-        switch (c) {
-            case '\b': {
-                constexpr const char* kBell = "\\b";
-                constexpr auto kBellLength = ::ct_strlen(kBell);
-                if (SIODB_UNLIKELY(m_out.write(kBell, kBellLength) != kBellLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            case '\f': {
-                constexpr const char* kFormFeed = "\\f";
-                constexpr auto kFormFeedLength = ::ct_strlen(kFormFeed);
-                if (SIODB_UNLIKELY(m_out.write(kFormFeed, kFormFeedLength) != kFormFeedLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            case '\n': {
-                constexpr const char* kLineFeed = "\\n";
-                constexpr auto kLineFeedLength = ::ct_strlen(kLineFeed);
-                if (SIODB_UNLIKELY(m_out.write(kLineFeed, kLineFeedLength) != kLineFeedLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            case '\r': {
-                constexpr const char* kCarriageReturn = "\\r";
-                constexpr auto kCarriageReturnLength = ::ct_strlen(kCarriageReturn);
-                if (SIODB_UNLIKELY(m_out.write(kCarriageReturn, kCarriageReturnLength)
-                                   != kCarriageReturnLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            case '\t': {
-                constexpr const char* kHorizintalTab = "\\t";
-                constexpr auto kHorizintalTabLength = ::ct_strlen(kHorizintalTab);
-                if (SIODB_UNLIKELY(m_out.write(kHorizintalTab, kHorizintalTabLength)
-                                   != kHorizintalTabLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            case '\\': {
-                constexpr const char* kBackSlash = "\\\\";
-                constexpr auto kBackSlashLength = ::ct_strlen(kBackSlash);
-                if (SIODB_UNLIKELY(m_out.write(kBackSlash, kBackSlashLength) != kBackSlashLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            case '"': {
-                constexpr const char* kDoubleQuote = "\\\"";
-                constexpr auto kDoubleQuoteLength = ::ct_strlen(kDoubleQuote);
-                if (SIODB_UNLIKELY(
-                            m_out.write(kDoubleQuote, kDoubleQuoteLength) != kDoubleQuoteLength))
-                    reportJsonWriteError();
-                break;
-            }
-
-            default: {
-                constexpr const char* kHexCharacters = "0123456789ABCDEF";
-                ubuffer[4] = kHexCharacters[c >> 4];
-                ubuffer[5] = kHexCharacters[c & 15];
-                if (SIODB_UNLIKELY(m_out.write(ubuffer, sizeof(ubuffer)) != sizeof(ubuffer)))
-                    reportJsonWriteError();
-                break;
-            }
-        }
-        s = ++p;
-    }  // while
-
-    if (p != s) {
-        const auto n = p - s;
-        if (SIODB_UNLIKELY(m_out.write(s, n) != n)) reportJsonWriteError();
+    while (s != end) {
+        const auto p = findCharacterToEscape(s, end);
+        if (p != s) writeBytes(s, p - s);
+        if (p == end) break;
+        writeEscapedCharacter(*p);
+        s = p + 1;
     }
 }
 
@@ -277,6 +195,57 @@ void JsonWriter::writeBytes(const void* buffer, std::size_t size)
 
 // --- internals ---
 
+const char* JsonWriter::findCharacterToEscape(const char* s, const char* end) noexcept
+{
+#ifdef __SSE2__
+    // Check 16 characters at once
+    const auto doubleQuote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto maxControlCharacter = _mm_set1_epi8(0x1F);
+    for (; end - s >= 16; s += 16) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const auto isControlCharacter =
+                _mm_cmpeq_epi8(_mm_max_epu8(chunk, maxControlCharacter), maxControlCharacter);
+        const auto needsEscape = _mm_or_si128(isControlCharacter,
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, doubleQuote), _mm_cmpeq_epi8(chunk, backslash)));
+        const int mask = _mm_movemask_epi8(needsEscape);
+        if (mask != 0) return s + __builtin_ctz(mask);
+    }
+#endif  // __SSE2__
+    for (; s != end; ++s) {
+        const auto c = static_cast<unsigned char>(*s);
+        if (c < static_cast<unsigned char>(' ') || c == '"' || c == '\\') break;
+    }
+    return s;
+}
+
+void JsonWriter::writeEscapedCharacter(char c)
+{
+    char buffer[6];
+    std::size_t length = 2;
+    buffer[0] = '\\';
+    switch (c) {
+        case '\b': buffer[1] = 'b'; break;
+        case '\f': buffer[1] = 'f'; break;
+        case '\n': buffer[1] = 'n'; break;
+        case '\r': buffer[1] = 'r'; break;
+        case '\t': buffer[1] = 't'; break;
+        case '\\': buffer[1] = '\\'; break;
+        case '"': buffer[1] = '"'; break;
+        default: {
+            constexpr const char* kHexCharacters = "0123456789ABCDEF";
+            buffer[1] = 'u';
+            buffer[2] = '0';
+            buffer[3] = '0';
+            buffer[4] = kHexCharacters[(c >> 4) & 15];
+            buffer[5] = kHexCharacters[c & 15];
+            length = sizeof(buffer);
+            break;
+        }
+    }
+    writeBytes(buffer, length);
+}
+
 [[noreturn]] void JsonWriter::reportJsonWriteError()
 {
     stdext::throw_system_error(kJsonWriteError);
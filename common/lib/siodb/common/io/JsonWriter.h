@@ -14,6 +14,7 @@
 #include <cstring>
 
 // STL headers
+#include <charconv>
 #include <string>
 
 namespace siodb::io {
@@ -210,6 +211,34 @@ public:
     void writeBytes(const void* buffer, std::size_t size);
 
 private:
+    /**
+     * Writes integer value.
+     * @param value Integer value.
+     * @throw std::system_erorr on write error.
+     */
+    template<class Integer>
+    void writeInteger(Integer value)
+    {
+        char buffer[kMaxIntegerLength];
+        const auto n = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer;
+        writeBytes(buffer, n);
+    }
+
+    /**
+     * Writes escape sequence for the character.
+     * @param c A character.
+     * @throw std::system_erorr on write error.
+     */
+    void writeEscapedCharacter(char c);
+
+    /**
+     * Finds first character that must be escaped in the JSON string.
+     * @param s Beginning of the string.
+     * @param end End of the string.
+     * @return Pointer to the first character that must be escaped or end of the string.
+     */
+    static const char* findCharacterToEscape(const char* s, const char* end) noexcept;
+
     /** Reports JSON write error. */
     [[noreturn]] static void reportJsonWriteError();
 
@@ -220,8 +249,11 @@ private:
     /** Opening double quote string */
     static constexpr const char* kDoubleQuote = "\"";
 
-    /** String output chunk size */
-    static constexpr int kStringChunkSize = 4096;
+    /** Maximum length of the formatted integer value */
+    static constexpr std::size_t kMaxIntegerLength = 24;
+
+    /** Maximum length of the formatted floating point value */
+    static constexpr std::size_t kMaxFloatingPointLength = 32;
 
     /** Json write error string */
     static constexpr const char* kJsonWriteError = "JSON write error";
@@ -0,0 +1,37 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+namespace siodb::io {
+
+/** Container format of the deflate compressed stream. */
+enum class ZlibStreamFormat {
+    /** zlib format (RFC 1950) */
+    kZlib,
+
+    /** gzip format (RFC 1952) */
+    kGzip,
+
+    /** Raw deflate stream without header and trailer (RFC 1951) */
+    kRaw,
+};
+
+/**
+ * Returns zlib window bits parameter value for a given stream format.
+ * @param format Stream format.
+ * @return Window bits value.
+ */
+constexpr int getZlibWindowBits(ZlibStreamFormat format) noexcept
+{
+    // Maximum window size is 2^15
+    constexpr int kMaxWindowBits = 15;
+    switch (format) {
+        case ZlibStreamFormat::kGzip: return kMaxWindowBits + 16;
+        case ZlibStreamFormat::kRaw: return -kMaxWindowBits;
+        default: return kMaxWindowBits;
+    }
+}
+
+}  // namespace siodb::io
@@ -487,6 +487,18 @@ void SiodbOptions::load(const std::string& instanceName, const std::string& conf
         }
     }
 
+    // Parse scan thread number
+    {
+        tmpOptions.m_ioManagerOptions.m_scanThreadNumber =
+                config.get<unsigned>(constructOptionPath(kIOManagerOptionScanThreadNumber),
+                        kDefaultIOManagerScanThreadNumber);
+        if (tmpOptions.m_ioManagerOptions.m_scanThreadNumber < 1
+                || tmpOptions.m_ioManagerOptions.m_scanThreadNumber
+                           > kMaxIOManagerScanThreadNumber) {
+            throw InvalidConfigurationError("Number of IO Manager scan threads is out of range");
+        }
+    }
+
     // Parse user limit
     {
         tmpOptions.m_ioManagerOptions.m_maxUsers = config.get<unsigned>(
@@ -583,6 +595,84 @@ void SiodbOptions::load(const std::string& instanceName, const std::string& conf
         throw InvalidConfigurationError(err.str());
     }
 
+    // Parse data scrubber read rate in megabytes per second
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionDataScrubRate),
+                kDefaultIOManagerOptionDataScrubRate);
+        if (value > kMaxIOManagerOptionDataScrubRate)
+            throw InvalidConfigurationError("IO Manager data scrub rate is too big");
+        tmpOptions.m_ioManagerOptions.m_dataScrubRate = value;
+    }
+
+    // Parse data scrubber block verification interval in hours
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionDataScrubInterval),
+                kDefaultIOManagerOptionDataScrubInterval);
+        if (value < kMinIOManagerOptionDataScrubInterval)
+            throw InvalidConfigurationError("IO Manager data scrub interval is too small");
+        if (value > kMaxIOManagerOptionDataScrubInterval)
+            throw InvalidConfigurationError("IO Manager data scrub interval is too big");
+        tmpOptions.m_ioManagerOptions.m_dataScrubInterval = value;
+    }
+
+    // Parse column data block compression level
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionDataBlockCompressionLevel),
+                kDefaultIOManagerOptionDataBlockCompressionLevel);
+        if (value > kMaxIOManagerOptionDataBlockCompressionLevel)
+            throw InvalidConfigurationError("IO Manager data block compression level is too big");
+        tmpOptions.m_ioManagerOptions.m_dataBlockCompressionLevel = value;
+    }
+
+    // Parse scan prefetch size
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionScanPrefetchSize),
+                kDefaultIOManagerOptionScanPrefetchSize);
+        if (value > kMaxIOManagerOptionScanPrefetchSize)
+            throw InvalidConfigurationError("IO Manager scan prefetch size is too big");
+        tmpOptions.m_ioManagerOptions.m_scanPrefetchSize = value * kBytesInKB;
+    }
+
+    // Parse file descriptor cache capacity
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionFileDescriptorCacheCapacity),
+                kDefaultIOManagerOptionFileDescriptorCacheCapacity);
+        if (value > 0 && value < kMinIOManagerOptionFileDescriptorCacheCapacity) {
+            throw InvalidConfigurationError(
+                    "IO Manager file descriptor cache capacity is too small");
+        }
+        if (value > kMaxIOManagerOptionFileDescriptorCacheCapacity)
+            throw InvalidConfigurationError("IO Manager file descriptor cache capacity is too big");
+        tmpOptions.m_ioManagerOptions.m_fileDescriptorCacheCapacity = value;
+    }
+
+    // Parse number of spare data block files
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionSpareDataBlockFileCount),
+                kDefaultIOManagerOptionSpareDataBlockFileCount);
+        if (value > kMaxIOManagerOptionSpareDataBlockFileCount) {
+            throw InvalidConfigurationError(
+                    "IO Manager number of spare data block files is too big");
+        }
+        tmpOptions.m_ioManagerOptions.m_spareDataBlockFileCount = value;
+    }
+
+    // Parse expired row purge rate
+    {
+        const auto value = config.get<unsigned>(
+                constructOptionPath(kIOManagerOptionExpiredRowPurgeRate),
+                kDefaultIOManagerOptionExpiredRowPurgeRate);
+        if (value > kMaxIOManagerOptionExpiredRowPurgeRate)
+            throw InvalidConfigurationError("IO Manager expired row purge rate is too big");
+        tmpOptions.m_ioManagerOptions.m_expiredRowPurgeRate = value;
+    }
+
     // Encryption options
 
     // Parse default cipher ID
@@ -604,6 +694,19 @@ void SiodbOptions::load(const std::string& instanceName, const std::string& conf
             config.get<std::string>(constructOptionPath(kEncryptionOptionSystemDbCipherId),
                     tmpOptions.m_encryptionOptions.m_defaultCipherId));
 
+    // Parse transform thread number
+    {
+        tmpOptions.m_encryptionOptions.m_transformThreadNumber =
+                config.get<unsigned>(constructOptionPath(kEncryptionOptionTransformThreadNumber),
+                        kDefaultEncryptionTransformThreadNumber);
+        if (tmpOptions.m_encryptionOptions.m_transformThreadNumber < 1
+                || tmpOptions.m_encryptionOptions.m_transformThreadNumber
+                           > kMaxEncryptionTransformThreadNumber) {
+            throw InvalidConfigurationError(
+                    "Number of encryption transform threads is out of range");
+        }
+    }
+
     // Client options
     tmpOptions.m_clientOptions.m_enableEncryption =
             config.get<bool>(constructOptionPath(kClientOptionEnableEncryption),
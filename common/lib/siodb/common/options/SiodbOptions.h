@@ -49,6 +49,7 @@ constexpr const char* kIOManagerOptionIpv4RestPort = "iomgr.rest.ipv4_port";
 constexpr const char* kIOManagerOptionIpv6RestPort = "iomgr.rest.ipv6_port";
 constexpr const char* kIOManagerOptionWorkerThreadNumber = "iomgr.worker_thread_number";
 constexpr const char* kIOManagerOptionWriterThreadNumber = "iomgr.writer_thread_number";
+constexpr const char* kIOManagerOptionScanThreadNumber = "iomgr.scan_thread_number";
 constexpr const char* kIOManagerOptionMaxUsers = "iomgr.max_users";
 constexpr const char* kIOManagerOptionMaxDatabases = "iomgr.max_databases";
 constexpr const char* kIOManagerOptionMaxTablesPerDatabase = "iomgr.max_tables_per_db";
@@ -56,12 +57,24 @@ constexpr const char* kIOManagerOptionBlockCacheCapacity = "iomgr.block_cache_ca
 constexpr const char* kIOManagerOptionDeadConnectionCleanupInterval =
         "iomgr.dead_connection_cleanup_interval";
 constexpr const char* kIOManagerOptionMaxJsonPayloadSize = "iomgr.max_json_payload_size";
+constexpr const char* kIOManagerOptionDataScrubRate = "iomgr.data_scrub_rate";
+constexpr const char* kIOManagerOptionDataScrubInterval = "iomgr.data_scrub_interval";
+constexpr const char* kIOManagerOptionDataBlockCompressionLevel =
+        "iomgr.data_block_compression_level";
+constexpr const char* kIOManagerOptionScanPrefetchSize = "iomgr.scan_prefetch_size";
+constexpr const char* kIOManagerOptionFileDescriptorCacheCapacity =
+        "iomgr.file_descriptor_cache_capacity";
+constexpr const char* kIOManagerOptionSpareDataBlockFileCount =
+        "iomgr.spare_data_block_file_count";
+constexpr const char* kIOManagerOptionExpiredRowPurgeRate = "iomgr.expired_row_purge_rate";
 
 // Encryption options
 constexpr const char* kEncryptionOptionDefaultCipherId = "encryption.default_cipher_id";
 constexpr const char* kEncryptionOptionMasterCipherId = "encryption.master_cipher_id";
 constexpr const char* kEncryptionOptionMasterKey = "encryption.master_key";
 constexpr const char* kEncryptionOptionSystemDbCipherId = "encryption.system_db_cipher_id";
+constexpr const char* kEncryptionOptionTransformThreadNumber =
+        "encryption.transform_thread_number";
 
 // Client options
 constexpr const char* kClientOptionEnableEncryption = "client.enable_encryption";
@@ -117,6 +130,10 @@ constexpr bool kDefaultOptionEnableRestServer = false;
 constexpr const unsigned kDefaultIOManagerWorkerThreadNumber = 2;
 constexpr const unsigned kDefaultIOManagerWriterThreadNumber = 2;
 
+// Number of IO Manager threads scanning single table in parallel, 1 disables parallel scan
+constexpr const unsigned kMaxIOManagerScanThreadNumber = 1024;
+constexpr const unsigned kDefaultIOManagerScanThreadNumber = 1;
+
 // Default IO Manager ports
 constexpr auto kDefaultIOManagerIpv4SqlPortNumber = 50001;
 constexpr auto kDefaultIOManagerIpv6SqlPortNumber = 0;
@@ -149,9 +166,45 @@ constexpr unsigned kDefaultIOManagerOptionDeadConnectionCleanupInterval = 15;
 constexpr std::size_t kDefaultIOManagerOptionMaxJsonPayloadSize = 1024 * 1024;
 constexpr std::size_t kMaxIOManagerOptionMaxJsonPayloadSize = 1024 * 1024 * 1024;
 
+// IO Manager data scrubber read rate in megabytes per second, zero disables scrubber
+constexpr unsigned kMaxIOManagerOptionDataScrubRate = 4096;
+constexpr unsigned kDefaultIOManagerOptionDataScrubRate = 16;
+
+// IO Manager interval in hours between verifications of the same block by the data scrubber
+constexpr unsigned kMinIOManagerOptionDataScrubInterval = 1;
+constexpr unsigned kMaxIOManagerOptionDataScrubInterval = 24 * 366;
+constexpr unsigned kDefaultIOManagerOptionDataScrubInterval = 24 * 7;
+
+// IO Manager compression level of the full column data blocks, zero disables compression
+constexpr unsigned kMaxIOManagerOptionDataBlockCompressionLevel = 9;
+constexpr unsigned kDefaultIOManagerOptionDataBlockCompressionLevel = 0;
+
+// IO Manager size of the column data read ahead by table scan in kilobytes, zero disables it
+constexpr unsigned kMaxIOManagerOptionScanPrefetchSize = 1024 * 1024;
+constexpr unsigned kDefaultIOManagerOptionScanPrefetchSize = 1024;
+
+// IO Manager maximum number of open column data block and index files,
+// zero means half of the open file limit of the process
+constexpr unsigned kMinIOManagerOptionFileDescriptorCacheCapacity = 16;
+constexpr unsigned kMaxIOManagerOptionFileDescriptorCacheCapacity = 1024 * 1024;
+constexpr unsigned kDefaultIOManagerOptionFileDescriptorCacheCapacity = 0;
+
+// IO Manager number of column data block files created in advance for each column
+// which fills data blocks, zero disables creation in advance
+constexpr unsigned kMaxIOManagerOptionSpareDataBlockFileCount = 16;
+constexpr unsigned kDefaultIOManagerOptionSpareDataBlockFileCount = 1;
+
+// IO Manager number of expired rows deleted per second, zero disables purging
+constexpr unsigned kMaxIOManagerOptionExpiredRowPurgeRate = 1000 * 1000;
+constexpr unsigned kDefaultIOManagerOptionExpiredRowPurgeRate = 1000;
+
 /** Default cipher */
 constexpr const char* kDefaultCipherId = "aes128";
 
+/** Default and maximum number of threads used to encrypt or decrypt single large buffer */
+constexpr unsigned kDefaultEncryptionTransformThreadNumber = 1;
+constexpr unsigned kMaxEncryptionTransformThreadNumber = 64;
+
 /** Default client enable encryption */
 constexpr bool kDefaultClientEnableEncryption = true;
 
@@ -220,6 +273,9 @@ struct IOManagerOptions {
     /** Writer thread number */
     std::size_t m_writerThreadNumber = kDefaultIOManagerWriterThreadNumber;
 
+    /** Number of threads scanning single table in parallel */
+    std::size_t m_scanThreadNumber = kDefaultIOManagerScanThreadNumber;
+
     /** IPv4 TCP SQL port number */
     int m_ipv4SqlPort = kDefaultIOManagerIpv4SqlPortNumber;
 
@@ -249,6 +305,27 @@ struct IOManagerOptions {
 
     /** Maximum JSON payload size */
     std::size_t m_maxJsonPayloadSize = kDefaultIOManagerOptionMaxJsonPayloadSize;
+
+    /** Data scrubber read rate in megabytes per second */
+    unsigned m_dataScrubRate = kDefaultIOManagerOptionDataScrubRate;
+
+    /** Interval in hours between verifications of the same block by the data scrubber */
+    unsigned m_dataScrubInterval = kDefaultIOManagerOptionDataScrubInterval;
+
+    /** Compression level of the full column data blocks, zero disables compression */
+    unsigned m_dataBlockCompressionLevel = kDefaultIOManagerOptionDataBlockCompressionLevel;
+
+    /** Size of the column data read ahead by table scan in bytes, zero disables it */
+    std::size_t m_scanPrefetchSize = kDefaultIOManagerOptionScanPrefetchSize * 1024;
+
+    /** Maximum number of open column data block and index files, zero means automatic */
+    std::size_t m_fileDescriptorCacheCapacity = kDefaultIOManagerOptionFileDescriptorCacheCapacity;
+
+    /** Number of column data block files created in advance for each column */
+    std::size_t m_spareDataBlockFileCount = kDefaultIOManagerOptionSpareDataBlockFileCount;
+
+    /** Number of expired rows deleted per second, zero disables purging */
+    unsigned m_expiredRowPurgeRate = kDefaultIOManagerOptionExpiredRowPurgeRate;
 };
 
 /** Extenal cipher options */
@@ -271,6 +348,9 @@ struct EncryptionOptions {
     /** System database cipher ID */
     std::string m_systemDbCipherId;
 
+    /** Number of threads used to encrypt or decrypt single large buffer */
+    unsigned m_transformThreadNumber = kDefaultEncryptionTransformThreadNumber;
+
     /** Explicit master cipher key. Use this one only for unit tests. */
     BinaryValue m_masterCipherKey;
 
@@ -0,0 +1,200 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// CRT headers
+#include <cstdint>
+
+// STL headers
+#include <vector>
+
+namespace stdext {
+
+/**
+ * Fixed size bit mask with fast search of the nearest set bit.
+ * Level 0 stores bits in 64-bit words, each upper level has one bit per word
+ * of the level below, which is set if that word is not zero. Top level is a single word,
+ * so search of the next or previous set bit touches at most one word per level.
+ */
+class hierarchical_bitmask {
+public:
+    /** Value returned when bit is not found */
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    /** Initializes object of class hierarchical_bitmask. */
+    hierarchical_bitmask() noexcept
+        : m_bit_size(0)
+    {
+    }
+
+    /**
+     * Initializes object of class hierarchical_bitmask with all bits cleared.
+     * @param bit_size Size of bitmask in bits.
+     */
+    explicit hierarchical_bitmask(std::size_t bit_size)
+        : m_bit_size(bit_size)
+    {
+        std::size_t n = bit_size;
+        do {
+            n = word_count(n);
+            m_levels.emplace_back(n, 0);
+        } while (n > 1);
+    }
+
+    /**
+     * Returns size of the bitmask in bits.
+     * @return Size of the bitmask in bits.
+     */
+    std::size_t bit_size() const noexcept
+    {
+        return m_bit_size;
+    }
+
+    /**
+     * Returns indication that no bits are set.
+     * @return true if no bits are set, false otherwise.
+     */
+    bool none() const noexcept
+    {
+        return m_levels.empty() || m_levels.back().front() == 0;
+    }
+
+    /**
+     * Returns value of a specified bit.
+     * @param pos Bit position, must be less than bit size.
+     * @return Value of a specified bit.
+     */
+    bool get(std::size_t pos) const noexcept
+    {
+        return (m_levels.front()[pos / kWordBits] & bit(pos)) != 0;
+    }
+
+    /**
+     * Sets specified bit.
+     * @param pos Bit position, must be less than bit size.
+     */
+    void set(std::size_t pos) noexcept
+    {
+        for (auto& level : m_levels) {
+            auto& word = level[pos / kWordBits];
+            const bool was_empty = word == 0;
+            word |= bit(pos);
+            // Upper levels already reflect non-empty word
+            if (!was_empty) break;
+            pos /= kWordBits;
+        }
+    }
+
+    /**
+     * Clears specified bit.
+     * @param pos Bit position, must be less than bit size.
+     */
+    void reset(std::size_t pos) noexcept
+    {
+        for (auto& level : m_levels) {
+            auto& word = level[pos / kWordBits];
+            word &= ~bit(pos);
+            // Upper levels must be updated only if word became empty
+            if (word != 0) break;
+            pos /= kWordBits;
+        }
+    }
+
+    /**
+     * Finds first set bit at or after a given position.
+     * @param pos Start position.
+     * @return Position of a found bit or npos if there is no such bit.
+     */
+    std::size_t find_next(std::size_t pos) const noexcept
+    {
+        return pos < m_bit_size ? find_next(0, pos) : npos;
+    }
+
+    /**
+     * Finds last set bit at or before a given position.
+     * @param pos Start position, positions after the last bit are allowed.
+     * @return Position of a found bit or npos if there is no such bit.
+     */
+    std::size_t find_previous(std::size_t pos) const noexcept
+    {
+        if (m_bit_size == 0) return npos;
+        return find_previous(0, pos < m_bit_size ? pos : m_bit_size - 1);
+    }
+
+private:
+    /**
+     * Finds first set bit at or after a given position at a given level.
+     * @param level_index Level index.
+     * @param pos Start position at the level.
+     * @return Position of a found bit or npos if there is no such bit.
+     */
+    std::size_t find_next(std::size_t level_index, std::size_t pos) const noexcept
+    {
+        const auto& level = m_levels[level_index];
+        std::size_t word_index = pos / kWordBits;
+        if (word_index >= level.size()) return npos;
+        const auto word = level[word_index] & (~std::uint64_t(0) << (pos % kWordBits));
+        if (word != 0) return word_index * kWordBits + __builtin_ctzll(word);
+        if (level_index + 1 == m_levels.size()) return npos;
+        word_index = find_next(level_index + 1, word_index + 1);
+        if (word_index == npos) return npos;
+        return word_index * kWordBits + __builtin_ctzll(level[word_index]);
+    }
+
+    /**
+     * Finds last set bit at or before a given position at a given level.
+     * @param level_index Level index.
+     * @param pos Start position at the level.
+     * @return Position of a found bit or npos if there is no such bit.
+     */
+    std::size_t find_previous(std::size_t level_index, std::size_t pos) const noexcept
+    {
+        const auto& level = m_levels[level_index];
+        std::size_t word_index = pos / kWordBits;
+        const auto bit_index = pos % kWordBits;
+        const auto mask = bit_index == kWordBits - 1 ? ~std::uint64_t(0)
+                                                     : (std::uint64_t(1) << (bit_index + 1)) - 1;
+        const auto word = level[word_index] & mask;
+        if (word != 0) return word_index * kWordBits + kWordBits - 1 - __builtin_clzll(word);
+        if (word_index == 0 || level_index + 1 == m_levels.size()) return npos;
+        word_index = find_previous(level_index + 1, word_index - 1);
+        if (word_index == npos) return npos;
+        return word_index * kWordBits + kWordBits - 1 - __builtin_clzll(level[word_index]);
+    }
+
+    /**
+     * Returns mask of a bit within its word.
+     * @param pos Bit position.
+     * @return Bit mask.
+     */
+    static constexpr std::uint64_t bit(std::size_t pos) noexcept
+    {
+        return std::uint64_t(1) << (pos % kWordBits);
+    }
+
+    /**
+     * Returns minimal number of words that can hold specified number of bits.
+     * At least one word is always returned.
+     * @param n Number of bits.
+     * @return Number of words.
+     */
+    static constexpr std::size_t word_count(std::size_t n) noexcept
+    {
+        return n > kWordBits ? (n / kWordBits) + ((n % kWordBits != 0) ? 1 : 0) : 1;
+    }
+
+private:
+    /** Number of bits in a word */
+    static constexpr std::size_t kWordBits = 64;
+
+    /** Size in bits */
+    std::size_t m_bit_size;
+
+    /** Levels of the bitmask, level 0 stores actual bits */
+    std::vector<std::vector<std::uint64_t>> m_levels;
+};
+
+}  // namespace stdext
@@ -0,0 +1,90 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "WorkerThreadPool.h"
+
+// STL headers
+#include <algorithm>
+#include <exception>
+
+namespace siodb::utils {
+
+WorkerThreadPool::WorkerThreadPool(std::size_t threadCount)
+    : m_stopRequested(false)
+    , m_submittedTaskCount(0)
+    , m_unfinishedTaskCount(0)
+{
+    if (threadCount == 0) threadCount = std::max(1U, std::thread::hardware_concurrency());
+    m_threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        m_threads.emplace_back(&WorkerThreadPool::threadMain, this);
+}
+
+WorkerThreadPool::~WorkerThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_cond.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+std::future<void> WorkerThreadPool::submit(Task task)
+{
+    // Task is counted as finished before its future becomes ready
+    std::packaged_task<void()> packagedTask([this, task = std::move(task)] {
+        try {
+            task();
+        } catch (...) {
+            m_unfinishedTaskCount.fetch_sub(1, std::memory_order_release);
+            throw;
+        }
+        m_unfinishedTaskCount.fetch_sub(1, std::memory_order_release);
+    });
+    auto future = packagedTask.get_future();
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(packagedTask));
+        m_unfinishedTaskCount.fetch_add(1, std::memory_order_relaxed);
+        m_submittedTaskCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_cond.notify_one();
+    return future;
+}
+
+void WorkerThreadPool::runAll(std::vector<Task>& tasks)
+{
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks.size());
+    for (auto& task : tasks)
+        futures.push_back(submit(std::move(task)));
+    std::exception_ptr firstError;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!firstError) firstError = std::current_exception();
+        }
+    }
+    if (firstError) std::rethrow_exception(firstError);
+}
+
+void WorkerThreadPool::threadMain()
+{
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_cond.wait(lock, [this] { return m_stopRequested || !m_tasks.empty(); });
+            if (m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace siodb::utils
@@ -0,0 +1,111 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "HelperMacros.h"
+
+// STL headers
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace siodb::utils {
+
+/** Fixed size pool of worker threads executing submitted tasks in FIFO order. */
+class WorkerThreadPool {
+public:
+    /** Task type */
+    using Task = std::function<void()>;
+
+public:
+    /**
+     * Initializes object of class WorkerThreadPool.
+     * @param threadCount Number of worker threads. Zero means number of hardware threads.
+     */
+    explicit WorkerThreadPool(std::size_t threadCount = 0);
+
+    /** De-initializes object of class WorkerThreadPool. Waits for all pending tasks. */
+    ~WorkerThreadPool();
+
+    DECLARE_NONCOPYABLE(WorkerThreadPool);
+
+    /**
+     * Returns number of worker threads.
+     * @return Number of worker threads.
+     */
+    std::size_t getThreadCount() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    /**
+     * Returns number of tasks submitted since creation of the pool.
+     * @return Number of submitted tasks.
+     */
+    std::uint64_t getSubmittedTaskCount() const noexcept
+    {
+        return m_submittedTaskCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns number of submitted tasks which are queued or running.
+     * Task is not counted anymore by the time its future becomes ready.
+     * @return Number of unfinished tasks.
+     */
+    std::size_t getUnfinishedTaskCount() const noexcept
+    {
+        return m_unfinishedTaskCount.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Submits task for execution.
+     * @param task A task.
+     * @return Future that becomes ready when task is completed.
+     *         Exception thrown by the task is propagated via the future.
+     */
+    std::future<void> submit(Task task);
+
+    /**
+     * Executes all given tasks in the pool and waits for them to complete.
+     * If any task fails, rethrows exception of the first failed task
+     * after all tasks are completed.
+     * @param tasks Tasks to execute.
+     */
+    void runAll(std::vector<Task>& tasks);
+
+private:
+    /** Worker thread main function */
+    void threadMain();
+
+private:
+    /** Worker threads */
+    std::vector<std::thread> m_threads;
+
+    /** Pending tasks */
+    std::deque<std::packaged_task<void()>> m_tasks;
+
+    /** Task queue synchronization object */
+    std::mutex m_mutex;
+
+    /** Task availability signal */
+    std::condition_variable m_cond;
+
+    /** Stop indication */
+    bool m_stopRequested;
+
+    /** Number of tasks submitted since creation of the pool */
+    std::atomic<std::uint64_t> m_submittedTaskCount;
+
+    /** Number of queued and running tasks */
+    std::atomic<std::size_t> m_unfinishedTaskCount;
+};
+
+}  // namespace siodb::utils
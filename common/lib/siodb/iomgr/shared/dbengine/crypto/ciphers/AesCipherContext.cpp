@@ -1,37 +1,26 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
 #include "AesCipherContext.h"
 
 // Common project headers
-#include <siodb/common/utils/DebugMacros.h>
+#include <siodb/common/stl_ext/sstream_ext.h>
 
-namespace siodb::iomgr::dbengine::crypto {
-
-////////// class AesEncryptionContext ////////////////////////////////////
+// STL headers
+#include <stdexcept>
 
-void AesEncryptionContext::transform(
-        const void* in, std::size_t blockCount, void* out) const noexcept
-{
-    for (; blockCount > 0; --blockCount,
-            in = static_cast<const std::uint8_t*>(in) + m_blockSizeInBytes,
-            out = static_cast<std::uint8_t*>(out) + m_blockSizeInBytes) {
-        AES_encrypt(static_cast<const unsigned char*>(in), static_cast<unsigned char*>(out),
-                &m_preparedKey);
-    }
-}
-
-////////// class AesDecryptionContext ////////////////////////////////////
+namespace siodb::iomgr::dbengine::crypto {
 
-void AesDecryptionContext::transform(
-        const void* in, std::size_t blockCount, void* out) const noexcept
+const EVP_CIPHER* AesCipherContext::getEvpCipher(std::size_t keySize)
 {
-    for (; blockCount > 0; --blockCount,
-            in = static_cast<const std::uint8_t*>(in) + m_blockSizeInBytes,
-            out = static_cast<std::uint8_t*>(out) + m_blockSizeInBytes) {
-        AES_decrypt(static_cast<const unsigned char*>(in), static_cast<unsigned char*>(out),
-                &m_preparedKey);
+    switch (keySize) {
+        case 16: return ::EVP_aes_128_ecb();
+        case 24: return ::EVP_aes_192_ecb();
+        case 32: return ::EVP_aes_256_ecb();
+        default:
+            throw std::invalid_argument(
+                    stdext::concat("Invalid Aes key size: ", keySize * 8, " bits"));
     }
 }
 
@@ -1,78 +1,67 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
 #pragma once
 
 // Project headers
-#include "CipherContext.h"
-
-// OpenSSL headers
-#include <openssl/aes.h>
+#include "EvpCipherContext.h"
 
 namespace siodb::iomgr::dbengine::crypto {
 
-/** Base class for all AES cipher contexts */
-class AesCipherContext : public CipherContext {
+/** Base class for all Aes cipher contexts */
+class AesCipherContext : public EvpCipherContext {
 protected:
     /**
      * Initializes object of class AesCipherContext.
      * @param cipher Cipher instance.
+     * @param key A key.
+     * @param encrypt Indication of encryption context.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
      */
-    explicit AesCipherContext(ConstCipherPtr&& cipher) noexcept
-        : CipherContext(std::move(cipher))
+    AesCipherContext(ConstCipherPtr&& cipher, const BinaryValue& key, bool encrypt)
+        : EvpCipherContext(std::move(cipher), getEvpCipher(key.size()), key, encrypt)
     {
     }
 
-protected:
-    /** Prepared encryption or decryption key */
-    AES_KEY m_preparedKey;
+private:
+    /**
+     * Returns OpenSSL Aes cipher in the ECB mode for the given key size.
+     * @param keySize Key size in bytes.
+     * @return OpenSSL cipher.
+     * @throw std::invalid_argument if key size is not supported.
+     */
+    static const EVP_CIPHER* getEvpCipher(std::size_t keySize);
 };
 
-/** Encryption context for all AES ciphers */
+/** Encryption context for all Aes ciphers */
 class AesEncryptionContext : public AesCipherContext {
 public:
     /**
      * Initializes instance of class AesEncryptionContext.
      * @param cipher Cipher instance.
      * @param key A key.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
      */
-    explicit AesEncryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key) noexcept
-        : AesCipherContext(std::move(cipher))
+    AesEncryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key)
+        : AesCipherContext(std::move(cipher), key, true)
     {
-        AES_set_encrypt_key(key.data(), key.size() * 8, &m_preparedKey);
     }
-
-    /**
-     * Transforms (i.e. encrypts or decrypts) given number of blocks.
-     * @param in Input data.
-     * @param blockCount Number of data blocks to process.
-     * @param out Output buffer.
-     */
-    void transform(const void* in, std::size_t blockCount, void* out) const noexcept override final;
 };
 
-/** Decryption context for all AES ciphers */
+/** Decryption context for all Aes ciphers */
 class AesDecryptionContext : public AesCipherContext {
 public:
     /**
      * Initializes instance of class AesDecryptionContext.
      * @param cipher Cipher instance.
      * @param key A key.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
      */
-    explicit AesDecryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key) noexcept
-        : AesCipherContext(std::move(cipher))
+    AesDecryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key)
+        : AesCipherContext(std::move(cipher), key, false)
     {
-        AES_set_decrypt_key(key.data(), key.size() * 8, &m_preparedKey);
     }
-
-    /**
-     * Transforms (i.e. encrypts or decrypts) given number of blocks.
-     * @param in Input data.
-     * @param blockCount Number of data blocks to process.
-     * @param out Output buffer.
-     */
-    void transform(const void* in, std::size_t blockCount, void* out) const noexcept override final;
 };
 
 }  // namespace siodb::iomgr::dbengine::crypto
@@ -1,78 +1,67 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
 #pragma once
 
 // Project headers
-#include "CipherContext.h"
-
-// OpenSSL headers
-#include <openssl/camellia.h>
+#include "EvpCipherContext.h"
 
 namespace siodb::iomgr::dbengine::crypto {
 
 /** Base class for all Camellia cipher contexts */
-class CamelliaCipherContext : public CipherContext {
+class CamelliaCipherContext : public EvpCipherContext {
 protected:
     /**
-     * Initializes instance of class CamelliaCipherContext.
+     * Initializes object of class CamelliaCipherContext.
      * @param cipher Cipher instance.
      * @param key A key.
+     * @param encrypt Indication of encryption context.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
      */
-    explicit CamelliaCipherContext(ConstCipherPtr&& cipher, const BinaryValue& key) noexcept
-        : CipherContext(std::move(cipher))
+    CamelliaCipherContext(ConstCipherPtr&& cipher, const BinaryValue& key, bool encrypt)
+        : EvpCipherContext(std::move(cipher), getEvpCipher(key.size()), key, encrypt)
     {
-        Camellia_set_key(key.data(), key.size() * 8, &m_preparedKey);
     }
 
-protected:
-    /** Prepared encryption or decryption key */
-    CAMELLIA_KEY m_preparedKey;
+private:
+    /**
+     * Returns OpenSSL Camellia cipher in the ECB mode for the given key size.
+     * @param keySize Key size in bytes.
+     * @return OpenSSL cipher.
+     * @throw std::invalid_argument if key size is not supported.
+     */
+    static const EVP_CIPHER* getEvpCipher(std::size_t keySize);
 };
 
 /** Encryption context for all Camellia ciphers */
 class CamelliaEncryptionContext : public CamelliaCipherContext {
 public:
     /**
-     * Initializes instance of class AesEncryptionContext.
+     * Initializes instance of class CamelliaEncryptionContext.
      * @param cipher Cipher instance.
      * @param key A key.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
      */
-    explicit CamelliaEncryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key) noexcept
-        : CamelliaCipherContext(std::move(cipher), key)
+    CamelliaEncryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key)
+        : CamelliaCipherContext(std::move(cipher), key, true)
     {
     }
-
-    /**
-     * Transforms (i.e. encrypts or decrypts) given number of blocks.
-     * @param in Input data.
-     * @param blockCount Number of data blocks to process.
-     * @param out Output buffer.
-     */
-    void transform(const void* in, std::size_t blockCount, void* out) const noexcept override final;
 };
 
 /** Decryption context for all Camellia ciphers */
 class CamelliaDecryptionContext : public CamelliaCipherContext {
 public:
     /**
-     * Initializes instance of class AesDecryptionContext.
+     * Initializes instance of class CamelliaDecryptionContext.
      * @param cipher Cipher instance.
      * @param key A key.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
      */
-    explicit CamelliaDecryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key) noexcept
-        : CamelliaCipherContext(std::move(cipher), key)
+    CamelliaDecryptionContext(ConstCipherPtr&& cipher, const BinaryValue& key)
+        : CamelliaCipherContext(std::move(cipher), key, false)
     {
     }
-
-    /**
-     * Transforms (i.e. encrypts or decrypts) given number of blocks.
-     * @param in Input data.
-     * @param blockCount Number of data blocks to process.
-     * @param out Output buffer.
-     */
-    void transform(const void* in, std::size_t blockCount, void* out) const noexcept override final;
 };
 
 }  // namespace siodb::iomgr::dbengine::crypto
@@ -0,0 +1,87 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "CipherContext.h"
+
+// Common project headers
+#include <siodb/common/utils/WorkerThreadPool.h>
+
+// STL headers
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <mutex>
+
+namespace siodb::iomgr::dbengine::crypto {
+
+namespace {
+
+/** Serializes changes of the transform thread count */
+std::mutex g_transformThreadCountMutex;
+
+}  // anonymous namespace
+
+std::atomic<unsigned> CipherContext::s_maxTransformThreadCount(1);
+
+std::shared_ptr<utils::WorkerThreadPool> CipherContext::s_transformThreadPool;
+
+void CipherContext::transform(const void* in, std::size_t blockCount, void* out) const noexcept
+{
+    const auto threadPool = std::atomic_load(&s_transformThreadPool);
+    const std::size_t maxThreadCount = threadPool ? threadPool->getThreadCount() + 1 : 1;
+    const auto threadCount = std::min(maxThreadCount,
+            blockCount * m_blockSizeInBytes / kMinTransformSizePerThread);
+    if (threadCount < 2) {
+        doTransform(in, blockCount, out);
+        return;
+    }
+
+    // Blocks are independent, so each pool thread takes contiguous range of blocks.
+    // Last range is processed by the current thread. If task can't be submitted,
+    // the current thread processes remaining blocks.
+    std::array<std::future<void>, kMaxTransformThreadCount - 1> futures;
+    const auto blocksPerThread = blockCount / threadCount;
+    std::size_t submittedTaskCount = 0, offset = 0;
+    for (; submittedTaskCount < threadCount - 1; ++submittedTaskCount) {
+        try {
+            futures[submittedTaskCount] =
+                    threadPool->submit([this, in, out, offset, blocksPerThread] {
+                        doTransform(static_cast<const std::uint8_t*>(in) + offset,
+                                blocksPerThread, static_cast<std::uint8_t*>(out) + offset);
+                    });
+        } catch (std::exception&) {
+            break;
+        }
+        offset += blocksPerThread * m_blockSizeInBytes;
+    }
+
+    doTransform(static_cast<const std::uint8_t*>(in) + offset,
+            blockCount - submittedTaskCount * blocksPerThread,
+            static_cast<std::uint8_t*>(out) + offset);
+
+    for (std::size_t i = 0; i < submittedTaskCount; ++i)
+        futures[i].wait();
+}
+
+void CipherContext::setMaxTransformThreadCount(unsigned threadCount) noexcept
+{
+    threadCount = std::clamp(threadCount, 1U, kMaxTransformThreadCount);
+    std::lock_guard lock(g_transformThreadCountMutex);
+    if (threadCount == s_maxTransformThreadCount.load(std::memory_order_relaxed)) return;
+
+    // Transforms in progress keep using previous pool until they complete
+    std::shared_ptr<utils::WorkerThreadPool> threadPool;
+    if (threadCount > 1) {
+        try {
+            threadPool = std::make_shared<utils::WorkerThreadPool>(threadCount - 1);
+        } catch (std::exception&) {
+            // Fall back to the single threaded transform
+            threadCount = 1;
+        }
+    }
+    std::atomic_store(&s_transformThreadPool, std::move(threadPool));
+    s_maxTransformThreadCount.store(threadCount, std::memory_order_relaxed);
+}
+
+}  // namespace siodb::iomgr::dbengine::crypto
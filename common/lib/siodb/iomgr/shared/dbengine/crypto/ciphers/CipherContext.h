@@ -1,4 +1,4 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
@@ -7,6 +7,16 @@
 // Project headers
 #include "Cipher.h"
 
+// STL headers
+#include <atomic>
+#include <memory>
+
+namespace siodb::utils {
+
+class WorkerThreadPool;
+
+}  // namespace siodb::utils
+
 namespace siodb::iomgr::dbengine::crypto {
 
 /** Base class for all cipher contexts. */
@@ -22,6 +32,13 @@ protected:
     {
     }
 
+public:
+    /** Maximum allowed number of threads used by single transform operation */
+    static constexpr unsigned kMaxTransformThreadCount = 64;
+
+    /** Minimum data size processed by each thread of the multithreaded transform */
+    static constexpr std::size_t kMinTransformSizePerThread = 1024 * 1024;
+
 public:
     /** De-initialzes object */
     virtual ~CipherContext() = default;
@@ -46,11 +63,40 @@ public:
 
     /**
      * Transforms (i.e. encrypts or decrypts) given number of blocks.
+     * Large inputs are split between several threads, if it is allowed.
+     * Input and output buffers may be the same, but must not overlap otherwise.
+     * @param in Input data.
+     * @param blockCount Number of data blocks to process.
+     * @param out Output buffer.
+     */
+    void transform(const void* in, std::size_t blockCount, void* out) const noexcept;
+
+    /**
+     * Returns maximum number of threads used by single transform operation.
+     * @return Maximum number of threads.
+     */
+    static unsigned getMaxTransformThreadCount() noexcept
+    {
+        return s_maxTransformThreadCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets maximum number of threads used by single transform operation.
+     * Value 1 disables multithreaded transform. Otherwise, transform thread pool
+     * with one thread less is created, since the calling thread takes its share too.
+     * @param threadCount Maximum number of threads, limited to kMaxTransformThreadCount.
+     */
+    static void setMaxTransformThreadCount(unsigned threadCount) noexcept;
+
+protected:
+    /**
+     * Transforms (i.e. encrypts or decrypts) given number of blocks in the current thread.
+     * Must be safe to call concurrently from several threads.
      * @param in Input data.
      * @param blockCount Number of data blocks to process.
      * @param out Output buffer.
      */
-    virtual void transform(const void* in, std::size_t blockCount, void* out) const noexcept = 0;
+    virtual void doTransform(const void* in, std::size_t blockCount, void* out) const noexcept = 0;
 
 protected:
     /** Cipher which this context belongs to */
@@ -58,6 +104,16 @@ protected:
 
     /** Block size in bytes */
     const unsigned m_blockSizeInBytes;
+
+private:
+    /** Maximum number of threads used by single transform operation */
+    static std::atomic<unsigned> s_maxTransformThreadCount;
+
+    /**
+     * Threads used by multithreaded transform. Accessed atomically,
+     * so that it can be replaced while transforms are in progress.
+     */
+    static std::shared_ptr<utils::WorkerThreadPool> s_transformThreadPool;
 };
 
 }  // namespace siodb::iomgr::dbengine::crypto
@@ -0,0 +1,111 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "EvpCipherContext.h"
+
+// CRT headers
+#include <cassert>
+
+// STL headers
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace siodb::iomgr::dbengine::crypto {
+
+EvpCipherContext::EvpCipherContext(ConstCipherPtr&& cipher, const EVP_CIPHER* evpCipher,
+        const BinaryValue& key, bool encrypt)
+    : CipherContext(std::move(cipher))
+    , m_templateContext(::EVP_CIPHER_CTX_new())
+{
+    if (!m_templateContext) throw std::runtime_error("Can't create OpenSSL cipher context");
+    if (::EVP_CipherInit_ex(m_templateContext, evpCipher, nullptr, key.data(), nullptr,
+                encrypt ? 1 : 0)
+                    != 1
+            || ::EVP_CIPHER_CTX_set_padding(m_templateContext, 0) != 1) {
+        ::EVP_CIPHER_CTX_free(m_templateContext);
+        throw std::runtime_error("Can't initialize OpenSSL cipher context");
+    }
+}
+
+EvpCipherContext::~EvpCipherContext()
+{
+    for (auto ctx : m_idleContexts)
+        ::EVP_CIPHER_CTX_free(ctx);
+    ::EVP_CIPHER_CTX_free(m_templateContext);
+}
+
+// --- internals ---
+
+void EvpCipherContext::doTransform(
+        const void* in, std::size_t blockCount, void* out) const noexcept
+{
+    if (blockCount == 0) return;
+    const auto ctx = acquireContext();
+    if (ctx) {
+        transformWithContext(ctx, in, blockCount, out);
+        releaseContext(ctx);
+    } else {
+        std::lock_guard lock(m_templateContextMutex);
+        transformWithContext(m_templateContext, in, blockCount, out);
+    }
+}
+
+EVP_CIPHER_CTX* EvpCipherContext::acquireContext() const noexcept
+{
+    {
+        std::lock_guard lock(m_idleContextsMutex);
+        if (!m_idleContexts.empty()) {
+            const auto ctx = m_idleContexts.back();
+            m_idleContexts.pop_back();
+            return ctx;
+        }
+    }
+
+    auto ctx = ::EVP_CIPHER_CTX_new();
+    if (!ctx) return nullptr;
+    int rc;
+    {
+        std::lock_guard lock(m_templateContextMutex);
+        rc = ::EVP_CIPHER_CTX_copy(ctx, m_templateContext);
+    }
+    if (rc != 1) {
+        ::EVP_CIPHER_CTX_free(ctx);
+        ctx = nullptr;
+    }
+    return ctx;
+}
+
+void EvpCipherContext::releaseContext(EVP_CIPHER_CTX* ctx) const noexcept
+{
+    try {
+        std::lock_guard lock(m_idleContextsMutex);
+        m_idleContexts.push_back(ctx);
+    } catch (std::bad_alloc&) {
+        ::EVP_CIPHER_CTX_free(ctx);
+    }
+}
+
+void EvpCipherContext::transformWithContext(
+        EVP_CIPHER_CTX* ctx, const void* in, std::size_t blockCount, void* out) const noexcept
+{
+    // EVP takes data size as int, so huge buffers are processed in parts
+    constexpr std::size_t kMaxPartSize = std::numeric_limits<int>::max();
+    const std::size_t maxBlocksPerPart = kMaxPartSize / m_blockSizeInBytes;
+    auto src = static_cast<const unsigned char*>(in);
+    auto dest = static_cast<unsigned char*>(out);
+    while (blockCount > 0) {
+        const auto partBlockCount = std::min(blockCount, maxBlocksPerPart);
+        const int partSize = static_cast<int>(partBlockCount * m_blockSizeInBytes);
+        int outSize = 0;
+        [[maybe_unused]] const int rc =
+                ::EVP_CipherUpdate(ctx, dest, &outSize, src, partSize);
+        assert(rc == 1 && outSize == partSize);
+        src += partSize;
+        dest += partSize;
+        blockCount -= partBlockCount;
+    }
+}
+
+}  // namespace siodb::iomgr::dbengine::crypto
@@ -0,0 +1,96 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "CipherContext.h"
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+
+// STL headers
+#include <mutex>
+#include <vector>
+
+// OpenSSL headers
+#include <openssl/evp.h>
+
+namespace siodb::iomgr::dbengine::crypto {
+
+/**
+ * Base class for cipher contexts which use OpenSSL EVP interface in the ECB mode.
+ * EVP processes many blocks per call and uses hardware acceleration
+ * (like AES-NI) where it is available.
+ */
+class EvpCipherContext : public CipherContext {
+protected:
+    /**
+     * Initializes object of class EvpCipherContext.
+     * @param cipher Cipher instance.
+     * @param evpCipher OpenSSL cipher, must be in the ECB mode.
+     * @param key A key.
+     * @param encrypt Indication of encryption context.
+     * @throw std::runtime_error if OpenSSL cipher context can't be initialized.
+     */
+    EvpCipherContext(ConstCipherPtr&& cipher, const EVP_CIPHER* evpCipher,
+            const BinaryValue& key, bool encrypt);
+
+public:
+    /** De-initializes object of class EvpCipherContext */
+    ~EvpCipherContext();
+
+    DECLARE_NONCOPYABLE(EvpCipherContext);
+
+protected:
+    /**
+     * Transforms (i.e. encrypts or decrypts) given number of blocks in the current thread.
+     * @param in Input data.
+     * @param blockCount Number of data blocks to process.
+     * @param out Output buffer.
+     */
+    void doTransform(const void* in, std::size_t blockCount, void* out) const
+            noexcept override final;
+
+private:
+    /**
+     * Takes prepared OpenSSL context from the pool or creates new one.
+     * @return OpenSSL context or nullptr if it can't be created.
+     */
+    EVP_CIPHER_CTX* acquireContext() const noexcept;
+
+    /**
+     * Returns OpenSSL context to the pool.
+     * @param ctx OpenSSL context.
+     */
+    void releaseContext(EVP_CIPHER_CTX* ctx) const noexcept;
+
+    /**
+     * Transforms data using given OpenSSL context.
+     * @param ctx OpenSSL context.
+     * @param in Input data.
+     * @param blockCount Number of data blocks to process.
+     * @param out Output buffer.
+     */
+    void transformWithContext(EVP_CIPHER_CTX* ctx, const void* in, std::size_t blockCount,
+            void* out) const noexcept;
+
+private:
+    /**
+     * Initialized OpenSSL context, copied to create per-thread working contexts.
+     * Also used as the last resort if working context can't be created.
+     */
+    EVP_CIPHER_CTX* const m_templateContext;
+
+    /** Template context usage mutex */
+    mutable std::mutex m_templateContextMutex;
+
+    /** Pool of the idle working contexts */
+    mutable std::vector<EVP_CIPHER_CTX*> m_idleContexts;
+
+    /** Idle working context pool mutex */
+    mutable std::mutex m_idleContextsMutex;
+};
+
+}  // namespace siodb::iomgr::dbengine::crypto
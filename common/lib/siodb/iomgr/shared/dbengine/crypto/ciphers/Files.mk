@@ -7,7 +7,9 @@ CXX_SRC+= \
 	dbengine/crypto/ciphers/AesCipherContext.cpp \
 	dbengine/crypto/ciphers/CamelliaCipher.cpp \
 	dbengine/crypto/ciphers/CamelliaCipherContext.cpp \
-	dbengine/crypto/ciphers/Cipher.cpp
+	dbengine/crypto/ciphers/Cipher.cpp \
+	dbengine/crypto/ciphers/CipherContext.cpp \
+	dbengine/crypto/ciphers/EvpCipherContext.cpp
 
 CXX_HDR+= \
 	dbengine/crypto/ciphers/AesCipher.h \
@@ -15,4 +17,7 @@ CXX_HDR+= \
 	dbengine/crypto/ciphers/CamelliaCipher.h \
 	dbengine/crypto/ciphers/CamelliaCipherContext.h \
 	dbengine/crypto/ciphers/Cipher.h \
+	dbengine/crypto/ciphers/CipherContext.h \
+	dbengine/crypto/ciphers/CipherContextPtr.h \
+	dbengine/crypto/ciphers/EvpCipherContext.h \
 	dbengine/crypto/KeyGenerator.h
@@ -82,6 +82,8 @@ EncryptedFile::EncryptedFile(const std::string& path, int extraFlags,
 
 std::size_t EncryptedFile::read(std::uint8_t* buffer, std::size_t size, off_t offset) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return 0;
     DEBUG_TRACE("EncryptedFile::READ: buffer=" << VOID_PTR(buffer) << " size=" << size
                                                << " offset=" << offset);
 
@@ -96,6 +98,8 @@ std::size_t EncryptedFile::read(std::uint8_t* buffer, std::size_t size, off_t of
 std::size_t EncryptedFile::write(
         const std::uint8_t* buffer, std::size_t size, off_t offset) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return 0;
     DEBUG_TRACE("EncryptedFile::WRITE: buffer=" << CONST_VOID_PTR(buffer) << " size=" << size
                                                 << " offset=" << offset);
 
@@ -114,6 +118,8 @@ off_t EncryptedFile::getFileSize() noexcept
 
 bool EncryptedFile::stat(struct stat& st) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return false;
     if (::fstat(m_fd.getFD(), &st) < 0) {
         m_lastError = errno;
         return false;
@@ -124,6 +130,8 @@ bool EncryptedFile::stat(struct stat& st) noexcept
 
 bool EncryptedFile::extend(off_t length) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return false;
     DEBUG_TRACE("EncryptedFile::EXTEND: length=" << length);
 
     if (length < 0) {
@@ -149,6 +157,21 @@ bool EncryptedFile::extend(off_t length) noexcept
     return false;
 }
 
+bool EncryptedFile::prefetch(off_t offset, off_t length) noexcept
+{
+    if (offset < 0 || length < 0) {
+        m_lastError = EINVAL;
+        return false;
+    }
+
+    // Ciphertext is read by whole blocks and follows the header.
+    // Zero length means up to the end of file, same as for the raw file.
+    const auto rawOffset = utils::alignDown(offset, m_blockSize);
+    const auto rawLength =
+            (length > 0) ? utils::alignUp(offset + length, m_blockSize) - rawOffset : 0;
+    return File::prefetch(rawOffset + m_headerBuffer.size(), rawLength);
+}
+
 // --- internals ---
 
 std::size_t EncryptedFile::readInternal(
@@ -99,6 +99,16 @@ public:
      */
     bool extend(off_t length) noexcept override;
 
+    /**
+     * Advises kernel to read given range of the file in background. Range is extended
+     * to the whole cipher blocks and shifted past the encryption header.
+     * @param offset Plaintext offset.
+     * @param length Range length.
+     * @return true if operation succeeded, false otherwise. In the case of failure,
+     *         getLastError() will return an error code.
+     */
+    bool prefetch(off_t offset, off_t length) noexcept override;
+
 private:
     /**
      * Reads specified amount of data from file starting at a given offset.
@@ -16,6 +16,7 @@
 #include <system_error>
 
 // System headers
+#include <fcntl.h>
 #include <unistd.h>
 
 namespace siodb::iomgr::dbengine::io {
@@ -27,6 +28,9 @@ File::File(const std::string& path, int extraFlags, int createMode, off_t initia
                     createMode),
             path))
     , m_lastError(0)
+    , m_reopenFlags(makeReopenFlags(extraFlags))
+    , m_descriptorCache(nullptr)
+    , m_descriptorUseCount(0)
 {
     if (initialSize > 0 && ::posixFileAllocateExact(m_fd.getFD(), 0, initialSize)) {
         const int errorCode = errno;
@@ -40,9 +44,25 @@ File::File(const std::string& path, int extraFlags, int createMode, off_t initia
 File::File(const std::string& path, int extraFlags)
     : m_fd(validateFd(::open(path.c_str(), O_RDWR | O_CLOEXEC | extraFlags), path))
     , m_lastError(0)
+    , m_reopenFlags(makeReopenFlags(extraFlags))
+    , m_descriptorCache(nullptr)
+    , m_descriptorUseCount(0)
 {
 }
 
+File::~File()
+{
+    if (m_descriptorCache) m_descriptorCache->detach(*this);
+}
+
+void File::attachToDescriptorCache(FileDescriptorCache& cache, const std::string& path)
+{
+    if (m_descriptorCache) throw std::logic_error("File is already attached to descriptor cache");
+    m_path = path;
+    cache.attach(*this);
+    m_descriptorCache = &cache;
+}
+
 void File::readChecked(std::uint8_t* buffer, std::size_t size, off_t offset)
 {
     const auto n = read(buffer, size, offset);
@@ -61,8 +81,22 @@ off_t File::getRawFileSize() noexcept
     return stat(st) ? st.st_size : -1;
 }
 
+bool File::prefetch(off_t offset, off_t length) noexcept
+{
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return false;
+    // Offset and length are raw file range here, derived classes translate their offsets
+    const int errorCode = ::posix_fadvise(m_fd.getFD(), offset, length, POSIX_FADV_WILLNEED);
+    if (errorCode == 0) return true;
+    // posix_fadvise() doesn't set errno
+    m_lastError = errorCode;
+    return false;
+}
+
 bool File::flush() noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return false;
     if (::fdatasync(m_fd.getFD()) == 0) return true;
     m_lastError = errno;
     return false;
@@ -79,4 +113,10 @@ int File::validateFd(int fd, const std::string& path)
     throw std::system_error(errorCode, std::generic_category(), err.str());
 }
 
+int File::makeReopenFlags(int extraFlags) noexcept
+{
+    // Existing file is reopened, O_TMPFILE also includes O_DIRECTORY
+    return O_RDWR | O_CLOEXEC | (extraFlags & ~(O_TMPFILE | O_CREAT | O_EXCL | O_TRUNC));
+}
+
 }  // namespace siodb::iomgr::dbengine::io
@@ -4,6 +4,9 @@
 
 #pragma once
 
+// Project headers
+#include "FileDescriptorCache.h"
+
 // Common project headers
 #include <siodb/common/utils/FDGuard.h>
 #include <siodb/common/utils/HelperMacros.h>
@@ -12,6 +15,7 @@
 #include <cstdint>
 
 // STL headers
+#include <list>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -164,10 +168,11 @@ public:
     DECLARE_NONCOPYABLE(File);
 
     /** De-initializes object */
-    virtual ~File() = default;
+    virtual ~File();
 
     /**
-     * Returns file descriptor.
+     * Returns file descriptor. Descriptor of the file attached to the descriptor cache
+     * may be closed at any time, so it must not be used after attaching.
      * @return File descriptor.
      */
     int getFD() const noexcept
@@ -184,6 +189,14 @@ public:
         return m_fd.release();
     }
 
+    /**
+     * Attaches file to the descriptor cache. Since then, file descriptor may be closed
+     * while file is not accessed and is reopened on the next access.
+     * @param cache Descriptor cache.
+     * @param path Current file path, used to reopen file.
+     */
+    void attachToDescriptorCache(FileDescriptorCache& cache, const std::string& path);
+
     /**
      * Returns last error code due to which last operation has failed.
      * @return Error code.
@@ -271,6 +284,16 @@ public:
      */
     virtual bool extend(off_t length) noexcept = 0;
 
+    /**
+     * Advises kernel to read given range of the file in background, so that
+     * subsequent reads of this range don't wait for I/O.
+     * @param offset Starting offset.
+     * @param length Range length.
+     * @return true if operation succeeded, false otherwise. In the case of failure,
+     *         getLastError() will return an error code.
+     */
+    virtual bool prefetch(off_t offset, off_t length) noexcept;
+
     /**
      * Flushes pending writes to disk.
      * @return true if operation succeeded, false otherwise. In the case of failure,
@@ -278,6 +301,45 @@ public:
      */
     bool flush() noexcept;
 
+protected:
+    /** Keeps file descriptor open while file is accessed */
+    class DescriptorGuard {
+    public:
+        /**
+         * Initializes object of class DescriptorGuard.
+         * @param file File object.
+         */
+        explicit DescriptorGuard(File& file) noexcept
+            : m_file(file)
+            , m_acquired(!file.m_descriptorCache || file.m_descriptorCache->acquire(file))
+        {
+        }
+
+        /** De-initializes object of class DescriptorGuard */
+        ~DescriptorGuard()
+        {
+            if (m_acquired && m_file.m_descriptorCache) m_file.m_descriptorCache->release(m_file);
+        }
+
+        DECLARE_NONCOPYABLE(DescriptorGuard);
+
+        /**
+         * Returns indication that file descriptor is open.
+         * @return true if file descriptor is open, false if it could not be reopened.
+         */
+        explicit operator bool() const noexcept
+        {
+            return m_acquired;
+        }
+
+    private:
+        /** File object */
+        File& m_file;
+
+        /** Indication that file descriptor is open */
+        const bool m_acquired;
+    };
+
 protected:
     /**
      * Validates given file descriptor.
@@ -288,12 +350,37 @@ protected:
      */
     static int validateFd(int fd, const std::string& path);
 
+    /**
+     * Returns open flags used to reopen file.
+     * @param extraFlags Additional open flags used to open or create file.
+     * @return Open flags.
+     */
+    static int makeReopenFlags(int extraFlags) noexcept;
+
 protected:
     /** File descriptor */
     FDGuard m_fd;
 
     /** Last I/O error code */
     int m_lastError;
+
+private:
+    /** Flags used to reopen file */
+    const int m_reopenFlags;
+
+    /** Descriptor cache which manages this file, if any */
+    FileDescriptorCache* m_descriptorCache;
+
+    /** File path used to reopen file */
+    std::string m_path;
+
+    /** Number of current accesses to the file */
+    std::size_t m_descriptorUseCount;
+
+    /** Position in the descriptor cache file list */
+    std::list<File*>::iterator m_descriptorCachePos;
+
+    friend class FileDescriptorCache;
 };
 
 /** Unique pointer shortcut type */
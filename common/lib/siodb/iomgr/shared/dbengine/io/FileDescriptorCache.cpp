@@ -0,0 +1,116 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "FileDescriptorCache.h"
+
+// Project headers
+#include "File.h"
+
+// CRT headers
+#include <cerrno>
+
+// System headers
+#include <fcntl.h>
+
+namespace siodb::iomgr::dbengine::io {
+
+FileDescriptorCache::FileDescriptorCache(std::size_t capacity) noexcept
+    : m_capacity(capacity > 0 ? capacity : 1)
+{
+    m_statistics.m_capacity = m_capacity;
+}
+
+FileDescriptorCacheStatistics FileDescriptorCache::getStatistics() const
+{
+    std::lock_guard lock(m_mutex);
+    auto statistics = m_statistics;
+    statistics.m_fileCount = m_idleFiles.size() + m_busyFiles.size() + m_closedFiles.size();
+    statistics.m_openFileCount = m_idleFiles.size() + m_busyFiles.size();
+    return statistics;
+}
+
+// --- internals ---
+
+void FileDescriptorCache::attach(File& file)
+{
+    std::lock_guard lock(m_mutex);
+    if (file.m_fd.isValidFd()) {
+        m_idleFiles.push_front(&file);
+        file.m_descriptorCachePos = m_idleFiles.begin();
+        closeIdleFilesUnlocked(m_capacity);
+    } else {
+        m_closedFiles.push_front(&file);
+        file.m_descriptorCachePos = m_closedFiles.begin();
+    }
+}
+
+void FileDescriptorCache::detach(File& file) noexcept
+{
+    std::lock_guard lock(m_mutex);
+    if (!file.m_fd.isValidFd())
+        m_closedFiles.erase(file.m_descriptorCachePos);
+    else if (file.m_descriptorUseCount > 0)
+        m_busyFiles.erase(file.m_descriptorCachePos);
+    else
+        m_idleFiles.erase(file.m_descriptorCachePos);
+}
+
+bool FileDescriptorCache::acquire(File& file) noexcept
+{
+    std::lock_guard lock(m_mutex);
+    if (file.m_descriptorUseCount > 0) {
+        ++file.m_descriptorUseCount;
+        ++m_statistics.m_hitCount;
+        return true;
+    }
+
+    if (file.m_fd.isValidFd()) {
+        m_busyFiles.splice(m_busyFiles.begin(), m_idleFiles, file.m_descriptorCachePos);
+        file.m_descriptorUseCount = 1;
+        ++m_statistics.m_hitCount;
+        return true;
+    }
+
+    int fd;
+    while ((fd = ::open(file.m_path.c_str(), file.m_reopenFlags)) < 0) {
+        // Descriptor limit may be reached by descriptors not managed by this cache,
+        // give up descriptors of the idle files one by one.
+        if ((errno == EMFILE || errno == ENFILE)
+                && closeIdleFilesUnlocked(m_idleFiles.size() + m_busyFiles.size() - 1))
+            continue;
+        file.m_lastError = errno;
+        ++m_statistics.m_reopenFailureCount;
+        return false;
+    }
+
+    file.m_fd.reset(fd);
+    m_busyFiles.splice(m_busyFiles.begin(), m_closedFiles, file.m_descriptorCachePos);
+    file.m_descriptorUseCount = 1;
+    ++m_statistics.m_reopenCount;
+    closeIdleFilesUnlocked(m_capacity);
+    return true;
+}
+
+void FileDescriptorCache::release(File& file) noexcept
+{
+    std::lock_guard lock(m_mutex);
+    if (--file.m_descriptorUseCount > 0) return;
+    m_idleFiles.splice(m_idleFiles.begin(), m_busyFiles, file.m_descriptorCachePos);
+    closeIdleFilesUnlocked(m_capacity);
+}
+
+bool FileDescriptorCache::closeIdleFilesUnlocked(std::size_t maxOpenFileCount) noexcept
+{
+    bool closed = false;
+    while (!m_idleFiles.empty() && m_idleFiles.size() + m_busyFiles.size() > maxOpenFileCount) {
+        const auto it = std::prev(m_idleFiles.end());
+        (*it)->m_fd.reset();
+        m_closedFiles.splice(m_closedFiles.begin(), m_idleFiles, it);
+        ++m_statistics.m_closeCount;
+        closed = true;
+    }
+    return closed;
+}
+
+}  // namespace siodb::iomgr::dbengine::io
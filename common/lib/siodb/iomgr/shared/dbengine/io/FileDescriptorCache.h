@@ -0,0 +1,132 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+
+// CRT headers
+#include <cstdint>
+
+// STL headers
+#include <list>
+#include <mutex>
+
+namespace siodb::iomgr::dbengine::io {
+
+class File;
+
+/** File descriptor cache statistics */
+struct FileDescriptorCacheStatistics {
+    /** Maximum number of open file descriptors */
+    std::size_t m_capacity = 0;
+
+    /** Number of files attached to the cache */
+    std::size_t m_fileCount = 0;
+
+    /** Number of attached files with open descriptor */
+    std::size_t m_openFileCount = 0;
+
+    /** Number of file accesses which found descriptor open */
+    std::uint64_t m_hitCount = 0;
+
+    /** Number of file accesses which reopened descriptor */
+    std::uint64_t m_reopenCount = 0;
+
+    /** Number of failed reopens */
+    std::uint64_t m_reopenFailureCount = 0;
+
+    /** Number of descriptors closed to stay within capacity */
+    std::uint64_t m_closeCount = 0;
+};
+
+/**
+ * Limits number of file descriptors kept open by the files attached to the cache,
+ * independently of the caches of the objects which own files. Descriptors of the least
+ * recently used files are closed and transparently reopened on the next file access.
+ * Descriptor of the file which is being accessed is never closed.
+ */
+class FileDescriptorCache {
+public:
+    /**
+     * Initializes object of class FileDescriptorCache.
+     * @param capacity Maximum number of open file descriptors.
+     */
+    explicit FileDescriptorCache(std::size_t capacity) noexcept;
+
+    DECLARE_NONCOPYABLE(FileDescriptorCache);
+
+    /**
+     * Returns maximum number of open file descriptors.
+     * @return Cache capacity.
+     */
+    std::size_t getCapacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    /**
+     * Returns cache statistics.
+     * @return Cache statistics.
+     */
+    FileDescriptorCacheStatistics getStatistics() const;
+
+private:
+    /**
+     * Starts management of the file descriptor of a given file.
+     * @param file File with open descriptor.
+     */
+    void attach(File& file);
+
+    /**
+     * Stops management of the file descriptor of a given file.
+     * @param file Attached file.
+     */
+    void detach(File& file) noexcept;
+
+    /**
+     * Marks file as being accessed, reopens its descriptor if required.
+     * @param file Attached file.
+     * @return true if file descriptor is open, false if it could not be reopened.
+     *         In such case, file's last error is set.
+     */
+    bool acquire(File& file) noexcept;
+
+    /**
+     * Marks file as not being accessed anymore.
+     * @param file Attached file.
+     */
+    void release(File& file) noexcept;
+
+    /**
+     * Closes descriptors of the least recently used idle files.
+     * @param maxOpenFileCount Maximum number of open descriptors which may remain.
+     * @return true if at least one descriptor was closed, false otherwise.
+     */
+    bool closeIdleFilesUnlocked(std::size_t maxOpenFileCount) noexcept;
+
+private:
+    /** Maximum number of open file descriptors */
+    const std::size_t m_capacity;
+
+    /** Idle files with open descriptors, most recently used first */
+    std::list<File*> m_idleFiles;
+
+    /** Files which are being accessed */
+    std::list<File*> m_busyFiles;
+
+    /** Files with closed descriptors */
+    std::list<File*> m_closedFiles;
+
+    /** Statistics counters */
+    FileDescriptorCacheStatistics m_statistics;
+
+    /** Synchronization object */
+    mutable std::mutex m_mutex;
+
+    friend class File;
+};
+
+}  // namespace siodb::iomgr::dbengine::io
@@ -5,9 +5,11 @@
 CXX_SRC+= \
 	dbengine/io/EncryptedFile.cpp \
 	dbengine/io/File.cpp \
+	dbengine/io/FileDescriptorCache.cpp \
 	dbengine/io/NormalFile.cpp
 
 CXX_HDR+= \
 	dbengine/io/EncryptedFile.h \
 	dbengine/io/File.h \
+	dbengine/io/FileDescriptorCache.h \
 	dbengine/io/NormalFile.h
@@ -28,6 +28,8 @@ NormalFile::NormalFile(const std::string& path, int extraFlags)
 
 std::size_t NormalFile::read(std::uint8_t* buffer, std::size_t size, off_t offset) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return 0;
     const auto res = ::preadExact(m_fd.getFD(), buffer, size, offset, kIgnoreSignals);
     if (res != size) m_lastError = errno;
     return res;
@@ -35,6 +37,8 @@ std::size_t NormalFile::read(std::uint8_t* buffer, std::size_t size, off_t offse
 
 std::size_t NormalFile::write(const std::uint8_t* buffer, std::size_t size, off_t offset) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return 0;
     const auto res = ::pwriteExact(m_fd.getFD(), buffer, size, offset, kIgnoreSignals);
     if (res != size) m_lastError = errno;
     return res;
@@ -47,6 +51,8 @@ off_t NormalFile::getFileSize() noexcept
 
 bool NormalFile::stat(struct stat& st) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return false;
     if (::fstat(m_fd.getFD(), &st) == 0) return true;
     m_lastError = errno;
     return false;
@@ -54,6 +60,8 @@ bool NormalFile::stat(struct stat& st) noexcept
 
 bool NormalFile::extend(off_t length) noexcept
 {
+    const DescriptorGuard descriptorGuard(*this);
+    if (!descriptorGuard) return false;
     struct stat st;
     if (::fstat(m_fd.getFD(), &st) == 0
             && ::posixFileAllocateExact(m_fd.getFD(), st.st_size, length) == 0)
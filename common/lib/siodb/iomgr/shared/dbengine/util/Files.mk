@@ -3,7 +3,9 @@
 # in the LICENSE file.
 
 CXX_SRC+= \
+	dbengine/util/RecordBatchDecoder.cpp \
 	dbengine/util/RowDecoder.cpp
 
 CXX_HDR+= \
+	dbengine/util/RecordBatchDecoder.h \
 	dbengine/util/RowDecoder.h
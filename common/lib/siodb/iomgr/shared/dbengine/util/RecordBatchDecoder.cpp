@@ -0,0 +1,194 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "RecordBatchDecoder.h"
+
+// Common project headers
+#include <siodb/common/stl_ext/sstream_ext.h>
+#include <siodb/common/utils/Base128VariantEncoding.h>
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+namespace siodb::iomgr::dbengine::util {
+
+namespace {
+
+[[noreturn]] void notEnoughData(std::size_t requiredLength, std::size_t availableLength,
+        std::size_t columnIndex, ColumnDataType dataType)
+{
+    throw std::invalid_argument(stdext::concat("Not enough data (need ", requiredLength,
+            " bytes, but only only ", availableLength, " bytes available) at column index ",
+            columnIndex, ", data type ", static_cast<int>(dataType)));
+}
+
+[[noreturn]] void dataCorruption(std::size_t columnIndex, ColumnDataType dataType)
+{
+    throw std::invalid_argument(stdext::concat("Data corrupted at column index ", columnIndex,
+            ", data type ", static_cast<int>(dataType)));
+}
+
+[[noreturn]] void unsupportedDataType(std::size_t columnIndex, ColumnDataType dataType)
+{
+    throw std::invalid_argument(stdext::concat("Unsupported data type ", static_cast<int>(dataType),
+            " at column index ", columnIndex));
+}
+
+std::size_t getValueSize(ColumnDataType dataType) noexcept
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_BOOL:
+        case COLUMN_DATA_TYPE_INT8:
+        case COLUMN_DATA_TYPE_UINT8: return 1;
+        case COLUMN_DATA_TYPE_INT16:
+        case COLUMN_DATA_TYPE_UINT16: return 2;
+        case COLUMN_DATA_TYPE_INT32:
+        case COLUMN_DATA_TYPE_UINT32:
+        case COLUMN_DATA_TYPE_FLOAT: return 4;
+        case COLUMN_DATA_TYPE_INT64:
+        case COLUMN_DATA_TYPE_UINT64:
+        case COLUMN_DATA_TYPE_DOUBLE: return 8;
+        case COLUMN_DATA_TYPE_TIMESTAMP: return RawDateTime::kSerializedSize;
+        default: return 0;
+    }
+}
+
+Variant decodeFixedSizeValue(const std::uint8_t* buffer, ColumnDataType dataType)
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_BOOL: return Variant(*buffer != 0);
+        case COLUMN_DATA_TYPE_INT8: return Variant(*reinterpret_cast<const std::int8_t*>(buffer));
+        case COLUMN_DATA_TYPE_UINT8: return Variant(*buffer);
+        case COLUMN_DATA_TYPE_INT16: {
+            std::int16_t value = 0;
+            ::pbeDecodeInt16(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_UINT16: {
+            std::uint16_t value = 0;
+            ::pbeDecodeUInt16(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_INT32: {
+            std::int32_t value = 0;
+            ::pbeDecodeInt32(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_UINT32: {
+            std::uint32_t value = 0;
+            ::pbeDecodeUInt32(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_INT64: {
+            std::int64_t value = 0;
+            ::pbeDecodeInt64(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_UINT64: {
+            std::uint64_t value = 0;
+            ::pbeDecodeUInt64(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_FLOAT: {
+            float value = 0.0f;
+            ::pbeDecodeFloat(buffer, &value);
+            return Variant(value);
+        }
+        case COLUMN_DATA_TYPE_DOUBLE: {
+            double value = 0.0;
+            ::pbeDecodeDouble(buffer, &value);
+            return Variant(value);
+        }
+        default: {
+            RawDateTime value;
+            value.deserialize(buffer, RawDateTime::kSerializedSize);
+            return Variant(value);
+        }
+    }
+}
+
+}  // anonymous namespace
+
+std::vector<std::vector<Variant>> decodeRecordBatch(const std::uint8_t* buffer,
+        std::size_t length, std::size_t columnCount, const ColumnDataType* dataTypes,
+        const bool* nullableColumns)
+{
+    std::uint32_t rowCount = 0;
+    const int consumed = decodeVarUInt32(buffer, length, &rowCount);
+    if (consumed < 1) throw std::invalid_argument("Can't decode record batch row count");
+    buffer += consumed;
+    length -= consumed;
+
+    std::vector<std::vector<Variant>> result(rowCount);
+    for (auto& row : result)
+        row.resize(columnCount);
+
+    const std::size_t validitySize = (rowCount + 7) / 8;
+    for (std::size_t i = 0; i < columnCount; ++i) {
+        const auto dataType = dataTypes[i];
+        if (dataType < 0 || dataType >= COLUMN_DATA_TYPE_MAX) {
+            throw std::invalid_argument(stdext::concat(
+                    "Invalid data type ", static_cast<int>(dataType), " at column index ", i));
+        }
+
+        const std::uint8_t* validity = nullptr;
+        if (nullableColumns[i]) {
+            if (length < validitySize) notEnoughData(validitySize, length, i, dataType);
+            validity = buffer;
+            buffer += validitySize;
+            length -= validitySize;
+        }
+
+        const auto valueSize = getValueSize(dataType);
+        if (valueSize > 0) {
+            const std::size_t requiredLength = valueSize * rowCount;
+            if (length < requiredLength) notEnoughData(requiredLength, length, i, dataType);
+            for (std::size_t j = 0; j < rowCount; ++j, buffer += valueSize) {
+                if (validity && (validity[j >> 3] & (1U << (j & 7))) == 0) continue;
+                result[j][i] = decodeFixedSizeValue(buffer, dataType);
+            }
+            length -= requiredLength;
+            continue;
+        }
+
+        if (dataType != COLUMN_DATA_TYPE_TEXT && dataType != COLUMN_DATA_TYPE_BINARY)
+            unsupportedDataType(i, dataType);
+
+        const std::size_t offsetsSize = (rowCount + 1) * sizeof(std::uint32_t);
+        if (length < offsetsSize) notEnoughData(offsetsSize, length, i, dataType);
+        const auto offsets = buffer;
+        buffer += offsetsSize;
+        length -= offsetsSize;
+
+        std::uint32_t dataSize = 0;
+        ::pbeDecodeUInt32(offsets + rowCount * sizeof(std::uint32_t), &dataSize);
+        if (length < dataSize) notEnoughData(dataSize, length, i, dataType);
+
+        std::uint32_t begin = 0;
+        ::pbeDecodeUInt32(offsets, &begin);
+        for (std::size_t j = 0; j < rowCount; ++j) {
+            std::uint32_t end = 0;
+            ::pbeDecodeUInt32(offsets + (j + 1) * sizeof(std::uint32_t), &end);
+            if (end < begin || end > dataSize) dataCorruption(i, dataType);
+            if (!validity || (validity[j >> 3] & (1U << (j & 7))) != 0) {
+                if (dataType == COLUMN_DATA_TYPE_TEXT) {
+                    result[j][i] = std::string(
+                            reinterpret_cast<const char*>(buffer) + begin, end - begin);
+                } else {
+                    result[j][i] = BinaryValue(buffer + begin, buffer + end);
+                }
+            }
+            begin = end;
+        }
+        buffer += dataSize;
+        length -= dataSize;
+    }
+
+    if (length > 0) {
+        throw std::invalid_argument(
+                stdext::concat("Extra ", length, " bytes at the end of the record batch"));
+    }
+
+    return result;
+}
+
+}  // namespace siodb::iomgr::dbengine::util
@@ -0,0 +1,30 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "../Variant.h"
+
+// Common project headers
+#include <siodb/common/proto/ColumnDataType.pb.h>
+
+namespace siodb::iomgr::dbengine::util {
+
+/**
+ * Decodes single record batch of the columnar rowset from memory into series of rows.
+ * @note For use in unit tests only and as reference implementation of the data decoder.
+ * @param buffer Record batch data buffer, not including batch length.
+ * @param length Record batch data buffer length.
+ * @param columnCount Number of columns.
+ * @param dataTypes Array of column data types.
+ * @param nullableColumns Array of column nullability flags.
+ * @return Vector of rows, each containing vector of column values.
+ * @throw std::invalid_argument if there is not enough data or invalid data encountered.
+ */
+std::vector<std::vector<Variant>> decodeRecordBatch(const std::uint8_t* buffer,
+        std::size_t length, std::size_t columnCount, const ColumnDataType* dataTypes,
+        const bool* nullableColumns);
+
+}  // namespace siodb::iomgr::dbengine::util
@@ -0,0 +1,190 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Common project headers
+#include <siodb/common/io/BufferedChunkedOutputStream.h>
+#include <siodb/common/io/ChunkedInputStream.h>
+#include <siodb/common/io/DeflateOutputStream.h>
+#include <siodb/common/io/DynamicMemoryOutputStream.h>
+#include <siodb/common/io/InflateInputStream.h>
+#include <siodb/common/io/MemoryInputStream.h>
+
+// STL headers
+#include <random>
+#include <string>
+
+// Google Test
+#include <gtest/gtest.h>
+
+using namespace siodb::io;
+
+namespace {
+
+std::string makeTestData(std::size_t size)
+{
+    std::mt19937 gen(size);
+    std::uniform_int_distribution<int> dist(0, 15);
+    std::string data;
+    data.reserve(size);
+    while (data.size() < size) {
+        data += R"({"id":)";
+        data += std::to_string(data.size());
+        data += R"(,"name":"row)";
+        data += static_cast<char>('a' + dist(gen));
+        data += R"("},)";
+    }
+    data.resize(size);
+    return data;
+}
+
+std::string readAll(InputStream& in)
+{
+    std::string result;
+    char buffer[1000];
+    while (true) {
+        const auto n = in.read(buffer, sizeof(buffer));
+        EXPECT_GE(n, 0);
+        if (n <= 0) break;
+        result.append(buffer, n);
+    }
+    return result;
+}
+
+void testRoundTrip(ZlibStreamFormat format, std::size_t dataSize)
+{
+    const auto data = makeTestData(dataSize);
+    DynamicMemoryOutputStream out;
+    {
+        DeflateOutputStream deflateOutput(out, format, DeflateOutputStream::kDefaultCompressionLevel,
+                // Small buffer to exercise buffer refills
+                512);
+        // Write in pieces of different size
+        std::size_t pos = 0, step = 1;
+        while (pos < data.size()) {
+            const auto n = std::min(step, data.size() - pos);
+            ASSERT_EQ(deflateOutput.write(data.data() + pos, n), static_cast<std::ptrdiff_t>(n));
+            pos += n;
+            step = step * 3 + 1;
+        }
+        ASSERT_EQ(deflateOutput.close(), 0);
+        ASSERT_EQ(deflateOutput.getTotalIn(), data.size());
+        ASSERT_EQ(deflateOutput.getTotalOut(), out.size());
+    }
+    if (dataSize > 1000) {
+        ASSERT_LT(out.size(), data.size() / 2);
+    }
+
+    MemoryInputStream in(out.data(), out.size());
+    InflateInputStream inflateInput(in, format, 100);
+    ASSERT_EQ(readAll(inflateInput), data);
+    ASSERT_TRUE(inflateInput.isEof());
+}
+
+}  // anonymous namespace
+
+TEST(DeflateStream, RoundTripZlib)
+{
+    testRoundTrip(ZlibStreamFormat::kZlib, 0);
+    testRoundTrip(ZlibStreamFormat::kZlib, 1);
+    testRoundTrip(ZlibStreamFormat::kZlib, 100000);
+}
+
+TEST(DeflateStream, RoundTripGzip)
+{
+    testRoundTrip(ZlibStreamFormat::kGzip, 0);
+    testRoundTrip(ZlibStreamFormat::kGzip, 100000);
+
+    // Check gzip magic
+    DynamicMemoryOutputStream out;
+    DeflateOutputStream deflateOutput(out, ZlibStreamFormat::kGzip);
+    ASSERT_EQ(deflateOutput.close(), 0);
+    ASSERT_GE(out.size(), 2U);
+    ASSERT_EQ(static_cast<const std::uint8_t*>(out.data())[0], 0x1F);
+    ASSERT_EQ(static_cast<const std::uint8_t*>(out.data())[1], 0x8B);
+}
+
+TEST(DeflateStream, RoundTripRaw)
+{
+    testRoundTrip(ZlibStreamFormat::kRaw, 100000);
+}
+
+TEST(DeflateStream, Flush)
+{
+    const std::string part1 = "first part", part2 = "second part";
+    DynamicMemoryOutputStream out;
+    DeflateOutputStream deflateOutput(out, ZlibStreamFormat::kZlib);
+    ASSERT_EQ(deflateOutput.write(part1.data(), part1.size()),
+            static_cast<std::ptrdiff_t>(part1.size()));
+    ASSERT_EQ(deflateOutput.flush(), 0);
+
+    // Everything written before flush must be decompressible
+    {
+        MemoryInputStream in(out.data(), out.size());
+        InflateInputStream inflateInput(in, ZlibStreamFormat::kZlib);
+        char buffer[100];
+        ASSERT_EQ(inflateInput.read(buffer, sizeof(buffer)),
+                static_cast<std::ptrdiff_t>(part1.size()));
+        ASSERT_EQ(std::string(buffer, part1.size()), part1);
+    }
+
+    ASSERT_EQ(deflateOutput.write(part2.data(), part2.size()),
+            static_cast<std::ptrdiff_t>(part2.size()));
+    ASSERT_EQ(deflateOutput.close(), 0);
+    MemoryInputStream in(out.data(), out.size());
+    InflateInputStream inflateInput(in, ZlibStreamFormat::kZlib);
+    ASSERT_EQ(readAll(inflateInput), part1 + part2);
+}
+
+TEST(DeflateStream, OverChunkedStream)
+{
+    const auto data = makeTestData(50000);
+    DynamicMemoryOutputStream out;
+    {
+        BufferedChunkedOutputStream chunkedOutput(1000, out);
+        DeflateOutputStream deflateOutput(chunkedOutput, ZlibStreamFormat::kGzip);
+        ASSERT_EQ(deflateOutput.write(data.data(), data.size()),
+                static_cast<std::ptrdiff_t>(data.size()));
+        ASSERT_EQ(deflateOutput.close(), 0);
+        ASSERT_EQ(chunkedOutput.close(), 0);
+    }
+    // Trailing data after the chunked stream must not be consumed
+    const char kTrailer = 'X';
+    ASSERT_EQ(out.write(&kTrailer, 1), 1);
+
+    MemoryInputStream in(out.data(), out.size());
+    {
+        ChunkedInputStream chunkedInput(in);
+        InflateInputStream inflateInput(chunkedInput, ZlibStreamFormat::kGzip);
+        ASSERT_EQ(readAll(inflateInput), data);
+        // Compressed stream ends before chunk stream terminator, consume it
+        char c = 0;
+        chunkedInput.read(&c, 1);
+        ASSERT_TRUE(chunkedInput.isEof());
+    }
+    char c = 0;
+    ASSERT_EQ(in.read(&c, 1), 1);
+    ASSERT_EQ(c, kTrailer);
+}
+
+TEST(DeflateStream, CorruptedData)
+{
+    const auto data = makeTestData(10000);
+    DynamicMemoryOutputStream out;
+    {
+        DeflateOutputStream deflateOutput(out, ZlibStreamFormat::kZlib);
+        ASSERT_EQ(deflateOutput.write(data.data(), data.size()),
+                static_cast<std::ptrdiff_t>(data.size()));
+    }
+    static_cast<std::uint8_t*>(out.data())[out.size() / 2] ^= 0xFF;
+    static_cast<std::uint8_t*>(out.data())[out.size() / 2 + 1] ^= 0x55;
+
+    MemoryInputStream in(out.data(), out.size());
+    InflateInputStream inflateInput(in, ZlibStreamFormat::kZlib);
+    char buffer[1000];
+    std::ptrdiff_t n = 0;
+    do {
+        n = inflateInput.read(buffer, sizeof(buffer));
+    } while (n > 0);
+    ASSERT_LT(n, 0);
+}
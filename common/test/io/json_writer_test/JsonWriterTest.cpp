@@ -0,0 +1,174 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Common project headers
+#include <siodb/common/io/DynamicMemoryOutputStream.h>
+#include <siodb/common/io/JsonWriter.h>
+
+// CRT headers
+#include <cstdint>
+#include <cstdlib>
+
+// STL headers
+#include <limits>
+#include <string>
+
+// Google Test
+#include <gtest/gtest.h>
+
+using namespace siodb::io;
+
+namespace {
+
+template<class Function>
+std::string writeJson(Function&& f)
+{
+    DynamicMemoryOutputStream out;
+    JsonWriter jsonWriter(out);
+    f(jsonWriter);
+    return std::string(static_cast<const char*>(out.data()), out.size());
+}
+
+template<class T>
+std::string writeJsonValue(T value)
+{
+    return writeJson([value](JsonWriter& jsonWriter) { jsonWriter.writeValue(value); });
+}
+
+std::string writeJsonString(const std::string& value)
+{
+    return writeJson([&value](JsonWriter& jsonWriter) { jsonWriter.writeValue(value); });
+}
+
+/** Straightforward escaping, one character at a time */
+std::string escapeJsonString(const std::string& value)
+{
+    std::string result = "\"";
+    for (const char c : value) {
+        switch (c) {
+            case '\b': result += "\\b"; break;
+            case '\f': result += "\\f"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            case '\\': result += "\\\\"; break;
+            case '"': result += "\\\""; break;
+            default: {
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr const char* kHexCharacters = "0123456789ABCDEF";
+                    result += "\\u00";
+                    result += kHexCharacters[(c >> 4) & 15];
+                    result += kHexCharacters[c & 15];
+                } else
+                    result += c;
+                break;
+            }
+        }
+    }
+    result += '"';
+    return result;
+}
+
+}  // anonymous namespace
+
+TEST(JsonWriter, WriteString)
+{
+    EXPECT_EQ(writeJsonString(""), R"("")");
+    EXPECT_EQ(writeJsonString("hello"), R"("hello")");
+    EXPECT_EQ(writeJsonString("a\"b\\c\nd"), R"("a\"b\\c\nd")");
+    EXPECT_EQ(writeJsonString(std::string("\x01\x1F\x7F\x20", 4)), "\"\\u0001\\u001F\x7F \"");
+}
+
+TEST(JsonWriter, WriteString_EveryEscapePosition)
+{
+    // Strings longer than 16 characters are scanned 16 characters at once,
+    // so put each character to every position of a two-chunk string with a tail.
+    // Characters 0x80-0xFF must not be taken as control characters.
+    constexpr std::size_t kLength = 37;
+    for (int c = 0; c < 256; ++c) {
+        for (std::size_t pos = 0; pos < kLength; ++pos) {
+            std::string s(kLength, 'x');
+            s[pos] = static_cast<char>(c);
+            ASSERT_EQ(writeJsonString(s), escapeJsonString(s)) << "c=" << c << " pos=" << pos;
+        }
+    }
+}
+
+TEST(JsonWriter, WriteString_ManyEscapes)
+{
+    std::string s;
+    for (int i = 0; i < 1000; ++i)
+        s += static_cast<char>(i % 64);
+    s += "\xC3\xA4\xE2\x82\xAC tail";
+    EXPECT_EQ(writeJsonString(s), escapeJsonString(s));
+}
+
+TEST(JsonWriter, WriteFieldName)
+{
+    const auto json = writeJson([](JsonWriter& jsonWriter) {
+        jsonWriter.writeObjectBegin();
+        jsonWriter.writeFieldName("long field \"name\" with\tescapes");
+        jsonWriter.writeNullValue();
+        jsonWriter.writeObjectEnd();
+    });
+    EXPECT_EQ(json, R"({"long field \"name\" with\tescapes":null})");
+}
+
+TEST(JsonWriter, WriteInteger)
+{
+    EXPECT_EQ(writeJsonValue(0), "0");
+    EXPECT_EQ(writeJsonValue(-1), "-1");
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<int>::min()), "-2147483648");
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<int>::max()), "2147483647");
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<unsigned>::max()), "4294967295");
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<long long>::min()), "-9223372036854775808");
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<long long>::max()), "9223372036854775807");
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<long>::min()),
+            std::to_string(std::numeric_limits<long>::min()));
+    EXPECT_EQ(writeJsonValue(std::numeric_limits<unsigned long>::max()),
+            std::to_string(std::numeric_limits<unsigned long>::max()));
+    EXPECT_EQ(
+            writeJsonValue(std::numeric_limits<unsigned long long>::max()), "18446744073709551615");
+}
+
+TEST(JsonWriter, WriteBool)
+{
+    EXPECT_EQ(writeJsonValue(true), "true");
+    EXPECT_EQ(writeJsonValue(false), "false");
+}
+
+TEST(JsonWriter, WriteFloat)
+{
+    // Shortest form, no trailing zeroes
+    EXPECT_EQ(writeJsonValue(0.0f), "0");
+    EXPECT_EQ(writeJsonValue(1.5f), "1.5");
+    EXPECT_EQ(writeJsonValue(-2.25f), "-2.25");
+    EXPECT_EQ(writeJsonValue(0.1f), "0.1");
+    EXPECT_EQ(writeJsonValue(100.0f), "100");
+
+    // Values which used to lose precision in the fixed point form
+    for (const float value : {1e-10f, 3.4028235e38f, 1.17549435e-38f, 16777217.0f, 0.3f,
+                 1.0f / 3.0f, 123456.789f}) {
+        const auto s = writeJsonValue(value);
+        EXPECT_EQ(std::strtof(s.c_str(), nullptr), value) << s;
+    }
+}
+
+TEST(JsonWriter, WriteDouble)
+{
+    // Shortest form, no trailing zeroes
+    EXPECT_EQ(writeJsonValue(0.0), "0");
+    EXPECT_EQ(writeJsonValue(1.5), "1.5");
+    EXPECT_EQ(writeJsonValue(-2.25), "-2.25");
+    EXPECT_EQ(writeJsonValue(0.1), "0.1");
+    EXPECT_EQ(writeJsonValue(1234567.0), "1234567");
+    EXPECT_EQ(writeJsonValue(1e21), "1e+21");
+
+    // Values which used to lose precision in the fixed point form
+    for (const double value : {1e-300, 1.7976931348623157e308, 2.2250738585072014e-308,
+                 9007199254740993.0, 0.1 + 0.2, 1.0 / 3.0, 123456.789}) {
+        const auto s = writeJsonValue(value);
+        EXPECT_EQ(std::strtod(s.c_str(), nullptr), value) << s;
+    }
+}
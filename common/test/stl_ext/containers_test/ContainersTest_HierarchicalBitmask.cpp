@@ -0,0 +1,99 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Common project headers
+#include <siodb/common/stl_ext/hierarchical_bitmask.h>
+
+// STL headers
+#include <set>
+
+// Google Test
+#include <gtest/gtest.h>
+
+namespace {
+
+using Bitmask = stdext::hierarchical_bitmask;
+
+}  // namespace
+
+TEST(HierarchicalBitmask, CreateEmpty)
+{
+    const Bitmask bitmask(1000);
+    ASSERT_EQ(bitmask.bit_size(), 1000U);
+    ASSERT_TRUE(bitmask.none());
+    ASSERT_EQ(bitmask.find_next(0), Bitmask::npos);
+    ASSERT_EQ(bitmask.find_previous(999), Bitmask::npos);
+}
+
+TEST(HierarchicalBitmask, SetAndReset)
+{
+    Bitmask bitmask(300000);
+    bitmask.set(5);
+    bitmask.set(299999);
+    ASSERT_FALSE(bitmask.none());
+    ASSERT_TRUE(bitmask.get(5));
+    ASSERT_TRUE(bitmask.get(299999));
+    ASSERT_FALSE(bitmask.get(6));
+    bitmask.reset(5);
+    ASSERT_FALSE(bitmask.get(5));
+    ASSERT_FALSE(bitmask.none());
+    bitmask.reset(299999);
+    ASSERT_TRUE(bitmask.none());
+}
+
+TEST(HierarchicalBitmask, FindNext)
+{
+    Bitmask bitmask(300000);
+    bitmask.set(0);
+    bitmask.set(64);
+    bitmask.set(4097);
+    bitmask.set(299998);
+    ASSERT_EQ(bitmask.find_next(0), 0U);
+    ASSERT_EQ(bitmask.find_next(1), 64U);
+    ASSERT_EQ(bitmask.find_next(65), 4097U);
+    ASSERT_EQ(bitmask.find_next(4098), 299998U);
+    ASSERT_EQ(bitmask.find_next(299999), Bitmask::npos);
+    ASSERT_EQ(bitmask.find_next(300000), Bitmask::npos);
+}
+
+TEST(HierarchicalBitmask, FindPrevious)
+{
+    Bitmask bitmask(300000);
+    bitmask.set(0);
+    bitmask.set(64);
+    bitmask.set(4097);
+    bitmask.set(299998);
+    ASSERT_EQ(bitmask.find_previous(400000), 299998U);
+    ASSERT_EQ(bitmask.find_previous(299997), 4097U);
+    ASSERT_EQ(bitmask.find_previous(4096), 64U);
+    ASSERT_EQ(bitmask.find_previous(63), 0U);
+    bitmask.reset(0);
+    ASSERT_EQ(bitmask.find_previous(63), Bitmask::npos);
+}
+
+TEST(HierarchicalBitmask, CompareWithSet)
+{
+    constexpr std::size_t kSize = 100000;
+    Bitmask bitmask(kSize);
+    std::set<std::size_t> expected;
+    std::size_t x = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        x = (x * 1103515245 + 12345) % kSize;
+        if (i % 3 == 0) {
+            bitmask.reset(x);
+            expected.erase(x);
+        } else {
+            bitmask.set(x);
+            expected.insert(x);
+        }
+    }
+
+    for (std::size_t pos = 0; pos < kSize; pos += 7) {
+        const auto next = expected.lower_bound(pos);
+        ASSERT_EQ(bitmask.find_next(pos), next == expected.end() ? Bitmask::npos : *next);
+        const auto prev = expected.upper_bound(pos);
+        ASSERT_EQ(bitmask.find_previous(pos),
+                prev == expected.begin() ? Bitmask::npos : *std::prev(prev));
+    }
+}
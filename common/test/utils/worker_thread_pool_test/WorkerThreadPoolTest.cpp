@@ -0,0 +1,75 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Common project headers
+#include <siodb/common/utils/WorkerThreadPool.h>
+
+// STL headers
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+// Google Test
+#include <gtest/gtest.h>
+
+using namespace siodb::utils;
+
+TEST(WorkerThreadPoolTest, SubmitTask)
+{
+    WorkerThreadPool pool(2);
+    ASSERT_EQ(pool.getThreadCount(), 2u);
+    int value = 0;
+    pool.submit([&value] { value = 42; }).get();
+    ASSERT_EQ(value, 42);
+}
+
+TEST(WorkerThreadPoolTest, RunAll)
+{
+    WorkerThreadPool pool(4);
+    std::atomic<int> counter(0);
+    std::vector<WorkerThreadPool::Task> tasks;
+    for (int i = 0; i < 100; ++i)
+        tasks.push_back([&counter] { ++counter; });
+    pool.runAll(tasks);
+    ASSERT_EQ(counter.load(), 100);
+}
+
+TEST(WorkerThreadPoolTest, RunAllPropagatesError)
+{
+    WorkerThreadPool pool(2);
+    std::atomic<int> counter(0);
+    std::vector<WorkerThreadPool::Task> tasks;
+    tasks.push_back([] { throw std::runtime_error("task failed"); });
+    for (int i = 0; i < 10; ++i)
+        tasks.push_back([&counter] { ++counter; });
+    ASSERT_THROW(pool.runAll(tasks), std::runtime_error);
+    ASSERT_EQ(counter.load(), 10);
+}
+
+TEST(WorkerThreadPoolTest, TaskCounters)
+{
+    WorkerThreadPool pool(2);
+    ASSERT_EQ(pool.getSubmittedTaskCount(), 0u);
+    ASSERT_EQ(pool.getUnfinishedTaskCount(), 0u);
+
+    std::promise<void> release;
+    auto blocker = release.get_future().share();
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 4; ++i)
+        futures.push_back(pool.submit([blocker] { blocker.wait(); }));
+    futures.push_back(pool.submit([blocker] {
+        blocker.wait();
+        throw std::runtime_error("task failed");
+    }));
+    ASSERT_EQ(pool.getSubmittedTaskCount(), 5u);
+    ASSERT_EQ(pool.getUnfinishedTaskCount(), 5u);
+
+    // Finished tasks are not counted by the time their futures are ready
+    release.set_value();
+    for (int i = 0; i < 4; ++i)
+        futures[i].get();
+    ASSERT_THROW(futures[4].get(), std::runtime_error);
+    ASSERT_EQ(pool.getUnfinishedTaskCount(), 0u);
+    ASSERT_EQ(pool.getSubmittedTaskCount(), 5u);
+}
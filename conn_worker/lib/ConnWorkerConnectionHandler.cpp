@@ -6,6 +6,9 @@
 
 // Common project headers
 #include <siodb/common/config/SiodbDefs.h>
+#include <siodb/common/io/BufferedChunkedOutputStream.h>
+#include <siodb/common/io/ChunkedInputStream.h>
+#include <siodb/common/io/DeflateOutputStream.h>
 #include <siodb/common/io/FDStream.h>
 #include <siodb/common/log/Log.h>
 #include <siodb/common/net/ConnectionError.h>
@@ -55,6 +58,8 @@ ConnWorkerConnectionHandler::ConnWorkerConnectionHandler(
         FDGuard&& client, const config::ConstInstaceOptionsPtr& instanceOptions, bool adminMode)
     : m_dbOptions(instanceOptions)
     , m_adminMode(adminMode)
+    , m_rowsetFormat(ROWSET_FORMAT_ROW)
+    , m_compression(COMPRESSION_NONE)
 {
     m_clientEpollFd.reset(net::createEpollFd(client.getFD(), EPOLLIN));
     if (!m_adminMode && m_dbOptions->m_clientOptions.m_enableEncryption) {
@@ -96,6 +101,10 @@ void ConnWorkerConnectionHandler::run()
 
     authenticateUser(*ioMgrInputStream);
 
+    // NOTE: Must be persistent, because command may be followed by the data stream,
+    // which can be partially buffered in this stream.
+    protobuf::StreamInputStream clientInputStream(*m_clientConnection, errorCodeChecker);
+
     while (true) {
         try {
             // Read message from client
@@ -105,8 +114,8 @@ void ConnWorkerConnectionHandler::run()
                 // NOTE: In case of the TCP connection close or abort
                 // we can receive an empty message
                 net::epollWaitForData(m_clientEpollFd.getFD(), true);
-                protobuf::readMessage(protobuf::ProtocolMessageType::kCommand, command,
-                        *m_clientConnection, errorCodeChecker);
+                protobuf::readMessage(
+                        protobuf::ProtocolMessageType::kCommand, command, clientInputStream);
             } catch (net::ConnectionError& err) {
                 // Connection was closed or hangup. No reading operation was in progress.
                 LOG_DEBUG << kLogContext << "client: Client disconnected";
@@ -132,14 +141,21 @@ void ConnWorkerConnectionHandler::run()
                     iomgr_protocol::DatabaseEngineRequest dbeRequest;
                     dbeRequest.set_text(command.text());
                     dbeRequest.set_request_id(command.request_id());
+                    dbeRequest.set_data_follows(command.data_follows());
+                    dbeRequest.set_rowset_format(m_rowsetFormat);
 
                     // Connect to server
                     protobuf::writeMessage(protobuf::ProtocolMessageType::kDatabaseEngineRequest,
                             dbeRequest, *m_iomgrConnection);
+
+                    if (command.data_follows()) forwardRequestData(clientInputStream, true);
                 } catch (const ProtocolError& ex) {
                     LOG_ERROR << kLogContext << "iomgr: write error: " << ex.what();
                     m_iomgrConnection->close();
 
+                    // Consume rest of the request data, if any
+                    if (command.data_follows()) forwardRequestData(clientInputStream, false);
+
                     responseToClientWithError(
                             command.request_id(), ex.what(), kIoMgrConnectionError);
 
@@ -192,6 +208,9 @@ void ConnWorkerConnectionHandler::run()
                             dbeResponse.mutable_freetext_message());
                     response.set_affected_row_count(dbeResponse.affected_row_count());
                     response.set_has_affected_row_count(dbeResponse.has_affected_row_count());
+                    response.set_rowset_format(dbeResponse.rowset_format());
+                    if (response.column_description_size() > 0)
+                        response.set_compression(m_compression);
 
                     // Send response
                     LOG_DEBUG << kLogContext << "client: Sending response for the request #"
@@ -266,10 +285,25 @@ void ConnWorkerConnectionHandler::forwardRowData(protobuf::StreamInputStream& io
     std::uint64_t totalBytesSent = 0;
     google::protobuf::io::CodedInputStream codedInput(&ioMgrInputStream);
 
+    // Compressed row data is sent as chunked stream, so that client
+    // can find the end of it without decompressing.
+    io::OutputStream* clientOutput = m_clientConnection.get();
+    std::unique_ptr<io::BufferedChunkedOutputStream> chunkedOutput;
+    std::unique_ptr<io::DeflateOutputStream> compressedOutput;
+    if (m_compression != COMPRESSION_NONE) {
+        chunkedOutput = std::make_unique<io::BufferedChunkedOutputStream>(
+                kMaxCompressedRowDataChunkSize, *m_clientConnection);
+        compressedOutput = std::make_unique<io::DeflateOutputStream>(*chunkedOutput,
+                m_compression == COMPRESSION_GZIP ? io::ZlibStreamFormat::kGzip
+                                                  : io::ZlibStreamFormat::kZlib);
+        clientOutput = compressedOutput.get();
+    }
+
     // Allow EINTR to cause I/O error when exit signal detected.
     const utils::ExitSignalAwareErrorCodeChecker errorCodeChecker;
-    protobuf::StreamOutputStream clientOutputStream(*m_clientConnection, errorCodeChecker);
-    google::protobuf::io::CodedOutputStream codedOutput(&clientOutputStream);
+    protobuf::StreamOutputStream clientOutputStream(*clientOutput, errorCodeChecker);
+    auto codedOutput = std::make_unique<google::protobuf::io::CodedOutputStream>(
+            &clientOutputStream);
     while (true) {
         LOG_DEBUG << kLogContext << "iomgr: Reading row length";
         std::uint64_t rowLength = 0;
@@ -282,7 +316,7 @@ void ConnWorkerConnectionHandler::forwardRowData(protobuf::StreamInputStream& io
                         rowLength, codedRowLength);
         const std::size_t readLengthBytes = codedRowLengthEnd - codedRowLength;
 
-        codedOutput.WriteRaw(codedRowLength, readLengthBytes);
+        codedOutput->WriteRaw(codedRowLength, readLengthBytes);
         totalBytesSent += readLengthBytes;
 
         if (rowLength == 0) {
@@ -301,7 +335,7 @@ void ConnWorkerConnectionHandler::forwardRowData(protobuf::StreamInputStream& io
 
             const std::size_t dataSize =
                     std::min(static_cast<std::size_t>(bufferSize), rowLength - rowDataBytesSent);
-            codedOutput.WriteRaw(data, dataSize);
+            codedOutput->WriteRaw(data, dataSize);
 
             codedInput.Skip(dataSize);
             rowDataBytesSent += dataSize;
@@ -310,9 +344,53 @@ void ConnWorkerConnectionHandler::forwardRowData(protobuf::StreamInputStream& io
         LOG_DEBUG << kLogContext << "client: Sent " << rowLength << " bytes of row data";
     }
 
+    if (compressedOutput) {
+        // Push all data through the compressor and finish compressed stream
+        codedOutput.reset();
+        if (!clientOutputStream.Flush()) stdext::throw_system_error("Client socket write error");
+        if (compressedOutput->close() != 0 || chunkedOutput->close() != 0)
+            stdext::throw_system_error("Client socket write error");
+        LOG_DEBUG << kLogContext << "client: Compressed " << compressedOutput->getTotalIn()
+                  << " bytes of row data into " << compressedOutput->getTotalOut() << " bytes";
+    }
+
     LOG_DEBUG << kLogContext << "client: Sent total " << totalBytesSent << " bytes of row data";
 }
 
+void ConnWorkerConnectionHandler::forwardRequestData(
+        protobuf::StreamInputStream& clientInputStream, bool forward)
+{
+    LOG_DEBUG << kLogContext << "client: " << (forward ? "Forwarding" : "Skipping")
+              << " request data";
+
+    io::ChunkedInputStream chunkedInput(clientInputStream);
+    std::unique_ptr<io::BufferedChunkedOutputStream> chunkedOutput;
+    if (forward) {
+        chunkedOutput = std::make_unique<io::BufferedChunkedOutputStream>(
+                kMaxRequestDataChunkSize, *m_iomgrConnection);
+    }
+
+    std::uint64_t totalBytes = 0;
+    std::vector<std::uint8_t> buffer(kMaxRequestDataChunkSize);
+    while (!chunkedInput.isEof()) {
+        const auto n = chunkedInput.read(buffer.data(), buffer.size());
+        if (n < 0) {
+            if (chunkedInput.isEof()) break;
+            stdext::throw_system_error("Client socket read error");
+        }
+        if (n == 0) stdext::throw_system_error(EIO, "Client closed request data stream");
+        if (chunkedOutput && chunkedOutput->write(buffer.data(), n) != n)
+            stdext::throw_system_error("IO manager socket write error");
+        totalBytes += n;
+    }
+
+    if (chunkedOutput && chunkedOutput->close() != 0)
+        stdext::throw_system_error("IO manager socket write error");
+
+    LOG_DEBUG << kLogContext << "client: " << (forward ? "Forwarded " : "Skipped ") << totalBytes
+              << " bytes of request data";
+}
+
 void ConnWorkerConnectionHandler::selectLastUsedDatabase(
         protobuf::StreamInputStream& ioMgrInputStream)
 {
@@ -373,6 +451,9 @@ void ConnWorkerConnectionHandler::authenticateUser(
             beginSessionRequest, *m_clientConnection, errorCodeChecker);
     LOG_DEBUG << kLogContext << "client: Received BeginSessionRequest from client";
 
+    m_rowsetFormat = beginSessionRequest.rowset_format();
+    m_compression = beginSessionRequest.compression();
+
     iomgr_protocol::BeginAuthenticateUserRequest beginAuthenticateUserRequest;
     const auto& userName = beginSessionRequest.user_name();
     if (userName.length() > 2 && userName.front() == '\"' && userName.back() == '\"')
@@ -60,6 +60,15 @@ private:
      * */
     void forwardRowData(protobuf::StreamInputStream& ioMgrInputStream);
 
+    /**
+     * Receives chunked request data stream from client and sends it to IO manager.
+     * If IO manager connection is not available, data is read and discarded.
+     * @param clientInputStream Client input stream.
+     * @param forward Indication that data must be sent to IO manager.
+     * @throw std::system_error when I/O error happens.
+     */
+    void forwardRequestData(protobuf::StreamInputStream& clientInputStream, bool forward);
+
     /**
      * Updates used database to @ref m_lastUsedDatabase (Sends USE DATABASE to Iomgr).
      * @param ioMgrInputStream Input stream.
@@ -116,12 +125,24 @@ private:
     /** Last used database */
     std::string m_lastUsedDatabase;
 
+    /** Rowset encoding requested by the client */
+    RowsetFormat m_rowsetFormat;
+
+    /** Rowset compression requested by the client */
+    CompressionType m_compression;
+
     /** A file descriptor for polling connection with the client */
     FDGuard m_clientEpollFd;
 
     /** Log context name */
     static constexpr const char* kLogContext = "ConnWorkerConnectionHandler: ";
 
+    /** Maximum chunk size of the request data sent to IO manager */
+    static constexpr std::size_t kMaxRequestDataChunkSize = 0x10000;
+
+    /** Maximum chunk size of the compressed row data sent to client */
+    static constexpr std::size_t kMaxCompressedRowDataChunkSize = 0x10000;
+
     /** Request ID for used database reset after Iomgr connection error */
     static constexpr std::uint64_t kUseDatabaseRequestId = 0xDB1D;
 
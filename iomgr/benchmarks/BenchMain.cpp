@@ -0,0 +1,26 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "BenchmarkEnv.h"
+
+// Common project headers
+#include <siodb/common/utils/StartupActions.h>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+    // Must be called very first!
+    siodb::utils::performCommonStartupActions();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    BenchmarkEnvironment::initialize(argv[0]);
+    benchmark::RunSpecifiedBenchmarks();
+    BenchmarkEnvironment::shutdown();
+    return 0;
+}
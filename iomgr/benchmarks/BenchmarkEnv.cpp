@@ -0,0 +1,125 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "BenchmarkEnv.h"
+
+// Project headers
+#include "dbengine/Database.h"
+#include "dbengine/Instance.h"
+#include "dbengine/SimpleColumnSpecification.h"
+#include "dbengine/Table.h"
+#include "dbengine/User.h"
+
+// Common project headers
+#include <siodb/common/log/Log.h>
+#include <siodb/common/options/SiodbOptions.h>
+#include <siodb/common/stl_ext/sstream_ext.h>
+#include <siodb/common/stl_wrap/filesystem_wrapper.h>
+#include <siodb/common/utils/FSUtils.h>
+#include <siodb/common/utils/MessageCatalog.h>
+#include <siodb/iomgr/shared/dbengine/crypto/ciphers/Cipher.h>
+
+// CRT headers
+#include <climits>
+#include <ctime>
+
+// STL headers
+#include <limits>
+#include <stdexcept>
+
+// System headers
+#include <unistd.h>
+
+std::string BenchmarkEnvironment::s_argv0;
+std::string BenchmarkEnvironment::s_baseDir;
+dbengine::InstancePtr BenchmarkEnvironment::s_instance;
+dbengine::DatabasePtr BenchmarkEnvironment::s_database;
+unsigned BenchmarkEnvironment::s_tableNumber;
+std::mutex BenchmarkEnvironment::s_mutex;
+
+void BenchmarkEnvironment::initialize(const char* argv0)
+{
+    s_argv0 = argv0;
+    s_baseDir = stdext::concat(
+            ::getenv("HOME"), "/tmp/siodb_bench_", std::time(nullptr), '_', ::getpid());
+    fs::create_directories(s_baseDir);
+    dbengine::crypto::initializeBuiltInCiphers();
+}
+
+void BenchmarkEnvironment::shutdown()
+{
+    std::lock_guard lock(s_mutex);
+    s_database.reset();
+    if (s_instance) {
+        s_instance.reset();
+        siodb::log::shutdownLogging();
+    }
+    if (!s_baseDir.empty()) fs::remove_all(s_baseDir);
+}
+
+dbengine::InstancePtr BenchmarkEnvironment::getInstance()
+{
+    std::lock_guard lock(s_mutex);
+    if (s_instance) return s_instance;
+
+    siodb::config::SiodbOptions instanceOptions;
+
+    std::vector<char> executableFullPath(PATH_MAX);
+    if (::realpath(s_argv0.c_str(), executableFullPath.data()) == nullptr)
+        throw std::runtime_error("Failed to obtain full path of the current executable.");
+    instanceOptions.m_generalOptions.m_executablePath = executableFullPath.data();
+
+    instanceOptions.m_generalOptions.m_dataDirectory = s_baseDir + "/data";
+    instanceOptions.m_generalOptions.m_superUserInitialAccessKey =
+            "ssh-ed25519 AAAAC3NzaC1lZDI1NTE5AAAAIMiRClOWfWD4kC6cy5IvxscUm17g5ECaXDUe5KVuIFEz "
+            "root@siodb";
+
+    // Benchmarked tables have encryption set explicitly, keep system data plain
+    instanceOptions.m_encryptionOptions.m_defaultCipherId = "none";
+    instanceOptions.m_encryptionOptions.m_masterCipherId = "none";
+    instanceOptions.m_encryptionOptions.m_systemDbCipherId = "none";
+
+    // Log to file only, so that benchmark output stays clean
+    instanceOptions.m_logOptions.m_logFileBaseName = "iomgr";
+    siodb::config::LogChannelOptions channel;
+    channel.m_name = "file";
+    channel.m_type = siodb::config::LogChannelType::kFile;
+    channel.m_destination = s_baseDir + "/log";
+    channel.m_severity = boost::log::trivial::warning;
+    instanceOptions.m_logOptions.m_logChannels.push_back(channel);
+    siodb::log::initLogging(instanceOptions.m_logOptions);
+
+    siodb::utils::MessageCatalog::initDefaultCatalog(
+            siodb::utils::constructPath(instanceOptions.getExecutableDir(), "iomgr_messages.txt"));
+
+    s_instance = std::make_shared<dbengine::Instance>(instanceOptions);
+    return s_instance;
+}
+
+dbengine::DatabasePtr BenchmarkEnvironment::getDatabase()
+{
+    const auto instance = getInstance();
+    std::lock_guard lock(s_mutex);
+    if (!s_database) {
+        siodb::BinaryValue key(16, 0xAB);
+        s_database = instance->createDatabase("BENCH", "aes128", std::move(key), {},
+                std::numeric_limits<std::uint32_t>::max() / 2, {}, false,
+                dbengine::User::kSuperUserId);
+    }
+    return s_database;
+}
+
+dbengine::TablePtr BenchmarkEnvironment::createTable(siodb::ColumnDataType dataType)
+{
+    const auto database = getDatabase();
+    std::string tableName;
+    {
+        std::lock_guard lock(s_mutex);
+        tableName = stdext::concat("T", ++s_tableNumber);
+    }
+    const std::vector<dbengine::SimpleColumnSpecification> columns {
+            dbengine::SimpleColumnSpecification("C", dataType, false)};
+    return database->createUserTable(std::move(tableName), dbengine::TableType::kDisk, columns,
+            dbengine::User::kSuperUserId, {});
+}
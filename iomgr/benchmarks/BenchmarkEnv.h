@@ -0,0 +1,83 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "dbengine/DatabasePtr.h"
+#include "dbengine/InstancePtr.h"
+#include "dbengine/TablePtr.h"
+#include <siodb-generated/common/lib/siodb/common/proto/ColumnDataType.pb.h>
+
+// STL headers
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dbengine = siodb::iomgr::dbengine;
+
+/**
+ * Shared environment of the benchmarks. Database instance is created lazily,
+ * so that benchmarks which don't need it (ciphers, variants, rowset writers)
+ * don't pay for its startup.
+ */
+class BenchmarkEnvironment {
+public:
+    /**
+     * Initializes benchmark environment.
+     * @param argv0 Executable path.
+     */
+    static void initialize(const char* argv0);
+
+    /** Shuts down database instance, if it was started, and removes benchmark data. */
+    static void shutdown();
+
+    /**
+     * Returns directory for the benchmark data files.
+     * @return Directory path.
+     */
+    static const std::string& getBaseDir() noexcept
+    {
+        return s_baseDir;
+    }
+
+    /**
+     * Returns database instance, starts it if it is not started yet.
+     * @return Database instance.
+     */
+    static dbengine::InstancePtr getInstance();
+
+    /**
+     * Returns benchmark database, creates it if it doesn't exist yet.
+     * @return Benchmark database.
+     */
+    static dbengine::DatabasePtr getDatabase();
+
+    /**
+     * Creates new table with a single column of the given data type
+     * in the benchmark database.
+     * @param dataType Column data type.
+     * @return New table.
+     */
+    static dbengine::TablePtr createTable(siodb::ColumnDataType dataType);
+
+private:
+    /** Executable path */
+    static std::string s_argv0;
+
+    /** Benchmark data directory */
+    static std::string s_baseDir;
+
+    /** Database instance */
+    static dbengine::InstancePtr s_instance;
+
+    /** Benchmark database */
+    static dbengine::DatabasePtr s_database;
+
+    /** Last used table number */
+    static unsigned s_tableNumber;
+
+    /** Initialization mutex */
+    static std::mutex s_mutex;
+};
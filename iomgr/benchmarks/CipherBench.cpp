@@ -0,0 +1,68 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "dbengine/crypto/GetCipher.h"
+
+// Common project headers
+#include <siodb/iomgr/shared/dbengine/crypto/ciphers/Cipher.h>
+#include <siodb/iomgr/shared/dbengine/crypto/ciphers/CipherContext.h>
+
+// STL headers
+#include <random>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace {
+
+namespace crypto = siodb::iomgr::dbengine::crypto;
+
+/**
+ * Measures CipherContext::transform() throughput.
+ * Argument 0 is buffer size in bytes, argument 1 is max. number of transform threads.
+ */
+void BM_CipherTransform(benchmark::State& state, const char* cipherId, bool encrypt)
+{
+    const auto cipher = crypto::getCipher(cipherId);
+    const auto blockSize = cipher->getBlockSizeInBits() / 8;
+    const auto blockCount = static_cast<std::size_t>(state.range(0)) / blockSize;
+
+    std::mt19937 gen(1);
+    siodb::BinaryValue key(cipher->getKeySizeInBits() / 8);
+    for (auto& v : key)
+        v = static_cast<std::uint8_t>(gen());
+    siodb::BinaryValue data(blockCount * blockSize);
+    for (auto& v : data)
+        v = static_cast<std::uint8_t>(gen());
+
+    const auto context =
+            encrypt ? cipher->createEncryptionContext(key) : cipher->createDecryptionContext(key);
+    const auto savedThreadCount = crypto::CipherContext::getMaxTransformThreadCount();
+    crypto::CipherContext::setMaxTransformThreadCount(static_cast<unsigned>(state.range(1)));
+    for (auto _ : state) {
+        context->transform(data.data(), blockCount, data.data());
+        benchmark::ClobberMemory();
+    }
+    crypto::CipherContext::setMaxTransformThreadCount(savedThreadCount);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void cipherTransformArgs(benchmark::internal::Benchmark* b)
+{
+    for (std::int64_t size : {16, 512, 8192, 65536, 1 << 20})
+        b->Args({size, 1});
+    for (std::int64_t threads : {1, 2, 4})
+        b->Args({16 << 20, threads});
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_CipherTransform, aes128_encrypt, "aes128", true)->Apply(cipherTransformArgs);
+BENCHMARK_CAPTURE(BM_CipherTransform, aes128_decrypt, "aes128", false)->Apply(cipherTransformArgs);
+BENCHMARK_CAPTURE(BM_CipherTransform, aes256_encrypt, "aes256", true)->Apply(cipherTransformArgs);
+BENCHMARK_CAPTURE(BM_CipherTransform, camellia128_encrypt, "camellia128", true)
+        ->Apply(cipherTransformArgs);
+BENCHMARK_CAPTURE(BM_CipherTransform, camellia256_encrypt, "camellia256", true)
+        ->Apply(cipherTransformArgs);
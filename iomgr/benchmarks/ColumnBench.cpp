@@ -0,0 +1,122 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "BenchmarkEnv.h"
+#include "dbengine/Column.h"
+#include "dbengine/Table.h"
+
+// STL headers
+#include <algorithm>
+#include <random>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using siodb::iomgr::dbengine::Variant;
+
+/** Number of distinct values used by each benchmark */
+constexpr std::size_t kValueCount = 4096;
+
+using ValueGenerator = Variant (*)(std::mt19937_64& gen);
+
+Variant makeInt32(std::mt19937_64& gen)
+{
+    return static_cast<std::int32_t>(gen());
+}
+
+Variant makeInt64(std::mt19937_64& gen)
+{
+    return static_cast<std::int64_t>(gen());
+}
+
+Variant makeDouble(std::mt19937_64& gen)
+{
+    return static_cast<double>(gen()) / 3.0;
+}
+
+Variant makeTimestamp(std::mt19937_64& gen)
+{
+    return siodb::RawDateTime(static_cast<std::time_t>(gen() % 2000000000));
+}
+
+Variant makeShortText(std::mt19937_64& gen)
+{
+    return std::string(16 + gen() % 16, static_cast<char>('a' + gen() % 26));
+}
+
+Variant makeLongText(std::mt19937_64& gen)
+{
+    return std::string(4096 + gen() % 64, static_cast<char>('a' + gen() % 26));
+}
+
+Variant makeBinary(std::mt19937_64& gen)
+{
+    return siodb::BinaryValue(256, static_cast<std::uint8_t>(gen()));
+}
+
+std::vector<Variant> makeValues(ValueGenerator makeValue)
+{
+    std::mt19937_64 gen(1);
+    std::vector<Variant> values;
+    values.reserve(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i)
+        values.push_back(makeValue(gen));
+    return values;
+}
+
+/** Measures Column::writeRecord(). Includes copying of the value. */
+void BM_ColumnWriteRecord(
+        benchmark::State& state, siodb::ColumnDataType dataType, ValueGenerator makeValue)
+{
+    const auto table = BenchmarkEnvironment::createTable(dataType);
+    const auto column = table->findColumnChecked("C");
+    const auto values = makeValues(makeValue);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Variant value(values[i++ % kValueCount]);
+        benchmark::DoNotOptimize(column->writeRecord(std::move(value)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/** Measures Column::readRecord(). */
+void BM_ColumnReadRecord(
+        benchmark::State& state, siodb::ColumnDataType dataType, ValueGenerator makeValue)
+{
+    const auto table = BenchmarkEnvironment::createTable(dataType);
+    const auto column = table->findColumnChecked("C");
+    auto values = makeValues(makeValue);
+    std::vector<siodb::iomgr::dbengine::ColumnDataAddress> addresses;
+    addresses.reserve(kValueCount);
+    for (auto& value : values)
+        addresses.push_back(column->writeRecord(std::move(value)).m_dataAddress);
+
+    // Read in the pseudo-random order
+    std::mt19937_64 gen(2);
+    std::shuffle(addresses.begin(), addresses.end(), gen);
+    Variant value;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        column->readRecord(addresses[i++ % kValueCount], value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+#define SIODB_COLUMN_BENCHMARKS(name, dataType, makeValue)                    \
+    BENCHMARK_CAPTURE(BM_ColumnWriteRecord, name, siodb::dataType, makeValue); \
+    BENCHMARK_CAPTURE(BM_ColumnReadRecord, name, siodb::dataType, makeValue)
+
+SIODB_COLUMN_BENCHMARKS(int32, COLUMN_DATA_TYPE_INT32, makeInt32);
+SIODB_COLUMN_BENCHMARKS(int64, COLUMN_DATA_TYPE_INT64, makeInt64);
+SIODB_COLUMN_BENCHMARKS(double, COLUMN_DATA_TYPE_DOUBLE, makeDouble);
+SIODB_COLUMN_BENCHMARKS(timestamp, COLUMN_DATA_TYPE_TIMESTAMP, makeTimestamp);
+SIODB_COLUMN_BENCHMARKS(text_short, COLUMN_DATA_TYPE_TEXT, makeShortText);
+SIODB_COLUMN_BENCHMARKS(text_4k, COLUMN_DATA_TYPE_TEXT, makeLongText);
+SIODB_COLUMN_BENCHMARKS(binary_256, COLUMN_DATA_TYPE_BINARY, makeBinary);
@@ -0,0 +1,117 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "BenchmarkEnv.h"
+#include "dbengine/crypto/GetCipher.h"
+
+// Common project headers
+#include <siodb/common/stl_ext/sstream_ext.h>
+#include <siodb/iomgr/shared/dbengine/crypto/ciphers/Cipher.h>
+#include <siodb/iomgr/shared/dbengine/io/EncryptedFile.h>
+
+// STL headers
+#include <atomic>
+#include <random>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace {
+
+namespace crypto = siodb::iomgr::dbengine::crypto;
+
+constexpr int kFileCreationMode = 0644;
+
+/** Size of the file region used by the benchmarks */
+constexpr off_t kFileRegionSize = 16 * 1024 * 1024;
+
+std::string makeNewFilePath()
+{
+    static std::atomic<unsigned> fileId(0);
+    return stdext::concat(BenchmarkEnvironment::getBaseDir(), "/ef_", ++fileId);
+}
+
+std::unique_ptr<siodb::iomgr::dbengine::io::EncryptedFile> createFile(const char* cipherId)
+{
+    const auto cipher = crypto::getCipher(cipherId);
+    siodb::BinaryValue key(cipher->getKeySizeInBits() / 8);
+    for (std::size_t i = 0; i < key.size(); ++i)
+        key[i] = static_cast<std::uint8_t>(i);
+    auto file = std::make_unique<siodb::iomgr::dbengine::io::EncryptedFile>(makeNewFilePath(), 0,
+            kFileCreationMode, cipher->createEncryptionContext(key),
+            cipher->createDecryptionContext(key), 0);
+    siodb::BinaryValue zeroes(1024 * 1024);
+    for (off_t offset = 0; offset < kFileRegionSize; offset += zeroes.size())
+        file->writeChecked(zeroes.data(), zeroes.size(), offset);
+    return file;
+}
+
+/**
+ * Sequence of offsets for the benchmark: block aligned or deliberately misaligned
+ * (crossing cipher block boundary), pseudo-random but reproducible.
+ */
+std::vector<off_t> makeOffsets(std::size_t ioSize, bool aligned)
+{
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<off_t> dis(0, kFileRegionSize - ioSize - 16);
+    std::vector<off_t> offsets(1024);
+    for (auto& offset : offsets) {
+        offset = dis(gen);
+        offset = aligned ? (offset & ~off_t(15)) : (offset | 7);
+    }
+    return offsets;
+}
+
+/**
+ * Measures EncryptedFile::write().
+ * Argument 0 is I/O size in bytes, argument 1 is alignment flag.
+ */
+void BM_EncryptedFileWrite(benchmark::State& state, const char* cipherId)
+{
+    const auto file = createFile(cipherId);
+    const std::size_t ioSize = state.range(0);
+    const auto offsets = makeOffsets(ioSize, state.range(1) != 0);
+    siodb::BinaryValue buffer(ioSize, 0x5A);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        if (file->write(buffer.data(), ioSize, offsets[i++ % offsets.size()]) != ioSize)
+            state.SkipWithError("EncryptedFile write failed");
+    }
+    state.SetBytesProcessed(state.iterations() * ioSize);
+}
+
+/**
+ * Measures EncryptedFile::read().
+ * Argument 0 is I/O size in bytes, argument 1 is alignment flag.
+ */
+void BM_EncryptedFileRead(benchmark::State& state, const char* cipherId)
+{
+    const auto file = createFile(cipherId);
+    const std::size_t ioSize = state.range(0);
+    const auto offsets = makeOffsets(ioSize, state.range(1) != 0);
+    siodb::BinaryValue buffer(ioSize);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        if (file->read(buffer.data(), ioSize, offsets[i++ % offsets.size()]) != ioSize)
+            state.SkipWithError("EncryptedFile read failed");
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * ioSize);
+}
+
+void encryptedFileArgs(benchmark::internal::Benchmark* b)
+{
+    for (std::int64_t size : {16, 100, 4096, 65536, 1 << 20}) {
+        b->Args({size, 1});
+        b->Args({size, 0});
+    }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_EncryptedFileWrite, aes128, "aes128")->Apply(encryptedFileArgs);
+BENCHMARK_CAPTURE(BM_EncryptedFileRead, aes128, "aes128")->Apply(encryptedFileArgs);
+BENCHMARK_CAPTURE(BM_EncryptedFileWrite, camellia256, "camellia256")->Apply(encryptedFileArgs);
+BENCHMARK_CAPTURE(BM_EncryptedFileRead, camellia256, "camellia256")->Apply(encryptedFileArgs);
@@ -0,0 +1,268 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "BenchmarkEnv.h"
+#include "dbengine/Column.h"
+#include "dbengine/Table.h"
+#include "dbengine/bpt/BPlusTreeIndex.h"
+#include "dbengine/ikt/UInt64IndexKeyTraits.h"
+#include "dbengine/uli/UInt64UniqueLinearIndex.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/stl_ext/sstream_ext.h>
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// STL headers
+#include <algorithm>
+#include <random>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using namespace siodb::iomgr::dbengine;
+
+/** Index value size, same as in the master column main index */
+constexpr std::size_t kValueSize = 12;
+
+/** Number of keys in the index for the lookup benchmarks */
+constexpr std::uint64_t kLookupKeyCount = 100000;
+
+std::shared_ptr<Index> createIndex(bool bplusTree)
+{
+    static unsigned indexNumber = 0;
+    const auto table = BenchmarkEnvironment::createTable(siodb::COLUMN_DATA_TYPE_INT64);
+    const IndexColumnSpecification columnSpec(
+            table->getMasterColumn()->getCurrentColumnDefinition(), false);
+    auto name = stdext::concat("BENCH_INDEX_", ++indexNumber);
+    if (bplusTree) {
+        return std::make_shared<BPlusTreeIndex>(*table, std::move(name), UInt64IndexKeyTraits(),
+                kValueSize, &UInt64IndexKeyTraits::compareKeys, true,
+                IndexColumnSpecificationList {columnSpec},
+                siodb::kDefaultDataFileDataAreaSize, std::nullopt);
+    }
+    return std::make_shared<UInt64UniqueLinearIndex>(*table, std::move(name), kValueSize,
+            columnSpec, siodb::kDefaultDataFileDataAreaSize, std::nullopt);
+}
+
+void encodeKey(std::uint64_t key, std::uint8_t* buffer) noexcept
+{
+    ::pbeEncodeUInt64(key, buffer);
+}
+
+void fillIndex(Index& index, std::uint64_t keyCount)
+{
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize] = {};
+    for (std::uint64_t k = 1; k <= keyCount; ++k) {
+        encodeKey(k, key);
+        ::pbeEncodeUInt64(k, value);
+        index.insert(key, value);
+    }
+}
+
+/** Measures UniqueLinearIndex::insert() with increasing keys, like TRIDs are inserted. */
+void BM_UniqueLinearIndexInsert(benchmark::State& state)
+{
+    const auto index = createIndex(false);
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize] = {};
+    std::uint64_t k = 0;
+    for (auto _ : state) {
+        encodeKey(++k, key);
+        benchmark::DoNotOptimize(index->insert(key, value));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/** Measures UniqueLinearIndex::find() for random existing keys. */
+void BM_UniqueLinearIndexFind(benchmark::State& state)
+{
+    const auto index = createIndex(false);
+    fillIndex(*index, kLookupKeyCount);
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<std::uint64_t> dis(1, kLookupKeyCount);
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize];
+    for (auto _ : state) {
+        encodeKey(dis(gen), key);
+        benchmark::DoNotOptimize(index->find(key, value, 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Measures UniqueLinearIndex::findNextKey() walk over the index.
+ * Argument 0 is distance between keys, which controls how many empty slots are skipped.
+ */
+void BM_UniqueLinearIndexFindNextKey(benchmark::State& state)
+{
+    const auto index = createIndex(false);
+    const auto step = static_cast<std::uint64_t>(state.range(0));
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize] = {};
+    for (std::uint64_t k = 1; k <= kLookupKeyCount; ++k) {
+        encodeKey(k * step, key);
+        index->insert(key, value);
+    }
+    std::uint8_t currentKey[8];
+    encodeKey(0, currentKey);
+    std::uint8_t nextKey[8];
+    for (auto _ : state) {
+        if (!index->findNextKey(currentKey, nextKey)) encodeKey(0, nextKey);
+        std::copy_n(nextKey, sizeof(nextKey), currentKey);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Measures BPlusTreeIndex::insert() into a fresh index.
+ * Argument 0 is number of keys per index. Key count is kept within the root leaf node,
+ * because node splitting is not implemented in the BPlusTreeIndex yet.
+ */
+void BM_BPlusTreeIndexInsert(benchmark::State& state)
+{
+    const auto keyCount = static_cast<std::uint64_t>(state.range(0));
+    std::mt19937_64 gen(1);
+    std::vector<std::uint64_t> keys(keyCount);
+    for (std::uint64_t i = 0; i < keyCount; ++i)
+        keys[i] = i + 1;
+    std::shuffle(keys.begin(), keys.end(), gen);
+
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize] = {};
+    for (auto _ : state) {
+        state.PauseTiming();
+        const auto index = createIndex(true);
+        state.ResumeTiming();
+        for (const auto k : keys) {
+            encodeKey(k, key);
+            benchmark::DoNotOptimize(index->insert(key, value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keyCount);
+}
+
+/**
+ * Measures BPlusTreeIndex::find() for random existing keys.
+ * Argument 0 is number of keys in the index.
+ */
+void BM_BPlusTreeIndexFind(benchmark::State& state)
+{
+    const auto keyCount = static_cast<std::uint64_t>(state.range(0));
+    const auto index = createIndex(true);
+    fillIndex(*index, keyCount);
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<std::uint64_t> dis(1, keyCount);
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize];
+    for (auto _ : state) {
+        encodeKey(dis(gen), key);
+        benchmark::DoNotOptimize(index->find(key, value, 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Measures BPlusTreeIndex::find() for random existing keys from multiple threads
+ * sharing the same index.
+ * Argument 0 is number of keys in the index.
+ */
+void BM_BPlusTreeIndexConcurrentFind(benchmark::State& state)
+{
+    static std::shared_ptr<Index> index;
+    const auto keyCount = static_cast<std::uint64_t>(state.range(0));
+    if (state.thread_index == 0) {
+        index = createIndex(true);
+        fillIndex(*index, keyCount);
+    }
+    std::mt19937_64 gen(state.thread_index + 1);
+    std::uniform_int_distribution<std::uint64_t> dis(1, keyCount);
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize];
+    for (auto _ : state) {
+        encodeKey(dis(gen), key);
+        benchmark::DoNotOptimize(index->find(key, value, 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index == 0) index.reset();
+}
+
+/** Bulk load source producing increasing keys */
+class SequentialBulkLoadSource : public BPlusTreeIndex::BulkLoadSource {
+public:
+    explicit SequentialBulkLoadSource(std::uint64_t keyCount) noexcept
+        : m_keyCount(keyCount)
+        , m_key(0)
+    {
+    }
+
+    bool getNext(void* key, void* value) override
+    {
+        if (m_key == m_keyCount) return false;
+        ++m_key;
+        encodeKey(m_key, static_cast<std::uint8_t*>(key));
+        std::memset(value, 0, kValueSize);
+        ::pbeEncodeUInt64(m_key, static_cast<std::uint8_t*>(value));
+        return true;
+    }
+
+private:
+    const std::uint64_t m_keyCount;
+    std::uint64_t m_key;
+};
+
+/**
+ * Measures BPlusTreeIndex::bulkLoad() into a fresh index.
+ * Argument 0 is number of keys per index.
+ */
+void BM_BPlusTreeIndexBulkLoad(benchmark::State& state)
+{
+    const auto keyCount = static_cast<std::uint64_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        const auto index = createIndex(true);
+        SequentialBulkLoadSource source(keyCount);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(
+                std::static_pointer_cast<BPlusTreeIndex>(index)->bulkLoad(source));
+    }
+    state.SetItemsProcessed(state.iterations() * keyCount);
+}
+
+/**
+ * Measures BPlusTreeIndex::find() for random existing keys in the bulk loaded
+ * multi-level tree.
+ * Argument 0 is number of keys in the index.
+ */
+void BM_BPlusTreeIndexBulkLoadedFind(benchmark::State& state)
+{
+    const auto keyCount = static_cast<std::uint64_t>(state.range(0));
+    const auto index = createIndex(true);
+    SequentialBulkLoadSource source(keyCount);
+    std::static_pointer_cast<BPlusTreeIndex>(index)->bulkLoad(source);
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<std::uint64_t> dis(1, keyCount);
+    std::uint8_t key[8];
+    std::uint8_t value[kValueSize];
+    for (auto _ : state) {
+        encodeKey(dis(gen), key);
+        benchmark::DoNotOptimize(index->find(key, value, 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_UniqueLinearIndexInsert);
+BENCHMARK(BM_UniqueLinearIndexFind);
+BENCHMARK(BM_UniqueLinearIndexFindNextKey)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(BM_BPlusTreeIndexInsert)->Arg(16)->Arg(128)->Arg(384);
+BENCHMARK(BM_BPlusTreeIndexFind)->Arg(16)->Arg(128)->Arg(384);
+BENCHMARK(BM_BPlusTreeIndexConcurrentFind)->Arg(384)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_BPlusTreeIndexBulkLoad)->Arg(kLookupKeyCount)->Arg(10 * kLookupKeyCount);
+BENCHMARK(BM_BPlusTreeIndexBulkLoadedFind)->Arg(kLookupKeyCount);
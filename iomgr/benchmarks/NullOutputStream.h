@@ -0,0 +1,41 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Common project headers
+#include <siodb/common/io/OutputStream.h>
+
+/** Output stream which discards all data and counts written bytes. */
+class NullOutputStream : public siodb::io::OutputStream {
+public:
+    bool isValid() const noexcept override
+    {
+        return true;
+    }
+
+    int close() noexcept override
+    {
+        return 0;
+    }
+
+    std::ptrdiff_t write([[maybe_unused]] const void* buffer, std::size_t size) noexcept override
+    {
+        m_writtenBytes += size;
+        return size;
+    }
+
+    /**
+     * Returns number of bytes written so far.
+     * @return Number of bytes.
+     */
+    std::size_t getWrittenBytes() const noexcept
+    {
+        return m_writtenBytes;
+    }
+
+private:
+    /** Number of written bytes */
+    std::size_t m_writtenBytes = 0;
+};
@@ -0,0 +1,120 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "NullOutputStream.h"
+#include "dbengine/handlers/RestProtocolRowsetWriterFactory.h"
+#include "dbengine/handlers/SqlClientProtocolColumnarRowsetWriterFactory.h"
+#include "dbengine/handlers/SqlClientProtocolRowsetWriterFactory.h"
+
+// STL headers
+#include <random>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using siodb::iomgr::dbengine::Variant;
+
+/** Number of rows in the single rowset */
+constexpr std::size_t kRowCount = 10000;
+
+/** Typical mixed rowset: TRID, INT32, INT64, DOUBLE, TEXT, TIMESTAMP */
+const siodb::ColumnDataType kColumnTypes[] = {
+        siodb::COLUMN_DATA_TYPE_UINT64,
+        siodb::COLUMN_DATA_TYPE_INT32,
+        siodb::COLUMN_DATA_TYPE_INT64,
+        siodb::COLUMN_DATA_TYPE_DOUBLE,
+        siodb::COLUMN_DATA_TYPE_TEXT,
+        siodb::COLUMN_DATA_TYPE_TIMESTAMP,
+};
+
+constexpr std::size_t kColumnCount = sizeof(kColumnTypes) / sizeof(kColumnTypes[0]);
+
+std::vector<std::vector<Variant>> makeRows()
+{
+    std::mt19937_64 gen(1);
+    std::uniform_real_distribution<double> realDis(-1e6, 1e6);
+    std::vector<std::vector<Variant>> rows(kRowCount);
+    for (std::size_t i = 0; i < kRowCount; ++i) {
+        auto& row = rows[i];
+        row.reserve(kColumnCount);
+        row.emplace_back(static_cast<std::uint64_t>(i + 1));
+        row.emplace_back(static_cast<std::int32_t>(gen()));
+        row.emplace_back(static_cast<std::int64_t>(gen()));
+        row.emplace_back(realDis(gen));
+        row.emplace_back("text value \"" + std::to_string(gen() % 100000) + "\"");
+        row.emplace_back(siodb::RawDateTime(static_cast<std::time_t>(gen() % 2000000000)));
+    }
+    return rows;
+}
+
+using RowsetWriterFactoryPtr = std::unique_ptr<siodb::iomgr::dbengine::RowsetWriterFactory>;
+
+RowsetWriterFactoryPtr makeSqlRowsetWriterFactory()
+{
+    return std::make_unique<siodb::iomgr::dbengine::SqlClientProtocolRowsetWriterFactory>();
+}
+
+RowsetWriterFactoryPtr makeSqlColumnarRowsetWriterFactory()
+{
+    return std::make_unique<siodb::iomgr::dbengine::SqlClientProtocolColumnarRowsetWriterFactory>();
+}
+
+RowsetWriterFactoryPtr makeRestRowsetWriterFactory()
+{
+    return std::make_unique<siodb::iomgr::dbengine::RestProtocolRowsetWriterFactory>(false);
+}
+
+RowsetWriterFactoryPtr makeCompactRestRowsetWriterFactory()
+{
+    return std::make_unique<siodb::iomgr::dbengine::RestProtocolRowsetWriterFactory>(true);
+}
+
+RowsetWriterFactoryPtr makeGzipRestRowsetWriterFactory()
+{
+    return std::make_unique<siodb::iomgr::dbengine::RestProtocolRowsetWriterFactory>(
+            false, siodb::COMPRESSION_GZIP);
+}
+
+/** Measures writing a whole rowset with the rowset writer created by the given factory. */
+void BM_RowsetWriter(benchmark::State& state, RowsetWriterFactoryPtr (*makeFactory)())
+{
+    const auto factory = makeFactory();
+    const auto rows = makeRows();
+    const stdext::bitmask nullMask(kColumnCount, false);
+    siodb::iomgr_protocol::DatabaseEngineResponse responseTemplate;
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        const auto column = responseTemplate.add_column_description();
+        column->set_name("COLUMN_" + std::to_string(i));
+        column->set_type(kColumnTypes[i]);
+        column->set_is_nullable(i > 0);
+    }
+
+    NullOutputStream out;
+    for (auto _ : state) {
+        auto response = responseTemplate;
+        const auto writer = factory->createRowsetWriter(out);
+        writer->beginRowset(response, true);
+        for (const auto& row : rows)
+            writer->writeRow(row, nullMask);
+        writer->endRowset();
+    }
+    state.SetItemsProcessed(state.iterations() * kRowCount);
+    state.SetBytesProcessed(out.getWrittenBytes());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_RowsetWriter, sql_row, makeSqlRowsetWriterFactory)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RowsetWriter, sql_columnar, makeSqlColumnarRowsetWriterFactory)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RowsetWriter, rest_json, makeRestRowsetWriterFactory)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RowsetWriter, rest_json_compact, makeCompactRestRowsetWriterFactory)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RowsetWriter, rest_json_gzip, makeGzipRestRowsetWriterFactory)
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,202 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Common project headers
+#include <siodb/iomgr/shared/dbengine/Variant.h>
+
+// STL headers
+#include <random>
+#include <vector>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using siodb::iomgr::dbengine::Variant;
+
+constexpr std::size_t kValueCount = 1024;
+
+std::vector<Variant> makeInt32Values()
+{
+    std::mt19937 gen(1);
+    std::vector<Variant> values;
+    values.reserve(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i)
+        values.emplace_back(static_cast<std::int32_t>(gen()));
+    return values;
+}
+
+std::vector<Variant> makeInt64Values()
+{
+    std::mt19937_64 gen(2);
+    std::vector<Variant> values;
+    values.reserve(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i)
+        values.emplace_back(static_cast<std::int64_t>(gen()));
+    return values;
+}
+
+std::vector<Variant> makeDoubleValues()
+{
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dis(-1e6, 1e6);
+    std::vector<Variant> values;
+    values.reserve(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i)
+        values.emplace_back(dis(gen));
+    return values;
+}
+
+std::vector<Variant> makeStringValues()
+{
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<int> dis('a', 'z');
+    std::vector<Variant> values;
+    values.reserve(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i) {
+        // Common prefix makes comparison look past the first bytes
+        std::string s("prefix_");
+        for (int j = 0; j < 16; ++j)
+            s.push_back(static_cast<char>(dis(gen)));
+        values.emplace_back(std::move(s));
+    }
+    return values;
+}
+
+std::vector<Variant> makeDateTimeValues()
+{
+    std::mt19937 gen(5);
+    std::vector<Variant> values;
+    values.reserve(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i)
+        values.emplace_back(siodb::RawDateTime(static_cast<std::time_t>(gen())));
+    return values;
+}
+
+std::vector<Variant> makeNumericStringValues(const std::vector<Variant>& src)
+{
+    std::vector<Variant> values;
+    values.reserve(src.size());
+    for (const auto& v : src)
+        values.emplace_back(*v.asString());
+    return values;
+}
+
+/** Measures Variant::operator<() between same type values. */
+void BM_VariantLess(benchmark::State& state, std::vector<Variant> (*makeValues)())
+{
+    const auto values = makeValues();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values[i % kValueCount] < values[(i + 1) % kValueCount]);
+        ++i;
+    }
+}
+
+/** Measures Variant::operator==() between same type values. */
+void BM_VariantEqual(benchmark::State& state, std::vector<Variant> (*makeValues)())
+{
+    const auto values = makeValues();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values[i % kValueCount] == values[(i + 1) % kValueCount]);
+        ++i;
+    }
+}
+
+/** Measures Variant::compatibleLess() between values of the different numeric types. */
+void BM_VariantCompatibleLessMixed(benchmark::State& state)
+{
+    const auto values1 = makeInt32Values();
+    const auto values2 = makeDoubleValues();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                values1[i % kValueCount].compatibleLess(values2[(i + 1) % kValueCount]));
+        ++i;
+    }
+}
+
+/** Measures Variant::compatibleEqual() between 32-bit and 64-bit integers. */
+void BM_VariantCompatibleEqualMixed(benchmark::State& state)
+{
+    const auto values1 = makeInt32Values();
+    const auto values2 = makeInt64Values();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                values1[i % kValueCount].compatibleEqual(values2[(i + 1) % kValueCount]));
+        ++i;
+    }
+}
+
+/** Measures Variant::asString() */
+void BM_VariantAsString(benchmark::State& state, std::vector<Variant> (*makeValues)())
+{
+    const auto values = makeValues();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto s = values[i++ % kValueCount].asString();
+        benchmark::DoNotOptimize(s->data());
+    }
+}
+
+/** Measures Variant::asInt64() on string values */
+void BM_VariantStringAsInt64(benchmark::State& state)
+{
+    const auto values = makeNumericStringValues(makeInt64Values());
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(values[i++ % kValueCount].asInt64());
+}
+
+/** Measures Variant::asDouble() on string values */
+void BM_VariantStringAsDouble(benchmark::State& state)
+{
+    const auto values = makeNumericStringValues(makeDoubleValues());
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(values[i++ % kValueCount].asDouble());
+}
+
+/** Measures Variant::asDateTime() on string values */
+void BM_VariantStringAsDateTime(benchmark::State& state)
+{
+    const auto values = makeNumericStringValues(makeDateTimeValues());
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(values[i++ % kValueCount].asDateTime());
+}
+
+/** Measures Variant copying */
+void BM_VariantCopy(benchmark::State& state, std::vector<Variant> (*makeValues)())
+{
+    const auto values = makeValues();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Variant v(values[i++ % kValueCount]);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_VariantLess, int32, makeInt32Values);
+BENCHMARK_CAPTURE(BM_VariantLess, int64, makeInt64Values);
+BENCHMARK_CAPTURE(BM_VariantLess, double, makeDoubleValues);
+BENCHMARK_CAPTURE(BM_VariantLess, string, makeStringValues);
+BENCHMARK_CAPTURE(BM_VariantLess, timestamp, makeDateTimeValues);
+BENCHMARK_CAPTURE(BM_VariantEqual, int64, makeInt64Values);
+BENCHMARK_CAPTURE(BM_VariantEqual, string, makeStringValues);
+BENCHMARK(BM_VariantCompatibleLessMixed);
+BENCHMARK(BM_VariantCompatibleEqualMixed);
+BENCHMARK_CAPTURE(BM_VariantAsString, int64, makeInt64Values);
+BENCHMARK_CAPTURE(BM_VariantAsString, double, makeDoubleValues);
+BENCHMARK_CAPTURE(BM_VariantAsString, timestamp, makeDateTimeValues);
+BENCHMARK(BM_VariantStringAsInt64);
+BENCHMARK(BM_VariantStringAsDouble);
+BENCHMARK(BM_VariantStringAsDateTime);
+BENCHMARK_CAPTURE(BM_VariantCopy, int64, makeInt64Values);
+BENCHMARK_CAPTURE(BM_VariantCopy, string, makeStringValues);
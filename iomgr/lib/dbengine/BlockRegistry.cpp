@@ -172,6 +172,26 @@ void BlockRegistry::updateBlockState(std::uint64_t blockId, ColumnDataBlockState
     }
 }
 
+ColumnDataBlockState BlockRegistry::getBlockState(std::uint64_t blockId) const
+{
+    if (blockId == 0 || blockId > m_lastBlockId) return ColumnDataBlockState::kNotPresent;
+
+    // Read block state
+    std::uint8_t buffer[1];
+    const auto readOffset = computeBlockRecordOffset(blockId)
+                            + BlockListRecord::kBlockStateSerializedFieldOffset;
+    const auto n = ::preadExact(
+            m_blockListFile.getFD(), buffer, sizeof(buffer), readOffset, kIgnoreSignals);
+    if (n != sizeof(buffer)) {
+        const int errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotReadBlockListDataFile, __func__,
+                m_column.getDatabaseName(), m_column.getTableName(), m_column.getName(),
+                m_column.getDatabaseUuid(), m_column.getTableId(), m_column.getId(), readOffset,
+                sizeof(buffer), errorCode, std::strerror(errorCode), n);
+    }
+    return static_cast<ColumnDataBlockState>(*buffer);
+}
+
 void BlockRegistry::addNextBlock(std::uint64_t blockId, std::uint64_t nextBlockId)
 {
     BREG_DBG_LOG_DEBUG("BlockRegistry: Recording NEXT block: "
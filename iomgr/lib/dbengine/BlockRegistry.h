@@ -79,6 +79,13 @@ public:
      */
     void updateBlockState(std::uint64_t blockId, ColumnDataBlockState state) const;
 
+    /**
+     * Returns recorded block state.
+     * @param blockId Block ID.
+     * @return Block state or ColumnDataBlockState::kNotPresent if block doesn't exist.
+     */
+    ColumnDataBlockState getBlockState(std::uint64_t blockId) const;
+
     /**
      * Adds next block record.
      * @param blockId Block ID.
@@ -7,6 +7,9 @@
 // Project headers
 #include "BlockRegistry.h"
 #include "ColumnDataBlockCache.h"
+#include "ColumnDataBlockHeader.h"
+#include "ColumnDataBlockZoneMap.h"
+#include "ColumnDataReadBuffer.h"
 #include "ColumnDefinitionCache.h"
 #include "ColumnPtr.h"
 #include "IndexPtr.h"
@@ -19,7 +22,9 @@
 // STL headers
 #include <array>
 #include <map>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace siodb::iomgr::dbengine {
 
@@ -64,6 +69,35 @@ public:
         ColumnDataAddress m_nextAddress;
     };
 
+    /** Information about column data block saved into a backup */
+    struct DataBlockBackupInfo {
+        /** Block ID */
+        std::uint64_t m_blockId;
+
+        /** Previous block ID */
+        std::uint64_t m_prevBlockId;
+
+        /**
+         * Indicates that block is sealed and its data file is copied as is,
+         * i.e. compressed, if block was compressed.
+         * Otherwise, backup contains snapshot of the block data available at the moment
+         * of backup.
+         */
+        bool m_sealed;
+
+        /** Indicates that sealed block was already present in the block store */
+        bool m_alreadyStored;
+
+        /** Length of the data in the block */
+        std::uint32_t m_dataLength;
+
+        /** Block digest, valid only for the sealed blocks */
+        ColumnDataBlockHeader::Digest m_digest;
+
+        /** Backup file path */
+        std::string m_filePath;
+    };
+
 public:
     /**
      * Initializes object of class Column for a new column.
@@ -81,6 +115,9 @@ public:
      */
     Column(Table& table, const ColumnRecord& columnRecord, std::uint64_t firstUserTrid);
 
+    /** De-initializes object of class Column */
+    ~Column();
+
     DECLARE_NONCOPYABLE(Column);
 
     /**
@@ -279,6 +316,26 @@ public:
         return m_blockRegistry.getLastBlockId();
     }
 
+    /**
+     * Returns number of data block files created in advance and ready for new blocks.
+     * @return Number of ready data block files.
+     */
+    std::size_t getSpareDataFileCount() const
+    {
+        std::lock_guard lock(m_spareDataFileMutex);
+        return m_spareDataFiles.size();
+    }
+
+    /**
+     * Returns number of new blocks which took data block file created in advance.
+     * @return Number of taken data block files.
+     */
+    std::uint64_t getTakenSpareDataFileCount() const
+    {
+        std::lock_guard lock(m_spareDataFileMutex);
+        return m_takenSpareDataFileCount;
+    }
+
     /**
      * Returns indication that column doesn't allow NULL values.
      * @return true is column doesn't allow NULL values, false otherwise.
@@ -305,6 +362,12 @@ public:
     ColumnDataBlockPtr createBlock(std::uint64_t prevBlockId,
             ColumnDataBlockState state = ColumnDataBlockState::kCreating);
 
+    /**
+     * Takes data block file created in advance and schedules creation of the next one.
+     * @return Anonymous data block file with zero header or nullptr if there is no ready file.
+     */
+    io::FilePtr takeSpareDataFile();
+
     /**
      * Returns ID of the previous block in the chain for the given block
      * based on the information in the block registry.
@@ -322,6 +385,52 @@ public:
      */
     void updateBlockState(std::uint64_t blockId, ColumnDataBlockState state) const;
 
+    /**
+     * Verifies digest of the closed data block and records verification time in the block.
+     * Blocks which are not closed or were verified recently are skipped.
+     * Block data is read bypassing the block cache and hashed without holding column lock.
+     * @param blockId A block identifier.
+     * @param verifiedBefore Block is verified only if it was last verified before this time.
+     * @param[out] dataSize Size of the block data read for verification, zero if skipped.
+     * @return false if block digest doesn't match block data, true otherwise.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool verifyBlock(std::uint64_t blockId, std::time_t verifiedBefore, std::size_t& dataSize);
+
+    /**
+     * Checks zone map of the data block, if block may contain value which satisfies predicate.
+     * @param blockId A block identifier.
+     * @param predicate Predicate type. Column value is left operand.
+     * @param value Right operand, lower bound for kBetween.
+     * @param upperValue Upper bound for kBetween, ignored otherwise.
+     * @return true if block may contain matching value or has no zone map, false otherwise.
+     * @throw DatabaseError if block doesn't exist or I/O error occurs.
+     */
+    bool mayBlockContain(std::uint64_t blockId, ZoneMapPredicate predicate,
+            const Variant& value, const Variant& upperValue);
+
+    /**
+     * Starts background reading of the column data from disk, so that sequential scan
+     * doesn't wait for I/O. Continues into the next data blocks if given block
+     * has less data than requested. Errors are ignored, they are reported by the actual read.
+     * @param blockId Block identifier.
+     * @param pos Starting data position in the block.
+     * @param length Desired data length.
+     */
+    void prefetchData(std::uint64_t blockId, std::uint32_t pos, std::size_t length);
+
+    /**
+     * Saves data blocks of this column into a backup. Snapshot of the data in the open blocks
+     * is saved while column is locked. Sealed blocks are copied as is after that, without lock,
+     * into the block store shared between backups, if they are not yet present there.
+     * @param blockStoreDir Block store directory, where sealed blocks are named by their digest.
+     * @param snapshotDir Directory for the open block snapshots.
+     * @return List of saved blocks.
+     * @throw DatabaseError if operation fails for any reason
+     */
+    std::vector<DataBlockBackupInfo> backupDataBlocks(
+            const std::string& blockStoreDir, const std::string& snapshotDir);
+
     /**
      * Read data from the data file.
      * @param addr Data address.
@@ -332,6 +441,18 @@ public:
     void readRecord(
             const ColumnDataAddress& addr, Variant& value, bool lobStreamsMustHoldSource = false);
 
+    /**
+     * Read data from the data file using read buffer. Fixed width value is read
+     * together with the following data in the block, so that values stored one after
+     * another are taken from the buffer without block lookup and block read.
+     * Values of other data types are read directly.
+     * @param addr Data address.
+     * @param value Resulting value.
+     * @param readBuffer Read buffer for this column.
+     */
+    void readRecord(
+            const ColumnDataAddress& addr, Variant& value, ColumnDataReadBuffer& readBuffer);
+
     /**
      * Read master column record from the data file.
      * @param addr Data address.
@@ -379,6 +500,18 @@ public:
     std::uint32_t loadLobChunkHeader(
             std::uint64_t blockId, std::uint32_t offset, LobChunkHeader& header);
 
+    /**
+     * Loads LOB chunk header and returns block containing chunk, so that
+     * chunk data can be read without looking up block again.
+     * @param blockId Data block ID.
+     * @param offset Offset in the block.
+     * @param[out] header Chunk header.
+     * @param[out] block Data block.
+     * @return Offset after header.
+     */
+    std::uint32_t loadLobChunkHeader(std::uint64_t blockId, std::uint32_t offset,
+            LobChunkHeader& header, ColumnDataBlockPtr& block);
+
     /**
      * Reads data from block.
      * @param blockId Block ID.
@@ -389,6 +522,16 @@ public:
     void readData(
             std::uint64_t blockId, std::uint32_t offset, void* buffer, std::size_t bufferSize);
 
+    /**
+     * Reads data from already loaded block.
+     * @param block Data block.
+     * @param offset Offset in block.
+     * @param[out] buffer Output buffer.
+     * @param bufferSize Size of buffer.
+     */
+    void readData(const ColumnDataBlock& block, std::uint32_t offset, void* buffer,
+            std::size_t bufferSize);
+
     /**
      * Generates next TRID from the user TRID range.
      * @return Next user record TRID.
@@ -608,9 +751,18 @@ private:
      * @param block Current block.
      * @param requiredFreeSpace Required free space in block, must be nonzero and not exceed
      *                          max data size in the block.
+     * @param finalize Indicates that current block should be finalized. Otherwise caller
+     *                 must finalize it with finalizeBlock().
      * @return New block.
      */
-    ColumnDataBlockPtr createOrGetNextBlock(ColumnDataBlock& block, std::size_t requiredFreeSpace);
+    ColumnDataBlockPtr createOrGetNextBlock(
+            ColumnDataBlock& block, std::size_t requiredFreeSpace, bool finalize = true);
+
+    /**
+     * Computes block digest and closes block.
+     * @param block A block.
+     */
+    void finalizeBlock(ColumnDataBlock& block);
 
     /**
      * Gets existing block into memory and returns cached object.
@@ -620,6 +772,15 @@ private:
      */
     ColumnDataBlockPtr findExistingBlock(std::uint64_t blockId);
 
+    /**
+     * Returns cached block object if block is cached, otherwise reads block into
+     * new object which is not put into the block cache. Assumes column is already locked.
+     * @param blockId Block ID.
+     * @return Block object.
+     * @throw DatabaseError if block can't be read.
+     */
+    ColumnDataBlockPtr getBlockWithoutCaching(std::uint64_t blockId);
+
     /**
      * Finds first block on disk.
      * @return First block ID or 0 if there are no blocks.
@@ -645,6 +806,23 @@ private:
      */
     WriteRecordResult writeLob(LobStream& lob, ColumnDataBlockPtr block);
 
+    /**
+     * Decodes fixed width value.
+     * @param data Serialized value.
+     * @param[out] value Output value.
+     */
+    void decodeFixedWidthValue(const std::uint8_t* data, Variant& value) const;
+
+    /**
+     * Returns indication that column values have fixed width.
+     * @return true if column data type has fixed width, false otherwise.
+     */
+    bool hasFixedWidthValues() const noexcept
+    {
+        // Data types BOOL to DOUBLE are fixed width
+        return m_dataType <= COLUMN_DATA_TYPE_DOUBLE;
+    }
+
     /**
      * Loads TEXT data.
      * @param addr Data address.
@@ -711,6 +889,13 @@ private:
     std::unique_ptr<MasterColumnData> maybeCreateMasterColumnData(
             bool create, std::uint64_t firstUserTrid);
 
+    /**
+     * Creates data block files in advance until configured number of them is ready
+     * or instance-wide limit of such files is reached.
+     * Runs in the background thread, errors are logged.
+     */
+    void prepareSpareDataFiles();
+
 private:
     /** Table to which this column belongs */
     Table& m_table;
@@ -770,9 +955,24 @@ private:
     /** Last block ID */
     std::atomic<std::uint64_t> m_lastBlockId;
 
+    /** Number of data rollbacks, invalidates read buffers */
+    std::atomic<std::uint64_t> m_rollbackCount;
+
     /** Cached blocks */
     ColumnDataBlockCache m_blockCache;
 
+    /** Data block files created in advance */
+    std::vector<io::FilePtr> m_spareDataFiles;
+
+    /** Indicates that creation of the data block files in advance is scheduled */
+    bool m_spareDataFilePreparationScheduled;
+
+    /** Number of data block files created in advance and taken by new blocks */
+    std::uint64_t m_takenSpareDataFileCount;
+
+    /** Spare data block files access synchronization object */
+    mutable std::mutex m_spareDataFileMutex;
+
     /** Minimum required block free spaces for various column data type */
     static const std::array<std::uint32_t, ColumnDataType_MAX> s_minRequiredBlockFreeSpaces;
 
@@ -818,6 +1018,9 @@ private:
 
     /** Column definition cache capacity */
     static constexpr std::size_t kColumnDefinitionCacheCapacity = 10;
+
+    /** Maximum number of next data blocks touched by a single prefetch */
+    static constexpr std::size_t kMaxPrefetchNextBlockCount = 2;
 };
 
 }  // namespace siodb::iomgr::dbengine
@@ -6,6 +6,7 @@
 
 // Project headers
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "Instance.h"
 #include "ThrowDatabaseError.h"
 
 // Common project headers
@@ -24,17 +25,41 @@
 #include <cstring>
 
 // STL headers
+#include <algorithm>
 #include <sstream>
 
 // System headers
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 // OpenSSL
 #include <openssl/sha.h>
 
 namespace siodb::iomgr::dbengine {
 
+namespace {
+
+/**
+ * Returns record size used for delta encoding of the block data.
+ * @param dataType Column data type.
+ * @return Record size or zero if column values don't have fixed size.
+ */
+std::size_t getDeltaRecordSize(ColumnDataType dataType) noexcept
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_INT16:
+        case COLUMN_DATA_TYPE_UINT16: return 2;
+        case COLUMN_DATA_TYPE_INT32:
+        case COLUMN_DATA_TYPE_UINT32: return 4;
+        case COLUMN_DATA_TYPE_INT64:
+        case COLUMN_DATA_TYPE_UINT64: return 8;
+        default: return 0;
+    }
+}
+
+}  // anonymous namespace
+
 const BinaryValue ColumnDataBlock::s_dataFileHeaderProto(kDataFileHeaderSize, 0);
 
 ColumnDataBlock::ColumnDataBlock(
@@ -48,8 +73,18 @@ ColumnDataBlock::ColumnDataBlock(
     , m_state(state)
     , m_headerModified(false)
     , m_dataModified(false)
+    , m_digestedDataLength(0)
+    , m_digestLimit(kNoDigestLimit)
 {
     loadHeader();
+    loadDigestState();
+    // Zone map must cover all values, so it can be started only in a new block
+    if (!m_column.isMasterColumn()
+            && ColumnDataBlockZoneMap::isDataTypeSupported(m_column.getDataType())) {
+        m_header.m_hasZoneMap = true;
+        m_headerModified = true;
+    }
+    loadZoneMap();
 }
 
 ColumnDataBlock::ColumnDataBlock(Column& column, std::uint64_t id)
@@ -62,8 +97,12 @@ ColumnDataBlock::ColumnDataBlock(Column& column, std::uint64_t id)
     , m_state(ColumnDataBlockState::kCreating)
     , m_headerModified(false)
     , m_dataModified(false)
+    , m_digestedDataLength(0)
+    , m_digestLimit(kNoDigestLimit)
 {
     loadHeader();
+    loadDigestState();
+    loadZoneMap();
 }
 
 ColumnDataBlock::~ColumnDataBlock()
@@ -97,7 +136,28 @@ void ColumnDataBlock::setNextDataPos(std::uint32_t pos)
         throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorInvalidPositionForColumnDataBlock,
                 pos, m_column.getDataBlockDataAreaSize());
     }
+    // Rolled back data must be writable
+    if (isCompressed() && pos != m_header.m_nextDataOffset) decompress();
     m_header.m_nextDataOffset = pos;
+    // Digested data is rolled back
+    if (pos < m_digestedDataLength) resetDigestState();
+    // Data which digest was limited for is rolled back
+    if (pos <= m_digestLimit) m_digestLimit = kNoDigestLimit;
+}
+
+void ColumnDataBlock::updateZoneMap(const Variant& value)
+{
+    if (!m_zoneMap) return;
+    if (m_zoneMap->update(value)) {
+        m_header.m_zoneMapValueCount = m_zoneMap->getValueCount();
+        m_zoneMap->serialize(m_column.getDataType(), m_header.m_zoneMapMinValue.data(),
+                m_header.m_zoneMapMaxValue.data());
+    } else {
+        // Value can't be ordered, block can't be skipped anymore
+        m_zoneMap.reset();
+        m_header.m_hasZoneMap = false;
+    }
+    m_headerModified = true;
 }
 
 void ColumnDataBlock::readData(void* data, std::size_t length, std::uint32_t pos) const
@@ -109,6 +169,19 @@ void ColumnDataBlock::readData(void* data, std::size_t length, std::uint32_t pos
                         + std::to_string(m_column.getDataBlockDataAreaSize() - 1),
                 0);
     }
+    if (isCompressed()) {
+        // Compressed block contains only data up to the next data position
+        if (pos + length > m_header.m_nextDataOffset) {
+            throwDatabaseErrorForThisObject(
+                    IOManagerMessageId::kErrorCannotReadColumnDataBlockFile, pos, length, -1,
+                    "invalid offset or length, sum exceeds "
+                            + std::to_string(m_header.m_nextDataOffset),
+                    0);
+        }
+        loadUncompressedData();
+        std::memcpy(data, m_uncompressedData.data() + pos, length);
+        return;
+    }
     const auto readOffset = pos + m_header.m_dataAreaOffset;
     const auto n = m_file->read(static_cast<std::uint8_t*>(data), length, readOffset);
     if (n != length) {
@@ -118,6 +191,19 @@ void ColumnDataBlock::readData(void* data, std::size_t length, std::uint32_t pos
     }
 }
 
+std::size_t ColumnDataBlock::prefetchData(std::uint32_t pos, std::size_t length) const noexcept
+{
+    if (pos >= m_header.m_nextDataOffset) return 0;
+    length = std::min<std::size_t>(length, m_header.m_nextDataOffset - pos);
+    if (isCompressed()) {
+        // Compressed block is read at once
+        if (m_uncompressedData.empty())
+            m_file->prefetch(m_header.m_dataAreaOffset, m_header.m_compressedDataSize);
+    } else
+        m_file->prefetch(m_header.m_dataAreaOffset + pos, length);
+    return length;
+}
+
 void ColumnDataBlock::writeData(const void* data, std::size_t length, std::uint32_t pos)
 {
     if (pos + length > m_column.getDataBlockDataAreaSize()) {
@@ -127,6 +213,7 @@ void ColumnDataBlock::writeData(const void* data, std::size_t length, std::uint3
                         + std::to_string(m_column.getDataBlockDataAreaSize() - 1),
                 0);
     }
+    if (isCompressed()) decompress();
     const auto writeOffset = pos + m_header.m_dataAreaOffset;
     const auto n = m_file->write(static_cast<const std::uint8_t*>(data), length, writeOffset);
     if (n != length) {
@@ -135,6 +222,16 @@ void ColumnDataBlock::writeData(const void* data, std::size_t length, std::uint3
                 n);
     }
     m_dataModified = true;
+
+    // Data is normally appended, so digest can be updated right away.
+    // Data written past digested one or past digest limit is read back
+    // when block is finalized.
+    if (pos == m_digestedDataLength && pos + length <= m_digestLimit) {
+        ::SHA256_Update(&m_digestContext, data, length);
+        m_digestedDataLength += length;
+        saveDigestState();
+    } else if (pos < m_digestedDataLength)
+        resetDigestState();
 }
 
 void ColumnDataBlock::finalize(const ColumnDataBlockHeader::Digest& prevBlockDigest)
@@ -142,46 +239,128 @@ void ColumnDataBlock::finalize(const ColumnDataBlockHeader::Digest& prevBlockDig
     m_state = ColumnDataBlockState::kClosing;
     m_column.updateBlockState(getId(), m_state);
     m_header.m_fillTimestamp = std::time(nullptr);
-    computeDigest(prevBlockDigest, m_header.m_digest);
+    if (m_header.m_version >= ColumnDataBlockHeader::kIncrementalDigestVersion) {
+        if (m_digestedDataLength > m_header.m_nextDataOffset) resetDigestState();
+        updateDigest(m_digestContext, m_digestedDataLength, m_header.m_nextDataOffset);
+        m_digestedDataLength = m_header.m_nextDataOffset;
+        saveDigestState();
+        auto ctx = m_digestContext;
+        updateDigestWithHeader(ctx, prevBlockDigest);
+        ::SHA256_Final(m_header.m_digest.data(), &ctx);
+    } else
+        computeDigest(prevBlockDigest, m_header.m_digest);
     m_headerModified = true;
     writeHeader();
     m_state = ColumnDataBlockState::kClosed;
     m_column.updateBlockState(getId(), m_state);
 }
 
-void ColumnDataBlock::computeDigest(const ColumnDataBlockHeader::Digest& prevBlockDigest,
-        ColumnDataBlockHeader::Digest& blockDigest) const
+bool ColumnDataBlock::compress(int level)
 {
-    // Serialize significant data from header
-    std::uint8_t headerData[ColumnDataBlockHeader::kSerializedSize];
     const auto dataLength = m_header.m_nextDataOffset;
-    std::uint8_t* p = headerData;
-    p = pbeEncodeBinary(m_header.m_fullColumnDataBlockId.m_databaseUuid.data,
-            m_header.m_fullColumnDataBlockId.m_databaseUuid.size(), p);
-    p = pbeEncodeUInt32(m_header.m_fullColumnDataBlockId.m_tableId, p);
-    p = pbeEncodeUInt32(m_header.m_fullColumnDataBlockId.m_columnId, p);
-    p = pbeEncodeUInt64(m_header.m_fullColumnDataBlockId.m_blockId, p);
-    p = pbeEncodeInt64(m_header.m_fillTimestamp, p);
-    p = pbeEncodeUInt32(dataLength, p);
+    if (isCompressed() || m_header.m_fillTimestamp == 0 || dataLength == 0) return false;
+
+    std::vector<std::uint8_t> data(dataLength);
+    readData(data.data(), dataLength, 0);
+    const auto deltaRecordSize = getDeltaRecordSize(m_column.getDataType());
+    std::vector<std::uint8_t> compressedData;
+    const auto compressionType = compressColumnDataBlockData(
+            data.data(), dataLength, deltaRecordSize, level, compressedData);
+    if (compressionType == ColumnDataBlockCompressionType::kNone) return false;
+
+    auto header = m_header;
+    header.m_compressionType = compressionType;
+    header.m_deltaRecordSize =
+            compressionType == ColumnDataBlockCompressionType::kDeltaDeflate ? deltaRecordSize
+                                                                             : 0;
+    header.m_compressedDataSize = compressedData.size();
+    replaceDataFile(header, compressedData.data(), compressedData.size(), compressedData.size());
+    // Data is likely to be read soon, keep it
+    m_uncompressedData.swap(data);
+    LOG_DEBUG << "Compressed ColumnDataBlock " << makeDisplayName() << " from " << dataLength
+              << " to " << header.m_compressedDataSize << " bytes";
+    return true;
+}
 
-    // Compute digest
+void ColumnDataBlock::saveCopy(const std::string& path) const
+{
+    const auto dataLength = m_header.m_nextDataOffset;
+    io::FilePtr file;
+    try {
+        file = m_column.getDatabase().createFile(
+                path, 0, kDataFileCreationMode, m_header.m_dataAreaOffset + dataLength);
+    } catch (std::system_error& ex) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotCreateColumnDataBlockFile,
+                path, "Can't create block copy file", ex.code().value(),
+                std::strerror(ex.code().value()));
+    }
+
+    // Write header. Copy contains uncompressed data.
+    std::vector<std::uint8_t> buffer(
+            std::max<std::size_t>(m_header.m_dataAreaOffset, kBlockCopyBufferSize));
+    auto header = m_header;
+    header.m_compressionType = ColumnDataBlockCompressionType::kNone;
+    header.m_deltaRecordSize = 0;
+    header.m_compressedDataSize = 0;
+    header.serialize(buffer.data());
+    std::memset(buffer.data() + ColumnDataBlockHeader::kSerializedSize, 0,
+            m_header.m_dataAreaOffset - ColumnDataBlockHeader::kSerializedSize);
+    auto n = file->write(buffer.data(), m_header.m_dataAreaOffset, 0);
+    if (n != m_header.m_dataAreaOffset) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile,
+                0, m_header.m_dataAreaOffset, file->getLastError(),
+                std::strerror(file->getLastError()), n);
+    }
+
+    // Copy data
+    for (std::uint32_t pos = 0; pos < dataLength;) {
+        const auto length = std::min<std::size_t>(dataLength - pos, buffer.size());
+        readData(buffer.data(), length, pos);
+        const auto writeOffset = m_header.m_dataAreaOffset + pos;
+        n = file->write(buffer.data(), length, writeOffset);
+        if (n != length) {
+            throwDatabaseErrorForThisObject(
+                    IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile, writeOffset,
+                    length, file->getLastError(), std::strerror(file->getLastError()), n);
+        }
+        pos += length;
+    }
+
+    if (!file->flush()) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile,
+                0, m_header.m_dataAreaOffset + dataLength, file->getLastError(),
+                std::strerror(file->getLastError()), 0);
+    }
+}
+
+void ColumnDataBlock::computeDigest(const ColumnDataBlockHeader::Digest& prevBlockDigest,
+        ColumnDataBlockHeader::Digest& blockDigest) const
+{
     ::SHA256_CTX ctx;
     ::SHA256_Init(&ctx);
-    ::SHA256_Update(&ctx, prevBlockDigest.data(), prevBlockDigest.size());
-    ::SHA256_Update(&ctx, headerData, p - headerData);
-    if (dataLength > 0) {
-        std::vector<std::uint8_t> buffer(dataLength);
-        const auto n = m_file->read(buffer.data(), dataLength, m_header.m_dataAreaOffset);
-        if (n != dataLength) {
-            throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotReadColumnDataBlockFile,
-                    m_header.m_dataAreaOffset, dataLength, m_file->getLastError(),
-                    std::strerror(m_file->getLastError()), n);
-        }
-        ::SHA256_Update(&ctx, buffer.data(), dataLength);
+    if (m_header.m_version >= ColumnDataBlockHeader::kIncrementalDigestVersion) {
+        updateDigest(ctx, 0, m_header.m_nextDataOffset);
+        updateDigestWithHeader(ctx, prevBlockDigest);
+    } else {
+        updateDigestWithHeader(ctx, prevBlockDigest);
+        updateDigest(ctx, 0, m_header.m_nextDataOffset);
     }
     ::SHA256_Final(blockDigest.data(), &ctx);
 }
 
+io::FilePtr ColumnDataBlock::createSpareDataFile(Column& column)
+{
+    auto file = column.getDatabase().createFile(column.getDataDir(), O_DSYNC | O_TMPFILE,
+            kDataFileCreationMode,
+            column.getDataBlockDataAreaSize() + ColumnDataBlockHeader::kDefaultDataAreaOffset);
+    const auto n = file->write(s_dataFileHeaderProto.data(), s_dataFileHeaderProto.size(), 0);
+    if (n != s_dataFileHeaderProto.size()) {
+        throw std::system_error(file->getLastError(), std::generic_category(),
+                "Can't write header of the spare data block file");
+    }
+    return file;
+}
+
 // ---- internals ----
 
 io::FilePtr ColumnDataBlock::createDataFile() const
@@ -191,24 +370,29 @@ io::FilePtr ColumnDataBlock::createDataFile() const
 
     std::string tmpFilePath;
 
-    // Create data file as temporary file
-    constexpr int kBaseExtraOpenFlags = O_DSYNC;
-    io::FilePtr file;
-    try {
+    // Use file created in advance, if column fills blocks and such file is ready
+    io::FilePtr file = (m_prevBlockId != 0) ? m_column.takeSpareDataFile() : nullptr;
+    const bool isSpareFile = file != nullptr;
+
+    if (!isSpareFile) {
+        // Create data file as temporary file
+        constexpr int kBaseExtraOpenFlags = O_DSYNC;
         try {
-            file = m_column.getDatabase().createFile(m_column.getDataDir(),
-                    kBaseExtraOpenFlags | O_TMPFILE, kDataFileCreationMode, getDataFileSize());
+            try {
+                file = m_column.getDatabase().createFile(m_column.getDataDir(),
+                        kBaseExtraOpenFlags | O_TMPFILE, kDataFileCreationMode, getDataFileSize());
+            } catch (std::system_error& ex) {
+                if (ex.code().value() != ENOTSUP) throw;
+                // O_TMPFILE not supported, fallback to the named temporary file
+                tmpFilePath = m_dataFilePath + kTempFileExtension;
+                file = m_column.getDatabase().createFile(
+                        tmpFilePath, kBaseExtraOpenFlags, kDataFileCreationMode, getDataFileSize());
+            }
         } catch (std::system_error& ex) {
-            if (ex.code().value() != ENOTSUP) throw;
-            // O_TMPFILE not supported, fallback to the named temporary file
-            tmpFilePath = m_dataFilePath + kTempFileExtension;
-            file = m_column.getDatabase().createFile(
-                    tmpFilePath, kBaseExtraOpenFlags, kDataFileCreationMode, getDataFileSize());
+            throwDatabaseErrorForThisObject(
+                    IOManagerMessageId::kErrorCannotCreateColumnDataBlockFile, m_dataFilePath,
+                    "Can't create new file", ex.code().value(), std::strerror(ex.code().value()));
         }
-    } catch (std::system_error& ex) {
-        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotCreateColumnDataBlockFile,
-                m_dataFilePath, "Can't create new file", ex.code().value(),
-                std::strerror(ex.code().value()));
     }
 
     // Prepare and write header
@@ -223,12 +407,16 @@ io::FilePtr ColumnDataBlock::createDataFile() const
                 file->getLastError(), sizeof(buffer), std::strerror(file->getLastError()), n);
     }
 
-    // Write rest of header
-    n = file->write(s_dataFileHeaderProto.data(), remainingHeaderSize, sizeof(buffer));
-    if (n != remainingHeaderSize) {
-        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile,
-                m_column.getDatabaseUuid(), m_column.getTableId(), m_column.getId(), sizeof(buffer),
-                remainingHeaderSize, file->getLastError(), std::strerror(file->getLastError()), n);
+    // Write rest of header, spare file already has it
+    if (!isSpareFile) {
+        n = file->write(s_dataFileHeaderProto.data(), remainingHeaderSize, sizeof(buffer));
+        if (n != remainingHeaderSize) {
+            throwDatabaseErrorForThisObject(
+                    IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile,
+                    m_column.getDatabaseUuid(), m_column.getTableId(), m_column.getId(),
+                    sizeof(buffer), remainingHeaderSize, file->getLastError(),
+                    std::strerror(file->getLastError()), n);
+        }
     }
 
     if (tmpFilePath.empty()) {
@@ -252,6 +440,8 @@ io::FilePtr ColumnDataBlock::createDataFile() const
         }
     }
 
+    file->attachToDescriptorCache(
+            m_column.getDatabase().getInstance().getFileDescriptorCache(), m_dataFilePath);
     return file;
 }
 
@@ -264,6 +454,8 @@ io::FilePtr ColumnDataBlock::openDataFile() const
         throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotOpenColumnDataBlockFile,
                 m_dataFilePath, ex.code().value(), ex.what());
     }
+    file->attachToDescriptorCache(
+            m_column.getDatabase().getInstance().getFileDescriptorCache(), m_dataFilePath);
     return file;
 }
 
@@ -284,10 +476,10 @@ void ColumnDataBlock::loadHeader()
     }
 
     ColumnDataBlockHeader header;
-    header.deserialize(buffer);
+    const bool headerDecoded = header.deserialize(buffer) != nullptr;
 
     // Validate header
-    if (header.m_version > ColumnDataBlockHeader::kCurrentVersion
+    if (!headerDecoded || header.m_version > ColumnDataBlockHeader::kCurrentVersion
             || header.m_fullColumnDataBlockId != m_header.m_fullColumnDataBlockId) {
         throwDatabaseErrorForThisObject(
                 IOManagerMessageId::kErrorInvalidDataFileHeader, header.m_version);
@@ -296,6 +488,101 @@ void ColumnDataBlock::loadHeader()
     m_header = header;
 }
 
+void ColumnDataBlock::replaceDataFile(const ColumnDataBlockHeader& header,
+        const std::uint8_t* data, std::size_t length, std::size_t dataAreaSize)
+{
+    const auto tmpFilePath = m_dataFilePath + kTempFileExtension;
+    // Temporary file may be left after crash
+    ::unlink(tmpFilePath.c_str());
+
+    io::FilePtr file;
+    try {
+        file = m_column.getDatabase().createFile(tmpFilePath, O_DSYNC, kDataFileCreationMode,
+                header.m_dataAreaOffset + dataAreaSize);
+    } catch (std::system_error& ex) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotCreateColumnDataBlockFile,
+                tmpFilePath, "Can't create new file", ex.code().value(),
+                std::strerror(ex.code().value()));
+    }
+
+    std::vector<std::uint8_t> headerBuffer(header.m_dataAreaOffset, 0);
+    header.serialize(headerBuffer.data());
+    auto n = file->write(headerBuffer.data(), headerBuffer.size(), 0);
+    if (n != headerBuffer.size()) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile,
+                0, headerBuffer.size(), file->getLastError(),
+                std::strerror(file->getLastError()), n);
+    }
+
+    n = file->write(data, length, header.m_dataAreaOffset);
+    if (n != length) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotWriteColumnDataBlockFile,
+                header.m_dataAreaOffset, length, file->getLastError(),
+                std::strerror(file->getLastError()), n);
+    }
+
+    if (::rename(tmpFilePath.c_str(), m_dataFilePath.c_str()) < 0) {
+        const int errorCode = errno;
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotCreateColumnDataBlockFile,
+                m_dataFilePath, "Can't rename temporary file to the regular one", errorCode,
+                std::strerror(errorCode));
+    }
+
+    file->attachToDescriptorCache(
+            m_column.getDatabase().getInstance().getFileDescriptorCache(), m_dataFilePath);
+    m_file = std::move(file);
+    m_header = header;
+    m_headerModified = false;
+    m_dataModified = false;
+}
+
+void ColumnDataBlock::decompress()
+{
+    loadUncompressedData();
+    auto header = m_header;
+    header.m_compressionType = ColumnDataBlockCompressionType::kNone;
+    header.m_deltaRecordSize = 0;
+    header.m_compressedDataSize = 0;
+    replaceDataFile(header, m_uncompressedData.data(), m_uncompressedData.size(),
+            m_column.getDataBlockDataAreaSize());
+    std::vector<std::uint8_t>().swap(m_uncompressedData);
+    LOG_DEBUG << "Decompressed ColumnDataBlock " << makeDisplayName();
+}
+
+void ColumnDataBlock::loadUncompressedData() const
+{
+    if (m_uncompressedData.size() == m_header.m_nextDataOffset) return;
+
+    std::vector<std::uint8_t> compressedData(m_header.m_compressedDataSize);
+    const auto n =
+            m_file->read(compressedData.data(), compressedData.size(), m_header.m_dataAreaOffset);
+    if (n != compressedData.size()) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotReadColumnDataBlockFile,
+                m_header.m_dataAreaOffset, compressedData.size(), m_file->getLastError(),
+                std::strerror(m_file->getLastError()), n);
+    }
+
+    std::vector<std::uint8_t> data(m_header.m_nextDataOffset);
+    if (!decompressColumnDataBlockData(m_header.m_compressionType, compressedData.data(),
+                compressedData.size(), m_header.m_deltaRecordSize, data)) {
+        throwDatabaseErrorForThisObject(IOManagerMessageId::kErrorCannotReadColumnDataBlockFile,
+                m_header.m_dataAreaOffset, compressedData.size(), -1,
+                "compressed data is corrupted", n);
+    }
+    m_uncompressedData.swap(data);
+}
+
+void ColumnDataBlock::loadZoneMap()
+{
+    m_zoneMap.reset();
+    if (!m_header.m_hasZoneMap
+            || !ColumnDataBlockZoneMap::isDataTypeSupported(m_column.getDataType()))
+        return;
+    m_zoneMap.emplace();
+    m_zoneMap->deserialize(m_column.getDataType(), m_header.m_zoneMapValueCount,
+            m_header.m_zoneMapMinValue.data(), m_header.m_zoneMapMaxValue.data());
+}
+
 void ColumnDataBlock::writeHeader() const
 {
     uint8_t header[ColumnDataBlockHeader::kSerializedSize];
@@ -308,6 +595,71 @@ void ColumnDataBlock::writeHeader() const
     m_headerModified = false;
 }
 
+void ColumnDataBlock::loadDigestState() noexcept
+{
+    ::SHA256_Init(&m_digestContext);
+    m_digestedDataLength = 0;
+    const auto length = m_header.m_digestedDataLength;
+    if (m_header.m_version < ColumnDataBlockHeader::kIncrementalDigestVersion || length == 0
+            || length > m_header.m_nextDataOffset || length % SHA256_CBLOCK != 0)
+        return;
+    std::copy(m_header.m_digestState.cbegin(), m_header.m_digestState.cend(), m_digestContext.h);
+    const std::uint64_t bitLength = static_cast<std::uint64_t>(length) * 8;
+    m_digestContext.Nl = static_cast<SHA_LONG>(bitLength);
+    m_digestContext.Nh = static_cast<SHA_LONG>(bitLength >> 32);
+    m_digestedDataLength = length;
+}
+
+void ColumnDataBlock::saveDigestState() noexcept
+{
+    // Context keeps incomplete SHA-256 block in the internal buffer,
+    // only state after the last complete block is saved.
+    m_header.m_digestedDataLength = m_digestedDataLength - m_digestContext.num;
+    std::copy(std::begin(m_digestContext.h), std::end(m_digestContext.h),
+            m_header.m_digestState.begin());
+    m_headerModified = true;
+}
+
+void ColumnDataBlock::resetDigestState()
+{
+    const bool stateSaved = m_header.m_digestedDataLength > 0;
+    ::SHA256_Init(&m_digestContext);
+    m_digestedDataLength = 0;
+    saveDigestState();
+    // Saved state must not be applied to the data which will be written instead
+    if (stateSaved) writeHeader();
+}
+
+void ColumnDataBlock::updateDigest(::SHA256_CTX& ctx, std::uint32_t from, std::uint32_t to) const
+{
+    if (from >= to) return;
+    std::vector<std::uint8_t> buffer(std::min<std::size_t>(to - from, kBlockCopyBufferSize));
+    for (auto pos = from; pos < to;) {
+        const auto length = std::min<std::size_t>(to - pos, buffer.size());
+        readData(buffer.data(), length, pos);
+        ::SHA256_Update(&ctx, buffer.data(), length);
+        pos += length;
+    }
+}
+
+void ColumnDataBlock::updateDigestWithHeader(
+        ::SHA256_CTX& ctx, const ColumnDataBlockHeader::Digest& prevBlockDigest) const
+{
+    // Serialize significant data from header
+    std::uint8_t headerData[ColumnDataBlockHeader::kSerializedSize];
+    std::uint8_t* p = headerData;
+    p = pbeEncodeBinary(m_header.m_fullColumnDataBlockId.m_databaseUuid.data,
+            m_header.m_fullColumnDataBlockId.m_databaseUuid.size(), p);
+    p = pbeEncodeUInt32(m_header.m_fullColumnDataBlockId.m_tableId, p);
+    p = pbeEncodeUInt32(m_header.m_fullColumnDataBlockId.m_columnId, p);
+    p = pbeEncodeUInt64(m_header.m_fullColumnDataBlockId.m_blockId, p);
+    p = pbeEncodeInt64(m_header.m_fillTimestamp, p);
+    p = pbeEncodeUInt32(m_header.m_nextDataOffset, p);
+
+    ::SHA256_Update(&ctx, prevBlockDigest.data(), prevBlockDigest.size());
+    ::SHA256_Update(&ctx, headerData, p - headerData);
+}
+
 template<class MessageId, class... Args>
 [[noreturn]] void ColumnDataBlock::throwDatabaseErrorForThisObject(
         MessageId messageId, Args&&... args) const
@@ -8,11 +8,23 @@
 #include "Column.h"
 #include "ColumnDataBlockHeader.h"
 #include "ColumnDataBlockPtr.h"
+#include "ColumnDataBlockZoneMap.h"
 
 // Common project headers
 #include <siodb/common/utils/FDGuard.h>
 #include <siodb/common/utils/HelperMacros.h>
 
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <limits>
+#include <optional>
+#include <vector>
+
+// OpenSSL
+#include <openssl/sha.h>
+
 namespace siodb::iomgr::dbengine {
 
 /** Column data block */
@@ -96,6 +108,40 @@ public:
         return m_header.m_digest;
     }
 
+    /**
+     * Returns time when block digest was last verified.
+     * @return Last verification timestamp or zero if block was never verified.
+     */
+    std::time_t getLastVerificationTimestamp() const noexcept
+    {
+        return static_cast<std::time_t>(m_header.m_lastVerificationTimestamp);
+    }
+
+    /**
+     * Sets time when block digest was last verified.
+     * @param timestamp Verification timestamp.
+     */
+    void setLastVerificationTimestamp(std::time_t timestamp) noexcept
+    {
+        m_header.m_lastVerificationTimestamp = timestamp;
+        m_headerModified = true;
+    }
+
+    /**
+     * Returns zone map.
+     * @return Zone map or nullptr if block doesn't have it.
+     */
+    const ColumnDataBlockZoneMap* getZoneMap() const noexcept
+    {
+        return m_zoneMap ? &*m_zoneMap : nullptr;
+    }
+
+    /**
+     * Adds value written to the block to the zone map.
+     * @param value A value of the column data type.
+     */
+    void updateZoneMap(const Variant& value);
+
     /**
      * Returns data file path.
      * @return data file path.
@@ -168,12 +214,42 @@ public:
         setNextDataPos(m_header.m_nextDataOffset + n);
     }
 
+    /**
+     * Stops updating digest while data is written, starting from the given position.
+     * Used for data that may be overwritten before block is finalized,
+     * such data is read back on finalization. Limit is dropped when data is rolled back
+     * to the given position.
+     * @param pos Data position.
+     */
+    void limitDigest(std::uint32_t pos) noexcept
+    {
+        m_digestLimit = pos;
+    }
+
+    /**
+     * Returns fill timestamp.
+     * @return Fill timestamp, nonzero value indicates that block is full.
+     */
+    std::uint64_t getFillTimestamp() const noexcept
+    {
+        return m_header.m_fillTimestamp;
+    }
+
     /** Resets fill timestemp to zero */
     void resetFillTimestamp() noexcept
     {
         m_header.m_fillTimestamp = 0;
     }
 
+    /**
+     * Returns indication that block data is compressed.
+     * @return true if block data is compressed, false otherwise.
+     */
+    bool isCompressed() const noexcept
+    {
+        return m_header.m_compressionType != ColumnDataBlockCompressionType::kNone;
+    }
+
     /** Saves header */
     void writeHeader() const;
 
@@ -185,6 +261,15 @@ public:
      */
     void readData(void* data, std::size_t length, std::uint32_t pos) const;
 
+    /**
+     * Starts background reading of the written data from disk.
+     * @param pos Starting data position.
+     * @param length Desired data length.
+     * @return Length of the data available in this block starting at a given position,
+     *         which is covered by the request.
+     */
+    std::size_t prefetchData(std::uint32_t pos, std::size_t length) const noexcept;
+
     /**
      * Writes data to the data file at a given position.
      * @param data A data.
@@ -224,19 +309,76 @@ public:
 
     /**
      * Finalizes block - put fill timestamp and adds data digest.
+     * Digest is completed from the state maintained while data was written,
+     * only data not covered by that state is read back from the file.
      * @param prevBlockDigest Digest of a previous block.
      */
     void finalize(const ColumnDataBlockHeader::Digest& prevBlockDigest);
 
     /**
-     * Computes block digest. Assumes block has data.
+     * Compresses data of the finalized block. Data file is replaced with the file
+     * which contains only compressed data. Block stays uncompressed if data
+     * doesn't compress well.
+     * @param level Compression level, 1 to 9.
+     * @return true if block has been compressed, false otherwise.
+     * @throw DatabaseError if data file can't be replaced.
+     */
+    bool compress(int level);
+
+    /**
+     * Saves copy of the header and currently available data of this block into a new file,
+     * encrypted in the same way as the data file.
+     * @param path Destination file path.
+     * @throw DatabaseError if operation fails for any reason
+     */
+    void saveCopy(const std::string& path) const;
+
+    /**
+     * Computes block digest from the whole block data. Assumes block has data.
      * @param prevBlockDigest Digest of a previous block.
      * @param[out] blockDigest Computed current block digest.
      */
     void computeDigest(const ColumnDataBlockHeader::Digest& prevBlockDigest,
             ColumnDataBlockHeader::Digest& blockDigest) const;
 
+    /**
+     * Creates anonymous preallocated data file with zero header for a future block
+     * of the given column. New block only writes its header and links file to the filesystem.
+     * @param column Column object.
+     * @return File object.
+     * @throw std::system_error if file can't be created or written.
+     */
+    static io::FilePtr createSpareDataFile(Column& column);
+
 private:
+    /** Restores digest context from the digest state saved in the header */
+    void loadDigestState() noexcept;
+
+    /** Saves digest context state into the header */
+    void saveDigestState() noexcept;
+
+    /**
+     * Discards digested data, so that digest is computed from the beginning of the data.
+     * @throw DatabaseError if header write fails.
+     */
+    void resetDigestState();
+
+    /**
+     * Adds block data in the given range to the digest.
+     * @param ctx Digest context.
+     * @param from Start data position.
+     * @param to End data position.
+     */
+    void updateDigest(::SHA256_CTX& ctx, std::uint32_t from, std::uint32_t to) const;
+
+    /**
+     * Adds previous block digest and significant header fields to the digest.
+     * @param ctx Digest context.
+     * @param prevBlockDigest Digest of a previous block.
+     */
+    void updateDigestWithHeader(
+            ::SHA256_CTX& ctx, const ColumnDataBlockHeader::Digest& prevBlockDigest) const;
+
     /**
      * Creates new data file for the specified column block.
      * Fails if the file already exists.
@@ -263,6 +405,32 @@ private:
     /** Loads header */
     void loadHeader();
 
+    /**
+     * Replaces data file with a new one which contains given header and data.
+     * @param header New block header.
+     * @param data Data to write into the data area.
+     * @param length Data length.
+     * @param dataAreaSize Data area size in the new file.
+     * @throw DatabaseError if operation fails for any reason
+     */
+    void replaceDataFile(const ColumnDataBlockHeader& header, const std::uint8_t* data,
+            std::size_t length, std::size_t dataAreaSize);
+
+    /**
+     * Converts compressed block back to the regular one, so that data can be modified.
+     * @throw DatabaseError if operation fails for any reason
+     */
+    void decompress();
+
+    /**
+     * Decompresses whole block data into memory, if not done yet.
+     * @throw DatabaseError if compressed data can't be read.
+     */
+    void loadUncompressedData() const;
+
+    /** Restores zone map from the header */
+    void loadZoneMap();
+
     /**
      * Throws database exception with message formatted using given arguments.
      * Looks up message in the default message catalog.
@@ -297,8 +465,32 @@ private:
     /** Indicates that data of the block is been modified */
     bool m_dataModified;
 
+    /** Digest of the data written so far */
+    ::SHA256_CTX m_digestContext;
+
+    /** Length of the data added to the digest context */
+    std::uint32_t m_digestedDataLength;
+
+    /** Data starting from this position is not added to the digest while written */
+    std::uint32_t m_digestLimit;
+
+    /** Zone map, absent if block doesn't have zone map */
+    std::optional<ColumnDataBlockZoneMap> m_zoneMap;
+
+    /**
+     * Decompressed data of the compressed block. Whole block is decompressed
+     * on the first read and kept while block object exists.
+     */
+    mutable std::vector<std::uint8_t> m_uncompressedData;
+
     /** Data file header prototype */
     static const BinaryValue s_dataFileHeaderProto;
+
+    /** Buffer size used for copying block data */
+    static constexpr std::size_t kBlockCopyBufferSize = 0x100000;
+
+    /** Digest limit value meaning that there is no limit */
+    static constexpr std::uint32_t kNoDigestLimit = std::numeric_limits<std::uint32_t>::max();
 };
 
 }  // namespace siodb::iomgr::dbengine
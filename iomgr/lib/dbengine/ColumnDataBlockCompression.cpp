@@ -0,0 +1,93 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "ColumnDataBlockCompression.h"
+
+// Common project headers
+#include <siodb/common/log/Log.h>
+
+// zlib
+#include <zlib.h>
+
+namespace siodb::iomgr::dbengine {
+
+namespace {
+
+/**
+ * Compresses data with deflate.
+ * @param data Data to compress.
+ * @param length Data length.
+ * @param level Compression level.
+ * @param[out] compressedData Compressed data.
+ * @return true if data was compressed, false otherwise.
+ */
+bool deflateData(const std::uint8_t* data, std::size_t length, int level,
+        std::vector<std::uint8_t>& compressedData)
+{
+    auto compressedLength = ::compressBound(length);
+    compressedData.resize(compressedLength);
+    const int rc = ::compress2(compressedData.data(), &compressedLength, data, length, level);
+    if (rc != Z_OK) {
+        LOG_WARNING << "Column data block compression failed, zlib error " << rc;
+        return false;
+    }
+    compressedData.resize(compressedLength);
+    return true;
+}
+
+}  // anonymous namespace
+
+ColumnDataBlockCompressionType compressColumnDataBlockData(const std::uint8_t* data,
+        std::size_t length, std::size_t recordSize, int level,
+        std::vector<std::uint8_t>& compressedData)
+{
+    auto compressionType = ColumnDataBlockCompressionType::kNone;
+    if (deflateData(data, length, level, compressedData))
+        compressionType = ColumnDataBlockCompressionType::kDeflate;
+
+    if (recordSize > 0 && length > recordSize) {
+        std::vector<std::uint8_t> deltas(data, data + length);
+        for (std::size_t i = length - 1; i >= recordSize; --i)
+            deltas[i] -= deltas[i - recordSize];
+        std::vector<std::uint8_t> compressedDeltas;
+        if (deflateData(deltas.data(), length, level, compressedDeltas)
+                && (compressionType == ColumnDataBlockCompressionType::kNone
+                        || compressedDeltas.size() < compressedData.size())) {
+            compressedData.swap(compressedDeltas);
+            compressionType = ColumnDataBlockCompressionType::kDeltaDeflate;
+        }
+    }
+
+    // Compressed block must pay for the decompression
+    if (compressedData.size() > length - length / 8) {
+        compressedData.clear();
+        compressionType = ColumnDataBlockCompressionType::kNone;
+    }
+    return compressionType;
+}
+
+bool decompressColumnDataBlockData(ColumnDataBlockCompressionType compressionType,
+        const std::uint8_t* compressedData, std::size_t compressedLength, std::size_t recordSize,
+        std::vector<std::uint8_t>& data)
+{
+    switch (compressionType) {
+        case ColumnDataBlockCompressionType::kDeflate:
+        case ColumnDataBlockCompressionType::kDeltaDeflate: {
+            ::uLongf length = data.size();
+            const int rc = ::uncompress(data.data(), &length, compressedData, compressedLength);
+            if (rc != Z_OK || length != data.size()) return false;
+            break;
+        }
+        default: return false;
+    }
+
+    if (compressionType == ColumnDataBlockCompressionType::kDeltaDeflate) {
+        if (recordSize == 0) return false;
+        for (std::size_t i = recordSize; i < data.size(); ++i)
+            data[i] += data[i - recordSize];
+    }
+    return true;
+}
+
+}  // namespace siodb::iomgr::dbengine
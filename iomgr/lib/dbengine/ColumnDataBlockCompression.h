@@ -0,0 +1,59 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// CRT headers
+#include <cstddef>
+#include <cstdint>
+
+// STL headers
+#include <vector>
+
+namespace siodb::iomgr::dbengine {
+
+/** Column data block compression type */
+enum class ColumnDataBlockCompressionType : std::uint8_t {
+    /** Data is not compressed */
+    kNone = 0,
+
+    /** Data is compressed with deflate */
+    kDeflate = 1,
+
+    /**
+     * Each byte is replaced with difference to the byte located one record before,
+     * then data is compressed with deflate. Suits slowly changing fixed size values,
+     * like increasing integers and timestamps.
+     */
+    kDeltaDeflate = 2,
+};
+
+/**
+ * Compresses column data block data. Tries delta encoding if record size is given
+ * and chooses the smallest result.
+ * @param data Data to compress.
+ * @param length Data length.
+ * @param recordSize Fixed record size for delta encoding, zero if records have variable size.
+ * @param level Deflate compression level, 1 to 9.
+ * @param[out] compressedData Compressed data.
+ * @return Compression type, kNone if data can't be compressed well.
+ */
+ColumnDataBlockCompressionType compressColumnDataBlockData(const std::uint8_t* data,
+        std::size_t length, std::size_t recordSize, int level,
+        std::vector<std::uint8_t>& compressedData);
+
+/**
+ * Decompresses column data block data.
+ * @param compressionType Compression type.
+ * @param compressedData Compressed data.
+ * @param compressedLength Compressed data length.
+ * @param recordSize Record size used for delta encoding.
+ * @param[out] data Buffer for the decompressed data, must have size of the original data.
+ * @return true if data was decompressed successfully, false if it is corrupted.
+ */
+bool decompressColumnDataBlockData(ColumnDataBlockCompressionType compressionType,
+        const std::uint8_t* compressedData, std::size_t compressedLength, std::size_t recordSize,
+        std::vector<std::uint8_t>& data);
+
+}  // namespace siodb::iomgr::dbengine
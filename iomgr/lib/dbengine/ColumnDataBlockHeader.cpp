@@ -8,6 +8,10 @@
 #include <siodb/common/stl_ext/utility_ext.h>
 #include <siodb/common/utils/PlainBinaryEncoding.h>
 
+// STL headers
+#include <iomanip>
+#include <sstream>
+
 namespace siodb::iomgr::dbengine {
 
 std::uint8_t* ColumnDataBlockHeader::serialize(std::uint8_t* buffer) const noexcept
@@ -25,6 +29,17 @@ std::uint8_t* ColumnDataBlockHeader::serialize(std::uint8_t* buffer) const noexc
     buffer = ::pbeEncodeUInt32(m_commitedDataOffset, buffer);
     buffer = ::pbeEncodeUInt64(m_fillTimestamp, buffer);
     buffer = ::pbeEncodeBinary(m_digest.data(), m_digest.size(), buffer);
+    buffer = ::pbeEncodeUInt32(m_digestedDataLength, buffer);
+    for (const auto v : m_digestState)
+        buffer = ::pbeEncodeUInt32(v, buffer);
+    buffer = ::pbeEncodeUInt64(m_lastVerificationTimestamp, buffer);
+    *buffer++ = m_hasZoneMap ? 1 : 0;
+    buffer = ::pbeEncodeUInt32(m_zoneMapValueCount, buffer);
+    buffer = ::pbeEncodeBinary(m_zoneMapMinValue.data(), m_zoneMapMinValue.size(), buffer);
+    buffer = ::pbeEncodeBinary(m_zoneMapMaxValue.data(), m_zoneMapMaxValue.size(), buffer);
+    *buffer++ = static_cast<std::uint8_t>(m_compressionType);
+    *buffer++ = m_deltaRecordSize;
+    buffer = ::pbeEncodeUInt32(m_compressedDataSize, buffer);
     return buffer;
 }
 
@@ -47,7 +62,36 @@ const std::uint8_t* ColumnDataBlockHeader::deserialize(const std::uint8_t* buffe
     buffer = ::pbeDecodeUInt32(buffer, &m_commitedDataOffset);
     buffer = ::pbeDecodeUInt64(buffer, &m_fillTimestamp);
     buffer = ::pbeDecodeBinary(buffer, m_digest.data(), m_digest.size());
+    if (m_version >= kIncrementalDigestVersion) {
+        buffer = ::pbeDecodeUInt32(buffer, &m_digestedDataLength);
+        for (auto& v : m_digestState)
+            buffer = ::pbeDecodeUInt32(buffer, &v);
+    } else {
+        // Header area beyond the version 1 fields is zero-filled
+        buffer += sizeof(m_digestedDataLength) + sizeof(m_digestState);
+        m_digestedDataLength = 0;
+        m_digestState.fill(0);
+    }
+    buffer = ::pbeDecodeUInt64(buffer, &m_lastVerificationTimestamp);
+    m_hasZoneMap = *buffer++ != 0;
+    buffer = ::pbeDecodeUInt32(buffer, &m_zoneMapValueCount);
+    buffer = ::pbeDecodeBinary(buffer, m_zoneMapMinValue.data(), m_zoneMapMinValue.size());
+    buffer = ::pbeDecodeBinary(buffer, m_zoneMapMaxValue.data(), m_zoneMapMaxValue.size());
+    if (*buffer > static_cast<std::uint8_t>(ColumnDataBlockCompressionType::kDeltaDeflate))
+        return nullptr;
+    m_compressionType = static_cast<ColumnDataBlockCompressionType>(*buffer++);
+    m_deltaRecordSize = *buffer++;
+    buffer = ::pbeDecodeUInt32(buffer, &m_compressedDataSize);
     return buffer;
 }
 
+std::string ColumnDataBlockHeader::digestToString(const Digest& digest)
+{
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0');
+    for (const auto v : digest)
+        oss << std::setw(2) << static_cast<unsigned>(v);
+    return oss.str();
+}
+
 }  // namespace siodb::iomgr::dbengine
@@ -5,6 +5,7 @@
 #pragma once
 
 // Project headers
+#include "ColumnDataBlockCompression.h"
 #include "ColumnDataBlockState.h"
 
 // Common project headers
@@ -16,6 +17,7 @@
 
 // STL headers
 #include <array>
+#include <string>
 
 namespace siodb::iomgr::dbengine {
 
@@ -67,6 +69,18 @@ struct ColumnDataBlockHeader {
     /** Digest type */
     using Digest = std::array<std::uint8_t, kDigestLength>;
 
+    /** Number of words in the intermediate SHA-256 hash value */
+    static constexpr const unsigned kDigestStateLength = 8;
+
+    /** Intermediate SHA-256 hash value of the data digested so far */
+    using DigestState = std::array<std::uint32_t, kDigestStateLength>;
+
+    /** Maximum size of the zone map value */
+    static constexpr const unsigned kZoneMapValueSize = 16;
+
+    /** Serialized zone map value */
+    using ZoneMapValue = std::array<std::uint8_t, kZoneMapValueSize>;
+
     /** Initializes ColumnDataBlockHeader */
     ColumnDataBlockHeader()
         : m_version(kCurrentVersion)
@@ -77,6 +91,16 @@ struct ColumnDataBlockHeader {
         , m_commitedDataOffset(0)
         , m_fillTimestamp(0)
         , m_digest {0}
+        , m_digestedDataLength(0)
+        , m_digestState {0}
+        , m_lastVerificationTimestamp(0)
+        , m_hasZoneMap(false)
+        , m_zoneMapValueCount(0)
+        , m_zoneMapMinValue {0}
+        , m_zoneMapMaxValue {0}
+        , m_compressionType(ColumnDataBlockCompressionType::kNone)
+        , m_deltaRecordSize(0)
+        , m_compressedDataSize(0)
     {
     }
 
@@ -98,6 +122,16 @@ struct ColumnDataBlockHeader {
         , m_commitedDataOffset(0)
         , m_fillTimestamp(0)
         , m_digest {0}
+        , m_digestedDataLength(0)
+        , m_digestState {0}
+        , m_lastVerificationTimestamp(0)
+        , m_hasZoneMap(false)
+        , m_zoneMapValueCount(0)
+        , m_zoneMapMinValue {0}
+        , m_zoneMapMaxValue {0}
+        , m_compressionType(ColumnDataBlockCompressionType::kNone)
+        , m_deltaRecordSize(0)
+        , m_compressedDataSize(0)
     {
     }
 
@@ -115,6 +149,13 @@ struct ColumnDataBlockHeader {
      */
     const std::uint8_t* deserialize(const std::uint8_t* buffer) noexcept;
 
+    /**
+     * Returns hexadecimal representation of the digest.
+     * @param digest Digest.
+     * @return Digest as hexadecimal string.
+     */
+    static std::string digestToString(const Digest& digest);
+
     /** Column block info version */
     std::uint32_t m_version;
 
@@ -148,14 +189,61 @@ struct ColumnDataBlockHeader {
     /** Block digest (when it became full) */
     Digest m_digest;
 
+    /** Length of the data covered by the digest state, multiple of the SHA-256 block size */
+    std::uint32_t m_digestedDataLength;
+
+    /** Digest state after processing of the first m_digestedDataLength bytes of data */
+    DigestState m_digestState;
+
+    /** Time when block digest was last verified by the data scrubber. Zero means never. */
+    std::uint64_t m_lastVerificationTimestamp;
+
+    /**
+     * Indication that zone map covers all values in the block.
+     * Zero-filled headers of the blocks created before zone maps don't have it.
+     */
+    bool m_hasZoneMap;
+
+    /** Number of values covered by zone map */
+    std::uint32_t m_zoneMapValueCount;
+
+    /** Minimum value in the block, serialized as column data */
+    ZoneMapValue m_zoneMapMinValue;
+
+    /** Maximum value in the block, serialized as column data */
+    ZoneMapValue m_zoneMapMaxValue;
+
+    /**
+     * Compression type of the data area. Compressed block is full and its data area
+     * in the file has size m_compressedDataSize.
+     */
+    ColumnDataBlockCompressionType m_compressionType;
+
+    /** Record size used for the delta encoding */
+    std::uint8_t m_deltaRecordSize;
+
+    /** Size of the compressed data */
+    std::uint32_t m_compressedDataSize;
+
     /** Current column block info version */
-    static constexpr const std::uint32_t kCurrentVersion = 1;
+    static constexpr const std::uint32_t kCurrentVersion = 2;
+
+    /**
+     * First version which maintains digest state. Digest of such block covers data
+     * before header fields, so that it can be computed while data is written.
+     */
+    static constexpr const std::uint32_t kIncrementalDigestVersion = 2;
 
     /** Serialized size */
     static constexpr const std::size_t kSerializedSize =
             sizeof(m_version) + FullColumnDataBlockId::kSerializedSize + sizeof(m_prevBlockId)
             + sizeof(m_dataAreaOffset) + sizeof(m_dataAreaSize) + sizeof(m_nextDataOffset)
-            + sizeof(m_commitedDataOffset) + sizeof(m_fillTimestamp) + sizeof(m_digest);
+            + sizeof(m_commitedDataOffset) + sizeof(m_fillTimestamp) + sizeof(m_digest)
+            + sizeof(m_digestedDataLength) + sizeof(m_digestState)
+            + sizeof(m_lastVerificationTimestamp) + sizeof(std::uint8_t)
+            + sizeof(m_zoneMapValueCount) + sizeof(m_zoneMapMinValue)
+            + sizeof(m_zoneMapMaxValue) + sizeof(m_compressionType) + sizeof(m_deltaRecordSize)
+            + sizeof(m_compressedDataSize);
 
     /** Standard data area offset for the current data file format version */
     static constexpr std::size_t kDefaultDataAreaOffset = kDataFileHeaderSize;
@@ -0,0 +1,174 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "ColumnDataBlockZoneMap.h"
+
+// Common project headers
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// CRT headers
+#include <cmath>
+
+namespace siodb::iomgr::dbengine {
+
+bool ColumnDataBlockZoneMap::update(const Variant& value)
+{
+    if ((value.getValueType() == VariantType::kFloat && std::isnan(value.getFloat()))
+            || (value.getValueType() == VariantType::kDouble && std::isnan(value.getDouble())))
+        return false;
+
+    if (m_valueCount == 0) {
+        m_minValue = value;
+        m_maxValue = value;
+    } else if (value.compatibleLess(m_minValue))
+        m_minValue = value;
+    else if (value.compatibleGreater(m_maxValue))
+        m_maxValue = value;
+    ++m_valueCount;
+    return true;
+}
+
+bool ColumnDataBlockZoneMap::mayContain(
+        ZoneMapPredicate predicate, const Variant& value, const Variant& upperValue) const noexcept
+{
+    // Null values are not stored in the blocks, so empty block can't match anything
+    if (m_valueCount == 0) return false;
+
+    try {
+        switch (predicate) {
+            case ZoneMapPredicate::kEqual:
+                return m_minValue.compatibleLessOrEqual(value)
+                       && m_maxValue.compatibleGreaterOrEqual(value);
+            case ZoneMapPredicate::kLess: return m_minValue.compatibleLess(value);
+            case ZoneMapPredicate::kLessOrEqual: return m_minValue.compatibleLessOrEqual(value);
+            case ZoneMapPredicate::kGreater: return m_maxValue.compatibleGreater(value);
+            case ZoneMapPredicate::kGreaterOrEqual:
+                return m_maxValue.compatibleGreaterOrEqual(value);
+            case ZoneMapPredicate::kBetween:
+                return m_maxValue.compatibleGreaterOrEqual(value)
+                       && m_minValue.compatibleLessOrEqual(upperValue);
+            default: return true;
+        }
+    } catch (std::exception&) {
+        // Values are not comparable, predicate evaluation will report this
+        return true;
+    }
+}
+
+void ColumnDataBlockZoneMap::serialize(ColumnDataType dataType, std::uint8_t* minValueBuffer,
+        std::uint8_t* maxValueBuffer) const noexcept
+{
+    if (m_valueCount == 0) return;
+    serializeValue(dataType, m_minValue, minValueBuffer);
+    serializeValue(dataType, m_maxValue, maxValueBuffer);
+}
+
+void ColumnDataBlockZoneMap::deserialize(ColumnDataType dataType, std::uint32_t valueCount,
+        const std::uint8_t* minValueBuffer, const std::uint8_t* maxValueBuffer)
+{
+    m_valueCount = valueCount;
+    if (valueCount == 0) {
+        m_minValue.clear();
+        m_maxValue.clear();
+        return;
+    }
+    m_minValue = deserializeValue(dataType, minValueBuffer);
+    m_maxValue = deserializeValue(dataType, maxValueBuffer);
+}
+
+bool ColumnDataBlockZoneMap::isDataTypeSupported(ColumnDataType dataType) noexcept
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_INT8:
+        case COLUMN_DATA_TYPE_UINT8:
+        case COLUMN_DATA_TYPE_INT16:
+        case COLUMN_DATA_TYPE_UINT16:
+        case COLUMN_DATA_TYPE_INT32:
+        case COLUMN_DATA_TYPE_UINT32:
+        case COLUMN_DATA_TYPE_INT64:
+        case COLUMN_DATA_TYPE_UINT64:
+        case COLUMN_DATA_TYPE_FLOAT:
+        case COLUMN_DATA_TYPE_DOUBLE:
+        case COLUMN_DATA_TYPE_TIMESTAMP: return true;
+        default: return false;
+    }
+}
+
+// --- internals ---
+
+void ColumnDataBlockZoneMap::serializeValue(
+        ColumnDataType dataType, const Variant& value, std::uint8_t* buffer) noexcept
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_INT8: *buffer = static_cast<std::uint8_t>(value.getInt8()); break;
+        case COLUMN_DATA_TYPE_UINT8: *buffer = value.getUInt8(); break;
+        case COLUMN_DATA_TYPE_INT16: ::pbeEncodeInt16(value.getInt16(), buffer); break;
+        case COLUMN_DATA_TYPE_UINT16: ::pbeEncodeUInt16(value.getUInt16(), buffer); break;
+        case COLUMN_DATA_TYPE_INT32: ::pbeEncodeInt32(value.getInt32(), buffer); break;
+        case COLUMN_DATA_TYPE_UINT32: ::pbeEncodeUInt32(value.getUInt32(), buffer); break;
+        case COLUMN_DATA_TYPE_INT64: ::pbeEncodeInt64(value.getInt64(), buffer); break;
+        case COLUMN_DATA_TYPE_UINT64: ::pbeEncodeUInt64(value.getUInt64(), buffer); break;
+        case COLUMN_DATA_TYPE_FLOAT: ::pbeEncodeFloat(value.getFloat(), buffer); break;
+        case COLUMN_DATA_TYPE_DOUBLE: ::pbeEncodeDouble(value.getDouble(), buffer); break;
+        case COLUMN_DATA_TYPE_TIMESTAMP: value.getDateTime().serialize(buffer); break;
+        default: break;
+    }
+}
+
+Variant ColumnDataBlockZoneMap::deserializeValue(
+        ColumnDataType dataType, const std::uint8_t* buffer)
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_INT8: return static_cast<std::int8_t>(*buffer);
+        case COLUMN_DATA_TYPE_UINT8: return *buffer;
+        case COLUMN_DATA_TYPE_INT16: {
+            std::int16_t v = 0;
+            ::pbeDecodeInt16(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_UINT16: {
+            std::uint16_t v = 0;
+            ::pbeDecodeUInt16(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_INT32: {
+            std::int32_t v = 0;
+            ::pbeDecodeInt32(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_UINT32: {
+            std::uint32_t v = 0;
+            ::pbeDecodeUInt32(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_INT64: {
+            std::int64_t v = 0;
+            ::pbeDecodeInt64(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_UINT64: {
+            std::uint64_t v = 0;
+            ::pbeDecodeUInt64(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_FLOAT: {
+            float v = 0;
+            ::pbeDecodeFloat(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_DOUBLE: {
+            double v = 0;
+            ::pbeDecodeDouble(buffer, &v);
+            return v;
+        }
+        case COLUMN_DATA_TYPE_TIMESTAMP: {
+            RawDateTime v;
+            v.deserialize(buffer, kMaxSerializedValueSize);
+            return v;
+        }
+        default: return Variant();
+    }
+}
+
+}  // namespace siodb::iomgr::dbengine
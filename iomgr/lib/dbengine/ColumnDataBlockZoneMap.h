@@ -0,0 +1,143 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Common project headers
+#include <siodb/common/proto/ColumnDataType.pb.h>
+#include <siodb/iomgr/shared/dbengine/Variant.h>
+
+// CRT headers
+#include <cstdint>
+
+namespace siodb::iomgr::dbengine {
+
+/** Predicate which can be checked against zone map */
+enum class ZoneMapPredicate {
+    kEqual,
+    kLess,
+    kLessOrEqual,
+    kGreater,
+    kGreaterOrEqual,
+    kBetween,
+};
+
+/**
+ * Zone map of the column data block: minimum and maximum of the values stored in the block.
+ * Allows to skip reading of the values from the block, when they can't satisfy a predicate.
+ * Maintained only for the numeric data types and timestamps.
+ */
+class ColumnDataBlockZoneMap {
+public:
+    /** Maximum serialized value size */
+    static constexpr std::size_t kMaxSerializedValueSize = 16;
+
+public:
+    /** Initializes object of class ColumnDataBlockZoneMap for an empty block */
+    ColumnDataBlockZoneMap() noexcept
+        : m_valueCount(0)
+    {
+    }
+
+    /**
+     * Returns number of values covered by zone map.
+     * @return Number of values.
+     */
+    std::uint32_t getValueCount() const noexcept
+    {
+        return m_valueCount;
+    }
+
+    /**
+     * Returns minimum value.
+     * @return Minimum value, null if there are no values.
+     */
+    const Variant& getMinValue() const noexcept
+    {
+        return m_minValue;
+    }
+
+    /**
+     * Returns maximum value.
+     * @return Maximum value, null if there are no values.
+     */
+    const Variant& getMaxValue() const noexcept
+    {
+        return m_maxValue;
+    }
+
+    /**
+     * Adds value to the zone map.
+     * @param value A value of the column data type, not null.
+     * @return true if zone map is still valid, false if value can't be ordered (NaN).
+     */
+    bool update(const Variant& value);
+
+    /**
+     * Checks if block may contain a value which satisfies predicate. Returns true
+     * when this can't be decided, for example, when values are not comparable.
+     * @param predicate Predicate type. Column value is left operand.
+     * @param value Right operand, lower bound for kBetween.
+     * @param upperValue Upper bound for kBetween, ignored otherwise.
+     * @return true if block may contain matching value, false if it definitely doesn't.
+     */
+    bool mayContain(ZoneMapPredicate predicate, const Variant& value,
+            const Variant& upperValue) const noexcept;
+
+    /**
+     * Serializes zone map values into memory buffers.
+     * @param dataType Column data type.
+     * @param minValueBuffer Buffer for the minimum value.
+     * @param maxValueBuffer Buffer for the maximum value.
+     */
+    void serialize(ColumnDataType dataType, std::uint8_t* minValueBuffer,
+            std::uint8_t* maxValueBuffer) const noexcept;
+
+    /**
+     * De-serializes zone map values from memory buffers.
+     * @param dataType Column data type.
+     * @param valueCount Number of values.
+     * @param minValueBuffer Buffer with the minimum value.
+     * @param maxValueBuffer Buffer with the maximum value.
+     */
+    void deserialize(ColumnDataType dataType, std::uint32_t valueCount,
+            const std::uint8_t* minValueBuffer, const std::uint8_t* maxValueBuffer);
+
+    /**
+     * Returns indication that zone map can be maintained for the given data type.
+     * @param dataType Column data type.
+     * @return true if data type is supported, false otherwise.
+     */
+    static bool isDataTypeSupported(ColumnDataType dataType) noexcept;
+
+private:
+    /**
+     * Serializes value into memory buffer.
+     * @param dataType Column data type.
+     * @param value A value.
+     * @param buffer Memory buffer.
+     */
+    static void serializeValue(
+            ColumnDataType dataType, const Variant& value, std::uint8_t* buffer) noexcept;
+
+    /**
+     * De-serializes value from memory buffer.
+     * @param dataType Column data type.
+     * @param buffer Memory buffer.
+     * @return A value.
+     */
+    static Variant deserializeValue(ColumnDataType dataType, const std::uint8_t* buffer);
+
+private:
+    /** Minimum value */
+    Variant m_minValue;
+
+    /** Maximum value */
+    Variant m_maxValue;
+
+    /** Number of values */
+    std::uint32_t m_valueCount;
+};
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,101 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "ColumnDataAddress.h"
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+
+// CRT headers
+#include <cstdint>
+
+// STL headers
+#include <vector>
+
+namespace siodb::iomgr::dbengine {
+
+/**
+ * Copy of the column data block contents starting at some position.
+ * Used to read fixed width values written one after another without
+ * block lookup and block read for each value.
+ */
+class ColumnDataReadBuffer {
+public:
+    /** Number of bytes read into buffer at once */
+    static constexpr std::size_t kDefaultReadSize = 4096;
+
+public:
+    /** Initializes object of class ColumnDataReadBuffer */
+    ColumnDataReadBuffer() noexcept
+        : m_blockId(0)
+        , m_offset(0)
+        , m_rollbackCount(0)
+    {
+    }
+
+    DECLARE_NONCOPYABLE(ColumnDataReadBuffer);
+
+    /** Move constructor */
+    ColumnDataReadBuffer(ColumnDataReadBuffer&& src) noexcept = default;
+
+    /**
+     * Returns buffered data at a given address.
+     * @param addr Data address.
+     * @param length Data length.
+     * @param rollbackCount Current number of data rollbacks in the column.
+     * @return Data address in the buffer or nullptr if data is not buffered.
+     */
+    const std::uint8_t* find(const ColumnDataAddress& addr, std::size_t length,
+            std::uint64_t rollbackCount) const noexcept
+    {
+        // Rolled back data could be overwritten
+        if (addr.getBlockId() != m_blockId || rollbackCount != m_rollbackCount
+                || addr.getOffset() < m_offset
+                || addr.getOffset() - m_offset + length > m_data.size())
+            return nullptr;
+        return m_data.data() + (addr.getOffset() - m_offset);
+    }
+
+    /**
+     * Invalidates buffer and prepares it for the new data.
+     * @param length Data length.
+     * @return Buffer to fill.
+     */
+    std::uint8_t* prepare(std::size_t length)
+    {
+        m_blockId = 0;
+        m_data.resize(length);
+        return m_data.data();
+    }
+
+    /**
+     * Marks prepared buffer as filled with the data from a given address.
+     * @param addr Address of the first byte of data.
+     * @param rollbackCount Number of data rollbacks in the column when data was read.
+     */
+    void assign(const ColumnDataAddress& addr, std::uint64_t rollbackCount) noexcept
+    {
+        m_blockId = addr.getBlockId();
+        m_offset = addr.getOffset();
+        m_rollbackCount = rollbackCount;
+    }
+
+private:
+    /** Block ID */
+    std::uint64_t m_blockId;
+
+    /** Offset of the buffered data in the block */
+    std::uint32_t m_offset;
+
+    /** Number of data rollbacks in the column when data was read */
+    std::uint64_t m_rollbackCount;
+
+    /** Buffered data */
+    std::vector<std::uint8_t> m_data;
+};
+
+}  // namespace siodb::iomgr::dbengine
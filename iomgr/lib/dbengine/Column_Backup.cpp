@@ -0,0 +1,112 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "Column.h"
+
+// Project headers
+#include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "ColumnDataBlock.h"
+#include "ThrowDatabaseError.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/log/Log.h>
+#include <siodb/common/stl_wrap/filesystem_wrapper.h>
+#include <siodb/common/utils/FSUtils.h>
+
+namespace siodb::iomgr::dbengine {
+
+std::vector<Column::DataBlockBackupInfo> Column::backupDataBlocks(
+        const std::string& blockStoreDir, const std::string& snapshotDir)
+{
+    struct SealedBlockCopyInfo {
+        std::size_t m_index;
+        std::string m_sourcePath;
+        std::uint64_t m_fillTimestamp;
+    };
+
+    std::vector<DataBlockBackupInfo> result;
+    std::vector<SealedBlockCopyInfo> sealedBlocks;
+
+    // Capture block list and save snapshot of the open blocks.
+    // Sealed blocks never change, except in case of rollback, which is checked below.
+    // Blocks which are not cached are read bypassing the block cache,
+    // so that backup doesn't evict blocks used by queries.
+    {
+        std::lock_guard lock(m_mutex);
+        const auto lastBlockId = m_blockRegistry.getLastBlockId();
+        result.reserve(lastBlockId);
+        for (std::uint64_t blockId = 1; blockId <= lastBlockId; ++blockId) {
+            const auto state = m_blockRegistry.getBlockState(blockId);
+            if (state == ColumnDataBlockState::kNotPresent) continue;
+
+            const auto block = getBlockWithoutCaching(blockId);
+            DataBlockBackupInfo info;
+            info.m_blockId = blockId;
+            info.m_prevBlockId = block->getPrevBlockId();
+            info.m_sealed = block->getFillTimestamp() != 0
+                            && (state == ColumnDataBlockState::kClosing
+                                    || state == ColumnDataBlockState::kClosed);
+            info.m_alreadyStored = false;
+            info.m_dataLength = block->getNextDataPos();
+            info.m_digest = block->getDigest();
+            if (info.m_sealed) {
+                info.m_filePath = utils::constructPath(blockStoreDir,
+                        ColumnDataBlockHeader::digestToString(info.m_digest), kDataFileExtension);
+                sealedBlocks.push_back(SealedBlockCopyInfo {
+                        result.size(), block->getDataFilePath(), block->getFillTimestamp()});
+            } else {
+                info.m_filePath = utils::constructPath(snapshotDir, m_table.getId(), '.', m_id,
+                        '.', blockId, kDataFileExtension);
+                block->saveCopy(info.m_filePath);
+            }
+            result.push_back(std::move(info));
+        }
+    }
+
+    // Copy sealed blocks as is, they are already encrypted and, if compression
+    // is enabled, compressed. Restored block is read the same way as the original one.
+    for (auto& sealedBlock : sealedBlocks) {
+        auto& info = result[sealedBlock.m_index];
+        if (fs::exists(info.m_filePath)) {
+            info.m_alreadyStored = true;
+            continue;
+        }
+        const auto tmpFilePath = info.m_filePath + kTempFileExtension;
+        try {
+            fs::copy_file(sealedBlock.m_sourcePath, tmpFilePath,
+                    fs::copy_options::overwrite_existing);
+            fs::rename(tmpFilePath, info.m_filePath);
+        } catch (fs::filesystem_error& ex) {
+            throwDatabaseError(IOManagerMessageId::kErrorCannotCopyColumnDataBlockForBackup,
+                    getDatabaseName(), m_table.getName(), m_name, info.m_blockId,
+                    getDatabaseUuid(), m_table.getId(), m_id, info.m_filePath,
+                    ex.code().value(), ex.code().message());
+        }
+    }
+
+    // Check that copied blocks were not reopened by rollback meanwhile
+    if (!sealedBlocks.empty()) {
+        std::lock_guard lock(m_mutex);
+        for (const auto& sealedBlock : sealedBlocks) {
+            const auto& info = result[sealedBlock.m_index];
+            if (info.m_alreadyStored) continue;
+            const auto block = getBlockWithoutCaching(info.m_blockId);
+            if (block->getFillTimestamp() != sealedBlock.m_fillTimestamp
+                    || block->getDigest() != info.m_digest) {
+                system_error_code ec;
+                fs::remove(info.m_filePath, ec);
+                throwDatabaseError(IOManagerMessageId::kErrorColumnDataBlockChangedDuringBackup,
+                        getDatabaseName(), m_table.getName(), m_name, info.m_blockId,
+                        getDatabaseUuid(), m_table.getId(), m_id);
+            }
+        }
+    }
+
+    LOG_DEBUG << "Column " << makeDisplayName() << ": saved " << result.size()
+              << " blocks into backup (" << sealedBlocks.size() << " sealed)";
+    return result;
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -32,6 +32,32 @@ ColumnDataBlockPtr Column::createBlock(std::uint64_t prevBlockId, ColumnDataBloc
     return block;
 }
 
+io::FilePtr Column::takeSpareDataFile()
+{
+    auto threadPool = getDatabase().getInstance().getDataBlockFileThreadPool();
+    if (!threadPool) return nullptr;
+
+    std::lock_guard lock(m_spareDataFileMutex);
+    io::FilePtr file;
+    if (!m_spareDataFiles.empty()) {
+        file = std::move(m_spareDataFiles.back());
+        m_spareDataFiles.pop_back();
+        ++m_takenSpareDataFileCount;
+        // From now on, file is limited by the file descriptor cache
+        getDatabase().getInstance().releaseSpareDataBlockFileDescriptor();
+    }
+    if (!m_spareDataFilePreparationScheduled) {
+        // Task holds the whole object chain, since column refers to table and database
+        threadPool->submit([database = getDatabase().shared_from_this(),
+                                   table = m_table.shared_from_this(),
+                                   column = shared_from_this()]() {
+            column->prepareSpareDataFiles();
+        });
+        m_spareDataFilePreparationScheduled = true;
+    }
+    return file;
+}
+
 std::uint64_t Column::findPrevBlockId(std::uint64_t blockId) const
 {
     std::lock_guard lock(m_mutex);
@@ -44,6 +70,77 @@ void Column::updateBlockState(std::uint64_t blockId, ColumnDataBlockState state)
     m_blockRegistry.updateBlockState(blockId, state);
 }
 
+bool Column::verifyBlock(std::uint64_t blockId, std::time_t verifiedBefore, std::size_t& dataSize)
+{
+    dataSize = 0;
+
+    // Take block and previous block digest under lock. Block is read through its own
+    // object rather than through the block cache, so that verification doesn't evict
+    // blocks used by queries.
+    ColumnDataBlockPtr block;
+    ColumnDataBlockHeader::Digest prevBlockDigest;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_blockRegistry.getBlockState(blockId) != ColumnDataBlockState::kClosed) return true;
+        block = std::make_shared<ColumnDataBlock>(*this, blockId);
+        if (block->getLastVerificationTimestamp() >= verifiedBefore) return true;
+        const auto prevBlockId = block->getPrevBlockId();
+        if (prevBlockId == 0)
+            prevBlockDigest = ColumnDataBlockHeader::kInitialPrevBlockDigest;
+        else
+            prevBlockDigest = getBlockWithoutCaching(prevBlockId)->getDigest();
+    }
+
+    // Hash data without lock, block can't change while it is closed
+    ColumnDataBlockHeader::Digest digest;
+    block->computeDigest(prevBlockDigest, digest);
+    dataSize = block->getNextDataPos();
+
+    std::lock_guard lock(m_mutex);
+
+    // Block could be reopened by rollback meanwhile, then data may have changed under hashing
+    if (m_blockRegistry.getBlockState(blockId) != ColumnDataBlockState::kClosed) return true;
+    const auto currentBlock = getBlockWithoutCaching(blockId);
+    if (currentBlock->getDigest() != block->getDigest()
+            || currentBlock->getFillTimestamp() != block->getFillTimestamp())
+        return true;
+
+    if (digest != block->getDigest()) return false;
+
+    // Cached block object, if any, must see new header too
+    currentBlock->setLastVerificationTimestamp(std::time(nullptr));
+    currentBlock->writeHeader();
+    return true;
+}
+
+bool Column::mayBlockContain(std::uint64_t blockId, ZoneMapPredicate predicate,
+        const Variant& value, const Variant& upperValue)
+{
+    std::lock_guard lock(m_mutex);
+    const auto block = findExistingBlock(blockId);
+    const auto zoneMap = block->getZoneMap();
+    return !zoneMap || zoneMap->mayContain(predicate, value, upperValue);
+}
+
+void Column::prefetchData(std::uint64_t blockId, std::uint32_t pos, std::size_t length)
+{
+    std::lock_guard lock(m_mutex);
+    try {
+        for (std::size_t i = 0; i <= kMaxPrefetchNextBlockCount; ++i) {
+            const auto prefetchedLength = findExistingBlock(blockId)->prefetchData(pos, length);
+            if (prefetchedLength >= length) break;
+            length -= prefetchedLength;
+            const auto nextBlockIds = m_blockRegistry.findNextBlockIds(blockId);
+            if (nextBlockIds.empty()) break;
+            blockId = nextBlockIds.front();
+            pos = 0;
+        }
+    } catch (std::exception& ex) {
+        LOG_DEBUG << "Column " << makeDisplayName() << ": Prefetch of the block #" << blockId
+                  << " failed: " << ex.what();
+    }
+}
+
 // --- internals ---
 
 ColumnDataBlockPtr Column::loadBlock(std::uint64_t blockId)
@@ -91,7 +188,7 @@ void Column::updateAvailableBlock(const ColumnDataBlock& block)
 }
 
 ColumnDataBlockPtr Column::createOrGetNextBlock(
-        ColumnDataBlock& block, std::size_t requiredFreeSpace)
+        ColumnDataBlock& block, std::size_t requiredFreeSpace, bool finalize)
 {
     // Validate requiredFreeSpace
     if (requiredFreeSpace == 0) throw std::invalid_argument("requiredFreeSpace is zero");
@@ -129,6 +226,14 @@ ColumnDataBlockPtr Column::createOrGetNextBlock(
         nextBlock = createBlock(block.getId());
     }
 
+    if (finalize) finalizeBlock(block);
+    m_availableDataBlocks.erase(block.getId());
+    updateAvailableBlock(*nextBlock);
+    return nextBlock;
+}
+
+void Column::finalizeBlock(ColumnDataBlock& block)
+{
     // Obtain previous block header
     ColumnDataBlockHeader::Digest prevBlockDigest;
     const auto prevBlockId = block.getPrevBlockId();
@@ -145,9 +250,19 @@ ColumnDataBlockPtr Column::createOrGetNextBlock(
     }
 
     block.finalize(prevBlockDigest);
-    m_availableDataBlocks.erase(block.getId());
-    updateAvailableBlock(*nextBlock);
-    return nextBlock;
+
+    // NOTE: Block is compressed by the write which has filled it, under the column mutex,
+    // so that write and other writes and reads of this column wait for the compression.
+    const auto compressionLevel = getDatabase().getInstance().getDataBlockCompressionLevel();
+    if (compressionLevel > 0) {
+        try {
+            block.compress(compressionLevel);
+        } catch (std::exception& ex) {
+            // Block is still valid uncompressed
+            LOG_WARNING << "Can't compress block " << block.makeDisplayName() << ": "
+                        << ex.what();
+        }
+    }
 }
 
 ColumnDataBlockPtr Column::findExistingBlock(std::uint64_t blockId)
@@ -160,6 +275,13 @@ ColumnDataBlockPtr Column::findExistingBlock(std::uint64_t blockId)
     return block;
 }
 
+ColumnDataBlockPtr Column::getBlockWithoutCaching(std::uint64_t blockId)
+{
+    const auto it = m_blockCache.find(blockId);
+    return (it != m_blockCache.end()) ? it->second
+                                      : std::make_shared<ColumnDataBlock>(*this, blockId);
+}
+
 std::uint64_t Column::findFirstBlock() const
 {
     constexpr auto kColumnDataBlockFilePrefixLength = ct_strlen(ColumnDataBlock::kBlockFilePrefix);
@@ -208,4 +330,33 @@ std::uint64_t Column::findFirstBlock() const
     return firstBlockId;
 }
 
+void Column::prepareSpareDataFiles()
+{
+    auto& instance = getDatabase().getInstance();
+    const auto fileCount = instance.getSpareDataBlockFileCount();
+    try {
+        while (true) {
+            {
+                std::lock_guard lock(m_spareDataFileMutex);
+                if (m_spareDataFiles.size() >= fileCount) break;
+            }
+            // Over instance-wide limit, block files are created inline
+            if (!instance.reserveSpareDataBlockFileDescriptor()) break;
+            try {
+                auto file = ColumnDataBlock::createSpareDataFile(*this);
+                std::lock_guard lock(m_spareDataFileMutex);
+                m_spareDataFiles.push_back(std::move(file));
+            } catch (...) {
+                instance.releaseSpareDataBlockFileDescriptor();
+                throw;
+            }
+        }
+    } catch (std::exception& ex) {
+        LOG_WARNING << "Can't create spare data block file for the column " << makeDisplayName()
+                    << ": " << ex.what();
+    }
+    std::lock_guard lock(m_spareDataFileMutex);
+    m_spareDataFilePreparationScheduled = false;
+}
+
 }  // namespace siodb::iomgr::dbengine
@@ -17,6 +17,9 @@
 #include <siodb/common/log/Log.h>
 #include <siodb/common/utils/PlainBinaryEncoding.h>
 
+// STL headers
+#include <algorithm>
+
 namespace siodb::iomgr::dbengine {
 void Column::readRecord(
         const ColumnDataAddress& addr, Variant& value, bool lobStreamsMustHoldSource)
@@ -38,89 +41,14 @@ void Column::readRecord(
                 m_id, addr.getOffset());
     }
 
+    if (hasFixedWidthValues()) {
+        std::uint8_t buffer[8];
+        block->readData(buffer, requiredLength, addr.getOffset());
+        decodeFixedWidthValue(buffer, value);
+        return;
+    }
+
     switch (m_dataType) {
-        case COLUMN_DATA_TYPE_BOOL: {
-            std::uint8_t v = 0;
-            block->readData(&v, sizeof(v), addr.getOffset());
-            value = (v != 0);
-            break;
-        }
-        case COLUMN_DATA_TYPE_INT8: {
-            std::int8_t v = 0;
-            block->readData(&v, sizeof(v), addr.getOffset());
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_UINT8: {
-            std::uint8_t v = 0;
-            block->readData(&v, sizeof(v), addr.getOffset());
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_INT16: {
-            std::uint8_t buffer[2];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            std::int16_t v = 0;
-            ::pbeDecodeInt16(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_UINT16: {
-            std::uint8_t buffer[2];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            std::uint16_t v = 0;
-            ::pbeDecodeUInt16(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_INT32: {
-            std::uint8_t buffer[4];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            std::int32_t v = 0;
-            ::pbeDecodeInt32(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_UINT32: {
-            std::uint8_t buffer[4];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            std::uint32_t v = 0;
-            ::pbeDecodeUInt32(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_INT64: {
-            std::uint8_t buffer[8];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            std::int64_t v = 0;
-            ::pbeDecodeInt64(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_UINT64: {
-            std::uint8_t buffer[8];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            std::uint64_t v = 0;
-            ::pbeDecodeUInt64(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_FLOAT: {
-            std::uint8_t buffer[4];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            float v = 0;
-            ::pbeDecodeFloat(buffer, &v);
-            value = v;
-            break;
-        }
-        case COLUMN_DATA_TYPE_DOUBLE: {
-            std::uint8_t buffer[8];
-            block->readData(buffer, sizeof(buffer), addr.getOffset());
-            double v = 0;
-            ::pbeDecodeDouble(buffer, &v);
-            value = v;
-            break;
-        }
         case COLUMN_DATA_TYPE_TEXT: {
             loadText(addr, value, lobStreamsMustHoldSource);
             break;
@@ -147,8 +75,47 @@ void Column::readRecord(
     }  // switch
 }
 
+void Column::readRecord(
+        const ColumnDataAddress& addr, Variant& value, ColumnDataReadBuffer& readBuffer)
+{
+    if (!addr || !hasFixedWidthValues()) {
+        readRecord(addr, value);
+        return;
+    }
+
+    const std::uint32_t valueLength = s_minRequiredBlockFreeSpaces[m_dataType];
+    const auto rollbackCount = m_rollbackCount.load();
+    if (const auto data = readBuffer.find(addr, valueLength, rollbackCount)) {
+        decodeFixedWidthValue(data, value);
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto block = findExistingBlock(addr.getBlockId());
+        if (addr.getOffset() + valueLength >= m_dataBlockDataAreaSize) {
+            throwDatabaseError(IOManagerMessageId::kErrorInvalidDataBlockPosition,
+                    getDatabaseName(), m_table.getName(), m_name, addr.getBlockId(),
+                    getDatabaseUuid(), m_table.getId(), m_id, addr.getOffset());
+        }
+        // Read ahead only data which is already written
+        const auto nextDataPos = block->getNextDataPos();
+        std::uint32_t readLength = valueLength;
+        if (nextDataPos > addr.getOffset() + valueLength) {
+            readLength = std::min<std::uint32_t>(
+                    nextDataPos - addr.getOffset(), ColumnDataReadBuffer::kDefaultReadSize);
+        }
+        block->readData(readBuffer.prepare(readLength), readLength, addr.getOffset());
+        readBuffer.assign(addr, rollbackCount);
+    }
+
+    decodeFixedWidthValue(readBuffer.find(addr, valueLength, rollbackCount), value);
+}
+
 void Column::readMasterColumnRecord(const ColumnDataAddress& addr, MasterColumnRecord& record)
 {
+    std::lock_guard lock(m_mutex);
+
     // Read MCR size
     auto block = findExistingBlock(addr.getBlockId());
     std::uint8_t recordSizeBuffer[2];
@@ -449,6 +416,8 @@ Column::WriteRecordResult Column::writeRecord(Variant&& value)
         }
     }  // switch
 
+    block->updateZoneMap(v);
+
     // Update block free space
     itBlock->second = block->getFreeDataSpace();
 
@@ -559,8 +528,10 @@ Column::WriteRecordResult Column::writeBuffer(
 
         // Check if chunk header fits into remaining free space in the block
         if (freeSpace < LobChunkHeader::kSerializedSize) {
-            auto newBlock = createOrGetNextBlock(
-                    *block, LobChunkHeader::kSerializedSize + kBlockFreeSpaceThresholdForLob);
+            // Block with the last chunk header is finalized after header is updated,
+            // so that block digest covers final header
+            auto newBlock = createOrGetNextBlock(*block,
+                    LobChunkHeader::kSerializedSize + kBlockFreeSpaceThresholdForLob, chunkId == 1);
             if (chunkId == 1)
                 result = ColumnDataAddress(block->getId(), block->getNextDataPos());
             else {
@@ -569,6 +540,7 @@ Column::WriteRecordResult Column::writeBuffer(
                 lastHeader.m_nextChunkOffset = newBlock->getNextDataPos();
                 lastHeader.serialize(headerBuffer);
                 block->writeData(headerBuffer, LobChunkHeader::kSerializedSize, lastHeaderPos);
+                finalizeBlock(*block);
             }
             block = newBlock;
             freeSpace = block->getFreeDataSpace();
@@ -580,8 +552,10 @@ Column::WriteRecordResult Column::writeBuffer(
                 static_cast<std::uint32_t>(freeSpace - LobChunkHeader::kSerializedSize);
         header.m_chunkLength = std::min(availableSpace, length);
 
-        // Write header
+        // Write header. Header of the chunk which doesn't complete the value is rewritten
+        // with the next chunk position, so it is left out of the running block digest.
         lastHeaderPos = block->getNextDataPos();
+        if (header.m_chunkLength < length) block->limitDigest(lastHeaderPos);
         header.serialize(headerBuffer);
         block->writeData(headerBuffer, LobChunkHeader::kSerializedSize);
         block->incNextDataPos(LobChunkHeader::kSerializedSize);
@@ -622,8 +596,10 @@ Column::WriteRecordResult Column::writeLob(LobStream& lob, ColumnDataBlockPtr bl
 
         // Check if chunk header fits into remaining free space in the block
         if (freeSpace < LobChunkHeader::kSerializedSize) {
-            auto newBlock = createOrGetNextBlock(
-                    *block, LobChunkHeader::kSerializedSize + kBlockFreeSpaceThresholdForLob);
+            // Block with the last chunk header is finalized after header is updated,
+            // so that block digest covers final header
+            auto newBlock = createOrGetNextBlock(*block,
+                    LobChunkHeader::kSerializedSize + kBlockFreeSpaceThresholdForLob, chunkId == 1);
             if (chunkId == 1)
                 result = ColumnDataAddress(block->getId(), block->getNextDataPos());
             else {
@@ -632,6 +608,7 @@ Column::WriteRecordResult Column::writeLob(LobStream& lob, ColumnDataBlockPtr bl
                 lastHeader.m_nextChunkOffset = newBlock->getNextDataPos();
                 lastHeader.serialize(headerBuffer);
                 block->writeData(headerBuffer, LobChunkHeader::kSerializedSize, lastHeaderPos);
+                finalizeBlock(*block);
             }
             block = newBlock;
             freeSpace = block->getFreeDataSpace();
@@ -643,8 +620,10 @@ Column::WriteRecordResult Column::writeLob(LobStream& lob, ColumnDataBlockPtr bl
                 static_cast<std::uint32_t>(freeSpace - LobChunkHeader::kSerializedSize);
         header.m_chunkLength = std::min(availableSpace, remainingLobSize);
 
-        // Write header
+        // Write header. Header of the chunk which doesn't complete the value is rewritten
+        // with the next chunk position, so it is left out of the running block digest.
         lastHeaderPos = block->getNextDataPos();
+        if (header.m_chunkLength < remainingLobSize) block->limitDigest(lastHeaderPos);
         header.serialize(headerBuffer);
         block->writeData(headerBuffer, LobChunkHeader::kSerializedSize);
         block->incNextDataPos(LobChunkHeader::kSerializedSize);
@@ -678,6 +657,73 @@ Column::WriteRecordResult Column::writeLob(LobStream& lob, ColumnDataBlockPtr bl
     return WriteRecordResult(result, ColumnDataAddress(block->getId(), block->getNextDataPos()));
 }
 
+void Column::decodeFixedWidthValue(const std::uint8_t* data, Variant& value) const
+{
+    switch (m_dataType) {
+        case COLUMN_DATA_TYPE_BOOL: {
+            value = (*data != 0);
+            break;
+        }
+        case COLUMN_DATA_TYPE_INT8: {
+            value = static_cast<std::int8_t>(*data);
+            break;
+        }
+        case COLUMN_DATA_TYPE_UINT8: {
+            value = *data;
+            break;
+        }
+        case COLUMN_DATA_TYPE_INT16: {
+            std::int16_t v = 0;
+            ::pbeDecodeInt16(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_UINT16: {
+            std::uint16_t v = 0;
+            ::pbeDecodeUInt16(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_INT32: {
+            std::int32_t v = 0;
+            ::pbeDecodeInt32(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_UINT32: {
+            std::uint32_t v = 0;
+            ::pbeDecodeUInt32(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_INT64: {
+            std::int64_t v = 0;
+            ::pbeDecodeInt64(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_UINT64: {
+            std::uint64_t v = 0;
+            ::pbeDecodeUInt64(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_FLOAT: {
+            float v = 0;
+            ::pbeDecodeFloat(data, &v);
+            value = v;
+            break;
+        }
+        case COLUMN_DATA_TYPE_DOUBLE: {
+            double v = 0;
+            ::pbeDecodeDouble(data, &v);
+            value = v;
+            break;
+        }
+        default: throw std::logic_error("invalid data type");
+    }  // switch
+}
+
 void Column::loadText(const ColumnDataAddress& addr, Variant& value, bool lobStreamsMustHoldSource)
 {
     auto block = findExistingBlock(addr.getBlockId());
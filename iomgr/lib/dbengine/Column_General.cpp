@@ -81,7 +81,10 @@ Column::Column(Table& table, ColumnSpecification&& spec, std::uint64_t firstUser
     , m_notNull(false)
     , m_blockRegistry(*this, true)
     , m_lastBlockId(m_blockRegistry.getLastBlockId())
+    , m_rollbackCount(0)
     , m_blockCache(getDatabase().getInstance().getBlockCacheCapacity())
+    , m_spareDataFilePreparationScheduled(false)
+    , m_takenSpareDataFileCount(0)
 {
     if (isMasterColumn()) {
         if (!spec.m_constraints.empty()) {
@@ -135,11 +138,21 @@ Column::Column(Table& table, const ColumnRecord& columnRecord, std::uint64_t fir
     , m_notNull(m_currentColumnDefinition->isNotNull())
     , m_blockRegistry(*this)
     , m_lastBlockId(m_blockRegistry.getLastBlockId())
+    , m_rollbackCount(0)
     , m_blockCache(table.getDatabase().getInstance().getBlockCacheCapacity())
+    , m_spareDataFilePreparationScheduled(false)
+    , m_takenSpareDataFileCount(0)
 {
     checkDataConsistency();
 }
 
+Column::~Column()
+{
+    auto& instance = getDatabase().getInstance();
+    for (std::size_t i = 0; i < m_spareDataFiles.size(); ++i)
+        instance.releaseSpareDataBlockFileDescriptor();
+}
+
 std::string Column::makeDisplayName() const
 {
     std::ostringstream oss;
@@ -194,6 +207,7 @@ void Column::rollbackToAddress(
         const ColumnDataAddress& addr, const std::uint64_t firstAvailableBlockId)
 {
     std::lock_guard lock(m_mutex);
+    ++m_rollbackCount;
 
     // Check first available data block
     if (m_availableDataBlocks.count(firstAvailableBlockId) == 0) {
@@ -270,6 +284,16 @@ std::uint32_t Column::loadLobChunkHeader(
     return loadLobChunkHeaderUnlocked(*block, offset, header);
 }
 
+std::uint32_t Column::loadLobChunkHeader(std::uint64_t blockId, std::uint32_t offset,
+        LobChunkHeader& header, ColumnDataBlockPtr& block)
+{
+    std::lock_guard lock(m_mutex);
+    auto chunkBlock = findExistingBlock(blockId);
+    const auto offsetAfterHeader = loadLobChunkHeaderUnlocked(*chunkBlock, offset, header);
+    block = std::move(chunkBlock);
+    return offsetAfterHeader;
+}
+
 void Column::readData(
         std::uint64_t blockId, std::uint32_t offset, void* buffer, std::size_t bufferSize)
 {
@@ -278,6 +302,14 @@ void Column::readData(
     block->readData(buffer, bufferSize, offset);
 }
 
+void Column::readData(
+        const ColumnDataBlock& block, std::uint32_t offset, void* buffer, std::size_t bufferSize)
+{
+    // Block file object is shared with writers
+    std::lock_guard lock(m_mutex);
+    block.readData(buffer, bufferSize, offset);
+}
+
 std::uint64_t Column::generateNextUserTrid()
 {
     if (!m_masterColumnData) {
@@ -466,7 +498,6 @@ void Column::checkDataConsistency()
     struct BlockInfo {
         std::uint64_t m_currentBlockId;
         std::uint64_t m_prevBlockId;
-        ColumnDataBlockHeader::Digest m_prevBlockDigest;
     };
 
     std::stack<BlockInfo> stack;
@@ -476,7 +507,6 @@ void Column::checkDataConsistency()
     blockInfo.m_currentBlockId = findFirstBlock();
     if (blockInfo.m_currentBlockId != 0) {
         blockInfo.m_prevBlockId = 0;
-        blockInfo.m_prevBlockDigest = ColumnDataBlockHeader::kInitialPrevBlockDigest;
         stack.push(blockInfo);
     }
 
@@ -498,19 +528,10 @@ void Column::checkDataConsistency()
                         getDatabaseUuid(), m_table.getId(), m_id, "previous block ID mismatch");
             }
 
-            // We can check only closed blocks
+            // We can check only closed blocks. Their digests are verified
+            // in background by the data scrubber, see verifyBlock().
             if (currentBlock->getState() != ColumnDataBlockState::kClosed) break;
 
-            // Check block digest based on data in block
-            ColumnDataBlockHeader::Digest currentBlockDigest;
-            currentBlock->computeDigest(blockInfo.m_prevBlockDigest, currentBlockDigest);
-            if (currentBlock->getDigest() == currentBlockDigest) {
-                LOG_DEBUG << "block digest mismatch";
-                throwDatabaseError(IOManagerMessageId::kErrorColumnDataBlockConsistencyMismatch,
-                        getDatabaseName(), m_table.getName(), getName(), blockInfo.m_currentBlockId,
-                        getDatabaseUuid(), m_table.getId(), m_id, "block digest mismatch");
-            }
-
             // Collect block into available block list, if it has enough free space
             if (currentBlock->getFreeDataSpace() >= s_minRequiredBlockFreeSpaces[m_dataType]) {
                 m_availableDataBlocks.emplace(
@@ -521,7 +542,6 @@ void Column::checkDataConsistency()
             const auto nextBlockIds = m_blockRegistry.findNextBlockIds(blockInfo.m_currentBlockId);
             if (nextBlockIds.empty()) break;
             blockInfo.m_prevBlockId = blockInfo.m_currentBlockId;
-            blockInfo.m_prevBlockDigest = currentBlockDigest;
             if (nextBlockIds.size() == 1) {
                 blockInfo.m_currentBlockId = nextBlockIds.front();
                 continue;
@@ -0,0 +1,245 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "DataScrubber.h"
+
+// Project headers
+#include "Column.h"
+#include "Database.h"
+#include "Instance.h"
+#include "Table.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/io/FileIO.h>
+#include <siodb/common/log/Log.h>
+#include <siodb/common/utils/FDGuard.h>
+#include <siodb/common/utils/FSUtils.h>
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// STL headers
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+// System headers
+#include <fcntl.h>
+
+namespace siodb::iomgr::dbengine {
+
+DataScrubber::DataScrubber(
+        Instance& instance, unsigned rate, unsigned interval, unsigned startDelay)
+    : m_instance(instance)
+    , m_progressFilePath(utils::constructPath(instance.getDataDir(), kProgressFileName))
+    , m_startDelay(startDelay)
+    , m_shouldRun(rate > 0)
+{
+    m_status.m_rate = static_cast<std::size_t>(rate) * 1024 * 1024;
+    m_status.m_interval = static_cast<std::time_t>(interval) * 3600;
+    if (m_shouldRun) {
+        loadProgress();
+        m_thread = std::thread(&DataScrubber::threadMain, this);
+    }
+}
+
+DataScrubber::~DataScrubber()
+{
+    m_shouldRun = false;
+    {
+        std::lock_guard lock(m_mutex);
+        m_cond.notify_one();
+    }
+    if (m_thread.joinable()) m_thread.join();
+}
+
+DataScrubberStatus DataScrubber::getStatus() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_status;
+}
+
+// --- internals ---
+
+void DataScrubber::threadMain()
+{
+    LOG_INFO << "DataScrubber: Thread started";
+    if (wait(m_startDelay)) {
+        while (scrubInstance()) {
+            {
+                std::lock_guard lock(m_mutex);
+                ++m_status.m_passNumber;
+                m_status.m_lastPassCompletionTimestamp = std::time(nullptr);
+                m_status.m_databaseId = 0;
+                m_status.m_tableId = 0;
+                m_status.m_columnId = 0;
+                m_status.m_blockId = 0;
+            }
+            saveProgress();
+            LOG_INFO << "DataScrubber: Pass completed";
+            if (!wait(kPassDelay)) break;
+        }
+    }
+    LOG_INFO << "DataScrubber: Thread is exiting";
+}
+
+bool DataScrubber::scrubInstance()
+{
+    std::uint32_t startDatabaseId, startTableId;
+    std::uint64_t startColumnId;
+    {
+        std::lock_guard lock(m_mutex);
+        startDatabaseId = m_status.m_databaseId;
+        startTableId = m_status.m_tableId;
+        startColumnId = m_status.m_columnId;
+    }
+
+    for (const auto databaseId : m_instance.getDatabaseIds()) {
+        if (databaseId < startDatabaseId) continue;
+        const auto database = m_instance.findDatabase(databaseId);
+        if (!database) continue;
+        for (const auto tableId : database->getTableIds()) {
+            if (databaseId == startDatabaseId && tableId < startTableId) continue;
+            std::vector<ColumnPtr> columns;
+            try {
+                columns = database->findTableChecked(tableId)->getColumnsOrderedByPosition();
+            } catch (std::exception& ex) {
+                // Table could be dropped meanwhile
+                LOG_WARNING << "DataScrubber: Skipping table " << database->makeDisplayName()
+                            << '.' << tableId << ": " << ex.what();
+                continue;
+            }
+            std::sort(columns.begin(), columns.end(),
+                    [](const auto& left, const auto& right) noexcept {
+                        return left->getId() < right->getId();
+                    });
+            for (const auto& column : columns) {
+                if (databaseId == startDatabaseId && tableId == startTableId
+                        && column->getId() < startColumnId)
+                    continue;
+                setPosition(databaseId, tableId, column->getId());
+                if (!scrubColumn(*column)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool DataScrubber::scrubColumn(Column& column)
+{
+    const auto verifiedBefore = std::time(nullptr) - m_status.m_interval;
+    const auto lastBlockId = column.getLastBlockId();
+    for (std::uint64_t blockId = 1; blockId <= lastBlockId; ++blockId) {
+        if (!m_shouldRun) return false;
+        {
+            std::lock_guard lock(m_mutex);
+            m_status.m_blockId = blockId;
+        }
+
+        std::size_t dataSize = 0;
+        try {
+            if (!column.verifyBlock(blockId, verifiedBefore, dataSize)) {
+                std::ostringstream err;
+                err << "Block " << column.makeDisplayName() << '.' << blockId << " ("
+                    << column.makeDisplayCode() << '.' << blockId << ") digest mismatch";
+                recordFailure(err.str());
+            }
+        } catch (std::exception& ex) {
+            std::ostringstream err;
+            err << "Block " << column.makeDisplayName() << '.' << blockId << " ("
+                << column.makeDisplayCode() << '.' << blockId
+                << ") verification failed: " << ex.what();
+            recordFailure(err.str());
+        }
+
+        if (dataSize > 0) {
+            {
+                std::lock_guard lock(m_mutex);
+                ++m_status.m_verifiedBlockCount;
+                m_status.m_verifiedDataSize += dataSize;
+            }
+            // Throttle reading
+            if (!wait(static_cast<double>(dataSize) / m_status.m_rate)) return false;
+        }
+    }
+    return true;
+}
+
+void DataScrubber::setPosition(
+        std::uint32_t databaseId, std::uint32_t tableId, std::uint64_t columnId)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_status.m_databaseId = databaseId;
+        m_status.m_tableId = tableId;
+        m_status.m_columnId = columnId;
+        m_status.m_blockId = 0;
+    }
+    saveProgress();
+}
+
+void DataScrubber::recordFailure(std::string&& failure)
+{
+    LOG_ERROR << "DataScrubber: " << failure;
+    std::lock_guard lock(m_mutex);
+    ++m_status.m_failedBlockCount;
+    m_status.m_lastFailure = std::move(failure);
+    m_status.m_lastFailureTimestamp = std::time(nullptr);
+}
+
+bool DataScrubber::wait(double seconds)
+{
+    std::unique_lock lock(m_mutex);
+    return !m_cond.wait_for(lock, std::chrono::duration<double>(seconds),
+            [this]() noexcept { return !m_shouldRun; });
+}
+
+void DataScrubber::loadProgress()
+{
+    FDGuard file(::open(m_progressFilePath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!file.isValidFd()) return;
+
+    std::uint8_t buffer[kSerializedProgressSize];
+    if (::preadExact(file.getFD(), buffer, sizeof(buffer), 0, kIgnoreSignals) != sizeof(buffer)) {
+        LOG_WARNING << "DataScrubber: Can't read progress file " << m_progressFilePath
+                    << ", starting from the beginning";
+        return;
+    }
+
+    std::uint32_t version = 0;
+    const std::uint8_t* p = ::pbeDecodeUInt32(buffer, &version);
+    if (version > kCurrentProgressVersion) {
+        LOG_WARNING << "DataScrubber: Unsupported progress file version " << version
+                    << ", starting from the beginning";
+        return;
+    }
+    p = ::pbeDecodeUInt64(p, &m_status.m_passNumber);
+    p = ::pbeDecodeUInt32(p, &m_status.m_databaseId);
+    p = ::pbeDecodeUInt32(p, &m_status.m_tableId);
+    ::pbeDecodeUInt64(p, &m_status.m_columnId);
+}
+
+void DataScrubber::saveProgress() const
+{
+    std::uint8_t buffer[kSerializedProgressSize];
+    {
+        std::lock_guard lock(m_mutex);
+        std::uint8_t* p = ::pbeEncodeUInt32(kCurrentProgressVersion, buffer);
+        p = ::pbeEncodeUInt64(m_status.m_passNumber, p);
+        p = ::pbeEncodeUInt32(m_status.m_databaseId, p);
+        p = ::pbeEncodeUInt32(m_status.m_tableId, p);
+        ::pbeEncodeUInt64(m_status.m_columnId, p);
+    }
+
+    FDGuard file(::open(m_progressFilePath.c_str(), O_CREAT | O_WRONLY | O_CLOEXEC | O_NOATIME,
+            kDataFileCreationMode));
+    if (!file.isValidFd()
+            || ::pwriteExact(file.getFD(), buffer, sizeof(buffer), 0, kIgnoreSignals)
+                       != sizeof(buffer)) {
+        const int errorCode = errno;
+        LOG_WARNING << "DataScrubber: Can't save progress file " << m_progressFilePath << ": "
+                    << std::strerror(errorCode);
+    }
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,189 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "ColumnPtr.h"
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+
+// CRT headers
+#include <cstdint>
+#include <ctime>
+
+// STL headers
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace siodb::iomgr::dbengine {
+
+class Instance;
+
+/** Data scrubber status */
+struct DataScrubberStatus {
+    /** Data read rate in bytes per second, zero if scrubber is disabled */
+    std::size_t m_rate = 0;
+
+    /** Interval in seconds between verifications of the same block */
+    std::time_t m_interval = 0;
+
+    /** Current pass number */
+    std::uint64_t m_passNumber = 0;
+
+    /** Time when last pass was completed */
+    std::time_t m_lastPassCompletionTimestamp = 0;
+
+    /** Database ID of the current position */
+    std::uint32_t m_databaseId = 0;
+
+    /** Table ID of the current position */
+    std::uint32_t m_tableId = 0;
+
+    /** Column ID of the current position */
+    std::uint64_t m_columnId = 0;
+
+    /** Block ID of the current position */
+    std::uint64_t m_blockId = 0;
+
+    /** Number of blocks verified since startup */
+    std::uint64_t m_verifiedBlockCount = 0;
+
+    /** Amount of data in bytes verified since startup */
+    std::uint64_t m_verifiedDataSize = 0;
+
+    /** Number of blocks which failed verification since startup */
+    std::uint64_t m_failedBlockCount = 0;
+
+    /** Description of the last verification failure */
+    std::string m_lastFailure;
+
+    /** Time of the last verification failure */
+    std::time_t m_lastFailureTimestamp = 0;
+};
+
+/**
+ * Data scrubber. Verifies digests of the closed column data blocks in background,
+ * reading data at limited rate, so that instance startup and user requests don't pay
+ * for reading all data. Walks databases, tables and columns in order of IDs and
+ * persists position, so that it continues from the same place after restart.
+ * Blocks are reverified only after configured interval.
+ */
+class DataScrubber {
+public:
+    /** Default delay in seconds before first pass, so that scrubber doesn't slow down startup */
+    static constexpr unsigned kDefaultStartDelay = 60;
+
+    /**
+     * Initializes object of class DataScrubber. Starts scrubber thread, if enabled.
+     * @param instance Instance object.
+     * @param rate Data read rate in megabytes per second, zero disables scrubber.
+     * @param interval Interval in hours between verifications of the same block.
+     * @param startDelay Delay in seconds before first pass.
+     */
+    DataScrubber(Instance& instance, unsigned rate, unsigned interval,
+            unsigned startDelay = kDefaultStartDelay);
+
+    /** De-initializes object of class DataScrubber. Stops scrubber thread. */
+    ~DataScrubber();
+
+    DECLARE_NONCOPYABLE(DataScrubber);
+
+    /**
+     * Returns current status.
+     * @return Scrubber status.
+     */
+    DataScrubberStatus getStatus() const;
+
+private:
+    /** Scrubber thread entry point. */
+    void threadMain();
+
+    /**
+     * Performs single pass over all databases.
+     * @return true if pass is completed, false if scrubber is stopped.
+     */
+    bool scrubInstance();
+
+    /**
+     * Verifies blocks of a column.
+     * @param column Column object.
+     * @return true if column is completed, false if scrubber is stopped.
+     */
+    bool scrubColumn(Column& column);
+
+    /**
+     * Updates current position.
+     * @param databaseId Database ID.
+     * @param tableId Table ID.
+     * @param columnId Column ID.
+     */
+    void setPosition(std::uint32_t databaseId, std::uint32_t tableId, std::uint64_t columnId);
+
+    /**
+     * Records verification failure.
+     * @param failure Failure description.
+     */
+    void recordFailure(std::string&& failure);
+
+    /**
+     * Waits for given time or until scrubber is stopped.
+     * @param seconds Time in seconds.
+     * @return true if time has elapsed, false if scrubber is stopped.
+     */
+    bool wait(double seconds);
+
+    /** Loads persisted position. */
+    void loadProgress();
+
+    /** Persists current position. */
+    void saveProgress() const;
+
+private:
+    /** Instance object */
+    Instance& m_instance;
+
+    /** Progress file path */
+    const std::string m_progressFilePath;
+
+    /** Status access synchronization object */
+    mutable std::mutex m_mutex;
+
+    /** Stop notification */
+    std::condition_variable m_cond;
+
+    /** Status */
+    DataScrubberStatus m_status;
+
+    /** Delay in seconds before first pass */
+    const unsigned m_startDelay;
+
+    /** Indication that thread should continue to run */
+    std::atomic_bool m_shouldRun;
+
+    /** Scrubber thread, must be the last member variable in this class. */
+    std::thread m_thread;
+
+    /** Progress file name */
+    static constexpr const char* kProgressFileName = "data_scrubber_progress";
+
+    /** Progress file version */
+    static constexpr std::uint32_t kCurrentProgressVersion = 1;
+
+    /** Serialized progress size */
+    static constexpr std::size_t kSerializedProgressSize = sizeof(kCurrentProgressVersion)
+                                                           + sizeof(m_status.m_passNumber)
+                                                           + sizeof(m_status.m_databaseId)
+                                                           + sizeof(m_status.m_tableId)
+                                                           + sizeof(m_status.m_columnId);
+
+    /** Delay in seconds between passes */
+    static constexpr unsigned kPassDelay = 3600;
+};
+
+}  // namespace siodb::iomgr::dbengine
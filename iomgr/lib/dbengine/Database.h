@@ -248,6 +248,12 @@ public:
      */
     std::vector<TableRecord> getTableRecordsOrderedByName(std::uint32_t currentUserId) const;
 
+    /**
+     * Returns list of IDs of all tables, including system tables, ordered by ID.
+     * @return List of table IDs.
+     */
+    std::vector<std::uint32_t> getTableIds() const;
+
     /**
      * Returns indication that user table can be created in this database.
      * @return true if user table can be created in this database, false otherwise.
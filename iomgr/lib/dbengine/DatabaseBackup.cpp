@@ -0,0 +1,166 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "DatabaseBackup.h"
+
+// Project headers
+#include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "Database.h"
+#include "ThrowDatabaseError.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/log/Log.h>
+#include <siodb/common/stl_wrap/filesystem_wrapper.h>
+#include <siodb/common/utils/FSUtils.h>
+
+// CRT headers
+#include <cerrno>
+#include <cstring>
+
+// STL headers
+#include <algorithm>
+#include <fstream>
+
+namespace siodb::iomgr::dbengine {
+
+DatabaseBackup::DatabaseBackup(DatabasePtr database, const std::string& backupDir)
+    : m_database(std::move(database))
+    , m_backupDir(backupDir)
+    , m_timestamp(std::time(nullptr))
+    , m_blockStoreDir(utils::constructPath(m_backupDir, kBlockStoreDir))
+    , m_currentBackupDir(utils::constructPath(m_backupDir, m_database->getName(), '.', m_timestamp))
+    , m_snapshotDir(utils::constructPath(m_currentBackupDir, kSnapshotDir))
+{
+}
+
+DatabaseBackup::Result DatabaseBackup::run(utils::WorkerThreadPool& threadPool)
+{
+    LOG_INFO << "Database " << m_database->makeDisplayName() << ": starting backup into "
+             << m_currentBackupDir;
+
+    createDirectory(m_backupDir);
+    createDirectory(m_blockStoreDir);
+    if (fs::exists(m_currentBackupDir)) {
+        throwDatabaseError(IOManagerMessageId::kErrorCannotCreateBackupDir, m_currentBackupDir,
+                EEXIST, std::strerror(EEXIST));
+    }
+    createDirectory(m_currentBackupDir);
+    createDirectory(m_snapshotDir);
+
+    // Collect columns
+    std::vector<ColumnPtr> masterColumns, columns;
+    for (const auto tableId : m_database->getTableIds()) {
+        const auto table = m_database->findTableChecked(tableId);
+        for (auto& column : table->getColumnsOrderedByPosition()) {
+            if (column->isMasterColumn())
+                masterColumns.push_back(std::move(column));
+            else
+                columns.push_back(std::move(column));
+        }
+    }
+
+    // Column data are written before master column records, so capturing master columns
+    // first guarantees that all data referenced by the saved master column records
+    // is present in the backup.
+    backupColumns(masterColumns, threadPool);
+    backupColumns(columns, threadPool);
+
+    Result result;
+    writeManifest(result);
+
+    LOG_INFO << "Database " << m_database->makeDisplayName() << ": backup completed: "
+             << result.m_blockCount << " blocks, " << result.m_copiedBlockCount
+             << " sealed blocks copied, " << result.m_reusedBlockCount
+             << " sealed blocks reused, " << result.m_snapshotBlockCount << " open blocks";
+    return result;
+}
+
+// --- internals ---
+
+void DatabaseBackup::backupColumns(
+        const std::vector<ColumnPtr>& columns, utils::WorkerThreadPool& threadPool)
+{
+    std::vector<utils::WorkerThreadPool::Task> tasks;
+    tasks.reserve(columns.size());
+    for (const auto& column : columns) {
+        tasks.push_back([this, column] {
+            ColumnBackupInfo info;
+            info.m_tableId = column->getTableId();
+            info.m_columnId = column->getId();
+            info.m_blocks = column->backupDataBlocks(m_blockStoreDir, m_snapshotDir);
+            std::lock_guard lock(m_mutex);
+            m_columns.push_back(std::move(info));
+        });
+    }
+    threadPool.runAll(tasks);
+}
+
+void DatabaseBackup::createDirectory(const std::string& path)
+{
+    try {
+        fs::create_directories(path);
+    } catch (fs::filesystem_error& ex) {
+        throwDatabaseError(IOManagerMessageId::kErrorCannotCreateBackupDir, path,
+                ex.code().value(), ex.code().message());
+    }
+}
+
+void DatabaseBackup::writeManifest(Result& result)
+{
+    std::sort(m_columns.begin(), m_columns.end(), [](const auto& left, const auto& right) {
+        return left.m_tableId < right.m_tableId
+               || (left.m_tableId == right.m_tableId && left.m_columnId < right.m_columnId);
+    });
+
+    result.m_manifestFilePath = utils::constructPath(m_currentBackupDir, kManifestFile);
+    const auto tmpFilePath = result.m_manifestFilePath + kTempFileExtension;
+    {
+        std::ofstream ofs(tmpFilePath);
+        ofs << "# Siodb database backup manifest\n"
+            << "version " << kManifestVersion << '\n'
+            << "database " << m_database->getName() << ' ' << m_database->getUuid() << '\n'
+            << "timestamp " << m_timestamp << '\n'
+            << "# block <table_id> <column_id> <block_id> <prev_block_id> sealed|snapshot"
+               " <data_length> <digest> <path>\n";
+        for (const auto& column : m_columns) {
+            for (const auto& block : column.m_blocks) {
+                ofs << "block " << column.m_tableId << ' ' << column.m_columnId << ' '
+                    << block.m_blockId << ' ' << block.m_prevBlockId << ' '
+                    << (block.m_sealed ? "sealed" : "snapshot") << ' ' << block.m_dataLength
+                    << ' '
+                    << (block.m_sealed ? ColumnDataBlockHeader::digestToString(block.m_digest)
+                                       : std::string("-"))
+                    << ' ' << makeRelativePath(block.m_filePath) << '\n';
+                ++result.m_blockCount;
+                if (!block.m_sealed)
+                    ++result.m_snapshotBlockCount;
+                else if (block.m_alreadyStored)
+                    ++result.m_reusedBlockCount;
+                else
+                    ++result.m_copiedBlockCount;
+            }
+        }
+        ofs.flush();
+        if (!ofs) {
+            const int errorCode = errno;
+            throwDatabaseError(IOManagerMessageId::kErrorCannotWriteBackupManifest, tmpFilePath,
+                    errorCode, std::strerror(errorCode));
+        }
+    }
+
+    try {
+        fs::rename(tmpFilePath, result.m_manifestFilePath);
+    } catch (fs::filesystem_error& ex) {
+        throwDatabaseError(IOManagerMessageId::kErrorCannotWriteBackupManifest,
+                result.m_manifestFilePath, ex.code().value(), ex.code().message());
+    }
+}
+
+std::string DatabaseBackup::makeRelativePath(const std::string& path) const
+{
+    return path.substr(m_backupDir.length() + 1);
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,150 @@
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "Column.h"
+#include "DatabasePtr.h"
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+#include <siodb/common/utils/WorkerThreadPool.h>
+
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace siodb::iomgr::dbengine {
+
+/**
+ * Online backup of the database column data.
+ * Backup directory may be shared by multiple backups. Sealed data blocks are stored
+ * in the common block store and named by their digest, so that each next backup
+ * copies only blocks that are not yet present there. Each backup has own subdirectory
+ * with the manifest and snapshots of the open blocks.
+ */
+class DatabaseBackup {
+public:
+    /** Block store subdirectory */
+    static constexpr const char* kBlockStoreDir = "blocks";
+
+    /** Open block snapshot subdirectory */
+    static constexpr const char* kSnapshotDir = "snapshot";
+
+    /** Manifest file name */
+    static constexpr const char* kManifestFile = "manifest";
+
+    /** Current manifest format version */
+    static constexpr unsigned kManifestVersion = 1;
+
+    /** Backup statistics */
+    struct Result {
+        /** Manifest file path */
+        std::string m_manifestFilePath;
+
+        /** Total number of blocks in the backup */
+        std::size_t m_blockCount = 0;
+
+        /** Number of sealed blocks copied into the block store */
+        std::size_t m_copiedBlockCount = 0;
+
+        /** Number of sealed blocks that were already present in the block store */
+        std::size_t m_reusedBlockCount = 0;
+
+        /** Number of open block snapshots */
+        std::size_t m_snapshotBlockCount = 0;
+    };
+
+public:
+    /**
+     * Initializes object of class DatabaseBackup.
+     * @param database Database to backup.
+     * @param backupDir Backup directory.
+     */
+    DatabaseBackup(DatabasePtr database, const std::string& backupDir);
+
+    DECLARE_NONCOPYABLE(DatabaseBackup);
+
+    /**
+     * Performs backup. Data of all master columns is captured first, so that all
+     * data referenced by the captured master column records is present in the backup.
+     * Columns are saved in parallel.
+     * @param threadPool Thread pool used to save columns.
+     * @return Backup statistics.
+     * @throw DatabaseError if operation fails for any reason
+     */
+    Result run(utils::WorkerThreadPool& threadPool);
+
+private:
+    /** Backed up column data blocks */
+    struct ColumnBackupInfo {
+        /** Table ID */
+        std::uint32_t m_tableId;
+
+        /** Column ID */
+        std::uint64_t m_columnId;
+
+        /** Saved blocks */
+        std::vector<Column::DataBlockBackupInfo> m_blocks;
+    };
+
+private:
+    /**
+     * Saves data blocks of given columns in parallel.
+     * @param columns Column list.
+     * @param threadPool Thread pool.
+     */
+    void backupColumns(const std::vector<ColumnPtr>& columns, utils::WorkerThreadPool& threadPool);
+
+    /**
+     * Creates directory if it doesn't exist.
+     * @param path Directory path.
+     */
+    static void createDirectory(const std::string& path);
+
+    /**
+     * Writes manifest file.
+     * @param[out] result Backup statistics.
+     */
+    void writeManifest(Result& result);
+
+    /**
+     * Returns path relative to the backup directory.
+     * @param path Full path.
+     * @return Relative path.
+     */
+    std::string makeRelativePath(const std::string& path) const;
+
+private:
+    /** Database */
+    const DatabasePtr m_database;
+
+    /** Backup directory */
+    const std::string m_backupDir;
+
+    /** Backup timestamp */
+    const std::time_t m_timestamp;
+
+    /** Block store directory */
+    const std::string m_blockStoreDir;
+
+    /** This backup directory */
+    const std::string m_currentBackupDir;
+
+    /** Open block snapshot directory */
+    const std::string m_snapshotDir;
+
+    /** Backed up columns */
+    std::vector<ColumnBackupInfo> m_columns;
+
+    /** Backed up columns list access synchronization object */
+    std::mutex m_mutex;
+};
+
+}  // namespace siodb::iomgr::dbengine
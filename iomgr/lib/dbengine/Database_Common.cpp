@@ -108,6 +108,16 @@ std::vector<TableRecord> Database::getTableRecordsOrderedByName(std::uint32_t cu
     return result;
 }
 
+std::vector<std::uint32_t> Database::getTableIds() const
+{
+    std::lock_guard lock(m_mutex);
+    std::vector<std::uint32_t> result;
+    result.reserve(m_tableRegistry.size());
+    for (const auto& tableRecord : m_tableRegistry.byId())
+        result.push_back(tableRecord.m_id);
+    return result;
+}
+
 TablePtr Database::findTableChecked(const std::string& tableName)
 {
     std::lock_guard lock(m_mutex);
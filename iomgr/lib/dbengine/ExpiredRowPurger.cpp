@@ -0,0 +1,109 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "ExpiredRowPurger.h"
+
+// Project headers
+#include "Database.h"
+#include "Instance.h"
+#include "Table.h"
+#include "User.h"
+
+// Common project headers
+#include <siodb/common/log/Log.h>
+
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <chrono>
+
+namespace siodb::iomgr::dbengine {
+
+ExpiredRowPurger::ExpiredRowPurger(Instance& instance, unsigned rate)
+    : m_instance(instance)
+    , m_rate(rate)
+    , m_purgedRowCount(0)
+    , m_shouldRun(rate > 0)
+{
+    if (m_shouldRun) m_thread = std::thread(&ExpiredRowPurger::threadMain, this);
+}
+
+ExpiredRowPurger::~ExpiredRowPurger()
+{
+    m_shouldRun = false;
+    {
+        std::lock_guard lock(m_mutex);
+        m_cond.notify_one();
+    }
+    if (m_thread.joinable()) m_thread.join();
+}
+
+// --- internals ---
+
+void ExpiredRowPurger::threadMain()
+{
+    LOG_INFO << "ExpiredRowPurger: Thread started";
+    if (wait(kStartDelay)) {
+        while (purgeInstance()) {
+            if (!wait(kPassDelay)) break;
+        }
+    }
+    LOG_INFO << "ExpiredRowPurger: Thread is exiting, " << m_purgedRowCount
+             << " rows deleted since startup";
+}
+
+bool ExpiredRowPurger::purgeInstance()
+{
+    for (const auto databaseId : m_instance.getDatabaseIds()) {
+        const auto database = m_instance.findDatabase(databaseId);
+        if (!database || database->isSystemDatabase()) continue;
+        for (const auto tableId : database->getTableIds()) {
+            TablePtr table;
+            try {
+                table = database->findTableChecked(tableId);
+            } catch (std::exception& ex) {
+                // Table could be dropped meanwhile
+                LOG_WARNING << "ExpiredRowPurger: Skipping table " << database->makeDisplayName()
+                            << '.' << tableId << ": " << ex.what();
+                continue;
+            }
+            if (!table->isSystemTable() && !purgeTable(*table)) return false;
+        }
+    }
+    return true;
+}
+
+bool ExpiredRowPurger::purgeTable(Table& table)
+{
+    while (m_shouldRun) {
+        Table::PurgeExpiredRowsResult result;
+        try {
+            result = table.purgeExpiredRows(
+                    User::kSuperUserId, std::time(nullptr), kBatchSize, kMaxScannedRowCount);
+        } catch (std::exception& ex) {
+            LOG_ERROR << "ExpiredRowPurger: Can't delete expired rows from the table "
+                      << table.makeDisplayName() << " (" << table.makeDisplayCode()
+                      << "): " << ex.what();
+            return true;
+        }
+
+        if (result.m_deletedRowCount > 0) {
+            m_purgedRowCount += result.m_deletedRowCount;
+            // Throttle deletion
+            if (!wait(static_cast<double>(result.m_deletedRowCount) / m_rate)) return false;
+        }
+        if (result.m_endOfTable) return true;
+    }
+    return false;
+}
+
+bool ExpiredRowPurger::wait(double seconds)
+{
+    std::unique_lock lock(m_mutex);
+    return !m_cond.wait_for(lock, std::chrono::duration<double>(seconds),
+            [this]() noexcept { return !m_shouldRun; });
+}
+
+}  // namespace siodb::iomgr::dbengine
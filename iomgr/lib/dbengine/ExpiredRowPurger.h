@@ -0,0 +1,105 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "TablePtr.h"
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+
+// CRT headers
+#include <cstdint>
+
+// STL headers
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace siodb::iomgr::dbengine {
+
+class Instance;
+
+/**
+ * Expired row purger. Deletes rows, which have reached their expiration timestamp,
+ * from the user tables in background, in small batches and at limited rate,
+ * so that purging doesn't compete with user requests. Expired rows are already
+ * invisible to readers, so purging only reclaims them.
+ */
+class ExpiredRowPurger {
+public:
+    /**
+     * Initializes object of class ExpiredRowPurger. Starts purger thread, if enabled.
+     * @param instance Instance object.
+     * @param rate Number of rows deleted per second, zero disables purger.
+     */
+    ExpiredRowPurger(Instance& instance, unsigned rate);
+
+    /** De-initializes object of class ExpiredRowPurger. Stops purger thread. */
+    ~ExpiredRowPurger();
+
+    DECLARE_NONCOPYABLE(ExpiredRowPurger);
+
+private:
+    /** Purger thread entry point. */
+    void threadMain();
+
+    /**
+     * Performs single pass over all user tables.
+     * @return true if pass is completed, false if purger is stopped.
+     */
+    bool purgeInstance();
+
+    /**
+     * Deletes expired rows of a table, scanning it up to the end.
+     * @param table Table object.
+     * @return true if table is completed, false if purger is stopped.
+     */
+    bool purgeTable(Table& table);
+
+    /**
+     * Waits for given time or until purger is stopped.
+     * @param seconds Time in seconds.
+     * @return true if time has elapsed, false if purger is stopped.
+     */
+    bool wait(double seconds);
+
+private:
+    /** Instance object */
+    Instance& m_instance;
+
+    /** Number of rows deleted per second */
+    const unsigned m_rate;
+
+    /** Number of rows deleted since startup */
+    std::uint64_t m_purgedRowCount;
+
+    /** Stop notification synchronization object */
+    std::mutex m_mutex;
+
+    /** Stop notification */
+    std::condition_variable m_cond;
+
+    /** Indication that thread should continue to run */
+    std::atomic_bool m_shouldRun;
+
+    /** Purger thread, must be the last member variable in this class. */
+    std::thread m_thread;
+
+    /** Maximum number of rows deleted while table is locked */
+    static constexpr std::size_t kBatchSize = 100;
+
+    /** Maximum number of rows scanned while table is locked */
+    static constexpr std::size_t kMaxScannedRowCount = 10000;
+
+    /** Delay in seconds before first pass, so that purger doesn't slow down startup */
+    static constexpr unsigned kStartDelay = 60;
+
+    /** Delay in seconds between passes */
+    static constexpr unsigned kPassDelay = 60;
+};
+
+}  // namespace siodb::iomgr::dbengine
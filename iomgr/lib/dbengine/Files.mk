@@ -13,6 +13,7 @@ include uli/Files.mk
 
 CXX_SRC+= \
 	BlockRegistry.cpp \
+	Column_Backup.cpp \
 	Column_DataBlockManagement.cpp \
 	Column_DataIO.cpp \
 	Column_General.cpp \
@@ -21,7 +22,9 @@ CXX_SRC+= \
 	ColumnDataAddress.cpp \
 	ColumnDataBlock.cpp \
 	ColumnDataBlockCache.cpp \
+	ColumnDataBlockCompression.cpp \
 	ColumnDataBlockHeader.cpp \
+	ColumnDataBlockZoneMap.cpp \
 	ColumnDataRecord.cpp \
 	ColumnDefinition.cpp \
 	ColumnDefinitionCache.cpp \
@@ -31,7 +34,9 @@ CXX_SRC+= \
 	ColumnSpecification.cpp \
 	Constraint.cpp \
 	ConstraintDefinition.cpp \
+	DataScrubber.cpp \
 	DataSet.cpp \
+	DatabaseBackup.cpp \
 	DatabaseMetadata.cpp \
 	Database_Common.cpp \
 	Database_Init.cpp \
@@ -39,6 +44,7 @@ CXX_SRC+= \
 	Database_ReadObjects2.cpp \
 	Database_RecordObjects.cpp \
 	Database_SysTablesIO.cpp \
+	ExpiredRowPurger.cpp \
 	Index.cpp \
 	IndexColumn.cpp \
 	IndexFileHeaderBase.cpp \
@@ -64,7 +70,8 @@ CXX_SRC+= \
 	UserAccessKey.cpp \
 	UserDatabase.cpp \
 	UserPermission.cpp \
-	UserToken.cpp
+	UserToken.cpp \
+	ZoneMapFilter.cpp
 
 CXX_HDR+= \
 	AuthenticationResult.h \
@@ -77,8 +84,11 @@ CXX_HDR+= \
 	ColumnDataBlock.h \
 	ColumnDataBlockHeader.h \
 	ColumnDataBlockCache.h \
+	ColumnDataBlockCompression.h \
 	ColumnDataBlockPtr.h \
 	ColumnDataBlockState.h \
+	ColumnDataBlockZoneMap.h \
+	ColumnDataReadBuffer.h \
 	ColumnDataRecord.h \
 	ColumnDefinition.h \
 	ColumnDefinitionCache.h \
@@ -139,4 +149,5 @@ CXX_HDR+= \
 	UserPermission.h \
 	UserPtr.h \
 	UserToken.h \
-	UserTokenPtr.h
+	UserTokenPtr.h \
+	ZoneMapFilter.h
@@ -99,6 +99,15 @@ public:
         return m_name;
     }
 
+    /**
+     * Returns value size.
+     * @return Value size.
+     */
+    auto getValueSize() const noexcept
+    {
+        return m_valueSize;
+    }
+
     /**
      * Returns index description.
      * @return Index description.
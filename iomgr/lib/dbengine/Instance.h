@@ -7,7 +7,9 @@
 // Project headers
 #include "AuthenticationResult.h"
 #include "ClientSession.h"
+#include "DataScrubber.h"
 #include "DatabasePtr.h"
+#include "ExpiredRowPurger.h"
 #include "InstancePtr.h"
 #include "UpdateUserAccessKeyParameters.h"
 #include "UpdateUserParameters.h"
@@ -21,10 +23,14 @@
 // Common project headers
 #include <siodb/common/utils/FDGuard.h>
 #include <siodb/common/utils/HelperMacros.h>
+#include <siodb/common/utils/WorkerThreadPool.h>
 #include <siodb/iomgr/shared/dbengine/crypto/ciphers/CipherContextPtr.h>
 #include <siodb/iomgr/shared/dbengine/crypto/ciphers/CipherPtr.h>
+#include <siodb/iomgr/shared/dbengine/io/FileDescriptorCache.h>
 
 // STL headers
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 
@@ -101,6 +107,89 @@ public:
         return m_blockCacheCapacity;
     }
 
+    /**
+     * Returns compression level of the full column data blocks.
+     * @return Compression level, zero if compression is disabled.
+     */
+    int getDataBlockCompressionLevel() const noexcept
+    {
+        return m_dataBlockCompressionLevel;
+    }
+
+    /**
+     * Returns size of the column data read ahead by table scan.
+     * @return Prefetch size in bytes, zero if prefetch is disabled.
+     */
+    std::size_t getScanPrefetchSize() const noexcept
+    {
+        return m_scanPrefetchSize;
+    }
+
+    /**
+     * Returns thread pool used for the parallel data writing.
+     * @return Writer thread pool.
+     */
+    utils::WorkerThreadPool& getWriterThreadPool() noexcept
+    {
+        return m_writerThreadPool;
+    }
+
+    /**
+     * Returns thread pool used for the parallel table scan.
+     * @return Scan thread pool or nullptr if parallel scan is disabled.
+     */
+    utils::WorkerThreadPool* getScanThreadPool() noexcept
+    {
+        return m_scanThreadPool.get();
+    }
+
+    /**
+     * Returns cache which limits number of open column data block and index files.
+     * @return File descriptor cache.
+     */
+    io::FileDescriptorCache& getFileDescriptorCache() noexcept
+    {
+        return m_fileDescriptorCache;
+    }
+
+    /**
+     * Returns number of column data block files created in advance for each column.
+     * @return Number of spare data block files, zero if they are not created in advance.
+     */
+    std::size_t getSpareDataBlockFileCount() const noexcept
+    {
+        return m_spareDataBlockFileCount;
+    }
+
+    /**
+     * Reserves file descriptor for a column data block file created in advance.
+     * Such files are anonymous, so file descriptor cache can't close and reopen them.
+     * Instead, they are limited instance-wide to a share of the cache capacity.
+     * @return true if descriptor is reserved, false if limit is reached.
+     */
+    bool reserveSpareDataBlockFileDescriptor() noexcept;
+
+    /** Releases file descriptor reserved for a column data block file created in advance. */
+    void releaseSpareDataBlockFileDescriptor() noexcept;
+
+    /**
+     * Returns thread pool used to create column data block files in advance.
+     * @return Thread pool or nullptr if block files are not created in advance.
+     */
+    utils::WorkerThreadPool* getDataBlockFileThreadPool() noexcept
+    {
+        return m_dataBlockFileThreadPool.get();
+    }
+
+    /**
+     * Returns data scrubber status.
+     * @return Data scrubber status.
+     */
+    DataScrubberStatus getDataScrubberStatus() const
+    {
+        return m_dataScrubber->getStatus();
+    }
+
     /**
      * Returns default database cipher.
      * @return Default database cipher.
@@ -135,6 +224,12 @@ public:
      */
     std::size_t getDatabaseCount() const;
 
+    /**
+     * Returns list of IDs of all databases, including system database, ordered by ID.
+     * @return List of database IDs.
+     */
+    std::vector<std::uint32_t> getDatabaseIds() const;
+
     /**
      * Returns list of database records which can be listed by current user, ordered by name.
      * @param currentUserId Current user ID.
@@ -567,6 +662,13 @@ private:
      */
     BinaryValue loadMasterCipherKey(const std::string& keyPath) const;
 
+    /**
+     * Returns file descriptor cache capacity.
+     * @param configuredCapacity Configured capacity, zero means automatic.
+     * @return Configured capacity if it is nonzero, half of the open file limit otherwise.
+     */
+    static std::size_t getFileDescriptorCacheCapacity(std::size_t configuredCapacity) noexcept;
+
     /**
      * Loads initial super-user access key.
      * @return Access key text
@@ -806,6 +908,33 @@ private:
     /** Block cache capacity */
     const std::size_t m_blockCacheCapacity;
 
+    /** Compression level of the full column data blocks */
+    const int m_dataBlockCompressionLevel;
+
+    /** Size of the column data read ahead by table scan */
+    const std::size_t m_scanPrefetchSize;
+
+    /** Writer thread pool */
+    utils::WorkerThreadPool m_writerThreadPool;
+
+    /** Scan thread pool, if parallel scan is enabled */
+    const std::unique_ptr<utils::WorkerThreadPool> m_scanThreadPool;
+
+    /**
+     * Open file limit for column data blocks and indices.
+     * Must outlive databases, so that files are detached before it is destroyed.
+     */
+    io::FileDescriptorCache m_fileDescriptorCache;
+
+    /** Number of column data block files created in advance for each column */
+    const std::size_t m_spareDataBlockFileCount;
+
+    /** Maximum number of open column data block files created in advance, over all columns */
+    const std::size_t m_maxSpareDataBlockFileDescriptorCount;
+
+    /** Number of open column data block files created in advance, over all columns */
+    std::atomic<std::size_t> m_spareDataBlockFileDescriptorCount;
+
     /** Metadata access synchronization object */
     mutable std::mutex m_mutex;
 
@@ -851,6 +980,18 @@ private:
     /** Active sessions */
     std::unordered_map<Uuid, std::shared_ptr<ClientSession>> m_activeSessions;
 
+    /**
+     * Thread pool which creates column data block files in advance, if enabled.
+     * Pending tasks hold databases, so it must be destroyed before other objects.
+     */
+    const std::unique_ptr<utils::WorkerThreadPool> m_dataBlockFileThreadPool;
+
+    /** Expired row purger. Must be destroyed before databases and thread pools. */
+    std::unique_ptr<ExpiredRowPurger> m_expiredRowPurger;
+
+    /** Data scrubber. Must be destroyed first, so that it stops before other objects. */
+    std::unique_ptr<DataScrubber> m_dataScrubber;
+
     /** Allowed permission map */
     static const std::unordered_map<DatabaseObjectType, std::uint64_t> s_allowedPermissions;
 
@@ -866,6 +1007,12 @@ private:
     /** Generated token length */
     static constexpr std::size_t kGeneratedTokenLength = 64;
 
+    /**
+     * Part of the file descriptor cache capacity, which is allowed for open column
+     * data block files created in advance.
+     */
+    static constexpr std::size_t kSpareDataBlockFileDescriptorShare = 16;
+
     /** All premissions constant for REVOKE */
     static constexpr std::uint64_t kAllPermissionsForRevoke =
             std::numeric_limits<std::uint64_t>::max();
@@ -23,6 +23,19 @@ std::size_t Instance::getDatabaseCount() const
     return m_databaseRegistry.size();
 }
 
+std::vector<std::uint32_t> Instance::getDatabaseIds() const
+{
+    std::vector<std::uint32_t> result;
+    {
+        std::lock_guard lock(m_mutex);
+        result.reserve(m_databaseRegistry.size());
+        for (const auto& databaseRecord : m_databaseRegistry.byId())
+            result.push_back(databaseRecord.m_id);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 std::vector<DatabaseRecord> Instance::getDatabaseRecordsOrderedByName(std::uint32_t currentUserId)
 {
     std::lock_guard lock(m_mutex);
@@ -27,6 +27,9 @@
 #include <siodb/iomgr/shared/dbengine/crypto/ciphers/Cipher.h>
 #include <siodb/iomgr/shared/dbengine/crypto/ciphers/CipherContext.h>
 
+// System headers
+#include <sys/resource.h>
+
 namespace siodb::iomgr::dbengine {
 
 Instance::Instance(const config::SiodbOptions& options)
@@ -51,14 +54,37 @@ Instance::Instance(const config::SiodbOptions& options)
     , m_maxDatabases(options.m_ioManagerOptions.m_maxDatabases)
     , m_maxTableCountPerDatabase(options.m_ioManagerOptions.m_maxTableCountPerDatabase)
     , m_blockCacheCapacity(options.m_ioManagerOptions.m_blockCacheCapacity)
+    , m_dataBlockCompressionLevel(options.m_ioManagerOptions.m_dataBlockCompressionLevel)
+    , m_scanPrefetchSize(options.m_ioManagerOptions.m_scanPrefetchSize)
+    , m_writerThreadPool(options.m_ioManagerOptions.m_writerThreadNumber)
+    , m_scanThreadPool(options.m_ioManagerOptions.m_scanThreadNumber > 1
+                               ? std::make_unique<utils::WorkerThreadPool>(
+                                       options.m_ioManagerOptions.m_scanThreadNumber)
+                               : nullptr)
+    , m_fileDescriptorCache(getFileDescriptorCacheCapacity(
+              options.m_ioManagerOptions.m_fileDescriptorCacheCapacity))
+    , m_spareDataBlockFileCount(options.m_ioManagerOptions.m_spareDataBlockFileCount)
+    , m_maxSpareDataBlockFileDescriptorCount(std::max<std::size_t>(
+              m_fileDescriptorCache.getCapacity() / kSpareDataBlockFileDescriptorShare, 1))
+    , m_spareDataBlockFileDescriptorCount(0)
     , m_metadataFile()
     , m_allowCreatingUserTablesInSystemDatabase(
               options.m_generalOptions.m_allowCreatingUserTablesInSystemDatabase)
+    , m_dataBlockFileThreadPool(m_spareDataBlockFileCount > 0
+                                        ? std::make_unique<utils::WorkerThreadPool>(1)
+                                        : nullptr)
 {
+    crypto::CipherContext::setMaxTransformThreadCount(
+            options.m_encryptionOptions.m_transformThreadNumber);
     if (fs::exists(utils::constructPath(m_dataDir, kInitializationFlagFile)))
         loadInstanceData();
     else
         createInstanceData();
+    m_dataScrubber = std::make_unique<DataScrubber>(*this,
+            options.m_ioManagerOptions.m_dataScrubRate,
+            options.m_ioManagerOptions.m_dataScrubInterval);
+    m_expiredRowPurger = std::make_unique<ExpiredRowPurger>(
+            *this, options.m_ioManagerOptions.m_expiredRowPurgeRate);
 }
 
 std::string Instance::makeDisplayName() const
@@ -111,6 +137,20 @@ BinaryValue Instance::decryptWithMasterEncryption(const void* data, std::size_t
     return buffer;
 }
 
+bool Instance::reserveSpareDataBlockFileDescriptor() noexcept
+{
+    auto count = m_spareDataBlockFileDescriptorCount.load();
+    do {
+        if (count >= m_maxSpareDataBlockFileDescriptorCount) return false;
+    } while (!m_spareDataBlockFileDescriptorCount.compare_exchange_weak(count, count + 1));
+    return true;
+}
+
+void Instance::releaseSpareDataBlockFileDescriptor() noexcept
+{
+    --m_spareDataBlockFileDescriptorCount;
+}
+
 // --- internals ---
 
 void Instance::createInstanceData()
@@ -244,6 +284,18 @@ BinaryValue Instance::loadMasterCipherKey(const std::string& keyPath) const
     return key;
 }
 
+std::size_t Instance::getFileDescriptorCacheCapacity(std::size_t configuredCapacity) noexcept
+{
+    if (configuredCapacity > 0) return configuredCapacity;
+    // Leave the rest of descriptors for connections, system tables and B+ tree indices
+    constexpr std::size_t kDefaultCapacity = 512;
+    struct rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) < 0 || limit.rlim_cur == RLIM_INFINITY)
+        return kDefaultCapacity;
+    return std::max<std::size_t>(
+            limit.rlim_cur / 2, config::kMinIOManagerOptionFileDescriptorCacheCapacity);
+}
+
 std::string Instance::loadSuperUserInitialAccessKey() const
 {
     LOG_DEBUG << "Instance: Loading super user initial access key.";
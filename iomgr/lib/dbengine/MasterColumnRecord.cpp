@@ -11,6 +11,9 @@
 #include <siodb/common/utils/Base128VariantEncoding.h>
 #include <siodb/common/utils/PlainBinaryEncoding.h>
 
+// CRT headers
+#include <cstring>
+
 namespace siodb::iomgr::dbengine {
 
 MasterColumnRecord::MasterColumnRecord(Table& table, std::uint64_t tableRowId,
@@ -27,7 +30,7 @@ MasterColumnRecord::MasterColumnRecord(Table& table, std::uint64_t tableRowId,
     , m_operationType(operationType)
     , m_userId(userId)
     , m_columnSetId(columnSetId)
-    , m_privateDataExpirationTimestamp(0)
+    , m_privateDataExpirationTimestamp(table.getRowExpirationTimestamp(createTimestamp))
     , m_previousVersionAddress(previousVersionAddress)
 {
     m_columnRecords.reserve(table.getColumnCount());
@@ -35,17 +38,30 @@ MasterColumnRecord::MasterColumnRecord(Table& table, std::uint64_t tableRowId,
 
 std::size_t MasterColumnRecord::getSerializedSize() const noexcept
 {
-    std::size_t size = ::getVarIntSize(m_tableRowId) + ::getVarIntSize(m_transactionId)
+    std::size_t size = 2  // Compact format marker and version
+                       + ::getVarIntSize(m_tableRowId) + ::getVarIntSize(m_transactionId)
                        + ::getVarIntSize(m_createTimestamp) + ::getVarIntSize(m_updateTimestamp)
                        + ::getVarIntSize(m_version) + ::getVarIntSize(m_operationId)
                        + 1  // Atomic operation type is always 1 byte
                        + ::getVarIntSize(m_userId) + ::getVarIntSize(m_columnSetId)
                        + ::getVarIntSize(m_privateDataExpirationTimestamp)
                        + ::getVarIntSize(static_cast<std::uint32_t>(m_columnRecords.size()))
+                       + getColumnBitmapSize(m_columnRecords.size()) * 3
                        + m_previousVersionAddress.getSerializedSize();
 
-    for (const auto& r : m_columnRecords)
-        size += r.getSerializedSize();
+    std::uint64_t prevBlockId = 0;
+    for (const auto& r : m_columnRecords) {
+        const auto& address = r.getAddress();
+        if (!address.isNullValueAddress()) {
+            size += ::getVarIntSize(static_cast<std::int64_t>(address.getBlockId() - prevBlockId))
+                    + ::getVarIntSize(address.getOffset());
+            prevBlockId = address.getBlockId();
+        }
+        if (r.getCreateTimestamp() != m_createTimestamp)
+            size += ::getVarIntSize(r.getCreateTimestamp());
+        if (r.getUpdateTimestamp() != m_updateTimestamp)
+            size += ::getVarIntSize(r.getUpdateTimestamp());
+    }
 
     return size;
 }
@@ -59,6 +75,8 @@ std::uint8_t* MasterColumnRecord::serializeUncheckedWithSizeTag(
         std::uint8_t* buffer, std::uint16_t sizeTag) const noexcept
 {
     buffer = ::encodeVarUInt16(sizeTag, buffer);
+    *buffer++ = kCompactFormatMarker;
+    *buffer++ = kCompactFormatVersion;
     buffer = ::encodeVarInt(m_tableRowId, buffer);
     buffer = ::encodeVarInt(m_transactionId, buffer);
     buffer = ::encodeVarInt(m_createTimestamp, buffer);
@@ -71,8 +89,35 @@ std::uint8_t* MasterColumnRecord::serializeUncheckedWithSizeTag(
     buffer = ::encodeVarInt(m_privateDataExpirationTimestamp, buffer);
     buffer = ::encodeVarInt(static_cast<std::uint32_t>(m_columnRecords.size()), buffer);
 
-    for (const auto& r : m_columnRecords)
-        buffer = r.serializeUnchecked(buffer);
+    // Fill bitmaps
+    const auto bitmapSize = getColumnBitmapSize(m_columnRecords.size());
+    auto nullBitmap = buffer;
+    auto createTimestampBitmap = nullBitmap + bitmapSize;
+    auto updateTimestampBitmap = createTimestampBitmap + bitmapSize;
+    buffer = updateTimestampBitmap + bitmapSize;
+    std::memset(nullBitmap, 0, bitmapSize * 3);
+    for (std::size_t i = 0; i < m_columnRecords.size(); ++i) {
+        const auto& r = m_columnRecords[i];
+        const std::uint8_t mask = 1 << (i % 8);
+        if (r.isNullValue()) nullBitmap[i / 8] |= mask;
+        if (r.getCreateTimestamp() != m_createTimestamp) createTimestampBitmap[i / 8] |= mask;
+        if (r.getUpdateTimestamp() != m_updateTimestamp) updateTimestampBitmap[i / 8] |= mask;
+    }
+
+    std::uint64_t prevBlockId = 0;
+    for (const auto& r : m_columnRecords) {
+        const auto& address = r.getAddress();
+        if (!address.isNullValueAddress()) {
+            buffer = ::encodeVarInt(
+                    static_cast<std::int64_t>(address.getBlockId() - prevBlockId), buffer);
+            buffer = ::encodeVarInt(address.getOffset(), buffer);
+            prevBlockId = address.getBlockId();
+        }
+        if (r.getCreateTimestamp() != m_createTimestamp)
+            buffer = ::encodeVarInt(r.getCreateTimestamp(), buffer);
+        if (r.getUpdateTimestamp() != m_updateTimestamp)
+            buffer = ::encodeVarInt(r.getUpdateTimestamp(), buffer);
+    }
 
     buffer = m_previousVersionAddress.serializeUnchecked(buffer);
 
@@ -82,9 +127,16 @@ std::uint8_t* MasterColumnRecord::serializeUncheckedWithSizeTag(
 std::size_t MasterColumnRecord::deserialize(
         const std::uint8_t* buffer, std::size_t dataSize) noexcept
 {
-    int consumed = ::decodeVarInt(buffer, dataSize, m_tableRowId);
+    std::size_t totalConsumed = 0;
+    const bool compact = dataSize > 0 && buffer[0] == kCompactFormatMarker;
+    if (compact) {
+        if (dataSize < 2 || buffer[1] != kCompactFormatVersion) return 0;
+        totalConsumed = 2;
+    }
+
+    int consumed = ::decodeVarInt(buffer + totalConsumed, dataSize - totalConsumed, m_tableRowId);
     if (consumed < 1) return 0;
-    std::size_t totalConsumed = consumed;
+    totalConsumed += consumed;
 
     consumed = ::decodeVarInt(buffer + totalConsumed, dataSize - totalConsumed, m_transactionId);
     if (consumed < 1) return 0;
@@ -128,19 +180,27 @@ std::size_t MasterColumnRecord::deserialize(
     if (consumed < 1) return 0;
     totalConsumed += consumed;
 
-    std::vector<ColumnDataRecord> columnRecords;
-    if (SIODB_LIKELY(columnRecordCount > 0)) {
-        columnRecords.resize(columnRecordCount);
-        for (std::uint32_t i = 0; i < columnRecordCount; ++i) {
-            const auto consumed1 =
-                    columnRecords[i].deserialize(buffer + totalConsumed, dataSize - totalConsumed);
-            if (consumed1 < 1) return 0;
-            totalConsumed += consumed1;
+    std::size_t consumed1 = 0;
+    if (compact) {
+        consumed1 = deserializeCompactColumnRecords(
+                buffer + totalConsumed, dataSize - totalConsumed, columnRecordCount);
+        if (consumed1 < 1 && columnRecordCount > 0) return 0;
+        totalConsumed += consumed1;
+    } else {
+        std::vector<ColumnDataRecord> columnRecords;
+        if (SIODB_LIKELY(columnRecordCount > 0)) {
+            columnRecords.resize(columnRecordCount);
+            for (std::uint32_t i = 0; i < columnRecordCount; ++i) {
+                consumed1 = columnRecords[i].deserialize(
+                        buffer + totalConsumed, dataSize - totalConsumed);
+                if (consumed1 < 1) return 0;
+                totalConsumed += consumed1;
+            }
         }
+        m_columnRecords.swap(columnRecords);
     }
-    m_columnRecords.swap(columnRecords);
 
-    auto consumed1 =
+    consumed1 =
             m_previousVersionAddress.deserialize(buffer + totalConsumed, dataSize - totalConsumed);
     if (consumed1 < 1) return 0;
     totalConsumed += consumed1;
@@ -169,6 +229,61 @@ std::string MasterColumnRecord::dumpColumnAddresses() const
     return oss.str();
 }
 
+// --- internals ---
+
+std::size_t MasterColumnRecord::deserializeCompactColumnRecords(
+        const std::uint8_t* buffer, std::size_t dataSize, std::uint32_t columnRecordCount) noexcept
+{
+    const auto bitmapSize = getColumnBitmapSize(columnRecordCount);
+    if (dataSize < bitmapSize * 3) return 0;
+    const auto nullBitmap = buffer;
+    const auto createTimestampBitmap = nullBitmap + bitmapSize;
+    const auto updateTimestampBitmap = createTimestampBitmap + bitmapSize;
+    std::size_t totalConsumed = bitmapSize * 3;
+
+    std::vector<ColumnDataRecord> columnRecords;
+    columnRecords.reserve(columnRecordCount);
+    std::uint64_t prevBlockId = 0;
+    for (std::uint32_t i = 0; i < columnRecordCount; ++i) {
+        const std::uint8_t mask = 1 << (i % 8);
+        ColumnDataAddress address;
+        if ((nullBitmap[i / 8] & mask) == 0) {
+            std::int64_t blockIdDelta = 0;
+            int consumed =
+                    ::decodeVarInt(buffer + totalConsumed, dataSize - totalConsumed, blockIdDelta);
+            if (consumed < 1) return 0;
+            totalConsumed += consumed;
+            std::uint32_t offset = 0;
+            consumed = ::decodeVarInt(buffer + totalConsumed, dataSize - totalConsumed, offset);
+            if (consumed < 1) return 0;
+            totalConsumed += consumed;
+            address = ColumnDataAddress(prevBlockId + blockIdDelta, offset);
+            prevBlockId = address.getBlockId();
+        }
+
+        auto createTimestamp = m_createTimestamp;
+        if (createTimestampBitmap[i / 8] & mask) {
+            const int consumed = ::decodeVarInt(
+                    buffer + totalConsumed, dataSize - totalConsumed, createTimestamp);
+            if (consumed < 1) return 0;
+            totalConsumed += consumed;
+        }
+
+        auto updateTimestamp = m_updateTimestamp;
+        if (updateTimestampBitmap[i / 8] & mask) {
+            const int consumed = ::decodeVarInt(
+                    buffer + totalConsumed, dataSize - totalConsumed, updateTimestamp);
+            if (consumed < 1) return 0;
+            totalConsumed += consumed;
+        }
+
+        columnRecords.emplace_back(address, createTimestamp, updateTimestamp);
+    }
+    m_columnRecords.swap(columnRecords);
+
+    return totalConsumed;
+}
+
 std::ostream& operator<<(std::ostream& os, const MasterColumnRecord& mcr)
 {
     return os << "TRID: " << mcr.getTableRowId() << ", txnid: " << mcr.getTransactionId()
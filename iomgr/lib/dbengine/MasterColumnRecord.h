@@ -26,6 +26,15 @@ public:
     /** Master column record size tag size */
     static constexpr std::size_t kMaxSizeTagSize = 2;
 
+    /**
+     * First byte of the record in the compact format. Legacy format starts
+     * with the table row ID, which is never zero.
+     */
+    static constexpr std::uint8_t kCompactFormatMarker = 0;
+
+    /** Current compact format version */
+    static constexpr std::uint8_t kCompactFormatVersion = 1;
+
 public:
     /**
      * Initializes new object of class MasterColumnRecord.
@@ -184,6 +193,17 @@ public:
         m_privateDataExpirationTimestamp = privateDataExpirationTimestamp;
     }
 
+    /**
+     * Returns indication that row has expired.
+     * @param currentTime Current timestamp.
+     * @return true if row has expiration timestamp and it is reached, false otherwise.
+     */
+    bool isExpired(std::uint64_t currentTime) const noexcept
+    {
+        return m_privateDataExpirationTimestamp != 0
+               && m_privateDataExpirationTimestamp <= currentTime;
+    }
+
     /**
      * Returns number of column addresses.
      * @return Number of column addresses.
@@ -274,6 +294,7 @@ public:
 
     /**
      * De-serializes master column with length from a memory buffer.
+     * Both compact and legacy formats are accepted.
      * @param buffer Buffer address.
      * @param dataSize Available data size in buffer.
      * @param masterColumn Master column data structure to fill.
@@ -293,6 +314,31 @@ public:
      */
     std::string dumpColumnAddresses() const;
 
+private:
+    /**
+     * Returns size of the per-column bitmap.
+     * @param columnCount Number of columns.
+     * @return Bitmap size in bytes.
+     */
+    static std::size_t getColumnBitmapSize(std::size_t columnCount) noexcept
+    {
+        return (columnCount + 7) / 8;
+    }
+
+    /**
+     * De-serializes column records in the compact format: bitmaps of null addresses,
+     * explicit create timestamps and explicit update timestamps, followed by
+     * block ID of each non-null column as a difference to the block ID
+     * of the previous non-null column, offset and explicit timestamps.
+     * Column timestamps which equal to the record timestamps are omitted.
+     * @param buffer Buffer address.
+     * @param dataSize Available data size in buffer.
+     * @param columnRecordCount Number of column records.
+     * @return Number of consumed bytes, zero if data can't be read or there are no columns.
+     */
+    std::size_t deserializeCompactColumnRecords(const std::uint8_t* buffer,
+            std::size_t dataSize, std::uint32_t columnRecordCount) noexcept;
+
 private:
     /**
      * The unique ID generated at each new transaction of **type INSERT only**.
@@ -15,12 +15,22 @@
 #include "parser/EmptyExpressionEvaluationContext.h"
 
 // Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/io/FileIO.h>
 #include <siodb/common/log/Log.h>
 #include <siodb/common/stl_wrap/filesystem_wrapper.h>
+#include <siodb/common/utils/FDGuard.h>
 #include <siodb/common/utils/FSUtils.h>
 #include <siodb/common/utils/PlainBinaryEncoding.h>
 #include <siodb/iomgr/shared/dbengine/DatabaseObjectName.h>
 
+// CRT headers
+#include <cerrno>
+#include <cstring>
+
+// System headers
+#include <fcntl.h>
+
 namespace siodb::iomgr::dbengine {
 
 Table::Table(Database& database, TableType type, std::string&& name, std::uint64_t firstUserTrid,
@@ -36,6 +46,9 @@ Table::Table(Database& database, TableType type, std::string&& name, std::uint64
     , m_columnSetCache(kColumnSetCacheCapacity)
     , m_currentColumnSet(createColumnSetUnlocked())
     , m_firstUserTrid(firstUserTrid)
+    , m_rowTtl(0)
+    , m_lastExpiredRowPurgeTrid(0)
+    , m_mayHaveExpiringRows(false)
 {
     createMasterColumn(firstUserTrid);
     createInitializationFlagFile();
@@ -53,6 +66,9 @@ Table::Table(Database& database, const TableRecord& tableRecord)
     , m_columnSetCache(kColumnSetCacheCapacity)
     , m_currentColumnSet(findColumnSetChecked(tableRecord.m_currentColumnSetId))
     , m_firstUserTrid(tableRecord.m_firstUserTrid)
+    , m_rowTtl(loadRowTtl())
+    , m_lastExpiredRowPurgeTrid(0)
+    , m_mayHaveExpiringRows(true)
 {
     // Populate columns from the current column set
     loadColumnsUnlocked();
@@ -295,6 +311,97 @@ InsertRowResult Table::insertRow(std::vector<Variant>&& columnValues,
     return doInsertRowUnlocked(std::move(columnValues), transactionParameters, customTrid);
 }
 
+std::size_t Table::insertRows(std::vector<std::vector<Variant>>& rows,
+        const TransactionParameters& tp, utils::WorkerThreadPool& threadPool)
+{
+    std::lock_guard lock(m_mutex);
+
+    // Check that every row contains values for all columns except MC
+    const auto columnCount = m_currentColumns.size() - 1;
+    for (const auto& row : rows) {
+        if (row.size() != columnCount) {
+            throwDatabaseError(IOManagerMessageId::kErrorNumberOfValuesMistatchOnInsert,
+                    m_database.getName(), m_name, row.size(), columnCount);
+        }
+    }
+
+    const auto rowCount = rows.size();
+    if (rowCount == 0) return 0;
+
+    // Write column data, one task per column. Each column is protected by own mutex,
+    // and data of a single column is still written in the row order.
+    std::vector<ColumnPtr> columns;
+    columns.reserve(columnCount);
+    for (const auto& tableColumnRecord : m_currentColumns.byPosition()) {
+        if (!tableColumnRecord.m_column->isMasterColumn())
+            columns.push_back(tableColumnRecord.m_column);
+    }
+
+    std::vector<std::vector<Column::WriteRecordResult>> results(columnCount);
+    std::vector<utils::WorkerThreadPool::Task> tasks;
+    tasks.reserve(columnCount);
+    for (std::size_t i = 0; i < columnCount; ++i) {
+        tasks.push_back([&rows, &column = *columns[i], &columnResults = results[i], i] {
+            columnResults.reserve(rows.size());
+            for (auto& row : rows)
+                columnResults.push_back(column.writeRecord(std::move(row[i])));
+        });
+    }
+
+    // Rolls back column data of the rows starting from the given one
+    const auto rollbackColumnData = [&columns, &results](std::size_t firstRowIndex) noexcept {
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            const auto& columnResults = results[i];
+            auto first = columnResults.cend(), last = columnResults.cend();
+            for (auto it = columnResults.cbegin() + std::min(firstRowIndex, columnResults.size());
+                    it != columnResults.cend(); ++it) {
+                if (it->m_dataAddress.isNullValueAddress()) continue;
+                if (first == columnResults.cend()) first = it;
+                last = it;
+            }
+            if (first == columnResults.cend()) continue;
+            try {
+                columns[i]->rollbackToAddress(
+                        first->m_dataAddress, last->m_nextAddress.getBlockId());
+            } catch (std::exception& ex) {
+                LOG_ERROR << ex.what();
+            }
+        }
+    };
+
+    try {
+        threadPool.runAll(tasks);
+    } catch (...) {
+        rollbackColumnData(0);
+        throw;
+    }
+
+    // Write master column records. Main index is updated per row rather than rebuilt
+    // at the end: it is addressed directly by TRID, so each update is a single in-place
+    // write, and rows written before a failure stay consistent with the index.
+    std::size_t rowIndex = 0;
+    try {
+        for (; rowIndex < rowCount; ++rowIndex) {
+            MasterColumnRecord mcr(*this, 0, tp.m_transactionId, tp.m_timestamp, tp.m_timestamp,
+                    0U, m_database.generateNextAtomicOperationId(), DmlOperationType::kInsert,
+                    tp.m_userId, m_currentColumnSet->getId(), kNullValueAddress);
+            mcr.reserveColumnRecords(columnCount);
+            for (const auto& columnResults : results) {
+                mcr.addColumnRecord(
+                        columnResults[rowIndex].m_dataAddress, tp.m_timestamp, tp.m_timestamp);
+            }
+            m_masterColumn->writeMasterColumnRecord(mcr);
+        }
+    } catch (...) {
+        // Rows with written master column record are already visible,
+        // so only data of the remaining rows can be rolled back.
+        rollbackColumnData(rowIndex);
+        throw;
+    }
+
+    return rowCount;
+}
+
 DeleteRowResult Table::deleteRow(std::uint64_t trid,
         const TransactionParameters& transactionParameters, bool updateMasterColumnMainIndex)
 {
@@ -317,6 +424,9 @@ DeleteRowResult Table::deleteRow(std::uint64_t trid,
     MasterColumnRecord mcr;
     m_masterColumn->readMasterColumnRecord(mcrAddr, mcr);
 
+    // Expired row is not visible anymore
+    if (mcr.isExpired(transactionParameters.m_timestamp)) return DeleteRowResult();
+
     // Delete row
     return deleteRow(mcr, mcrAddr, transactionParameters, updateMasterColumnMainIndex);
 }
@@ -330,6 +440,7 @@ DeleteRowResult Table::deleteRow(const MasterColumnRecord& mcr, const ColumnData
             transactionParameters.m_timestamp, mcr.getVersion() + 1,
             m_database.generateNextAtomicOperationId(), DmlOperationType::kDelete,
             transactionParameters.m_userId, m_currentColumnSet->getId(), mcrAddress);
+    newMcr->setPrivateDataExpirationTimestamp(mcr.getPrivateDataExpirationTimestamp());
     auto writeResult =
             m_masterColumn->writeMasterColumnRecord(*newMcr, updateMasterColumnMainIndex);
     return DeleteRowResult(
@@ -375,6 +486,9 @@ UpdateRowResult Table::updateRow(std::uint64_t trid,
     MasterColumnRecord mcr;
     m_masterColumn->readMasterColumnRecord(mcrAddr, mcr);
 
+    // Expired row is not visible anymore
+    if (mcr.isExpired(tp.m_timestamp)) return UpdateRowResult();
+
     // Perform update
     return updateRow(mcr, mcrAddr, columnPositions, std::move(columnValues), tp);
 }
@@ -400,6 +514,8 @@ UpdateRowResult Table::updateRow(const MasterColumnRecord& mcr, const ColumnData
             tp.m_transactionId, mcr.getCreateTimestamp(), tp.m_timestamp, mcr.getVersion() + 1,
             m_database.generateNextAtomicOperationId(), DmlOperationType::kUpdate, tp.m_userId,
             m_currentColumnSet->getId(), mcrAddress);
+    // Update doesn't prolong row life
+    newMcr->setPrivateDataExpirationTimestamp(mcr.getPrivateDataExpirationTimestamp());
 
     const auto tableColumns = getColumnsOrderedByPosition();
     std::vector<std::uint64_t> currentBlockIds, nextBlockIds;
@@ -520,6 +636,77 @@ ColumnDefinitionPtr Table::findColumnDefinitionChecked(std::uint64_t columnDefin
     return it->m_column->findColumnDefinitionChecked(columnDefinitionId);
 }
 
+void Table::setRowTtl(std::uint64_t rowTtl)
+{
+    std::lock_guard lock(m_mutex);
+    if (rowTtl == m_rowTtl) return;
+    saveRowTtl(rowTtl);
+    m_rowTtl = rowTtl;
+    if (m_rowTtl > 0) m_mayHaveExpiringRows = true;
+}
+
+std::uint64_t Table::getRowExpirationTimestamp(std::uint64_t createTimestamp) const
+{
+    std::lock_guard lock(m_mutex);
+    return m_rowTtl > 0 ? createTimestamp + m_rowTtl : 0;
+}
+
+Table::PurgeExpiredRowsResult Table::purgeExpiredRows(std::uint32_t userId,
+        std::time_t currentTime, std::size_t maxRowCount, std::size_t maxScannedRowCount)
+{
+    std::lock_guard lock(m_mutex);
+
+    PurgeExpiredRowsResult result;
+    const auto index = m_masterColumn->getMasterColumnMainIndex();
+    std::uint8_t key[8];
+    std::uint8_t nextKey[8];
+    std::uint64_t maxTrid = 0;
+    bool haveKey = index->getMaxKey(key);
+    if (haveKey) {
+        ::pbeDecodeUInt64(key, &maxTrid);
+        if (m_lastExpiredRowPurgeTrid == 0) {
+            // New pass. Rows created while TTL is zero never expire, so unless
+            // earlier rows may expire, there is nothing to look for.
+            haveKey = m_rowTtl > 0 || m_mayHaveExpiringRows;
+            m_mayHaveExpiringRows = m_rowTtl > 0;
+            if (haveKey) haveKey = index->getMinKey(key);
+        } else if (m_lastExpiredRowPurgeTrid < maxTrid) {
+            ::pbeEncodeUInt64(m_lastExpiredRowPurgeTrid, nextKey);
+            haveKey = index->findNextKey(nextKey, key);
+        } else
+            haveKey = false;
+    }
+
+    std::optional<TransactionParameters> tp;
+    IndexValue indexValue;
+    for (std::size_t scannedRowCount = 0; haveKey && result.m_deletedRowCount < maxRowCount
+                                          && scannedRowCount < maxScannedRowCount;
+            ++scannedRowCount) {
+        ::pbeDecodeUInt64(key, &m_lastExpiredRowPurgeTrid);
+        if (index->find(key, indexValue.m_data, 1) == 1) {
+            ColumnDataAddress mcrAddr;
+            mcrAddr.pbeDeserialize(indexValue.m_data, sizeof(indexValue.m_data));
+            MasterColumnRecord mcr;
+            m_masterColumn->readMasterColumnRecord(mcrAddr, mcr);
+            if (mcr.isExpired(currentTime)) {
+                // Delete row, this also removes it from the master column main index
+                if (!tp) tp.emplace(userId, m_database.generateNextTransactionId(), currentTime);
+                deleteRow(mcr, mcrAddr, *tp);
+                ++result.m_deletedRowCount;
+            } else if (mcr.getPrivateDataExpirationTimestamp() != 0)
+                m_mayHaveExpiringRows = true;
+        }
+        haveKey = m_lastExpiredRowPurgeTrid < maxTrid && index->findNextKey(key, nextKey);
+        if (haveKey) std::memcpy(key, nextKey, sizeof(key));
+    }
+
+    if (!haveKey) {
+        m_lastExpiredRowPurgeTrid = 0;
+        result.m_endOfTable = true;
+    }
+    return result;
+}
+
 // --- internals ---
 
 std::string&& Table::validateTableName(std::string&& tableName)
@@ -715,6 +902,65 @@ void Table::createInitializationFlagFile() const
     }
 }
 
+std::uint64_t Table::loadRowTtl() const
+{
+    const auto rowTtlFilePath = utils::constructPath(m_dataDir, kRowTtlFile);
+    FDGuard fd(::open(rowTtlFilePath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!fd.isValidFd()) {
+        const auto errorCode = errno;
+        // Row time to live was never set
+        if (errorCode == ENOENT) return 0;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotLoadTableRowTtl, rowTtlFilePath,
+                m_database.getName(), m_name, m_database.getUuid(), m_id, errorCode,
+                std::strerror(errorCode));
+    }
+
+    std::uint8_t buffer[8];
+    if (::readExact(fd.getFD(), buffer, sizeof(buffer), kIgnoreSignals) != sizeof(buffer)) {
+        const auto errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotLoadTableRowTtl, rowTtlFilePath,
+                m_database.getName(), m_name, m_database.getUuid(), m_id, errorCode,
+                std::strerror(errorCode));
+    }
+
+    std::uint64_t rowTtl = 0;
+    ::pbeDecodeUInt64(buffer, &rowTtl);
+    return rowTtl;
+}
+
+void Table::saveRowTtl(std::uint64_t rowTtl) const
+{
+    // Write temporary file and then replace original one, so that
+    // incompletely written file can't appear under the original name.
+    const auto tmpFilePath = utils::constructPath(m_dataDir, kTempRowTtlFile);
+    FDGuard fd(::open(tmpFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DSYNC | O_CLOEXEC,
+            kDataFileCreationMode));
+    if (!fd.isValidFd()) {
+        const auto errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotSaveTableRowTtl, tmpFilePath,
+                m_database.getName(), m_name, m_database.getUuid(), m_id, errorCode,
+                std::strerror(errorCode));
+    }
+
+    std::uint8_t buffer[8];
+    ::pbeEncodeUInt64(rowTtl, buffer);
+    if (::writeExact(fd.getFD(), buffer, sizeof(buffer), kIgnoreSignals) != sizeof(buffer)) {
+        const auto errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotSaveTableRowTtl, tmpFilePath,
+                m_database.getName(), m_name, m_database.getUuid(), m_id, errorCode,
+                std::strerror(errorCode));
+    }
+    fd.reset();
+
+    const auto rowTtlFilePath = utils::constructPath(m_dataDir, kRowTtlFile);
+    if (::rename(tmpFilePath.c_str(), rowTtlFilePath.c_str()) < 0) {
+        const auto errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotSaveTableRowTtl, rowTtlFilePath,
+                m_database.getName(), m_name, m_database.getUuid(), m_id, errorCode,
+                std::strerror(errorCode));
+    }
+}
+
 InsertRowResult Table::doInsertRowUnlocked(std::vector<Variant>&& columnValues,
         const TransactionParameters& tp, std::uint64_t customTrid)
 {
@@ -18,6 +18,7 @@
 #include "UpdateRowResult.h"
 
 // Common project headers
+#include <siodb/common/utils/WorkerThreadPool.h>
 #include <siodb/iomgr/shared/dbengine/Variant.h>
 
 namespace siodb::iomgr::dbengine {
@@ -395,6 +396,22 @@ public:
     InsertRowResult insertRow(std::vector<Variant>&& columnValues,
             const TransactionParameters& transactionParameters, std::uint64_t customTrid = 0);
 
+    /**
+     * Inserts multiple rows into the table. Data of each column is written
+     * by a separate task in the given thread pool, then master column records
+     * are written in the row order. Each row must contain values for all columns
+     * except master column in the table column order.
+     * @param rows Row values. May be modified by this function.
+     * @param transactionParameters Transaction parameters.
+     * @param threadPool Thread pool used to write column data.
+     * @return Number of inserted rows.
+     * @throw DatabaseError if operation has failed. Rows, for which master column record
+     *        has been already written at that moment, remain inserted.
+     */
+    std::size_t insertRows(std::vector<std::vector<Variant>>& rows,
+            const TransactionParameters& transactionParameters,
+            utils::WorkerThreadPool& threadPool);
+
     /**
      * Deletes existing row from the table.
      * @param trid Table row ID.
@@ -502,6 +519,56 @@ public:
      */
     ColumnDefinitionPtr findColumnDefinitionChecked(std::uint64_t columnDefinitionId);
 
+    /**
+     * Returns row time to live.
+     * @return Row time to live in seconds, zero if rows never expire.
+     */
+    std::uint64_t getRowTtl() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_rowTtl;
+    }
+
+    /**
+     * Sets row time to live and saves it to disk. Used by ALTER TABLE SET TTL.
+     * Applies to the rows inserted after this call.
+     * @param rowTtl Row time to live in seconds, zero disables expiration of the new rows.
+     * @throw DatabaseError if row time to live can't be saved.
+     */
+    void setRowTtl(std::uint64_t rowTtl);
+
+    /**
+     * Returns expiration timestamp of a row created at a given time.
+     * @param createTimestamp Row creation timestamp.
+     * @return Row expiration timestamp, zero if row never expires.
+     */
+    std::uint64_t getRowExpirationTimestamp(std::uint64_t createTimestamp) const;
+
+    /** Result of the single expired row purge step */
+    struct PurgeExpiredRowsResult {
+        /** Number of deleted rows */
+        std::size_t m_deletedRowCount = 0;
+
+        /** Indication that scan has reached end of table and next step starts new pass */
+        bool m_endOfTable = false;
+    };
+
+    /**
+     * Performs single step of the expired row purge. Rows are scanned in the TRID order,
+     * starting after the last row scanned by the previous step. Rows which never expire
+     * (created while TTL was zero) and rows which have not expired yet are skipped.
+     * Pass is skipped entirely when TTL is zero and the previous pass has found
+     * no rows that can expire.
+     * @param userId ID of the user on whose behalf rows are deleted.
+     * @param currentTime Current timestamp.
+     * @param maxRowCount Maximum number of rows to delete.
+     * @param maxScannedRowCount Maximum number of rows to scan.
+     * @return Number of deleted rows and end of table indication.
+     * @throw DatabaseError if operation has failed.
+     */
+    PurgeExpiredRowsResult purgeExpiredRows(std::uint32_t userId, std::time_t currentTime,
+            std::size_t maxRowCount, std::size_t maxScannedRowCount);
+
 private:
     /**
      * Validates table name.
@@ -637,6 +704,20 @@ private:
     /** Creates initialization flag file. */
     void createInitializationFlagFile() const;
 
+    /**
+     * Loads row time to live from the table data directory.
+     * @return Row time to live in seconds, zero if it was never set.
+     * @throw DatabaseError if row time to live file can't be read.
+     */
+    std::uint64_t loadRowTtl() const;
+
+    /**
+     * Saves row time to live to the table data directory.
+     * @param rowTtl Row time to live in seconds.
+     * @throw DatabaseError if row time to live file can't be written.
+     */
+    void saveRowTtl(std::uint64_t rowTtl) const;
+
     /**
      * Inserts new row into the table. Assumes values correspond to columns in other order
      * they are in the table. Does not obtain column registry lock.
@@ -698,11 +779,26 @@ private:
      */
     const std::uint64_t m_firstUserTrid;
 
+    /** Row time to live in seconds, zero if rows don't expire */
+    std::uint64_t m_rowTtl;
+
+    /** Last TRID scanned by the expired row purge, zero if next purge step starts new pass */
+    std::uint64_t m_lastExpiredRowPurgeTrid;
+
+    /** Indication that table may contain rows with expiration timestamp */
+    bool m_mayHaveExpiringRows;
+
     /** Table directory prefix */
     static constexpr const char* kTableDataDirPrefix = "t";
 
     /** Column set cache capacity */
     static constexpr std::size_t kColumnSetCacheCapacity = 10;
+
+    /** Row time to live file name */
+    static constexpr const char* kRowTtlFile = "row_ttl";
+
+    /** Temporary row time to live file name */
+    static constexpr const char* kTempRowTtlFile = "row_ttl.tmp";
 };
 
 }  // namespace siodb::iomgr::dbengine
@@ -8,12 +8,19 @@
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
 #include "Database.h"
 #include "Index.h"
+#include "Instance.h"
 #include "ThrowDatabaseError.h"
 
 // Common project headers
 #include <siodb/common/utils/PlainBinaryEncoding.h>
 #include <siodb/iomgr/shared/dbengine/DatabaseObjectName.h>
 
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <limits>
+
 namespace siodb::iomgr::dbengine {
 
 TableDataSet::TableDataSet(const TablePtr& table)
@@ -23,6 +30,13 @@ TableDataSet::TableDataSet(const TablePtr& table)
     , m_masterColumnIndex(m_masterColumn->getMasterColumnMainIndex())
     , m_currentKey(nullptr)
     , m_nextKey(nullptr)
+    , m_readBuffers(m_columns.size())
+    , m_minTrid(0)
+    , m_maxTrid(std::numeric_limits<std::uint64_t>::max())
+    , m_currentTime(0)
+    , m_indexMutex(nullptr)
+    , m_prefetchSize(m_table->getDatabase().getInstance().getScanPrefetchSize())
+    , m_prefetchStates(m_columns.size())
 {
 }
 
@@ -34,7 +48,35 @@ TableDataSet::TableDataSet(const TablePtr& table, const std::string& tableAlias)
     , m_masterColumnIndex(m_masterColumn->getMasterColumnMainIndex())
     , m_currentKey(nullptr)
     , m_nextKey(nullptr)
+    , m_readBuffers(m_columns.size())
+    , m_minTrid(0)
+    , m_maxTrid(std::numeric_limits<std::uint64_t>::max())
+    , m_currentTime(0)
+    , m_indexMutex(nullptr)
+    , m_prefetchSize(m_table->getDatabase().getInstance().getScanPrefetchSize())
+    , m_prefetchStates(m_columns.size())
+{
+}
+
+TableDataSet::TableDataSet(const TableDataSet& src, std::uint64_t minTrid,
+        std::uint64_t maxTrid, std::mutex& indexMutex)
+    : DataSet(src.m_alias)
+    , m_table(src.m_table)
+    , m_columns(src.m_columns)
+    , m_masterColumn(src.m_masterColumn)
+    , m_masterColumnIndex(src.m_masterColumnIndex)
+    , m_currentKey(nullptr)
+    , m_nextKey(nullptr)
+    , m_readBuffers(m_columns.size())
+    , m_minTrid(minTrid)
+    , m_maxTrid(maxTrid)
+    , m_currentTime(0)
+    , m_indexMutex(&indexMutex)
+    , m_prefetchSize(src.m_prefetchSize)
+    , m_prefetchStates(m_columns.size())
 {
+    for (const auto& columnInfo : src.m_columnInfos)
+        emplaceColumnInfo(columnInfo.m_posInTable, *columnInfo.m_name, *columnInfo.m_alias);
 }
 
 const std::string& TableDataSet::getName() const noexcept
@@ -89,13 +131,28 @@ std::uint32_t TableDataSet::getDataSourceId() const noexcept
     return m_table->getId();
 }
 
+std::optional<std::pair<std::uint64_t, std::uint64_t>> TableDataSet::getTridRange() const
+{
+    std::uint8_t key[8];
+    std::uint64_t minTrid = 0, maxTrid = 0;
+    const auto indexLock = lockMasterColumnIndex();
+    if (!m_masterColumnIndex->getMinKey(key)) return std::nullopt;
+    ::pbeDecodeUInt64(key, &minTrid);
+    if (!m_masterColumnIndex->getMaxKey(key)) return std::nullopt;
+    ::pbeDecodeUInt64(key, &maxTrid);
+    return std::make_pair(minTrid, maxTrid);
+}
+
 void TableDataSet::resetCursor()
 {
     // Obtain min and max TRID
     std::uint64_t minTrid = 0, maxTrid = 0;
-    if (m_masterColumnIndex->getMinKey(m_key) && m_masterColumnIndex->getMaxKey(&m_key[8])) {
-        ::pbeDecodeUInt64(m_key, &minTrid);
-        ::pbeDecodeUInt64(&m_key[8], &maxTrid);
+    {
+        const auto indexLock = lockMasterColumnIndex();
+        if (m_masterColumnIndex->getMinKey(m_key) && m_masterColumnIndex->getMaxKey(&m_key[8])) {
+            ::pbeDecodeUInt64(m_key, &minTrid);
+            ::pbeDecodeUInt64(&m_key[8], &maxTrid);
+        }
     }
 
     m_currentKey = m_key;
@@ -110,23 +167,38 @@ void TableDataSet::resetCursor()
 
     m_valueReadMask.resize(m_columnInfos.size());
     m_values.resize(m_columnInfos.size());
+    m_currentTime = std::time(nullptr);
 
     m_hasCurrentRow = (maxTrid > 0);
+    if (m_hasCurrentRow && minTrid < m_minTrid) {
+        // Skip rows before the TRID range
+        ::pbeEncodeUInt64(m_minTrid - 1, m_nextKey);
+        const auto indexLock = lockMasterColumnIndex();
+        m_hasCurrentRow = m_masterColumnIndex->findNextKey(m_nextKey, m_currentKey);
+    }
+    m_hasCurrentRow = m_hasCurrentRow && isCurrentKeyInRange();
     if (m_hasCurrentRow) {
         readMasterColumnRecord(2);
         m_valueReadMask.fill(false);
+        // Expired rows are invisible even before they are purged
+        if (m_currentMcr.isExpired(m_currentTime)) moveToNextRow();
     }
 }
 
 bool TableDataSet::moveToNextRow()
 {
-    m_hasCurrentRow = m_masterColumnIndex->findNextKey(m_currentKey, m_nextKey);
-    std::swap(m_currentKey, m_nextKey);
-    if (m_hasCurrentRow) {
+    do {
+        {
+            const auto indexLock = lockMasterColumnIndex();
+            m_hasCurrentRow = m_masterColumnIndex->findNextKey(m_currentKey, m_nextKey);
+        }
+        std::swap(m_currentKey, m_nextKey);
+        m_hasCurrentRow = m_hasCurrentRow && isCurrentKeyInRange();
+        if (!m_hasCurrentRow) return false;
         readMasterColumnRecord(3);
-        m_valueReadMask.fill(false);
-    }
-    return m_hasCurrentRow;
+    } while (m_currentMcr.isExpired(m_currentTime));
+    m_valueReadMask.fill(false);
+    return true;
 }
 
 void TableDataSet::deleteCurrentRow(std::uint32_t currentUserId)
@@ -146,12 +218,24 @@ void TableDataSet::updateCurrentRow(std::vector<Variant>&& values,
 
 // ---- internals ----
 
+bool TableDataSet::isCurrentKeyInRange() const noexcept
+{
+    std::uint64_t trid = 0;
+    ::pbeDecodeUInt64(m_currentKey, &trid);
+    return trid <= m_maxTrid;
+}
+
 void TableDataSet::readMasterColumnRecord(int indexSearchFailureDefectCode)
 {
     IndexValue indexValue;
 
     // Obtain master column record address
-    if (m_masterColumnIndex->find(m_currentKey, indexValue.m_data, 1) != 1) {
+    std::size_t indexValueCount = 0;
+    {
+        const auto indexLock = lockMasterColumnIndex();
+        indexValueCount = m_masterColumnIndex->find(m_currentKey, indexValue.m_data, 1);
+    }
+    if (indexValueCount != 1) {
         throwDatabaseError(IOManagerMessageId::kErrorMasterColumnRecordIndexCorrupted,
                 m_table->getDatabaseName(), m_table->getName(), m_table->getDatabaseUuid(),
                 m_table->getId(), indexSearchFailureDefectCode);
@@ -159,6 +243,7 @@ void TableDataSet::readMasterColumnRecord(int indexSearchFailureDefectCode)
 
     ColumnDataAddress mcrAddr;
     mcrAddr.pbeDeserialize(indexValue.m_data, sizeof(indexValue.m_data));
+    prefetchColumnData(0, mcrAddr);
 
     // Read and validate master column record
     m_masterColumn->readMasterColumnRecord(mcrAddr, m_currentMcr);
@@ -183,7 +268,9 @@ void TableDataSet::readColumnValue(std::size_t index)
     if (column->isMasterColumn())
         value = m_currentMcr.getTableRowId();
     else {
-        column->readRecord(m_currentMcr.getColumnRecords().at(pos - 1).getAddress(), value);
+        const auto& addr = m_currentMcr.getColumnRecords().at(pos - 1).getAddress();
+        if (!addr.isNullValueAddress()) prefetchColumnData(pos, addr);
+        column->readRecord(addr, value, m_readBuffers[pos]);
         if (value.isNull() && column->isNotNull()) {
             throwDatabaseError(IOManagerMessageId::kErrorUnexpectedNullValue,
                     m_table->getDatabaseName(), m_table->getName(), column->getName(),
@@ -194,4 +281,18 @@ void TableDataSet::readColumnValue(std::size_t index)
     m_valueReadMask.set(index);
 }
 
+void TableDataSet::prefetchColumnData(std::size_t pos, const ColumnDataAddress& addr)
+{
+    if (m_prefetchSize == 0) return;
+    // Next portion is requested when half of the previous one is consumed,
+    // so that I/O overlaps with decoding of the rows
+    auto& state = m_prefetchStates[pos];
+    if (addr.getBlockId() == state.m_blockId
+            && addr.getOffset() + m_prefetchSize / 2 < state.m_endPos)
+        return;
+    m_columns[pos]->prefetchData(addr.getBlockId(), addr.getOffset(), m_prefetchSize);
+    state.m_blockId = addr.getBlockId();
+    state.m_endPos = addr.getOffset() + m_prefetchSize;
+}
+
 }  // namespace siodb::iomgr::dbengine
@@ -14,6 +14,7 @@
 
 // STL headers
 #include <bitset>
+#include <mutex>
 
 namespace siodb::iomgr::dbengine {
 
@@ -33,6 +34,18 @@ public:
      */
     TableDataSet(const TablePtr& table, const std::string& tableAlias);
 
+    /**
+     * Initializes object of class TableDataSet, which reads subrange of rows of another
+     * table data set. Column information is copied from the source data set.
+     * @param src Source data set.
+     * @param minTrid Minimum TRID of the subrange.
+     * @param maxTrid Maximum TRID of the subrange.
+     * @param indexMutex Master column index access synchronization object, shared
+     *                   by all data sets which read the same table in parallel.
+     */
+    TableDataSet(const TableDataSet& src, std::uint64_t minTrid, std::uint64_t maxTrid,
+            std::mutex& indexMutex);
+
     /**
      * Returns table object.
      * @return Table object.
@@ -107,6 +120,12 @@ public:
      */
     std::uint32_t getDataSourceId() const noexcept override;
 
+    /**
+     * Returns minimum and maximum TRID existing in the table.
+     * @return Pair of minimum and maximum TRID or empty value if table is empty.
+     */
+    std::optional<std::pair<std::uint64_t, std::uint64_t>> getTridRange() const;
+
     /** Reset cursor position to the first row. */
     void resetCursor() override;
 
@@ -135,6 +154,21 @@ public:
             const std::vector<std::size_t>& columnPositions, std::uint32_t currentUserId);
 
 private:
+    /**
+     * Locks master column index, if it is shared with other data sets.
+     * @return Lock object.
+     */
+    std::unique_lock<std::mutex> lockMasterColumnIndex() const
+    {
+        return m_indexMutex ? std::unique_lock(*m_indexMutex) : std::unique_lock<std::mutex>();
+    }
+
+    /**
+     * Checks that current row key belongs to the TRID range of this data set.
+     * @return true if key is in range, false otherwise.
+     */
+    bool isCurrentKeyInRange() const noexcept;
+
     /**
      * Reads master column record of the current row.
      * @param indexSearchFailureDefectCode Defect code used to report index search failure.
@@ -147,6 +181,24 @@ private:
      */
     void readColumnValue(std::size_t index);
 
+    /**
+     * Requests background read of the column data following given address,
+     * if previously requested data is mostly consumed.
+     * @param pos Column position.
+     * @param addr Address of the data being read.
+     */
+    void prefetchColumnData(std::size_t pos, const ColumnDataAddress& addr);
+
+private:
+    /** Column data prefetch state */
+    struct ColumnPrefetchState {
+        /** Block ID of the last prefetch */
+        std::uint64_t m_blockId = 0;
+
+        /** End position of the data requested by last prefetch */
+        std::uint64_t m_endPos = 0;
+    };
+
 private:
     /** Table object */
     const TablePtr m_table;
@@ -174,6 +226,27 @@ private:
 
     /** Next row key from index */
     std::uint8_t* m_nextKey;
+
+    /** Read buffers of the fixed width columns, by column position */
+    std::vector<ColumnDataReadBuffer> m_readBuffers;
+
+    /** Minimum TRID of rows read by this data set */
+    const std::uint64_t m_minTrid;
+
+    /** Maximum TRID of rows read by this data set */
+    const std::uint64_t m_maxTrid;
+
+    /** Time at which cursor was reset, rows expired before it are skipped */
+    std::uint64_t m_currentTime;
+
+    /** Master column index access synchronization object, if index is shared */
+    std::mutex* const m_indexMutex;
+
+    /** Size of the column data read ahead, zero if prefetch is disabled */
+    const std::size_t m_prefetchSize;
+
+    /** Prefetch states of the columns, by column position */
+    std::vector<ColumnPrefetchState> m_prefetchStates;
 };
 
 }  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,143 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "ZoneMapFilter.h"
+
+// Project headers
+#include "Column.h"
+#include "TableDataSet.h"
+
+// Common project headers
+#include <siodb/iomgr/shared/dbengine/parser/expr/BetweenOperator.h>
+#include <siodb/iomgr/shared/dbengine/parser/expr/BinaryOperator.h>
+#include <siodb/iomgr/shared/dbengine/parser/expr/ConstantExpression.h>
+#include <siodb/iomgr/shared/dbengine/parser/expr/SingleColumnExpression.h>
+
+namespace siodb::iomgr::dbengine {
+
+ZoneMapFilter::ZoneMapFilter(const TableDataSet& dataSet, const requests::Expression& where)
+    : m_dataSet(dataSet)
+{
+    addConditions(where);
+}
+
+bool ZoneMapFilter::mayMatchCurrentRow()
+{
+    const auto& columnRecords = m_dataSet.getCurrentMcr().getColumnRecords();
+    for (auto& condition : m_conditions) {
+        const auto& address = columnRecords.at(condition.m_columnPosition - 1).getAddress();
+        if (address.isNullValueAddress()) {
+            // NULL never satisfies predicate. Unexpected NULL is reported when value is read.
+            if (condition.m_column->isNotNull()) continue;
+            return false;
+        }
+        if (address.getBlockId() != condition.m_lastBlockId) {
+            condition.m_lastResult = condition.m_column->mayBlockContain(address.getBlockId(),
+                    condition.m_predicate, condition.m_value, condition.m_upperValue);
+            condition.m_lastBlockId = address.getBlockId();
+        }
+        if (!condition.m_lastResult) return false;
+    }
+    return true;
+}
+
+// --- internals ---
+
+void ZoneMapFilter::addConditions(const requests::Expression& expression)
+{
+    switch (expression.getType()) {
+        case requests::ExpressionType::kLogicalAndOperator: {
+            const auto& andOperator = static_cast<const requests::BinaryOperator&>(expression);
+            addConditions(andOperator.getLeftOperand());
+            addConditions(andOperator.getRightOperand());
+            break;
+        }
+        case requests::ExpressionType::kEqualPredicate:
+        case requests::ExpressionType::kLessPredicate:
+        case requests::ExpressionType::kLessOrEqualPredicate:
+        case requests::ExpressionType::kGreaterPredicate:
+        case requests::ExpressionType::kGreaterOrEqualPredicate: {
+            const auto& comparison = static_cast<const requests::BinaryOperator&>(expression);
+            const auto& left = comparison.getLeftOperand();
+            const auto& right = comparison.getRightOperand();
+            // "constant <op> column" is turned into "column <reversed op> constant"
+            const bool reversed = left.getType() == requests::ExpressionType::kConstant;
+            ZoneMapPredicate predicate;
+            switch (expression.getType()) {
+                case requests::ExpressionType::kLessPredicate: {
+                    predicate = reversed ? ZoneMapPredicate::kGreater : ZoneMapPredicate::kLess;
+                    break;
+                }
+                case requests::ExpressionType::kLessOrEqualPredicate: {
+                    predicate = reversed ? ZoneMapPredicate::kGreaterOrEqual
+                                         : ZoneMapPredicate::kLessOrEqual;
+                    break;
+                }
+                case requests::ExpressionType::kGreaterPredicate: {
+                    predicate = reversed ? ZoneMapPredicate::kLess : ZoneMapPredicate::kGreater;
+                    break;
+                }
+                case requests::ExpressionType::kGreaterOrEqualPredicate: {
+                    predicate = reversed ? ZoneMapPredicate::kLessOrEqual
+                                         : ZoneMapPredicate::kGreaterOrEqual;
+                    break;
+                }
+                default: {
+                    predicate = ZoneMapPredicate::kEqual;
+                    break;
+                }
+            }
+            if (reversed)
+                addCondition(right, predicate, left, nullptr);
+            else
+                addCondition(left, predicate, right, nullptr);
+            break;
+        }
+        case requests::ExpressionType::kBetweenPredicate: {
+            const auto& between = static_cast<const requests::BetweenOperator&>(expression);
+            if (!between.isNotBetween()) {
+                addCondition(between.getLeftOperand(), ZoneMapPredicate::kBetween,
+                        between.getMiddleOperand(), &between.getRightOperand());
+            }
+            break;
+        }
+        default: break;
+    }
+}
+
+void ZoneMapFilter::addCondition(const requests::Expression& columnExpression,
+        ZoneMapPredicate predicate, const requests::Expression& valueExpression,
+        const requests::Expression* upperValueExpression)
+{
+    if (columnExpression.getType() != requests::ExpressionType::kSingleColumnReference
+            || valueExpression.getType() != requests::ExpressionType::kConstant
+            || (upperValueExpression
+                    && upperValueExpression->getType() != requests::ExpressionType::kConstant))
+        return;
+
+    const auto& column = static_cast<const requests::SingleColumnExpression&>(columnExpression);
+    const auto& columnIndex = column.getDatasetColumnIndex();
+    const auto& tableIndices = column.getDatasetTableIndices();
+    if (!columnIndex || tableIndices.size() != 1 || tableIndices.front() != 0) return;
+
+    const auto& value = static_cast<const requests::ConstantExpression&>(valueExpression);
+    if (value.getValue().isNull()) return;
+    Variant upperValue;
+    if (upperValueExpression) {
+        upperValue =
+                static_cast<const requests::ConstantExpression&>(*upperValueExpression).getValue();
+        if (upperValue.isNull()) return;
+    }
+
+    const auto columnPosition = m_dataSet.findColumnPosition(*columnIndex);
+    const auto& tableColumn = m_dataSet.getColumns().at(columnPosition);
+    if (tableColumn->isMasterColumn()
+            || !ColumnDataBlockZoneMap::isDataTypeSupported(tableColumn->getDataType()))
+        return;
+
+    m_conditions.push_back(Condition {tableColumn, columnPosition, predicate, value.getValue(),
+            std::move(upperValue), 0, true});
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,107 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "ColumnDataBlockZoneMap.h"
+#include "ColumnPtr.h"
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+#include <siodb/iomgr/shared/dbengine/parser/expr/Expression.h>
+
+// STL headers
+#include <vector>
+
+namespace siodb::iomgr::dbengine {
+
+class TableDataSet;
+
+/**
+ * Filter which skips rows of the table data set using zone maps of the column data blocks,
+ * without reading column values. Uses conditions "column <op> constant" and
+ * "column BETWEEN constant AND constant" joined with AND at the top level of the WHERE
+ * expression. Filter is conservative: row which passes it still must be checked
+ * with the WHERE expression.
+ */
+class ZoneMapFilter {
+public:
+    /**
+     * Initializes object of class ZoneMapFilter.
+     * @param dataSet Table data set, must be the only data set of the WHERE expression.
+     * @param where WHERE expression.
+     */
+    ZoneMapFilter(const TableDataSet& dataSet, const requests::Expression& where);
+
+    DECLARE_NONCOPYABLE(ZoneMapFilter);
+
+    /**
+     * Returns indication that filter has no applicable conditions.
+     * @return true if filter has no conditions, false otherwise.
+     */
+    bool isEmpty() const noexcept
+    {
+        return m_conditions.empty();
+    }
+
+    /**
+     * Checks if current row of the data set may satisfy WHERE expression.
+     * @return true if row may satisfy WHERE expression, false if it definitely doesn't.
+     * @throw DatabaseError if zone map can't be read.
+     */
+    bool mayMatchCurrentRow();
+
+private:
+    /** Condition on the single column */
+    struct Condition {
+        /** Column object */
+        ColumnPtr m_column;
+
+        /** Column position in the table */
+        std::size_t m_columnPosition;
+
+        /** Predicate type */
+        ZoneMapPredicate m_predicate;
+
+        /** Right operand or lower bound */
+        Variant m_value;
+
+        /** Upper bound */
+        Variant m_upperValue;
+
+        /** Last checked block ID */
+        std::uint64_t m_lastBlockId;
+
+        /** Result of the last check */
+        bool m_lastResult;
+    };
+
+private:
+    /**
+     * Collects conditions from the expression.
+     * @param expression An expression.
+     */
+    void addConditions(const requests::Expression& expression);
+
+    /**
+     * Adds condition, if operands are column of this data set and constants.
+     * @param columnExpression Column operand.
+     * @param predicate Predicate type.
+     * @param valueExpression Right operand or lower bound.
+     * @param upperValueExpression Upper bound or nullptr.
+     */
+    void addCondition(const requests::Expression& columnExpression, ZoneMapPredicate predicate,
+            const requests::Expression& valueExpression,
+            const requests::Expression* upperValueExpression);
+
+private:
+    /** Table data set */
+    const TableDataSet& m_dataSet;
+
+    /** Conditions */
+    std::vector<Condition> m_conditions;
+};
+
+}  // namespace siodb::iomgr::dbengine
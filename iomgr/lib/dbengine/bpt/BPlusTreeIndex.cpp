@@ -1,4 +1,4 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
@@ -11,6 +11,7 @@
 // Common project headers
 #include <siodb/common/config/SiodbDataFileDefs.h>
 #include <siodb/common/io/FileIO.h>
+#include <siodb/common/log/Log.h>
 #include <siodb/common/stl_wrap/filesystem_wrapper.h>
 #include <siodb/common/utils/FSUtils.h>
 #include <siodb/common/utils/PlainBinaryEncoding.h>
@@ -39,10 +40,9 @@ BPlusTreeIndex::BPlusTreeIndex(Table& table, std::string&& name, const IndexKeyT
     : Index(table, IndexType::kBPlusTreeIndex, std::move(name), keyTraits, valueSize, keyCompare,
             unique, columns, std::move(description))
     , m_dataFileSize(dataFileSize)
-    , m_internalKvPairSize(m_keySize + sizeof(std::uint64_t))
-    , m_branchingFactor(
-              std::min((Node::kSize - InternalNodeHeader::kSerializedSize) / m_internalKvPairSize,
-                      (Node::kSize - LeafNodeHeader::kSerializedSize) / m_kvPairSize))
+    , m_branchingFactor((Node::kSize - Node::kEntriesOffset)
+                        / (m_keySize + std::max(m_valueSize, kChildNodeIdSize)))
+    , m_keySearch(getIntegerNodeKeySearchFunction(keyTraits.getNumericKeyType(), m_keySize))
     , m_splitThreshold((m_branchingFactor + 1) / 2)
     , m_indexFilePath(makeIndexFilePath(0))
     , m_file(createIndexFile())
@@ -58,18 +58,155 @@ BPlusTreeIndex::BPlusTreeIndex(Table& table, const IndexRecord& indexRecord,
         const IndexKeyTraits& keyTraits, std::size_t valueSize, KeyCompareFunction keyCompare)
     : Index(table, indexRecord, keyTraits, valueSize, keyCompare)
     , m_dataFileSize(indexRecord.m_dataFileSize)
-    , m_internalKvPairSize(m_keySize + sizeof(std::uint64_t))
-    , m_branchingFactor(
-              std::min((Node::kSize - InternalNodeHeader::kSerializedSize) / m_internalKvPairSize,
-                      (Node::kSize - LeafNodeHeader::kSerializedSize) / m_kvPairSize))
+    , m_branchingFactor((Node::kSize - Node::kEntriesOffset)
+                        / (m_keySize + std::max(m_valueSize, kChildNodeIdSize)))
+    , m_keySearch(getIntegerNodeKeySearchFunction(keyTraits.getNumericKeyType(), m_keySize))
     , m_splitThreshold((m_branchingFactor + 1) / 2)
     , m_indexFilePath(makeIndexFilePath(0))
     , m_file(openIndexFile())
     , m_nodeCount(calculateNodeCount())
-    , m_rootNodeId(findRootNode())
+    , m_rootNodeId(0)
     , m_nextFreeNodeId(1)
     , m_nodeCache(*this, kNodeCacheCapacity)
 {
+    // Root node is loaded via node cache, so it can be done only after cache initialization
+    m_rootNodeId = findRootNode();
+}
+
+std::uint64_t BPlusTreeIndex::bulkLoad(BulkLoadSource& source, unsigned fillFactor)
+{
+    if (fillFactor == 0 || fillFactor > 100)
+        throw std::invalid_argument("BPlusTreeIndex: bulk load fill factor is out of range");
+
+    std::lock_guard lock(m_structureModificationMutex);
+
+    // Index must contain only empty root leaf node
+    const auto rootNode = findNode(m_rootNodeId);
+    if (m_nodeCount > 1 || !rootNode->isLeaf() || rootNode->m_header.m_common.m_childCount > 0) {
+        throwDatabaseError(IOManagerMessageId::kErrorBptiBulkLoadIndexNotEmpty,
+                m_table.getDatabaseName(), m_table.getName(), m_name, m_table.getDatabaseUuid(),
+                m_table.getId(), m_id);
+    }
+
+    // Nodes are numbered in the order of writing, starting from the node 1,
+    // which replaces empty root node. Node is written when batch is full and next
+    // node is required, so that last node is always available for update.
+    stdext::buffer<std::uint8_t> batch(kBulkLoadWriteBatchNodeCount * Node::kSize);
+    std::uint64_t batchFirstNodeId = 1;
+    std::size_t batchNodeCount = 0;
+    const auto addNode = [&]() {
+        if (batchNodeCount == kBulkLoadWriteBatchNodeCount) {
+            writeBulkLoadedNodes(batch.data(), batchFirstNodeId, batchNodeCount);
+            batchFirstNodeId += batchNodeCount;
+            batchNodeCount = 0;
+        }
+        const auto node = batch.data() + batchNodeCount++ * Node::kSize;
+        std::memset(node, 0, Node::kSize);
+        return node;
+    };
+
+    // Last keys and IDs of the nodes of the current level, which become entries
+    // of the next level
+    const auto separatorSize = m_keySize + kChildNodeIdSize;
+    std::vector<std::uint8_t> separators;
+    const auto addSeparator = [&](const std::uint8_t* key, std::uint64_t nodeId) {
+        const auto pos = separators.size();
+        separators.resize(pos + separatorSize);
+        std::memcpy(separators.data() + pos, key, m_keySize);
+        ::pbeEncodeUInt64(nodeId, separators.data() + pos + m_keySize);
+    };
+
+    // Build leaf level
+    const auto leafCapacity = std::max<std::size_t>(m_branchingFactor * fillFactor / 100, 1);
+    LeafNodeHeader leafHeader;
+    leafHeader.m_nodeId = 0;
+    std::uint8_t* leaf = nullptr;
+    const auto finishLeaf = [&](bool last) {
+        leafHeader.m_nodeType = (last && leafHeader.m_nodeId == 1) ? NodeType::kRootLeafNode
+                                                                   : NodeType::kLeafNode;
+        leafHeader.m_prevNodeId = leafHeader.m_nodeId - 1;
+        leafHeader.m_nextNodeId = last ? 0 : leafHeader.m_nodeId + 1;
+        leafHeader.serialize(leaf);
+        addSeparator(leaf + getNodeKeyOffset(leafHeader.m_childCount - 1), leafHeader.m_nodeId);
+    };
+
+    std::uint64_t count = 0;
+    stdext::buffer<std::uint8_t> value(m_valueSize);
+    stdext::buffer<std::uint8_t> key(m_keySize), prevKey(m_keySize);
+    while (source.getNext(key.data(), value.data())) {
+        if (count > 0 && m_keyCompare(prevKey.data(), key.data()) >= 0) {
+            throwDatabaseError(IOManagerMessageId::kErrorBptiBulkLoadKeyOutOfOrder,
+                    m_table.getDatabaseName(), m_table.getName(), m_name,
+                    m_table.getDatabaseUuid(), m_table.getId(), m_id, count);
+        }
+        if (!leaf || leafHeader.m_childCount == leafCapacity) {
+            if (leaf) finishLeaf(false);
+            leaf = addNode();
+            ++leafHeader.m_nodeId;
+            leafHeader.m_childCount = 0;
+        }
+        std::memcpy(leaf + getNodeKeyOffset(leafHeader.m_childCount), key.data(), m_keySize);
+        std::memcpy(leaf + getNodeValueOffset(leafHeader.m_childCount, true), value.data(),
+                m_valueSize);
+        ++leafHeader.m_childCount;
+        ++count;
+        std::swap(key, prevKey);
+    }
+    if (count == 0) return 0;
+    finishLeaf(true);
+
+    // Build internal levels until single node remains. Entries are spread evenly
+    // among the nodes of the level, so that last node is not underfilled.
+    auto nodeId = leafHeader.m_nodeId;
+    const auto internalCapacity = std::max<std::size_t>(leafCapacity, 2);
+    while (separators.size() > separatorSize) {
+        const auto entryCount = separators.size() / separatorSize;
+        const auto nodeCount = (entryCount + internalCapacity - 1) / internalCapacity;
+        std::vector<std::uint8_t> childSeparators;
+        childSeparators.swap(separators);
+        auto separator = childSeparators.data();
+        for (std::size_t i = 0; i < nodeCount; ++i) {
+            InternalNodeHeader header;
+            header.m_nodeId = ++nodeId;
+            header.m_nodeType = (nodeCount == 1) ? NodeType::kRootInternalNode
+                                                 : NodeType::kInternalNode;
+            header.m_childCount = entryCount / nodeCount + (i < entryCount % nodeCount ? 1 : 0);
+            const auto node = addNode();
+            header.serialize(node);
+            for (std::size_t j = 0; j < header.m_childCount; ++j, separator += separatorSize) {
+                std::memcpy(node + getNodeKeyOffset(j), separator, m_keySize);
+                std::memcpy(node + getNodeValueOffset(j, false), separator + m_keySize,
+                        kChildNodeIdSize);
+            }
+            addSeparator(separator - separatorSize, nodeId);
+        }
+    }
+    writeBulkLoadedNodes(batch.data(), batchFirstNodeId, batchNodeCount);
+
+    // Write root node ID
+    std::uint8_t rootNodeIdBuffer[sizeof(std::uint64_t)];
+    ::pbeEncodeUInt64(nodeId, rootNodeIdBuffer);
+    const auto rootNodeIdOffset = Node::getOffset(0);
+    const auto n = m_file->write(rootNodeIdBuffer, sizeof(rootNodeIdBuffer), rootNodeIdOffset);
+    if (n != sizeof(rootNodeIdBuffer)) {
+        const int errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotWriteIndexFile, m_indexFilePath,
+                m_table.getDatabaseName(), m_table.getName(), m_name, m_table.getDatabaseUuid(),
+                m_table.getId(), m_id, rootNodeIdOffset, sizeof(rootNodeIdBuffer), errorCode,
+                std::strerror(errorCode), n);
+    }
+
+    // Cached empty root node is replaced by the first leaf node
+    {
+        std::lock_guard cacheLock(m_nodeCacheMutex);
+        m_nodeCache.clear();
+    }
+    m_nodeCount = nodeId;
+    m_nextFreeNodeId = nodeId + 1;
+    m_rootNodeId = nodeId;
+    // Readers still holding old root node must restart from the new one
+    rootNode->m_latch.tryMarkObsolete();
+    return count;
 }
 
 std::uint32_t BPlusTreeIndex::getDataFileSize() const noexcept
@@ -85,29 +222,33 @@ bool BPlusTreeIndex::preallocate([[maybe_unused]] const void* key)
 
 bool BPlusTreeIndex::insert(const void* key, const void* value)
 {
-    // Find a node which should contain the key
-    auto node = findNode(key);
-    assert(node->isLeaf());
-
-    // Check if a key already exists
-    auto insertPos = node->m_header.m_common.m_childCount;
-    const auto it = std::lower_bound(
-            node->begin(), node->end(), key, BinarySearchNodeDataCompareFunction(m_keyCompare));
-    if (it != node->end()) {
-        const auto newEntry = (*it).m_data;
-        if (std::memcmp(newEntry, key, m_keySize) == 0) {
-            // Key exists
-            return false;
-        }
-        insertPos = (newEntry - node->m_data - LeafNodeHeader::kSerializedSize) / m_kvPairSize;
-    }
+    while (true) {
+        // Find a node which should contain the key
+        std::uint64_t version = 0;
+        const auto node = findLeafNode(key, version);
 
-    if (node->m_header.m_common.m_childCount < m_branchingFactor)
-        insertNewEntryToNonFullLeafNode(*node, insertPos, key, value);
-    else
-        insertNewEntryToFullLeafNode(*node, insertPos, key, value);
+        // Check if a key already exists
+        const auto insertPos = findKeyPosition(*node, key);
+        const bool keyExists = insertPos < node->m_header.m_common.m_childCount
+                               && m_keyCompare(key, node->getKey(insertPos)) == 0;
 
-    return true;
+        // Results are valid only if node was not modified meanwhile
+        if (keyExists) {
+            if (node->m_latch.validate(version)) return false;
+            continue;
+        }
+        if (!node->m_latch.upgradeToWrite(version)) continue;
+
+        NodeLatchWriteGuard latchGuard(node->m_latch);
+        if (node->m_header.m_common.m_childCount < m_branchingFactor)
+            insertNewEntryToNonFullLeafNode(*node, insertPos, key, value);
+        else {
+            // Split modifies also parent nodes, which are not latched by this operation
+            std::lock_guard lock(m_structureModificationMutex);
+            insertNewEntryToFullLeafNode(*node, insertPos, key, value);
+        }
+        return true;
+    }
 }
 
 std::uint64_t BPlusTreeIndex::erase(const void* key)
@@ -128,6 +269,7 @@ std::uint64_t BPlusTreeIndex::update(const void* key, const void* value)
 void BPlusTreeIndex::flush()
 {
     try {
+        std::lock_guard lock(m_nodeCacheMutex);
         m_nodeCache.flush();
     } catch (std::exception& ex) {
         throwDatabaseError(IOManagerMessageId::kErrorBptiFlushNodeCacheFailed,
@@ -142,32 +284,38 @@ std::uint64_t BPlusTreeIndex::find(const void* key, void* value, std::size_t cou
     // otherwise there is no sense to continue
     if (count == 0) return 0;
 
-    // Find a node which may contain the key
-    auto node = findNode(key);
-    assert(node->isLeaf());
-
-    // Attempt to find a key
-    const auto it = std::lower_bound(
-            node->begin(), node->end(), key, BinarySearchNodeDataCompareFunction(m_keyCompare));
-    if (it == node->end()) return 0;
-    auto v = (*it).m_data;
-    if (m_keyCompare(key, v)) return 0;
+    while (true) {
+        // Find a node which may contain the key
+        std::uint64_t version = 0;
+        const auto node = findLeafNode(key, version);
+
+        // Attempt to find a key
+        std::uint64_t result = 0;
+        const auto pos = findKeyPosition(*node, key);
+        if (pos < node->m_header.m_common.m_childCount
+                && m_keyCompare(key, node->getKey(pos)) == 0) {
+            std::memcpy(value, node->getValue(pos), m_valueSize);
+            result = 1;
+        }
 
-    std::memcpy(value, v + m_keySize, m_valueSize);
-    return 1;
+        // Copied value is consistent only if node was not modified meanwhile
+        if (node->m_latch.validate(version)) return result;
+    }
 }
 
 std::uint64_t BPlusTreeIndex::count(const void* key)
 {
-    // Find a node which may contain the key
-    auto node = findNode(key);
-    assert(node->isLeaf());
+    while (true) {
+        // Find a node which may contain the key
+        std::uint64_t version = 0;
+        const auto node = findLeafNode(key, version);
 
-    // Check that node actually has a key
-    return std::binary_search(node->begin(), node->end(), key,
-                   BinarySearchNodeDataCompareFunction(m_keyCompare))
-                   ? 1
-                   : 0;
+        // Check that node actually has a key
+        const auto pos = findKeyPosition(*node, key);
+        const bool found = pos < node->m_header.m_common.m_childCount
+                           && m_keyCompare(key, node->getKey(pos)) == 0;
+        if (node->m_latch.validate(version)) return found ? 1 : 0;
+    }
 }
 
 bool BPlusTreeIndex::getMinKey([[maybe_unused]] void* key)
@@ -182,10 +330,14 @@ bool BPlusTreeIndex::getMaxKey([[maybe_unused]] void* key)
     return false;
 }
 
-bool BPlusTreeIndex::findFirstKey([[maybe_unused]] void* key)
+bool BPlusTreeIndex::findFirstKey(void* key)
 {
-    // TODO: Implement BPlusTreeIndex::findFirstKey()
-    return false;
+    while (true) {
+        std::uint64_t version = 0;
+        const auto node = findLeafNode(nullptr, version);
+        const auto result = copyKeyAtOrAfter(node, version, 0, key);
+        if (result) return *result;
+    }
 }
 
 bool BPlusTreeIndex::findLastKey([[maybe_unused]] void* key)
@@ -201,10 +353,21 @@ bool BPlusTreeIndex::findPreviousKey(
     return false;
 }
 
-bool BPlusTreeIndex::findNextKey([[maybe_unused]] const void* key, [[maybe_unused]] void* nextKey)
+bool BPlusTreeIndex::findNextKey(const void* key, void* nextKey)
 {
-    // TODO: Implement BPlusTreeIndex::findNextKey()
-    return false;
+    while (true) {
+        std::uint64_t version = 0;
+        const auto node = findLeafNode(key, version);
+
+        // Skip given key itself
+        auto pos = findKeyPosition(*node, key);
+        if (pos < node->m_header.m_common.m_childCount
+                && m_keyCompare(key, node->getKey(pos)) == 0)
+            ++pos;
+
+        const auto result = copyKeyAtOrAfter(node, version, pos, nextKey);
+        if (result) return *result;
+    }
 }
 
 io::FilePtr BPlusTreeIndex::createIndexFile() const
@@ -379,93 +542,156 @@ std::size_t BPlusTreeIndex::findRootNode()
     return rootNodeId;
 }
 
-BPlusTreeIndex::NodePtr BPlusTreeIndex::findNode(const void* key)
+BPlusTreeIndex::NodePtr BPlusTreeIndex::findLeafNode(const void* key, std::uint64_t& version)
+{
+    while (true) {
+        auto nodeId = m_rootNodeId.load();
+        auto node = findNode(nodeId);
+        if (!node->m_latch.beginRead(version)) continue;
+
+        // Root could change after root node ID was read
+        bool restart = !node->isRoot();
+
+        // Descend to the leaf. Parent version is validated after child version is obtained,
+        // so that child is known to be still referenced by the parent.
+        while (!restart && !node->isLeaf()) {
+            const auto childNodeId = findChildNodeId(*node, key);
+            if (!node->m_latch.validate(version)) {
+                restart = true;
+                break;
+            }
+            if (childNodeId == 0) {
+                throwDatabaseError(IOManagerMessageId::kErrorIndexNodeCorrupted,
+                        m_table.getDatabaseName(), m_table.getName(), m_name, nodeId,
+                        m_table.getDatabaseUuid(), m_table.getId(), m_id);
+            }
+            auto childNode = findNode(childNodeId);
+            std::uint64_t childVersion = 0;
+            restart = !childNode->m_latch.beginRead(childVersion)
+                      || !node->m_latch.validate(version);
+            node = std::move(childNode);
+            nodeId = childNodeId;
+            version = childVersion;
+        }
+
+        // Leaf could be split after its parent was examined, in such case key
+        // may belong to one of the right siblings.
+        while (!restart && key && isKeyBeyondLeafNode(*node, key)) {
+            const auto nextNodeId = node->m_header.m_leafNodeHeader.m_nextNodeId;
+            if (!node->m_latch.validate(version)) {
+                restart = true;
+                break;
+            }
+            auto nextNode = findNode(nextNodeId);
+            std::uint64_t nextVersion = 0;
+            if (!nextNode->m_latch.beginRead(nextVersion)) {
+                restart = true;
+                break;
+            }
+            const bool moveRight = nextNode->isLeaf()
+                                   && nextNode->m_header.m_common.m_childCount > 0
+                                   && m_keyCompare(key, nextNode->getKey(0)) >= 0;
+            if (!nextNode->m_latch.validate(nextVersion) || !node->m_latch.validate(version)) {
+                restart = true;
+                break;
+            }
+            if (!moveRight) break;
+            node = std::move(nextNode);
+            nodeId = nextNodeId;
+            version = nextVersion;
+        }
+
+        if (!restart) return node;
+    }
+}
+
+std::uint64_t BPlusTreeIndex::findChildNodeId(Node& node, const void* key) const noexcept
 {
     // Each node contains:
     // - header
-    // - series of (key, value) pairs, where value:
+    // - array of keys
+    // - array of values, where value:
     //     - in the internal node is 64-bit child node ID
-    //     - in the leaf node is 64-bit data offset
+    //     - in the leaf node is index value
 
     // Search algorithm as described in the https://en.wikipedia.org/wiki/B%2B_tree
     //
-    // Function: search (k)
-    // return tree_search (k, root);
-    //
-    // Function: tree_search (k, node)
-    // if node is a leaf then
-    //     return node;
-    // switch k do
     // case k ≤ k_0
-    //     return tree_search(k, p_0);
+    //     return p_0;
     // case k_i < k ≤ k_{i+1}
-    //     return tree_search(k, p_{i+1});
+    //     return p_{i+1};
     // case k_d < k
-    //     return tree_search(k, p_{d});
+    //     return p_d;
     //
+    // i.e. child is pointed by the first entry with key not less than given,
+    // last entry covers all greater keys.
+
+    const std::size_t childCount = node.m_header.m_common.m_childCount;
+    if (childCount == 0 || childCount > m_branchingFactor) return 0;
+
+    const auto pos = key ? std::min(findKeyPosition(node, key), childCount - 1) : 0;
+    std::uint64_t childNodeId = 0;
+    ::pbeDecodeUInt64(node.getValue(pos), &childNodeId);
+    return childNodeId;
+}
+
+std::optional<bool> BPlusTreeIndex::copyKeyAtOrAfter(
+        NodePtr node, std::uint64_t version, std::size_t pos, void* key)
+{
+    // Node may be concurrently modified, so entry count is limited to stay inside node
+    while (pos >= std::min<std::size_t>(node->m_header.m_common.m_childCount, m_branchingFactor)) {
+        const auto nextNodeId = node->m_header.m_leafNodeHeader.m_nextNodeId;
+        if (!node->m_latch.validate(version)) return std::nullopt;
+        if (nextNodeId == 0) return false;
+        auto nextNode = findNode(nextNodeId);
+        std::uint64_t nextVersion = 0;
+        if (!nextNode->m_latch.beginRead(nextVersion) || !node->m_latch.validate(version))
+            return std::nullopt;
+        node = std::move(nextNode);
+        version = nextVersion;
+        pos = 0;
+    }
 
-    auto currentNodeId = m_rootNodeId;
-    auto currentNode = findNode(currentNodeId);
-
-    while (currentNode && currentNode->m_header.m_common.m_nodeType != NodeType::kLeafNode
-            && currentNode->m_header.m_common.m_nodeType != NodeType::kRootLeafNode) {
-        std::uint64_t nextNodeId = 0;
-        if (m_keyCompare(key, currentNode->m_data + InternalNodeHeader::kSerializedSize) <= 0) {
-            // case k ≤ k_0
-            ::pbeDecodeUInt64(currentNode->m_data + InternalNodeHeader::kSerializedSize + m_keySize,
-                    &nextNodeId);
-        } else {
-            // There must be at least 2 child nodes in this case
-            auto n = currentNode->m_header.m_common.m_childCount;
-            if (n < 2) {
-                throwDatabaseError(IOManagerMessageId::kErrorIndexNodeCorrupted,
-                        m_table.getDatabaseName(), m_table.getName(), m_name, currentNodeId,
-                        m_table.getDatabaseUuid(), m_table.getId(), m_id);
-            }
-
-            --n;
-            std::uint32_t i = 1;
-            for (; i < n - 1; ++i) {
-                const auto currentEntryOffset =
-                        InternalNodeHeader::kSerializedSize + i * m_internalKvPairSize;
-                const auto nextEntryOffset = currentEntryOffset + m_internalKvPairSize;
-                if (m_keyCompare(key, currentNode->m_data + currentEntryOffset) > 0
-                        && m_keyCompare(key, currentNode->m_data + nextEntryOffset) <= 0) {
-                    // case k_i < k ≤ k_{i+1}
-                    ::pbeDecodeUInt64(
-                            currentNode->m_data + nextEntryOffset + m_keySize, &nextNodeId);
-                    break;
-                }
-            }
+    // Output buffer may be the same as the key buffer of the caller,
+    // so it is not touched until key is known to be consistent
+    stdext::buffer<std::uint8_t> foundKey(m_keySize);
+    std::memcpy(foundKey.data(), node->getKey(pos), m_keySize);
+    if (!node->m_latch.validate(version)) return std::nullopt;
+    std::memcpy(key, foundKey.data(), m_keySize);
+    return true;
+}
 
-            if (i == n - 1) {
-                const auto offset = InternalNodeHeader::kSerializedSize + n * m_internalKvPairSize;
-                if (m_keyCompare(key, currentNode->m_data + offset) > 0) {
-                    // case k_d < k
-                    ::pbeDecodeUInt64(currentNode->m_data + offset + m_keySize, &nextNodeId);
-                } else {
-                    throwDatabaseError(IOManagerMessageId::kErrorIndexNodeCorrupted,
-                            m_table.getDatabaseName(), m_table.getName(), m_name, currentNodeId,
-                            m_table.getDatabaseUuid(), m_table.getId(), m_id);
-                }
-            }
-        }
+bool BPlusTreeIndex::isKeyBeyondLeafNode(Node& node, const void* key) const noexcept
+{
+    const std::size_t childCount = node.m_header.m_common.m_childCount;
+    return node.m_header.m_leafNodeHeader.m_nextNodeId != 0 && childCount > 0
+           && childCount <= m_branchingFactor
+           && m_keyCompare(key, node.getKey(childCount - 1)) > 0;
+}
 
-        currentNode = findNode(nextNodeId);
-        currentNodeId = nextNodeId;
-    }
+std::size_t BPlusTreeIndex::findKeyPosition(Node& node, const void* key) const noexcept
+{
+    // Node may be concurrently modified, so entry count is limited to stay inside node
+    const auto count =
+            std::min<std::size_t>(node.m_header.m_common.m_childCount, m_branchingFactor);
+    if (m_keySearch) return m_keySearch(node.getKey(0), count, key);
 
-    if (!currentNode) {
-        throwDatabaseError(IOManagerMessageId::kErrorCannotFindIndexNode, m_table.getDatabaseName(),
-                m_table.getName(), m_name, currentNodeId, m_table.getDatabaseUuid(),
-                m_table.getId(), m_id);
+    std::size_t left = 0, right = count;
+    while (left < right) {
+        const auto middle = left + (right - left) / 2;
+        if (m_keyCompare(node.getKey(middle), key) < 0)
+            left = middle + 1;
+        else
+            right = middle;
     }
-
-    return currentNode;
+    return left;
 }
 
 BPlusTreeIndex::NodePtr BPlusTreeIndex::findNode(io::File& file, std::uint64_t nodeId)
 {
+    // Cache miss is handled under lock too, otherwise two copies of the same node
+    // could be loaded and modified independently
+    std::lock_guard lock(m_nodeCacheMutex);
     auto cachedNode = m_nodeCache.get(nodeId);
     return cachedNode ? *cachedNode : readNode(file, nodeId);
 }
@@ -513,20 +739,38 @@ BPlusTreeIndex::NodePtr BPlusTreeIndex::makeNode(io::File& file, std::uint64_t n
     return nullptr;
 }
 
+void BPlusTreeIndex::writeBulkLoadedNodes(
+        const std::uint8_t* nodes, std::uint64_t firstNodeId, std::size_t nodeCount)
+{
+    const auto offset = Node::getOffset(firstNodeId);
+    const auto size = nodeCount * Node::kSize;
+    const auto n = m_file->write(nodes, size, offset);
+    if (n != size) {
+        const int errorCode = errno;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotWriteIndexFile, m_indexFilePath,
+                m_table.getDatabaseName(), m_table.getName(), m_name, m_table.getDatabaseUuid(),
+                m_table.getId(), m_id, offset, size, errorCode, std::strerror(errorCode), n);
+    }
+}
+
 void BPlusTreeIndex::insertNewEntryToNonFullLeafNode(
         Node& node, std::uint32_t pos, const void* key, const void* value)
 {
     if (pos > node.m_header.m_common.m_childCount)
         throw std::out_of_range("BPlusTreeIndex: new leaf node element index is out of range");
 
-    const auto newEntry = node.m_data + LeafNodeHeader::kSerializedSize + pos * m_kvPairSize;
+    const auto newKey = node.getKey(pos);
+    const auto newValue = node.getValue(pos);
     const auto movedEntryCount = node.m_header.m_common.m_childCount - pos;
-    if (movedEntryCount > 0)
-        std::memmove(newEntry + m_kvPairSize, newEntry, movedEntryCount * m_kvPairSize);
+    if (movedEntryCount > 0) {
+        std::memmove(newKey + m_keySize, newKey, movedEntryCount * m_keySize);
+        std::memmove(newValue + m_valueSize, newValue, movedEntryCount * m_valueSize);
+    }
 
-    std::memcpy(newEntry, key, m_keySize);
-    std::memcpy(newEntry + m_keySize, value, m_valueSize);
+    std::memcpy(newKey, key, m_keySize);
+    std::memcpy(newValue, value, m_valueSize);
     ++node.m_header.m_common.m_childCount;
+    // Must be set while node is still latched, see NodeCache::can_evict()
     node.m_modified = true;
 }
 
@@ -557,28 +801,54 @@ const std::uint8_t* BPlusTreeIndex::IndexFileHeader::deserialize(
 
 ///////////////////// class BPlusTreeIndex::NodeCache /////////////////////////////////////////////
 
+BPlusTreeIndex::NodeCache::~NodeCache()
+{
+    // Save pending changes. Base class evicts all nodes and modified node must not be evicted.
+    try {
+        flush();
+    } catch (std::exception& ex) {
+        LOG_ERROR << "Index " << m_owner.makeDisplayName() << ": " << ex.what();
+    }
+    std::size_t unsavedCount = 0;
+    for (const auto& e : map_internal()) {
+        if (e.second.first->m_modified) {
+            ++unsavedCount;
+            e.second.first->m_modified = false;
+        }
+    }
+    if (unsavedCount > 0) {
+        LOG_ERROR << "Index " << m_owner.makeDisplayName() << ": " << unsavedCount
+                  << " modified nodes were not saved";
+    }
+}
+
 void BPlusTreeIndex::NodeCache::flush()
 {
-    bool hadErrors = false;
+    std::size_t failedCount = 0;
+    std::string firstError;
     for (const auto& e : map_internal()) {
         try {
-            if (e.second.first->m_modified) {
-                // TODO: Write modified block to disk
-                e.second.first->m_modified = false;
-            }
-        } catch (...) {
-            // ignore all exceptions
+            saveNode(e.first, *e.second.first);
+        } catch (std::exception& ex) {
+            if (failedCount++ == 0) firstError = ex.what();
         }
     }
-    if (hadErrors) {
-        throw std::runtime_error("Error flushing BPTI node cache");
+    if (failedCount > 0) {
+        std::ostringstream err;
+        err << "Error flushing BPTI node cache: " << failedCount << " nodes not saved, "
+            << firstError;
+        throw std::runtime_error(err.str());
     }
 }
 
 bool BPlusTreeIndex::NodeCache::can_evict(
         [[maybe_unused]] const key_type& key, const mapped_type& value) const noexcept
 {
-    return !value->m_modified;
+    // Node is marked obsolete here, because cache evicts node immediately when
+    // this function returns true. Concurrent operations still holding node object
+    // will restart and load node again. Writers set modification flag while node
+    // is latched, so latched or modified node is never evicted.
+    return !value->m_modified && value->m_latch.tryMarkObsolete();
 }
 
 void BPlusTreeIndex::NodeCache::on_evict([[maybe_unused]] const key_type& key, mapped_type& value,
@@ -592,24 +862,46 @@ bool BPlusTreeIndex::NodeCache::on_last_chance_cleanup()
 {
     std::size_t savedCount = 0;
     for (const auto& e : map_internal()) {
-        if (!e.second.first->m_modified) continue;
-        // Save node to data file
-        const auto nodeOffset = Node::getOffset(e.first);
-        const auto n = m_owner.m_file->write(e.second.first->m_data, Node::kSize, nodeOffset);
-        if (n != Node::kSize) {
-            const int errorCode = errno;
-            throwDatabaseError(IOManagerMessageId::kErrorCannotWriteIndexFile,
-                    m_owner.getIndexFilePath(), m_owner.getTable().getDatabaseName(),
-                    m_owner.m_table.getName(), m_owner.m_name, m_owner.getTable().getDatabaseUuid(),
-                    m_owner.m_table.getId(), m_owner.m_id, nodeOffset, Node::kSize, errorCode,
-                    std::strerror(errorCode), n);
-        }
-        e.second.first->m_modified = false;
-        ++savedCount;
+        if (saveNode(e.first, *e.second.first)) ++savedCount;
     }
     return savedCount > 0;
 }
 
+bool BPlusTreeIndex::NodeCache::saveNode(std::uint64_t nodeId, Node& node) const
+{
+    if (!node.m_modified) return false;
+
+    // Node latched by a writer can't be saved consistently. Waiting is not possible,
+    // because writer may wait for the node cache mutex held by the caller.
+    std::uint64_t version = 0;
+    if (!node.m_latch.tryBeginRead(version)) return false;
+    node.m_modified = false;
+    std::uint8_t buffer[Node::kSize];
+    std::memcpy(buffer, node.m_data, Node::kSize);
+    if (Node::isLeafNodeType(node.m_header.m_common.m_nodeType))
+        node.m_header.m_leafNodeHeader.serialize(buffer);
+    else
+        node.m_header.m_internalNodeHeader.serialize(buffer);
+    if (!node.m_latch.validate(version)) {
+        node.m_modified = true;
+        return false;
+    }
+
+    // Save node to data file
+    const auto nodeOffset = Node::getOffset(nodeId);
+    const auto n = m_owner.m_file->write(buffer, Node::kSize, nodeOffset);
+    if (n != Node::kSize) {
+        const int errorCode = errno;
+        node.m_modified = true;
+        throwDatabaseError(IOManagerMessageId::kErrorCannotWriteIndexFile,
+                m_owner.getIndexFilePath(), m_owner.getTable().getDatabaseName(),
+                m_owner.m_table.getName(), m_owner.m_name, m_owner.getTable().getDatabaseUuid(),
+                m_owner.m_table.getId(), m_owner.m_id, nodeOffset, Node::kSize, errorCode,
+                std::strerror(errorCode), n);
+    }
+    return true;
+}
+
 ///////////////////// class BPlusTreeIndex::CommonNodeHeader////////////////////////////////////
 
 std::uint8_t* BPlusTreeIndex::CommonNodeHeader::serialize(std::uint8_t* buffer) const noexcept
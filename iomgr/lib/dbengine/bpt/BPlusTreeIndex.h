@@ -1,4 +1,4 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
@@ -7,17 +7,30 @@
 // Project headers
 #include "../Index.h"
 #include "../IndexFileHeaderBase.h"
+#include "NodeKeySearch.h"
+#include "NodeLatch.h"
 
 // Common project headers
 #include <siodb/common/stl_ext/lru_cache.h>
 #include <siodb/common/utils/FDGuard.h>
 
+// STL headers
+#include <atomic>
+#include <mutex>
+
 // System headers
 #include <sys/types.h>
 
 namespace siodb::iomgr::dbengine {
 
-/** B+ tree index */
+/**
+ * B+ tree index. Safe for concurrent use. Each node has versioned latch.
+ * Readers descend the tree without taking latches and validate node versions,
+ * restarting from the root when validation fails (optimistic lock coupling).
+ * Writers latch exclusively only the leaf node they modify. Leaf nodes are linked
+ * to the right siblings, so that a reader which reached a leaf after its split
+ * but before its parent was updated moves right to the correct leaf.
+ */
 class BPlusTreeIndex : public Index {
 public:
     /**
@@ -57,6 +70,38 @@ public:
         return m_indexFilePath;
     }
 
+    /** Source of the key-value pairs for the bulk load */
+    class BulkLoadSource {
+    public:
+        /** De-initializes object of class BulkLoadSource */
+        virtual ~BulkLoadSource() = default;
+
+        /**
+         * Reads next key-value pair. Keys must go in the strictly ascending order.
+         * @param key Key buffer.
+         * @param value Value buffer.
+         * @return true if key-value pair was read, false if there are no more pairs.
+         */
+        virtual bool getNext(void* key, void* value) = 0;
+    };
+
+    /** Default node fill factor for the bulk load, percent */
+    static constexpr unsigned kDefaultBulkLoadFillFactor = 90;
+
+    /**
+     * Builds index bottom-up from the sorted key-value pairs. Leaf nodes are filled
+     * up to the fill factor and written sequentially, then each upper level is built
+     * from the last keys of the level below. Index must be empty and must not be used
+     * concurrently until bulk load completes.
+     * @param source Key-value pair source.
+     * @param fillFactor Node fill factor, percent, from 1 to 100.
+     * @return Number of loaded key-value pairs.
+     * @throw std::invalid_argument if fill factor is out of range.
+     * @throw DatabaseError if index is not empty, keys are out of order or I/O error occurs.
+     */
+    std::uint64_t bulkLoad(
+            BulkLoadSource& source, unsigned fillFactor = kDefaultBulkLoadFillFactor);
+
     /**
      * Returns data file size if applicable.
      * @return Data file size or zero if not applicable.
@@ -271,8 +316,6 @@ private:
                 CommonNodeHeader::kSerializedSize + sizeof(m_prevNodeId) + sizeof(m_nextNodeId);
     };
 
-    class NodeKeyValuePairIterator;
-
     /** Tree node */
     struct Node {
         /**
@@ -336,16 +379,24 @@ private:
         }
 
         /**
-         * Returns begin iterator.
-         * @return Begin iterator.
+         * Returns key address.
+         * @param index Entry index.
+         * @return Key address.
          */
-        NodeKeyValuePairIterator begin() noexcept;
+        std::uint8_t* getKey(std::size_t index) noexcept
+        {
+            return m_data + m_owner.getNodeKeyOffset(index);
+        }
 
         /**
-         * Returns end iterator.
-         * @return end iterator.
+         * Returns value address. In the internal node value is a child node ID.
+         * @param index Entry index.
+         * @return Value address.
          */
-        NodeKeyValuePairIterator end() noexcept;
+        std::uint8_t* getValue(std::size_t index) noexcept
+        {
+            return m_data + m_owner.getNodeValueOffset(index, isLeaf());
+        }
 
         /** B+ tree node size */
         static constexpr std::size_t kSize = 8 * 1024;
@@ -364,10 +415,19 @@ private:
         std::uint8_t m_data[kSize];
 
         /** Modification flag */
-        bool m_modified;
+        std::atomic<bool> m_modified;
+
+        /** Node latch */
+        NodeLatch m_latch;
 
         /** Node type offset */
         static constexpr std::size_t kNodeTypeOffset = 0;
+
+        /**
+         * Offset of the entries. Entries are stored as array of keys followed by array
+         * of values, so that keys are searched in the contiguous memory.
+         */
+        static constexpr std::size_t kEntriesOffset = LeafNodeHeader::kSerializedSize;
     };
 
     /** Node shared pointer shortcut type */
@@ -394,7 +454,9 @@ private:
         ~NodeCache();
 
         /**
-         * Writes all pending changes to disk.
+         * Writes all pending changes to disk. Nodes latched by writers are skipped,
+         * they remain modified and are saved later.
+         * @throw std::runtime_error if some nodes could not be written.
          */
         void flush();
 
@@ -424,225 +486,19 @@ private:
         bool on_last_chance_cleanup() override;
 
     private:
-        /** Owner object */
-        const BPlusTreeIndex& m_owner;
-    };
-
-    /**
-     * Lightweight object type returned by iterator dereference operator.
-     * Contains only actual data address.
-     */
-    struct NodeDataValue {
-        /** Address of a key-value pair in the node */
-        std::uint8_t* m_data;
-    };
-
-    /** Iterator for key-value pairs in the node */
-    class NodeKeyValuePairIterator {
-    public:
-        typedef NodeKeyValuePairIterator self_type;
-        typedef NodeDataValue value_type;
-        typedef NodeDataValue& reference;
-        typedef NodeDataValue* pointer;
-        typedef std::forward_iterator_tag iterator_category;
-        typedef std::ptrdiff_t difference_type;
-
-    public:
         /**
-         * Initializes object of class NodeKeyValuePairIterator.
+         * Writes modified node to disk using optimistic snapshot of the node.
+         * @param nodeId Node ID.
          * @param node Node object.
-         * @param entryIndex Initial entry index.
+         * @return true if node was written, false if node is not modified
+         *         or is being modified concurrently.
+         * @throw DatabaseError if write fails. Node remains modified in such case.
          */
-        explicit NodeKeyValuePairIterator(Node& node, std::size_t entryIndex = 0) noexcept
-            : m_node(&node)
-            , m_entryIndex(entryIndex)
-        {
-        }
-
-        /**
-         * Equality operator.
-         * @param other Other object.
-         * @return true if this object is equal to other, false otherwise.
-         */
-        bool operator==(const NodeKeyValuePairIterator& other) const noexcept
-        {
-            return m_node == other.m_node && m_entryIndex == other.m_entryIndex;
-        }
-
-        /**
-         * Non-equality operator.
-         * @param other Other object.
-         * @return true if this object is not equal to other, false otherwise.
-         */
-        bool operator!=(const NodeKeyValuePairIterator& other) const noexcept
-        {
-            return m_node != other.m_node || m_entryIndex != other.m_entryIndex;
-        }
-
-        /**
-         * Prefix increment operator.
-         * @return This object.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator& operator++()
-        {
-            if (m_entryIndex >= m_node->m_header.m_common.m_childCount) {
-                throw std::out_of_range("NodeKeyValuePairIterator increment is out of range");
-            }
-            ++m_entryIndex;
-            return *this;
-        }
-
-        /**
-         * Postfix increment operator.
-         * @return Iterator object, pointing to a current element.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator operator++(int)
-        {
-            if (m_entryIndex >= m_node->m_header.m_common.m_childCount) {
-                throw std::out_of_range("NodeKeyValuePairIterator increment is out of range");
-            }
-            return NodeKeyValuePairIterator(*m_node, m_entryIndex++);
-        }
-
-        /**
-         * Prefix decrement operator.
-         * @return This object.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator& operator--()
-        {
-            if (m_entryIndex == 0) {
-                throw std::out_of_range("NodeKeyValuePairIterator decrement is out of range");
-            }
-            --m_entryIndex;
-            return *this;
-        }
-
-        /**
-         * Postfix decrement operator.
-         * @return Iterator object, pointing to a current element.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator operator--(int)
-        {
-            if (m_entryIndex == 0) {
-                throw std::out_of_range("NodeKeyValuePairIterator decrement is out of range");
-            }
-            return NodeKeyValuePairIterator(*m_node, m_entryIndex--);
-        }
-
-        /**
-         * Addition to this object operator.
-         * @param n Number of steps forward.
-         * @return This object.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator& operator+=(difference_type n)
-        {
-            if (n < 0) return *this -= (-n);
-            if (m_node->m_header.m_common.m_childCount - m_entryIndex
-                    < static_cast<std::size_t>(n)) {
-                throw std::out_of_range("NodeKeyValuePairIterator step forward is out of range");
-            }
-            m_entryIndex += n;
-            return *this;
-        }
-
-        /**
-         * Subtraction from this object operator.
-         * @param n Number of steps back.
-         * @return This object.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator& operator-=(difference_type n)
-        {
-            if (n < 0) return *this += (-n);
-            if (m_entryIndex < static_cast<std::size_t>(n)) {
-                throw std::out_of_range("NodeKeyValuePairIterator step back is out of range");
-            }
-            m_entryIndex -= n;
-            return *this;
-        }
-
-        /**
-         * Addition operator.
-         * @param n Number of steps forward.
-         * @return Iterator object pointing N steps forward.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator operator+(difference_type n) const
-        {
-            if (n < 0) return *this - (-n);
-            if (m_node->m_header.m_common.m_childCount - m_entryIndex
-                    < static_cast<std::size_t>(n)) {
-                throw std::out_of_range("NodeKeyValuePairIterator step forward is out of range");
-            }
-            return NodeKeyValuePairIterator(*m_node, m_entryIndex + n);
-        }
-
-        /**
-         * Addition operator.
-         * @param n Number of steps forward.
-         * @return Iterator object pointing N steps forward.
-         * @throw std::out_of_range if move out of iteration range happened.
-         */
-        NodeKeyValuePairIterator operator-(difference_type n) const
-        {
-            if (n < 0) return *this + (-n);
-            if (m_entryIndex < static_cast<std::size_t>(n)) {
-                throw std::out_of_range("NodeKeyValuePairIterator step back is out of range");
-            }
-            return NodeKeyValuePairIterator(*m_node, m_entryIndex - n);
-        }
-
-        /**
-         * Dereference operator.
-         * @return Lightweight object, which contains pointer to actual data inside.
-         */
-        NodeDataValue operator*() const noexcept
-        {
-            return NodeDataValue {
-                    m_node->m_data + m_entryIndex * m_node->m_owner.m_internalKvPairSize};
-        }
+        bool saveNode(std::uint64_t nodeId, Node& node) const;
 
     private:
-        /** Underlying node object */
-        Node* m_node;
-
-        /** Current entry index */
-        std::size_t m_entryIndex;
-    };
-
-    /** Comparison function for the binary search */
-    struct BinarySearchNodeDataCompareFunction {
-        /** Initializes object of class BinarySearchNodeDataCompareFunction */
-        explicit BinarySearchNodeDataCompareFunction(KeyCompareFunction cmp) noexcept
-            : m_cmp(cmp)
-        {
-        }
-
-        /**
-         * Compares data from node and given key.
-         * @return true, if value is "less" than key, false otherwise.
-         */
-        bool operator()(const NodeDataValue& value, const void* key) const
-        {
-            return m_cmp(value.m_data, key);
-        }
-
-        /**
-         * Compares data from node and given key.
-         * @return true, if key is "less" than value, false otherwise.
-         */
-        bool operator()(const void* key, const NodeDataValue& value) const
-        {
-            return m_cmp(key, value.m_data);
-        }
-
-        /** Key comparison function */
-        const KeyCompareFunction m_cmp;
+        /** Owner object */
+        const BPlusTreeIndex& m_owner;
     };
 
 private:
@@ -671,11 +527,78 @@ private:
     std::size_t findRootNode();
 
     /**
-     * Finds node that contains or must contain given key.
+     * Returns offset of the key in the node.
+     * @param index Entry index.
+     * @return Key offset.
+     */
+    std::size_t getNodeKeyOffset(std::size_t index) const noexcept
+    {
+        return Node::kEntriesOffset + index * m_keySize;
+    }
+
+    /**
+     * Returns offset of the value in the node.
+     * @param index Entry index.
+     * @param leaf Indication that node is leaf node.
+     * @return Value offset.
+     */
+    std::size_t getNodeValueOffset(std::size_t index, bool leaf) const noexcept
+    {
+        return Node::kEntriesOffset + m_branchingFactor * m_keySize
+               + index * (leaf ? m_valueSize : kChildNodeIdSize);
+    }
+
+    /**
+     * Finds position of the first key not less than given one in the node.
+     * Node may be concurrently modified, so result is meaningful only if node
+     * version is validated after this call.
+     * @param node Node object.
      * @param key A key.
-     * @return Node object.
+     * @return Key position or number of entries if all keys are less than given one.
      */
-    NodePtr findNode(const void* key);
+    std::size_t findKeyPosition(Node& node, const void* key) const noexcept;
+
+    /**
+     * Finds leaf node that contains or must contain given key and starts optimistic
+     * read of it. Caller must validate returned version after reading the node.
+     * @param key A key or nullptr to find the leftmost leaf node.
+     * @param[out] version Leaf node version.
+     * @return Leaf node object.
+     */
+    NodePtr findLeafNode(const void* key, std::uint64_t& version);
+
+    /**
+     * Finds child node which contains or must contain given key in the internal node.
+     * Node may be concurrently modified, so result is meaningful only if node
+     * version is validated after this call.
+     * @param node Internal node object.
+     * @param key A key or nullptr to find the leftmost child node.
+     * @return Child node ID or zero if node data is inconsistent.
+     */
+    std::uint64_t findChildNodeId(Node& node, const void* key) const noexcept;
+
+    /**
+     * Copies key at given position of the leaf node, or the first key of the next
+     * non-empty leaf node, if position is beyond the last entry.
+     * @param node Leaf node object.
+     * @param version Leaf node version obtained when optimistic read was started.
+     * @param pos Key position.
+     * @param[out] key Buffer for storing key.
+     * @return true if key copied, false if there are no more keys, empty value
+     *         if nodes were modified meanwhile and search must be restarted.
+     */
+    std::optional<bool> copyKeyAtOrAfter(
+            NodePtr node, std::uint64_t version, std::size_t pos, void* key);
+
+    /**
+     * Checks whether key belongs to one of the right siblings of the leaf node.
+     * Node may be concurrently modified, so result is meaningful only if node
+     * version is validated after this call.
+     * @param node Leaf node object.
+     * @param key A key.
+     * @return true if key is greater than any key in the node and node has right sibling.
+     */
+    bool isKeyBeyondLeafNode(Node& node, const void* key) const noexcept;
 
     /**
      * Gets existing node object from the standard data file.
@@ -697,6 +620,7 @@ private:
 
     /**
      * Reads existing node object from the standard data file.
+     * Must be called with node cache mutex locked.
      * @param nodeId Node ID.
      * @return Node object.
      */
@@ -707,6 +631,7 @@ private:
 
     /**
      * Reads existing node object from a given file.
+     * Must be called with node cache mutex locked.
      * @param file File object.
      * @param nodeId Node ID.
      * @return Node object.
@@ -733,6 +658,7 @@ private:
 
     /**
      * Makes new physical node in the standard data file or obtains first available free node.
+     * Must be called with structure modification mutex locked.
      * @return New node object.
      */
     NodePtr getNewNode()
@@ -742,6 +668,7 @@ private:
 
     /**
      * Makes new physical node in a given data file or obtains first available free node.
+     * Must be called with structure modification mutex locked.
      * @param file File object.
      * @return New node object.
      */
@@ -751,6 +678,15 @@ private:
                                                 : findNode(file, m_nextFreeNodeId);
     }
 
+    /**
+     * Writes series of the bulk loaded nodes.
+     * @param nodes Node data.
+     * @param firstNodeId First node ID.
+     * @param nodeCount Number of nodes.
+     */
+    void writeBulkLoadedNodes(
+            const std::uint8_t* nodes, std::uint64_t firstNodeId, std::size_t nodeCount);
+
     /**
      * Inserts new key-value pair into the non-full leaf node.
      * @param node Node object.
@@ -775,12 +711,12 @@ private:
     /** Data file size */
     const std::uint32_t m_dataFileSize;
 
-    /** Internal key-value pair size in the node */
-    const std::size_t m_internalKvPairSize;
-
     /** Maximum number of entries in the node */
     const std::size_t m_branchingFactor;
 
+    /** Key search function specialized for the key type, nullptr if there is no such */
+    const NodeKeySearchFunction m_keySearch;
+
     /** Node split threshold */
     const std::size_t m_splitThreshold;
 
@@ -794,7 +730,7 @@ private:
     std::uint64_t m_nodeCount;
 
     /** Root node ID */
-    std::uint64_t m_rootNodeId;
+    std::atomic<std::uint64_t> m_rootNodeId;
 
     /** Next free node ID */
     std::uint64_t m_nextFreeNodeId;
@@ -802,21 +738,23 @@ private:
     /** Node cache */
     NodeCache m_nodeCache;
 
+    /** Node cache access synchronization object */
+    std::mutex m_nodeCacheMutex;
+
+    /** Serializes structure modifications (node splits) */
+    std::mutex m_structureModificationMutex;
+
     /** Modified nodes (used during modification operations) */
     std::unordered_set<Node*> m_modifiedNodes;
 
     /** Node cache capacity */
     static constexpr std::size_t kNodeCacheCapacity = 16;
-};
 
-inline BPlusTreeIndex::NodeKeyValuePairIterator BPlusTreeIndex::Node::begin() noexcept
-{
-    return NodeKeyValuePairIterator(*this);
-}
+    /** Child node ID size */
+    static constexpr std::size_t kChildNodeIdSize = sizeof(std::uint64_t);
 
-inline BPlusTreeIndex::NodeKeyValuePairIterator BPlusTreeIndex::Node::end() noexcept
-{
-    return NodeKeyValuePairIterator(*this, m_header.m_common.m_childCount);
-}
+    /** Number of nodes written at once during bulk load */
+    static constexpr std::size_t kBulkLoadWriteBatchNodeCount = 64;
+};
 
 }  // namespace siodb::iomgr::dbengine
@@ -1,9 +1,12 @@
-# Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+# Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 # Use of this source code is governed by a license that can be found
 # in the LICENSE file.
 
 CXX_SRC+= \
-	bpt/BPlusTreeIndex.cpp
+	bpt/BPlusTreeIndex.cpp \
+	bpt/NodeKeySearch.cpp
 
 CXX_HDR+= \
-	bpt/BPlusTreeIndex.h
+	bpt/BPlusTreeIndex.h \
+	bpt/NodeKeySearch.h \
+	bpt/NodeLatch.h
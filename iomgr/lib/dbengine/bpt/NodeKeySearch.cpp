@@ -0,0 +1,216 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "NodeKeySearch.h"
+
+// Common project headers
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// STL headers
+#include <limits>
+#include <type_traits>
+
+// System headers
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif  // __SSE2__
+
+namespace siodb::iomgr::dbengine {
+
+namespace {
+
+/** Number of keys below which binary search switches to the linear scan */
+constexpr std::size_t kLinearSearchThreshold = 16;
+
+/**
+ * Decodes key.
+ * @param key Key buffer.
+ * @return Key value.
+ */
+template<class T>
+T decodeKey(const std::uint8_t* key) noexcept
+{
+    if constexpr (sizeof(T) == 1) {
+        return static_cast<T>(*key);
+    } else {
+        T value = 0;
+        ::pbeDecodeInt(key, value);
+        return value;
+    }
+}
+
+/**
+ * Counts keys less than given one, one key at once.
+ * @param keys Key array.
+ * @param count Number of keys in the array.
+ * @param key A key.
+ * @return Number of keys less than given one.
+ */
+template<class T>
+std::size_t countLessKeysScalar(const std::uint8_t* keys, std::size_t count, T key) noexcept
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        n += decodeKey<T>(keys + i * sizeof(T)) < key;
+    return n;
+}
+
+#ifdef __SSE2__
+
+/**
+ * Counts 32-bit keys less than given one, 4 keys at once.
+ * @param keys Key array.
+ * @param count Number of keys in the array.
+ * @param key A key.
+ * @param signFlip Value XOR-ed with keys so that they can be compared as signed integers.
+ * @return Number of keys less than given one.
+ */
+template<class T>
+std::size_t countLessKeys32(
+        const std::uint8_t* keys, std::size_t count, T key, std::int32_t signFlip) noexcept
+{
+    const auto flip = _mm_set1_epi32(signFlip);
+    const auto k = _mm_xor_si128(_mm_set1_epi32(static_cast<std::int32_t>(key)), flip);
+    std::size_t n = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i * sizeof(T)));
+        v = _mm_xor_si128(v, flip);
+        const auto less = _mm_cmplt_epi32(v, k);
+        n += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(less)));
+    }
+    return n + countLessKeysScalar<T>(keys + i * sizeof(T), count - i, key);
+}
+
+/**
+ * Counts 64-bit keys less than given one, 2 keys at once. SSE2 has no 64-bit
+ * comparison, so it is composed of the comparisons of the 32-bit halves.
+ * @param keys Key array.
+ * @param count Number of keys in the array.
+ * @param key A key.
+ * @param signFlip Value XOR-ed with keys so that they can be compared as signed integers.
+ * @return Number of keys less than given one.
+ */
+template<class T>
+std::size_t countLessKeys64(
+        const std::uint8_t* keys, std::size_t count, T key, std::int64_t signFlip) noexcept
+{
+    const auto flip = _mm_set1_epi64x(signFlip);
+    // Low halves are compared as unsigned
+    constexpr auto kSignBit32 = std::numeric_limits<std::int32_t>::min();
+    const auto lowHalfFlip = _mm_set_epi32(0, kSignBit32, 0, kSignBit32);
+    const auto k = _mm_xor_si128(_mm_set1_epi64x(static_cast<std::int64_t>(key)), flip);
+    const auto kLow = _mm_xor_si128(k, lowHalfFlip);
+    std::size_t n = 0, i = 0;
+    for (; i + 2 <= count; i += 2) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i * sizeof(T)));
+        v = _mm_xor_si128(v, flip);
+        const auto highLess = _mm_cmplt_epi32(v, k);
+        const auto highEqual = _mm_cmpeq_epi32(v, k);
+        const auto lowLess = _mm_cmplt_epi32(_mm_xor_si128(v, lowHalfFlip), kLow);
+        // Result is valid in the high half of each 64-bit lane
+        const auto less = _mm_or_si128(highLess,
+                _mm_and_si128(highEqual, _mm_shuffle_epi32(lowLess, _MM_SHUFFLE(2, 2, 0, 0))));
+        n += __builtin_popcount(
+                _mm_movemask_ps(_mm_castsi128_ps(less)) & 0xA /* high halves only */);
+    }
+    return n + countLessKeysScalar<T>(keys + i * sizeof(T), count - i, key);
+}
+
+#endif  // __SSE2__
+
+/**
+ * Counts keys less than given one. Uses SIMD comparisons when they are available
+ * and allowed by UseSimd.
+ * @param keys Key array.
+ * @param count Number of keys in the array.
+ * @param key A key.
+ * @return Number of keys less than given one.
+ */
+template<class T, bool UseSimd>
+std::size_t countLessKeys(const std::uint8_t* keys, std::size_t count, T key) noexcept
+{
+#ifdef __SSE2__
+    if constexpr (UseSimd) {
+        if constexpr (std::is_same_v<T, std::int32_t>)
+            return countLessKeys32(keys, count, key, 0);
+        if constexpr (std::is_same_v<T, std::uint32_t>)
+            return countLessKeys32(keys, count, key, std::numeric_limits<std::int32_t>::min());
+        if constexpr (std::is_same_v<T, std::int64_t>)
+            return countLessKeys64(keys, count, key, 0);
+        if constexpr (std::is_same_v<T, std::uint64_t>)
+            return countLessKeys64(keys, count, key, std::numeric_limits<std::int64_t>::min());
+    }
+#endif  // __SSE2__
+    return countLessKeysScalar(keys, count, key);
+}
+
+/**
+ * Finds position of the first key not less than given one. Binary search narrows
+ * range down to a few keys, which are then counted without branches.
+ * @param keys Key array.
+ * @param count Number of keys in the array.
+ * @param key A key.
+ * @return Key position or count if all keys are less than given one.
+ */
+template<class T, bool UseSimd>
+std::size_t findIntegerKey(const std::uint8_t* keys, std::size_t count, const void* key) noexcept
+{
+    const auto k = decodeKey<T>(static_cast<const std::uint8_t*>(key));
+    std::size_t left = 0, right = count;
+    while (right - left > kLinearSearchThreshold) {
+        const auto middle = left + (right - left) / 2;
+        if (decodeKey<T>(keys + middle * sizeof(T)) < k)
+            left = middle + 1;
+        else
+            right = middle;
+    }
+    return left + countLessKeys<T, UseSimd>(keys + left * sizeof(T), right - left, k);
+}
+
+/**
+ * Returns key search function specialized for the integer keys.
+ * Search uses SIMD comparisons only if allowed by UseSimd.
+ * @param keyType Numeric key type.
+ * @param keySize Key size.
+ * @return Key search function or nullptr if keys are not integers.
+ */
+template<bool UseSimd>
+NodeKeySearchFunction getIntegerNodeKeySearchFunctionImpl(
+        NumericKeyType keyType, std::size_t keySize) noexcept
+{
+    if (keyType == NumericKeyType::kSignedInt) {
+        switch (keySize) {
+            case 1: return &findIntegerKey<std::int8_t, UseSimd>;
+            case 2: return &findIntegerKey<std::int16_t, UseSimd>;
+            case 4: return &findIntegerKey<std::int32_t, UseSimd>;
+            case 8: return &findIntegerKey<std::int64_t, UseSimd>;
+            default: break;
+        }
+    } else if (keyType == NumericKeyType::kUnsignedInt) {
+        switch (keySize) {
+            case 1: return &findIntegerKey<std::uint8_t, UseSimd>;
+            case 2: return &findIntegerKey<std::uint16_t, UseSimd>;
+            case 4: return &findIntegerKey<std::uint32_t, UseSimd>;
+            case 8: return &findIntegerKey<std::uint64_t, UseSimd>;
+            default: break;
+        }
+    }
+    return nullptr;
+}
+
+}  // anonymous namespace
+
+NodeKeySearchFunction getIntegerNodeKeySearchFunction(
+        NumericKeyType keyType, std::size_t keySize) noexcept
+{
+    return getIntegerNodeKeySearchFunctionImpl<true>(keyType, keySize);
+}
+
+NodeKeySearchFunction getScalarIntegerNodeKeySearchFunction(
+        NumericKeyType keyType, std::size_t keySize) noexcept
+{
+    return getIntegerNodeKeySearchFunctionImpl<false>(keyType, keySize);
+}
+
+}  // namespace siodb::iomgr::dbengine
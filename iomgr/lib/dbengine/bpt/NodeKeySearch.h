@@ -0,0 +1,48 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "../ikt/IndexKeyTraits.h"
+
+// STL headers
+#include <cstddef>
+#include <cstdint>
+
+namespace siodb::iomgr::dbengine {
+
+/**
+ * Function which finds position of the first key not less than given one
+ * in the sorted array of fixed size keys.
+ * @param keys Key array.
+ * @param count Number of keys in the array.
+ * @param key A key.
+ * @return Key position or count if all keys are less than given one.
+ */
+using NodeKeySearchFunction = std::size_t (*)(
+        const std::uint8_t* keys, std::size_t count, const void* key) noexcept;
+
+/**
+ * Returns key search function specialized for the integer keys. Such function compares
+ * keys directly and uses SIMD comparisons, when available, instead of calling key
+ * comparison function for each key.
+ * @param keyType Numeric key type.
+ * @param keySize Key size.
+ * @return Key search function or nullptr if keys are not integers.
+ */
+NodeKeySearchFunction getIntegerNodeKeySearchFunction(
+        NumericKeyType keyType, std::size_t keySize) noexcept;
+
+/**
+ * Returns key search function specialized for the integer keys, which compares
+ * keys one by one without SIMD. Serves as reference for the SIMD search.
+ * @param keyType Numeric key type.
+ * @param keySize Key size.
+ * @return Key search function or nullptr if keys are not integers.
+ */
+NodeKeySearchFunction getScalarIntegerNodeKeySearchFunction(
+        NumericKeyType keyType, std::size_t keySize) noexcept;
+
+}  // namespace siodb::iomgr::dbengine
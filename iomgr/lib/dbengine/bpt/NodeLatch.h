@@ -0,0 +1,146 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Common project headers
+#include <siodb/common/utils/HelperMacros.h>
+
+// STL headers
+#include <atomic>
+#include <thread>
+
+namespace siodb::iomgr::dbengine {
+
+/**
+ * Versioned latch of the B+ tree node for the optimistic lock coupling.
+ * Readers do not acquire latch, instead they remember node version before reading
+ * and validate that it did not change after reading. Writers acquire latch exclusively,
+ * which changes node version on release. Obsolete latch belongs to the node which
+ * is not a part of the tree anymore, operations which encounter it must restart.
+ */
+class NodeLatch {
+public:
+    /** Initializes object of class NodeLatch */
+    NodeLatch() noexcept
+        : m_version(0)
+    {
+    }
+
+    DECLARE_NONCOPYABLE(NodeLatch);
+
+    /**
+     * Returns indication that latch is held by a writer.
+     * @return true if latch is locked, false otherwise.
+     */
+    bool isLocked() const noexcept
+    {
+        return (m_version.load(std::memory_order_relaxed) & kLockedBit) != 0;
+    }
+
+    /**
+     * Starts optimistic read. Waits until writer releases latch.
+     * @param[out] version Node version.
+     * @return true if read can proceed, false if node is obsolete.
+     */
+    bool beginRead(std::uint64_t& version) const noexcept
+    {
+        auto v = m_version.load(std::memory_order_acquire);
+        while (v & kLockedBit) {
+            std::this_thread::yield();
+            v = m_version.load(std::memory_order_acquire);
+        }
+        version = v;
+        return (v & kObsoleteBit) == 0;
+    }
+
+    /**
+     * Starts optimistic read, if latch is not held by a writer.
+     * @param[out] version Node version.
+     * @return true if read can proceed, false if node is latched or obsolete.
+     */
+    bool tryBeginRead(std::uint64_t& version) const noexcept
+    {
+        version = m_version.load(std::memory_order_acquire);
+        return (version & (kLockedBit | kObsoleteBit)) == 0;
+    }
+
+    /**
+     * Checks that node was not modified since the optimistic read was started.
+     * @param version Node version returned by beginRead().
+     * @return true if data read after beginRead() is consistent, false otherwise.
+     */
+    bool validate(std::uint64_t version) const noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_version.load(std::memory_order_relaxed) == version;
+    }
+
+    /**
+     * Acquires latch exclusively, if node was not modified since the optimistic read
+     * was started.
+     * @param version Node version returned by beginRead().
+     * @return true if latch acquired, false if node was modified.
+     */
+    bool upgradeToWrite(std::uint64_t version) noexcept
+    {
+        return m_version.compare_exchange_strong(
+                version, version + kLockedBit, std::memory_order_acquire);
+    }
+
+    /** Releases exclusive latch and advances node version. */
+    void endWrite() noexcept
+    {
+        m_version.fetch_add(kLockedBit, std::memory_order_release);
+    }
+
+    /**
+     * Marks node obsolete, if latch is not held by a writer.
+     * @return true if node was marked obsolete, false otherwise.
+     */
+    bool tryMarkObsolete() noexcept
+    {
+        auto v = m_version.load(std::memory_order_relaxed);
+        return (v & (kLockedBit | kObsoleteBit)) == 0
+               && m_version.compare_exchange_strong(
+                       v, v | kObsoleteBit, std::memory_order_acquire);
+    }
+
+private:
+    /** Version. Bit 0 is obsolete flag, bit 1 is lock flag, other bits are counter. */
+    std::atomic<std::uint64_t> m_version;
+
+    /** Obsolete flag */
+    static constexpr std::uint64_t kObsoleteBit = 1;
+
+    /** Lock flag. Adding it twice clears it and increments counter. */
+    static constexpr std::uint64_t kLockedBit = 2;
+};
+
+/** Releases exclusive node latch on scope exit */
+class NodeLatchWriteGuard {
+public:
+    /**
+     * Initializes object of class NodeLatchWriteGuard.
+     * @param latch Latch, already acquired exclusively.
+     */
+    explicit NodeLatchWriteGuard(NodeLatch& latch) noexcept
+        : m_latch(latch)
+    {
+    }
+
+    /** De-initializes object of class NodeLatchWriteGuard. */
+    ~NodeLatchWriteGuard()
+    {
+        m_latch.endWrite();
+    }
+
+    DECLARE_NONCOPYABLE(NodeLatchWriteGuard);
+
+private:
+    /** Latch */
+    NodeLatch& m_latch;
+};
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,191 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "CopyFromRowReader.h"
+
+// Common project headers
+#include <siodb/common/stl_ext/system_error_ext.h>
+#include <siodb/common/utils/Base128VariantEncoding.h>
+#include <siodb/iomgr/shared/dbengine/util/RowDecoder.h>
+
+// STL headers
+#include <algorithm>
+
+namespace siodb::iomgr::dbengine {
+
+namespace {
+
+/** Maximum allowed binary row length */
+constexpr std::uint64_t kMaxBinaryRowLength = 0x40000000;
+
+}  // namespace
+
+std::size_t CopyFromRowReader::readData(void* buffer, std::size_t size)
+{
+    // NOTE: Chunked input stream reports error when attempting to read
+    // after the end of data, so check end of data flag first.
+    if (m_input.isEof()) return 0;
+    const auto n = m_input.read(buffer, size);
+    if (n < 0) {
+        if (m_input.isEof()) return 0;
+        stdext::throw_system_error("COPY: data read error");
+    }
+    return static_cast<std::size_t>(n);
+}
+
+/////////////////////// class CsvCopyFromRowReader /////////////////////////////////
+
+CsvCopyFromRowReader::CsvCopyFromRowReader(
+        siodb::io::ChunkedInputStream& input, std::size_t columnCount)
+    : CopyFromRowReader(input, columnCount)
+    , m_buffer(kBufferSize)
+    , m_pos(0)
+    , m_size(0)
+{
+}
+
+bool CsvCopyFromRowReader::readRow(std::vector<Variant>& values)
+{
+    values.clear();
+
+    // Skip empty lines
+    while (true) {
+        if (!ensureData()) return false;
+        const auto ch = m_buffer[m_pos];
+        if (ch != '\n' && ch != '\r') break;
+        ++m_pos;
+    }
+
+    ++m_rowNumber;
+    std::string field;
+    bool quoted = false, inQuotes = false, endOfRow = false;
+    while (!endOfRow) {
+        if (!ensureData()) {
+            if (inQuotes) throw std::invalid_argument("unterminated quoted value");
+            endOfRow = true;
+        } else {
+            const auto ch = m_buffer[m_pos++];
+            if (inQuotes) {
+                if (ch == '"') {
+                    // Doubled quote is an escaped quote character
+                    if (ensureData() && m_buffer[m_pos] == '"') {
+                        field.push_back('"');
+                        ++m_pos;
+                    } else
+                        inQuotes = false;
+                } else
+                    field.push_back(ch);
+                continue;
+            }
+            switch (ch) {
+                case '"': {
+                    if (!field.empty() || quoted)
+                        throw std::invalid_argument("unexpected quote character");
+                    quoted = inQuotes = true;
+                    continue;
+                }
+                case '\r': {
+                    if (ensureData() && m_buffer[m_pos] == '\n') ++m_pos;
+                    endOfRow = true;
+                    break;
+                }
+                case '\n': {
+                    endOfRow = true;
+                    break;
+                }
+                case ',': break;
+                default: {
+                    if (quoted) throw std::invalid_argument("unexpected data after quoted value");
+                    field.push_back(ch);
+                    continue;
+                }
+            }
+        }
+
+        // Field completed
+        if (values.size() == m_columnCount) {
+            throw std::invalid_argument(
+                    "too many values, expecting " + std::to_string(m_columnCount));
+        }
+        if (field.empty() && !quoted)
+            values.emplace_back();
+        else
+            values.emplace_back(std::move(field));
+        field.clear();
+        quoted = false;
+    }
+
+    if (values.size() != m_columnCount) {
+        throw std::invalid_argument("row has " + std::to_string(values.size())
+                                    + " values, expecting " + std::to_string(m_columnCount));
+    }
+    return true;
+}
+
+bool CsvCopyFromRowReader::ensureData()
+{
+    if (m_pos < m_size) return true;
+    m_size = readData(m_buffer.data(), m_buffer.size());
+    m_pos = 0;
+    return m_size > 0;
+}
+
+/////////////////////// class BinaryCopyFromRowReader //////////////////////////////
+
+BinaryCopyFromRowReader::BinaryCopyFromRowReader(siodb::io::ChunkedInputStream& input,
+        std::vector<ColumnDataType>&& dataTypes, bool hasNullableColumns)
+    : CopyFromRowReader(input, dataTypes.size())
+    , m_dataTypes(std::move(dataTypes))
+    , m_hasNullableColumns(hasNullableColumns)
+    , m_eof(false)
+{
+}
+
+bool BinaryCopyFromRowReader::readRow(std::vector<Variant>& values)
+{
+    values.clear();
+    if (m_eof) return false;
+
+    // Read row length
+    std::uint8_t lengthBuffer[kMaxSerializedInt64Size];
+    std::size_t lengthSize = 0;
+    do {
+        if (lengthSize == sizeof(lengthBuffer))
+            throw std::invalid_argument("invalid row length encoding");
+        if (readData(lengthBuffer + lengthSize, 1) == 0) {
+            if (lengthSize > 0) throw std::invalid_argument("unexpected end of data");
+            // Missing terminator is tolerated
+            m_eof = true;
+            return false;
+        }
+    } while ((lengthBuffer[lengthSize++] & 0x80) != 0);
+
+    std::uint64_t rowLength = 0;
+    if (::decodeVarUInt64(lengthBuffer, lengthSize, &rowLength) < 1)
+        throw std::invalid_argument("invalid row length encoding");
+
+    if (rowLength == 0) {
+        m_eof = true;
+        return false;
+    }
+
+    ++m_rowNumber;
+    if (rowLength > kMaxBinaryRowLength)
+        throw std::invalid_argument("row length " + std::to_string(rowLength) + " is too big");
+
+    // Read row data
+    m_buffer.resize(rowLength);
+    std::size_t offset = 0;
+    while (offset < rowLength) {
+        const auto n = readData(m_buffer.data() + offset, rowLength - offset);
+        if (n == 0) throw std::invalid_argument("unexpected end of data");
+        offset += n;
+    }
+
+    values = util::decodeRow(m_buffer.data(), m_buffer.size(), m_columnCount, m_columnCount,
+            m_dataTypes.data(), m_hasNullableColumns);
+    return true;
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,161 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Common project headers
+#include <siodb/common/io/ChunkedInputStream.h>
+#include <siodb/common/proto/ColumnDataType.pb.h>
+#include <siodb/common/utils/HelperMacros.h>
+#include <siodb/iomgr/shared/dbengine/Variant.h>
+
+// STL headers
+#include <memory>
+#include <vector>
+
+namespace siodb::iomgr::dbengine {
+
+/** Reads rows of the COPY FROM data stream. */
+class CopyFromRowReader {
+protected:
+    /**
+     * Initializes object of class CopyFromRowReader.
+     * @param input Data input stream.
+     * @param columnCount Number of values in each row.
+     */
+    CopyFromRowReader(siodb::io::ChunkedInputStream& input, std::size_t columnCount) noexcept
+        : m_input(input)
+        , m_columnCount(columnCount)
+        , m_rowNumber(0)
+    {
+    }
+
+public:
+    /** De-initializes object of class CopyFromRowReader. */
+    virtual ~CopyFromRowReader() = default;
+
+    DECLARE_NONCOPYABLE(CopyFromRowReader);
+
+    /**
+     * Returns number of the last read row, starting from 1.
+     * @return Row number.
+     */
+    std::size_t getRowNumber() const noexcept
+    {
+        return m_rowNumber;
+    }
+
+    /**
+     * Reads next row.
+     * @param[out] values Row values, NULL values are represented by the empty variant.
+     * @return true if row was read, false if end of data reached.
+     * @throw std::invalid_argument if row data is invalid.
+     * @throw std::system_error if read error occurred.
+     */
+    virtual bool readRow(std::vector<Variant>& values) = 0;
+
+protected:
+    /**
+     * Reads up to given number of bytes from the input stream.
+     * @param buffer Destination buffer.
+     * @param size Buffer size.
+     * @return Number of bytes read, zero means end of data. Once end of data is reached,
+     *         all subsequent calls return zero.
+     * @throw std::system_error if read error occurred.
+     */
+    std::size_t readData(void* buffer, std::size_t size);
+
+protected:
+    /** Data input stream */
+    siodb::io::ChunkedInputStream& m_input;
+
+    /** Number of values in each row */
+    const std::size_t m_columnCount;
+
+    /** Current row number */
+    std::size_t m_rowNumber;
+};
+
+/** Reads comma separated values, one row per line. Empty unquoted field means NULL. */
+class CsvCopyFromRowReader : public CopyFromRowReader {
+public:
+    /**
+     * Initializes object of class CsvCopyFromRowReader.
+     * @param input Data input stream.
+     * @param columnCount Number of values in each row.
+     */
+    CsvCopyFromRowReader(siodb::io::ChunkedInputStream& input, std::size_t columnCount);
+
+    /**
+     * Reads next row.
+     * @param[out] values Row values, NULL values are represented by the empty variant.
+     * @return true if row was read, false if end of data reached.
+     * @throw std::invalid_argument if row data is invalid.
+     * @throw std::system_error if read error occurred.
+     */
+    bool readRow(std::vector<Variant>& values) override;
+
+private:
+    /**
+     * Ensures that there is at least one unread character in the buffer.
+     * @return true if character available, false if end of data reached.
+     */
+    bool ensureData();
+
+private:
+    /** Read buffer */
+    std::vector<char> m_buffer;
+
+    /** Current position in the buffer */
+    std::size_t m_pos;
+
+    /** Size of data in the buffer */
+    std::size_t m_size;
+
+    /** Read buffer size */
+    static constexpr std::size_t kBufferSize = 0x10000;
+};
+
+/**
+ * Reads rows encoded in the same way as rowset data sent to the client:
+ * varint row length followed by the row data, zero row length terminates the data.
+ */
+class BinaryCopyFromRowReader : public CopyFromRowReader {
+public:
+    /**
+     * Initializes object of class BinaryCopyFromRowReader.
+     * @param input Data input stream.
+     * @param dataTypes Data types of columns.
+     * @param hasNullableColumns Indication that rows contain null bitmask.
+     */
+    BinaryCopyFromRowReader(siodb::io::ChunkedInputStream& input,
+            std::vector<ColumnDataType>&& dataTypes, bool hasNullableColumns);
+
+    /**
+     * Reads next row.
+     * @param[out] values Row values, NULL values are represented by the empty variant.
+     * @return true if row was read, false if end of data reached.
+     * @throw std::invalid_argument if row data is invalid.
+     * @throw std::system_error if read error occurred.
+     */
+    bool readRow(std::vector<Variant>& values) override;
+
+private:
+    /** Column data types */
+    const std::vector<ColumnDataType> m_dataTypes;
+
+    /** Indication that rows contain null bitmask */
+    const bool m_hasNullableColumns;
+
+    /** Row data buffer */
+    std::vector<std::uint8_t> m_buffer;
+
+    /** End of data indication */
+    bool m_eof;
+};
+
+/** COPY FROM row reader pointer */
+using CopyFromRowReaderPtr = std::unique_ptr<CopyFromRowReader>;
+
+}  // namespace siodb::iomgr::dbengine
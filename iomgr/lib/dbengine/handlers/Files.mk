@@ -3,6 +3,7 @@
 # in the LICENSE file.
 
 CXX_SRC+= \
+	handlers/CopyFromRowReader.cpp \
 	handlers/JsonOutput.cpp \
 	handlers/RequestHandler_Common.cpp \
 	handlers/RequestHandler_DDL.cpp \
@@ -14,11 +15,14 @@ CXX_SRC+= \
 	handlers/RequestHandler_UP.cpp \
 	handlers/RestProtocolRowsetWriter.cpp \
 	handlers/RestProtocolRowsetWriterFactory.cpp \
+	handlers/SqlClientProtocolColumnarRowsetWriter.cpp \
+	handlers/SqlClientProtocolColumnarRowsetWriterFactory.cpp \
 	handlers/SqlClientProtocolRowsetWriter.cpp \
 	handlers/SqlClientProtocolRowsetWriterFactory.cpp \
 	handlers/VariantOutput.cpp
 
 CXX_HDR+= \
+	handlers/CopyFromRowReader.h \
 	handlers/JsonOutput.h \
 	handlers/RequestHandler.h \
 	handlers/RequestHandlerSharedConstants.h \
@@ -26,6 +30,8 @@ CXX_HDR+= \
 	handlers/RestProtocolRowsetWriterFactory.h \
 	handlers/RowsetWriter.h \
 	handlers/RowsetWriterFactory.h \
+	handlers/SqlClientProtocolColumnarRowsetWriter.h \
+	handlers/SqlClientProtocolColumnarRowsetWriterFactory.h \
 	handlers/SqlClientProtocolRowsetWriter.h \
 	handlers/SqlClientProtocolRowsetWriterFactory.h \
 	handlers/VariantOutput.h
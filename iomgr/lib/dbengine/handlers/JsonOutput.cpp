@@ -25,6 +25,31 @@ void writeGetJsonProlog(int statusCode, siodb::io::JsonWriter& jsonWriter)
     jsonWriter.writeArrayBegin();
 }
 
+void writeGetCompactJsonProlog(int statusCode, const std::vector<std::string>& columnNames,
+        siodb::io::JsonWriter& jsonWriter)
+{
+    // Start top level object
+    jsonWriter.writeObjectBegin();
+    // Write status
+    jsonWriter.writeFieldName(kRestStatusCodeFieldName, ::ct_strlen(kRestStatusCodeFieldName));
+    jsonWriter.writeValue(statusCode);
+    // Write column names
+    jsonWriter.writeComma();
+    jsonWriter.writeFieldName(kRestColumnsFieldName, ::ct_strlen(kRestColumnsFieldName));
+    jsonWriter.writeArrayBegin();
+    bool needComma = false;
+    for (const auto& columnName : columnNames) {
+        if (needComma) jsonWriter.writeComma();
+        needComma = true;
+        jsonWriter.writeValue(columnName);
+    }
+    jsonWriter.writeArrayEnd();
+    // Start rows array
+    jsonWriter.writeComma();
+    jsonWriter.writeFieldName(kRestRowsFieldName, ::ct_strlen(kRestRowsFieldName));
+    jsonWriter.writeArrayBegin();
+}
+
 void writeModificationJsonProlog(
         int statusCode, std::size_t affectedRowCount, siodb::io::JsonWriter& jsonWriter)
 {
@@ -7,6 +7,10 @@
 // Common project headers
 #include <siodb/common/io/JsonWriter.h>
 
+// STL headers
+#include <string>
+#include <vector>
+
 namespace siodb::iomgr::dbengine {
 /**
  * Writes JSON prolog for GET request.
@@ -16,6 +20,17 @@ namespace siodb::iomgr::dbengine {
  */
 void writeGetJsonProlog(int statusCode, siodb::io::JsonWriter& jsonWriter);
 
+/**
+ * Writes JSON prolog for GET request with compact rows, which includes
+ * column names array, so that rows are written as arrays of values.
+ * @param statusCode Status code.
+ * @param columnNames Column names.
+ * @param jsonWriter JSON writer object.
+ * @throw std::system_error on write error.
+ */
+void writeGetCompactJsonProlog(int statusCode, const std::vector<std::string>& columnNames,
+        siodb::io::JsonWriter& jsonWriter);
+
 /**
  * Writes JSON prolog for POST, PATCH, DELETE requests.
  * @param statusCode Status code.
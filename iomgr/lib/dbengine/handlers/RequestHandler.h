@@ -57,6 +57,15 @@ public:
     void executeRequest(const requests::DBEngineRequest& request, std::uint64_t requestId,
             std::uint32_t responseId, std::uint32_t responseCount);
 
+    /**
+     * Sets encoding of the rowsets returned by the subsequent requests.
+     * @param rowsetFormat Rowset format.
+     */
+    void setRowsetFormat(RowsetFormat rowsetFormat) noexcept
+    {
+        m_rowsetFormat = rowsetFormat;
+    }
+
 private:
     /**
      * Returns indication that this RequestHandler acts under the super user rights.
@@ -198,6 +207,14 @@ private:
     void executeDetachDatabaseRequest(iomgr_protocol::DatabaseEngineResponse& response,
             const requests::DetachDatabaseRequest& request);
 
+    /**
+     * Executes SQL BACKUP DATABASE request.
+     * @param response Response object.
+     * @param request Request object.
+     */
+    void executeBackupDatabaseRequest(iomgr_protocol::DatabaseEngineResponse& response,
+            const requests::BackupDatabaseRequest& request);
+
     /**
      * Executes SQL RENAME TABLE request.
      * @param response Response object.
@@ -240,6 +257,14 @@ private:
     void executeInsertRequest(iomgr_protocol::DatabaseEngineResponse& response,
             const requests::InsertRequest& request);
 
+    /**
+     * Executes SQL COPY FROM request.
+     * @param response Response object.
+     * @param request Request object.
+     */
+    void executeCopyFromRequest(iomgr_protocol::DatabaseEngineResponse& response,
+            const requests::CopyFromRequest& request);
+
     // TC requests
 
     /**
@@ -395,6 +420,12 @@ private:
      */
     void executeShowTablesRequest(iomgr_protocol::DatabaseEngineResponse& response);
 
+    /**
+     * Executes SQL SHOW SCRUB STATE request.
+     * @param response Response object.
+     */
+    void executeShowScrubStateRequest(iomgr_protocol::DatabaseEngineResponse& response);
+
     /**
      * Executes SQL DESCRIBE TABLE request.
      * @param response Response object.
@@ -599,6 +630,9 @@ private:
     /** Current database */
     std::string m_currentDatabaseName;
 
+    /** Encoding of the returned rowsets */
+    RowsetFormat m_rowsetFormat;
+
     /** Log context name */
     static constexpr const char* kLogContext = "RequestHandler: ";
 
@@ -18,10 +18,28 @@ static constexpr std::uint32_t kLobChunkSize = 4096;
 /** JSON chunk size */
 static constexpr std::size_t kJsonChunkSize = 65536;
 
+/** Number of rows inserted at once by COPY FROM */
+static constexpr std::size_t kCopyFromBatchSize = 4096;
+
+/** Number of rows in a single record batch of the columnar rowset */
+static constexpr std::size_t kColumnarRowsetBatchSize = 4096;
+
+/** Column data size after which record batch of the columnar rowset is sent earlier */
+static constexpr std::size_t kMaxColumnarRowsetBatchDataSize = 0x1000000;
+
+/** Minimum number of TRIDs in the partition of the parallel table scan */
+static constexpr std::uint64_t kMinParallelScanPartitionSize = 16384;
+
+/** Number of the parallel table scan partitions per scan thread */
+static constexpr std::size_t kParallelScanPartitionsPerThread = 4;
+
 /** REST status code field name */
 static constexpr const char* kRestStatusCodeFieldName = "status";
 
 /** REST rows field name */
 static constexpr const char* kRestRowsFieldName = "rows";
 
+/** REST column names field name */
+static constexpr const char* kRestColumnsFieldName = "columns";
+
 }  // namespace siodb::iomgr::dbengine
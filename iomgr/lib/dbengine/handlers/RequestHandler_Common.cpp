@@ -6,6 +6,7 @@
 
 // Project headers
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "SqlClientProtocolColumnarRowsetWriterFactory.h"
 #include "SqlClientProtocolRowsetWriterFactory.h"
 #include "../Column.h"
 #include "../DatabaseError.h"
@@ -38,6 +39,7 @@ RequestHandler::RequestHandler(
     , m_connection(connection)
     , m_currentUserId(userId)
     , m_currentDatabaseName(kSystemDatabaseName)
+    , m_rowsetFormat(ROWSET_FORMAT_ROW)
 {
     m_instance.findDatabaseChecked(m_currentDatabaseName)->use();
 }
@@ -67,9 +69,14 @@ void RequestHandler::executeRequest(const requests::DBEngineRequest& request,
         response.set_response_count(responseCount);
         switch (request.m_requestType) {
             case requests::DBEngineRequestType::kSelect: {
-                SqlClientProtocolRowsetWriterFactory rowsetWriterFactory;
-                executeSelectRequest(response,
-                        dynamic_cast<const requests::SelectRequest&>(request), rowsetWriterFactory);
+                const auto& selectRequest = dynamic_cast<const requests::SelectRequest&>(request);
+                if (m_rowsetFormat == ROWSET_FORMAT_COLUMNAR) {
+                    SqlClientProtocolColumnarRowsetWriterFactory rowsetWriterFactory;
+                    executeSelectRequest(response, selectRequest, rowsetWriterFactory);
+                } else {
+                    SqlClientProtocolRowsetWriterFactory rowsetWriterFactory;
+                    executeSelectRequest(response, selectRequest, rowsetWriterFactory);
+                }
                 break;
             }
 
@@ -90,6 +97,11 @@ void RequestHandler::executeRequest(const requests::DBEngineRequest& request,
                 break;
             }
 
+            case requests::DBEngineRequestType::kShowScrubState: {
+                executeShowScrubStateRequest(response);
+                break;
+            }
+
             case requests::DBEngineRequestType::kDescribeTable: {
                 executeDescribeTableRequest(
                         response, dynamic_cast<const requests::DescribeTableRequest&>(request));
@@ -102,6 +114,12 @@ void RequestHandler::executeRequest(const requests::DBEngineRequest& request,
                 break;
             }
 
+            case requests::DBEngineRequestType::kCopyFrom: {
+                executeCopyFromRequest(
+                        response, dynamic_cast<const requests::CopyFromRequest&>(request));
+                break;
+            }
+
             case requests::DBEngineRequestType::kUpdate: {
                 executeUpdateRequest(
                         response, dynamic_cast<const requests::UpdateRequest&>(request));
@@ -156,6 +174,12 @@ void RequestHandler::executeRequest(const requests::DBEngineRequest& request,
                 break;
             }
 
+            case requests::DBEngineRequestType::kBackupDatabase: {
+                executeBackupDatabaseRequest(
+                        response, dynamic_cast<const requests::BackupDatabaseRequest&>(request));
+                break;
+            }
+
             case requests::DBEngineRequestType::kCreateDatabase: {
                 executeCreateDatabaseRequest(
                         response, dynamic_cast<const requests::CreateDatabaseRequest&>(request));
@@ -8,6 +8,7 @@
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
 #include "../Column.h"
 #include "../Database.h"
+#include "../DatabaseBackup.h"
 #include "../MasterColumnRecord.h"
 #include "../Table.h"
 #include "../ThrowDatabaseError.h"
@@ -552,6 +553,36 @@ void RequestHandler::executeDetachDatabaseRequest(iomgr_protocol::DatabaseEngine
     sendNotImplementedYet(response);
 }
 
+void RequestHandler::executeBackupDatabaseRequest(iomgr_protocol::DatabaseEngineResponse& response,
+        const requests::BackupDatabaseRequest& request)
+{
+    response.set_has_affected_row_count(false);
+
+    if (!isValidDatabaseObjectName(request.m_database))
+        throwDatabaseError(IOManagerMessageId::kErrorInvalidDatabaseName, request.m_database);
+
+    // Backup contains data of all tables including system ones, so only super user can do it.
+    const auto currentUser = m_instance.findUserChecked(m_currentUserId);
+    if (!currentUser->isSuperUser()) throwDatabaseError(IOManagerMessageId::kErrorPermissionDenied);
+
+    const auto database = m_instance.findDatabaseChecked(request.m_database);
+    UseDatabaseGuard databaseGuard(*database);
+
+    DatabaseBackup backup(database, request.m_backupDir);
+    const auto result = backup.run(m_instance.getWriterThreadPool());
+
+    response.add_freetext_message("Backup manifest: " + result.m_manifestFilePath);
+    std::ostringstream oss;
+    oss << "Backed up " << result.m_blockCount << " blocks: " << result.m_copiedBlockCount
+        << " sealed blocks copied, " << result.m_reusedBlockCount
+        << " sealed blocks already stored, " << result.m_snapshotBlockCount
+        << " open block snapshots";
+    response.add_freetext_message(oss.str());
+
+    protobuf::writeMessage(
+            protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, m_connection);
+}
+
 void RequestHandler::executeRenameTableRequest(iomgr_protocol::DatabaseEngineResponse& response,
         const requests::RenameTableRequest& request)
 {
@@ -620,6 +651,11 @@ void RequestHandler::executeSetTableAttributesRequest(
         }
     }
 
+    if (request.m_rowTtl && table->isSystemTable()) {
+        throwDatabaseError(IOManagerMessageId::kErrorCannotSetRowTtlForSystemTable,
+                database->getName(), table->getName());
+    }
+
     // Check permissions
     // User should have permission to alter this table or any table in this database
     // or any table in the any database
@@ -643,6 +679,8 @@ void RequestHandler::executeSetTableAttributesRequest(
         }
     }
 
+    if (request.m_rowTtl) table->setRowTtl(*request.m_rowTtl);
+
     protobuf::writeMessage(
             protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, m_connection);
 }
@@ -6,12 +6,16 @@
 
 // Project headers
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "CopyFromRowReader.h"
+#include "RequestHandlerSharedConstants.h"
 #include "../Column.h"
+#include "../ColumnDefinition.h"
 #include "../Database.h"
 #include "../MasterColumnRecord.h"
 #include "../Table.h"
 #include "../ThrowDatabaseError.h"
 #include "../TransactionParameters.h"
+#include "../ZoneMapFilter.h"
 #include "../parser/DBExpressionEvaluationContext.h"
 #include "../parser/EmptyExpressionEvaluationContext.h"
 
@@ -24,6 +28,7 @@
 
 // STL headers
 #include <functional>
+#include <optional>
 
 namespace siodb::iomgr::dbengine {
 
@@ -129,9 +134,14 @@ void RequestHandler::executeUpdateRequest(
         throwDatabaseError(IOManagerMessageId::kErrorUpdateInvalidValueExpression, e.what());
     }
 
+    std::optional<ZoneMapFilter> zoneMapFilter;
+    if (request.m_where) zoneMapFilter.emplace(*tableDataSet, *request.m_where);
+
     std::uint64_t updatedRowCount = 0;
     for (tableDataSet->resetCursor(); tableDataSet->hasCurrentRow();
             tableDataSet->moveToNextRow()) {
+        if (zoneMapFilter && !zoneMapFilter->mayMatchCurrentRow()) continue;
+
         // Read all columns required for where
         if (request.m_where) {
             try {
@@ -193,9 +203,14 @@ void RequestHandler::executeDeleteRequest(
 
     checkWhereExpression(request.m_where, dbContext);
 
+    std::optional<ZoneMapFilter> zoneMapFilter;
+    if (request.m_where) zoneMapFilter.emplace(*tableDataSet, *request.m_where);
+
     std::uint64_t deletedRowCount = 0;
     for (tableDataSet->resetCursor(); tableDataSet->hasCurrentRow();
             tableDataSet->moveToNextRow()) {
+        if (zoneMapFilter && !zoneMapFilter->mayMatchCurrentRow()) continue;
+
         if (request.m_where) {
             try {
                 const auto rowFits = request.m_where->evaluate(dbContext);
@@ -332,4 +347,152 @@ void RequestHandler::executeInsertRequest(
             protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, m_connection);
 }
 
+void RequestHandler::executeCopyFromRequest(
+        iomgr_protocol::DatabaseEngineResponse& response, const requests::CopyFromRequest& request)
+{
+    response.set_affected_row_count(0);
+    response.set_has_affected_row_count(true);
+
+    const auto& databaseName =
+            request.m_database.empty() ? m_currentDatabaseName : request.m_database;
+    if (!isValidDatabaseObjectName(databaseName))
+        throwDatabaseError(IOManagerMessageId::kErrorInvalidDatabaseName, databaseName);
+
+    const auto database = m_instance.findDatabaseChecked(databaseName);
+    UseDatabaseGuard databaseGuard(*database);
+
+    if (!isValidDatabaseObjectName(request.m_table))
+        throwDatabaseError(IOManagerMessageId::kErrorInvalidTableName, request.m_table);
+
+    if (database->isSystemTable(request.m_table)) {
+        throwDatabaseError(
+                IOManagerMessageId::kErrorCannotInsertToSystemTable, databaseName, request.m_table);
+    }
+
+    const auto table = database->findTableChecked(request.m_table);
+    table->checkOperationPermitted(m_currentUserId, PermissionType::kInsert);
+
+    // Includes TRID
+    const auto tableColumns = table->getColumnsOrderedByPosition();
+
+    // Map data stream columns to the table column positions
+    std::vector<std::size_t> columnPositions;
+    if (request.m_columns.empty()) {
+        columnPositions.reserve(tableColumns.size() - 1);
+        for (std::size_t i = 1; i < tableColumns.size(); ++i)
+            columnPositions.push_back(i);
+    } else {
+        std::unordered_map<std::reference_wrapper<const std::string>, std::size_t,
+                std::hash<std::string>, std::equal_to<std::string>>
+                tableColumnPositions;
+        tableColumnPositions.reserve(tableColumns.size());
+        for (std::size_t i = 0; i < tableColumns.size(); ++i)
+            tableColumnPositions.emplace(std::ref(tableColumns[i]->getName()), i);
+
+        std::vector<char> columnPresent(tableColumns.size());
+        std::vector<CompoundDatabaseError::ErrorRecord> errors;
+        columnPositions.reserve(request.m_columns.size());
+        for (const auto& columnName : request.m_columns) {
+            if (columnName == kMasterColumnName) {
+                errors.push_back(
+                        makeDatabaseError(IOManagerMessageId::kErrorCannotInsertIntoMasterColumn));
+                continue;
+            }
+
+            const auto it = tableColumnPositions.find(columnName);
+            if (it == tableColumnPositions.cend()) {
+                errors.push_back(makeDatabaseError(IOManagerMessageId::kErrorColumnDoesNotExist,
+                        databaseName, request.m_table, columnName));
+                continue;
+            }
+
+            if (columnPresent[it->second]) {
+                errors.push_back(makeDatabaseError(
+                        IOManagerMessageId::kErrorInsertDuplicateColumnName, columnName));
+                continue;
+            }
+
+            columnPresent[it->second] = 1;
+            columnPositions.push_back(it->second);
+        }
+
+        if (!errors.empty()) throw CompoundDatabaseError(std::move(errors));
+    }
+
+    // Prepare row prototype with default values for the columns missing in the data stream
+    std::vector<Variant> rowPrototype(tableColumns.size() - 1);
+    {
+        std::vector<char> columnPresent(tableColumns.size());
+        for (const auto position : columnPositions)
+            columnPresent[position] = 1;
+        for (std::size_t i = 1; i < tableColumns.size(); ++i) {
+            // NOTE: For now, always use current column definition.
+            if (!columnPresent[i]) {
+                rowPrototype[i - 1] =
+                        tableColumns[i]->getCurrentColumnDefinition()->getDefaultValue();
+            }
+        }
+    }
+
+    CopyFromRowReaderPtr rowReader;
+    switch (request.m_format) {
+        case requests::CopyFromFormat::kCsv: {
+            rowReader = std::make_unique<CsvCopyFromRowReader>(
+                    request.m_input, columnPositions.size());
+            break;
+        }
+        case requests::CopyFromFormat::kBinary: {
+            std::vector<ColumnDataType> dataTypes;
+            dataTypes.reserve(columnPositions.size());
+            bool hasNullableColumns = false;
+            for (const auto position : columnPositions) {
+                const auto& column = tableColumns[position];
+                dataTypes.push_back(column->getDataType());
+                hasNullableColumns |= !column->isNotNull();
+            }
+            rowReader = std::make_unique<BinaryCopyFromRowReader>(
+                    request.m_input, std::move(dataTypes), hasNullableColumns);
+            break;
+        }
+    }
+
+    const TransactionParameters transactionParams(
+            m_currentUserId, database->generateNextTransactionId());
+
+    // Read data in batches, each batch is written with one writer task per column.
+    auto& threadPool = m_instance.getWriterThreadPool();
+    std::vector<std::vector<Variant>> rows;
+    rows.reserve(kCopyFromBatchSize);
+    std::vector<Variant> values;
+    std::uint64_t insertedRowCount = 0;
+    bool hasMoreData = true;
+    while (hasMoreData) {
+        try {
+            while (rows.size() < kCopyFromBatchSize) {
+                if (!rowReader->readRow(values)) {
+                    hasMoreData = false;
+                    break;
+                }
+                auto& row = rows.emplace_back(rowPrototype);
+                for (std::size_t i = 0; i < columnPositions.size(); ++i)
+                    row[columnPositions[i] - 1] = std::move(values[i]);
+            }
+        } catch (std::invalid_argument& ex) {
+            throwDatabaseError(IOManagerMessageId::kErrorCopyFromInvalidData, databaseName,
+                    request.m_table, rowReader->getRowNumber(), ex.what());
+        } catch (std::system_error& ex) {
+            throwDatabaseError(IOManagerMessageId::kErrorCopyFromDataReadError, databaseName,
+                    request.m_table, ex.what());
+        }
+
+        if (rows.empty()) break;
+        insertedRowCount += table->insertRows(rows, transactionParams, threadPool);
+        response.set_affected_row_count(insertedRowCount);
+        rows.clear();
+    }
+
+    protobuf::writeMessage(
+            protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, m_connection);
+}
+
 }  // namespace siodb::iomgr::dbengine
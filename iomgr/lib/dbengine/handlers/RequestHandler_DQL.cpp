@@ -14,6 +14,8 @@
 #include "../SystemDatabase.h"
 #include "../TableDataSet.h"
 #include "../ThrowDatabaseError.h"
+#include "../User.h"
+#include "../ZoneMapFilter.h"
 #include "../parser/DBExpressionEvaluationContext.h"
 #include "../parser/EmptyExpressionEvaluationContext.h"
 
@@ -28,6 +30,12 @@
 #include <siodb/iomgr/shared/dbengine/parser/expr/AllColumnsExpression.h>
 #include <siodb/iomgr/shared/dbengine/parser/expr/SingleColumnExpression.h>
 
+// STL headers
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <optional>
+
 namespace siodb::iomgr::dbengine {
 
 namespace {
@@ -43,6 +51,203 @@ bool moveToNextRow(const std::vector<DataSetPtr>& tableDataSets)
     return tableDataSets.front()->hasCurrentRow();
 }
 
+/**
+ * Checks that current row satisfies WHERE expression.
+ * @param where WHERE expression.
+ * @param context Evaluation context.
+ * @return true if row satisfies WHERE expression, false otherwise.
+ * @throw DatabaseError if WHERE expression can't be evaluated.
+ */
+bool isCurrentRowMatching(
+        const requests::Expression& where, requests::DBExpressionEvaluationContext& context)
+{
+    try {
+        if (isNullType(where.getResultValueType(context))) return false;
+        return where.evaluate(context).getBool();
+    } catch (const std::runtime_error& e) {
+        // Catch exception from WHERE expression evaluation
+        throwDatabaseError(IOManagerMessageId::kErrorInvalidWhereCondition, e.what());
+    } catch (const VariantLogicError& error) {
+        throwDatabaseError(IOManagerMessageId::kErrorInvalidWhereCondition, error.what());
+    }
+}
+
+/**
+ * Evaluates result expressions for the current row.
+ * @param request SELECT request.
+ * @param context Evaluation context.
+ * @param values Buffer for the result values.
+ */
+void evaluateResultRow(const requests::SelectRequest& request,
+        requests::DBExpressionEvaluationContext& context, Variant* values)
+{
+    const auto& dataSets = context.getDataSets();
+    for (const auto& expr : request.m_resultExpressions) {
+        const auto exprType = expr.m_expression->getType();
+        if (exprType == requests::ExpressionType::kAllColumnsReference) {
+            const auto allColumnsExpression =
+                    dynamic_cast<const requests::AllColumnsExpression*>(expr.m_expression.get());
+            for (const auto tableIndex : allColumnsExpression->getDatasetTableIndices()) {
+                auto& dataSet = *dataSets[tableIndex];
+                dataSet.readCurrentRow();
+                for (const auto& rowValue : dataSet.getValues())
+                    *values++ = rowValue;
+            }
+        } else
+            *values++ = expr.m_expression->evaluate(context);
+    }
+}
+
+/** Part of the table scanned by a single thread */
+struct ParallelScanPartition {
+    /** Evaluation context over the data set reading TRID subrange */
+    std::unique_ptr<requests::DBExpressionEvaluationContext> m_context;
+
+    /** Number of scanned rows */
+    std::uint64_t m_inputRowCount = 0;
+
+    /** Values of the result rows, one row after another */
+    std::vector<Variant> m_values;
+};
+
+/**
+ * Scans single partition of the table.
+ * @param request SELECT request.
+ * @param resultingColumnCount Number of result columns.
+ * @param cancelled Indication that scan is cancelled due to error in other partition.
+ * @param partition Partition to scan.
+ * @throw DatabaseError if some error occurs.
+ */
+void scanTablePartition(const requests::SelectRequest& request, std::size_t resultingColumnCount,
+        const std::atomic<bool>& cancelled, ParallelScanPartition& partition)
+{
+    auto& context = *partition.m_context;
+    auto& dataSet = static_cast<TableDataSet&>(*context.getDataSets().front());
+    dataSet.resetCursor();
+
+    std::optional<ZoneMapFilter> zoneMapFilter;
+    if (request.m_where) {
+        zoneMapFilter.emplace(dataSet, *request.m_where);
+        if (zoneMapFilter->isEmpty()) zoneMapFilter.reset();
+    }
+
+    for (bool rowDataAvailable = dataSet.hasCurrentRow(); rowDataAvailable && !cancelled;
+            rowDataAvailable = dataSet.moveToNextRow()) {
+        ++partition.m_inputRowCount;
+        if (zoneMapFilter && !zoneMapFilter->mayMatchCurrentRow()) continue;
+        if (request.m_where && !isCurrentRowMatching(*request.m_where, context)) continue;
+        const auto rowOffset = partition.m_values.size();
+        partition.m_values.resize(rowOffset + resultingColumnCount);
+        evaluateResultRow(request, context, partition.m_values.data() + rowOffset);
+        // LOB stream keeps its data block in the block cache until row is written,
+        // buffered rows of many partitions would exhaust it, so read LOB right away.
+        for (auto it = partition.m_values.begin() + rowOffset; it != partition.m_values.end();
+                ++it) {
+            if (it->isClob())
+                *it = Variant(std::move(*it->asString()));
+            else if (it->isBlob())
+                *it = Variant(std::move(*it->asBinary()));
+        }
+    }
+}
+
+/**
+ * Scans table by the multiple threads. TRID range is split into the partitions,
+ * which are read and filtered in parallel. Rows are written in the TRID order,
+ * each partition as soon as it and all preceding partitions are scanned.
+ * Scan runs ahead of writing by at most as many partitions as there are threads,
+ * which limits number of buffered rows.
+ * NOTE: Reads of the same column from the different partitions are still serialized
+ * by the column mutex, and master column index access by the shared index mutex,
+ * so parallelism comes mostly from the filtering and evaluation of expressions.
+ * @param request SELECT request.
+ * @param dataSet Table data set.
+ * @param minTrid Minimum TRID.
+ * @param maxTrid Maximum TRID.
+ * @param partitionCount Number of partitions.
+ * @param resultingColumnCount Number of result columns.
+ * @param hasNullableColumns Indication that result has nullable columns.
+ * @param threadPool Scan thread pool.
+ * @param rowsetWriter Rowset writer.
+ * @param[out] inputRowCount Number of scanned rows.
+ * @param[out] outputRowCount Number of written rows.
+ * @throw DatabaseError if some error occurs.
+ */
+void scanTableInParallel(const requests::SelectRequest& request, const TableDataSet& dataSet,
+        std::uint64_t minTrid, std::uint64_t maxTrid, std::size_t partitionCount,
+        std::size_t resultingColumnCount, bool hasNullableColumns,
+        utils::WorkerThreadPool& threadPool, RowsetWriter& rowsetWriter,
+        std::uint64_t& inputRowCount, std::uint64_t& outputRowCount)
+{
+    // Master column index is not thread-safe
+    std::mutex indexMutex;
+    std::atomic<bool> cancelled(false);
+
+    // More partitions than threads are created, so that threads which have
+    // finished sparse partitions pick up remaining ones
+    const auto partitionSize = (maxTrid - minTrid) / partitionCount + 1;
+    partitionCount =
+            std::min<std::uint64_t>(partitionCount, (maxTrid - minTrid) / partitionSize + 1);
+    std::vector<ParallelScanPartition> partitions(partitionCount);
+    std::vector<std::future<void>> futures(partitionCount);
+    std::exception_ptr firstError;
+
+    const auto submitPartition = [&](std::size_t i) {
+        if (cancelled) return;
+        try {
+            const auto partitionMinTrid = minTrid + i * partitionSize;
+            const auto partitionMaxTrid = std::min(maxTrid, partitionMinTrid + (partitionSize - 1));
+            auto& partition = partitions[i];
+            std::vector<DataSetPtr> dataSets {std::make_shared<TableDataSet>(
+                    dataSet, partitionMinTrid, partitionMaxTrid, indexMutex)};
+            partition.m_context =
+                    std::make_unique<requests::DBExpressionEvaluationContext>(std::move(dataSets));
+            futures[i] = threadPool.submit([&request, resultingColumnCount, &cancelled,
+                                                   &partition] {
+                scanTablePartition(request, resultingColumnCount, cancelled, partition);
+            });
+        } catch (...) {
+            if (!firstError) firstError = std::current_exception();
+            cancelled = true;
+        }
+    };
+
+    const auto windowSize = std::max<std::size_t>(threadPool.getThreadCount(), 1);
+    for (std::size_t i = 0; i < std::min(windowSize, partitionCount); ++i)
+        submitPartition(i);
+
+    // All submitted tasks must complete before partitions are destroyed
+    std::vector<Variant> values(resultingColumnCount);
+    stdext::bitmask nullMask;
+    if (hasNullableColumns) nullMask.resize(resultingColumnCount);
+    for (std::size_t i = 0; i < partitionCount; ++i) {
+        if (!futures[i].valid()) continue;
+        auto& partition = partitions[i];
+        try {
+            futures[i].get();
+            if (!firstError) {
+                inputRowCount += partition.m_inputRowCount;
+                for (auto it = partition.m_values.begin(); it != partition.m_values.end();) {
+                    for (std::size_t j = 0; j < resultingColumnCount; ++j, ++it) {
+                        values[j] = std::move(*it);
+                        if (hasNullableColumns) nullMask.set(j, values[j].isNull());
+                    }
+                    rowsetWriter.writeRow(values, nullMask);
+                    ++outputRowCount;
+                }
+            }
+        } catch (...) {
+            if (!firstError) firstError = std::current_exception();
+            cancelled = true;
+        }
+        // Release rows as soon as possible and let next partition take the place
+        partition = ParallelScanPartition();
+        if (i + windowSize < partitionCount) submitPartition(i + windowSize);
+    }
+
+    if (firstError) std::rethrow_exception(firstError);
+}
+
 }  // namespace
 
 void RequestHandler::executeSelectRequest(iomgr_protocol::DatabaseEngineResponse& response,
@@ -277,6 +482,32 @@ void RequestHandler::executeSelectRequest(iomgr_protocol::DatabaseEngineResponse
         offset = offsetValue.asUInt64();
     }
 
+    const auto singleTableDataSet =
+            (dataSets.size() == 1) ? dynamic_cast<const TableDataSet*>(dataSets.front().get())
+                                   : nullptr;
+
+    // Rows which can't satisfy WHERE are skipped using zone maps of the data blocks
+    std::optional<ZoneMapFilter> zoneMapFilter;
+    if (request.m_where && singleTableDataSet) {
+        zoneMapFilter.emplace(*singleTableDataSet, *request.m_where);
+        if (zoneMapFilter->isEmpty()) zoneMapFilter.reset();
+    }
+
+    // Large single table is scanned by the multiple threads, unless rows
+    // must be counted in order for LIMIT or OFFSET
+    const auto scanThreadPool = m_instance.getScanThreadPool();
+    std::size_t scanPartitionCount = 0;
+    std::optional<std::pair<std::uint64_t, std::uint64_t>> tridRange;
+    if (scanThreadPool && singleTableDataSet && !limit && !offset) {
+        tridRange = singleTableDataSet->getTridRange();
+        if (tridRange) {
+            // Deleted rows are counted too, this is only an estimate
+            const auto rowCount = tridRange->second - tridRange->first + 1;
+            scanPartitionCount = std::min<std::uint64_t>(rowCount / kMinParallelScanPartitionSize,
+                    scanThreadPool->getThreadCount() * kParallelScanPartitionsPerThread);
+        }
+    }
+
     const auto rowsetWriter = rowsetWriterFactory.createRowsetWriter(m_connection);
 
     response.set_rest_status_code(net::HttpStatus::kOk);
@@ -286,6 +517,14 @@ void RequestHandler::executeSelectRequest(iomgr_protocol::DatabaseEngineResponse
 
     try {
         bool rowDataAvailable = true;
+        if (scanPartitionCount > 1) {
+            scanTableInParallel(request, *singleTableDataSet, tridRange->first,
+                    tridRange->second, scanPartitionCount, resultingColumnCount,
+                    hasNullableColumns, *scanThreadPool, *rowsetWriter, inputRowCount,
+                    outputRowCount);
+            rowDataAvailable = false;
+        }
+
         for (auto& tableDataSet : dataSets) {
             rowDataAvailable &= tableDataSet->hasCurrentRow();
             if (!rowDataAvailable) break;
@@ -298,25 +537,14 @@ void RequestHandler::executeSelectRequest(iomgr_protocol::DatabaseEngineResponse
 
         while (rowDataAvailable && (!limit.has_value() || *limit > 0)) {
             ++inputRowCount;
-            if (request.m_where) {
-                try {
-                    if (isNullType(request.m_where->getResultValueType(*dbContext))) {
-                        rowDataAvailable = moveToNextRow(dataSets);
-                        continue;
-                    }
+            if (zoneMapFilter && !zoneMapFilter->mayMatchCurrentRow()) {
+                rowDataAvailable = moveToNextRow(dataSets);
+                continue;
+            }
 
-                    const auto rowFits = request.m_where->evaluate(*dbContext);
-                    if (!rowFits.getBool()) {
-                        rowDataAvailable = moveToNextRow(dataSets);
-                        continue;
-                    }
-                } catch (const std::runtime_error& e) {
-                    // Catch exception from WHERE expression evaluation
-                    throwDatabaseError(IOManagerMessageId::kErrorInvalidWhereCondition, e.what());
-                } catch (const VariantLogicError& error) {
-                    throwDatabaseError(
-                            IOManagerMessageId::kErrorInvalidWhereCondition, error.what());
-                }
+            if (request.m_where && !isCurrentRowMatching(*request.m_where, *dbContext)) {
+                rowDataAvailable = moveToNextRow(dataSets);
+                continue;
             }
 
             if (offset.has_value() && *offset > 0) {
@@ -325,29 +553,10 @@ void RequestHandler::executeSelectRequest(iomgr_protocol::DatabaseEngineResponse
                 continue;
             }
 
-            std::size_t valueIndex = 0;
-            for (const auto& expr : request.m_resultExpressions) {
-                const auto exprType = expr.m_expression->getType();
-                if (exprType == requests::ExpressionType::kAllColumnsReference) {
-                    const auto allColumnsExpression =
-                            dynamic_cast<const requests::AllColumnsExpression*>(
-                                    expr.m_expression.get());
-                    for (const auto tableIndex : allColumnsExpression->getDatasetTableIndices()) {
-                        auto& dataSet = *dataSets[tableIndex];
-                        dataSet.readCurrentRow();
-                        for (const auto& rowValue : dataSet.getValues()) {
-                            auto& value = values[valueIndex];
-                            value = rowValue;
-                            if (hasNullableColumns) nullMask.set(valueIndex, value.isNull());
-                            ++valueIndex;
-                        }
-                    }
-                } else {
-                    auto& value = values[valueIndex];
-                    value = expr.m_expression->evaluate(*dbContext);
-                    if (hasNullableColumns) nullMask.set(valueIndex, value.isNull());
-                    ++valueIndex;
-                }
+            evaluateResultRow(request, *dbContext, values.data());
+            if (hasNullableColumns) {
+                for (std::size_t i = 0; i < resultingColumnCount; ++i)
+                    nullMask.set(i, values[i].isNull());
             }
 
             rowsetWriter->writeRow(values, nullMask);
@@ -493,6 +702,81 @@ void RequestHandler::executeShowTablesRequest(iomgr_protocol::DatabaseEngineResp
     rawOutput.CheckNoError();
 }
 
+void RequestHandler::executeShowScrubStateRequest(iomgr_protocol::DatabaseEngineResponse& response)
+{
+    response.set_has_affected_row_count(false);
+    response.set_affected_row_count(0);
+
+    // Scrubber position reveals objects of all databases, so only super user can see it.
+    const auto currentUser = m_instance.findUserChecked(m_currentUserId);
+    if (!currentUser->isSuperUser()) throwDatabaseError(IOManagerMessageId::kErrorPermissionDenied);
+
+    const auto status = m_instance.getDataScrubberStatus();
+
+    addColumnToResponse(response, "ENABLED", COLUMN_DATA_TYPE_BOOL);
+    addColumnToResponse(response, "RATE", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "INTERVAL", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "PASS", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "LAST_PASS_COMPLETED", COLUMN_DATA_TYPE_TIMESTAMP, false);
+    addColumnToResponse(response, "DATABASE_ID", COLUMN_DATA_TYPE_UINT32);
+    addColumnToResponse(response, "TABLE_ID", COLUMN_DATA_TYPE_UINT32);
+    addColumnToResponse(response, "COLUMN_ID", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "BLOCK_ID", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "VERIFIED_BLOCKS", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "VERIFIED_BYTES", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "FAILED_BLOCKS", COLUMN_DATA_TYPE_UINT64);
+    addColumnToResponse(response, "LAST_FAILURE", COLUMN_DATA_TYPE_TEXT, false);
+    addColumnToResponse(response, "LAST_FAILURE_TIME", COLUMN_DATA_TYPE_TIMESTAMP, false);
+
+    std::vector<Variant> values;
+    values.reserve(response.column_description_size());
+    values.push_back(status.m_rate > 0);  // ENABLED
+    values.push_back(static_cast<std::uint64_t>(status.m_rate));  // RATE
+    values.push_back(static_cast<std::uint64_t>(status.m_interval));  // INTERVAL
+    values.push_back(status.m_passNumber);  // PASS
+    values.emplace_back();  // LAST_PASS_COMPLETED
+    if (status.m_lastPassCompletionTimestamp != 0)
+        values.back() = RawDateTime(status.m_lastPassCompletionTimestamp);
+    values.push_back(status.m_databaseId);  // DATABASE_ID
+    values.push_back(status.m_tableId);  // TABLE_ID
+    values.push_back(status.m_columnId);  // COLUMN_ID
+    values.push_back(status.m_blockId);  // BLOCK_ID
+    values.push_back(status.m_verifiedBlockCount);  // VERIFIED_BLOCKS
+    values.push_back(status.m_verifiedDataSize);  // VERIFIED_BYTES
+    values.push_back(status.m_failedBlockCount);  // FAILED_BLOCKS
+    values.emplace_back();  // LAST_FAILURE
+    values.emplace_back();  // LAST_FAILURE_TIME
+    if (status.m_lastFailureTimestamp != 0) {
+        values[values.size() - 2] = status.m_lastFailure;
+        values.back() = RawDateTime(status.m_lastFailureTimestamp);
+    }
+
+    stdext::bitmask nullMask(values.size(), false);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        nullMask.set(i, values[i].isNull());
+
+    utils::DefaultErrorCodeChecker errorChecker;
+    protobuf::StreamOutputStream rawOutput(m_connection, errorChecker);
+    protobuf::writeMessage(
+            protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, rawOutput);
+
+    protobuf::ExtendedCodedOutputStream codedOutput(&rawOutput);
+    const auto rowSize = std::accumulate(values.cbegin(), values.cend(), nullMask.size(),
+            [](std::size_t a, const Variant& b) noexcept {
+                return a + getVariantSerializedSize(b);
+            });
+    codedOutput.WriteVarint64(rowSize);
+    codedOutput.WriteRaw(nullMask.data(), nullMask.size());
+    rawOutput.CheckNoError();
+    for (const auto& value : values) {
+        writeVariant(value, codedOutput);
+        rawOutput.CheckNoError();
+    }
+
+    codedOutput.WriteVarint64(kNoMoreRows);
+    rawOutput.CheckNoError();
+}
+
 void RequestHandler::executeDescribeTableRequest(iomgr_protocol::DatabaseEngineResponse& response,
         const requests::DescribeTableRequest& request)
 {
@@ -8,6 +8,7 @@
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
 #include "JsonOutput.h"
 #include "RequestHandlerSharedConstants.h"
+#include "RestProtocolRowsetWriter.h"
 #include "RestProtocolRowsetWriterFactory.h"
 #include "VariantOutput.h"
 #include "../Index.h"
@@ -125,42 +126,23 @@ void RequestHandler::executeGetAllRowsRestRequest(iomgr_protocol::DatabaseEngine
     TableDataSet dataSet(table);
     dataSet.fillColumnInfosFromTable();
 
-    // Write response message
-    response.set_rest_status_code(net::HttpStatus::kOk);
-    {
-        utils::DefaultErrorCodeChecker errorChecker;
-        protobuf::StreamOutputStream rawOutput(m_connection, errorChecker);
-        protobuf::writeMessage(
-                protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, rawOutput);
-    }
-
-    // Write JSON payload
-    siodb::io::BufferedChunkedOutputStream chunkedOutput(kJsonChunkSize, m_connection);
-    siodb::io::JsonWriter jsonWriter(chunkedOutput);
-    writeGetJsonProlog(net::HttpStatus::kOk, jsonWriter);
+    // Column names go only into JSON, response message carries no column descriptions
     const auto& columns = dataSet.getColumns();
-    const auto columnCount = columns.size();
-    bool hadFirstRow = false;
+    std::vector<std::string> columnNames;
+    columnNames.reserve(columns.size());
+    for (const auto& column : columns)
+        columnNames.push_back(column->getName());
+
+    // Write response message and JSON payload
+    RestProtocolRowsetWriter rowsetWriter(
+            m_connection, request.m_compactRows, request.m_compression);
+    rowsetWriter.beginRowset(response, columnNames, true);
+    const stdext::bitmask nullMask;
     for (dataSet.resetCursor(); dataSet.hasCurrentRow(); dataSet.moveToNextRow()) {
         dataSet.readCurrentRow();
-        const auto& values = dataSet.getValues();
-        if (SIODB_LIKELY(hadFirstRow)) jsonWriter.writeComma();
-        hadFirstRow = true;
-        jsonWriter.writeObjectBegin();
-        bool hadFirstColumn = false;
-        for (std::size_t i = 0; i != columnCount; ++i) {
-            const auto& column = columns[i];
-            if (SIODB_LIKELY(hadFirstColumn)) jsonWriter.writeComma();
-            hadFirstColumn = true;
-            jsonWriter.writeFieldName(column->getName());
-            writeVariant(values.at(i), jsonWriter);
-        }
-        jsonWriter.writeObjectEnd();
+        rowsetWriter.writeRow(dataSet.getValues(), nullMask);
     }
-
-    writeJsonEpilog(jsonWriter);
-
-    if (chunkedOutput.close() != 0) stdext::throw_system_error("Failed to send JSON payload");
+    rowsetWriter.endRowset();
 }
 
 void RequestHandler::executeGetSingleRowRestRequest(
@@ -190,18 +172,22 @@ void RequestHandler::executeGetSingleRowRestRequest(
         throwDatabaseError(IOManagerMessageId::kErrorMasterColumnRecordIndexCorrupted,
                 database->getName(), table->getName(), database->getUuid(), table->getId(), 2);
     }
-    const bool haveRow = (valueCount == 1);
+    bool haveRow = (valueCount == 1);
 
     struct RowRelatedData {
         MasterColumnRecord m_mcr;
         std::vector<ColumnPtr> m_columns;
     };
     std::unique_ptr<RowRelatedData> rowRelatedData;
+    ColumnDataAddress mcrAddr;
     if (haveRow) {
-        ColumnDataAddress mcrAddr;
         mcrAddr.pbeDeserialize(indexValue.m_data, sizeof(indexValue.m_data));
         rowRelatedData = std::make_unique<RowRelatedData>();
         masterColumn->readMasterColumnRecord(mcrAddr, rowRelatedData->m_mcr);
+        // Expired row is not visible anymore
+        haveRow = !rowRelatedData->m_mcr.isExpired(std::time(nullptr));
+    }
+    if (haveRow) {
         const auto expectedColumnCount = table->getColumnCount() - 1;
         if (rowRelatedData->m_mcr.getColumnCount() != expectedColumnCount) {
             throwDatabaseError(IOManagerMessageId::kErrorInvalidMasterColumnRecordColumnCount,
@@ -251,7 +237,8 @@ void RequestHandler::executeGetSqlQueryRowsRestRequest(
 {
     response.set_has_affected_row_count(false);
     response.set_affected_row_count(0);
-    RestProtocolRowsetWriterFactory rowsetWriterFactory;
+    RestProtocolRowsetWriterFactory rowsetWriterFactory(
+            request.m_compactRows, request.m_compression);
     executeSelectRequest(response, *request.m_query, rowsetWriterFactory);
 }
 
@@ -10,6 +10,7 @@
 #include "VariantOutput.h"
 
 // Common project headers
+#include <siodb/common/io/DynamicMemoryOutputStream.h>
 #include <siodb/common/net/HttpStatus.h>
 #include <siodb/common/protobuf/ProtobufMessageIO.h>
 #include <siodb/common/protobuf/StreamOutputStream.h>
@@ -17,10 +18,16 @@
 
 namespace siodb::iomgr::dbengine {
 
-RestProtocolRowsetWriter::RestProtocolRowsetWriter(siodb::io::OutputStream& connection)
+RestProtocolRowsetWriter::RestProtocolRowsetWriter(
+        siodb::io::OutputStream& connection, bool compactRows, CompressionType compression)
     : m_connection(connection)
     , m_chunkedOutput(kJsonChunkSize, m_connection)
-    , m_jsonWriter(m_chunkedOutput)
+    , m_compressedOutput(createCompressedOutput(compression, m_chunkedOutput))
+    , m_jsonWriter(m_compressedOutput ? static_cast<siodb::io::OutputStream&>(*m_compressedOutput)
+                                      : m_chunkedOutput)
+    , m_compactRows(compactRows)
+    , m_compression(compression)
+    , m_columnCount(0)
     , m_needCommaBeforeRow(false)
 {
 }
@@ -28,27 +35,54 @@ RestProtocolRowsetWriter::RestProtocolRowsetWriter(siodb::io::OutputStream& conn
 void RestProtocolRowsetWriter::beginRowset(
         iomgr_protocol::DatabaseEngineResponse& response, bool haveRows)
 {
-    // Save field names
-    m_fieldNames.clear();
-    for (int i = 0, n = response.column_description_size(); i < n; ++i) {
-        const auto& column = response.column_description(i);
-        m_fieldNames.push_back(column.name());
+    std::vector<std::string> columnNames;
+    columnNames.reserve(response.column_description_size());
+    for (int i = 0, n = response.column_description_size(); i < n; ++i)
+        columnNames.push_back(response.column_description(i).name());
+    beginRowset(response, columnNames, haveRows);
+}
+
+void RestProtocolRowsetWriter::beginRowset(iomgr_protocol::DatabaseEngineResponse& response,
+        const std::vector<std::string>& columnNames, bool haveRows)
+{
+    // Render field names once per rowset
+    m_columnCount = columnNames.size();
+    m_fieldPrologs.clear();
+    if (!m_compactRows) {
+        m_fieldPrologs.reserve(m_columnCount);
+        for (std::size_t i = 0; i < m_columnCount; ++i) {
+            const auto& columnName = columnNames[i];
+            siodb::io::DynamicMemoryOutputStream out(columnName.length() + 8);
+            siodb::io::JsonWriter jsonWriter(out);
+            if (i == 0)
+                jsonWriter.writeObjectBegin();
+            else
+                jsonWriter.writeComma();
+            jsonWriter.writeFieldName(columnName);
+            m_fieldPrologs.emplace_back(static_cast<const char*>(out.data()), out.size());
+        }
     }
 
     // Send response message
     utils::DefaultErrorCodeChecker errorChecker;
     protobuf::StreamOutputStream rawOutput(m_connection, errorChecker);
     response.set_rest_status_code(haveRows ? net::HttpStatus::kOk : net::HttpStatus::kNotFound);
+    if (m_compressedOutput) response.set_compression(m_compression);
     protobuf::writeMessage(
             protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, rawOutput);
 
     // Write JSON prolog
-    writeGetJsonProlog(response.rest_status_code(), m_jsonWriter);
+    if (m_compactRows)
+        writeGetCompactJsonProlog(response.rest_status_code(), columnNames, m_jsonWriter);
+    else
+        writeGetJsonProlog(response.rest_status_code(), m_jsonWriter);
 }
 
 void RestProtocolRowsetWriter::endRowset()
 {
     writeJsonEpilog(m_jsonWriter);
+    if (m_compressedOutput && m_compressedOutput->close() != 0)
+        stdext::throw_system_error("Failed to send JSON payload");
     if (m_chunkedOutput.close() != 0) stdext::throw_system_error("Failed to send JSON payload");
 }
 
@@ -60,17 +94,42 @@ void RestProtocolRowsetWriter::writeRow(
     else
         m_needCommaBeforeRow = true;
 
-    m_jsonWriter.writeObjectBegin();
-    bool needCommaBeforeColumn = false;
-    for (std::size_t i = 0, n = m_fieldNames.size(); i != n; ++i) {
-        if (SIODB_LIKELY(needCommaBeforeColumn))
-            m_jsonWriter.writeComma();
-        else
-            needCommaBeforeColumn = true;
-        m_jsonWriter.writeFieldName(m_fieldNames[i]);
-        writeVariant(values.at(i), m_jsonWriter);
+    if (m_compactRows) {
+        m_jsonWriter.writeArrayBegin();
+        for (std::size_t i = 0; i != m_columnCount; ++i) {
+            if (SIODB_LIKELY(i > 0)) m_jsonWriter.writeComma();
+            writeVariant(values.at(i), m_jsonWriter);
+        }
+        m_jsonWriter.writeArrayEnd();
+        return;
+    }
+
+    if (SIODB_UNLIKELY(m_fieldPrologs.empty())) {
+        m_jsonWriter.writeObjectBegin();
+    } else {
+        for (std::size_t i = 0, n = m_fieldPrologs.size(); i != n; ++i) {
+            const auto& fieldProlog = m_fieldPrologs[i];
+            m_jsonWriter.writeBytes(fieldProlog.data(), fieldProlog.length());
+            writeVariant(values.at(i), m_jsonWriter);
+        }
     }
     m_jsonWriter.writeObjectEnd();
 }
 
+// --- internals ---
+
+std::unique_ptr<siodb::io::DeflateOutputStream> RestProtocolRowsetWriter::createCompressedOutput(
+        CompressionType compression, siodb::io::OutputStream& out)
+{
+    switch (compression) {
+        case COMPRESSION_GZIP:
+            return std::make_unique<siodb::io::DeflateOutputStream>(
+                    out, siodb::io::ZlibStreamFormat::kGzip);
+        case COMPRESSION_DEFLATE:
+            return std::make_unique<siodb::io::DeflateOutputStream>(
+                    out, siodb::io::ZlibStreamFormat::kZlib);
+        default: return nullptr;
+    }
+}
+
 }  // namespace siodb::iomgr::dbengine
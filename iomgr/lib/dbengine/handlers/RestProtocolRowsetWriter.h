@@ -9,6 +9,7 @@
 
 // Common project headers
 #include <siodb/common/io/BufferedChunkedOutputStream.h>
+#include <siodb/common/io/DeflateOutputStream.h>
 #include <siodb/common/io/JsonWriter.h>
 
 namespace siodb::iomgr::dbengine {
@@ -21,8 +22,12 @@ public:
     /**
      * Initializes object of class RestProtocolRowsetWriter.
      * @param connection Client connection stream.
+     * @param compactRows Indication that rows should be written as arrays of values
+     *                    instead of objects.
+     * @param compression JSON payload compression.
      */
-    explicit RestProtocolRowsetWriter(siodb::io::OutputStream& connection);
+    RestProtocolRowsetWriter(siodb::io::OutputStream& connection, bool compactRows,
+            CompressionType compression);
 
     /**
      * Begins a rowset.
@@ -31,6 +36,16 @@ public:
      */
     void beginRowset(iomgr_protocol::DatabaseEngineResponse& response, bool haveRows) override;
 
+    /**
+     * Begins a rowset with column names given separately from the response,
+     * so that response doesn't have to carry column descriptions.
+     * @param response Database engine response.
+     * @param columnNames Column names.
+     * @param haveRows Indication that there are rows in the respose.
+     */
+    void beginRowset(iomgr_protocol::DatabaseEngineResponse& response,
+            const std::vector<std::string>& columnNames, bool haveRows);
+
     /**
      * Ends a rowset.
      */
@@ -43,6 +58,16 @@ public:
      */
     void writeRow(const std::vector<Variant>& values, const stdext::bitmask& nullMask) override;
 
+private:
+    /**
+     * Creates compressing stream over the chunked output stream.
+     * @param compression Compression type.
+     * @param out Chunked output stream.
+     * @return Compressing stream or nullptr if compression is not required.
+     */
+    static std::unique_ptr<siodb::io::DeflateOutputStream> createCompressedOutput(
+            CompressionType compression, siodb::io::OutputStream& out);
+
 private:
     /** Client connection */
     siodb::io::OutputStream& m_connection;
@@ -50,11 +75,26 @@ private:
     /** Chunked output stream */
     siodb::io::BufferedChunkedOutputStream m_chunkedOutput;
 
+    /** Compressing stream over the chunked output stream, if compression is enabled */
+    std::unique_ptr<siodb::io::DeflateOutputStream> m_compressedOutput;
+
     /** JSON writer */
     siodb::io::JsonWriter m_jsonWriter;
 
-    /** Field names */
-    std::vector<std::string> m_fieldNames;
+    /** Indication that rows are written as arrays of values */
+    const bool m_compactRows;
+
+    /** JSON payload compression */
+    const CompressionType m_compression;
+
+    /** Number of columns in the rowset */
+    std::size_t m_columnCount;
+
+    /**
+     * Pre-rendered JSON text written before each field value:
+     * object begin or comma, followed by escaped quoted field name and colon.
+     */
+    std::vector<std::string> m_fieldPrologs;
 
     /** Indication that comma before next row is required */
     bool m_needCommaBeforeRow;
@@ -12,7 +12,7 @@ namespace siodb::iomgr::dbengine {
 std::unique_ptr<RowsetWriter> RestProtocolRowsetWriterFactory::createRowsetWriter(
         siodb::io::OutputStream& connection)
 {
-    auto p = std::make_unique<RestProtocolRowsetWriter>(connection);
+    auto p = std::make_unique<RestProtocolRowsetWriter>(connection, m_compactRows, m_compression);
     return std::unique_ptr<RowsetWriter>(p.release());
 }
 
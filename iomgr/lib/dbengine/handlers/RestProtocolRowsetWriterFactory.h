@@ -15,12 +15,32 @@ namespace siodb::iomgr::dbengine {
  */
 class RestProtocolRowsetWriterFactory : public RowsetWriterFactory {
 public:
+    /**
+     * Initializes object of class RestProtocolRowsetWriterFactory.
+     * @param compactRows Indication that rows should be written as arrays of values
+     *                    instead of objects.
+     * @param compression JSON payload compression.
+     */
+    explicit RestProtocolRowsetWriterFactory(
+            bool compactRows = false, CompressionType compression = COMPRESSION_NONE) noexcept
+        : m_compactRows(compactRows)
+        , m_compression(compression)
+    {
+    }
+
     /**
      * Creates new rowset writer object.
      * @param connection Client connection stream.
      * @return New rowset writer object.
      */
     std::unique_ptr<RowsetWriter> createRowsetWriter(siodb::io::OutputStream& connection) override;
+
+private:
+    /** Indication that rows are written as arrays of values */
+    const bool m_compactRows;
+
+    /** JSON payload compression */
+    const CompressionType m_compression;
 };
 
 }  // namespace siodb::iomgr::dbengine
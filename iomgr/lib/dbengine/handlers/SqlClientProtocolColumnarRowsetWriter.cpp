@@ -0,0 +1,238 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "SqlClientProtocolColumnarRowsetWriter.h"
+
+// Project headers
+#include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "RequestHandlerSharedConstants.h"
+#include "../ThrowDatabaseError.h"
+
+// Common project headers
+#include <siodb/common/protobuf/ProtobufMessageIO.h>
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+#include <siodb/iomgr/shared/dbengine/ColumnDataType.h>
+
+// STL headers
+#include <algorithm>
+
+namespace siodb::iomgr::dbengine {
+
+namespace {
+
+/**
+ * Appends LOB contents to the buffer.
+ * @param lob LOB stream.
+ * @param buffer Destination buffer.
+ */
+void appendLob(LobStream& lob, std::vector<std::uint8_t>& buffer)
+{
+    const auto size = lob.getRemainingSize();
+    auto pos = buffer.size();
+    buffer.resize(pos + size);
+    while (pos < buffer.size()) {
+        const auto n = lob.read(
+                buffer.data() + pos, std::min<std::size_t>(buffer.size() - pos, kLobChunkSize));
+        if (n < 1) break;
+        pos += n;
+    }
+    buffer.resize(pos);
+}
+
+}  // anonymous namespace
+
+SqlClientProtocolColumnarRowsetWriter::SqlClientProtocolColumnarRowsetWriter(
+        siodb::io::OutputStream& connection, std::size_t batchSize)
+    : m_rawOutput(connection, m_errorChecker)
+    , m_codedOutput(&m_rawOutput)
+    , m_batchSize(std::max(batchSize, static_cast<std::size_t>(1)))
+    , m_rowCount(0)
+{
+}
+
+void SqlClientProtocolColumnarRowsetWriter::beginRowset(
+        iomgr_protocol::DatabaseEngineResponse& response, [[maybe_unused]] bool haveRows)
+{
+    m_columns.clear();
+    m_columns.reserve(response.column_description_size());
+    for (const auto& columnDescription : response.column_description()) {
+        const auto dataType = columnDescription.type();
+        if (!isSupportedDataType(dataType)) {
+            throwDatabaseError(IOManagerMessageId::kErrorColumnarRowsetUnsupportedDataType,
+                    getColumnDataTypeName(dataType), columnDescription.name());
+        }
+        ColumnBuffer column;
+        column.m_dataType = dataType;
+        column.m_nullable = columnDescription.is_nullable();
+        column.m_valueSize = getValueSize(dataType);
+        if (column.m_nullable) column.m_validity.reserve((m_batchSize + 7) / 8);
+        if (column.m_valueSize > 0)
+            column.m_values.reserve(m_batchSize * column.m_valueSize);
+        else
+            column.m_offsets.reserve((m_batchSize + 1) * sizeof(std::uint32_t));
+        resetColumnBuffer(column);
+        m_columns.push_back(std::move(column));
+    }
+    m_rowCount = 0;
+
+    response.set_rowset_format(ROWSET_FORMAT_COLUMNAR);
+    protobuf::writeMessage(protobuf::ProtocolMessageType::kDatabaseEngineResponse, response,
+            m_rawOutput, m_codedOutput);
+}
+
+void SqlClientProtocolColumnarRowsetWriter::endRowset()
+{
+    if (m_rowCount > 0) flushBatch();
+    m_codedOutput.WriteVarint64(kNoMoreRows);
+    m_rawOutput.CheckNoError();
+}
+
+void SqlClientProtocolColumnarRowsetWriter::writeRow(
+        const std::vector<Variant>& values, const stdext::bitmask& nullMask)
+{
+    const auto columnCount = std::min(values.size(), m_columns.size());
+    std::size_t dataSize = 0;
+    for (std::size_t i = 0; i < columnCount; ++i) {
+        const bool isNull = values[i].isNull() || (!nullMask.empty() && nullMask.get(i));
+        appendValue(m_columns[i], values[i], isNull);
+        dataSize = std::max(dataSize, m_columns[i].m_values.size());
+    }
+    // Variable size values may make batch too large, so flush it earlier in such case
+    if (++m_rowCount == m_batchSize || dataSize >= kMaxColumnarRowsetBatchDataSize) flushBatch();
+}
+
+// --- internals ---
+
+void SqlClientProtocolColumnarRowsetWriter::appendValue(
+        ColumnBuffer& column, const Variant& value, bool isNull)
+{
+    if (column.m_nullable && !isNull)
+        column.m_validity[m_rowCount >> 3] |= static_cast<std::uint8_t>(1U << (m_rowCount & 7));
+
+    if (column.m_valueSize > 0) {
+        const auto pos = column.m_values.size();
+        column.m_values.resize(pos + column.m_valueSize, 0);
+        if (isNull) return;
+        auto buffer = column.m_values.data() + pos;
+        switch (column.m_dataType) {
+            case COLUMN_DATA_TYPE_BOOL: *buffer = value.asBool() ? 1 : 0; break;
+            case COLUMN_DATA_TYPE_INT8: *buffer = value.asInt8(); break;
+            case COLUMN_DATA_TYPE_UINT8: *buffer = value.asUInt8(); break;
+            case COLUMN_DATA_TYPE_INT16: ::pbeEncodeInt16(value.asInt16(), buffer); break;
+            case COLUMN_DATA_TYPE_UINT16: ::pbeEncodeUInt16(value.asUInt16(), buffer); break;
+            case COLUMN_DATA_TYPE_INT32: ::pbeEncodeInt32(value.asInt32(), buffer); break;
+            case COLUMN_DATA_TYPE_UINT32: ::pbeEncodeUInt32(value.asUInt32(), buffer); break;
+            case COLUMN_DATA_TYPE_INT64: ::pbeEncodeInt64(value.asInt64(), buffer); break;
+            case COLUMN_DATA_TYPE_UINT64: ::pbeEncodeUInt64(value.asUInt64(), buffer); break;
+            case COLUMN_DATA_TYPE_FLOAT: ::pbeEncodeFloat(value.asFloat(), buffer); break;
+            case COLUMN_DATA_TYPE_DOUBLE: ::pbeEncodeDouble(value.asDouble(), buffer); break;
+            case COLUMN_DATA_TYPE_TIMESTAMP: value.asDateTime().serialize(buffer); break;
+            default: break;
+        }
+        return;
+    }
+
+    if (!isNull) {
+        auto& data = column.m_values;
+        switch (value.getValueType()) {
+            case VariantType::kString: {
+                const auto& s = value.getString();
+                data.insert(data.end(), s.cbegin(), s.cend());
+                break;
+            }
+            case VariantType::kBinary: {
+                const auto& b = value.getBinary();
+                data.insert(data.end(), b.cbegin(), b.cend());
+                break;
+            }
+            case VariantType::kClob: {
+                std::unique_ptr<ClobStream> clob(value.getClob().clone());
+                appendLob(*clob, data);
+                break;
+            }
+            case VariantType::kBlob: {
+                std::unique_ptr<BlobStream> blob(value.getBlob().clone());
+                appendLob(*blob, data);
+                break;
+            }
+            default: {
+                if (column.m_dataType == COLUMN_DATA_TYPE_TEXT) {
+                    const auto s = value.asString();
+                    data.insert(data.end(), s->cbegin(), s->cend());
+                } else {
+                    const auto b = value.asBinary();
+                    data.insert(data.end(), b->cbegin(), b->cend());
+                }
+                break;
+            }
+        }
+    }
+
+    const auto pos = column.m_offsets.size();
+    column.m_offsets.resize(pos + sizeof(std::uint32_t));
+    ::pbeEncodeUInt32(static_cast<std::uint32_t>(column.m_values.size()),
+            column.m_offsets.data() + pos);
+}
+
+void SqlClientProtocolColumnarRowsetWriter::flushBatch()
+{
+    const std::size_t validitySize = (m_rowCount + 7) / 8;
+    std::uint64_t batchLength =
+            google::protobuf::io::CodedOutputStream::VarintSize32(m_rowCount);
+    for (const auto& column : m_columns) {
+        batchLength += (column.m_nullable ? validitySize : 0) + column.m_offsets.size()
+                       + column.m_values.size();
+    }
+
+    m_codedOutput.WriteVarint64(batchLength);
+    m_codedOutput.WriteVarint32(m_rowCount);
+    m_rawOutput.CheckNoError();
+
+    for (auto& column : m_columns) {
+        if (column.m_nullable) m_codedOutput.WriteRaw(column.m_validity.data(), validitySize);
+        if (!column.m_offsets.empty())
+            m_codedOutput.WriteRaw(column.m_offsets.data(), column.m_offsets.size());
+        if (!column.m_values.empty())
+            m_codedOutput.WriteRaw(column.m_values.data(), column.m_values.size());
+        m_rawOutput.CheckNoError();
+    }
+
+    m_rowCount = 0;
+    for (auto& column : m_columns)
+        resetColumnBuffer(column);
+}
+
+void SqlClientProtocolColumnarRowsetWriter::resetColumnBuffer(ColumnBuffer& column)
+{
+    if (column.m_nullable) column.m_validity.assign((m_batchSize + 7) / 8, 0);
+    column.m_values.clear();
+    if (column.m_valueSize == 0) column.m_offsets.assign(sizeof(std::uint32_t), 0);
+}
+
+std::size_t SqlClientProtocolColumnarRowsetWriter::getValueSize(ColumnDataType dataType) noexcept
+{
+    switch (dataType) {
+        case COLUMN_DATA_TYPE_BOOL:
+        case COLUMN_DATA_TYPE_INT8:
+        case COLUMN_DATA_TYPE_UINT8: return 1;
+        case COLUMN_DATA_TYPE_INT16:
+        case COLUMN_DATA_TYPE_UINT16: return 2;
+        case COLUMN_DATA_TYPE_INT32:
+        case COLUMN_DATA_TYPE_UINT32:
+        case COLUMN_DATA_TYPE_FLOAT: return 4;
+        case COLUMN_DATA_TYPE_INT64:
+        case COLUMN_DATA_TYPE_UINT64:
+        case COLUMN_DATA_TYPE_DOUBLE: return 8;
+        case COLUMN_DATA_TYPE_TIMESTAMP: return RawDateTime::kSerializedSize;
+        default: return 0;
+    }
+}
+
+bool SqlClientProtocolColumnarRowsetWriter::isSupportedDataType(ColumnDataType dataType) noexcept
+{
+    return getValueSize(dataType) > 0 || dataType == COLUMN_DATA_TYPE_TEXT
+           || dataType == COLUMN_DATA_TYPE_BINARY;
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,125 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "RowsetWriter.h"
+
+// Project common headers
+#include <siodb/common/proto/ColumnDataType.pb.h>
+#include <siodb/common/protobuf/ExtendedCodedOutputStream.h>
+#include <siodb/common/protobuf/StreamOutputStream.h>
+
+namespace siodb::iomgr::dbengine {
+
+/**
+ * An object for outputting a rowset to a client connection stream
+ * as series of columnar record batches.
+ */
+class SqlClientProtocolColumnarRowsetWriter : public RowsetWriter {
+public:
+    /**
+     * Initializes object of class SqlClientProtocolColumnarRowsetWriter.
+     * @param connection Client connection.
+     * @param batchSize Maximum number of rows in the single record batch.
+     */
+    SqlClientProtocolColumnarRowsetWriter(
+            siodb::io::OutputStream& connection, std::size_t batchSize);
+
+    /**
+     * Begins a rowset.
+     * @param response Database engine response.
+     * @param haveRows Indication that there are rows in the respose.
+     * @throw DatabaseError if some column has data type not supported by the columnar format.
+     */
+    void beginRowset(iomgr_protocol::DatabaseEngineResponse& response, bool haveRows) override;
+
+    /**
+     * Ends a rowset.
+     */
+    void endRowset() override;
+
+    /**
+     * Writes a row.
+     * @param values A values to write.
+     * @param nullMask Null values bitmask.
+     */
+    void writeRow(const std::vector<Variant>& values, const stdext::bitmask& nullMask) override;
+
+private:
+    /** Column data accumulated for the current batch */
+    struct ColumnBuffer {
+        /** Column data type */
+        ColumnDataType m_dataType;
+
+        /** Indication that column can have null values */
+        bool m_nullable;
+
+        /** Value size for fixed size types, 0 for the variable size types */
+        std::size_t m_valueSize;
+
+        /** Validity bitmap */
+        std::vector<std::uint8_t> m_validity;
+
+        /** Offsets of the variable size values */
+        std::vector<std::uint8_t> m_offsets;
+
+        /** Values */
+        std::vector<std::uint8_t> m_values;
+    };
+
+private:
+    /**
+     * Appends value to the column buffer.
+     * @param column Column buffer.
+     * @param value A value.
+     * @param isNull Indication that value is null.
+     */
+    void appendValue(ColumnBuffer& column, const Variant& value, bool isNull);
+
+    /** Writes accumulated rows as record batch and resets column buffers. */
+    void flushBatch();
+
+    /**
+     * Clears column buffer for the next batch.
+     * @param column Column buffer.
+     */
+    void resetColumnBuffer(ColumnBuffer& column);
+
+    /**
+     * Returns size of a single value in the column buffer.
+     * @param dataType Column data type.
+     * @return Value size for fixed size types, 0 for the variable size types.
+     */
+    static std::size_t getValueSize(ColumnDataType dataType) noexcept;
+
+    /**
+     * Returns indication that data type is supported by the columnar format.
+     * @param dataType Column data type.
+     * @return true if data type is supported, false otherwise.
+     */
+    static bool isSupportedDataType(ColumnDataType dataType) noexcept;
+
+private:
+    /** Error checker object */
+    utils::DefaultErrorCodeChecker m_errorChecker;
+
+    /** Raw data output stream */
+    protobuf::StreamOutputStream m_rawOutput;
+
+    /** Coded output stream */
+    protobuf::ExtendedCodedOutputStream m_codedOutput;
+
+    /** Maximum number of rows in the batch */
+    const std::size_t m_batchSize;
+
+    /** Number of rows in the current batch */
+    std::size_t m_rowCount;
+
+    /** Column buffers */
+    std::vector<ColumnBuffer> m_columns;
+};
+
+}  // namespace siodb::iomgr::dbengine
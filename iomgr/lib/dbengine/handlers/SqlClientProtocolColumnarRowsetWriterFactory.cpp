@@ -0,0 +1,19 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "SqlClientProtocolColumnarRowsetWriterFactory.h"
+
+// Project headers
+#include "SqlClientProtocolColumnarRowsetWriter.h"
+
+namespace siodb::iomgr::dbengine {
+
+std::unique_ptr<RowsetWriter> SqlClientProtocolColumnarRowsetWriterFactory::createRowsetWriter(
+        siodb::io::OutputStream& connection)
+{
+    auto p = std::make_unique<SqlClientProtocolColumnarRowsetWriter>(connection, m_batchSize);
+    return std::unique_ptr<RowsetWriter>(p.release());
+}
+
+}  // namespace siodb::iomgr::dbengine
@@ -0,0 +1,41 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "RequestHandlerSharedConstants.h"
+#include "RowsetWriterFactory.h"
+
+namespace siodb::iomgr::dbengine {
+
+/**
+ * An abstract factory implemntation for creating rowset writer objects
+ * of class SqlClientProtocolColumnarRowsetWriter.
+ */
+class SqlClientProtocolColumnarRowsetWriterFactory : public RowsetWriterFactory {
+public:
+    /**
+     * Initializes object of class SqlClientProtocolColumnarRowsetWriterFactory.
+     * @param batchSize Maximum number of rows in the single record batch.
+     */
+    explicit SqlClientProtocolColumnarRowsetWriterFactory(
+            std::size_t batchSize = kColumnarRowsetBatchSize) noexcept
+        : m_batchSize(batchSize)
+    {
+    }
+
+    /**
+     * Creates new rowset writer object.
+     * @param connection Client connection stream.
+     * @return New rowset writer object.
+     */
+    std::unique_ptr<RowsetWriter> createRowsetWriter(siodb::io::OutputStream& connection) override;
+
+private:
+    /** Maximum number of rows in the single record batch */
+    const std::size_t m_batchSize;
+};
+
+}  // namespace siodb::iomgr::dbengine
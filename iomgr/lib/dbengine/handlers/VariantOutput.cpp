@@ -20,6 +20,41 @@
 
 namespace siodb::iomgr::dbengine {
 
+namespace {
+
+/**
+ * Writes LOB contents into coded output stream. Data is read directly into
+ * the output buffer, intermediate buffer is used only when output buffer
+ * is not available.
+ * @param lob LOB stream.
+ * @param codedOutput Output stream.
+ */
+void writeLob(LobStream& lob, protobuf::ExtendedCodedOutputStream& codedOutput)
+{
+    auto size = lob.getRemainingSize();
+    codedOutput.WriteVarint32(size);
+    while (size > 0) {
+        void* data = nullptr;
+        int available = 0;
+        if (!codedOutput.GetDirectBufferPointer(&data, &available)) break;
+        const auto n = lob.read(data, std::min<std::size_t>(size, available));
+        if (n < 1) break;
+        codedOutput.Skip(n);
+        size -= n;
+    }
+    if (size == 0) return;
+
+    stdext::buffer<std::uint8_t> buffer(std::min(size, kLobChunkSize));
+    while (size > 0) {
+        auto chunkSize = std::min(size, kLobChunkSize);
+        chunkSize = lob.read(buffer.data(), chunkSize);
+        size -= chunkSize;
+        codedOutput.WriteRaw(buffer.data(), chunkSize);
+    }
+}
+
+}  // anonymous namespace
+
 std::uint64_t getVariantSerializedSize(const Variant& value)
 {
     switch (value.getValueType()) {
@@ -125,28 +160,12 @@ void writeVariant(const Variant& value, protobuf::ExtendedCodedOutputStream& cod
         }
         case VariantType::kClob: {
             std::unique_ptr<ClobStream> clob(value.getClob().clone());
-            auto size = clob->getRemainingSize();
-            stdext::buffer<std::uint8_t> buffer(std::min(size, kLobChunkSize));
-            codedOutput.WriteVarint32(size);
-            while (size > 0) {
-                auto chunkSize = std::min(size, kLobChunkSize);
-                chunkSize = clob->read(buffer.data(), chunkSize);
-                size -= chunkSize;
-                codedOutput.WriteRaw(buffer.data(), chunkSize);
-            }
+            writeLob(*clob, codedOutput);
             break;
         }
         case VariantType::kBlob: {
             std::unique_ptr<BlobStream> blob(value.getBlob().clone());
-            auto size = blob->getRemainingSize();
-            stdext::buffer<std::uint8_t> buffer(std::min(size, kLobChunkSize));
-            codedOutput.WriteVarint32(size);
-            while (size > 0) {
-                auto chunkSize = std::min(size, kLobChunkSize);
-                chunkSize = blob->read(buffer.data(), chunkSize);
-                size -= chunkSize;
-                codedOutput.WriteRaw(buffer.data(), chunkSize);
-            }
+            writeLob(*blob, codedOutput);
             break;
         }
         default: {
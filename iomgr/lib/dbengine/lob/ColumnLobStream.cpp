@@ -22,8 +22,8 @@ ColumnLobStream::ColumnLobStream(Column& column, const ColumnDataAddress& addr,
     , m_startingAddress(addr)
     , m_offsetInChunk(0)
     , m_blockId(m_startingAddress.getBlockId())
-    , m_offsetInBlock(m_column.loadLobChunkHeader(
-              m_startingAddress.getBlockId(), m_startingAddress.getOffset(), m_chunkHeader))
+    , m_offsetInBlock(m_column.loadLobChunkHeader(m_startingAddress.getBlockId(),
+              m_startingAddress.getOffset(), m_chunkHeader, m_block))
     , m_chunkId(1)
 {
     m_size = m_chunkHeader.m_remainingLobLength;
@@ -42,7 +42,7 @@ std::ptrdiff_t ColumnLobStream::readInternal(void* buffer, std::size_t bufferSiz
         const auto availableInChunk = m_chunkHeader.m_chunkLength - m_offsetInChunk;
         if (availableInChunk > 0) {
             const auto bytesToRead = std::min(availableInChunk, remainingBytes);
-            m_column.readData(m_blockId, m_offsetInBlock,
+            m_column.readData(*m_block, m_offsetInBlock,
                     static_cast<std::uint8_t*>(buffer) + bufferOffset, bytesToRead);
             m_offsetInBlock += bytesToRead;
             m_offsetInChunk += bytesToRead;
@@ -67,8 +67,9 @@ std::ptrdiff_t ColumnLobStream::readInternal(void* buffer, std::size_t bufferSiz
         // Be exception-safe in regard to internal state: commit chunk header
         // and related counters only after all checks passed.
         LobChunkHeader chunkHeader;
+        ColumnDataBlockPtr block;
         const auto newOffsetInBlock =
-                m_column.loadLobChunkHeader(m_blockId, m_offsetInBlock, chunkHeader);
+                m_column.loadLobChunkHeader(m_blockId, m_offsetInBlock, chunkHeader, block);
         if (chunkHeader.m_remainingLobLength != getRemainingSize()) {
             throwDatabaseError(IOManagerMessageId::kErrorInvalidLobChunkHeader,
                     m_column.getDatabaseName(), m_column.getTableName(), m_column.getName(),
@@ -96,6 +97,7 @@ std::ptrdiff_t ColumnLobStream::readInternal(void* buffer, std::size_t bufferSiz
 
         ++m_chunkId;
         m_chunkHeader = chunkHeader;
+        m_block = std::move(block);
         m_offsetInBlock = newOffsetInBlock;
         m_offsetInChunk = 0;
     }
@@ -105,8 +107,8 @@ void ColumnLobStream::doRewind()
 {
     m_offsetInChunk = 0;
     m_blockId = m_startingAddress.getBlockId();
-    m_offsetInBlock = m_column.loadLobChunkHeader(
-            m_startingAddress.getBlockId(), m_startingAddress.getOffset(), m_chunkHeader);
+    m_offsetInBlock = m_column.loadLobChunkHeader(m_startingAddress.getBlockId(),
+            m_startingAddress.getOffset(), m_chunkHeader, m_block);
     m_chunkId = 1;
 }
 
@@ -69,6 +69,12 @@ protected:
     /** Current block */
     std::uint64_t m_blockId;
 
+    /**
+     * Current block object. Holding it keeps block in the column block cache,
+     * so that chunk data is read without looking up block for every read.
+     */
+    ColumnDataBlockPtr m_block;
+
     /** Current offset in block */
     std::uint32_t m_offsetInBlock;
 
@@ -20,6 +20,7 @@ const char* g_DBEngineRequestTypeNames[static_cast<std::size_t>(DBEngineRequestT
         "Insert",
         "Update",
         "Delete",
+        "CopyFrom",
         "BeginTransaction",
         "kCommitTransaction",
         "RollbackTransaction",
@@ -27,6 +28,7 @@ const char* g_DBEngineRequestTypeNames[static_cast<std::size_t>(DBEngineRequestT
         "Release",
         "AttachDatabase",
         "DetachDatabase",
+        "BackupDatabase",
         "CreateDatabase",
         "DropDatabase",
         "RenameDatabase",
@@ -69,6 +71,8 @@ const char* g_DBEngineRequestTypeNames[static_cast<std::size_t>(DBEngineRequestT
         "RevokePermissionsForTrigger",
         "ShowDatabases",
         "ShowTables",
+        "ShowPermissions",
+        "ShowScrubState",
         "DescribeTable",
 
         // REST requests
@@ -16,6 +16,7 @@ enum class DBEngineRequestType {
     kInsert,
     kUpdate,
     kDelete,
+    kCopyFrom,
     kBeginTransaction,
     kCommitTransaction,
     kRollbackTransaction,
@@ -23,6 +24,7 @@ enum class DBEngineRequestType {
     kRelease,
     kAttachDatabase,
     kDetachDatabase,
+    kBackupDatabase,
     kCreateDatabase,
     kDropDatabase,
     kRenameDatabase,
@@ -66,6 +68,7 @@ enum class DBEngineRequestType {
     kShowDatabases,
     kShowTables,
     kShowPermissions,
+    kShowScrubState,
     kDescribeTable,
 
     // REST requests
@@ -8,6 +8,7 @@
 #include "DBEngineSqlRequest.h"
 
 // Common project headers
+#include <siodb/common/proto/CommonMessages.pb.h>
 #include <siodb/iomgr/shared/dbengine/Variant.h>
 
 namespace siodb::iomgr::dbengine::requests {
@@ -43,11 +44,16 @@ struct GetAllRowsRestRequest : public DBEngineRequest {
      * Initializes object of class GetAllRowsRestRequest.
      * @param database A database.
      * @param table A table.
+     * @param compactRows Indication that rows should be returned as arrays of values.
+     * @param compression Compression of the returned JSON payload.
      */
-    explicit GetAllRowsRestRequest(std::string&& database, std::string&& table) noexcept
+    GetAllRowsRestRequest(std::string&& database, std::string&& table, bool compactRows,
+            CompressionType compression) noexcept
         : DBEngineRequest(DBEngineRequestType::kRestGetAllRows)
         , m_database(std::move(database))
         , m_table(std::move(table))
+        , m_compactRows(compactRows)
+        , m_compression(compression)
     {
     }
 
@@ -56,6 +62,12 @@ struct GetAllRowsRestRequest : public DBEngineRequest {
 
     /** Table name */
     const std::string m_table;
+
+    /** Indication that rows should be returned as arrays of values */
+    const bool m_compactRows;
+
+    /** Compression of the returned JSON payload */
+    const CompressionType m_compression;
 };
 
 /** GET single row request */
@@ -187,15 +199,26 @@ struct GetSqlQueryRowsRestRequest : public DBEngineRequest {
     /**
      * Initializes object of class GetSqlQueryRowsRestRequest.
      * @param queries List of queries.
+     * @param compactRows Indication that rows should be returned as arrays of values.
+     * @param compression Compression of the returned JSON payload.
      */
-    explicit GetSqlQueryRowsRestRequest(const std::shared_ptr<SelectRequest>& query)
+    GetSqlQueryRowsRestRequest(const std::shared_ptr<SelectRequest>& query, bool compactRows,
+            CompressionType compression)
         : DBEngineRequest(DBEngineRequestType::kRestGetSqlQueryRows)
         , m_query(query)
+        , m_compactRows(compactRows)
+        , m_compression(compression)
     {
     }
 
     /** A query*/
     const std::shared_ptr<SelectRequest> m_query;
+
+    /** Indication that rows should be returned as arrays of values */
+    const bool m_compactRows;
+
+    /** Compression of the returned JSON payload */
+    const CompressionType m_compression;
 };
 
 }  // namespace siodb::iomgr::dbengine::requests
@@ -146,7 +146,8 @@ requests::DBEngineRequestPtr DBEngineRestRequestFactory::createGetAllRowsRequest
     boost::to_upper(components[1]);
 
     return std::make_shared<requests::GetAllRowsRestRequest>(
-            std::move(components[0]), std::move(components[1]));
+            std::move(components[0]), std::move(components[1]), msg.compact_rows(),
+            msg.compression());
 }
 
 requests::DBEngineRequestPtr DBEngineRestRequestFactory::createGetSingleRowRequest(
@@ -198,7 +199,8 @@ requests::DBEngineRequestPtr DBEngineRestRequestFactory::createSqlQueryRequest(
     if (request->m_requestType == requests::DBEngineRequestType::kSelect) {
         auto query = std::shared_ptr<requests::SelectRequest>(
                 request, static_cast<requests::SelectRequest*>(request.get()));
-        return std::make_shared<requests::GetSqlQueryRowsRestRequest>(query);
+        return std::make_shared<requests::GetSqlQueryRowsRestRequest>(
+                query, msg.compact_rows(), msg.compression());
     } else {
         throw DBEngineRequestFactoryError("SQL QUERY: Not a SELECT statement");
     }
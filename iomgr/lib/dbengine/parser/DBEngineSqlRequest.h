@@ -12,6 +12,7 @@
 #include "../UpdateUserTokenParameters.h"
 
 // Common project headers
+#include <siodb/common/io/ChunkedInputStream.h>
 #include <siodb/common/proto/ColumnDataType.pb.h>
 #include <siodb/common/utils/Uuid.h>
 #include <siodb/iomgr/shared/dbengine/ConstraintType.h>
@@ -222,6 +223,52 @@ struct InsertRequest : public DBEngineRequest {
     const std::vector<std::vector<ConstExpressionPtr>> m_values;
 };
 
+/** COPY FROM data formats */
+enum class CopyFromFormat {
+    /** Comma separated values, one row per line */
+    kCsv,
+
+    /** Rows serialized in the same way as row data sent to the client */
+    kBinary,
+};
+
+/** COPY FROM STDIN request */
+struct CopyFromRequest : public DBEngineRequest {
+    /**
+     * Initializes object of class CopyFromRequest.
+     * @param database Database name.
+     * @param table Table name.
+     * @param columns Column names.
+     * @param format Data format.
+     * @param input Data input stream.
+     */
+    CopyFromRequest(std::string&& database, std::string&& table, std::vector<std::string>&& columns,
+            CopyFromFormat format, siodb::io::ChunkedInputStream& input) noexcept
+        : DBEngineRequest(DBEngineRequestType::kCopyFrom)
+        , m_database(std::move(database))
+        , m_table(std::move(table))
+        , m_columns(std::move(columns))
+        , m_format(format)
+        , m_input(input)
+    {
+    }
+
+    /** Database name */
+    const std::string m_database;
+
+    /** Table name */
+    const std::string m_table;
+
+    /** Column names, may be empty. */
+    const std::vector<std::string> m_columns;
+
+    /** Data format */
+    const CopyFromFormat m_format;
+
+    /** Data input stream. Must remain valid until request is executed. */
+    siodb::io::ChunkedInputStream& m_input;
+};
+
 /** UPDATE request */
 struct UpdateRequest : public DBEngineRequest {
     /**
@@ -428,6 +475,27 @@ struct DetachDatabaseRequest : public DBEngineRequest {
     const bool m_ifExists;
 };
 
+/** BACKUP DATABASE request */
+struct BackupDatabaseRequest : public DBEngineRequest {
+    /**
+     * Initializes object of class BackupDatabaseRequest.
+     * @param database Database name.
+     * @param backupDir Backup directory.
+     */
+    BackupDatabaseRequest(std::string&& database, std::string&& backupDir) noexcept
+        : DBEngineRequest(DBEngineRequestType::kBackupDatabase)
+        , m_database(std::move(database))
+        , m_backupDir(std::move(backupDir))
+    {
+    }
+
+    /** Database name */
+    const std::string m_database;
+
+    /** Backup directory */
+    const std::string m_backupDir;
+};
+
 /** CREATE DATABASE request */
 struct CreateDatabaseRequest : public DBEngineRequest {
     /**
@@ -887,13 +955,15 @@ struct SetTableAttributesRequest : public DBEngineRequest {
      * @param database Database name.
      * @param table Table name.
      * @param nextTrid Next TRID attribute.
+     * @param rowTtl Row time to live attribute.
      */
     SetTableAttributesRequest(std::string&& database, std::string&& table,
-            std::optional<std::uint64_t>&& nextTrid) noexcept
+            std::optional<std::uint64_t>&& nextTrid, std::optional<std::uint64_t>&& rowTtl) noexcept
         : DBEngineRequest(DBEngineRequestType::kSetTableAttributes)
         , m_database(std::move(database))
         , m_table(std::move(table))
         , m_nextTrid(std::move(nextTrid))
+        , m_rowTtl(std::move(rowTtl))
     {
     }
 
@@ -905,6 +975,9 @@ struct SetTableAttributesRequest : public DBEngineRequest {
 
     /** Next TRID attribute */
     const std::optional<std::uint64_t> m_nextTrid;
+
+    /** Row time to live attribute, in seconds */
+    const std::optional<std::uint64_t> m_rowTtl;
 };
 
 /** ALTER TABLE ADD COLUMN request */
@@ -1556,6 +1629,15 @@ struct ShowTablesRequest : public DBEngineRequest {
     }
 };
 
+/** SHOW SCRUB STATE request */
+struct ShowScrubStateRequest : public DBEngineRequest {
+    /** Initializes object of class ShowScrubStateRequest */
+    ShowScrubStateRequest() noexcept
+        : DBEngineRequest(DBEngineRequestType::kShowScrubState)
+    {
+    }
+};
+
 /** REVOKE permissions for the table request */
 struct ShowPermissionsRequest : public DBEngineRequest {
     /** Initializes object of class DescribeTableRequest
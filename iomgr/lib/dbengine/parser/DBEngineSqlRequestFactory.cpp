@@ -21,6 +21,7 @@
 
 // Boost headers
 #include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/uuid/string_generator.hpp>
 
 // Protobuf message headers
@@ -116,8 +117,11 @@ requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createSqlRequest(
             return std::make_unique<requests::ShowDatabasesRequest>();
         case SiodbParser::RuleShow_tables_stmt:
             return std::make_unique<requests::ShowTablesRequest>();
+        case SiodbParser::RuleShow_scrub_state_stmt:
+            return std::make_unique<requests::ShowScrubStateRequest>();
         case SiodbParser::RuleDescribe_table_stmt: return createDescribeTableRequest(node);
         case SiodbParser::RuleInsert_stmt: return createInsertRequest(node);
+        case SiodbParser::RuleCopy_stmt: return createCopyFromRequest(node);
         case SiodbParser::RuleUpdate_stmt: return createUpdateRequest(node);
         case SiodbParser::RuleDelete_stmt: return createDeleteRequest(node);
         case SiodbParser::RuleBegin_stmt: return createBeginTransactionRequest(node);
@@ -127,6 +131,7 @@ requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createSqlRequest(
         case SiodbParser::RuleRelease_stmt: return createReleaseRequest(node);
         case SiodbParser::RuleAttach_stmt: return createAttachDatabaseRequest(node);
         case SiodbParser::RuleDetach_stmt: return createDetachDatabaseRequest(node);
+        case SiodbParser::RuleBackup_database_stmt: return createBackupDatabaseRequest(node);
         case SiodbParser::RuleCreate_database_stmt: return createCreateDatabaseRequest(node);
         case SiodbParser::RuleDrop_database_stmt: return createDropDatabaseRequest(node);
         case SiodbParser::RuleAlter_database_stmt: return createAlterDatabaseRequest(node);
@@ -354,6 +359,53 @@ requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createInsertRequest(
             std::move(database), std::move(table), std::move(columns), std::move(values));
 }
 
+requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createCopyFromRequest(
+        antlr4::tree::ParseTree* node)
+{
+    if (!m_input) throw DBEngineRequestFactoryError("COPY: missing data stream");
+
+    // Capture database ID
+    std::string database;
+    const auto databaseNameNode =
+            helpers::findTerminal(node, SiodbParser::RuleDatabase_name, SiodbParser::IDENTIFIER);
+    if (databaseNameNode) database = helpers::extractObjectName(databaseNameNode);
+
+    // Capture table ID
+    const auto tableNameNode =
+            helpers::findTerminal(node, SiodbParser::RuleTable_name, SiodbParser::IDENTIFIER);
+    if (!tableNameNode) throw DBEngineRequestFactoryError("COPY: missing table ID");
+    auto table = helpers::extractObjectName(tableNameNode);
+
+    // Capture column IDs and data format
+    std::vector<std::string> columns;
+    auto format = requests::CopyFromFormat::kCsv;
+    for (const auto e : node->children) {
+        switch (helpers::getNonTerminalType(e)) {
+            case SiodbParser::RuleColumn_name: {
+                const auto columnIdNode = helpers::findTerminal(e, SiodbParser::IDENTIFIER);
+                if (!columnIdNode) throw DBEngineRequestFactoryError("COPY: missing column ID");
+                columns.push_back(helpers::extractObjectName(columnIdNode));
+                break;
+            }
+            case SiodbParser::RuleCopy_format: {
+                const auto formatName =
+                        boost::to_upper_copy(helpers::getAnyNameText(e->children.at(0)));
+                if (formatName == "CSV")
+                    format = requests::CopyFromFormat::kCsv;
+                else if (formatName == "BINARY")
+                    format = requests::CopyFromFormat::kBinary;
+                else
+                    throw DBEngineRequestFactoryError("COPY: unsupported format " + formatName);
+                break;
+            }
+            default: break;
+        }
+    }
+
+    return std::make_unique<requests::CopyFromRequest>(
+            std::move(database), std::move(table), std::move(columns), format, *m_input);
+}
+
 requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createUpdateRequest(
         antlr4::tree::ParseTree* node)
 {
@@ -655,6 +707,29 @@ requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createDetachDatabaseRequ
     return std::make_unique<requests::DetachDatabaseRequest>(std::move(database), ifExists);
 }
 
+requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createBackupDatabaseRequest(
+        antlr4::tree::ParseTree* node)
+{
+    // Capture database ID
+    const auto databaseNameNode =
+            helpers::findTerminal(node, SiodbParser::RuleDatabase_name, SiodbParser::IDENTIFIER);
+    if (!databaseNameNode)
+        throw DBEngineRequestFactoryError("BACKUP DATABASE: missing database ID");
+    auto database = helpers::extractObjectName(databaseNameNode);
+
+    // Capture backup directory
+    const auto backupDirNode =
+            helpers::findTerminal(node, SiodbParser::RuleExpr, SiodbParser::STRING_LITERAL);
+    if (!backupDirNode)
+        throw DBEngineRequestFactoryError("BACKUP DATABASE: missing backup directory");
+    auto backupDir = helpers::unquoteString(backupDirNode->getText());
+    if (backupDir.empty())
+        throw DBEngineRequestFactoryError("BACKUP DATABASE: empty backup directory");
+
+    return std::make_unique<requests::BackupDatabaseRequest>(
+            std::move(database), std::move(backupDir));
+}
+
 requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createCreateDatabaseRequest(
         antlr4::tree::ParseTree* node)
 {
@@ -1047,7 +1122,7 @@ requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createSetTableAttributes
         throw DBEngineRequestFactoryError("ALTER TABLE SET ATTRIBUTES: missing table ID");
     auto table = helpers::extractObjectName(tableNameNode);
 
-    std::optional<std::uint64_t> nextTrid;
+    std::optional<std::uint64_t> nextTrid, rowTtl;
 
     const auto attrListNode = helpers::findNonTerminal(node, SiodbParser::RuleTable_attr_list);
     if (attrListNode == nullptr)
@@ -1068,13 +1143,26 @@ requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createSetTableAttributes
                 }
                 break;
             }
+            case SiodbParser::K_TTL: {
+                const auto value = attrNode->children.at(2)->getText();
+                try {
+                    size_t index = 0;
+                    rowTtl = std::stoull(value, &index, 10);
+                    if (index != value.length()) throw std::invalid_argument("parse error");
+                } catch (std::exception& ex) {
+                    throw DBEngineRequestFactoryError(
+                            "ALTER TABLE SET ATTRIBUTES: invalid integer value of the attribute "
+                            "TTL");
+                }
+                break;
+            }
             default:
                 throw DBEngineRequestFactoryError("ALTER TABLE SET ATTRIBUTES: invalid attribute");
         }
     }
 
     return std::make_unique<requests::SetTableAttributesRequest>(
-            std::move(database), std::move(table), std::move(nextTrid));
+            std::move(database), std::move(table), std::move(nextTrid), std::move(rowTtl));
 }
 
 requests::DBEngineRequestPtr DBEngineSqlRequestFactory::createAddColumnRequest(
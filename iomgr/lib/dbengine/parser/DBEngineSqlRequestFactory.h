@@ -21,9 +21,12 @@ public:
     /**
      * Initializes object of class DBEngineSqlRequestFactory.
      * @param parser Parser object.
+     * @param input Data input stream which follows the statement text, may be nullptr.
      */
-    explicit DBEngineSqlRequestFactory(SqlParser& parser) noexcept
+    explicit DBEngineSqlRequestFactory(
+            SqlParser& parser, siodb::io::ChunkedInputStream* input = nullptr) noexcept
         : m_parser(parser)
+        , m_input(input)
     {
     }
 
@@ -82,6 +85,13 @@ private:
      */
     requests::DBEngineRequestPtr createInsertRequest(antlr4::tree::ParseTree* node);
 
+    /**
+     * Creates COPY FROM request.
+     * @param node Parse tree node with SQL statement.
+     * @return COPY FROM request.
+     */
+    requests::DBEngineRequestPtr createCopyFromRequest(antlr4::tree::ParseTree* node);
+
     /**
      * Creates UPDATE request.
      * @param node Parse tree node with SQL statement.
@@ -145,6 +155,13 @@ private:
      */
     requests::DBEngineRequestPtr createDetachDatabaseRequest(antlr4::tree::ParseTree* node);
 
+    /**
+     * Creates BACKUP DATABASE request.
+     * @param node Parse tree node with SQL statement.
+     * @return BACKUP DATABASE request.
+     */
+    requests::DBEngineRequestPtr createBackupDatabaseRequest(antlr4::tree::ParseTree* node);
+
     /**
      * Creates CREATE DATABASE request.
      * @param node Parse tree node with SQL statement.
@@ -419,6 +436,9 @@ private:
     /** SQL parser object */
     SqlParser& m_parser;
 
+    /** Data input stream */
+    siodb::io::ChunkedInputStream* const m_input;
+
     /** Siodb data type map. */
     static const std::unordered_map<std::string, siodb::ColumnDataType> m_siodbDataTypeMap;
 };
@@ -49,10 +49,12 @@ sql_stmt: (K_EXPLAIN ( K_QUERY K_PLAN)?)? (
 		| alter_user_stmt
 		| analyze_stmt
 		| attach_stmt
+		| backup_database_stmt
 		| begin_stmt
 		| check_user_token_stmt
 		| commit_stmt
 		| compound_select_stmt
+		| copy_stmt
 		| create_database_stmt
 		| create_index_stmt
 		| create_table_stmt
@@ -92,6 +94,7 @@ sql_stmt: (K_EXPLAIN ( K_QUERY K_PLAN)?)? (
 		| select_stmt
 		| show_databases_stmt
 		| show_tables_stmt
+		| show_scrub_state_stmt
 		| show_user_permissions_stmt
 		| update_stmt
 		| update_stmt_limited
@@ -167,6 +170,8 @@ analyze_stmt: K_ANALYZE ( database_name | table_or_index_spec)?;
 
 attach_stmt: K_ATTACH K_DATABASE expr K_AS database_name;
 
+backup_database_stmt: K_BACKUP K_DATABASE database_name K_TO expr;
+
 begin_stmt:
 	K_BEGIN (K_DEFERRED | K_IMMEDIATE | K_EXCLUSIVE)? (
 		K_TRANSACTION transaction_name?
@@ -187,6 +192,13 @@ compound_select_stmt: (
 		K_LIMIT simple_expr (( K_OFFSET | ',') simple_expr)?
 	)?;
 
+copy_stmt:
+	K_COPY (database_name '.')? table_name (
+		'(' column_name (',' column_name)* ')'
+	)? K_FROM K_STDIN (K_WITH? K_FORMAT copy_format)?;
+
+copy_format: any_name;
+
 create_database_attr:
 	K_CIPHER_ID '=' simple_expr
 	| K_CIPHER_KEY_SEED '=' simple_expr
@@ -450,7 +462,7 @@ insert_stmt:
 		| K_DEFAULT K_VALUES
 	);
 
-table_attr: K_NEXT_TRID '=' NUMERIC_LITERAL;
+table_attr: K_NEXT_TRID '=' NUMERIC_LITERAL | K_TTL '=' NUMERIC_LITERAL;
 
 table_attr_list: table_attr (',' table_attr)*;
 
@@ -504,6 +516,8 @@ show_databases_stmt: K_SHOW ( K_DATABASES | K_DBS);
 
 show_tables_stmt: K_SHOW K_TABLES;
 
+show_scrub_state_stmt: K_SHOW K_SCRUB K_STATE;
+
 show_user_permissions_stmt:
 	K_SHOW K_PERMISSIONS (K_FOR user_name)?;
 
@@ -913,6 +927,7 @@ K_EXPIRATION_TIMESTAMP:
 	E X P I R A T I O N '_' T I M E S T A M P;
 K_NEXT_TRID: N E X T '_' T R I D;
 K_STATE: S T A T E;
+K_TTL: T T L;
 K_REAL_NAME: R E A L '_' N A M E;
 
 // http://www.sqlite.org/lang_keywords.html
@@ -932,6 +947,7 @@ K_AS: A S;
 K_ASC: A S C;
 K_ATTACH: A T T A C H;
 K_AUTOINCREMENT: A U T O I N C R E M E N T;
+K_BACKUP: B A C K U P;
 K_BEFORE: B E F O R E;
 K_BEGIN: B E G I N;
 K_BETWEEN: B E T W E E N;
@@ -945,6 +961,7 @@ K_COLUMN: C O L U M N;
 K_COMMIT: C O M M I T;
 K_CONFLICT: C O N F L I C T;
 K_CONSTRAINT: C O N S T R A I N T;
+K_COPY: C O P Y;
 K_CREATE: C R E A T E;
 K_CROSS: C R O S S;
 K_CURRENT_DATE: C U R R E N T '_' D A T E;
@@ -978,6 +995,7 @@ K_FAIL: F A I L;
 K_FALSE: F A L S E;
 K_FOR: F O R;
 K_FOREIGN: F O R E I G N;
+K_FORMAT: F O R M A T;
 K_FROM: F R O M;
 K_FULL: F U L L;
 K_GLOB: G L O B;
@@ -1038,9 +1056,11 @@ K_RIGHT: R I G H T;
 K_ROLLBACK: R O L L B A C K;
 K_ROW: R O W;
 K_SAVEPOINT: S A V E P O I N T;
+K_SCRUB: S C R U B;
 K_SELECT: S E L E C T;
 K_SET: S E T;
 K_SHOW: S H O W;
+K_STDIN: S T D I N;
 K_TABLE: T A B L E;
 K_TABLES: T A B L E S;
 K_TEMP: T E M P;
@@ -1083,6 +1103,7 @@ keyword:
 	| K_ASC
 	| K_ATTACH
 	| K_AUTOINCREMENT
+	| K_BACKUP
 	| K_BEFORE
 	| K_BEGIN
 	| K_BETWEEN
@@ -1096,6 +1117,7 @@ keyword:
 	| K_COMMIT
 	| K_CONFLICT
 	| K_CONSTRAINT
+	| K_COPY
 	| K_CREATE
 	| K_CROSS
 	| K_CURRENT_DATE
@@ -1127,6 +1149,7 @@ keyword:
 	| K_FALSE
 	| K_FOR
 	| K_FOREIGN
+	| K_FORMAT
 	| K_FROM
 	| K_FULL
 	| K_GLOB
@@ -1187,8 +1210,10 @@ keyword:
 	| K_ROLLBACK
 	| K_ROW
 	| K_SAVEPOINT
+	| K_SCRUB
 	| K_SELECT
 	| K_SET
+	| K_STDIN
 	| K_TABLE
 	| K_TEMP
 	| K_TEMPORARY
@@ -1222,6 +1247,7 @@ attribute:
 	| K_NEXT_TRID
 	| K_REAL_NAME
 	| K_STATE
+	| K_TTL
 	| K_UUID;
 
 IDENTIFIER:
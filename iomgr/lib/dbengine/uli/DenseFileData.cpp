@@ -0,0 +1,198 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "DenseFileData.h"
+
+// Common project headers
+#include <siodb/iomgr/shared/dbengine/io/NormalFile.h>
+
+namespace siodb::iomgr::dbengine::uli {
+
+DenseFileData::DenseFileData(UniqueLinearIndex& index, std::uint64_t fileId, io::FilePtr&& file)
+    : FileData(index, fileId, std::move(file))
+    , m_recordSize(m_index.getRecordSize())
+    , m_valueSize(m_index.getValueSize())
+    , m_recordCount(m_index.getNumberOfRecordsPerFile())
+    , m_recordsPerPage(std::max(kApproximatePageSize / m_recordSize, static_cast<std::size_t>(1)))
+    , m_pageSize(m_recordsPerPage * m_recordSize)
+    , m_mappedData(nullptr)
+    , m_unloadedPages((m_recordCount + m_recordsPerPage - 1) / m_recordsPerPage)
+    , m_occupancy(m_recordCount)
+{
+    // Plain file is mapped into memory as is. If mapping fails for some reason,
+    // fall back to reading pages, as done for encrypted files.
+    if (dynamic_cast<const io::NormalFile*>(m_file.get())) {
+        try {
+            m_mappedFile = std::make_unique<siodb::io::MemoryMappedFile>(
+                    m_file->getFD(), false, PROT_READ, 0, 0, m_index.getDataFileSize());
+            m_mappedData = static_cast<std::uint8_t*>(m_mappedFile->getMappingAddress())
+                           + UniqueLinearIndex::kIndexFileHeaderSize;
+        } catch (std::system_error&) {
+            // Use reading of the pages
+        }
+    }
+    if (!m_mappedData) m_pages.resize(m_unloadedPages.bit_size());
+
+    for (std::size_t i = 0; i < m_unloadedPages.bit_size(); ++i)
+        m_unloadedPages.set(i);
+}
+
+FileFormat DenseFileData::getFormat() const noexcept
+{
+    return FileFormat::kDense;
+}
+
+bool DenseFileData::isUsedRecordCountExact() const noexcept
+{
+    return m_unloadedPages.none();
+}
+
+std::optional<FileFormat> DenseFileData::getRewriteFormat() const noexcept
+{
+    if (isUsedRecordCountExact() && m_usedRecordCount < m_recordCount / kDenseFileMinFillDivisor)
+        return FileFormat::kSparse;
+    return std::nullopt;
+}
+
+const std::uint8_t* DenseFileData::findValue(std::uint64_t recordId)
+{
+    const auto record = getRecord(recordId);
+    switch (*record) {
+        case kRecordStateFree: return nullptr;
+        case kRecordStateExists1:
+        case kRecordStateExists2: return record + 1 + (*record - 1) * m_valueSize;
+        default: throwRecordCorrupted(recordId);
+    }
+}
+
+bool DenseFileData::insert(std::uint64_t recordId, const void* value)
+{
+    const auto record = getRecord(recordId);
+    if (*record != kRecordStateFree) return false;
+    const auto offset = recordId * m_recordSize;
+    updateData(offset + 1, value, m_valueSize);
+    updateRecordState(recordId, kRecordStateExists1);
+    ++m_usedRecordCount;
+    return true;
+}
+
+bool DenseFileData::update(std::uint64_t recordId, const void* value)
+{
+    const auto record = getRecord(recordId);
+    if (*record == kRecordStateFree) return false;
+    const std::uint8_t state =
+            (*record == kRecordStateExists1) ? kRecordStateExists2 : kRecordStateExists1;
+    const auto offset = recordId * m_recordSize;
+    updateData(offset + 1 + m_valueSize * (state - 1), value, m_valueSize);
+    updateRecordState(recordId, state);
+    return true;
+}
+
+bool DenseFileData::erase(std::uint64_t recordId)
+{
+    const auto record = getRecord(recordId);
+    if (*record == kRecordStateFree) return false;
+    updateRecordState(recordId, kRecordStateFree);
+    --m_usedRecordCount;
+    return true;
+}
+
+std::uint64_t DenseFileData::findNextUsedRecord(std::uint64_t recordId)
+{
+    while (true) {
+        const auto usedRecordId = m_occupancy.find_next(recordId);
+        // Used record may be also in the unloaded page before found record
+        const auto pageIndex = m_unloadedPages.find_next(recordId / m_recordsPerPage);
+        if (pageIndex == stdext::hierarchical_bitmask::npos
+                || (usedRecordId != kNoRecord && pageIndex * m_recordsPerPage > usedRecordId))
+            return usedRecordId;
+        doLoadPage(pageIndex);
+    }
+}
+
+std::uint64_t DenseFileData::findPreviousUsedRecord(std::uint64_t recordId)
+{
+    while (true) {
+        const auto usedRecordId = m_occupancy.find_previous(recordId);
+        // Used record may be also in the unloaded page after found record
+        const auto pageIndex = m_unloadedPages.find_previous(recordId / m_recordsPerPage);
+        if (pageIndex == stdext::hierarchical_bitmask::npos
+                || (usedRecordId != kNoRecord
+                        && (pageIndex + 1) * m_recordsPerPage <= usedRecordId))
+            return usedRecordId;
+        doLoadPage(pageIndex);
+    }
+}
+
+stdext::buffer<std::uint8_t> DenseFileData::makeData(UniqueLinearIndex& index, FileData& source)
+{
+    const auto recordSize = index.getRecordSize();
+    const auto valueSize = index.getValueSize();
+    stdext::buffer<std::uint8_t> data(
+            index.getDataFileSize() - UniqueLinearIndex::kIndexFileHeaderSize, 0);
+    for (auto recordId = source.findNextUsedRecord(0); recordId != kNoRecord;
+            recordId = source.findNextUsedRecord(recordId + 1)) {
+        const auto record = data.data() + recordId * recordSize;
+        *record = kRecordStateExists1;
+        std::memcpy(record + 1, source.findValue(recordId), valueSize);
+    }
+    return data;
+}
+
+// --- internals ---
+
+void DenseFileData::updateData(std::size_t pos, const void* src, std::size_t size)
+{
+    // Memory mapped data is updated by the write itself. Otherwise, update
+    // loaded pages, unloaded ones will receive new data when loaded.
+    if (!m_mappedData) {
+        auto data = static_cast<const std::uint8_t*>(src);
+        auto pagePos = pos;
+        auto remainingSize = size;
+        while (remainingSize > 0) {
+            const auto pageIndex = pagePos / m_pageSize;
+            const auto offsetInPage = pagePos % m_pageSize;
+            const auto n = std::min(remainingSize, m_pageSize - offsetInPage);
+            const auto& page = m_pages[pageIndex];
+            if (page) std::memcpy(page.get() + offsetInPage, data, n);
+            data += n;
+            pagePos += n;
+            remainingSize -= n;
+        }
+    }
+    writeData(static_cast<const std::uint8_t*>(src), size, pos);
+}
+
+void DenseFileData::updateRecordState(std::uint64_t recordId, std::uint8_t state)
+{
+    updateData(recordId * m_recordSize, &state, 1);
+    if (state != kRecordStateFree)
+        m_occupancy.set(recordId);
+    else
+        m_occupancy.reset(recordId);
+}
+
+std::uint8_t* DenseFileData::doLoadPage(std::size_t pageIndex)
+{
+    const auto recordCount = getPageRecordCount(pageIndex);
+    if (!m_mappedData) {
+        auto page = std::make_unique<std::uint8_t[]>(m_pageSize);
+        readData(page.get(), recordCount * m_recordSize, pageIndex * m_pageSize);
+        m_pages[pageIndex] = std::move(page);
+    }
+
+    const auto page = getPage(pageIndex);
+    const auto firstRecordId = pageIndex * m_recordsPerPage;
+    auto record = page;
+    for (std::size_t i = 0; i < recordCount; ++i, record += m_recordSize) {
+        if (*record != kRecordStateFree) {
+            m_occupancy.set(firstRecordId + i);
+            ++m_usedRecordCount;
+        }
+    }
+    m_unloadedPages.reset(pageIndex);
+    return page;
+}
+
+}  // namespace siodb::iomgr::dbengine::uli
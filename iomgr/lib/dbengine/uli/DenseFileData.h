@@ -0,0 +1,239 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "FileData.h"
+
+// Common project headers
+#include <siodb/common/io/MemoryMappedFile.h>
+#include <siodb/common/stl_ext/buffer.h>
+
+// STL headers
+#include <vector>
+
+namespace siodb::iomgr::dbengine::uli {
+
+/**
+ * Linear index file with a slot for each key in the file key range.
+ * Plain files are memory mapped and paged in by the OS on demand. Encrypted files
+ * are read and decrypted page by page on the first access to a page. In both cases,
+ * occupancy of the records is collected only for the pages that were accessed.
+ */
+class DenseFileData final : public FileData {
+public:
+    /** Approximate page size. Actual page size is a whole number of records. */
+    static constexpr std::size_t kApproximatePageSize = 64 * 1024;
+
+public:
+    /**
+     * Initializes object of class DenseFileData.
+     * @param index Owner index object.
+     * @param fileId File ID.
+     * @param file File object.
+     */
+    DenseFileData(UniqueLinearIndex& index, std::uint64_t fileId, io::FilePtr&& file);
+
+    /**
+     * Returns indication that file is memory mapped.
+     * @return true if file is memory mapped, false otherwise.
+     */
+    bool isMapped() const noexcept
+    {
+        return m_mappedFile != nullptr;
+    }
+
+    /**
+     * Returns file format.
+     * @return File format.
+     */
+    FileFormat getFormat() const noexcept override;
+
+    /**
+     * Returns indication that number of used records is exact.
+     * @return true if all pages were loaded, false otherwise.
+     */
+    bool isUsedRecordCountExact() const noexcept override;
+
+    /**
+     * Returns format in which file should be rewritten.
+     * @return Sparse format if used record count is known and it is low enough,
+     *         otherwise nothing.
+     */
+    std::optional<FileFormat> getRewriteFormat() const noexcept override;
+
+    /**
+     * Finds value of a record. Loads page containing record, if required.
+     * @param recordId Record ID.
+     * @return Value address or nullptr if record is not used.
+     * @throw DatabaseError if read from file fails or record is corrupted.
+     */
+    const std::uint8_t* findValue(std::uint64_t recordId) override;
+
+    /**
+     * Stores value to a free record.
+     * @param recordId Record ID.
+     * @param value Value.
+     * @return true if value was stored, false if record is already used.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool insert(std::uint64_t recordId, const void* value) override;
+
+    /**
+     * Replaces value of a used record. New value is written to the alternate
+     * value slot of the record, then record state is switched to it.
+     * @param recordId Record ID.
+     * @param value New value.
+     * @return true if value was replaced, false if record is free.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool update(std::uint64_t recordId, const void* value) override;
+
+    /**
+     * Marks record as free.
+     * @param recordId Record ID.
+     * @return true if record was used, false otherwise.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool erase(std::uint64_t recordId) override;
+
+    /**
+     * Finds first used record at or after a given record.
+     * Loads pages which may contain such record.
+     * @param recordId Record ID.
+     * @return Record ID of the found record or kNoRecord if there is no such record.
+     * @throw DatabaseError if read from file fails.
+     */
+    std::uint64_t findNextUsedRecord(std::uint64_t recordId) override;
+
+    /**
+     * Finds last used record at or before a given record.
+     * Loads pages which may contain such record.
+     * @param recordId Record ID.
+     * @return Record ID of the found record or kNoRecord if there is no such record.
+     * @throw DatabaseError if read from file fails.
+     */
+    std::uint64_t findPreviousUsedRecord(std::uint64_t recordId) override;
+
+    /**
+     * Builds dense file data area containing all used records of another file.
+     * @param index Owner index object.
+     * @param source Source file.
+     * @return Data area contents.
+     * @throw DatabaseError if read from source file fails.
+     */
+    static stdext::buffer<std::uint8_t> makeData(UniqueLinearIndex& index, FileData& source);
+
+private:
+    /** Record state */
+    enum RecordState : std::uint8_t {
+        kRecordStateFree = 0,
+        kRecordStateExists1 = 1,
+        kRecordStateExists2 = 2,
+    };
+
+private:
+    /**
+     * Returns record address in the memory. Loads page containing record, if required.
+     * @param recordId Record ID.
+     * @return Record address.
+     * @throw DatabaseError if read from file fails.
+     */
+    const std::uint8_t* getRecord(std::uint64_t recordId)
+    {
+        return loadPage(recordId / m_recordsPerPage)
+               + (recordId % m_recordsPerPage) * m_recordSize;
+    }
+
+    /**
+     * Updates data in the memory and file.
+     * @param pos Position in the data area.
+     * @param src Source buffer address.
+     * @param size Data size.
+     * @throw DatabaseError if write to file fails.
+     */
+    void updateData(std::size_t pos, const void* src, std::size_t size);
+
+    /**
+     * Updates record state byte in the memory and file and maintains occupancy bitmap.
+     * Page containing record must be loaded.
+     * @param recordId Record ID.
+     * @param state New record state.
+     * @throw DatabaseError if write to file fails.
+     */
+    void updateRecordState(std::uint64_t recordId, std::uint8_t state);
+
+    /**
+     * Returns page address, loads page if it is not loaded yet.
+     * @param pageIndex Page index.
+     * @return Page address.
+     * @throw DatabaseError if read from file fails.
+     */
+    std::uint8_t* loadPage(std::size_t pageIndex)
+    {
+        return m_unloadedPages.get(pageIndex) ? doLoadPage(pageIndex) : getPage(pageIndex);
+    }
+
+    /**
+     * Loads page and collects record occupancy for it.
+     * @param pageIndex Page index.
+     * @return Page address.
+     * @throw DatabaseError if read from file fails.
+     */
+    std::uint8_t* doLoadPage(std::size_t pageIndex);
+
+    /**
+     * Returns address of a loaded page.
+     * @param pageIndex Page index.
+     * @return Page address.
+     */
+    std::uint8_t* getPage(std::size_t pageIndex) const noexcept
+    {
+        return m_mappedData ? m_mappedData + pageIndex * m_pageSize : m_pages[pageIndex].get();
+    }
+
+    /**
+     * Returns number of records in the page.
+     * @param pageIndex Page index.
+     * @return Number of records in the page.
+     */
+    std::size_t getPageRecordCount(std::size_t pageIndex) const noexcept
+    {
+        return std::min(m_recordsPerPage, m_recordCount - pageIndex * m_recordsPerPage);
+    }
+
+private:
+    /** Record size */
+    const std::size_t m_recordSize;
+
+    /** Value size */
+    const std::size_t m_valueSize;
+
+    /** Number of records in the file */
+    const std::size_t m_recordCount;
+
+    /** Number of records in the page */
+    const std::size_t m_recordsPerPage;
+
+    /** Page size */
+    const std::size_t m_pageSize;
+
+    /** Memory mapping of the plain index file */
+    std::unique_ptr<siodb::io::MemoryMappedFile> m_mappedFile;
+
+    /** Address of the data in the memory mapped file */
+    std::uint8_t* m_mappedData;
+
+    /** Pages of the encrypted index file, allocated on the first access */
+    std::vector<std::unique_ptr<std::uint8_t[]>> m_pages;
+
+    /** Bitmap of the pages which were not accessed yet */
+    stdext::hierarchical_bitmask m_unloadedPages;
+
+    /** Record occupancy bitmap, valid only for the loaded pages */
+    stdext::hierarchical_bitmask m_occupancy;
+};
+
+}  // namespace siodb::iomgr::dbengine::uli
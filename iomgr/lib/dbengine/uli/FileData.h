@@ -1,4 +1,4 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
@@ -6,12 +6,16 @@
 
 // Project headers
 #include "FileDataPtr.h"
+#include "FileFormat.h"
 #include "UniqueLinearIndex.h"
 
 // Common project headers
-#include <siodb/common/stl_ext/buffer.h>
+#include <siodb/common/stl_ext/hierarchical_bitmask.h>
 #include <siodb/iomgr/shared/dbengine/io/File.h>
 
+// STL headers
+#include <optional>
+
 namespace siodb::iomgr::dbengine {
 
 class UniqueLinearIndex;
@@ -20,68 +24,144 @@ class UniqueLinearIndex;
 
 namespace siodb::iomgr::dbengine::uli {
 
-/** Linear index file related data */
+/**
+ * Linear index file related data. Stores values for the records of a single file,
+ * record ID is key position in the file key range.
+ */
 class FileData {
-public:
+protected:
     /**
      * Initializes object of class FileData.
      * @param index Owner index object.
      * @param fileId File ID.
      * @param file File object.
      */
-    FileData(UniqueLinearIndex& index, std::uint64_t fileId, io::FilePtr&& file);
+    FileData(UniqueLinearIndex& index, std::uint64_t fileId, io::FilePtr&& file) noexcept
+        : m_index(index)
+        , m_fileId(fileId)
+        , m_file(std::move(file))
+        , m_usedRecordCount(0)
+    {
+    }
+
+public:
+    /** Value returned by record search functions when record is not found */
+    static constexpr std::uint64_t kNoRecord = stdext::hierarchical_bitmask::npos;
+
+    /** Sparse file is converted to dense one when more than 1/N of the records are used */
+    static constexpr std::size_t kSparseFileMaxFillDivisor = 16;
+
+    /** Dense file is converted to sparse one when less than 1/N of the records are used */
+    static constexpr std::size_t kDenseFileMinFillDivisor = 64;
+
+public:
+    /** De-initializes object of class FileData */
+    virtual ~FileData() = default;
 
     /**
-     * Returns mutable buffer address.
-     * @return Buffer address.
+     * Returns file format.
+     * @return File format.
      */
-    std::uint8_t* getBuffer() noexcept
-    {
-        return m_data.data();
-    }
+    virtual FileFormat getFormat() const noexcept = 0;
 
     /**
-     * Returns mutable buffer address.
-     * @return Buffer address.
+     * Returns number of used records known so far.
+     * @return Number of used records.
      */
-    const std::uint8_t* getBuffer() const noexcept
+    std::size_t getUsedRecordCount() const noexcept
     {
-        return m_data.data();
+        return m_usedRecordCount;
     }
 
     /**
-     * Calculates record offset in the memory.
-     * Assumes record belongs to this file.
-     * @param recordId Record identifier.
-     * @return Record offset in the file.
+     * Returns indication that number of used records is exact.
+     * @return true if all records were examined, false otherwise.
      */
-    std::size_t getRecordOffsetInMemory(std::uint64_t recordId) const noexcept
-    {
-        return (recordId % m_index.getNumberOfRecordsPerFile()) * m_index.getRecordSize();
-    }
+    virtual bool isUsedRecordCountExact() const noexcept = 0;
+
+    /**
+     * Returns format in which file should be rewritten, if rewrite is required.
+     * @return Format for rewrite or nothing if rewrite is not required.
+     */
+    virtual std::optional<FileFormat> getRewriteFormat() const noexcept = 0;
 
     /**
-     * Calculates record offset in the data file.
-     * Assumes record belongs to this file.
+     * Finds value of a record.
      * @param recordId Record ID.
-     * @return Record offset in the file.
+     * @return Value address or nullptr if record is not used.
+     * @throw DatabaseError if read from file fails or record is corrupted.
      */
-    off_t getRecordOffsetInFile(std::uint64_t recordId) const noexcept
-    {
-        return getRecordOffsetInMemory(recordId) + UniqueLinearIndex::kIndexFileHeaderSize;
-    }
+    virtual const std::uint8_t* findValue(std::uint64_t recordId) = 0;
+
+    /**
+     * Stores value to a free record.
+     * @param recordId Record ID.
+     * @param value Value.
+     * @return true if value was stored, false if record is already used.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    virtual bool insert(std::uint64_t recordId, const void* value) = 0;
 
     /**
-     * Updates data in the memory and file.
-     * @param pos Position in the memory buffer.
-     * @param src Source buffer address.
+     * Replaces value of a used record.
+     * @param recordId Record ID.
+     * @param value New value.
+     * @return true if value was replaced, false if record is free.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    virtual bool update(std::uint64_t recordId, const void* value) = 0;
+
+    /**
+     * Marks record as free.
+     * @param recordId Record ID.
+     * @return true if record was used, false otherwise.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    virtual bool erase(std::uint64_t recordId) = 0;
+
+    /**
+     * Finds first used record at or after a given record.
+     * @param recordId Record ID.
+     * @return Record ID of the found record or kNoRecord if there is no such record.
+     * @throw DatabaseError if read from file fails.
+     */
+    virtual std::uint64_t findNextUsedRecord(std::uint64_t recordId) = 0;
+
+    /**
+     * Finds last used record at or before a given record.
+     * @param recordId Record ID.
+     * @return Record ID of the found record or kNoRecord if there is no such record.
+     * @throw DatabaseError if read from file fails.
+     */
+    virtual std::uint64_t findPreviousUsedRecord(std::uint64_t recordId) = 0;
+
+protected:
+    /**
+     * Reads data from the file data area.
+     * @param buffer Output buffer.
      * @param size Data size.
-     * @throw std::out_of_range if combination of the destOffset and size is invalid.
-     * @throw DatabaseError if write to file fails.
+     * @param pos Position in the data area.
+     * @throw DatabaseError if read fails.
+     */
+    void readData(std::uint8_t* buffer, std::size_t size, std::size_t pos);
+
+    /**
+     * Writes data to the file data area.
+     * @param buffer Data buffer.
+     * @param size Data size.
+     * @param pos Position in the data area.
+     * @throw DatabaseError if write fails.
+     */
+    void writeData(const std::uint8_t* buffer, std::size_t size, std::size_t pos);
+
+    /**
+     * Throws exception about corrupted record.
+     * @param recordId Record ID.
+     * @throw DatabaseError always.
      */
-    void update(std::size_t pos, const void* src, std::size_t size);
+    [[noreturn]] void throwRecordCorrupted(std::uint64_t recordId) const;
 
-private:
+protected:
     /** Owner index object */
     UniqueLinearIndex& m_index;
 
@@ -91,8 +171,8 @@ private:
     /** Index file. */
     io::FilePtr m_file;
 
-    /** Index file data buffer */
-    stdext::buffer<std::uint8_t> m_data;
+    /** Number of used records known so far */
+    std::size_t m_usedRecordCount;
 };
 
 }  // namespace siodb::iomgr::dbengine::uli
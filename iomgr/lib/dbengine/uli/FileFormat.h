@@ -0,0 +1,21 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// CRT headers
+#include <cstdint>
+
+namespace siodb::iomgr::dbengine::uli {
+
+/** Layout of the data in the linear index file */
+enum class FileFormat : std::uint8_t {
+    /** Slot for each key in the file key range */
+    kDense = 0,
+
+    /** Sorted run of the existing keys only */
+    kSparse = 1,
+};
+
+}  // namespace siodb::iomgr::dbengine::uli
@@ -1,14 +1,16 @@
-# Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+# Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 # Use of this source code is governed by a license that can be found
 # in the LICENSE file.
 
 CXX_SRC+= \
+	uli/DenseFileData.cpp \
 	uli/FileCache.cpp \
 	uli/FileData.cpp \
 	uli/Int16UniqueLinearIndex.cpp \
 	uli/Int32UniqueLinearIndex.cpp \
 	uli/Int64UniqueLinearIndex.cpp \
 	uli/Int8UniqueLinearIndex.cpp \
+	uli/SparseFileData.cpp \
 	uli/UInt16UniqueLinearIndex.cpp \
 	uli/UInt32UniqueLinearIndex.cpp \
 	uli/UInt64UniqueLinearIndex.cpp \
@@ -16,13 +18,16 @@ CXX_SRC+= \
 	uli/UniqueLinearIndex.cpp
 
 CXX_HDR+= \
+	uli/DenseFileData.h \
 	uli/FileCache.h \
 	uli/FileData.h \
 	uli/FileDataPtr.h \
+	uli/FileFormat.h \
 	uli/Int16UniqueLinearIndex.h \
 	uli/Int32UniqueLinearIndex.h \
 	uli/Int64UniqueLinearIndex.h \
 	uli/Int8UniqueLinearIndex.h \
+	uli/SparseFileData.h \
 	uli/UInt16UniqueLinearIndex.h \
 	uli/UInt32UniqueLinearIndex.h \
 	uli/UInt64UniqueLinearIndex.h \
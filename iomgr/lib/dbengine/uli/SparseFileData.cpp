@@ -0,0 +1,180 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "SparseFileData.h"
+
+// Project headers
+#include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
+#include "../ThrowDatabaseError.h"
+
+// Common project headers
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// STL headers
+#include <map>
+
+namespace siodb::iomgr::dbengine::uli {
+
+SparseFileData::SparseFileData(UniqueLinearIndex& index, std::uint64_t fileId, io::FilePtr&& file)
+    : FileData(index, fileId, std::move(file))
+    , m_valueSize(m_index.getValueSize())
+    , m_entrySize(kEntryHeaderSize + m_valueSize)
+    , m_entryCount(0)
+{
+    const auto fileSize = m_file->getFileSize();
+    if (fileSize < 0) {
+        throwDatabaseError(IOManagerMessageId::kErrorCannotStatIndexFile,
+                m_index.getDatabaseName(), m_index.getTableName(), m_index.getName(),
+                m_file->getLastError(), std::strerror(m_file->getLastError()));
+    }
+
+    // Incomplete last entry is a result of the interrupted write, it is ignored
+    // and overwritten by the next write.
+    m_entryCount = (fileSize > UniqueLinearIndex::kIndexFileHeaderSize)
+                           ? (fileSize - UniqueLinearIndex::kIndexFileHeaderSize) / m_entrySize
+                           : 0;
+    stdext::buffer<std::uint8_t> log(m_entryCount * m_entrySize);
+    if (!log.empty()) readData(log.data(), log.size(), 0);
+
+    // Replay log. Map keeps latest value of each record.
+    const auto recordCount = m_index.getNumberOfRecordsPerFile();
+    std::map<std::uint32_t, const std::uint8_t*> records;
+    for (auto entry = log.data(), end = log.data() + log.size(); entry != end;
+            entry += m_entrySize) {
+        std::uint32_t recordId = 0;
+        ::pbeDecodeUInt32(entry, &recordId);
+        const auto entryType = entry[sizeof(std::uint32_t)];
+        if (recordId >= recordCount || entryType > kEntryTypeStore) {
+            std::ostringstream err;
+            err << "invalid sparse log entry #" << (entry - log.data()) / m_entrySize;
+            throwDatabaseError(IOManagerMessageId::kErrorIndexFileCorrupted,
+                    m_index.getDatabaseName(), m_index.getTableName(), m_index.getName(),
+                    m_index.getDatabaseUuid(), m_index.getTableId(), m_index.getId(), err.str());
+        }
+        if (entryType == kEntryTypeStore)
+            records[recordId] = entry + kEntryHeaderSize;
+        else
+            records.erase(recordId);
+    }
+
+    m_recordIds.reserve(records.size());
+    m_values.resize(records.size() * m_valueSize);
+    auto value = m_values.data();
+    for (const auto& record : records) {
+        m_recordIds.push_back(record.first);
+        std::memcpy(value, record.second, m_valueSize);
+        value += m_valueSize;
+    }
+    m_usedRecordCount = m_recordIds.size();
+}
+
+FileFormat SparseFileData::getFormat() const noexcept
+{
+    return FileFormat::kSparse;
+}
+
+bool SparseFileData::isUsedRecordCountExact() const noexcept
+{
+    return true;
+}
+
+std::optional<FileFormat> SparseFileData::getRewriteFormat() const noexcept
+{
+    if (m_usedRecordCount > m_index.getNumberOfRecordsPerFile() / kSparseFileMaxFillDivisor)
+        return FileFormat::kDense;
+    const auto staleEntryCount = m_entryCount - m_usedRecordCount;
+    if (staleEntryCount > kMinStaleEntryCountForCompaction && staleEntryCount > m_usedRecordCount)
+        return FileFormat::kSparse;
+    return std::nullopt;
+}
+
+const std::uint8_t* SparseFileData::findValue(std::uint64_t recordId)
+{
+    const auto pos = lowerBound(recordId);
+    return isRecordAt(pos, recordId) ? m_values.data() + pos * m_valueSize : nullptr;
+}
+
+bool SparseFileData::insert(std::uint64_t recordId, const void* value)
+{
+    const auto pos = lowerBound(recordId);
+    if (isRecordAt(pos, recordId)) return false;
+    appendEntry(kEntryTypeStore, recordId, value);
+    m_recordIds.insert(m_recordIds.begin() + pos, static_cast<std::uint32_t>(recordId));
+    const auto v = static_cast<const std::uint8_t*>(value);
+    m_values.insert(m_values.begin() + pos * m_valueSize, v, v + m_valueSize);
+    ++m_usedRecordCount;
+    return true;
+}
+
+bool SparseFileData::update(std::uint64_t recordId, const void* value)
+{
+    const auto pos = lowerBound(recordId);
+    if (!isRecordAt(pos, recordId)) return false;
+    appendEntry(kEntryTypeStore, recordId, value);
+    std::memcpy(m_values.data() + pos * m_valueSize, value, m_valueSize);
+    return true;
+}
+
+bool SparseFileData::erase(std::uint64_t recordId)
+{
+    const auto pos = lowerBound(recordId);
+    if (!isRecordAt(pos, recordId)) return false;
+    appendEntry(kEntryTypeErase, recordId, nullptr);
+    m_recordIds.erase(m_recordIds.begin() + pos);
+    const auto valuePos = m_values.begin() + pos * m_valueSize;
+    m_values.erase(valuePos, valuePos + m_valueSize);
+    --m_usedRecordCount;
+    return true;
+}
+
+std::uint64_t SparseFileData::findNextUsedRecord(std::uint64_t recordId)
+{
+    const auto pos = lowerBound(recordId);
+    return pos < m_recordIds.size() ? m_recordIds[pos] : kNoRecord;
+}
+
+std::uint64_t SparseFileData::findPreviousUsedRecord(std::uint64_t recordId)
+{
+    const auto it = std::upper_bound(m_recordIds.cbegin(), m_recordIds.cend(), recordId);
+    return it == m_recordIds.cbegin() ? kNoRecord : *(it - 1);
+}
+
+stdext::buffer<std::uint8_t> SparseFileData::makeData(UniqueLinearIndex& index, FileData& source)
+{
+    assert(source.isUsedRecordCountExact());
+    const auto valueSize = index.getValueSize();
+    const auto entrySize = kEntryHeaderSize + valueSize;
+    stdext::buffer<std::uint8_t> data(source.getUsedRecordCount() * entrySize);
+    auto entry = data.data();
+    for (auto recordId = source.findNextUsedRecord(0); recordId != kNoRecord;
+            recordId = source.findNextUsedRecord(recordId + 1)) {
+        entry = encodeEntry(
+                kEntryTypeStore, recordId, source.findValue(recordId), valueSize, entry);
+    }
+    return data;
+}
+
+// --- internals ---
+
+void SparseFileData::appendEntry(EntryType type, std::uint64_t recordId, const void* value)
+{
+    stdext::buffer<std::uint8_t> entry(m_entrySize);
+    encodeEntry(type, recordId, value, m_valueSize, entry.data());
+    writeData(entry.data(), entry.size(), m_entryCount * m_entrySize);
+    ++m_entryCount;
+}
+
+std::uint8_t* SparseFileData::encodeEntry(EntryType type, std::uint64_t recordId,
+        const void* value, std::size_t valueSize, std::uint8_t* buffer) noexcept
+{
+    buffer = ::pbeEncodeUInt32(static_cast<std::uint32_t>(recordId), buffer);
+    *buffer++ = type;
+    if (value)
+        std::memcpy(buffer, value, valueSize);
+    else
+        std::memset(buffer, 0, valueSize);
+    return buffer + valueSize;
+}
+
+}  // namespace siodb::iomgr::dbengine::uli
@@ -0,0 +1,184 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "FileData.h"
+
+// Common project headers
+#include <siodb/common/stl_ext/buffer.h>
+
+// STL headers
+#include <vector>
+
+namespace siodb::iomgr::dbengine::uli {
+
+/**
+ * Linear index file which stores existing keys only.
+ * Records are kept in memory as a run sorted by record ID. On disk, file data area
+ * is a log of fixed size entries, each entry either stores record value or marks record
+ * as free. Log is replayed when file is loaded.
+ */
+class SparseFileData final : public FileData {
+public:
+    /**
+     * Initializes object of class SparseFileData.
+     * @param index Owner index object.
+     * @param fileId File ID.
+     * @param file File object.
+     * @throw DatabaseError if read from file fails or file is corrupted.
+     */
+    SparseFileData(UniqueLinearIndex& index, std::uint64_t fileId, io::FilePtr&& file);
+
+    /**
+     * Returns file format.
+     * @return File format.
+     */
+    FileFormat getFormat() const noexcept override;
+
+    /**
+     * Returns indication that number of used records is exact.
+     * @return Always true.
+     */
+    bool isUsedRecordCountExact() const noexcept override;
+
+    /**
+     * Returns format in which file should be rewritten.
+     * @return Sparse format if log contains too many stale entries, dense format
+     *         if file is filled enough for dense format, otherwise nothing.
+     */
+    std::optional<FileFormat> getRewriteFormat() const noexcept override;
+
+    /**
+     * Finds value of a record.
+     * @param recordId Record ID.
+     * @return Value address or nullptr if record is not used.
+     */
+    const std::uint8_t* findValue(std::uint64_t recordId) override;
+
+    /**
+     * Stores value to a free record.
+     * @param recordId Record ID.
+     * @param value Value.
+     * @return true if value was stored, false if record is already used.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool insert(std::uint64_t recordId, const void* value) override;
+
+    /**
+     * Replaces value of a used record.
+     * @param recordId Record ID.
+     * @param value New value.
+     * @return true if value was replaced, false if record is free.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool update(std::uint64_t recordId, const void* value) override;
+
+    /**
+     * Marks record as free.
+     * @param recordId Record ID.
+     * @return true if record was used, false otherwise.
+     * @throw DatabaseError if I/O error occurs.
+     */
+    bool erase(std::uint64_t recordId) override;
+
+    /**
+     * Finds first used record at or after a given record.
+     * @param recordId Record ID.
+     * @return Record ID of the found record or kNoRecord if there is no such record.
+     */
+    std::uint64_t findNextUsedRecord(std::uint64_t recordId) override;
+
+    /**
+     * Finds last used record at or before a given record.
+     * @param recordId Record ID.
+     * @return Record ID of the found record or kNoRecord if there is no such record.
+     */
+    std::uint64_t findPreviousUsedRecord(std::uint64_t recordId) override;
+
+    /**
+     * Builds sparse file data area containing all used records of another file.
+     * @param index Owner index object.
+     * @param source Source file.
+     * @return Data area contents.
+     * @throw DatabaseError if read from source file fails.
+     */
+    static stdext::buffer<std::uint8_t> makeData(UniqueLinearIndex& index, FileData& source);
+
+private:
+    /** Log entry type */
+    enum EntryType : std::uint8_t {
+        kEntryTypeErase = 0,
+        kEntryTypeStore = 1,
+    };
+
+private:
+    /**
+     * Returns position of the record in the sorted run.
+     * @param recordId Record ID.
+     * @return Position of a first record with ID not less than given.
+     */
+    std::size_t lowerBound(std::uint64_t recordId) const noexcept
+    {
+        return std::lower_bound(m_recordIds.cbegin(), m_recordIds.cend(), recordId)
+               - m_recordIds.cbegin();
+    }
+
+    /**
+     * Returns indication that record exists at a given position of the sorted run.
+     * @param pos Position in the sorted run.
+     * @param recordId Record ID.
+     * @return true if record exists, false otherwise.
+     */
+    bool isRecordAt(std::size_t pos, std::uint64_t recordId) const noexcept
+    {
+        return pos < m_recordIds.size() && m_recordIds[pos] == recordId;
+    }
+
+    /**
+     * Appends entry to the log.
+     * @param type Entry type.
+     * @param recordId Record ID.
+     * @param value Value, nullptr for the erase entry.
+     * @throw DatabaseError if write to file fails.
+     */
+    void appendEntry(EntryType type, std::uint64_t recordId, const void* value);
+
+    /**
+     * Encodes log entry.
+     * @param type Entry type.
+     * @param recordId Record ID.
+     * @param value Value, nullptr for the erase entry.
+     * @param valueSize Value size.
+     * @param buffer Output buffer.
+     * @return Address after the last written byte.
+     */
+    static std::uint8_t* encodeEntry(EntryType type, std::uint64_t recordId, const void* value,
+            std::size_t valueSize, std::uint8_t* buffer) noexcept;
+
+private:
+    /** Value size */
+    const std::size_t m_valueSize;
+
+    /** Log entry size */
+    const std::size_t m_entrySize;
+
+    /** Sorted IDs of the used records */
+    std::vector<std::uint32_t> m_recordIds;
+
+    /** Values of the used records, in the same order as record IDs */
+    std::vector<std::uint8_t> m_values;
+
+    /** Number of entries in the log */
+    std::size_t m_entryCount;
+
+    /** Log entry header size: record ID and entry type */
+    static constexpr std::size_t kEntryHeaderSize = sizeof(std::uint32_t) + 1;
+
+    /** Stale log entry count after which log is compacted */
+    static constexpr std::size_t kMinStaleEntryCountForCompaction = 4096;
+};
+
+}  // namespace siodb::iomgr::dbengine::uli
@@ -6,9 +6,11 @@
 
 // Project headers
 #include <siodb-generated/iomgr/lib/messages/IOManagerMessageId.h>
-#include "FileData.h"
+#include "DenseFileData.h"
+#include "SparseFileData.h"
 #include "../DBEngineDebug.h"
 #include "../IndexColumn.h"
+#include "../Instance.h"
 #include "../ThrowDatabaseError.h"
 
 // Common project headers
@@ -88,6 +90,11 @@ std::uint32_t UniqueLinearIndex::getDataFileSize() const noexcept
     return m_dataFileSize;
 }
 
+uli::FileFormat UniqueLinearIndex::getFileFormat(std::uint64_t fileId)
+{
+    return findFileChecked(fileId)->getFormat();
+}
+
 bool UniqueLinearIndex::preallocate(const void* key)
 {
     const auto numericKey = decodeKey(key);
@@ -104,12 +111,11 @@ bool UniqueLinearIndex::insert(const void* key, const void* value)
     const auto fileId = getFileIdForKey(numericKey);
     auto file = findFile(fileId);
     if (!file) file = makeFile(fileId);
-    const auto offset = file->getRecordOffsetInMemory(numericKey);
-    const auto record = file->getBuffer() + offset;
-    const bool keyAbsent = (*record == kValueStateFree);
+    const auto recordId = numericKey % m_numberOfRecordsPerFile;
+    const bool keyAbsent = file->insert(recordId, value);
 
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": INSERT key=" << numericKey << " (fileId "
-                               << fileId << ", offset " << offset << ", key "
+                               << fileId << ", record " << recordId << ", key "
                                << (keyAbsent ? "doesn't exists" : "exists") << ')');
 
     //if (getTableName() == "SYS_COLUMN_DEF_CONSTRAINTS" && numericKey == 3) {
@@ -117,10 +123,7 @@ bool UniqueLinearIndex::insert(const void* key, const void* value)
     //}
 
     if (keyAbsent) {
-        // Update data
-        file->update(offset + 1, value, m_valueSize);
-        std::uint8_t state = kValueStateExists1;
-        file->update(offset, &state, 1);
+        rewriteFileIfRequired(fileId, *file);
 
         // Update min and max keys
         if (m_keyCompare(m_maxKey.data(), m_minKey.data()) < 0) {
@@ -146,22 +149,19 @@ std::uint64_t UniqueLinearIndex::erase(const void* key)
 {
     // Find record
     const auto numericKey = decodeKey(key);
-    auto file = findFile(getFileIdForKey(numericKey));
+    const auto fileId = getFileIdForKey(numericKey);
+    auto file = findFile(fileId);
     if (!file) return 0;
-    const auto offset = file->getRecordOffsetInMemory(numericKey);
-    const auto record = file->getBuffer() + offset;
-    const bool keyExists = *record != kValueStateFree;
+    const auto recordId = numericKey % m_numberOfRecordsPerFile;
+    const bool keyExists = file->erase(recordId);
 
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": DELETE key=" << numericKey << " (fileId "
-                               << fileId << ", offset " << offset << ", key "
-                               << (keyExists ? "doesn't exist" : "exists") << ')');
+                               << fileId << ", record " << recordId << ", key "
+                               << (keyExists ? "exists" : "doesn't exist") << ')');
 
     if (!keyExists) return 0;
 
-    // Mark record as free
-    std::uint8_t state = kValueStateFree;
-    file->update(offset, &state, 1);
-
+    rewriteFileIfRequired(fileId, *file);
     updateMinAndMaxKeysAfterRemoval(key);
 
     return 1;
@@ -170,25 +170,19 @@ std::uint64_t UniqueLinearIndex::erase(const void* key)
 std::uint64_t UniqueLinearIndex::update(const void* key, const void* value)
 {
     const auto numericKey = decodeKey(key);
-    auto file = findFile(getFileIdForKey(numericKey));
+    const auto fileId = getFileIdForKey(numericKey);
+    auto file = findFile(fileId);
     if (!file) return 0;
-    const auto offset = file->getRecordOffsetInMemory(numericKey);
-    const auto record = file->getBuffer() + offset;
-    const bool keyExists = *record != kValueStateFree;
+    const auto recordId = numericKey % m_numberOfRecordsPerFile;
+    const bool keyExists = file->update(recordId, value);
 
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": UPDATE key=" << numericKey << " (fileId "
-                               << fileId << ", offset " << offset << ", key "
-                               << (keyExists ? "doesn't exist" : "exists") << ')');
-
-    if (keyExists) {
-        // Update data
-        std::uint8_t state =
-                (*record == kValueStateExists1) ? kValueStateExists2 : kValueStateExists1;
-        file->update(offset + 1 + m_valueSize * (state - 1), value, m_valueSize);
-        file->update(offset, &state, 1);
-        return 1;
-    }
-    return 0;
+                               << fileId << ", record " << recordId << ", key "
+                               << (keyExists ? "exists" : "doesn't exist") << ')');
+
+    if (!keyExists) return 0;
+    rewriteFileIfRequired(fileId, *file);
+    return 1;
 }
 
 void UniqueLinearIndex::flush()
@@ -200,39 +194,33 @@ std::uint64_t UniqueLinearIndex::find(const void* key, void* value, std::size_t
 {
     if (count == 0) return 0;
     const auto numericKey = decodeKey(key);
-    auto file = findFile(getFileIdForKey(numericKey));
+    const auto fileId = getFileIdForKey(numericKey);
+    auto file = findFile(fileId);
     if (!file) return 0;
-    const auto offset = file->getRecordOffsetInMemory(numericKey);
-    const auto record = file->getBuffer() + offset;
-    const bool keyExists = *record != kValueStateFree;
+    const auto recordId = numericKey % m_numberOfRecordsPerFile;
+    const auto storedValue = file->findValue(recordId);
 
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": GET key=" << numericKey << " (fileId "
-                               << fileId << ", offset " << offset << ", key "
-                               << (keyExists ? "doesn't exist" : "exists") << ')');
+                               << fileId << ", record " << recordId << ", key "
+                               << (storedValue ? "exists" : "doesn't exist") << ')');
 
-    if (keyExists) {
-        if (SIODB_LIKELY(*record <= kValueStateExists2)) {
-            ::memcpy(value, record + 1 + ((*record - 1) * m_valueSize), m_valueSize);
-            return 1;
-        }
-        throwDatabaseError(IOManagerMessageId::kErrorUliCorrupted, getDatabaseName(),
-                m_table.getName(), m_name, getDatabaseUuid(), m_table.getId(), m_id, numericKey);
-    }
-    return 0;
+    if (!storedValue) return 0;
+    ::memcpy(value, storedValue, m_valueSize);
+    return 1;
 }
 
 std::uint64_t UniqueLinearIndex::count(const void* key)
 {
     const auto numericKey = decodeKey(key);
-    auto file = findFile(getFileIdForKey(numericKey));
+    const auto fileId = getFileIdForKey(numericKey);
+    auto file = findFile(fileId);
     if (!file) return 0;
-    const auto offset = file->getRecordOffsetInMemory(numericKey);
-    const auto record = file->getBuffer() + offset;
-    const bool keyExists = *record != kValueStateFree;
+    const auto recordId = numericKey % m_numberOfRecordsPerFile;
+    const bool keyExists = file->findValue(recordId) != nullptr;
 
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": COUNT key=" << numericKey << " (fileId "
-                               << fileId << ", offset " << offset << ", key "
-                               << (keyExists ? "doesn't exist" : "exists") << ')');
+                               << fileId << ", record " << recordId << ", key "
+                               << (keyExists ? "exists" : "doesn't exist") << ')');
 
     return keyExists ? 1 : 0;
 }
@@ -286,24 +274,34 @@ std::uint32_t UniqueLinearIndex::validateIndexFileSize(std::uint32_t size)
     return size;
 }
 
-io::FilePtr UniqueLinearIndex::createIndexFile(std::uint64_t fileId) const
+io::FilePtr UniqueLinearIndex::createIndexFile(std::uint64_t fileId, uli::FileFormat format,
+        const stdext::buffer<std::uint8_t>& data, bool replace) const
 {
     std::string tmpFilePath;
     const auto indexFilePath = makeIndexFilePath(fileId);
+    const bool isDense = format == uli::FileFormat::kDense;
+    const off_t fileSize = isDense ? m_dataFileSize : kIndexFileHeaderSize + data.size();
 
     // Create data file as temporary file
     constexpr int kBaseExtraOpenFlags = O_DSYNC;
     io::FilePtr file;
     try {
-        try {
-            file = m_table.getDatabase().createFile(m_dataDir, kBaseExtraOpenFlags | O_TMPFILE,
-                    kDataFileCreationMode, m_dataFileSize);
-        } catch (std::system_error& ex) {
-            if (ex.code().value() != ENOTSUP) throw;
-            // O_TMPFILE not supported, fallback to the named temporary file
+        if (!replace) {
+            try {
+                file = m_table.getDatabase().createFile(m_dataDir,
+                        kBaseExtraOpenFlags | O_TMPFILE, kDataFileCreationMode, fileSize);
+            } catch (std::system_error& ex) {
+                if (ex.code().value() != ENOTSUP) throw;
+            }
+        }
+        if (!file) {
+            // O_TMPFILE not supported or existing file must be replaced, which linkat()
+            // can't do. Fallback to the named temporary file. Temporary file left
+            // by an interrupted operation is removed, because file is not truncated on open.
             tmpFilePath = indexFilePath + kTempFileExtension;
+            ::unlink(tmpFilePath.c_str());
             file = m_table.getDatabase().createFile(
-                    tmpFilePath, kBaseExtraOpenFlags, kDataFileCreationMode, m_dataFileSize);
+                    tmpFilePath, kBaseExtraOpenFlags, kDataFileCreationMode, fileSize);
         }
     } catch (std::system_error& ex) {
         throwDatabaseError(IOManagerMessageId::kErrorCannotCreateIndexFile, indexFilePath,
@@ -314,7 +312,7 @@ io::FilePtr UniqueLinearIndex::createIndexFile(std::uint64_t fileId) const
     stdext::buffer<std::uint8_t> buffer(kIndexFileHeaderSize, 0);
 
     // Write header
-    IndexFileHeader indexFileHeader(getDatabaseUuid(), getTableId(), m_id, m_type);
+    IndexFileHeader indexFileHeader(getDatabaseUuid(), getTableId(), m_id, m_type, format);
     indexFileHeader.serialize(buffer.data());
     auto n = file->write(buffer.data(), buffer.size(), 0);
     if (n != buffer.size()) {
@@ -326,14 +324,20 @@ io::FilePtr UniqueLinearIndex::createIndexFile(std::uint64_t fileId) const
 
     // Write initial data
     const off_t dataOffset = buffer.size();
-    buffer.resize(m_dataFileSize - kIndexFileHeaderSize);
-    buffer.fill(0);
-    n = file->write(buffer.data(), buffer.size(), dataOffset);
-    if (n != buffer.size()) {
-        throwDatabaseError(IOManagerMessageId::kErrorCannotWriteIndexFile, indexFilePath,
-                getDatabaseName(), m_table.getName(), m_name, getDatabaseUuid(), m_table.getId(),
-                m_id, dataOffset, buffer.size(), file->getLastError(),
-                std::strerror(file->getLastError()), n);
+    const stdext::buffer<std::uint8_t>* initialData = &data;
+    if (isDense && data.empty()) {
+        buffer.resize(m_dataFileSize - kIndexFileHeaderSize);
+        buffer.fill(0);
+        initialData = &buffer;
+    }
+    if (!initialData->empty()) {
+        n = file->write(initialData->data(), initialData->size(), dataOffset);
+        if (n != initialData->size()) {
+            throwDatabaseError(IOManagerMessageId::kErrorCannotWriteIndexFile, indexFilePath,
+                    getDatabaseName(), m_table.getName(), m_name, getDatabaseUuid(),
+                    m_table.getId(), m_id, dataOffset, initialData->size(), file->getLastError(),
+                    std::strerror(file->getLastError()), n);
+        }
     }
 
     if (tmpFilePath.empty()) {
@@ -359,7 +363,7 @@ io::FilePtr UniqueLinearIndex::createIndexFile(std::uint64_t fileId) const
     return file;
 }
 
-io::FilePtr UniqueLinearIndex::openIndexFile(std::uint64_t fileId) const
+io::FilePtr UniqueLinearIndex::openIndexFile(std::uint64_t fileId, uli::FileFormat& format) const
 {
     // Open file
     const auto indexFilePath = makeIndexFilePath(fileId);
@@ -372,22 +376,6 @@ io::FilePtr UniqueLinearIndex::openIndexFile(std::uint64_t fileId) const
                 m_id, ex.code().value(), std::strerror(ex.code().value()));
     }
 
-    // Check file size
-    struct stat st;
-    if (!file->stat(st)) {
-        throwDatabaseError(IOManagerMessageId::kErrorCannotStatIndexFile, getDatabaseName(),
-                getTableName(), getName(), file->getLastError(),
-                std::strerror(file->getLastError()));
-    }
-    const auto expectedFileSize = getDataFileSize();
-    if (st.st_size != expectedFileSize) {
-        std::ostringstream str;
-        str << "invalid file size " << st.st_size << " bytes, expected " << expectedFileSize
-            << " bytes";
-        throwDatabaseError(IOManagerMessageId::kErrorIndexFileCorrupted, getDatabaseName(),
-                getTableName(), m_name, getDatabaseUuid(), getTableId(), m_id, str.str());
-    }
-
     // Check header
     stdext::buffer<std::uint8_t> buffer(kIndexFileHeaderSize);
     const auto n = file->read(buffer.data(), buffer.size(), 0);
@@ -398,13 +386,30 @@ io::FilePtr UniqueLinearIndex::openIndexFile(std::uint64_t fileId) const
                 n);
     }
     IndexFileHeader actualHeader(m_type);
-    actualHeader.deserialize(buffer.data());
-    const IndexFileHeader expectedHeader(getDatabaseUuid(), getTableId(), m_id, m_type);
-    if (actualHeader != expectedHeader) {
+    const IndexFileHeader expectedHeader(
+            getDatabaseUuid(), getTableId(), m_id, m_type, uli::FileFormat::kDense);
+    if (!actualHeader.deserialize(buffer.data()) || actualHeader != expectedHeader) {
         throwDatabaseError(IOManagerMessageId::kErrorIndexFileCorrupted, indexFilePath,
                 getDatabaseName(), m_table.getName(), m_name, getDatabaseUuid(), m_table.getId(),
                 m_id, "invalid header");
     }
+    format = actualHeader.m_format;
+
+    // Check file size, sparse file size depends on the number of log entries
+    struct stat st;
+    if (!file->stat(st)) {
+        throwDatabaseError(IOManagerMessageId::kErrorCannotStatIndexFile, getDatabaseName(),
+                getTableName(), getName(), file->getLastError(),
+                std::strerror(file->getLastError()));
+    }
+    const auto expectedFileSize = getDataFileSize();
+    if (format == uli::FileFormat::kDense && st.st_size != expectedFileSize) {
+        std::ostringstream str;
+        str << "invalid file size " << st.st_size << " bytes, expected " << expectedFileSize
+            << " bytes";
+        throwDatabaseError(IOManagerMessageId::kErrorIndexFileCorrupted, getDatabaseName(),
+                getTableName(), m_name, getDatabaseUuid(), getTableId(), m_id, str.str());
+    }
 
     return file;
 }
@@ -430,7 +435,9 @@ uli::FileDataPtr UniqueLinearIndex::findFile(std::uint64_t fileId)
     if (maybeFileData)
         fileData = *maybeFileData;
     else {
-        fileData = std::make_shared<uli::FileData>(*this, fileId, openIndexFile(fileId));
+        uli::FileFormat format = uli::FileFormat::kDense;
+        auto indexFile = openIndexFile(fileId, format);
+        fileData = makeFileData(fileId, format, std::move(indexFile));
         m_fileCache.emplace(fileId, fileData);
     }
 
@@ -439,14 +446,48 @@ uli::FileDataPtr UniqueLinearIndex::findFile(std::uint64_t fileId)
 
 uli::FileDataPtr UniqueLinearIndex::makeFile(std::uint64_t fileId)
 {
+    // New file starts sparse and becomes dense when it is filled enough
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": Creating file " << fileId);
-    auto indexFile = createIndexFile(fileId);
-    auto fileData = std::make_shared<uli::FileData>(*this, fileId, std::move(indexFile));
+    const stdext::buffer<std::uint8_t> noData;
+    auto indexFile = createIndexFile(fileId, uli::FileFormat::kSparse, noData, false);
+    auto fileData = makeFileData(fileId, uli::FileFormat::kSparse, std::move(indexFile));
     m_fileIds.insert(fileId);
     m_fileCache.emplace(fileId, fileData);
     return fileData;
 }
 
+uli::FileDataPtr UniqueLinearIndex::makeFileData(
+        std::uint64_t fileId, uli::FileFormat format, io::FilePtr&& file)
+{
+    // Dense file data maps file into memory, so descriptor must be open until it is constructed
+    auto& fileRef = *file;
+    uli::FileDataPtr fileData;
+    if (format == uli::FileFormat::kSparse)
+        fileData = std::make_shared<uli::SparseFileData>(*this, fileId, std::move(file));
+    else
+        fileData = std::make_shared<uli::DenseFileData>(*this, fileId, std::move(file));
+    fileRef.attachToDescriptorCache(
+            getDatabase().getInstance().getFileDescriptorCache(), makeIndexFilePath(fileId));
+    return fileData;
+}
+
+void UniqueLinearIndex::rewriteFileIfRequired(std::uint64_t fileId, uli::FileData& file)
+{
+    const auto format = file.getRewriteFormat();
+    if (!format) return;
+
+    ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": Rewriting file " << fileId
+                               << " with " << file.getUsedRecordCount() << " records as "
+                               << (*format == uli::FileFormat::kDense ? "dense" : "sparse"));
+
+    // New file is written completely and then atomically replaces the old one
+    const auto data = (*format == uli::FileFormat::kDense)
+                              ? uli::DenseFileData::makeData(*this, file)
+                              : uli::SparseFileData::makeData(*this, file);
+    auto indexFile = createIndexFile(fileId, *format, data, true);
+    m_fileCache.emplace(fileId, makeFileData(fileId, *format, std::move(indexFile)), true);
+}
+
 std::uint64_t UniqueLinearIndex::decodeKey(const void* key) const noexcept
 {
     if (m_isSignedKey) {
@@ -627,18 +668,16 @@ bool UniqueLinearIndex::findLeadingKey(void* key)
     ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": findLeadingKey");
     for (const auto fileId : m_fileIds) {
         const auto file = findFileChecked(fileId);
-        auto record = file->getBuffer();
-        for (std::size_t i = 0; i < m_numberOfRecordsPerFile; ++i, record += m_recordSize) {
-            if (*record != kValueStateFree) {
-                const std::uint64_t numericKey = (fileId - 1) * m_numberOfRecordsPerFile + i;
-                encodeKey(numericKey, key);
+        const auto i = file->findNextUsedRecord(0);
+        if (i != uli::FileData::kNoRecord) {
+            const std::uint64_t numericKey = (fileId - 1) * m_numberOfRecordsPerFile + i;
+            encodeKey(numericKey, key);
 
-                ULI_DBG_LOG_DEBUG("Index " << makeDisplayName()
-                                           << ": findLeadingKey: found active record file "
-                                           << fileId << " record " << i << " key " << numericKey);
+            ULI_DBG_LOG_DEBUG("Index " << makeDisplayName()
+                                       << ": findLeadingKey: found active record file "
+                                       << fileId << " record " << i << " key " << numericKey);
 
-                return true;
-            }
+            return true;
         }
     }
     return false;
@@ -657,20 +696,16 @@ bool UniqueLinearIndex::findTrailingKey(void* key)
     for (auto it = m_fileIds.crbegin(); it != m_fileIds.crend(); ++it) {
         const auto fileId = *it;
         const auto file = findFileChecked(fileId);
-        const auto buffer = file->getBuffer();
-        auto record = buffer + (m_numberOfRecordsPerFile - 1) * m_recordSize;
-        for (std::size_t i = m_numberOfRecordsPerFile; i != 0; --i, record -= m_recordSize) {
-            if (*record != kValueStateFree) {
-                const std::uint64_t numericKey = (fileId - 1) * m_numberOfRecordsPerFile + i - 1;
-                encodeKey(numericKey, key);
-
-                ULI_DBG_LOG_DEBUG("Index " << makeDisplayName()
-                                           << ": findTrailingKey: found active record file "
-                                           << fileId << " record " << (i - 1) << " offset "
-                                           << " key " << numericKey);
+        const auto i = file->findPreviousUsedRecord(m_numberOfRecordsPerFile - 1);
+        if (i != uli::FileData::kNoRecord) {
+            const std::uint64_t numericKey = (fileId - 1) * m_numberOfRecordsPerFile + i;
+            encodeKey(numericKey, key);
 
-                return true;
-            }
+            ULI_DBG_LOG_DEBUG("Index " << makeDisplayName()
+                                       << ": findTrailingKey: found active record file "
+                                       << fileId << " record " << i << " key " << numericKey);
+
+            return true;
         }
     }
     return false;
@@ -719,22 +754,17 @@ bool UniqueLinearIndex::findKeyBefore(const void* key, void* keyBefore)
         ULI_DBG_LOG_DEBUG(
                 "Index " << makeDisplayName() << ": findKeyBefore: obtained file #" << fileId);
 
-        // Scan file
-        if (recordId > 0) {
-            --recordId;
-            --currentNumericKey;
-            const auto base = file->getBuffer();
-            auto record = base + file->getRecordOffsetInMemory(recordId);
-            for (; record >= base; --recordId, --currentNumericKey, record -= m_recordSize) {
-                if (*record != kValueStateFree) {
-                    encodeKey(currentNumericKey, keyBefore);
-                    if (m_keyCompare(keyBefore, key) < 0) {
-                        ULI_DBG_LOG_DEBUG("Index " << makeDisplayName()
-                                                   << ": findKeyBefore: key=" << numericKey
-                                                   << " result=" << currentNumericKey);
-                        return true;
-                    }
-                }
+        // Scan file, skipping free records using occupancy bitmap
+        while (recordId > 0) {
+            const auto usedRecordId = file->findPreviousUsedRecord(recordId - 1);
+            if (usedRecordId == uli::FileData::kNoRecord) break;
+            currentNumericKey -= recordId - usedRecordId;
+            recordId = usedRecordId;
+            encodeKey(currentNumericKey, keyBefore);
+            if (m_keyCompare(keyBefore, key) < 0) {
+                ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": findKeyBefore: key="
+                                           << numericKey << " result=" << currentNumericKey);
+                return true;
             }
         }
 
@@ -804,19 +834,19 @@ bool UniqueLinearIndex::findKeyAfter(const void* key, void* keyAfter)
         ULI_DBG_LOG_DEBUG(
                 "Index " << makeDisplayName() << ": findKeyAfter: obtained file #" << fileId);
 
-        // Scan file
-        const auto base = file->getBuffer();
-        auto record = base + file->getRecordOffsetInMemory(recordId);
-        const auto end = base + m_numberOfRecordsPerFile * m_recordSize;
-        for (; record != end; ++recordId, ++currentNumericKey, record += m_recordSize) {
-            if (*record != kValueStateFree) {
-                encodeKey(currentNumericKey, keyAfter);
-                if (m_keyCompare(keyAfter, key) > 0) {
-                    ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": findKeyAfter: key="
-                                               << numericKey << " result=" << currentNumericKey);
-                    return true;
-                }
+        // Scan file, skipping free records using occupancy bitmap
+        while (recordId < m_numberOfRecordsPerFile) {
+            const auto usedRecordId = file->findNextUsedRecord(recordId);
+            if (usedRecordId == uli::FileData::kNoRecord) break;
+            currentNumericKey += usedRecordId - recordId;
+            encodeKey(currentNumericKey, keyAfter);
+            if (m_keyCompare(keyAfter, key) > 0) {
+                ULI_DBG_LOG_DEBUG("Index " << makeDisplayName() << ": findKeyAfter: key="
+                                           << numericKey << " result=" << currentNumericKey);
+                return true;
             }
+            recordId = usedRecordId + 1;
+            ++currentNumericKey;
         }
 
         // Step to a next file
@@ -910,10 +940,17 @@ std::set<std::uint64_t> UniqueLinearIndex::scanFiles() const
     constexpr auto kFileNameSurroundingLength =
             kIndexFilePrefixLength + ct_strlen(kDataFileExtension);
     constexpr auto kMinFileNameLength = kFileNameSurroundingLength + 1;
+    constexpr auto kTempFileExtensionLength = ct_strlen(kTempFileExtension);
     std::set<std::uint64_t> fileIds;
     for (fs::directory_iterator it(m_dataDir), endIt; it != endIt; ++it) {
         const auto fileName = it->path().filename().generic_string();
         if (fileName == kInitializationFlagFile) continue;
+        // Skip temporary files left by the interrupted file creation or rewrite
+        if (fileName.length() > kTempFileExtensionLength
+                && fileName.compare(fileName.length() - kTempFileExtensionLength,
+                           kTempFileExtensionLength, kTempFileExtension)
+                           == 0)
+            continue;
         if (fileName.length() < kMinFileNameLength || fileName.find(kIndexFilePrefix) != 0)
             continue;
         const auto fileIdStr = fileName.substr(
@@ -944,13 +981,18 @@ std::uint64_t UniqueLinearIndex::computeMaxPossibleFileId() const noexcept
 
 std::uint8_t* UniqueLinearIndex::IndexFileHeader::serialize(std::uint8_t* buffer) const noexcept
 {
-    return IndexFileHeaderBase::serialize(buffer);
+    buffer = IndexFileHeaderBase::serialize(buffer);
+    *buffer++ = static_cast<std::uint8_t>(m_format);
+    return buffer;
 }
 
 const std::uint8_t* UniqueLinearIndex::IndexFileHeader::deserialize(
         const std::uint8_t* buffer) noexcept
 {
-    return IndexFileHeaderBase::deserialize(buffer);
+    buffer = IndexFileHeaderBase::deserialize(buffer);
+    if (!buffer || *buffer > static_cast<std::uint8_t>(uli::FileFormat::kSparse)) return nullptr;
+    m_format = static_cast<uli::FileFormat>(*buffer++);
+    return buffer;
 }
 
 }  // namespace siodb::iomgr::dbengine
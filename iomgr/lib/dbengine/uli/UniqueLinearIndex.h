@@ -1,4 +1,4 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
@@ -6,10 +6,12 @@
 
 // Project headers
 #include "FileCache.h"
+#include "FileFormat.h"
 #include "../Index.h"
 #include "../IndexFileHeaderBase.h"
 
 // Common project headers
+#include <siodb/common/stl_ext/buffer.h>
 #include <siodb/common/utils/FDGuard.h>
 
 // STL headers
@@ -84,6 +86,14 @@ public:
         return m_numberOfRecordsPerFile;
     }
 
+    /**
+     * Returns format of the index file.
+     * @param fileId File ID.
+     * @return File format.
+     * @throw DatabaseError if file doesn't exist or can't be opened.
+     */
+    uli::FileFormat getFileFormat(std::uint64_t fileId);
+
     /**
      * Returns data file size if applicable.
      * @return Data file size or zero if not applicable.
@@ -189,6 +199,7 @@ private:
         /** Initialized object of class Header */
         IndexFileHeader(IndexType indexType) noexcept
             : IndexFileHeaderBase(indexType)
+            , m_format(uli::FileFormat::kDense)
         {
         }
 
@@ -198,14 +209,16 @@ private:
          * @param tableId Table ID.
          * @param indexId Index ID.
          * @param indexType Index type.
+         * @param format File format.
          */
         IndexFileHeader(const Uuid& databaseUuid, std::uint32_t tableId, std::uint64_t indexId,
-                IndexType indexType) noexcept
+                IndexType indexType, uli::FileFormat format) noexcept
             : IndexFileHeaderBase(databaseUuid, tableId, indexId, indexType)
+            , m_format(format)
         {
         }
 
-        /** Equality operator */
+        /** Equality operator. File format is not compared. */
         bool operator==(const IndexFileHeader& other) const noexcept
         {
             return IndexFileHeaderBase::operator==(other);
@@ -230,16 +243,11 @@ private:
          */
         const std::uint8_t* deserialize(const std::uint8_t* buffer) noexcept;
 
-        /** Serialized size */
-        static constexpr std::size_t kSerializedSize = IndexFileHeaderBase::kSerializedSize;
-    };
+        /** File format. Zero in the files created before sparse format was introduced. */
+        uli::FileFormat m_format;
 
-private:
-    /** Value state */
-    enum ValueState {
-        kValueStateFree = 0,
-        kValueStateExists1 = 1,
-        kValueStateExists2 = 2,
+        /** Serialized size */
+        static constexpr std::size_t kSerializedSize = IndexFileHeaderBase::kSerializedSize + 1;
     };
 
 private:
@@ -254,16 +262,32 @@ private:
     /**
      * Creates and initializes new index data file.
      * @param fileId File ID.
+     * @param format File format.
+     * @param data Initial contents of the data area. Empty data means empty file:
+     *             data area is zero-filled for the dense file and has no entries
+     *             for the sparse file.
+     * @param replace Indicates that file replaces existing file with the same ID.
      * @return File object.
      */
-    io::FilePtr createIndexFile(std::uint64_t fileId) const;
+    io::FilePtr createIndexFile(std::uint64_t fileId, uli::FileFormat format,
+            const stdext::buffer<std::uint8_t>& data, bool replace) const;
 
     /**
      * Opens existing index data file.
      * @param fileId File ID.
+     * @param[out] format File format.
      * @return File object.
      */
-    io::FilePtr openIndexFile(std::uint64_t fileId) const;
+    io::FilePtr openIndexFile(std::uint64_t fileId, uli::FileFormat& format) const;
+
+    /**
+     * Creates file data object of the given format.
+     * @param fileId File ID.
+     * @param format File format.
+     * @param file File object.
+     * @return File data object.
+     */
+    uli::FileDataPtr makeFileData(std::uint64_t fileId, uli::FileFormat format, io::FilePtr&& file);
 
     /**
      * Returns file with given ID.
@@ -287,6 +311,13 @@ private:
      */
     uli::FileDataPtr makeFile(std::uint64_t fileId);
 
+    /**
+     * Rewrites file in another format or compacts it, if file requests that.
+     * @param fileId File identifier.
+     * @param file File object.
+     */
+    void rewriteFileIfRequired(std::uint64_t fileId, uli::FileData& file);
+
     /**
      * Encodes 8-bit signed integer for indexing.
      * @param n A number.
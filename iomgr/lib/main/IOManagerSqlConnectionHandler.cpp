@@ -13,18 +13,58 @@
 #include "../dbengine/parser/SqlParser.h"
 
 // Common project headers
+#include <siodb/common/io/ChunkedInputStream.h>
 #include <siodb/common/log/Log.h>
 #include <siodb/common/net/ConnectionError.h>
 #include <siodb/common/net/EpollHelpers.h>
 #include <siodb/common/protobuf/ProtobufMessageIO.h>
+#include <siodb/common/protobuf/StreamInputStream.h>
 #include <siodb/common/utils/ErrorCodeChecker.h>
+#include <siodb/common/utils/HelperMacros.h>
 #include <siodb/common/utils/SignalHandlers.h>
 
+// STL headers
+#include <optional>
+
 // Protobuf message headers
 #include <siodb/common/proto/IOManagerProtocol.pb.h>
 
 namespace siodb::iomgr {
 
+namespace {
+
+/** Reads and discards unread part of the data stream, which follows the request. */
+class RequestDataStreamGuard {
+public:
+    /**
+     * Initializes object of class RequestDataStreamGuard.
+     * @param dataInput Data stream, if present.
+     */
+    explicit RequestDataStreamGuard(std::optional<io::ChunkedInputStream>& dataInput) noexcept
+        : m_dataInput(dataInput)
+    {
+    }
+
+    /** De-initializes object of class RequestDataStreamGuard. */
+    ~RequestDataStreamGuard()
+    {
+        if (!m_dataInput) return;
+        while (!m_dataInput->isEof() && m_dataInput->skip(kSkipSize) > 0)
+            ;
+    }
+
+    DECLARE_NONCOPYABLE(RequestDataStreamGuard);
+
+private:
+    /** Data stream */
+    std::optional<io::ChunkedInputStream>& m_dataInput;
+
+    /** Number of bytes skipped at once */
+    static constexpr std::size_t kSkipSize = 0x10000;
+};
+
+}  // namespace
+
 // --- internals ---
 
 void IOManagerSqlConnectionHandler::threadLogicImpl()
@@ -44,6 +84,10 @@ void IOManagerSqlConnectionHandler::threadLogicImpl()
     // Allow EINTR to cause I/O error when exit signal detected.
     const utils::ExitSignalAwareErrorCodeChecker errorCodeChecker;
 
+    // NOTE: Must be persistent, because request may be followed by the data stream,
+    // which can be partially buffered in this stream.
+    protobuf::StreamInputStream input(*m_clientConnection, errorCodeChecker);
+
     while (m_clientConnection->isValid()) {
         try {
             // Read message from client
@@ -53,7 +97,7 @@ void IOManagerSqlConnectionHandler::threadLogicImpl()
                 // NOTE: We can receive an empty message if TCP connection is closed or aborted
                 net::epollWaitForData(m_clientEpollFd.getFD(), true);
                 protobuf::readMessage(protobuf::ProtocolMessageType::kDatabaseEngineRequest,
-                        requestMsg, *m_clientConnection, errorCodeChecker);
+                        requestMsg, input);
             } catch (net::ConnectionError& err) {
                 LOG_DEBUG << m_logContext << "Client disconnected.";
                 // Connection was closed or hangup. No reading operation was in progress
@@ -68,6 +112,11 @@ void IOManagerSqlConnectionHandler::threadLogicImpl()
             DBG_LOG_DEBUG(m_logContext << "Received request: id: " << requestMsg.request_id()
                                        << ",\ntext: " << requestMsg.text());
 
+            // Data stream must be always consumed, even if it is not used by the statements
+            std::optional<io::ChunkedInputStream> dataInput;
+            if (requestMsg.data_follows()) dataInput.emplace(input);
+            RequestDataStreamGuard dataInputGuard(dataInput);
+
             dbengine::parser::SqlParser parser(requestMsg.text());
             try {
                 parser.parse();
@@ -78,6 +127,8 @@ void IOManagerSqlConnectionHandler::threadLogicImpl()
                 continue;
             }
 
+            requestHandler->setRowsetFormat(requestMsg.rowset_format());
+
             const auto statementCount = parser.getStatementCount();
             for (std::size_t i = 0; i < statementCount; ++i) {
                 // Fill request
@@ -92,7 +143,8 @@ void IOManagerSqlConnectionHandler::threadLogicImpl()
                     }();
 #endif
                     LOG_DEBUG << m_logContext << "Parsing statement #" << i;
-                    dbengine::parser::DBEngineSqlRequestFactory factory(parser);
+                    dbengine::parser::DBEngineSqlRequestFactory factory(
+                            parser, dataInput ? &*dataInput : nullptr);
                     dbEngineRequest = factory.createSqlRequest(i);
                 } catch (dbengine::parser::DBEngineRequestFactoryError& ex) {
                     LOG_ERROR << m_logContext << "SQL parse error: " << ex.what();
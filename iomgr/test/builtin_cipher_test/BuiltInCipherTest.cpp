@@ -1,4 +1,4 @@
-// Copyright (C) 2019-2020 Siodb GmbH. All rights reserved.
+// Copyright (C) 2019-2021 Siodb GmbH. All rights reserved.
 // Use of this source code is governed by a license that can be found
 // in the LICENSE file.
 
@@ -67,6 +67,76 @@ bool testCipher(const siodb::iomgr::dbengine::crypto::Cipher& cipher, unsigned m
     return true;
 }
 
+siodb::BinaryValue fromHex(const char* hex)
+{
+    siodb::BinaryValue result(std::strlen(hex) / 2);
+    for (std::size_t i = 0; i < result.size(); ++i)
+        result[i] = std::stoul(std::string(hex + i * 2, 2), nullptr, 16);
+    return result;
+}
+
+bool testKnownAnswer(const siodb::iomgr::dbengine::crypto::Cipher& cipher, const char* keyHex,
+        const char* plaintextHex, const char* ciphertextHex)
+{
+    const auto key = fromHex(keyHex);
+    const auto plaintext = fromHex(plaintextHex);
+    const auto expectedCiphertext = fromHex(ciphertextHex);
+    const auto blockCount = plaintext.size() / (cipher.getBlockSizeInBits() / 8);
+
+    siodb::BinaryValue ciphertext(plaintext.size());
+    cipher.createEncryptionContext(key)->transform(plaintext.data(), blockCount, ciphertext.data());
+    if (ciphertext != expectedCiphertext) {
+        printData(std::cerr, "Expected Encrypted Data", expectedCiphertext);
+        printData(std::cerr, "Encrypted Data", ciphertext);
+        return false;
+    }
+
+    // In-place decryption
+    const auto decryptionContext = cipher.createDecryptionContext(key);
+    decryptionContext->transform(ciphertext.data(), blockCount, ciphertext.data());
+    if (ciphertext != plaintext) {
+        printData(std::cerr, "Data", plaintext);
+        printData(std::cerr, "Decrypted Data", ciphertext);
+        return false;
+    }
+    return true;
+}
+
+bool testMultithreadedTransform(const siodb::iomgr::dbengine::crypto::Cipher& cipher)
+{
+    using siodb::iomgr::dbengine::crypto::CipherContext;
+
+    const auto blockSize = cipher.getBlockSizeInBits() / 8;
+    // Not divisible evenly between threads
+    const auto blockCount = (CipherContext::kMinTransformSizePerThread * 5) / blockSize + 3;
+    const auto dataSize = blockCount * blockSize;
+
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<unsigned> dis(0, 255);
+    siodb::BinaryValue data(dataSize);
+    for (auto& v : data)
+        v = dis(gen);
+    siodb::BinaryValue key(cipher.getKeySizeInBits() / 8);
+    for (auto& v : key)
+        v = dis(gen);
+
+    const auto encryptionContext = cipher.createEncryptionContext(key);
+    const auto decryptionContext = cipher.createDecryptionContext(key);
+
+    siodb::BinaryValue expectedEncryptedData(dataSize);
+    CipherContext::setMaxTransformThreadCount(1);
+    encryptionContext->transform(data.data(), blockCount, expectedEncryptedData.data());
+
+    siodb::BinaryValue encryptedData(dataSize);
+    CipherContext::setMaxTransformThreadCount(4);
+    encryptionContext->transform(data.data(), blockCount, encryptedData.data());
+    siodb::BinaryValue decryptedData(encryptedData);
+    decryptionContext->transform(decryptedData.data(), blockCount, decryptedData.data());
+    CipherContext::setMaxTransformThreadCount(1);
+
+    return encryptedData == expectedEncryptedData && decryptedData == data;
+}
+
 }  // anonymous namespace
 
 TEST(BuiltInCiphers, Aes128)
@@ -111,6 +181,37 @@ TEST(BuiltInCiphers, Camellia256)
     ASSERT_TRUE(testCipher(*cipher, 16));
 }
 
+TEST(BuiltInCiphers, KnownAnswer)
+{
+    using namespace siodb::iomgr::dbengine::crypto;
+    // FIPS-197 Appendix C
+    ASSERT_TRUE(testKnownAnswer(*std::make_shared<Aes128>(), "000102030405060708090a0b0c0d0e0f",
+            "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a"));
+    ASSERT_TRUE(testKnownAnswer(*std::make_shared<Aes192>(),
+            "000102030405060708090a0b0c0d0e0f1011121314151617",
+            "00112233445566778899aabbccddeeff", "dda97ca4864cdfe06eaf70a0ec0d7191"));
+    ASSERT_TRUE(testKnownAnswer(*std::make_shared<Aes256>(),
+            "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+            "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089"));
+    // RFC 3713 Appendix A
+    ASSERT_TRUE(testKnownAnswer(*std::make_shared<Camellia128>(),
+            "0123456789abcdeffedcba9876543210", "0123456789abcdeffedcba9876543210",
+            "67673138549669730857065648eabe43"));
+    ASSERT_TRUE(testKnownAnswer(*std::make_shared<Camellia192>(),
+            "0123456789abcdeffedcba98765432100011223344556677",
+            "0123456789abcdeffedcba9876543210", "b4993401b3e996f84ee5cee7d79b09b9"));
+    ASSERT_TRUE(testKnownAnswer(*std::make_shared<Camellia256>(),
+            "0123456789abcdeffedcba987654321000112233445566778899aabbccddeeff",
+            "0123456789abcdeffedcba9876543210", "9acc237dff16d76c20ef7c919e3a7509"));
+}
+
+TEST(BuiltInCiphers, MultithreadedTransform)
+{
+    using namespace siodb::iomgr::dbengine::crypto;
+    ASSERT_TRUE(testMultithreadedTransform(*std::make_shared<Aes128>()));
+    ASSERT_TRUE(testMultithreadedTransform(*std::make_shared<Camellia256>()));
+}
+
 int main(int argc, char** argv)
 {
     // Run tests
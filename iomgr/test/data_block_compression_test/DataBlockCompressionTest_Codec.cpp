@@ -0,0 +1,184 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "dbengine/ColumnDataBlockCompression.h"
+
+// CRT headers
+#include <cstring>
+
+// STL headers
+#include <random>
+#include <string>
+
+// Google Test
+#include <gtest/gtest.h>
+
+namespace dbengine = siodb::iomgr::dbengine;
+
+namespace {
+
+constexpr int kCompressionLevel = 6;
+
+/**
+ * Makes data with repeating text records of variable size.
+ * @param length Data length.
+ * @return Data.
+ */
+std::vector<std::uint8_t> makeTextData(std::size_t length)
+{
+    std::vector<std::uint8_t> data;
+    data.reserve(length);
+    for (std::size_t i = 0; data.size() < length; ++i) {
+        const auto record = "customer name " + std::to_string(i % 100) + ";";
+        data.insert(data.end(), record.cbegin(), record.cend());
+    }
+    data.resize(length);
+    return data;
+}
+
+/**
+ * Makes data with increasing 64-bit integer records, with carries and wraparound
+ * between bytes.
+ * @param recordCount Number of records.
+ * @return Data.
+ */
+std::vector<std::uint8_t> makeIncreasingIntegerData(std::size_t recordCount)
+{
+    std::vector<std::uint8_t> data(recordCount * sizeof(std::uint64_t));
+    std::uint64_t value = 0xFFFFFFFFFFFFF000ULL;
+    for (std::size_t i = 0; i < recordCount; ++i, value += 251)
+        std::memcpy(data.data() + i * sizeof(value), &value, sizeof(value));
+    return data;
+}
+
+/**
+ * Makes random data.
+ * @param length Data length.
+ * @return Data.
+ */
+std::vector<std::uint8_t> makeRandomData(std::size_t length)
+{
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(length));
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<std::uint8_t> data(length);
+    for (auto& b : data)
+        b = static_cast<std::uint8_t>(dist(gen));
+    return data;
+}
+
+/**
+ * Compresses and decompresses data, checks that result is the same as original data.
+ * @param data Data.
+ * @param recordSize Record size.
+ * @return Compression type.
+ */
+dbengine::ColumnDataBlockCompressionType checkRoundtrip(
+        const std::vector<std::uint8_t>& data, std::size_t recordSize)
+{
+    std::vector<std::uint8_t> compressedData;
+    const auto compressionType = dbengine::compressColumnDataBlockData(
+            data.data(), data.size(), recordSize, kCompressionLevel, compressedData);
+    if (compressionType == dbengine::ColumnDataBlockCompressionType::kNone) {
+        EXPECT_TRUE(compressedData.empty());
+        return compressionType;
+    }
+
+    EXPECT_LE(compressedData.size(), data.size() - data.size() / 8);
+    std::vector<std::uint8_t> decompressedData(data.size());
+    EXPECT_TRUE(dbengine::decompressColumnDataBlockData(compressionType, compressedData.data(),
+            compressedData.size(), recordSize, decompressedData));
+    EXPECT_EQ(decompressedData, data);
+    return compressionType;
+}
+
+}  // anonymous namespace
+
+TEST(Codec, DeflateRoundtrip)
+{
+    const auto data = makeTextData(1024 * 1024);
+    EXPECT_EQ(checkRoundtrip(data, 0), dbengine::ColumnDataBlockCompressionType::kDeflate);
+}
+
+TEST(Codec, DeltaDeflateRoundtrip)
+{
+    const auto data = makeIncreasingIntegerData(128 * 1024);
+    EXPECT_EQ(checkRoundtrip(data, sizeof(std::uint64_t)),
+            dbengine::ColumnDataBlockCompressionType::kDeltaDeflate);
+}
+
+TEST(Codec, DeltaDeflateRoundtrip_PartialLastRecord)
+{
+    // Length which is not multiple of the record size, as in a block with a tail
+    auto data = makeIncreasingIntegerData(64 * 1024);
+    data.resize(data.size() - 3);
+    EXPECT_EQ(checkRoundtrip(data, sizeof(std::uint64_t)),
+            dbengine::ColumnDataBlockCompressionType::kDeltaDeflate);
+
+    // Record size not matching data must not break roundtrip, whatever encoding is chosen
+    for (const std::size_t recordSize : {2U, 3U, 4U})
+        checkRoundtrip(data, recordSize);
+}
+
+TEST(Codec, DeltaNotChosenWhenWorse)
+{
+    // Delta encoding of the text scrambles repetitions, so plain deflate wins
+    const auto data = makeTextData(256 * 1024);
+    EXPECT_EQ(checkRoundtrip(data, sizeof(std::uint32_t)),
+            dbengine::ColumnDataBlockCompressionType::kDeflate);
+}
+
+TEST(Codec, ShortData)
+{
+    // Data not longer than single record can't be delta encoded
+    const auto data = makeIncreasingIntegerData(1);
+    checkRoundtrip(data, sizeof(std::uint64_t));
+    checkRoundtrip(std::vector<std::uint8_t>(1, 0), 0);
+}
+
+TEST(Codec, IncompressibleData)
+{
+    const auto data = makeRandomData(256 * 1024);
+    EXPECT_EQ(checkRoundtrip(data, sizeof(std::uint64_t)),
+            dbengine::ColumnDataBlockCompressionType::kNone);
+}
+
+TEST(Codec, CorruptedData)
+{
+    const auto data = makeIncreasingIntegerData(16 * 1024);
+    std::vector<std::uint8_t> compressedData;
+    const auto compressionType = dbengine::compressColumnDataBlockData(data.data(), data.size(),
+            sizeof(std::uint64_t), kCompressionLevel, compressedData);
+    ASSERT_EQ(compressionType, dbengine::ColumnDataBlockCompressionType::kDeltaDeflate);
+
+    std::vector<std::uint8_t> decompressedData(data.size());
+
+    // Damaged stream
+    auto damagedData = compressedData;
+    damagedData[damagedData.size() / 2] ^= 0x5A;
+    damagedData[damagedData.size() - 1] ^= 0xFF;
+    EXPECT_FALSE(dbengine::decompressColumnDataBlockData(compressionType, damagedData.data(),
+            damagedData.size(), sizeof(std::uint64_t), decompressedData));
+
+    // Truncated stream
+    EXPECT_FALSE(dbengine::decompressColumnDataBlockData(compressionType, compressedData.data(),
+            compressedData.size() / 2, sizeof(std::uint64_t), decompressedData));
+
+    // Wrong original length
+    std::vector<std::uint8_t> shortBuffer(data.size() / 2);
+    EXPECT_FALSE(dbengine::decompressColumnDataBlockData(compressionType, compressedData.data(),
+            compressedData.size(), sizeof(std::uint64_t), shortBuffer));
+    std::vector<std::uint8_t> longBuffer(data.size() + 1);
+    EXPECT_FALSE(dbengine::decompressColumnDataBlockData(compressionType, compressedData.data(),
+            compressedData.size(), sizeof(std::uint64_t), longBuffer));
+
+    // Missing record size
+    EXPECT_FALSE(dbengine::decompressColumnDataBlockData(compressionType, compressedData.data(),
+            compressedData.size(), 0, decompressedData));
+
+    // Not compressed
+    EXPECT_FALSE(dbengine::decompressColumnDataBlockData(
+            dbengine::ColumnDataBlockCompressionType::kNone, compressedData.data(),
+            compressedData.size(), sizeof(std::uint64_t), decompressedData));
+}
@@ -8,6 +8,7 @@
 #include <siodb/common/utils/DebugMacros.h>
 #include <siodb/iomgr/shared/dbengine/crypto/ciphers/AesCipher.h>
 #include <siodb/iomgr/shared/dbengine/io/EncryptedFile.h>
+#include <siodb/iomgr/shared/dbengine/io/FileDescriptorCache.h>
 
 // STL headers
 #include <limits>
@@ -551,6 +552,85 @@ TEST(EncryptedFile, RandomReadWrite)
     }
 }
 
+TEST(EncryptedFile, Prefetch)
+{
+    using namespace siodb;
+    using namespace siodb::iomgr::dbengine;
+
+    constexpr off_t kFileSize = 256 * 1024;
+    siodb::BinaryValue buffer1(kFileSize), buffer2(kFileSize);
+    for (off_t i = 0; i < kFileSize; ++i)
+        buffer1[i] = static_cast<std::uint8_t>(i * 7);
+
+    io::EncryptedFile file(g_testEnv->makeNewFilePath(), 0, kFileCreationMode,
+            g_testEnv->getEncryptionContext(), g_testEnv->getDecryptionContext(), kFileSize);
+    ASSERT_EQ(file.write(buffer1.data(), buffer1.size(), 0), buffer1.size());
+
+    // Aligned, unaligned, up to the end of file and beyond it
+    const auto blockSize = static_cast<off_t>(file.getBlockSize());
+    ASSERT_TRUE(file.prefetch(0, blockSize));
+    ASSERT_TRUE(file.prefetch(blockSize + 1, 3 * blockSize - 2));
+    ASSERT_TRUE(file.prefetch(kFileSize - 10, 10));
+    ASSERT_TRUE(file.prefetch(kFileSize / 2, 0));
+    ASSERT_TRUE(file.prefetch(kFileSize - 1, kFileSize));
+
+    // Prefetch doesn't affect data
+    ASSERT_EQ(file.read(buffer2.data(), buffer2.size(), 0), buffer2.size());
+    ASSERT_EQ(std::memcmp(buffer1.data(), buffer2.data(), buffer1.size()), 0);
+
+    ASSERT_FALSE(file.prefetch(-1, blockSize));
+    ASSERT_EQ(file.getLastError(), EINVAL);
+    ASSERT_FALSE(file.prefetch(0, -1));
+    ASSERT_EQ(file.getLastError(), EINVAL);
+}
+
+TEST(EncryptedFile, DescriptorCache)
+{
+    using namespace siodb;
+    using namespace siodb::iomgr::dbengine;
+
+    constexpr off_t kFileSize = 4096;
+    constexpr std::size_t kFileCount = 3;
+    io::FileDescriptorCache cache(1);
+
+    // Create files and fill them with different data
+    std::vector<std::unique_ptr<io::EncryptedFile>> files;
+    for (std::size_t i = 0; i < kFileCount; ++i) {
+        const auto filePath = g_testEnv->makeNewFilePath();
+        files.push_back(std::make_unique<io::EncryptedFile>(filePath, 0, kFileCreationMode,
+                g_testEnv->getEncryptionContext(), g_testEnv->getDecryptionContext(), 0));
+        const siodb::BinaryValue buffer(kFileSize, static_cast<std::uint8_t>(i + 1));
+        ASSERT_EQ(files.back()->write(buffer.data(), buffer.size(), 0), buffer.size());
+        files.back()->attachToDescriptorCache(cache, filePath);
+    }
+    ASSERT_EQ(cache.getStatistics().m_fileCount, kFileCount);
+    ASSERT_EQ(cache.getStatistics().m_openFileCount, 1U);
+
+    // Access files alternately, so that each access reopens file
+    siodb::BinaryValue buffer(kFileSize);
+    for (std::size_t i = 0; i < kFileCount * 2; ++i) {
+        auto& file = *files[i % kFileCount];
+        ASSERT_EQ(file.read(buffer.data(), buffer.size(), 0), buffer.size());
+        ASSERT_EQ(buffer[0], static_cast<std::uint8_t>(i % kFileCount + 1));
+        ASSERT_EQ(buffer[kFileSize - 1], static_cast<std::uint8_t>(i % kFileCount + 1));
+        ASSERT_EQ(cache.getStatistics().m_openFileCount, 1U);
+    }
+
+    // Write to the file with closed descriptor and read data back
+    const siodb::BinaryValue newData(kFileSize, 0xFF);
+    ASSERT_EQ(files[0]->write(newData.data(), newData.size(), kFileSize), newData.size());
+    ASSERT_EQ(files[0]->read(buffer.data(), buffer.size(), kFileSize), buffer.size());
+    ASSERT_EQ(buffer, newData);
+
+    const auto statistics = cache.getStatistics();
+    ASSERT_GE(statistics.m_reopenCount, kFileCount * 2);
+    ASSERT_EQ(statistics.m_reopenFailureCount, 0U);
+
+    // Destroyed files are detached
+    files.pop_back();
+    ASSERT_EQ(cache.getStatistics().m_fileCount, kFileCount - 1);
+}
+
 int main(int argc, char** argv)
 {
     DEBUG_SYSCALLS_LIBRARY_GUARD;
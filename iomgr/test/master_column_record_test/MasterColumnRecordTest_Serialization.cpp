@@ -0,0 +1,292 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "dbengine/MasterColumnRecord.h"
+
+// Common project headers
+#include <siodb/common/utils/Base128VariantEncoding.h>
+
+// STL headers
+#include <limits>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+namespace dbengine = siodb::iomgr::dbengine;
+
+namespace {
+
+constexpr std::uint64_t kCreateTimestamp = 1600000000000000ULL;
+constexpr std::uint64_t kUpdateTimestamp = 1600000000123456ULL;
+
+/**
+ * Makes master column record without column records.
+ * @param privateDataExpirationTimestamp Private data expiration timestamp.
+ * @return Master column record.
+ */
+dbengine::MasterColumnRecord makeRecord(std::uint64_t privateDataExpirationTimestamp = 0)
+{
+    dbengine::MasterColumnRecord mcr(1234567, 890, kCreateTimestamp, kUpdateTimestamp, 3, 77,
+            dbengine::DmlOperationType::kUpdate, 5, 42, dbengine::ColumnDataAddress(99, 1000));
+    mcr.setPrivateDataExpirationTimestamp(privateDataExpirationTimestamp);
+    return mcr;
+}
+
+/**
+ * Serializes master column record, checks that serialized size is as expected.
+ * @param mcr Master column record.
+ * @return Serialized record without size tag.
+ */
+std::vector<std::uint8_t> serialize(const dbengine::MasterColumnRecord& mcr)
+{
+    const auto size = static_cast<std::uint16_t>(mcr.getSerializedSize());
+    std::vector<std::uint8_t> buffer(
+            dbengine::MasterColumnRecord::getSerializedSizeWithSizeTag(size));
+    const auto end = mcr.serializeUncheckedWithSizeTag(buffer.data(), size);
+    EXPECT_EQ(static_cast<std::size_t>(end - buffer.data()), buffer.size());
+    buffer.erase(buffer.begin(), buffer.begin() + ::getVarUInt16Size(size));
+    EXPECT_EQ(buffer.size(), size);
+    return buffer;
+}
+
+/**
+ * Checks that two master column records are equal.
+ * @param mcr1 First master column record.
+ * @param mcr2 Second master column record.
+ */
+void checkEqual(const dbengine::MasterColumnRecord& mcr1, const dbengine::MasterColumnRecord& mcr2)
+{
+    EXPECT_EQ(mcr1.getTableRowId(), mcr2.getTableRowId());
+    EXPECT_EQ(mcr1.getTransactionId(), mcr2.getTransactionId());
+    EXPECT_EQ(mcr1.getCreateTimestamp(), mcr2.getCreateTimestamp());
+    EXPECT_EQ(mcr1.getUpdateTimestamp(), mcr2.getUpdateTimestamp());
+    EXPECT_EQ(mcr1.getVersion(), mcr2.getVersion());
+    EXPECT_EQ(mcr1.getOperationId(), mcr2.getOperationId());
+    EXPECT_EQ(mcr1.getOperationType(), mcr2.getOperationType());
+    EXPECT_EQ(mcr1.getUserId(), mcr2.getUserId());
+    EXPECT_EQ(mcr1.getColumnSetId(), mcr2.getColumnSetId());
+    EXPECT_EQ(mcr1.getPrivateDataExpirationTimestamp(), mcr2.getPrivateDataExpirationTimestamp());
+    EXPECT_EQ(mcr1.getPreviousVersionAddress().getBlockId(),
+            mcr2.getPreviousVersionAddress().getBlockId());
+    EXPECT_EQ(mcr1.getPreviousVersionAddress().getOffset(),
+            mcr2.getPreviousVersionAddress().getOffset());
+    ASSERT_EQ(mcr1.getColumnCount(), mcr2.getColumnCount());
+    for (std::size_t i = 0; i < mcr1.getColumnCount(); ++i) {
+        const auto& r1 = mcr1.getColumnRecords()[i];
+        const auto& r2 = mcr2.getColumnRecords()[i];
+        EXPECT_EQ(r1.getAddress().getBlockId(), r2.getAddress().getBlockId()) << "i=" << i;
+        EXPECT_EQ(r1.getAddress().getOffset(), r2.getAddress().getOffset()) << "i=" << i;
+        EXPECT_EQ(r1.getCreateTimestamp(), r2.getCreateTimestamp()) << "i=" << i;
+        EXPECT_EQ(r1.getUpdateTimestamp(), r2.getUpdateTimestamp()) << "i=" << i;
+    }
+}
+
+/**
+ * Serializes and deserializes master column record, checks that result is the same
+ * as original record.
+ * @param mcr Master column record.
+ * @return Serialized record without size tag.
+ */
+std::vector<std::uint8_t> checkRoundtrip(const dbengine::MasterColumnRecord& mcr)
+{
+    const auto buffer = serialize(mcr);
+    EXPECT_EQ(buffer[0], dbengine::MasterColumnRecord::kCompactFormatMarker);
+    EXPECT_EQ(buffer[1], dbengine::MasterColumnRecord::kCompactFormatVersion);
+    dbengine::MasterColumnRecord mcr2;
+    EXPECT_EQ(mcr2.deserialize(buffer.data(), buffer.size()), buffer.size());
+    checkEqual(mcr, mcr2);
+    return buffer;
+}
+
+}  // anonymous namespace
+
+TEST(Serialization, CompactRoundtrip)
+{
+    auto mcr = makeRecord(kCreateTimestamp + 3600000000ULL);
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(1, 0), kCreateTimestamp, kUpdateTimestamp);
+    mcr.addColumnRecord(dbengine::kNullValueAddress, kCreateTimestamp, kUpdateTimestamp);
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(1, 12345), kCreateTimestamp - 1,
+            kUpdateTimestamp);
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(7, 65535), kCreateTimestamp,
+            kUpdateTimestamp + 1);
+    mcr.addColumnRecord(dbengine::kDefaultValueAddress, 1, 2);
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(3, std::numeric_limits<std::uint32_t>::max()),
+            kCreateTimestamp, kUpdateTimestamp);
+    checkRoundtrip(mcr);
+
+    // No columns at all
+    checkRoundtrip(makeRecord());
+}
+
+TEST(Serialization, CompactRoundtrip_ManyColumns)
+{
+    // Bitmaps span several bytes, bits are set at byte boundaries
+    for (const std::size_t columnCount : {7U, 8U, 9U, 16U, 17U, 1000U}) {
+        auto mcr = makeRecord();
+        for (std::size_t i = 0; i < columnCount; ++i) {
+            const auto address = (i % 3 == 1) ? dbengine::kNullValueAddress
+                                              : dbengine::ColumnDataAddress(i / 5 + 1, i * 10);
+            const auto createTimestamp = (i % 8 == 7) ? i : kCreateTimestamp;
+            const auto updateTimestamp = (i % 8 == 0) ? i : kUpdateTimestamp;
+            mcr.addColumnRecord(address, createTimestamp, updateTimestamp);
+        }
+        checkRoundtrip(mcr);
+    }
+}
+
+TEST(Serialization, DecodeLegacyFormat)
+{
+    auto mcr = makeRecord(kCreateTimestamp + 1);
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(1, 100), kCreateTimestamp, kUpdateTimestamp);
+    mcr.addColumnRecord(dbengine::kNullValueAddress, kCreateTimestamp, kUpdateTimestamp);
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(5, 200), 10, 20);
+
+    // Encode record in the legacy format: all fields, then each column record as is
+    std::vector<std::uint8_t> buffer(1024);
+    auto p = buffer.data();
+    p = ::encodeVarInt(mcr.getTableRowId(), p);
+    p = ::encodeVarInt(mcr.getTransactionId(), p);
+    p = ::encodeVarInt(mcr.getCreateTimestamp(), p);
+    p = ::encodeVarInt(mcr.getUpdateTimestamp(), p);
+    p = ::encodeVarInt(mcr.getVersion(), p);
+    p = ::encodeVarInt(mcr.getOperationId(), p);
+    *p++ = static_cast<std::uint8_t>(mcr.getOperationType());
+    p = ::encodeVarInt(mcr.getUserId(), p);
+    p = ::encodeVarInt(mcr.getColumnSetId(), p);
+    p = ::encodeVarInt(mcr.getPrivateDataExpirationTimestamp(), p);
+    p = ::encodeVarInt(static_cast<std::uint32_t>(mcr.getColumnCount()), p);
+    for (const auto& r : mcr.getColumnRecords())
+        p = r.serializeUnchecked(p);
+    p = mcr.getPreviousVersionAddress().serializeUnchecked(p);
+    buffer.resize(p - buffer.data());
+    ASSERT_NE(buffer[0], dbengine::MasterColumnRecord::kCompactFormatMarker);
+
+    dbengine::MasterColumnRecord mcr2;
+    EXPECT_EQ(mcr2.deserialize(buffer.data(), buffer.size()), buffer.size());
+    checkEqual(mcr, mcr2);
+
+    // Legacy record is re-written in the compact format
+    checkRoundtrip(mcr2);
+
+    // Truncated legacy record can't be read
+    dbengine::MasterColumnRecord mcr3;
+    EXPECT_EQ(mcr3.deserialize(buffer.data(), buffer.size() - 1), 0U);
+}
+
+TEST(Serialization, RejectUnknownCompactFormatVersion)
+{
+    auto buffer = serialize(makeRecord());
+    buffer[1] = dbengine::MasterColumnRecord::kCompactFormatVersion + 1;
+    dbengine::MasterColumnRecord mcr;
+    EXPECT_EQ(mcr.deserialize(buffer.data(), buffer.size()), 0U);
+}
+
+TEST(Serialization, NullAddressAndTimestampElision)
+{
+    const auto baseSize = makeRecord().getSerializedSize();
+
+    // Null column with record timestamps takes only its bitmap bits
+    auto mcr = makeRecord();
+    for (int i = 0; i < 8; ++i)
+        mcr.addColumnRecord(dbengine::kNullValueAddress, kCreateTimestamp, kUpdateTimestamp);
+    EXPECT_EQ(mcr.getSerializedSize(), baseSize + 3);
+    checkRoundtrip(mcr);
+
+    // Non-null column with record timestamps takes block ID delta and offset
+    mcr = makeRecord();
+    mcr.addColumnRecord(dbengine::ColumnDataAddress(1, 1), kCreateTimestamp, kUpdateTimestamp);
+    EXPECT_EQ(mcr.getSerializedSize(), baseSize + 3 + 2);
+    checkRoundtrip(mcr);
+
+    // Explicit timestamps are added only when they differ from record timestamps
+    mcr = makeRecord();
+    mcr.addColumnRecord(dbengine::kNullValueAddress, kCreateTimestamp - 1, kUpdateTimestamp);
+    EXPECT_EQ(mcr.getSerializedSize(), baseSize + 3 + ::getVarIntSize(kCreateTimestamp - 1));
+    checkRoundtrip(mcr);
+
+    mcr = makeRecord();
+    mcr.addColumnRecord(dbengine::kNullValueAddress, kCreateTimestamp, 1);
+    EXPECT_EQ(mcr.getSerializedSize(), baseSize + 3 + 1);
+    const auto buffer = checkRoundtrip(mcr);
+
+    // Bitmaps follow column count: null bitmap, create and update timestamp bitmaps
+    const auto bitmapPos = buffer.size() - 3 - 1
+                           - mcr.getPreviousVersionAddress().getSerializedSize();
+    EXPECT_EQ(buffer[bitmapPos], 1U);
+    EXPECT_EQ(buffer[bitmapPos + 1], 0U);
+    EXPECT_EQ(buffer[bitmapPos + 2], 1U);
+}
+
+TEST(Serialization, BlockIdDeltaEdgeValues)
+{
+    // Block ID differences as zigzag varint: zero, small positive and negative,
+    // 7-bit boundaries and full 64-bit range wraparound
+    const std::vector<std::uint64_t> blockIds {
+            5,
+            5,
+            6,
+            4,
+            4 + 63,
+            4 + 63 - 64,
+            4 + 63 - 64 + 64,
+            4 + 63 - 64 + 64 - 65,
+            0x8000000000000000ULL,
+            0,
+            0x7FFFFFFFFFFFFFFFULL,
+            0xFFFFFFFFFFFFFFFFULL,
+            1,
+            0xFFFFFFFFFFFFFFFFULL,
+            0x8000000000000001ULL,
+    };
+    auto mcr = makeRecord();
+    for (const auto blockId : blockIds) {
+        mcr.addColumnRecord(
+                dbengine::ColumnDataAddress(blockId, 1), kCreateTimestamp, kUpdateTimestamp);
+        mcr.addColumnRecord(dbengine::kNullValueAddress, kCreateTimestamp, kUpdateTimestamp);
+    }
+    checkRoundtrip(mcr);
+
+    // Zero and small deltas take single byte
+    mcr = makeRecord();
+    const auto baseSize = mcr.getSerializedSize() + 3;
+    for (const std::uint64_t blockId : {63ULL, 63ULL, 0ULL}) {
+        mcr.addColumnRecord(
+                dbengine::ColumnDataAddress(blockId, 1), kCreateTimestamp, kUpdateTimestamp);
+    }
+    EXPECT_EQ(mcr.getSerializedSize(), baseSize + 3 * 2);
+}
+
+TEST(Serialization, ZigzagVarIntEdgeValues)
+{
+    const std::vector<std::pair<std::int64_t, unsigned>> values {
+            {0, 1},
+            {-1, 1},
+            {1, 1},
+            {-64, 1},
+            {63, 1},
+            {-65, 2},
+            {64, 2},
+            {std::numeric_limits<std::int32_t>::min(), 5},
+            {std::numeric_limits<std::int32_t>::max(), 5},
+            {std::numeric_limits<std::int64_t>::min(), 10},
+            {std::numeric_limits<std::int64_t>::max(), 10},
+            {std::numeric_limits<std::int64_t>::min() + 1, 10},
+    };
+    for (const auto& [value, expectedSize] : values) {
+        std::uint8_t buffer[16];
+        const auto end = ::encodeVarInt(value, buffer);
+        EXPECT_EQ(static_cast<unsigned>(end - buffer), expectedSize) << value;
+        EXPECT_EQ(::getVarIntSize(value), expectedSize) << value;
+        std::int64_t decodedValue = 0;
+        EXPECT_EQ(::decodeVarInt(buffer, end - buffer, decodedValue),
+                static_cast<int>(expectedSize))
+                << value;
+        EXPECT_EQ(decodedValue, value);
+
+        // Truncated value can't be decoded
+        EXPECT_LT(::decodeVarInt(buffer, end - buffer - 1, decodedValue), 1) << value;
+    }
+}
@@ -0,0 +1,197 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "dbengine/bpt/NodeKeySearch.h"
+
+// Common project headers
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// STL headers
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+namespace dbengine = siodb::iomgr::dbengine;
+
+namespace {
+
+/** Maximum number of keys in the tested key arrays */
+constexpr std::size_t kMaxKeyCount = 80;
+
+/**
+ * Returns values around sign boundaries of both signed and unsigned representation.
+ * @return Boundary values.
+ */
+template<class T>
+std::vector<T> makeBoundaryValues()
+{
+    using Signed = std::make_signed_t<T>;
+    using Unsigned = std::make_unsigned_t<T>;
+    constexpr auto kSignBit = static_cast<T>(std::numeric_limits<Signed>::min());
+    constexpr auto kMaxPositive = static_cast<T>(std::numeric_limits<Signed>::max());
+    constexpr auto kAllBits = static_cast<T>(std::numeric_limits<Unsigned>::max());
+    // Values differing only in the low half check composed 64-bit comparison
+    constexpr auto kLowHalfSignBit = static_cast<T>(Unsigned(1) << (sizeof(T) * 4 - 1));
+    return {
+            std::numeric_limits<T>::min(),
+            static_cast<T>(std::numeric_limits<T>::min() + 1),
+            static_cast<T>(kSignBit - 1),
+            kSignBit,
+            static_cast<T>(kSignBit + 1),
+            static_cast<T>(kAllBits - 1),
+            kAllBits,
+            0,
+            1,
+            static_cast<T>(kLowHalfSignBit - 1),
+            kLowHalfSignBit,
+            static_cast<T>(kLowHalfSignBit + 1),
+            static_cast<T>(kMaxPositive - 1),
+            kMaxPositive,
+            static_cast<T>(std::numeric_limits<T>::max() - 1),
+            std::numeric_limits<T>::max(),
+    };
+}
+
+/**
+ * Encodes key.
+ * @param key Key.
+ * @param buffer Output buffer.
+ */
+template<class T>
+void encodeKey(T key, std::uint8_t* buffer)
+{
+    if constexpr (sizeof(T) == 1)
+        *buffer = static_cast<std::uint8_t>(key);
+    else
+        ::pbeEncodeInt(key, buffer);
+}
+
+/**
+ * Encodes sorted keys into key array.
+ * @param keys Keys.
+ * @return Key array.
+ */
+template<class T>
+std::vector<std::uint8_t> encodeKeys(const std::vector<T>& keys)
+{
+    std::vector<std::uint8_t> result(keys.size() * sizeof(T));
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        encodeKey(keys[i], result.data() + i * sizeof(T));
+    return result;
+}
+
+/**
+ * Checks that SIMD and scalar searches find the same position as std::lower_bound()
+ * for each key of the array, its neighbours and the boundary values.
+ * @param keys Sorted keys.
+ * @param searchKeys Additional keys to search for.
+ */
+template<class T>
+void checkSearch(const std::vector<T>& keys, const std::vector<T>& searchKeys)
+{
+    constexpr auto kKeyType = std::is_signed_v<T> ? dbengine::NumericKeyType::kSignedInt
+                                                  : dbengine::NumericKeyType::kUnsignedInt;
+    const auto search = dbengine::getIntegerNodeKeySearchFunction(kKeyType, sizeof(T));
+    const auto scalarSearch = dbengine::getScalarIntegerNodeKeySearchFunction(kKeyType, sizeof(T));
+    ASSERT_NE(search, nullptr);
+    ASSERT_NE(scalarSearch, nullptr);
+
+    std::vector<T> allSearchKeys(searchKeys);
+    for (const auto key : keys) {
+        allSearchKeys.push_back(static_cast<T>(key - 1));
+        allSearchKeys.push_back(key);
+        allSearchKeys.push_back(static_cast<T>(key + 1));
+    }
+
+    const auto encodedKeys = encodeKeys(keys);
+    std::uint8_t encodedKey[sizeof(T)];
+    for (const auto key : allSearchKeys) {
+        encodeKey(key, encodedKey);
+        const auto expectedPos = static_cast<std::size_t>(
+                std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        ASSERT_EQ(scalarSearch(encodedKeys.data(), keys.size(), encodedKey), expectedPos)
+                << "key=" << +key << " count=" << keys.size();
+        ASSERT_EQ(search(encodedKeys.data(), keys.size(), encodedKey), expectedPos)
+                << "key=" << +key << " count=" << keys.size();
+    }
+}
+
+/**
+ * Checks search in the key arrays of all sizes up to kMaxKeyCount,
+ * made of boundary values and random values.
+ */
+template<class T>
+void checkSearchOverKeyArrays()
+{
+    const auto boundaryValues = makeBoundaryValues<T>();
+    std::mt19937_64 rng(sizeof(T) * 2 + std::is_signed_v<T>);
+
+    for (std::size_t count = 0; count <= kMaxKeyCount; ++count) {
+        // Boundary values first, so that they fall to various positions of SIMD lanes
+        // and of the remaining scalar tail
+        std::vector<T> keys(boundaryValues.begin(),
+                boundaryValues.begin() + std::min(count, boundaryValues.size()));
+        while (keys.size() < count)
+            keys.push_back(static_cast<T>(rng()));
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        checkSearch(keys, boundaryValues);
+        if (::testing::Test::HasFatalFailure()) return;
+    }
+
+    // Keys clustered around sign boundary
+    std::vector<T> keys;
+    const auto signBit = static_cast<T>(std::numeric_limits<std::make_signed_t<T>>::min());
+    for (int i = -20; i < 20; ++i)
+        keys.push_back(static_cast<T>(signBit + i));
+    std::sort(keys.begin(), keys.end());
+    checkSearch(keys, boundaryValues);
+}
+
+}  // anonymous namespace
+
+TEST(IntegerKeys, SearchInt32)
+{
+    checkSearchOverKeyArrays<std::int32_t>();
+}
+
+TEST(IntegerKeys, SearchUInt32)
+{
+    checkSearchOverKeyArrays<std::uint32_t>();
+}
+
+TEST(IntegerKeys, SearchInt64)
+{
+    checkSearchOverKeyArrays<std::int64_t>();
+}
+
+TEST(IntegerKeys, SearchUInt64)
+{
+    checkSearchOverKeyArrays<std::uint64_t>();
+}
+
+TEST(IntegerKeys, SearchSmallIntegers)
+{
+    checkSearchOverKeyArrays<std::int8_t>();
+    checkSearchOverKeyArrays<std::uint8_t>();
+    checkSearchOverKeyArrays<std::int16_t>();
+    checkSearchOverKeyArrays<std::uint16_t>();
+}
+
+TEST(IntegerKeys, NonIntegerKeys)
+{
+    EXPECT_EQ(dbengine::getIntegerNodeKeySearchFunction(dbengine::NumericKeyType::kNonNumeric, 8),
+            nullptr);
+    EXPECT_EQ(dbengine::getIntegerNodeKeySearchFunction(
+                      dbengine::NumericKeyType::kFloatingPoint, 8),
+            nullptr);
+    EXPECT_EQ(dbengine::getIntegerNodeKeySearchFunction(dbengine::NumericKeyType::kSignedInt, 16),
+            nullptr);
+}
@@ -0,0 +1,217 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+#include "dbengine/bpt/BPlusTreeIndex.h"
+#include "dbengine/ikt/Int64IndexKeyTraits.h"
+#include "dbengine/reg/IndexRecord.h"
+
+// Common project headers
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+namespace {
+
+/** Distance between consecutive keys, leaves gaps for absent keys */
+constexpr std::int64_t kKeyStep = 3;
+
+/** Source of the keys around zero, so that both negative and positive keys are present */
+class KeySource : public dbengine::BPlusTreeIndex::BulkLoadSource {
+public:
+    /**
+     * Initializes object of class KeySource.
+     * @param count Number of keys.
+     */
+    explicit KeySource(std::int64_t count) noexcept
+        : m_count(count)
+        , m_index(0)
+    {
+    }
+
+    /**
+     * Returns key at given position.
+     * @param index Key position.
+     * @return Key.
+     */
+    std::int64_t getKey(std::int64_t index) const noexcept
+    {
+        return (index - m_count / 2) * kKeyStep;
+    }
+
+    /**
+     * Returns value for a key.
+     * @param key A key.
+     * @return Value.
+     */
+    static std::uint64_t getValue(std::int64_t key) noexcept
+    {
+        return static_cast<std::uint64_t>(key) * 7 + 1;
+    }
+
+    /**
+     * Reads next key-value pair.
+     * @param key Key buffer.
+     * @param value Value buffer.
+     * @return true if key-value pair was read, false if there are no more pairs.
+     */
+    bool getNext(void* key, void* value) override
+    {
+        if (m_index == m_count) return false;
+        const auto k = getKey(m_index++);
+        ::pbeEncodeInt64(k, static_cast<std::uint8_t*>(key));
+        ::pbeEncodeUInt64(getValue(k), static_cast<std::uint8_t*>(value));
+        return true;
+    }
+
+private:
+    /** Number of keys */
+    const std::int64_t m_count;
+
+    /** Next key position */
+    std::int64_t m_index;
+};
+
+/**
+ * Creates table with single INT64 column and B+ tree index on it.
+ * @param tableName Table name.
+ * @return Table and index objects.
+ */
+std::pair<dbengine::TablePtr, std::unique_ptr<dbengine::BPlusTreeIndex>> createTestIndex(
+        const std::string& tableName)
+{
+    const auto database = TestEnvironment::getInstance()->findDatabaseChecked(
+            TestEnvironment::getTestDatabaseName());
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"A", siodb::COLUMN_DATA_TYPE_INT64, true},
+    };
+    auto table = database->createUserTable(std::string(tableName), dbengine::TableType::kDisk,
+            tableColumns, dbengine::User::kSuperUserId, {});
+    const dbengine::IndexColumnSpecificationList indexColumns {
+            dbengine::IndexColumnSpecification(
+                    table->findColumnChecked("A")->getCurrentColumnDefinition(), false),
+    };
+    auto index = std::make_unique<dbengine::BPlusTreeIndex>(*table, tableName + "_IDX",
+            dbengine::Int64IndexKeyTraits(), sizeof(std::uint64_t),
+            &dbengine::Int64IndexKeyTraits::compareKeys, true, indexColumns, 1024 * 1024,
+            std::nullopt);
+    return std::make_pair(std::move(table), std::move(index));
+}
+
+/**
+ * Checks that key exists and has expected value.
+ * @param index Index object.
+ * @param k A key.
+ */
+void checkKey(dbengine::BPlusTreeIndex& index, std::int64_t k)
+{
+    std::uint8_t key[sizeof(std::int64_t)];
+    std::uint8_t value[sizeof(std::uint64_t)];
+    ::pbeEncodeInt64(k, key);
+    ASSERT_EQ(index.find(key, value, 1), 1U) << k;
+    std::uint64_t v = 0;
+    ::pbeDecodeUInt64(value, &v);
+    ASSERT_EQ(v, KeySource::getValue(k)) << k;
+}
+
+/**
+ * Bulk loads B+ tree and checks that every key is found by find() and findNextKey().
+ * @param tableName Table name.
+ * @param keyCount Number of keys.
+ * @param fillFactor Node fill factor.
+ */
+void checkBulkLoadedIndex(const std::string& tableName, std::int64_t keyCount, unsigned fillFactor)
+{
+    const auto [table, indexHolder] = createTestIndex(tableName);
+    auto& index = *indexHolder;
+
+    KeySource source(keyCount);
+    ASSERT_EQ(index.bulkLoad(source, fillFactor), static_cast<std::uint64_t>(keyCount));
+
+    std::uint8_t key[sizeof(std::int64_t)];
+    std::uint8_t value[sizeof(std::uint64_t)];
+    for (std::int64_t i = 0; i < keyCount; ++i) {
+        // Existing key
+        const auto k = source.getKey(i);
+        checkKey(index, k);
+
+        // Absent key in the gap after it
+        ::pbeEncodeInt64(k + 1, key);
+        ASSERT_EQ(index.find(key, value, 1), 0U) << k + 1;
+    }
+
+    // All keys are iterated in order
+    std::int64_t foundKeyCount = 0;
+    for (bool found = index.findFirstKey(key); found; found = index.findNextKey(key, key)) {
+        std::int64_t k = 0;
+        ::pbeDecodeInt64(key, &k);
+        ASSERT_LT(foundKeyCount, keyCount);
+        ASSERT_EQ(k, source.getKey(foundKeyCount));
+        ++foundKeyCount;
+    }
+    EXPECT_EQ(foundKeyCount, keyCount);
+
+    // Next key is found also from absent key
+    ::pbeEncodeInt64(source.getKey(0) - 1, key);
+    ASSERT_TRUE(index.findNextKey(key, key));
+    std::int64_t k = 0;
+    ::pbeDecodeInt64(key, &k);
+    EXPECT_EQ(k, source.getKey(0));
+    ::pbeEncodeInt64(source.getKey(keyCount - 1), key);
+    EXPECT_FALSE(index.findNextKey(key, key));
+}
+
+}  // anonymous namespace
+
+TEST(BPlusTreeIndex, BulkLoadSingleLeafNode)
+{
+    checkBulkLoadedIndex("BPT_TEST_1", 100, 100);
+}
+
+TEST(BPlusTreeIndex, BulkLoadMultipleLevels)
+{
+    // Enough keys for two levels of the internal nodes
+    checkBulkLoadedIndex(
+            "BPT_TEST_2", 250000, dbengine::BPlusTreeIndex::kDefaultBulkLoadFillFactor);
+}
+
+TEST(BPlusTreeIndex, FlushInsertedKeys)
+{
+    auto [table, index] = createTestIndex("BPT_TEST_3");
+
+    // Leaves have free space after bulk load, so inserts don't split them
+    constexpr std::int64_t kKeyCount = 20000;
+    KeySource source(kKeyCount);
+    ASSERT_EQ(index->bulkLoad(source), static_cast<std::uint64_t>(kKeyCount));
+
+    // Modify more leaves than node cache holds, so that modified nodes are
+    // written back on eviction too
+    std::vector<std::int64_t> insertedKeys;
+    std::uint8_t key[sizeof(std::int64_t)];
+    std::uint8_t value[sizeof(std::uint64_t)];
+    for (std::int64_t i = 0; i < kKeyCount; i += 100) {
+        const auto k = source.getKey(i) + 1;
+        ::pbeEncodeInt64(k, key);
+        ::pbeEncodeUInt64(KeySource::getValue(k), value);
+        ASSERT_TRUE(index->insert(key, value)) << k;
+        insertedKeys.push_back(k);
+    }
+    index->flush();
+
+    // Reopen index
+    const dbengine::IndexRecord indexRecord(*index);
+    index.reset();
+    index = std::make_unique<dbengine::BPlusTreeIndex>(*table, indexRecord,
+            dbengine::Int64IndexKeyTraits(), sizeof(std::uint64_t),
+            &dbengine::Int64IndexKeyTraits::compareKeys);
+
+    for (std::int64_t i = 0; i < kKeyCount; ++i)
+        checkKey(*index, source.getKey(i));
+    for (const auto k : insertedKeys)
+        checkKey(*index, k);
+
+    std::size_t foundKeyCount = 0;
+    for (bool found = index->findFirstKey(key); found; found = index->findNextKey(key, key))
+        ++foundKeyCount;
+    EXPECT_EQ(foundKeyCount, kKeyCount + insertedKeys.size());
+}
@@ -0,0 +1,238 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+#include "dbengine/ColumnDataBlock.h"
+#include "dbengine/DatabaseBackup.h"
+#include "dbengine/handlers/RequestHandler.h"
+#include "dbengine/parser/DBEngineSqlRequestFactory.h"
+#include "dbengine/parser/SqlParser.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/protobuf/ProtobufMessageIO.h>
+#include <siodb/common/stl_ext/sstream_ext.h>
+#include <siodb/common/stl_wrap/filesystem_wrapper.h>
+#include <siodb/common/utils/FSUtils.h>
+
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <chrono>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace parser_ns = dbengine::parser;
+
+namespace {
+
+/** Manifest block entry */
+struct ManifestBlock {
+    std::uint32_t m_tableId = 0;
+    std::uint64_t m_columnId = 0;
+    std::uint64_t m_blockId = 0;
+    std::uint64_t m_prevBlockId = 0;
+    bool m_sealed = false;
+    std::uint64_t m_dataLength = 0;
+    std::string m_digest;
+    std::string m_path;
+};
+
+/**
+ * Executes BACKUP DATABASE statement.
+ * @param databaseName Database name.
+ * @param backupDir Backup directory.
+ * @return Free text messages of the response.
+ */
+std::vector<std::string> backupDatabase(
+        const std::string& databaseName, const std::string& backupDir)
+{
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+    const auto statement =
+            stdext::concat("BACKUP DATABASE ", databaseName, " TO '", backupDir, '\'');
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    const auto request = factory.createSqlRequest();
+
+    requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+    siodb::iomgr_protocol::DatabaseEngineResponse response;
+    siodb::protobuf::StreamInputStream inputStream(
+            TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+    siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+            response, inputStream);
+
+    EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+    EXPECT_EQ(response.message_size(), 0);
+    EXPECT_FALSE(response.has_affected_row_count());
+    return std::vector<std::string>(
+            response.freetext_message().begin(), response.freetext_message().end());
+}
+
+/**
+ * Reads block entries of the backup manifest.
+ * @param manifestFilePath Manifest file path.
+ * @return Block entries.
+ */
+std::vector<ManifestBlock> readManifest(const std::string& manifestFilePath)
+{
+    std::vector<ManifestBlock> blocks;
+    std::ifstream ifs(manifestFilePath);
+    EXPECT_TRUE(ifs.is_open()) << manifestFilePath;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        std::istringstream iss(line);
+        std::string keyword;
+        iss >> keyword;
+        if (keyword != "block") continue;
+        ManifestBlock block;
+        std::string kind;
+        iss >> block.m_tableId >> block.m_columnId >> block.m_blockId >> block.m_prevBlockId
+                >> kind >> block.m_dataLength >> block.m_digest >> block.m_path;
+        EXPECT_FALSE(iss.fail()) << line;
+        block.m_sealed = kind == "sealed";
+        blocks.push_back(std::move(block));
+    }
+    return blocks;
+}
+
+/**
+ * Reads whole file.
+ * @param path File path.
+ * @return File contents.
+ */
+std::string readFile(const std::string& path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    return oss.str();
+}
+
+}  // anonymous namespace
+
+TEST(Backup, BackupDatabase)
+{
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+    const std::string databaseName("BACKUP_TEST_DB");
+    const auto database = instance->createDatabase(std::string(databaseName), "none",
+            siodb::BinaryValue(), {}, std::numeric_limits<std::uint32_t>::max() / 2, {}, false,
+            dbengine::User::kSuperUserId);
+
+    // Create table
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"A", siodb::COLUMN_DATA_TYPE_TEXT, true},
+    };
+    const auto table = database->createUserTable("BACKUP_TEST_1", dbengine::TableType::kDisk,
+            tableColumns, dbengine::User::kSuperUserId, {});
+    const auto column = table->findColumnChecked("A");
+
+    // Insert more data than fits into single block, so that column has
+    // sealed blocks and open last block
+    constexpr std::size_t kValueSize = 1024 * 1024;
+    const std::size_t rowCount = siodb::kDefaultDataFileDataAreaSize / kValueSize + 2;
+    const auto insertRows = [&](std::size_t count) {
+        const dbengine::TransactionParameters tp(dbengine::User::kSuperUserId,
+                database->generateNextTransactionId(), std::time(nullptr));
+        for (std::size_t i = 0; i < count; ++i) {
+            std::vector<dbengine::Variant> values {
+                    dbengine::Variant(std::string(kValueSize, static_cast<char>('a' + i % 26)))};
+            table->insertRow(std::move(values), tp);
+        }
+    };
+    insertRows(rowCount);
+    ASSERT_GT(column->getLastBlockId(), 1U);
+
+    const auto backupDir = (fs::path(instance->getDataDir()).parent_path() / "backup").string();
+    const auto blockStoreDir =
+            siodb::utils::constructPath(backupDir, dbengine::DatabaseBackup::kBlockStoreDir);
+
+    // ----------- First backup -----------
+    const auto messages1 = backupDatabase(databaseName, backupDir);
+    ASSERT_EQ(messages1.size(), 2U);
+    const std::string manifestPrefix("Backup manifest: ");
+    ASSERT_EQ(messages1[0].compare(0, manifestPrefix.length(), manifestPrefix), 0)
+            << messages1[0];
+    const auto blocks1 = readManifest(messages1[0].substr(manifestPrefix.length()));
+
+    std::size_t sealedBlockCount = 0, columnSealedBlockCount = 0, columnSnapshotBlockCount = 0;
+    for (const auto& block : blocks1) {
+        const auto path = siodb::utils::constructPath(backupDir, block.m_path);
+        ASSERT_TRUE(fs::exists(path)) << path;
+        if (block.m_sealed) ++sealedBlockCount;
+        if (block.m_tableId != table->getId() || block.m_columnId != column->getId()) continue;
+        const auto blockFilePath = siodb::utils::constructPath(column->getDataDir(),
+                dbengine::ColumnDataBlock::kBlockFilePrefix, block.m_blockId,
+                siodb::kDataFileExtension);
+        if (block.m_sealed) {
+            // Sealed block is stored in the block store under its digest, as is
+            ++columnSealedBlockCount;
+            EXPECT_EQ(fs::path(path).parent_path(), fs::path(blockStoreDir));
+            EXPECT_EQ(fs::path(path).stem().string(), block.m_digest);
+            EXPECT_GT(block.m_dataLength, 0U);
+            EXPECT_TRUE(readFile(path) == readFile(blockFilePath)) << block.m_blockId;
+        } else {
+            // Open block is saved as snapshot of its current data
+            ++columnSnapshotBlockCount;
+            EXPECT_EQ(block.m_digest, "-");
+            EXPECT_EQ(block.m_blockId, column->getLastBlockId());
+            EXPECT_GE(fs::file_size(path),
+                    block.m_dataLength + dbengine::ColumnDataBlockHeader::kSerializedSize);
+        }
+    }
+    EXPECT_GT(columnSealedBlockCount, 0U);
+    EXPECT_EQ(columnSnapshotBlockCount, 1U);
+    EXPECT_EQ(messages1[1],
+            stdext::concat("Backed up ", blocks1.size(), " blocks: ", sealedBlockCount,
+                    " sealed blocks copied, 0 sealed blocks already stored, ",
+                    blocks1.size() - sealedBlockCount, " open block snapshots"));
+
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(
+                      fs::directory_iterator(blockStoreDir), fs::directory_iterator())),
+            sealedBlockCount);
+
+    // Backup directory name contains timestamp in seconds
+    const auto firstBackupTime = std::time(nullptr);
+    while (std::time(nullptr) == firstBackupTime)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // ----------- Second backup -----------
+    // Changes open block only, so that sealed blocks are not copied again
+    const auto lastBlockId = column->getLastBlockId();
+    insertRows(1);
+    ASSERT_EQ(column->getLastBlockId(), lastBlockId);
+
+    const auto messages2 = backupDatabase(databaseName, backupDir);
+    ASSERT_EQ(messages2.size(), 2U);
+    ASSERT_EQ(messages2[0].compare(0, manifestPrefix.length(), manifestPrefix), 0)
+            << messages2[0];
+    EXPECT_NE(messages2[0], messages1[0]);
+    const auto blocks2 = readManifest(messages2[0].substr(manifestPrefix.length()));
+    ASSERT_EQ(blocks2.size(), blocks1.size());
+    for (std::size_t i = 0; i < blocks2.size(); ++i) {
+        EXPECT_EQ(blocks2[i].m_blockId, blocks1[i].m_blockId);
+        EXPECT_EQ(blocks2[i].m_sealed, blocks1[i].m_sealed);
+        if (blocks2[i].m_sealed) {
+            EXPECT_EQ(blocks2[i].m_digest, blocks1[i].m_digest);
+            EXPECT_EQ(blocks2[i].m_path, blocks1[i].m_path);
+        } else {
+            EXPECT_NE(blocks2[i].m_path, blocks1[i].m_path);
+            EXPECT_TRUE(fs::exists(siodb::utils::constructPath(backupDir, blocks2[i].m_path)));
+        }
+    }
+    EXPECT_EQ(messages2[1],
+            stdext::concat("Backed up ", blocks2.size(), " blocks: 0 sealed blocks copied, ",
+                    sealedBlockCount, " sealed blocks already stored, ",
+                    blocks2.size() - sealedBlockCount, " open block snapshots"));
+
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(
+                      fs::directory_iterator(blockStoreDir), fs::directory_iterator())),
+            sealedBlockCount);
+}
@@ -1533,3 +1533,55 @@ TEST(DDL, SetTableAttributes_NextTrid)
         EXPECT_EQ(response.response_count(), 1U);
     }
 }
+
+TEST(DDL, SetTableAttributes_Ttl)
+{
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+
+    {
+        // ----------- CREATE TABLE -----------
+        const std::string statement("CREATE TABLE DDL_TEST_TABLE_445 (TEST_INTEGER INTEGER)");
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_FALSE(response.has_affected_row_count());
+        EXPECT_EQ(response.response_id(), 0U);
+        EXPECT_EQ(response.response_count(), 1U);
+    }
+
+    {
+        // ----------- ALTER TABLE -----------
+        const std::string statement("ALTER TABLE DDL_TEST_TABLE_445 SET TTL=3600");
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_FALSE(response.has_affected_row_count());
+        EXPECT_EQ(response.response_id(), 0U);
+        EXPECT_EQ(response.response_count(), 1U);
+    }
+}
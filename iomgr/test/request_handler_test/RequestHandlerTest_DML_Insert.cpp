@@ -8,6 +8,10 @@
 #include "dbengine/parser/SqlParser.h"
 
 // Common project headers
+#include <siodb/common/io/BufferedChunkedOutputStream.h>
+#include <siodb/common/io/ChunkedInputStream.h>
+#include <siodb/common/io/DynamicMemoryOutputStream.h>
+#include <siodb/common/io/MemoryInputStream.h>
 #include <siodb/common/log/Log.h>
 #include <siodb/common/protobuf/ExtendedCodedInputStream.h>
 #include <siodb/common/protobuf/ProtobufMessageIO.h>
@@ -1231,3 +1235,107 @@ TEST(DML_Insert, InsertSingleRecordIntoBigTable)
         }
     }
 }
+
+TEST(DML_Insert, CopyFromStdinCsv)
+{
+    constexpr std::size_t kInsertRows = 2500;
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+
+    // create table
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"FIRST_NAME", siodb::COLUMN_DATA_TYPE_TEXT, true},
+            {"LAST_NAME", siodb::COLUMN_DATA_TYPE_TEXT, true},
+    };
+
+    instance->findDatabase("SYS")->createUserTable("TEST_COPY_CUSTOMERS",
+            dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+
+    // ----------- COPY -----------
+    {
+        // More rows than fit into single COPY batch, columns are listed in other order
+        siodb::io::DynamicMemoryOutputStream data;
+        {
+            siodb::io::BufferedChunkedOutputStream chunkedOutput(4096, data);
+            for (std::size_t i = 0; i < kInsertRows; ++i) {
+                const auto row = "LAST" + std::to_string(i) + ",FIRST" + std::to_string(i) + "\n";
+                ASSERT_EQ(chunkedOutput.write(row.data(), row.size()),
+                        static_cast<std::ptrdiff_t>(row.size()));
+            }
+        }
+        siodb::io::MemoryInputStream rawInput(data.data(), data.size());
+        siodb::io::ChunkedInputStream chunkedInput(rawInput);
+
+        const std::string statement(
+                "COPY SYS.TEST_COPY_CUSTOMERS (LAST_NAME, FIRST_NAME) FROM STDIN");
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser, &chunkedInput);
+        const auto request = factory.createSqlRequest();
+        ASSERT_EQ(request->m_requestType, requests::DBEngineRequestType::kCopyFrom);
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_TRUE(response.has_affected_row_count());
+        ASSERT_EQ(response.affected_row_count(), kInsertRows);
+    }
+
+    // ----------- SELECT -----------
+    {
+        const std::string statement("SELECT * FROM SYS.TEST_COPY_CUSTOMERS");
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_FALSE(response.has_affected_row_count());
+        ASSERT_EQ(response.column_description_size(), 3);  // + TRID
+        EXPECT_EQ(response.column_description(1).name(), "FIRST_NAME");
+        EXPECT_EQ(response.column_description(2).name(), "LAST_NAME");
+
+        siodb::protobuf::ExtendedCodedInputStream codedInput(&inputStream);
+
+        std::uint64_t rowLength = 0;
+        for (std::size_t i = 0; i < kInsertRows; ++i) {
+            rowLength = 0;
+            ASSERT_TRUE(codedInput.ReadVarint64(&rowLength));
+            ASSERT_GT(rowLength, 0U);
+
+            std::uint64_t trid = 0;
+            ASSERT_TRUE(codedInput.Read(&trid));
+            ASSERT_EQ(trid, i + 1);
+
+            std::string name;
+            ASSERT_TRUE(codedInput.Read(&name));
+            EXPECT_EQ(name, "FIRST" + std::to_string(i));
+
+            ASSERT_TRUE(codedInput.Read(&name));
+            EXPECT_EQ(name, "LAST" + std::to_string(i));
+        }
+
+        ASSERT_TRUE(codedInput.ReadVarint64(&rowLength));
+        EXPECT_EQ(rowLength, 0U);
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+#include "dbengine/ColumnDataBlock.h"
+#include "dbengine/DataScrubber.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+#include <siodb/common/utils/FDGuard.h>
+#include <siodb/common/utils/FSUtils.h>
+
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <chrono>
+#include <thread>
+
+// System headers
+#include <fcntl.h>
+#include <unistd.h>
+
+TEST(DataScrubber, ReportCorruptedBlock)
+{
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+    const auto database = instance->findDatabaseChecked(TestEnvironment::getTestDatabaseName());
+
+    // Create table
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"A", siodb::COLUMN_DATA_TYPE_TEXT, true},
+    };
+    const auto table = database->createUserTable("DATA_SCRUBBER_TEST_1",
+            dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+    const auto column = table->findColumnChecked("A");
+
+    // Insert more data than fits into single block, so that first block gets closed
+    const dbengine::TransactionParameters tp(dbengine::User::kSuperUserId,
+            database->generateNextTransactionId(), std::time(nullptr));
+    constexpr std::size_t kValueSize = 1024 * 1024;
+    const std::size_t rowCount = siodb::kDefaultDataFileDataAreaSize / kValueSize + 2;
+    for (std::size_t i = 0; i < rowCount; ++i) {
+        std::vector<dbengine::Variant> values {
+                dbengine::Variant(std::string(kValueSize, static_cast<char>('a' + i % 26)))};
+        table->insertRow(std::move(values), tp);
+    }
+    ASSERT_GT(column->getLastBlockId(), 1U);
+
+    // Damage data of the first block
+    constexpr std::uint64_t kBlockId = 1;
+    const auto blockFilePath = siodb::utils::constructPath(column->getDataDir(),
+            dbengine::ColumnDataBlock::kBlockFilePrefix, kBlockId, siodb::kDataFileExtension);
+    siodb::FDGuard fd(::open(blockFilePath.c_str(), O_RDWR));
+    ASSERT_TRUE(fd.isValidFd());
+    const off_t damagedByteOffset = dbengine::ColumnDataBlockHeader::kDefaultDataAreaOffset + 1000;
+    char originalByte = 0;
+    ASSERT_EQ(::pread(fd.getFD(), &originalByte, 1, damagedByteOffset), 1);
+    const char damagedByte = ~originalByte;
+    ASSERT_EQ(::pwrite(fd.getFD(), &damagedByte, 1, damagedByteOffset), 1);
+
+    // Verification is forced by verification time in the future
+    std::size_t dataSize = 0;
+    EXPECT_FALSE(column->verifyBlock(kBlockId, std::time(nullptr) + 3600, dataSize));
+    EXPECT_GT(dataSize, 0U);
+
+    // Run scrubber over the whole instance
+    {
+        dbengine::DataScrubber scrubber(*instance, 1024, 0, 0);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(2);
+        while (scrubber.getStatus().m_passNumber == 0
+                && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        const auto status = scrubber.getStatus();
+        ASSERT_GT(status.m_passNumber, 0U);
+        EXPECT_GT(status.m_verifiedBlockCount, 0U);
+        EXPECT_EQ(status.m_failedBlockCount, 1U);
+        const auto blockCode = column->makeDisplayCode() + '.' + std::to_string(kBlockId);
+        EXPECT_NE(status.m_lastFailure.find(blockCode), std::string::npos)
+                << status.m_lastFailure;
+    }
+
+    // Repaired block passes verification
+    ASSERT_EQ(::pwrite(fd.getFD(), &originalByte, 1, damagedByteOffset), 1);
+    EXPECT_TRUE(column->verifyBlock(kBlockId, std::time(nullptr) + 3600, dataSize));
+    EXPECT_GT(dataSize, 0U);
+}
@@ -0,0 +1,280 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+#include "dbengine/handlers/RequestHandler.h"
+#include "dbengine/handlers/RequestHandlerSharedConstants.h"
+#include "dbengine/parser/DBEngineSqlRequestFactory.h"
+#include "dbengine/parser/SqlParser.h"
+
+// Common project headers
+#include <siodb/common/protobuf/ExtendedCodedInputStream.h>
+#include <siodb/common/protobuf/ProtobufMessageIO.h>
+#include <siodb/common/protobuf/StreamInputStream.h>
+
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <algorithm>
+#include <optional>
+
+namespace parser_ns = dbengine::parser;
+
+namespace {
+
+/** Number of rows in the test table, enough for several scan partitions */
+constexpr std::int64_t kRowCount = 100000;
+
+/** Row time to live of the test table */
+constexpr std::time_t kRowTtl = 3600;
+
+/** Size of the LOB values which are read via LOB streams */
+constexpr std::size_t kLargeLobSize = 0x100000 + 100;
+
+/** Row with the invalid date string */
+constexpr std::int64_t kInvalidDateRow = 70000;
+
+/** Test table name */
+const std::string kTableName("PARALLEL_SCAN_TEST_1");
+
+/**
+ * Returns indication that row is deleted.
+ * @param a Value of column A.
+ * @return true if row is deleted, false otherwise.
+ */
+bool isDeletedRow(std::int64_t a) noexcept
+{
+    // Whole range of rows is deleted too, so that some partition is sparse
+    return a % 1000 == 5 || (a >= 40000 && a < 45000);
+}
+
+/**
+ * Returns indication that row is expired.
+ * @param a Value of column A.
+ * @return true if row is expired, false otherwise.
+ */
+bool isExpiredRow(std::int64_t a) noexcept
+{
+    return a % 1000 == 7;
+}
+
+/**
+ * Returns indication that row is visible.
+ * @param a Value of column A.
+ * @return true if row is neither deleted nor expired, false otherwise.
+ */
+bool isLiveRow(std::int64_t a) noexcept
+{
+    return !isDeletedRow(a) && !isExpiredRow(a);
+}
+
+/**
+ * Returns value of column B, which is not ordered like rows.
+ * @param a Value of column A.
+ * @return Value of column B or nothing if it is NULL.
+ */
+std::optional<std::int32_t> getValueB(std::int64_t a) noexcept
+{
+    if (a % 97 == 0) return std::nullopt;
+    return static_cast<std::int32_t>(a * 7919 % 1000);
+}
+
+/**
+ * Returns size of the LOB values in a row.
+ * @param a Value of column A.
+ * @return LOB value size.
+ */
+std::size_t getLobSize(std::int64_t a) noexcept
+{
+    return (a % 25000 == 1) ? kLargeLobSize : static_cast<std::size_t>(a % 64);
+}
+
+/**
+ * Returns test table, creating it on the first call.
+ * @return Table object.
+ */
+dbengine::TablePtr getTestTable()
+{
+    static const auto table = [] {
+        const auto database = TestEnvironment::getInstance()->findDatabaseChecked(
+                TestEnvironment::getTestDatabaseName());
+        const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+                {"A", siodb::COLUMN_DATA_TYPE_INT64, true},
+                {"B", siodb::COLUMN_DATA_TYPE_INT32, false},
+                {"C", siodb::COLUMN_DATA_TYPE_TEXT, true},
+                {"D", siodb::COLUMN_DATA_TYPE_BINARY, true},
+                {"S", siodb::COLUMN_DATA_TYPE_TEXT, true},
+                {"T", siodb::COLUMN_DATA_TYPE_TIMESTAMP, true},
+        };
+        auto table = database->createUserTable(std::string(kTableName),
+                dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+        table->setRowTtl(kRowTtl);
+
+        const siodb::RawDateTime dateTime("2030-01-01", siodb::RawDateTime::kDefaultDateFormat);
+        const auto currentTime = std::time(nullptr);
+        std::vector<std::uint64_t> deletedTrids;
+        for (std::int64_t a = 0; a < kRowCount; ++a) {
+            const dbengine::TransactionParameters tp(dbengine::User::kSuperUserId,
+                    database->generateNextTransactionId(),
+                    isExpiredRow(a) ? currentTime - kRowTtl * 2 : currentTime);
+            const auto b = getValueB(a);
+            const auto lobSize = getLobSize(a);
+            // String S is compared with timestamp T, which fails for invalid date
+            std::vector<dbengine::Variant> values {
+                    dbengine::Variant(a),
+                    b ? dbengine::Variant(*b) : dbengine::Variant(),
+                    dbengine::Variant(std::string(lobSize, static_cast<char>('a' + a % 26))),
+                    dbengine::Variant(siodb::BinaryValue(lobSize, static_cast<std::uint8_t>(a))),
+                    dbengine::Variant(
+                            std::string(a == kInvalidDateRow ? "invalid date" : "2021-06-15")),
+                    dbengine::Variant(dateTime),
+            };
+            const auto trid = table->insertRow(std::move(values), tp).m_mcr->getTableRowId();
+            if (isDeletedRow(a)) deletedTrids.push_back(trid);
+        }
+
+        const dbengine::TransactionParameters tp(dbengine::User::kSuperUserId,
+                database->generateNextTransactionId(), currentTime);
+        for (const auto trid : deletedTrids)
+            table->deleteRow(trid, tp);
+        return table;
+    }();
+    return table;
+}
+
+/**
+ * Executes SELECT statement and reads result rows.
+ * @param statement SELECT statement.
+ * @return Serialized result rows.
+ */
+std::vector<std::string> selectRows(const std::string& statement)
+{
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    const auto request = factory.createSqlRequest();
+
+    requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+    siodb::iomgr_protocol::DatabaseEngineResponse response;
+    siodb::protobuf::StreamInputStream inputStream(
+            TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+    siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+            response, inputStream);
+    EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+    EXPECT_EQ(response.message_size(), 0);
+
+    std::vector<std::string> rows;
+    siodb::protobuf::ExtendedCodedInputStream codedInput(&inputStream);
+    std::uint64_t rowLength = 0;
+    while (codedInput.ReadVarint64(&rowLength) && rowLength > 0) {
+        auto& row = rows.emplace_back();
+        if (!codedInput.ReadString(&row, static_cast<int>(rowLength))) {
+            ADD_FAILURE() << "Can't read row " << rows.size() << ": " << statement;
+            break;
+        }
+    }
+    return rows;
+}
+
+/**
+ * Checks that parallel scan returns the same rows as sequential scan.
+ * @param columns Result columns.
+ * @param condition WHERE clause or empty string.
+ * @param isMatchingRow Predicate selecting expected rows by value of column A.
+ */
+template<class Predicate>
+void checkParallelScan(
+        const std::string& columns, const std::string& condition, Predicate isMatchingRow)
+{
+    const auto scanThreadPool = TestEnvironment::getInstance()->getScanThreadPool();
+    const auto statement = "SELECT " + columns + " FROM " + TestEnvironment::getTestDatabaseName()
+                           + '.' + kTableName + condition;
+
+    const auto submittedTaskCount = scanThreadPool->getSubmittedTaskCount();
+    const auto parallelRows = selectRows(statement);
+    EXPECT_GE(scanThreadPool->getSubmittedTaskCount(), submittedTaskCount + 2) << statement;
+    EXPECT_EQ(scanThreadPool->getUnfinishedTaskCount(), 0U) << statement;
+
+    // Table is scanned sequentially when rows are counted for LIMIT
+    const auto limitedStatement = statement + " LIMIT " + std::to_string(kRowCount);
+    const auto sequentialSubmittedTaskCount = scanThreadPool->getSubmittedTaskCount();
+    const auto sequentialRows = selectRows(limitedStatement);
+    EXPECT_EQ(scanThreadPool->getSubmittedTaskCount(), sequentialSubmittedTaskCount);
+
+    std::size_t expectedRowCount = 0;
+    for (std::int64_t a = 0; a < kRowCount; ++a)
+        expectedRowCount += (isLiveRow(a) && isMatchingRow(a)) ? 1 : 0;
+    EXPECT_EQ(sequentialRows.size(), expectedRowCount) << statement;
+    ASSERT_EQ(parallelRows.size(), sequentialRows.size()) << statement;
+    // Rows are compared without printing, since they may contain large LOBs
+    const auto mismatch =
+            std::mismatch(parallelRows.begin(), parallelRows.end(), sequentialRows.begin());
+    EXPECT_TRUE(mismatch.first == parallelRows.end())
+            << statement << ": row " << (mismatch.first - parallelRows.begin()) << " differs";
+}
+
+}  // anonymous namespace
+
+TEST(ParallelScan, CompareWithSequentialScan)
+{
+    const auto scanThreadPool = TestEnvironment::getInstance()->getScanThreadPool();
+    ASSERT_NE(scanThreadPool, nullptr);
+    ASSERT_GT(scanThreadPool->getThreadCount(), 1U);
+    ASSERT_GT(kRowCount / dbengine::kMinParallelScanPartitionSize, 1U);
+    getTestTable();
+
+    // Plain scan, deleted and expired rows are skipped
+    checkParallelScan("A, B", "", [](std::int64_t) { return true; });
+
+    // WHERE on column with values spread over all data blocks
+    checkParallelScan("A, B", " WHERE B < 100", [](std::int64_t a) {
+        const auto b = getValueB(a);
+        return b && *b < 100;
+    });
+
+    // WHERE on ordered column, data blocks outside of range are pruned by zone maps
+    checkParallelScan("A, C", " WHERE A >= 60000 AND A < 61000",
+            [](std::int64_t a) { return a >= 60000 && a < 61000; });
+
+    // Large LOBs are read via LOB streams
+    checkParallelScan("*", "", [](std::int64_t) { return true; });
+    checkParallelScan("A, C, D", " WHERE A >= 24000 AND A < 27000",
+            [](std::int64_t a) { return a >= 24000 && a < 27000; });
+}
+
+TEST(ParallelScan, ErrorInPartition)
+{
+    const auto scanThreadPool = TestEnvironment::getInstance()->getScanThreadPool();
+    ASSERT_NE(scanThreadPool, nullptr);
+    getTestTable();
+    const auto statement = "SELECT A FROM " + TestEnvironment::getTestDatabaseName() + '.'
+                           + kTableName + " WHERE S < T";
+
+    // Sequential scan returns rows preceding the invalid one
+    const auto sequentialRows = selectRows(statement + " LIMIT " + std::to_string(kRowCount));
+    std::size_t precedingRowCount = 0;
+    for (std::int64_t a = 0; a < kInvalidDateRow; ++a)
+        precedingRowCount += isLiveRow(a) ? 1 : 0;
+    EXPECT_EQ(sequentialRows.size(), precedingRowCount);
+
+    // Parallel scan returns only rows of the partitions preceding the failed one.
+    // Other partitions are cancelled, and all submitted tasks are completed
+    // by the time the request is finished.
+    const auto submittedTaskCount = scanThreadPool->getSubmittedTaskCount();
+    const auto parallelRows = selectRows(statement);
+    EXPECT_EQ(scanThreadPool->getUnfinishedTaskCount(), 0U);
+    EXPECT_GE(scanThreadPool->getSubmittedTaskCount(), submittedTaskCount + 2);
+    ASSERT_LT(parallelRows.size(), sequentialRows.size());
+    EXPECT_TRUE(std::equal(parallelRows.begin(), parallelRows.end(), sequentialRows.begin()));
+
+    // Next request is processed normally
+    checkParallelScan("A", " WHERE B = 0", [](std::int64_t a) {
+        const auto b = getValueB(a);
+        return b && *b == 0;
+    });
+}
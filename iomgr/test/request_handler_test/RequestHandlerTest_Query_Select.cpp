@@ -13,8 +13,10 @@
 #include <siodb/common/protobuf/ExtendedCodedInputStream.h>
 #include <siodb/common/protobuf/ProtobufMessageIO.h>
 #include <siodb/common/protobuf/RawDateTimeIO.h>
+#include <siodb/iomgr/shared/dbengine/util/RecordBatchDecoder.h>
 
 namespace parser_ns = dbengine::parser;
+namespace util_ns = dbengine::util;
 
 // SELECT * FROM SYS.SYS_DATABASES
 TEST(Query, SelectFromSysDatabases)
@@ -1205,3 +1207,195 @@ TEST(Query, SelectWithWhereEqualNull)
         ASSERT_TRUE(rowLength == 0);
     }
 }
+
+/**
+ * SELECT I FROM ZONE_MAP_TEST_TABLE_1 WHERE <conditions checked with zone maps>
+ */
+TEST(Query, SelectWithWhereUsingZoneMaps)
+{
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"I", siodb::COLUMN_DATA_TYPE_INT64, true},
+            {"V", siodb::COLUMN_DATA_TYPE_INT64, false},
+    };
+
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+    instance->findDatabase("SYS")->createUserTable("ZONE_MAP_TEST_TABLE_1",
+            dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+
+    siodb::protobuf::StreamInputStream inputStream(
+            TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+
+    {
+        const std::string statement(
+                "INSERT INTO SYS.ZONE_MAP_TEST_TABLE_1 VALUES (1, 10), (2, NULL), (3, 20), "
+                "(4, 30)");
+
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_TRUE(response.has_affected_row_count());
+        ASSERT_EQ(response.affected_row_count(), 4U);
+    }
+
+    const std::vector<std::pair<std::string, std::vector<std::int64_t>>> testCases {
+            {"25 > V AND V >= 10", {1, 3}},
+            {"V = 30", {4}},
+            {"V BETWEEN 15 AND 30", {3, 4}},
+            {"V BETWEEN 40 AND 50", {}},
+            {"V < 10", {}},
+    };
+
+    for (const auto& testCase : testCases) {
+        const auto statement =
+                "SELECT I FROM SYS.ZONE_MAP_TEST_TABLE_1 WHERE " + testCase.first;
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        ASSERT_EQ(response.column_description_size(), 1);
+        ASSERT_FALSE(response.column_description(0).is_nullable());
+
+        siodb::protobuf::ExtendedCodedInputStream codedInput(&inputStream);
+
+        std::uint64_t rowLength = 0;
+        for (const auto expectedValue : testCase.second) {
+            ASSERT_TRUE(codedInput.ReadVarint64(&rowLength));
+            ASSERT_GT(rowLength, 0U);
+
+            std::int64_t value = 0;
+            ASSERT_TRUE(codedInput.Read(&value));
+            EXPECT_EQ(value, expectedValue) << statement;
+        }
+
+        ASSERT_TRUE(codedInput.ReadVarint64(&rowLength));
+        EXPECT_EQ(rowLength, 0U) << statement;
+    }
+}
+
+/**
+ * SELECT * FROM COLUMNAR_TEST_TABLE_1 with columnar rowset format
+ */
+TEST(Query, SelectColumnarRowset)
+{
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"I", siodb::COLUMN_DATA_TYPE_INT32, true},
+            {"T", siodb::COLUMN_DATA_TYPE_TEXT, false},
+            {"D", siodb::COLUMN_DATA_TYPE_DOUBLE, false},
+    };
+
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+    instance->findDatabase("SYS")->createUserTable("COLUMNAR_TEST_TABLE_1",
+            dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+
+    siodb::protobuf::StreamInputStream inputStream(
+            TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+
+    {
+        const std::string statement(
+                "INSERT INTO SYS.COLUMNAR_TEST_TABLE_1 VALUES (1, 'a', 1.5), (2, NULL, NULL), "
+                "(3, 'ccc', 3.5)");
+
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_TRUE(response.has_affected_row_count());
+        ASSERT_EQ(response.affected_row_count(), 3U);
+    }
+
+    {
+        requestHandler->setRowsetFormat(siodb::ROWSET_FORMAT_COLUMNAR);
+
+        const std::string statement("SELECT * FROM SYS.COLUMNAR_TEST_TABLE_1");
+        parser_ns::SqlParser parser(statement);
+        parser.parse();
+
+        parser_ns::DBEngineSqlRequestFactory factory(parser);
+        const auto request = factory.createSqlRequest();
+
+        requestHandler->executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+        siodb::iomgr_protocol::DatabaseEngineResponse response;
+        siodb::protobuf::readMessage(siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse,
+                response, inputStream);
+
+        EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+        ASSERT_EQ(response.message_size(), 0);
+        EXPECT_EQ(response.rowset_format(), siodb::ROWSET_FORMAT_COLUMNAR);
+        ASSERT_EQ(response.column_description_size(), 4);  // + TRID
+
+        std::vector<siodb::ColumnDataType> dataTypes;
+        std::unique_ptr<bool[]> nullableColumns(new bool[response.column_description_size()]);
+        for (int i = 0; i < response.column_description_size(); ++i) {
+            dataTypes.push_back(response.column_description(i).type());
+            nullableColumns[i] = response.column_description(i).is_nullable();
+        }
+
+        siodb::protobuf::ExtendedCodedInputStream codedInput(&inputStream);
+
+        std::uint64_t batchLength = 0;
+        ASSERT_TRUE(codedInput.ReadVarint64(&batchLength));
+        ASSERT_GT(batchLength, 0);
+        std::vector<std::uint8_t> batchData(batchLength);
+        ASSERT_TRUE(codedInput.ReadRaw(batchData.data(), batchLength));
+
+        const auto rows = util_ns::decodeRecordBatch(batchData.data(), batchData.size(),
+                dataTypes.size(), dataTypes.data(), nullableColumns.get());
+        ASSERT_EQ(rows.size(), 3U);
+
+        EXPECT_EQ(rows[0][0].getUInt64(), 1U);
+        EXPECT_EQ(rows[0][1].getInt32(), 1);
+        EXPECT_EQ(rows[0][2].getString(), "a");
+        EXPECT_DOUBLE_EQ(rows[0][3].getDouble(), 1.5);
+
+        EXPECT_EQ(rows[1][0].getUInt64(), 2U);
+        EXPECT_EQ(rows[1][1].getInt32(), 2);
+        EXPECT_TRUE(rows[1][2].isNull());
+        EXPECT_TRUE(rows[1][3].isNull());
+
+        EXPECT_EQ(rows[2][0].getUInt64(), 3U);
+        EXPECT_EQ(rows[2][1].getInt32(), 3);
+        EXPECT_EQ(rows[2][2].getString(), "ccc");
+        EXPECT_DOUBLE_EQ(rows[2][3].getDouble(), 3.5);
+
+        ASSERT_TRUE(codedInput.ReadVarint64(&batchLength));
+        EXPECT_EQ(batchLength, 0U);
+    }
+}
@@ -0,0 +1,282 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+#include "dbengine/Index.h"
+#include "dbengine/handlers/RequestHandler.h"
+#include "dbengine/parser/DBEngineRestRequestFactory.h"
+#include "dbengine/parser/DBEngineSqlRequestFactory.h"
+#include "dbengine/parser/SqlParser.h"
+
+// Common project headers
+#include <siodb/common/io/InputStreamUtils.h>
+#include <siodb/common/protobuf/ExtendedCodedInputStream.h>
+#include <siodb/common/protobuf/ProtobufMessageIO.h>
+#include <siodb/common/protobuf/StreamInputStream.h>
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// CRT headers
+#include <ctime>
+
+// JSON library
+#include <nlohmann/json.hpp>
+
+namespace parser_ns = dbengine::parser;
+
+namespace {
+
+/** Row time to live used by tests */
+constexpr std::uint64_t kTestRowTtl = 10;
+
+/**
+ * Creates test table with single INTEGER column A.
+ * @param tableName Table name.
+ * @return Table object.
+ */
+dbengine::TablePtr createTestTable(const std::string& tableName)
+{
+    const auto instance = TestEnvironment::getInstance();
+    const auto database = instance->findDatabaseChecked(TestEnvironment::getTestDatabaseName());
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"A", siodb::COLUMN_DATA_TYPE_INT32, true},
+    };
+    return database->createUserTable(std::string(tableName), dbengine::TableType::kDisk,
+            tableColumns, dbengine::User::kSuperUserId, {});
+}
+
+/**
+ * Inserts row into the test table.
+ * @param table Table object.
+ * @param value Value of column A.
+ * @param timestamp Row creation timestamp.
+ * @return TRID of the new row.
+ */
+std::uint64_t insertTestRow(dbengine::Table& table, std::int32_t value, std::time_t timestamp)
+{
+    const dbengine::TransactionParameters tp(dbengine::User::kSuperUserId,
+            table.getDatabase().generateNextTransactionId(), timestamp);
+    std::vector<dbengine::Variant> values {dbengine::Variant(value)};
+    return table.insertRow(std::move(values), tp).m_mcr->getTableRowId();
+}
+
+/**
+ * Executes SQL statement and reads response.
+ * @param requestHandler Request handler.
+ * @param statement SQL statement.
+ * @param inputStream Stream to read response from.
+ * @return Database engine response.
+ */
+siodb::iomgr_protocol::DatabaseEngineResponse executeSqlStatement(
+        dbengine::RequestHandler& requestHandler, const std::string& statement,
+        siodb::protobuf::StreamInputStream& inputStream)
+{
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    const auto request = factory.createSqlRequest();
+
+    requestHandler.executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+    siodb::iomgr_protocol::DatabaseEngineResponse response;
+    siodb::protobuf::readMessage(
+            siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, inputStream);
+    EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+    EXPECT_EQ(response.message_size(), 0);
+    return response;
+}
+
+/**
+ * Reads single row via REST GET request.
+ * @param requestHandler Request handler.
+ * @param tableName Table name.
+ * @param trid Row ID.
+ * @return REST status code and returned rows.
+ */
+std::pair<int, nlohmann::json> getRestRow(
+        dbengine::RequestHandler& requestHandler, const std::string& tableName, std::uint64_t trid)
+{
+    siodb::iomgr_protocol::DatabaseEngineRestRequest requestMsg;
+    requestMsg.set_request_id(1);
+    requestMsg.set_verb(siodb::iomgr_protocol::GET);
+    requestMsg.set_object_type(siodb::iomgr_protocol::ROW);
+    requestMsg.set_object_name_or_query(TestEnvironment::getTestDatabaseName() + "." + tableName);
+    requestMsg.set_object_id(trid);
+
+    parser_ns::DBEngineRestRequestFactory requestFactory(1024 * 1024);
+    const auto request = requestFactory.createRestRequest(requestMsg);
+
+    requestHandler.executeRequest(*request, TestEnvironment::kTestRequestId, 0, 1);
+
+    siodb::iomgr_protocol::DatabaseEngineResponse response;
+    siodb::protobuf::StreamInputStream inputStream(
+            TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+    siodb::protobuf::readMessage(
+            siodb::protobuf::ProtocolMessageType::kDatabaseEngineResponse, response, inputStream);
+    EXPECT_EQ(response.request_id(), TestEnvironment::kTestRequestId);
+    EXPECT_EQ(response.message_size(), 0);
+
+    const auto j = nlohmann::json::parse(siodb::io::readChunkedString(inputStream));
+    return std::make_pair(static_cast<int>(j["status"]), j["rows"]);
+}
+
+/**
+ * Checks that row exists in the master column main index.
+ * @param table Table object.
+ * @param trid Row ID.
+ * @return true if row exists, false otherwise.
+ */
+bool rowExists(dbengine::Table& table, std::uint64_t trid)
+{
+    std::uint8_t key[8];
+    ::pbeEncodeUInt64(trid, key);
+    dbengine::IndexValue indexValue;
+    return table.getMasterColumn()->getMasterColumnMainIndex()->find(key, indexValue.m_data, 1)
+           == 1;
+}
+
+}  // anonymous namespace
+
+TEST(RowTtl, ExpiredRowIsHidden)
+{
+    const std::string kTableName("ROW_TTL_TEST_1");
+    const auto table = createTestTable(kTableName);
+    table->setRowTtl(kTestRowTtl);
+
+    const auto currentTime = std::time(nullptr);
+    const auto expiredTrid = insertTestRow(*table, 1, currentTime - kTestRowTtl * 10);
+    const auto liveTrid = insertTestRow(*table, 2, currentTime);
+
+    const auto requestHandler = TestEnvironment::makeRequestHandlerForSuperUser();
+    const auto fullTableName = TestEnvironment::getTestDatabaseName() + "." + kTableName;
+
+    // ----------- SELECT -----------
+    {
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        const auto response = executeSqlStatement(
+                *requestHandler, "SELECT TRID, A FROM " + fullTableName, inputStream);
+        ASSERT_EQ(response.column_description_size(), 2);
+
+        siodb::protobuf::ExtendedCodedInputStream codedInput(&inputStream);
+        std::uint64_t rowLength = 0;
+        ASSERT_TRUE(codedInput.ReadVarint64(&rowLength));
+        ASSERT_GT(rowLength, 0U);
+        std::uint64_t trid = 0;
+        ASSERT_TRUE(codedInput.Read(&trid));
+        EXPECT_EQ(trid, liveTrid);
+        std::int32_t a = 0;
+        ASSERT_TRUE(codedInput.Read(&a));
+        EXPECT_EQ(a, 2);
+
+        ASSERT_TRUE(codedInput.ReadVarint64(&rowLength));
+        EXPECT_EQ(rowLength, 0U);
+    }
+
+    // ----------- REST GET -----------
+    {
+        const auto [status, rows] = getRestRow(*requestHandler, kTableName, expiredTrid);
+        EXPECT_EQ(status, 404);
+        EXPECT_EQ(rows.size(), 0U);
+    }
+    {
+        const auto [status, rows] = getRestRow(*requestHandler, kTableName, liveTrid);
+        EXPECT_EQ(status, 200);
+        EXPECT_EQ(rows.size(), 1U);
+    }
+
+    // ----------- UPDATE -----------
+    {
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        const auto response = executeSqlStatement(*requestHandler,
+                "UPDATE " + fullTableName + " SET A = 100 WHERE TRID = "
+                        + std::to_string(expiredTrid),
+                inputStream);
+        EXPECT_TRUE(response.has_affected_row_count());
+        EXPECT_EQ(response.affected_row_count(), 0U);
+    }
+
+    // ----------- DELETE -----------
+    {
+        siodb::protobuf::StreamInputStream inputStream(
+                TestEnvironment::getInputStream(), siodb::utils::DefaultErrorCodeChecker());
+        const auto response = executeSqlStatement(*requestHandler,
+                "DELETE FROM " + fullTableName + " WHERE TRID = " + std::to_string(expiredTrid),
+                inputStream);
+        EXPECT_TRUE(response.has_affected_row_count());
+        EXPECT_EQ(response.affected_row_count(), 0U);
+    }
+
+    // Modification requests above must not have touched live row
+    {
+        const auto [status, rows] = getRestRow(*requestHandler, kTableName, liveTrid);
+        EXPECT_EQ(status, 200);
+        ASSERT_EQ(rows.size(), 1U);
+        EXPECT_EQ(static_cast<int>(rows[0]["A"]), 2);
+    }
+}
+
+TEST(RowTtl, PurgeExpiredRows)
+{
+    const auto table = createTestTable("ROW_TTL_TEST_2");
+
+    // Row created while TTL is zero never expires and must not stop purge
+    const auto currentTime = std::time(nullptr);
+    const auto oldTime = currentTime - kTestRowTtl * 10;
+    const auto nonExpiringTrid = insertTestRow(*table, 1, oldTime);
+    table->setRowTtl(kTestRowTtl);
+    const auto expiredTrid = insertTestRow(*table, 2, oldTime);
+    const auto liveTrid = insertTestRow(*table, 3, currentTime);
+
+    // Scanning single row per step: first step sees only non-expiring row
+    auto result = table->purgeExpiredRows(dbengine::User::kSuperUserId, currentTime, 100, 1);
+    EXPECT_EQ(result.m_deletedRowCount, 0U);
+    EXPECT_FALSE(result.m_endOfTable);
+
+    // Next step resumes after it and deletes expired row
+    result = table->purgeExpiredRows(dbengine::User::kSuperUserId, currentTime, 100, 1);
+    EXPECT_EQ(result.m_deletedRowCount, 1U);
+    EXPECT_FALSE(result.m_endOfTable);
+
+    result = table->purgeExpiredRows(dbengine::User::kSuperUserId, currentTime, 100, 100);
+    EXPECT_EQ(result.m_deletedRowCount, 0U);
+    EXPECT_TRUE(result.m_endOfTable);
+
+    EXPECT_TRUE(rowExists(*table, nonExpiringTrid));
+    EXPECT_FALSE(rowExists(*table, expiredTrid));
+    EXPECT_TRUE(rowExists(*table, liveTrid));
+
+    // New pass deletes live row once it expires
+    result = table->purgeExpiredRows(
+            dbengine::User::kSuperUserId, currentTime + kTestRowTtl, 100, 100);
+    EXPECT_EQ(result.m_deletedRowCount, 1U);
+    EXPECT_TRUE(result.m_endOfTable);
+    EXPECT_TRUE(rowExists(*table, nonExpiringTrid));
+    EXPECT_FALSE(rowExists(*table, liveTrid));
+}
+
+TEST(RowTtl, RowTtlSurvivesReload)
+{
+    const std::string kTableName("ROW_TTL_TEST_3");
+    const auto table = createTestTable(kTableName);
+    EXPECT_EQ(table->getRowTtl(), 0U);
+    table->setRowTtl(3600);
+    EXPECT_EQ(table->getRowTtl(), 3600U);
+
+    // Load another table object from the same table record and files
+    auto& database = table->getDatabase();
+    const auto tableRecords = database.getTableRecordsOrderedByName(dbengine::User::kSuperUserId);
+    const auto it = std::find_if(tableRecords.cbegin(), tableRecords.cend(),
+            [&kTableName](const auto& tableRecord) { return tableRecord.m_name == kTableName; });
+    ASSERT_NE(it, tableRecords.cend());
+    const auto reloadedTable = std::make_shared<dbengine::Table>(database, *it);
+    EXPECT_EQ(reloadedTable->getRowTtl(), 3600U);
+
+    // Zero TTL is also persisted
+    table->setRowTtl(0);
+    const auto reloadedTable2 = std::make_shared<dbengine::Table>(database, *it);
+    EXPECT_EQ(reloadedTable2->getRowTtl(), 0U);
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDataFileDefs.h>
+
+// CRT headers
+#include <ctime>
+
+// STL headers
+#include <chrono>
+#include <thread>
+
+namespace {
+
+/**
+ * Inserts 1 MB values into the column until it has given number of blocks.
+ * @param table Table object.
+ * @param column Column object.
+ * @param blockCount Required number of blocks.
+ */
+void fillBlocks(dbengine::Table& table, const dbengine::Column& column, std::uint64_t blockCount)
+{
+    constexpr std::size_t kValueSize = 1024 * 1024;
+    const std::size_t maxRowCount =
+            (siodb::kDefaultDataFileDataAreaSize / kValueSize + 2) * blockCount;
+    for (std::size_t i = 0; i < maxRowCount && column.getLastBlockId() < blockCount; ++i) {
+        const dbengine::TransactionParameters tp(dbengine::User::kSuperUserId,
+                table.getDatabase().generateNextTransactionId(), std::time(nullptr));
+        std::vector<dbengine::Variant> values {
+                dbengine::Variant(std::string(kValueSize, static_cast<char>('a' + i % 26)))};
+        table.insertRow(std::move(values), tp);
+    }
+    ASSERT_GE(column.getLastBlockId(), blockCount);
+}
+
+/**
+ * Checks that block created on rollover takes data block file created in advance
+ * and that such block is valid.
+ * @param database Database object.
+ * @param tableName Table name.
+ */
+void checkRolloverToSpareDataFile(dbengine::Database& database, const std::string& tableName)
+{
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"A", siodb::COLUMN_DATA_TYPE_TEXT, true},
+    };
+    const auto table = database.createUserTable(std::string(tableName),
+            dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+    const auto column = table->findColumnChecked("A");
+
+    // First rollover starts creation of the data block files in advance
+    fillBlocks(*table, *column, 2);
+    EXPECT_EQ(column->getTakenSpareDataFileCount(), 0U);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+    while (column->getSpareDataFileCount() == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_GT(column->getSpareDataFileCount(), 0U);
+
+    // Next rollover takes ready file. Fill that block too, so that it gets closed.
+    const auto spareFileBlockId = column->getLastBlockId() + 1;
+    fillBlocks(*table, *column, spareFileBlockId);
+    EXPECT_GE(column->getTakenSpareDataFileCount(), 1U);
+    fillBlocks(*table, *column, spareFileBlockId + 1);
+
+    // Block is loaded again from its file and its digest is checked
+    std::size_t dataSize = 0;
+    EXPECT_TRUE(column->verifyBlock(spareFileBlockId, std::time(nullptr) + 3600, dataSize));
+    EXPECT_GT(dataSize, 0U);
+}
+
+}  // anonymous namespace
+
+TEST(SpareDataFile, RolloverInPlainDatabase)
+{
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+    ASSERT_GT(instance->getSpareDataBlockFileCount(), 0U);
+    const auto database = instance->createDatabase("SPARE_DATA_FILE_TEST_DB", "none",
+            siodb::BinaryValue(), {}, std::numeric_limits<std::uint32_t>::max() / 2, {}, false,
+            dbengine::User::kSuperUserId);
+    checkRolloverToSpareDataFile(*database, "SPARE_DATA_FILE_TEST_1");
+}
+
+TEST(SpareDataFile, RolloverInEncryptedDatabase)
+{
+    const auto instance = TestEnvironment::getInstance();
+    ASSERT_NE(instance, nullptr);
+    ASSERT_GT(instance->getSpareDataBlockFileCount(), 0U);
+    // Test database is encrypted
+    const auto database = instance->findDatabaseChecked(TestEnvironment::getTestDatabaseName());
+    checkRolloverToSpareDataFile(*database, "SPARE_DATA_FILE_TEST_2");
+}
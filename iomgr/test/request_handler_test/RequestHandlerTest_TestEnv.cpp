@@ -100,6 +100,12 @@ void TestEnvironment::SetUp()
     instanceOptions.m_encryptionOptions.m_masterCipherId = "none";
     instanceOptions.m_encryptionOptions.m_systemDbCipherId = "none";
 
+    // Data scrubber is started by tests explicitly, when needed
+    instanceOptions.m_ioManagerOptions.m_dataScrubRate = 0;
+
+    // Large tables are scanned by the multiple threads
+    instanceOptions.m_ioManagerOptions.m_scanThreadNumber = 4;
+
     // Fill log options
     instanceOptions.m_logOptions.m_logFileBaseName = "iomgr";
     {
@@ -0,0 +1,429 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+// Project headers
+#include "RequestHandlerTest_TestEnv.h"
+#include "dbengine/reg/IndexRecord.h"
+#include "dbengine/uli/DenseFileData.h"
+#include "dbengine/uli/FileData.h"
+#include "dbengine/uli/UInt64UniqueLinearIndex.h"
+
+// Common project headers
+#include <siodb/common/utils/FDGuard.h>
+#include <siodb/common/utils/PlainBinaryEncoding.h>
+
+// STL headers
+#include <array>
+#include <map>
+
+// System headers
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace uli = dbengine::uli;
+
+namespace {
+
+/** Value size of the test index */
+constexpr std::size_t kValueSize = 12;
+
+/** Data file size of the test index, small to reach fill thresholds quickly */
+constexpr std::uint32_t kDataFileSize = dbengine::UniqueLinearIndex::kIndexFileHeaderSize + 16384;
+
+/** Data file size of the test index having several dense file pages */
+constexpr std::uint32_t kMultiPageDataFileSize =
+        dbengine::UniqueLinearIndex::kIndexFileHeaderSize + 512 * 1024;
+
+/** Test index file ID */
+constexpr std::uint64_t kFileId = 1;
+
+/**
+ * Returns unencrypted database, so that index files can be modified directly.
+ * @return Database object.
+ */
+dbengine::DatabasePtr getPlainDatabase()
+{
+    static const auto database = TestEnvironment::getInstance()->createDatabase(
+            "ULI_TEST_DB", "none", siodb::BinaryValue(), {},
+            std::numeric_limits<std::uint32_t>::max() / 2, {}, false,
+            dbengine::User::kSuperUserId);
+    return database;
+}
+
+/**
+ * Creates table and unique linear index on its master column.
+ * @param tableName Table name.
+ * @param database Database object.
+ * @param dataFileSize Index data file size.
+ * @return Table and index objects.
+ */
+std::pair<dbengine::TablePtr, std::shared_ptr<dbengine::UniqueLinearIndex>> createTestIndex(
+        const std::string& tableName, const dbengine::DatabasePtr& database = getPlainDatabase(),
+        std::uint32_t dataFileSize = kDataFileSize)
+{
+    const std::vector<dbengine::SimpleColumnSpecification> tableColumns {
+            {"A", siodb::COLUMN_DATA_TYPE_INT32, true},
+    };
+    const auto table = database->createUserTable(std::string(tableName),
+            dbengine::TableType::kDisk, tableColumns, dbengine::User::kSuperUserId, {});
+    const dbengine::IndexColumnSpecification indexColumnSpec(
+            table->getMasterColumn()->getCurrentColumnDefinition(), false);
+    const auto index = std::make_shared<dbengine::UInt64UniqueLinearIndex>(*table,
+            tableName + "_ULI", kValueSize, indexColumnSpec, dataFileSize, std::nullopt);
+    return std::make_pair(table, index);
+}
+
+/**
+ * Closes index and opens it again from its files.
+ * @param table Table object.
+ * @param index Index object, replaced with the reopened one.
+ */
+void reopenIndex(dbengine::Table& table, std::shared_ptr<dbengine::UniqueLinearIndex>& index)
+{
+    const dbengine::IndexRecord indexRecord(*index);
+    index.reset();
+    index = std::make_shared<dbengine::UInt64UniqueLinearIndex>(table, indexRecord, kValueSize);
+}
+
+/**
+ * Makes key buffer.
+ * @param key Key.
+ * @return Key buffer.
+ */
+std::array<std::uint8_t, 8> makeKey(std::uint64_t key)
+{
+    std::array<std::uint8_t, 8> buffer;
+    ::pbeEncodeUInt64(key, buffer.data());
+    return buffer;
+}
+
+/**
+ * Makes value for a key.
+ * @param key Key.
+ * @param version Value version.
+ * @return Value buffer.
+ */
+std::array<std::uint8_t, kValueSize> makeValue(std::uint64_t key, std::uint8_t version = 0)
+{
+    std::array<std::uint8_t, kValueSize> value;
+    for (std::size_t i = 0; i < value.size(); ++i)
+        value[i] = static_cast<std::uint8_t>(key * 31 + i + version);
+    return value;
+}
+
+/**
+ * Inserts key with its value into index.
+ * @param index Index object.
+ * @param key Key.
+ */
+void insertKey(dbengine::UniqueLinearIndex& index, std::uint64_t key)
+{
+    ASSERT_TRUE(index.insert(makeKey(key).data(), makeValue(key).data())) << key;
+}
+
+/**
+ * Collects keys found by iteration over index.
+ * @param index Index object.
+ * @param forward Iteration direction: from the first key forward if true,
+ *                from the last key backward otherwise.
+ * @return Keys in the order of iteration.
+ */
+std::vector<std::uint64_t> scanKeys(dbengine::UniqueLinearIndex& index, bool forward)
+{
+    std::vector<std::uint64_t> keys;
+    std::array<std::uint8_t, 8> key;
+    for (bool found = forward ? index.findFirstKey(key.data()) : index.findLastKey(key.data());
+            found; found = forward ? index.findNextKey(key.data(), key.data())
+                                   : index.findPreviousKey(key.data(), key.data())) {
+        std::uint64_t numericKey = 0;
+        ::pbeDecodeUInt64(key.data(), &numericKey);
+        keys.push_back(numericKey);
+    }
+    return keys;
+}
+
+/**
+ * Checks that index contains exactly given keys with expected values
+ * and that keys are found in order by iteration.
+ * @param index Index object.
+ * @param expectedValues Keys and expected values.
+ */
+void checkKeys(dbengine::UniqueLinearIndex& index,
+        const std::map<std::uint64_t, std::array<std::uint8_t, kValueSize>>& expectedValues)
+{
+    const auto recordCount = index.getNumberOfRecordsPerFile();
+    for (std::uint64_t key = 0; key < recordCount; ++key) {
+        std::array<std::uint8_t, kValueSize> value;
+        const auto it = expectedValues.find(key);
+        const auto n = index.find(makeKey(key).data(), value.data(), 1);
+        if (it == expectedValues.end())
+            EXPECT_EQ(n, 0U) << key;
+        else {
+            ASSERT_EQ(n, 1U) << key;
+            EXPECT_EQ(value, it->second) << key;
+        }
+    }
+
+    std::vector<std::uint64_t> expectedKeys;
+    for (const auto& e : expectedValues)
+        expectedKeys.push_back(e.first);
+    EXPECT_EQ(scanKeys(index, true), expectedKeys);
+}
+
+}  // anonymous namespace
+
+TEST(UniqueLinearIndex, SparseLogReplay)
+{
+    auto [table, index] = createTestIndex("ULI_TEST_1");
+    std::map<std::uint64_t, std::array<std::uint8_t, kValueSize>> expectedValues;
+
+    // Stay below dense threshold, so that file remains a log of changes
+    for (std::uint64_t key = 1; key < 30; key += 3) {
+        insertKey(*index, key);
+        expectedValues[key] = makeValue(key);
+    }
+    for (std::uint64_t key = 1; key < 30; key += 9) {
+        ASSERT_EQ(index->update(makeKey(key).data(), makeValue(key, 1).data()), 1U);
+        expectedValues[key] = makeValue(key, 1);
+    }
+    for (std::uint64_t key = 4; key < 30; key += 12) {
+        ASSERT_EQ(index->erase(makeKey(key).data()), 1U);
+        expectedValues.erase(key);
+    }
+    // Erased and inserted again
+    insertKey(*index, 4);
+    expectedValues[4] = makeValue(4);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+    checkKeys(*index, expectedValues);
+
+    // Replay log
+    index->flush();
+    reopenIndex(*table, index);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+    checkKeys(*index, expectedValues);
+}
+
+TEST(UniqueLinearIndex, SparseLogTornLastEntry)
+{
+    auto [table, index] = createTestIndex("ULI_TEST_2");
+    std::map<std::uint64_t, std::array<std::uint8_t, kValueSize>> expectedValues;
+    for (std::uint64_t key = 10; key < 20; ++key) {
+        insertKey(*index, key);
+        expectedValues[key] = makeValue(key);
+    }
+    index->flush();
+    const auto filePath = index->makeIndexFilePath(kFileId);
+    const dbengine::IndexRecord indexRecord(*index);
+    index.reset();
+
+    // Append incomplete store entry, as left by interrupted write
+    {
+        siodb::FDGuard fd(::open(filePath.c_str(), O_RDWR));
+        ASSERT_TRUE(fd.isValidFd());
+        struct stat st;
+        ASSERT_EQ(::fstat(fd.getFD(), &st), 0);
+        std::array<std::uint8_t, 4 + 1 + kValueSize / 2> tornEntry;
+        tornEntry.fill(0xAA);
+        ::pbeEncodeUInt32(5, tornEntry.data());
+        tornEntry[4] = 1;
+        ASSERT_EQ(::pwrite(fd.getFD(), tornEntry.data(), tornEntry.size(), st.st_size),
+                static_cast<ssize_t>(tornEntry.size()));
+    }
+
+    // Incomplete entry is ignored
+    index = std::make_shared<dbengine::UInt64UniqueLinearIndex>(*table, indexRecord, kValueSize);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+    checkKeys(*index, expectedValues);
+
+    // Next entry overwrites incomplete one and is replayed properly
+    insertKey(*index, 5);
+    expectedValues[5] = makeValue(5);
+    index->flush();
+    reopenIndex(*table, index);
+    checkKeys(*index, expectedValues);
+}
+
+TEST(UniqueLinearIndex, FileFormatThresholds)
+{
+    auto [table, index] = createTestIndex("ULI_TEST_3");
+    const auto recordCount = index->getNumberOfRecordsPerFile();
+    const auto maxSparseRecordCount = recordCount / uli::FileData::kSparseFileMaxFillDivisor;
+    const auto minDenseRecordCount = recordCount / uli::FileData::kDenseFileMinFillDivisor;
+    ASSERT_GT(minDenseRecordCount, 1U);
+    std::map<std::uint64_t, std::array<std::uint8_t, kValueSize>> expectedValues;
+
+    // Sparse file is kept up to 1/16 of records used
+    std::uint64_t key = 0;
+    for (std::size_t i = 0; i < maxSparseRecordCount; ++i, key += 7) {
+        insertKey(*index, key % recordCount);
+        expectedValues[key % recordCount] = makeValue(key % recordCount);
+    }
+    ASSERT_EQ(expectedValues.size(), maxSparseRecordCount);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+
+    // Next one makes it dense
+    while (expectedValues.count(key % recordCount) > 0)
+        ++key;
+    insertKey(*index, key % recordCount);
+    expectedValues[key % recordCount] = makeValue(key % recordCount);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kDense);
+    checkKeys(*index, expectedValues);
+
+    // Dense file is kept down to 1/64 of records used.
+    // Record count is exact here, since all pages were loaded by the check above.
+    while (expectedValues.size() > minDenseRecordCount) {
+        const auto it = expectedValues.begin();
+        ASSERT_EQ(index->erase(makeKey(it->first).data()), 1U) << it->first;
+        expectedValues.erase(it);
+        EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kDense) << expectedValues.size();
+    }
+
+    // Next one makes it sparse
+    const auto it = expectedValues.begin();
+    ASSERT_EQ(index->erase(makeKey(it->first).data()), 1U) << it->first;
+    expectedValues.erase(it);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+    checkKeys(*index, expectedValues);
+}
+
+TEST(UniqueLinearIndex, ReopenAfterRewrite)
+{
+    auto [table, index] = createTestIndex("ULI_TEST_4");
+    const auto recordCount = index->getNumberOfRecordsPerFile();
+    const auto maxSparseRecordCount = recordCount / uli::FileData::kSparseFileMaxFillDivisor;
+    const auto minDenseRecordCount = recordCount / uli::FileData::kDenseFileMinFillDivisor;
+    std::map<std::uint64_t, std::array<std::uint8_t, kValueSize>> expectedValues;
+
+    // Rewrite as dense
+    for (std::uint64_t key = 0; key <= maxSparseRecordCount; ++key) {
+        insertKey(*index, key * 3);
+        expectedValues[key * 3] = makeValue(key * 3);
+    }
+    ASSERT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kDense);
+
+    // Changes made to dense file after rewrite
+    ASSERT_EQ(index->update(makeKey(0).data(), makeValue(0, 1).data()), 1U);
+    expectedValues[0] = makeValue(0, 1);
+    ASSERT_EQ(index->erase(makeKey(3).data()), 1U);
+    expectedValues.erase(3);
+
+    index->flush();
+    reopenIndex(*table, index);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kDense);
+    checkKeys(*index, expectedValues);
+
+    // Rewrite as sparse, all pages are loaded by the check above
+    while (expectedValues.size() >= minDenseRecordCount) {
+        const auto it = std::prev(expectedValues.end());
+        ASSERT_EQ(index->erase(makeKey(it->first).data()), 1U) << it->first;
+        expectedValues.erase(it);
+    }
+    ASSERT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+
+    // Changes logged to sparse file after rewrite
+    insertKey(*index, recordCount - 1);
+    expectedValues[recordCount - 1] = makeValue(recordCount - 1);
+    ASSERT_EQ(index->update(makeKey(6).data(), makeValue(6, 1).data()), 1U);
+    expectedValues[6] = makeValue(6, 1);
+
+    index->flush();
+    reopenIndex(*table, index);
+    EXPECT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kSparse);
+    checkKeys(*index, expectedValues);
+}
+
+TEST(UniqueLinearIndex, EncryptedDenseFilePages)
+{
+    // Encrypted dense file is read page by page on demand
+    const auto database = TestEnvironment::getInstance()->findDatabaseChecked(
+            TestEnvironment::getTestDatabaseName());
+    ASSERT_STRNE(database->getCipherId(), "none");
+    auto [table, index] = createTestIndex("ULI_TEST_5", database, kMultiPageDataFileSize);
+    const auto recordCount = index->getNumberOfRecordsPerFile();
+    const auto recordsPerPage =
+            uli::DenseFileData::kApproximatePageSize / index->getRecordSize();
+    const auto pageCount = (recordCount + recordsPerPage - 1) / recordsPerPage;
+    ASSERT_GE(pageCount, 8U);
+    std::map<std::uint64_t, std::array<std::uint8_t, kValueSize>> expectedValues;
+
+    // Keys in the first three pages, enough to make file dense,
+    // then keys at the boundaries of the pages 2, 6 and the last one.
+    // Pages 3-5 and the ones between page 6 and the last one remain empty.
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t key = 0; key < recordsPerPage * 3; key += 4)
+        keys.push_back(key);
+    ASSERT_GT(keys.size(), recordCount / uli::FileData::kSparseFileMaxFillDivisor);
+    keys.push_back(recordsPerPage * 3 - 1);
+    keys.push_back(recordsPerPage * 6);
+    keys.push_back(recordsPerPage * 7 - 1);
+    keys.push_back(recordCount - 1);
+    for (const auto key : keys) {
+        insertKey(*index, key);
+        expectedValues[key] = makeValue(key);
+    }
+    ASSERT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kDense);
+
+    // Changes of the loaded pages are visible before reopening
+    for (const auto key : keys) {
+        if (key / recordsPerPage == 1 && key % 8 == 0) {
+            ASSERT_EQ(index->update(makeKey(key).data(), makeValue(key, 1).data()), 1U) << key;
+            expectedValues[key] = makeValue(key, 1);
+        } else if (key / recordsPerPage == 2 && key % 40 == 0) {
+            ASSERT_EQ(index->erase(makeKey(key).data()), 1U) << key;
+            expectedValues.erase(key);
+        }
+    }
+    checkKeys(*index, expectedValues);
+
+    std::vector<std::uint64_t> expectedKeys;
+    for (const auto& e : expectedValues)
+        expectedKeys.push_back(e.first);
+    const std::vector<std::uint64_t> expectedReverseKeys(
+            expectedKeys.rbegin(), expectedKeys.rend());
+
+    // Forward iteration over unloaded pages
+    index->flush();
+    reopenIndex(*table, index);
+    ASSERT_EQ(index->getFileFormat(kFileId), uli::FileFormat::kDense);
+    EXPECT_EQ(scanKeys(*index, true), expectedKeys);
+
+    // Backward iteration over unloaded pages
+    reopenIndex(*table, index);
+    EXPECT_EQ(scanKeys(*index, false), expectedReverseKeys);
+
+    // Next and previous keys across unloaded empty pages, with only page 6 loaded
+    reopenIndex(*table, index);
+    std::array<std::uint8_t, kValueSize> value;
+    ASSERT_EQ(index->find(makeKey(recordsPerPage * 6).data(), value.data(), 1), 1U);
+    std::array<std::uint8_t, 8> key;
+    std::uint64_t numericKey = 0;
+    ASSERT_TRUE(index->findPreviousKey(makeKey(recordsPerPage * 6).data(), key.data()));
+    ::pbeDecodeUInt64(key.data(), &numericKey);
+    EXPECT_EQ(numericKey, recordsPerPage * 3 - 1);
+    ASSERT_TRUE(index->findNextKey(makeKey(recordsPerPage * 7 - 1).data(), key.data()));
+    ::pbeDecodeUInt64(key.data(), &numericKey);
+    EXPECT_EQ(numericKey, recordCount - 1);
+    ASSERT_TRUE(index->findNextKey(makeKey(recordsPerPage * 3 - 1).data(), key.data()));
+    ::pbeDecodeUInt64(key.data(), &numericKey);
+    EXPECT_EQ(numericKey, recordsPerPage * 6);
+    EXPECT_FALSE(index->findNextKey(makeKey(recordCount - 1).data(), key.data()));
+
+    // Insert, update and erase in the pages loaded and not loaded yet
+    insertKey(*index, recordsPerPage * 4 + 1);
+    expectedValues[recordsPerPage * 4 + 1] = makeValue(recordsPerPage * 4 + 1);
+    ASSERT_EQ(index->update(makeKey(recordsPerPage * 6).data(),
+                      makeValue(recordsPerPage * 6, 2).data()),
+            1U);
+    expectedValues[recordsPerPage * 6] = makeValue(recordsPerPage * 6, 2);
+    ASSERT_EQ(index->update(makeKey(4).data(), makeValue(4, 2).data()), 1U);
+    expectedValues[4] = makeValue(4, 2);
+    ASSERT_EQ(index->erase(makeKey(recordCount - 1).data()), 1U);
+    expectedValues.erase(recordCount - 1);
+    checkKeys(*index, expectedValues);
+
+    index->flush();
+    reopenIndex(*table, index);
+    checkKeys(*index, expectedValues);
+}
@@ -57,6 +57,25 @@ TEST(DDL, DetachDatabase)
     EXPECT_EQ(request.m_database, "MY_DATABASE");
 }
 
+TEST(DDL, BackupDatabase)
+{
+    // Parse statement and prepare request
+    const std::string statement("BACKUP DATABASE my_database TO '/var/backup/siodb'");
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    const auto dbeRequest = factory.createSqlRequest();
+
+    // Check request type
+    ASSERT_EQ(dbeRequest->m_requestType, requests::DBEngineRequestType::kBackupDatabase);
+
+    // Check request
+    const auto& request = dynamic_cast<const requests::BackupDatabaseRequest&>(*dbeRequest);
+    EXPECT_EQ(request.m_database, "MY_DATABASE");
+    EXPECT_EQ(request.m_backupDir, "/var/backup/siodb");
+}
+
 TEST(DDL, CreateDatabase)
 {
     // Parse statement and prepare request
@@ -409,6 +428,29 @@ TEST(DDL, AlterTableSetTableAttributes)
     EXPECT_EQ(request.m_table, "MY_TABLE");
     ASSERT_TRUE(request.m_nextTrid.has_value());
     EXPECT_EQ(*request.m_nextTrid, 288449U);
+    EXPECT_FALSE(request.m_rowTtl.has_value());
+}
+
+TEST(DDL, AlterTableSetTableAttributes_Ttl)
+{
+    // Parse statement and prepare request
+    const std::string statement("ALTER TABLE my_database.my_table SET ttl=86400");
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    const auto dbeRequest = factory.createSqlRequest();
+
+    // Check request type
+    ASSERT_EQ(dbeRequest->m_requestType, requests::DBEngineRequestType::kSetTableAttributes);
+
+    // Check request
+    const auto& request = dynamic_cast<const requests::SetTableAttributesRequest&>(*dbeRequest);
+    EXPECT_EQ(request.m_database, "MY_DATABASE");
+    EXPECT_EQ(request.m_table, "MY_TABLE");
+    EXPECT_FALSE(request.m_nextTrid.has_value());
+    ASSERT_TRUE(request.m_rowTtl.has_value());
+    EXPECT_EQ(*request.m_rowTtl, 86400U);
 }
 
 TEST(DDL, AlterTableAddColumn)
@@ -9,6 +9,8 @@
 #include "dbengine/parser/SqlParser.h"
 
 // Common project headers
+#include <siodb/common/io/ChunkedInputStream.h>
+#include <siodb/common/io/MemoryInputStream.h>
 #include <siodb/iomgr/shared/dbengine/parser/expr/AllExpressions.h>
 
 // Google Test
@@ -337,3 +339,41 @@ TEST(DML, InsertColumnName_2)
     parser_ns::DBEngineSqlRequestFactory factory(parser);
     ASSERT_THROW(factory.createSqlRequest(), parser_ns::DBEngineRequestFactoryError);
 }
+
+TEST(DML, CopyFrom)
+{
+    // Parse statement and prepare request
+    const std::string statement(
+            "COPY my_database.my_table (col0, col1) FROM STDIN WITH FORMAT binary");
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+
+    const std::uint8_t data[] = {0};
+    siodb::io::MemoryInputStream rawInput(data, sizeof(data));
+    siodb::io::ChunkedInputStream input(rawInput);
+    parser_ns::DBEngineSqlRequestFactory factory(parser, &input);
+    const auto dbeRequest = factory.createSqlRequest();
+
+    // Check request type
+    ASSERT_EQ(dbeRequest->m_requestType, requests::DBEngineRequestType::kCopyFrom);
+
+    // Check request
+    const auto& request = dynamic_cast<const requests::CopyFromRequest&>(*dbeRequest);
+    EXPECT_EQ(request.m_database, "MY_DATABASE");
+    EXPECT_EQ(request.m_table, "MY_TABLE");
+    ASSERT_EQ(request.m_columns.size(), 2U);
+    EXPECT_EQ(request.m_columns[0], "COL0");
+    EXPECT_EQ(request.m_columns[1], "COL1");
+    EXPECT_EQ(request.m_format, requests::CopyFromFormat::kBinary);
+    EXPECT_EQ(&request.m_input, &input);
+}
+
+TEST(DML, CopyFromWithoutDataStream)
+{
+    const std::string statement("COPY my_table FROM STDIN");
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    ASSERT_THROW(factory.createSqlRequest(), parser_ns::DBEngineRequestFactoryError);
+}
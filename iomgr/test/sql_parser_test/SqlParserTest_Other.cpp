@@ -76,6 +76,20 @@ TEST(Query, ShowTables)
     ASSERT_EQ(dbeRequest->m_requestType, requests::DBEngineRequestType::kShowTables);
 }
 
+TEST(Query, ShowScrubState)
+{
+    // Parse statement and prepare request
+    const std::string statement("SHOW SCRUB STATE");
+    parser_ns::SqlParser parser(statement);
+    parser.parse();
+
+    parser_ns::DBEngineSqlRequestFactory factory(parser);
+    const auto dbeRequest = factory.createSqlRequest();
+
+    // Check request type
+    ASSERT_EQ(dbeRequest->m_requestType, requests::DBEngineRequestType::kShowScrubState);
+}
+
 TEST(Query, DescTable)
 {
     // Parse statement and prepare request
@@ -18,6 +18,9 @@ help:
 	@echo "${CYAN}make rest_server${NC} - Build REST Server"
 	@echo "${CYAN}make siocli${NC} - Build command-line client"
 	@echo "${CYAN}make restcli${NC} - Build REST protocol test client"
+	@echo "${CYAN}make siobench${NC} - Build SQL and REST workload benchmark client"
+	@echo "${CYAN}make benchmarks${NC} - Build IO Manager micro-benchmarks."
+	@echo "${CYAN}make run-benchmarks${NC} - Run IO Manager micro-benchmarks, save results as JSON."
 	@echo "${CYAN}make clean${NC} - Clean all targets."
 	@echo "${CYAN}make clean-<siodb_target>${NC} - Clean specific target, for example 'clean-siodb'."
 	@echo "By default, debug version is built. To build release version add DEBUG=0 to the command."
@@ -7,6 +7,7 @@
 ANTLR4_VERSION:=4.9.2
 ANTLR4_CPP_RUNTIME_VERSION:=4.9.2
 LIBDATE_VERSION:=3.0.1-git~77bd6b9
+GBENCHMARK_VERSION:=1.5.5
 GTEST_VERSION:=1.10.0
 JSON_VERSION:=3.10.2
 OPENSSL_VERSION:=1.1.1k
@@ -31,6 +31,9 @@ LIBDATE_ROOT:=$(THIRD_PARTY_ROOT)/date-$(LIBDATE_VERSION)
 CXX_INCLUDE+=-isystem $(LIBDATE_ROOT)/include
 LDFLAGS+=-L$(LIBDATE_ROOT)/$(OS_LIBDIR) -Wl,-rpath -Wl,$(LIBDATE_ROOT)/$(OS_LIBDIR)
 
+# Google Benchmark, include and library paths are added only by the benchmark makefiles
+GBENCHMARK_ROOT:=$(THIRD_PARTY_ROOT)/benchmark-$(GBENCHMARK_VERSION)
+
 # Google Test
 GTEST_ROOT:=$(THIRD_PARTY_ROOT)/googletest-$(GTEST_VERSION)
 CXX_INCLUDE+=-isystem $(GTEST_ROOT)/include
@@ -11,6 +11,8 @@ import (
 	"path/filepath"
 	"strconv"
 	"strings"
+
+	"siodb.io/siodb/siodbproto"
 )
 
 func stringToByteSize(str string) (bytes uint32, err error) {
@@ -138,3 +140,44 @@ func minUint32(a uint32, b uint32) uint32 {
 	}
 	return b
 }
+
+// parseAcceptEncoding selects supported response compression from the Accept-Encoding header value.
+// gzip is preferred over deflate, encodings with zero quality value are ignored.
+func parseAcceptEncoding(acceptEncoding string) siodbproto.CompressionType {
+	compression := siodbproto.CompressionType_COMPRESSION_NONE
+	for _, item := range strings.Split(acceptEncoding, ",") {
+		params := strings.Split(item, ";")
+		encoding := strings.ToLower(strings.TrimSpace(params[0]))
+		rejected := false
+		for _, param := range params[1:] {
+			param = strings.ReplaceAll(param, " ", "")
+			if strings.HasPrefix(param, "q=") {
+				if q, err := strconv.ParseFloat(param[2:], 64); err == nil && q == 0 {
+					rejected = true
+				}
+			}
+		}
+		if rejected {
+			continue
+		}
+		switch encoding {
+		case "gzip", "x-gzip":
+			return siodbproto.CompressionType_COMPRESSION_GZIP
+		case "deflate":
+			compression = siodbproto.CompressionType_COMPRESSION_DEFLATE
+		}
+	}
+	return compression
+}
+
+// getContentEncoding returns Content-Encoding header value for the compression type.
+func getContentEncoding(compression siodbproto.CompressionType) string {
+	switch compression {
+	case siodbproto.CompressionType_COMPRESSION_GZIP:
+		return "gzip"
+	case siodbproto.CompressionType_COMPRESSION_DEFLATE:
+		return "deflate"
+	default:
+		return ""
+	}
+}
@@ -115,7 +115,9 @@ func (ioMgrConn *ioMgrConnection) writeIOMgrRequest(
 	userName string,
 	token string,
 	objectName string,
-	objectID uint64) (requestID uint64, err error) {
+	objectID uint64,
+	compactRows bool,
+	compression siodbproto.CompressionType) (requestID uint64, err error) {
 
 	requestID = ioMgrConn.RequestID
 	ioMgrConn.RequestID++
@@ -125,6 +127,8 @@ func (ioMgrConn *ioMgrConnection) writeIOMgrRequest(
 	databaseEngineRestRequest.ObjectType = objectType
 	databaseEngineRestRequest.UserName = userName
 	databaseEngineRestRequest.Token = token
+	databaseEngineRestRequest.CompactRows = compactRows
+	databaseEngineRestRequest.Compression = compression
 
 	if len(objectName) > 0 {
 		databaseEngineRestRequest.ObjectNameOrQuery = objectName
@@ -144,32 +148,34 @@ func (ioMgrConn *ioMgrConnection) writeIOMgrRequest(
 	return requestID, nil
 }
 
-func (ioMgrConn *ioMgrConnection) readIOMgrResponse(requestID uint64) (restStatusCode uint32, err error) {
+func (ioMgrConn *ioMgrConnection) readIOMgrResponse(requestID uint64) (
+	restStatusCode uint32, compression siodbproto.CompressionType, err error) {
 	var databaseEngineResponse siodbproto.DatabaseEngineResponse
 	restStatusCode = 0
 
 	if _, err := ioMgrConn.readMessage(messageTypeDatabaseEngineReposnse, &databaseEngineResponse); err != nil {
-		return restStatusCode, fmt.Errorf("can't read response from IOMgr: %v", err)
+		return restStatusCode, compression, fmt.Errorf("can't read response from IOMgr: %v", err)
 	}
 	log.Debug("readIOMgrResponse | databaseEngineResponse: %v", &databaseEngineResponse)
 	log.Debug("readIOMgrResponse | databaseEngineResponse.RequestId: %v", databaseEngineResponse.RequestId)
 	log.Debug("readIOMgrResponse | databaseEngineResponse.rest_status_code: %v", databaseEngineResponse.RestStatusCode)
 	log.Debug("readIOMgrResponse | ioMgrConn.RequestID: %v", ioMgrConn.RequestID)
 	restStatusCode = databaseEngineResponse.RestStatusCode
+	compression = databaseEngineResponse.Compression
 
 	if databaseEngineResponse.RequestId != requestID {
 		ioMgrConn.Close()
 		ioMgrConn.trackedNetConn.Conn = nil
-		return restStatusCode, fmt.Errorf("request ID mismatch: databaseEngineResponse.RequestId (%v) != requestID (%v)",
+		return restStatusCode, compression, fmt.Errorf("request ID mismatch: databaseEngineResponse.RequestId (%v) != requestID (%v)",
 			databaseEngineResponse.RequestId, requestID)
 	}
 
 	if len(databaseEngineResponse.Message) > 0 {
-		return restStatusCode, fmt.Errorf("code: %v, message: %v",
+		return restStatusCode, compression, fmt.Errorf("code: %v, message: %v",
 			databaseEngineResponse.Message[0].GetStatusCode(), databaseEngineResponse.Message[0].GetText())
 	}
 
-	return restStatusCode, nil
+	return restStatusCode, compression, nil
 }
 
 func (ioMgrConn *ioMgrConnection) readChunkedJSON(c *gin.Context) (err error) {
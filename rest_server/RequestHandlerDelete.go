@@ -46,7 +46,8 @@ func (worker restWorker) delete(
 
 	var requestID uint64
 	if requestID, err = ioMgrConn.writeIOMgrRequest(
-		siodbproto.RestVerb_DELETE, ObjectType, userName, token, ObjectName, ObjectID); err != nil {
+		siodbproto.RestVerb_DELETE, ObjectType, userName, token, ObjectName, ObjectID, false,
+		siodbproto.CompressionType_COMPRESSION_NONE); err != nil {
 		log.Error("%v", err)
 		c.JSON(http.StatusInternalServerError,
 			gin.H{"status": http.StatusInternalServerError,
@@ -54,7 +55,7 @@ func (worker restWorker) delete(
 		return err
 	}
 
-	if restStatusCode, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
+	if restStatusCode, _, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
 		log.Error("%v", err)
 		c.JSON(int(restStatusCode),
 			gin.H{"status": int(restStatusCode),
@@ -115,9 +115,19 @@ func (worker restWorker) get(
 		return err
 	}
 
+	// format=compact requests rows as arrays of values with separate list of column names
+	compactRows := c.Query("format") == "compact"
+
+	// Compressed payload can't be embedded into the multiple query response
+	compression := siodbproto.CompressionType_COMPRESSION_NONE
+	if CanWriteHeader {
+		compression = parseAcceptEncoding(c.GetHeader("Accept-Encoding"))
+	}
+
 	var requestID uint64
 	if requestID, err = ioMgrConn.writeIOMgrRequest(
-		siodbproto.RestVerb_GET, ObjectType, userName, token, ObjectName, ObjectID); err != nil {
+		siodbproto.RestVerb_GET, ObjectType, userName, token, ObjectName, ObjectID, compactRows,
+		compression); err != nil {
 		log.Error("%v", err)
 		c.JSON(http.StatusInternalServerError,
 			gin.H{"status": http.StatusInternalServerError,
@@ -125,13 +135,17 @@ func (worker restWorker) get(
 		return err
 	}
 
-	if restStatusCode, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
+	if restStatusCode, responseCompression, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
 		log.Error("%v", err)
 		c.JSON(int(restStatusCode),
 			gin.H{"status": int(restStatusCode),
 				"error": fmt.Sprintf("%v", err)})
 		return err
 	} else if CanWriteHeader {
+		if contentEncoding := getContentEncoding(responseCompression); contentEncoding != "" {
+			c.Writer.Header().Set("Content-Encoding", contentEncoding)
+			c.Writer.Header().Add("Vary", "Accept-Encoding")
+		}
 		c.Writer.WriteHeader(int(restStatusCode))
 	}
 	// Read and stream chunked JSON
@@ -48,7 +48,8 @@ func (worker restWorker) patch(
 
 	var requestID uint64
 	if requestID, err = ioMgrConn.writeIOMgrRequest(
-		siodbproto.RestVerb_PATCH, ObjectType, userName, token, ObjectName, ObjectID); err != nil {
+		siodbproto.RestVerb_PATCH, ObjectType, userName, token, ObjectName, ObjectID, false,
+		siodbproto.CompressionType_COMPRESSION_NONE); err != nil {
 		log.Error("%v", err)
 		c.JSON(http.StatusInternalServerError,
 			gin.H{"status": http.StatusInternalServerError,
@@ -56,7 +57,7 @@ func (worker restWorker) patch(
 		return err
 	}
 
-	if restStatusCode, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
+	if restStatusCode, _, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
 		log.Error("%v", err)
 		c.JSON(int(restStatusCode),
 			gin.H{"status": int(restStatusCode),
@@ -73,7 +74,7 @@ func (worker restWorker) patch(
 		return err
 	}
 
-	if restStatusCode, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
+	if restStatusCode, _, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
 		log.Error("%v", err)
 		c.JSON(int(restStatusCode),
 			gin.H{"status": int(restStatusCode),
@@ -38,7 +38,8 @@ func (worker restWorker) post(
 
 	var requestID uint64
 	if requestID, err = ioMgrConn.writeIOMgrRequest(
-		siodbproto.RestVerb_POST, ObjectType, userName, token, ObjectName, ObjectID); err != nil {
+		siodbproto.RestVerb_POST, ObjectType, userName, token, ObjectName, ObjectID, false,
+		siodbproto.CompressionType_COMPRESSION_NONE); err != nil {
 		log.Error("%v", err)
 		c.JSON(http.StatusInternalServerError,
 			gin.H{"status": http.StatusInternalServerError,
@@ -46,7 +47,7 @@ func (worker restWorker) post(
 		return err
 	}
 
-	if restStatusCode, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
+	if restStatusCode, _, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
 		log.Error("%v", err)
 		c.JSON(int(restStatusCode),
 			gin.H{"status": int(restStatusCode),
@@ -63,7 +64,7 @@ func (worker restWorker) post(
 		return err
 	}
 
-	if restStatusCode, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
+	if restStatusCode, _, err := ioMgrConn.readIOMgrResponse(requestID); err != nil {
 		log.Error("%v", err)
 		c.JSON(int(restStatusCode),
 			gin.H{"status": int(restStatusCode),
@@ -173,6 +173,12 @@ int executeRestRequest(const RestClientParameters& params, std::ostream& os)
                   << ": fd=" << fd << std::endl;
     }
 
+    return executeRestRequest(params, connection, os);
+}
+
+int executeRestRequest(
+        const RestClientParameters& params, io::InputOutputStream& connection, std::ostream& os)
+{
     // Fill requst message
     iomgr_protocol::DatabaseEngineRestRequest restRequest;
     restRequest.set_request_id(params.m_requestId);
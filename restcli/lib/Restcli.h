@@ -4,6 +4,9 @@
 
 #pragma once
 
+// Common project headers
+#include <siodb/common/io/InputOutputStream.h>
+
 // CRT headers
 #include <cstdint>
 
@@ -72,4 +75,15 @@ void printLogo();
  */
 int executeRestRequest(const RestClientParameters& params, std::ostream& os);
 
+/**
+ * Executes REST requst to IO Manager over already established connection.
+ * Connection can be reused for the subsequent requests.
+ * @param params Client parameters. Host and port are ignored.
+ * @param connection Connection to IO Manager.
+ * @param os Output stream.
+ * @return Exit code.
+ */
+int executeRestRequest(
+        const RestClientParameters& params, io::InputOutputStream& connection, std::ostream& os);
+
 }  // namespace siodb::rest_client
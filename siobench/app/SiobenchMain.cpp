@@ -0,0 +1,10 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+extern "C" int siobenchMain(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+    return siobenchMain(argc, argv);
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "LatencyHistogram.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+namespace siodb::siobench {
+
+LatencyHistogram::LatencyHistogram() noexcept
+    : m_count(0)
+    , m_sum(0)
+    , m_min(std::numeric_limits<std::uint64_t>::max())
+    , m_max(0)
+{
+    m_buckets.fill(0);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept
+{
+    for (std::size_t i = 0; i < kBucketCount; ++i)
+        m_buckets[i] += other.m_buckets[i];
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+std::uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const noexcept
+{
+    if (m_count == 0) return 0;
+    const auto p = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max(static_cast<std::uint64_t>(std::ceil(m_count * p / 100.0)),
+            static_cast<std::uint64_t>(1));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) return std::min(getBucketUpperBound(i), m_max);
+    }
+    return m_max;
+}
+
+// --- internals ---
+
+std::uint64_t LatencyHistogram::getBucketUpperBound(std::size_t index) noexcept
+{
+    if (index < kExactValueCount) return index;
+    const auto offset = index - kExactValueCount;
+    const unsigned shift = static_cast<unsigned>(offset / kSubBucketCount) + 1;
+    const std::uint64_t subBucket = (offset % kSubBucketCount) + kSubBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+}  // namespace siodb::siobench
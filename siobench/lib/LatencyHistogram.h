@@ -0,0 +1,142 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// CRT headers
+#include <cstdint>
+
+// STL headers
+#include <array>
+#include <limits>
+
+namespace siodb::siobench {
+
+/**
+ * Log-linear latency histogram. Values below 128 are recorded exactly,
+ * larger values are recorded with relative error below 1/64.
+ * Fixed memory footprint, so it can be updated on the hot path without allocations.
+ */
+class LatencyHistogram {
+public:
+    /** Initializes object of class LatencyHistogram */
+    LatencyHistogram() noexcept;
+
+    /**
+     * Records single value.
+     * @param value A value.
+     */
+    void record(std::uint64_t value) noexcept
+    {
+        ++m_buckets[getBucketIndex(value)];
+        ++m_count;
+        m_sum += value;
+        if (value < m_min) m_min = value;
+        if (value > m_max) m_max = value;
+    }
+
+    /**
+     * Adds all values recorded in other histogram to this one.
+     * @param other Other histogram.
+     */
+    void merge(const LatencyHistogram& other) noexcept;
+
+    /**
+     * Returns number of recorded values.
+     * @return Number of recorded values.
+     */
+    std::uint64_t getCount() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * Returns minimum recorded value.
+     * @return Minimum recorded value or zero if there are no values.
+     */
+    std::uint64_t getMin() const noexcept
+    {
+        return m_count > 0 ? m_min : 0;
+    }
+
+    /**
+     * Returns maximum recorded value.
+     * @return Maximum recorded value.
+     */
+    std::uint64_t getMax() const noexcept
+    {
+        return m_max;
+    }
+
+    /**
+     * Returns mean of the recorded values.
+     * @return Mean value or zero if there are no values.
+     */
+    double getMean() const noexcept
+    {
+        return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0.0;
+    }
+
+    /**
+     * Returns value at a given percentile, i.e. the smallest value such that
+     * at least given percent of the recorded values are less or equal to it.
+     * @param percentile Percentile in the range [0, 100].
+     * @return Upper bound of the bucket containing value at percentile,
+     *         or zero if there are no values.
+     */
+    std::uint64_t getValueAtPercentile(double percentile) const noexcept;
+
+private:
+    /**
+     * Returns bucket index for a value.
+     * @param value A value.
+     * @return Bucket index.
+     */
+    static std::size_t getBucketIndex(std::uint64_t value) noexcept
+    {
+        if (value < kExactValueCount) return static_cast<std::size_t>(value);
+        const unsigned msb = 63 - __builtin_clzll(value);
+        const unsigned shift = msb - kSubBucketBits;
+        const auto subBucket = static_cast<std::size_t>(value >> shift) - kSubBucketCount;
+        return kExactValueCount + (shift - 1) * kSubBucketCount + subBucket;
+    }
+
+    /**
+     * Returns largest value that belongs to a bucket.
+     * @param index Bucket index.
+     * @return Largest value in the bucket.
+     */
+    static std::uint64_t getBucketUpperBound(std::size_t index) noexcept;
+
+private:
+    /** Number of sub-buckets in each power of two range, as bits */
+    static constexpr unsigned kSubBucketBits = 6;
+
+    /** Number of sub-buckets in each power of two range */
+    static constexpr std::size_t kSubBucketCount = std::size_t(1) << kSubBucketBits;
+
+    /** Number of values recorded exactly */
+    static constexpr std::size_t kExactValueCount = kSubBucketCount * 2;
+
+    /** Total number of buckets */
+    static constexpr std::size_t kBucketCount =
+            kExactValueCount + (63 - kSubBucketBits) * kSubBucketCount;
+
+    /** Value counters */
+    std::array<std::uint64_t, kBucketCount> m_buckets;
+
+    /** Number of recorded values */
+    std::uint64_t m_count;
+
+    /** Sum of recorded values */
+    std::uint64_t m_sum;
+
+    /** Minimum recorded value */
+    std::uint64_t m_min;
+
+    /** Maximum recorded value */
+    std::uint64_t m_max;
+};
+
+}  // namespace siodb::siobench
@@ -0,0 +1,234 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "Siobench.h"
+
+// Project headers
+#include "Siocli.h"
+#include "WorkloadDriver.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbDefs.h>
+#include <siodb/common/config/SiodbVersion.h>
+#include <siodb/common/net/NetConstants.h>
+#include <siodb/common/options/SiodbOptions.h>
+#include <siodb/common/utils/CheckOSUser.h>
+#include <siodb/common/utils/DebugMacros.h>
+#include <siodb/common/utils/StartupActions.h>
+
+// STL headers
+#include <fstream>
+#include <iostream>
+
+// System headers
+#include <signal.h>
+
+// Boost headers
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+namespace {
+const std::string kDefaultIdentityFile = siodb::utils::getHomeDir() + "/.ssh/id_rsa";
+constexpr const char* kDefaultDatabaseName = "SIOBENCH";
+constexpr const char* kDefaultTableName = "WORKLOAD";
+}  // namespace
+
+extern "C" int siobenchMain(int argc, char** argv)
+{
+    // Must be called very first!
+    siodb::utils::performCommonStartupActions();
+
+    DEBUG_SYSCALLS_LIBRARY_GUARD;
+
+    try {
+        // Declare options
+        boost::program_options::options_description desc("Options");
+        desc.add_options()("host,H",
+                boost::program_options::value<std::string>()->default_value(siodb::net::kLocalhost),
+                "Server host name or IP address");
+        desc.add_options()("port,p",
+                boost::program_options::value<int>()->default_value(
+                        siodb::config::kDefaultIpv4PortNumber),
+                "Server SQL port");
+        desc.add_options()("rest-port,R",
+                boost::program_options::value<int>()->default_value(
+                        siodb::config::kDefaultIOManagerIpv4RestPortNumber),
+                "IO Manager REST protocol port");
+        desc.add_options()("user,u",
+                boost::program_options::value<std::string>()->default_value("root"), "User name");
+        desc.add_options()("identity-file,i",
+                boost::program_options::value<std::string>()->default_value(kDefaultIdentityFile),
+                "Identity file (client private key)");
+        desc.add_options()("token,T",
+                boost::program_options::value<std::string>()->default_value(""),
+                "User token for REST requests (takes precendece over token file)");
+        desc.add_options()("token-file,F",
+                boost::program_options::value<std::string>()->default_value(""),
+                "User token file for REST requests");
+        desc.add_options()("verify-certificates,V", "Verify certificates");
+        desc.add_options()("plaintext,P", "Use plaintext SQL connections");
+        desc.add_options()("database,D",
+                boost::program_options::value<std::string>()->default_value(kDefaultDatabaseName),
+                "Benchmark database name");
+        desc.add_options()("table",
+                boost::program_options::value<std::string>()->default_value(kDefaultTableName),
+                "Benchmark table name");
+        desc.add_options()("cipher",
+                boost::program_options::value<std::string>()->default_value(""),
+                "Benchmark database cipher (server default if not specified)");
+        desc.add_options()("no-setup",
+                "Use existing database and table, don't drop, create and load them");
+        desc.add_options()("rows,r",
+                boost::program_options::value<std::uint64_t>()->default_value(10000),
+                "Number of rows to load, or number of existing rows with --no-setup");
+        desc.add_options()("sessions,s",
+                boost::program_options::value<std::size_t>()->default_value(4),
+                "Number of concurrent sessions");
+        desc.add_options()("warm-up,w", boost::program_options::value<unsigned>()->default_value(5),
+                "Warm-up time in seconds");
+        desc.add_options()("duration,t",
+                boost::program_options::value<unsigned>()->default_value(30),
+                "Measurement time in seconds");
+        desc.add_options()("mix,m",
+                boost::program_options::value<std::string>()->default_value(
+                        siodb::siobench::kDefaultWorkloadMix),
+                "Workload mix: comma separated list of <operation>=<weight>");
+        desc.add_options()("batch-size,b",
+                boost::program_options::value<unsigned>()->default_value(10),
+                "Number of rows in single insert batch or REST POST request");
+        desc.add_options()("range-length,l",
+                boost::program_options::value<unsigned>()->default_value(100),
+                "Number of rows requested by range scan");
+        desc.add_options()("text-length",
+                boost::program_options::value<std::size_t>()->default_value(32),
+                "Length of generated text values");
+        desc.add_options()("seed",
+                boost::program_options::value<std::uint64_t>()->default_value(1), "Random seed");
+        desc.add_options()("output,o",
+                boost::program_options::value<std::string>()->default_value(""),
+                "JSON report file (standard output if not specified)");
+        desc.add_options()("help,h", "Print help message");
+        desc.add_options()("nologo", "Do not print logo");
+        desc.add_options()("debug,d", "Print debug messages");
+
+        // Parse options
+        boost::program_options::variables_map vm;
+        boost::program_options::store(
+                boost::program_options::parse_command_line(argc, argv, desc), vm);
+        boost::program_options::notify(vm);
+
+        // Handle help options
+        if (vm.count("help") > 0) {
+            siodb::siobench::printLogo();
+            std::cout << '\n' << desc << std::endl;
+            return 0;
+        }
+
+        // Handle options
+        siodb::siobench::WorkloadParameters params;
+        params.m_host = vm["host"].as<std::string>();
+        params.m_sqlPort = vm["port"].as<int>();
+        params.m_restPort = vm["rest-port"].as<int>();
+        params.m_user = vm["user"].as<std::string>();
+        params.m_encryption = vm.count("plaintext") == 0;
+        params.m_verifyCertificates = vm.count("verify-certificates") > 0;
+        params.m_database = boost::to_upper_copy(vm["database"].as<std::string>());
+        params.m_table = boost::to_upper_copy(vm["table"].as<std::string>());
+        params.m_cipherId = vm["cipher"].as<std::string>();
+        params.m_setup = vm.count("no-setup") == 0;
+        params.m_initialRowCount = vm["rows"].as<std::uint64_t>();
+        params.m_sessionCount = vm["sessions"].as<std::size_t>();
+        params.m_warmUpTime = std::chrono::seconds(vm["warm-up"].as<unsigned>());
+        params.m_duration = std::chrono::seconds(vm["duration"].as<unsigned>());
+        params.m_mix = siodb::siobench::parseWorkloadMix(vm["mix"].as<std::string>());
+        params.m_batchSize = vm["batch-size"].as<unsigned>();
+        params.m_rangeLength = vm["range-length"].as<unsigned>();
+        params.m_textLength = vm["text-length"].as<std::size_t>();
+        params.m_seed = vm["seed"].as<std::uint64_t>();
+        params.m_outputFile = vm["output"].as<std::string>();
+        params.m_printDebugMessages = vm.count("debug") > 0;
+
+        if (params.m_sessionCount == 0) throw std::invalid_argument("Invalid number of sessions");
+        if (params.m_duration.count() == 0) throw std::invalid_argument("Invalid duration");
+        if (params.m_batchSize == 0) throw std::invalid_argument("Invalid batch size");
+        if (params.m_rangeLength == 0) throw std::invalid_argument("Invalid range length");
+
+        params.m_identityKey = siodb::sql_client::loadUserIdentityKey(
+                vm["identity-file"].as<std::string>().c_str());
+
+        if (siodb::siobench::isRestRequired(params.m_mix)) {
+            params.m_token = vm["token"].as<std::string>();
+            if (params.m_token.empty()) {
+                const auto tokenFile = vm["token-file"].as<std::string>();
+                if (tokenFile.empty()) {
+                    throw std::invalid_argument(
+                            "REST operations require user token or token file");
+                }
+                std::ifstream ifs(tokenFile);
+                if (!ifs.is_open()) throw std::runtime_error("Can't open token file " + tokenFile);
+                if (!std::getline(ifs, params.m_token))
+                    throw std::runtime_error("Can't read token from file " + tokenFile);
+            }
+        }
+
+        // Ignore SIGPIPE
+        signal(SIGPIPE, SIG_IGN);
+
+        // Print logo, progress goes to stderr to keep report on stdout clean
+        if (vm.count("nologo") == 0) siodb::siobench::printLogo();
+
+        return siodb::siobench::runWorkload(params, std::cerr);
+    } catch (std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << '.' << std::endl;
+        return 2;
+    }
+}
+
+namespace siodb::siobench {
+
+void printLogo()
+{
+    std::cerr << "Siodb Workload Benchmark v." << SIODB_VERSION_MAJOR << '.' << SIODB_VERSION_MINOR
+              << '.' << SIODB_VERSION_PATCH
+#ifdef _DEBUG
+              << " (debug build)"
+#endif
+              << "\nCompiled on " << __DATE__ << ' ' << __TIME__ << "\nCopyright (C) "
+              << SIODB_COPYRIGHT_YEARS << " Siodb GmbH. All rights reserved." << std::endl;
+}
+
+int runWorkload(const WorkloadParameters& params, std::ostream& os)
+{
+    // Open output file first to avoid losing results of the long run
+    std::ofstream ofs;
+    if (!params.m_outputFile.empty()) {
+        ofs.open(params.m_outputFile);
+        if (!ofs.is_open()) {
+            std::cerr << "Can't open output file '" << params.m_outputFile << "'" << std::endl;
+            return 2;
+        }
+    }
+
+    WorkloadDriver driver(params);
+    if (params.m_setup) driver.setup(os);
+    driver.run(os);
+
+    const auto report = driver.makeReport();
+    std::ostream& out = params.m_outputFile.empty() ? std::cout : ofs;
+    out << report.dump(4) << std::endl;
+    if (!params.m_outputFile.empty()) {
+        os << "Report saved to " << params.m_outputFile << std::endl;
+        if (!ofs) {
+            std::cerr << "Can't write output file '" << params.m_outputFile << "'" << std::endl;
+            return 2;
+        }
+    }
+
+    const auto& total = report["total"];
+    return total["operations"].get<std::uint64_t>() > 0 ? 0 : 3;
+}
+
+}  // namespace siodb::siobench
@@ -0,0 +1,26 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "Workload.h"
+
+// STL headers
+#include <ostream>
+
+namespace siodb::siobench {
+
+/** Prints logo. */
+void printLogo();
+
+/**
+ * Sets up and runs workload, writes JSON report.
+ * @param params Workload parameters.
+ * @param os Progress output stream.
+ * @return Exit code.
+ */
+int runWorkload(const WorkloadParameters& params, std::ostream& os);
+
+}  // namespace siodb::siobench
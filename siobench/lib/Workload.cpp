@@ -0,0 +1,88 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "Workload.h"
+
+// Common project headers
+#include <siodb/common/stl_ext/sstream_ext.h>
+
+// STL headers
+#include <stdexcept>
+#include <vector>
+
+// Boost headers
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+namespace siodb::siobench {
+
+namespace {
+
+constexpr std::array<const char*, kOperationTypeCount> kOperationTypeNames {
+        "point_select",
+        "range_scan",
+        "insert_batch",
+        "update_by_id",
+        "rest_post",
+        "rest_get",
+};
+
+}  // anonymous namespace
+
+const char* getOperationTypeName(OperationType operationType) noexcept
+{
+    const auto index = static_cast<std::size_t>(operationType);
+    return index < kOperationTypeCount ? kOperationTypeNames[index] : "unknown";
+}
+
+WorkloadMix parseWorkloadMix(const std::string& spec)
+{
+    WorkloadMix mix {};
+    std::vector<std::string> items;
+    boost::split(items, spec, boost::is_any_of(","));
+    for (auto& item : items) {
+        boost::trim(item);
+        if (item.empty()) continue;
+        const auto pos = item.find('=');
+        if (pos == std::string::npos) {
+            throw std::invalid_argument(
+                    stdext::concat("Invalid workload mix item '", item, "': missing weight"));
+        }
+        const auto name = boost::trim_copy(item.substr(0, pos));
+        const auto weightStr = boost::trim_copy(item.substr(pos + 1));
+        std::size_t index = 0;
+        while (index < kOperationTypeCount && name != kOperationTypeNames[index])
+            ++index;
+        if (index == kOperationTypeCount) {
+            throw std::invalid_argument(
+                    stdext::concat("Invalid workload mix item '", item, "': unknown operation"));
+        }
+        std::size_t end = 0;
+        unsigned long weight = 0;
+        try {
+            weight = std::stoul(weightStr, &end);
+        } catch (std::exception&) {
+            end = 0;
+        }
+        if (end == 0 || end != weightStr.length() || weight > 1000000) {
+            throw std::invalid_argument(
+                    stdext::concat("Invalid workload mix item '", item, "': invalid weight"));
+        }
+        mix[index] = static_cast<unsigned>(weight);
+    }
+
+    for (const auto weight : mix) {
+        if (weight > 0) return mix;
+    }
+    throw std::invalid_argument("Workload mix is empty");
+}
+
+bool isRestRequired(const WorkloadMix& mix) noexcept
+{
+    return mix[static_cast<std::size_t>(OperationType::kRestPost)] > 0
+           || mix[static_cast<std::size_t>(OperationType::kRestGet)] > 0;
+}
+
+}  // namespace siodb::siobench
@@ -0,0 +1,133 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// CRT headers
+#include <cstdint>
+
+// STL headers
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace siodb::siobench {
+
+/** Workload operation types */
+enum class OperationType {
+    kPointSelect,
+    kRangeScan,
+    kInsertBatch,
+    kUpdateById,
+    kRestPost,
+    kRestGet,
+    kMax
+};
+
+/** Number of operation types */
+constexpr std::size_t kOperationTypeCount = static_cast<std::size_t>(OperationType::kMax);
+
+/** Operation weights, indexed by operation type */
+using WorkloadMix = std::array<unsigned, kOperationTypeCount>;
+
+/** Default workload mix specification */
+constexpr const char* kDefaultWorkloadMix =
+        "point_select=50,range_scan=10,insert_batch=10,update_by_id=20,rest_post=5,rest_get=5";
+
+/**
+ * Returns operation type name as used in the workload mix specification and report.
+ * @param operationType Operation type.
+ * @return Operation type name.
+ */
+const char* getOperationTypeName(OperationType operationType) noexcept;
+
+/**
+ * Parses workload mix specification in the form "name=weight,name=weight,...".
+ * Operation types not mentioned in the specification get zero weight.
+ * @param spec Workload mix specification.
+ * @return Operation weights.
+ * @throw std::invalid_argument if specification is invalid or all weights are zero.
+ */
+WorkloadMix parseWorkloadMix(const std::string& spec);
+
+/**
+ * Returns true if workload mix contains REST operations.
+ * @param mix Workload mix.
+ * @return true if REST connection is required, false otherwise.
+ */
+bool isRestRequired(const WorkloadMix& mix) noexcept;
+
+/** Workload parameters */
+struct WorkloadParameters {
+    /** Server host name or IP address */
+    std::string m_host;
+
+    /** SQL protocol port */
+    int m_sqlPort = 0;
+
+    /** IO Manager REST protocol port */
+    int m_restPort = 0;
+
+    /** User name */
+    std::string m_user;
+
+    /** User identity key, used for SQL connections */
+    std::string m_identityKey;
+
+    /** User token, used for REST requests */
+    std::string m_token;
+
+    /** Indicates that SQL connections are encrypted */
+    bool m_encryption = true;
+
+    /** Indicates that server certificates should be verified */
+    bool m_verifyCertificates = false;
+
+    /** Benchmark database name */
+    std::string m_database;
+
+    /** Benchmark table name */
+    std::string m_table;
+
+    /** Benchmark database cipher, empty string means server default */
+    std::string m_cipherId;
+
+    /** Indicates that database and table should be created and populated before run */
+    bool m_setup = true;
+
+    /** Number of rows loaded during setup, or existing number of rows if setup skipped */
+    std::uint64_t m_initialRowCount = 0;
+
+    /** Number of concurrent sessions */
+    std::size_t m_sessionCount = 1;
+
+    /** Warm-up time, operations executed during warm-up are not recorded */
+    std::chrono::seconds m_warmUpTime {0};
+
+    /** Measurement time */
+    std::chrono::seconds m_duration {0};
+
+    /** Operation weights */
+    WorkloadMix m_mix {};
+
+    /** Number of rows in single INSERT statement or REST POST request */
+    unsigned m_batchSize = 1;
+
+    /** Number of rows requested by range scan */
+    unsigned m_rangeLength = 1;
+
+    /** Length of generated text values */
+    std::size_t m_textLength = 0;
+
+    /** Random seed, each session uses seed + session index */
+    std::uint64_t m_seed = 0;
+
+    /** Report output file, empty string means standard output */
+    std::string m_outputFile;
+
+    /** Indicates that debug messages should be printed out */
+    bool m_printDebugMessages = false;
+};
+
+}  // namespace siodb::siobench
@@ -0,0 +1,157 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "WorkloadDriver.h"
+
+// Common project headers
+#include <siodb/common/config/SiodbVersion.h>
+#include <siodb/common/stl_ext/sstream_ext.h>
+
+// STL headers
+#include <iostream>
+#include <thread>
+
+namespace siodb::siobench {
+
+namespace {
+
+/** Reported percentiles */
+constexpr std::array<std::pair<const char*, double>, 5> kReportedPercentiles {
+        std::make_pair("p50", 50.0),
+        std::make_pair("p90", 90.0),
+        std::make_pair("p99", 99.0),
+        std::make_pair("p999", 99.9),
+        std::make_pair("p9999", 99.99),
+};
+
+/** Number of rows in single INSERT statement during setup */
+constexpr unsigned kSetupBatchSize = 1000;
+
+double toMicroseconds(double nanoseconds) noexcept
+{
+    return nanoseconds / 1000.0;
+}
+
+}  // anonymous namespace
+
+WorkloadDriver::WorkloadDriver(const WorkloadParameters& params)
+    : m_params(params)
+    , m_rowCount(params.m_setup ? 0 : params.m_initialRowCount)
+    , m_measuredSeconds(0.0)
+{
+}
+
+void WorkloadDriver::setup(std::ostream& os)
+{
+    WorkloadSession session(m_params, 0, m_rowCount);
+
+    os << "Creating database " << m_params.m_database << "..." << std::endl;
+    session.executeSql("DROP DATABASE IF EXISTS " + m_params.m_database);
+    if (m_params.m_cipherId.empty())
+        session.executeSql("CREATE DATABASE " + m_params.m_database);
+    else {
+        session.executeSql(stdext::concat("CREATE DATABASE ", m_params.m_database,
+                " WITH CIPHER_ID = '", m_params.m_cipherId, '\''));
+    }
+    session.executeSql(stdext::concat("CREATE TABLE ", m_params.m_database, '.',
+            m_params.m_table, " (K BIGINT, V TEXT, N DOUBLE)"));
+    m_rowCount = 0;
+
+    os << "Loading " << m_params.m_initialRowCount << " rows..." << std::endl;
+    while (m_rowCount < m_params.m_initialRowCount) {
+        const auto remaining = m_params.m_initialRowCount - m_rowCount;
+        session.insertRows(static_cast<unsigned>(
+                std::min(remaining, static_cast<std::uint64_t>(kSetupBatchSize))));
+    }
+}
+
+void WorkloadDriver::run(std::ostream& os)
+{
+    // Connect all sessions before start, so that connection time is not measured
+    os << "Connecting " << m_params.m_sessionCount << " sessions..." << std::endl;
+    m_sessions.clear();
+    m_sessions.reserve(m_params.m_sessionCount);
+    for (std::size_t i = 0; i < m_params.m_sessionCount; ++i)
+        m_sessions.push_back(std::make_unique<WorkloadSession>(m_params, i, m_rowCount));
+
+    os << "Running workload: warm-up " << m_params.m_warmUpTime.count() << " s, measurement "
+       << m_params.m_duration.count() << " s..." << std::endl;
+    const auto startTime = WorkloadSession::Clock::now();
+    const auto measurementStartTime = startTime + m_params.m_warmUpTime;
+    const auto stopTime = measurementStartTime + m_params.m_duration;
+
+    std::vector<std::thread> threads;
+    threads.reserve(m_sessions.size());
+    for (auto& session : m_sessions) {
+        threads.emplace_back([&session, measurementStartTime, stopTime] {
+            session->run(measurementStartTime, stopTime);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    // Operations started before stop time are allowed to complete
+    const auto endTime = WorkloadSession::Clock::now();
+    m_measuredSeconds = std::chrono::duration<double>(endTime - measurementStartTime).count();
+}
+
+nlohmann::json WorkloadDriver::makeReport() const
+{
+    nlohmann::json report;
+    report["siodb_version"] = stdext::concat(
+            SIODB_VERSION_MAJOR, '.', SIODB_VERSION_MINOR, '.', SIODB_VERSION_PATCH);
+    report["host"] = m_params.m_host;
+    report["sessions"] = m_params.m_sessionCount;
+    report["warm_up_sec"] = m_params.m_warmUpTime.count();
+    report["duration_sec"] = m_measuredSeconds;
+    report["batch_size"] = m_params.m_batchSize;
+    report["range_length"] = m_params.m_rangeLength;
+    report["text_length"] = m_params.m_textLength;
+    report["final_row_count"] = m_rowCount.load();
+
+    LatencyHistogram totalHistogram;
+    std::uint64_t totalErrorCount = 0;
+    auto& mix = report["mix"];
+    auto& operations = report["operations"];
+    for (std::size_t i = 0; i < kOperationTypeCount; ++i) {
+        const auto operationType = static_cast<OperationType>(i);
+        const auto name = getOperationTypeName(operationType);
+        mix[name] = m_params.m_mix[i];
+        if (m_params.m_mix[i] == 0) continue;
+        LatencyHistogram histogram;
+        std::uint64_t errorCount = 0;
+        for (const auto& session : m_sessions) {
+            histogram.merge(session->getLatencyHistogram(operationType));
+            errorCount += session->getErrorCount(operationType);
+        }
+        operations[name] = makeOperationReport(histogram, errorCount);
+        totalHistogram.merge(histogram);
+        totalErrorCount += errorCount;
+    }
+    report["total"] = makeOperationReport(totalHistogram, totalErrorCount);
+    return report;
+}
+
+// --- internals ---
+
+nlohmann::json WorkloadDriver::makeOperationReport(
+        const LatencyHistogram& histogram, std::uint64_t errorCount) const
+{
+    nlohmann::json report;
+    report["operations"] = histogram.getCount();
+    report["errors"] = errorCount;
+    report["throughput_ops"] =
+            m_measuredSeconds > 0.0 ? histogram.getCount() / m_measuredSeconds : 0.0;
+    auto& latency = report["latency_us"];
+    latency["min"] = toMicroseconds(histogram.getMin());
+    latency["mean"] = toMicroseconds(histogram.getMean());
+    for (const auto& percentile : kReportedPercentiles) {
+        latency[percentile.first] =
+                toMicroseconds(histogram.getValueAtPercentile(percentile.second));
+    }
+    latency["max"] = toMicroseconds(histogram.getMax());
+    return report;
+}
+
+}  // namespace siodb::siobench
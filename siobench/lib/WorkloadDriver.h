@@ -0,0 +1,77 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "WorkloadSession.h"
+
+// STL headers
+#include <vector>
+
+// JSON library
+#include <nlohmann/json.hpp>
+
+namespace siodb::siobench {
+
+/**
+ * Runs workload with a number of concurrent sessions against a Siodb instance
+ * and summarizes throughput and latency of each operation type.
+ */
+class WorkloadDriver {
+public:
+    /**
+     * Initializes object of class WorkloadDriver.
+     * @param params Workload parameters.
+     */
+    explicit WorkloadDriver(const WorkloadParameters& params);
+
+    DECLARE_NONCOPYABLE(WorkloadDriver);
+
+    /**
+     * Creates benchmark database and table and loads initial rows.
+     * Existing benchmark database is dropped.
+     * @param os Progress output stream.
+     * @throw std::runtime_error if setup fails.
+     */
+    void setup(std::ostream& os);
+
+    /**
+     * Connects all sessions and runs workload for warm-up time and measurement time.
+     * @param os Progress output stream.
+     * @throw std::runtime_error if sessions can't be connected.
+     */
+    void run(std::ostream& os);
+
+    /**
+     * Makes report of the last run.
+     * @return Report as JSON object.
+     */
+    nlohmann::json makeReport() const;
+
+private:
+    /**
+     * Makes report of the single operation type, or of all types.
+     * @param histogram Latency histogram, in nanoseconds.
+     * @param errorCount Number of failed operations.
+     * @return Report as JSON object.
+     */
+    nlohmann::json makeOperationReport(
+            const LatencyHistogram& histogram, std::uint64_t errorCount) const;
+
+private:
+    /** Workload parameters */
+    const WorkloadParameters& m_params;
+
+    /** Current number of rows in the benchmark table */
+    std::atomic<std::uint64_t> m_rowCount;
+
+    /** Sessions of the last run */
+    std::vector<std::unique_ptr<WorkloadSession>> m_sessions;
+
+    /** Actual measurement time of the last run in seconds */
+    double m_measuredSeconds;
+};
+
+}  // namespace siodb::siobench
@@ -0,0 +1,219 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#include "WorkloadSession.h"
+
+// Project headers
+#include "Restcli.h"
+#include "SqlClient.h"
+
+// Common project headers
+#include <siodb/common/crypto/OpenSslError.h>
+#include <siodb/common/io/FDStream.h>
+#include <siodb/common/net/TcpConnection.h>
+#include <siodb/common/stl_ext/sstream_ext.h>
+
+// STL headers
+#include <iostream>
+#include <sstream>
+
+namespace siodb::siobench {
+
+namespace {
+
+constexpr const char kTextAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+}  // anonymous namespace
+
+WorkloadSession::WorkloadSession(const WorkloadParameters& params, std::size_t sessionIndex,
+        std::atomic<std::uint64_t>& rowCount)
+    : m_params(params)
+    , m_tableName(params.m_database + '.' + params.m_table)
+    , m_rowCount(rowCount)
+    , m_random(params.m_seed + sessionIndex)
+    , m_operationDistribution(params.m_mix.cbegin(), params.m_mix.cend())
+    , m_requestId(1)
+    , m_nullStream(nullptr)
+    , m_errorCounts {}
+{
+    connectSql();
+    if (isRestRequired(params.m_mix)) connectRest();
+}
+
+void WorkloadSession::executeSql(std::string&& commandText)
+{
+    if (!m_sqlConnection) connectSql();
+    if (m_params.m_printDebugMessages) std::clog << "debug: SQL: " << commandText << std::endl;
+    sql_client::executeCommandOnServer(m_requestId++, std::move(commandText), *m_sqlConnection,
+            m_nullStream, true, false);
+}
+
+void WorkloadSession::insertRows(unsigned rowCount)
+{
+    executeSql(makeInsertStatement(rowCount));
+    m_rowCount.fetch_add(rowCount, std::memory_order_relaxed);
+}
+
+void WorkloadSession::run(Clock::time_point measurementStartTime, Clock::time_point stopTime)
+{
+    while (true) {
+        const auto operationType = static_cast<OperationType>(m_operationDistribution(m_random));
+        const auto startTime = Clock::now();
+        if (startTime >= stopTime) break;
+        const bool succeeded = executeOperation(operationType);
+        if (startTime < measurementStartTime) continue;
+        const auto index = static_cast<std::size_t>(operationType);
+        if (succeeded) {
+            const auto latency = Clock::now() - startTime;
+            m_latencyHistograms[index].record(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+        } else
+            ++m_errorCounts[index];
+    }
+}
+
+// --- internals ---
+
+bool WorkloadSession::executeOperation(OperationType operationType) noexcept
+{
+    try {
+        switch (operationType) {
+            case OperationType::kPointSelect: {
+                executeSql(stdext::concat(
+                        "SELECT * FROM ", m_tableName, " WHERE TRID = ", getRandomTrid()));
+                break;
+            }
+            case OperationType::kRangeScan: {
+                const auto trid = getRandomTrid();
+                executeSql(stdext::concat("SELECT * FROM ", m_tableName, " WHERE TRID >= ", trid,
+                        " AND TRID < ", trid + m_params.m_rangeLength));
+                break;
+            }
+            case OperationType::kInsertBatch: {
+                insertRows(m_params.m_batchSize);
+                break;
+            }
+            case OperationType::kUpdateById: {
+                const auto trid = getRandomTrid();
+                executeSql(stdext::concat("UPDATE ", m_tableName, " SET N = ",
+                        std::generate_canonical<double, 53>(m_random), ", V = '", makeText(),
+                        "' WHERE TRID = ", trid));
+                break;
+            }
+            case OperationType::kRestPost: {
+                executeRest("POST", 0, makeJsonRows(m_params.m_batchSize));
+                m_rowCount.fetch_add(m_params.m_batchSize, std::memory_order_relaxed);
+                break;
+            }
+            case OperationType::kRestGet: {
+                executeRest("GET", getRandomTrid(), std::string());
+                break;
+            }
+            default: throw std::invalid_argument("Invalid operation type");
+        }
+        return true;
+    } catch (std::exception& ex) {
+        if (m_params.m_printDebugMessages) {
+            std::clog << "debug: " << getOperationTypeName(operationType)
+                      << " failed: " << ex.what() << std::endl;
+        }
+        // Connection state is unknown after error
+        m_sqlConnection.reset();
+        m_restConnection.reset();
+        return false;
+    }
+}
+
+void WorkloadSession::executeRest(const char* method, std::uint64_t objectId, std::string&& payload)
+{
+    if (!m_restConnection) connectRest();
+    rest_client::RestClientParameters params;
+    params.m_requestId = m_requestId++;
+    params.m_method = method;
+    params.m_objectType = "ROW";
+    params.m_objectName = m_tableName;
+    params.m_objectId = objectId;
+    params.m_user = m_params.m_user;
+    params.m_token = m_params.m_token;
+    params.m_payload = std::move(payload);
+    if (rest_client::executeRestRequest(params, *m_restConnection, m_nullStream) != 0)
+        throw std::runtime_error("REST request failed");
+}
+
+void WorkloadSession::connectSql()
+{
+    const auto fd = net::openTcpConnection(m_params.m_host, m_params.m_sqlPort);
+    if (m_params.m_encryption) {
+        if (!m_tlsClient) {
+            m_tlsClient = std::make_unique<crypto::TlsClient>();
+            if (m_params.m_verifyCertificates) m_tlsClient->enableCertificateVerification();
+        }
+        auto tlsConnection = m_tlsClient->connectToServer(fd);
+        const auto x509Certificate = ::SSL_get_peer_certificate(tlsConnection->getSsl());
+        if (x509Certificate == nullptr)
+            throw crypto::OpenSslError("SSL_get_peer_certificate failed");
+        ::X509_free(x509Certificate);
+        m_sqlConnection = std::move(tlsConnection);
+    } else
+        m_sqlConnection = std::make_unique<io::FDStream>(fd, true);
+
+    sql_client::ServerConnectionInfo serverConnectionInfo;
+    try {
+        sql_client::authenticate(
+                m_params.m_identityKey, m_params.m_user, *m_sqlConnection, serverConnectionInfo);
+    } catch (...) {
+        m_sqlConnection.reset();
+        throw;
+    }
+}
+
+void WorkloadSession::connectRest()
+{
+    const auto fd = net::openTcpConnection(m_params.m_host, m_params.m_restPort);
+    m_restConnection = std::make_unique<io::FDStream>(fd, true);
+}
+
+std::uint64_t WorkloadSession::getRandomTrid()
+{
+    const auto rowCount = std::max(m_rowCount.load(std::memory_order_relaxed),
+            static_cast<std::uint64_t>(1));
+    return std::uniform_int_distribution<std::uint64_t>(1, rowCount)(m_random);
+}
+
+std::string WorkloadSession::makeText()
+{
+    std::uniform_int_distribution<std::size_t> distribution(0, sizeof(kTextAlphabet) - 2);
+    std::string text(m_params.m_textLength, ' ');
+    for (auto& c : text)
+        c = kTextAlphabet[distribution(m_random)];
+    return text;
+}
+
+std::string WorkloadSession::makeInsertStatement(unsigned rowCount)
+{
+    std::ostringstream oss;
+    oss << "INSERT INTO " << m_tableName << " (K, V, N) VALUES ";
+    for (unsigned i = 0; i < rowCount; ++i) {
+        if (i > 0) oss << ", ";
+        oss << '(' << static_cast<std::int64_t>(m_random()) << ", '" << makeText() << "', "
+            << std::generate_canonical<double, 53>(m_random) << ')';
+    }
+    return oss.str();
+}
+
+std::string WorkloadSession::makeJsonRows(unsigned rowCount)
+{
+    std::ostringstream oss;
+    oss << '[';
+    for (unsigned i = 0; i < rowCount; ++i) {
+        if (i > 0) oss << ',';
+        oss << "{\"K\":" << static_cast<std::int64_t>(m_random()) << ",\"V\":\"" << makeText()
+            << "\",\"N\":" << std::generate_canonical<double, 53>(m_random) << '}';
+    }
+    oss << ']';
+    return oss.str();
+}
+
+}  // namespace siodb::siobench
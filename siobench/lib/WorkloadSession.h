@@ -0,0 +1,178 @@
+// Copyright (C) 2021 Siodb GmbH. All rights reserved.
+// Use of this source code is governed by a license that can be found
+// in the LICENSE file.
+
+#pragma once
+
+// Project headers
+#include "LatencyHistogram.h"
+#include "Workload.h"
+
+// Common project headers
+#include <siodb/common/crypto/TlsClient.h>
+#include <siodb/common/io/InputOutputStream.h>
+#include <siodb/common/utils/HelperMacros.h>
+
+// STL headers
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <random>
+
+namespace siodb::siobench {
+
+/**
+ * Single client session of the workload. Owns SQL connection and, if needed,
+ * REST connection, and executes randomly selected operations over them.
+ * Not thread-safe, each session is driven by its own thread.
+ */
+class WorkloadSession {
+public:
+    /** Clock used for latency measurements */
+    using Clock = std::chrono::steady_clock;
+
+public:
+    /**
+     * Initializes object of class WorkloadSession. Establishes connections.
+     * @param params Workload parameters.
+     * @param sessionIndex Session index.
+     * @param rowCount Current number of rows in the benchmark table, shared between sessions.
+     * @throw std::system_error if connection can't be established.
+     * @throw std::runtime_error if authentication fails.
+     */
+    WorkloadSession(const WorkloadParameters& params, std::size_t sessionIndex,
+            std::atomic<std::uint64_t>& rowCount);
+
+    DECLARE_NONCOPYABLE(WorkloadSession);
+
+    /**
+     * Executes SQL command, stops on error.
+     * @param commandText Command text.
+     * @throw std::runtime_error if command fails.
+     */
+    void executeSql(std::string&& commandText);
+
+    /**
+     * Inserts batch of generated rows using SQL connection.
+     * @param rowCount Number of rows.
+     * @throw std::runtime_error if insert fails.
+     */
+    void insertRows(unsigned rowCount);
+
+    /**
+     * Executes randomly selected operations until stop time is reached.
+     * Only operations started after measurement start time are recorded.
+     * @param measurementStartTime Measurement start time.
+     * @param stopTime Stop time.
+     */
+    void run(Clock::time_point measurementStartTime, Clock::time_point stopTime);
+
+    /**
+     * Returns latency histogram of successfully completed operations, in nanoseconds.
+     * @param operationType Operation type.
+     * @return Latency histogram.
+     */
+    const LatencyHistogram& getLatencyHistogram(OperationType operationType) const noexcept
+    {
+        return m_latencyHistograms[static_cast<std::size_t>(operationType)];
+    }
+
+    /**
+     * Returns number of failed operations.
+     * @param operationType Operation type.
+     * @return Number of failed operations.
+     */
+    std::uint64_t getErrorCount(OperationType operationType) const noexcept
+    {
+        return m_errorCounts[static_cast<std::size_t>(operationType)];
+    }
+
+private:
+    /**
+     * Executes single operation. Drops connections on error,
+     * so that they are re-established by the next operation.
+     * @param operationType Operation type.
+     * @return true if operation succeeded, false otherwise.
+     */
+    bool executeOperation(OperationType operationType) noexcept;
+
+    /**
+     * Executes REST request.
+     * @param method Request method.
+     * @param objectId Object identifier or zero.
+     * @param payload Request payload.
+     * @throw std::runtime_error if request fails.
+     */
+    void executeRest(const char* method, std::uint64_t objectId, std::string&& payload);
+
+    /** Establishes SQL connection and authenticates user. */
+    void connectSql();
+
+    /** Establishes REST connection. */
+    void connectRest();
+
+    /**
+     * Returns random TRID of existing row.
+     * @return TRID.
+     */
+    std::uint64_t getRandomTrid();
+
+    /**
+     * Generates random text value.
+     * @return Text value.
+     */
+    std::string makeText();
+
+    /**
+     * Generates SQL INSERT statement for given number of rows.
+     * @param rowCount Number of rows.
+     * @return INSERT statement text.
+     */
+    std::string makeInsertStatement(unsigned rowCount);
+
+    /**
+     * Generates JSON payload for the REST POST request.
+     * @param rowCount Number of rows.
+     * @return JSON text.
+     */
+    std::string makeJsonRows(unsigned rowCount);
+
+private:
+    /** Workload parameters */
+    const WorkloadParameters& m_params;
+
+    /** Fully qualified table name */
+    const std::string m_tableName;
+
+    /** Current number of rows in the benchmark table */
+    std::atomic<std::uint64_t>& m_rowCount;
+
+    /** Random number generator */
+    std::mt19937_64 m_random;
+
+    /** Operation type distribution */
+    std::discrete_distribution<std::size_t> m_operationDistribution;
+
+    /** TLS client */
+    std::unique_ptr<crypto::TlsClient> m_tlsClient;
+
+    /** SQL connection */
+    std::unique_ptr<io::InputOutputStream> m_sqlConnection;
+
+    /** REST connection */
+    std::unique_ptr<io::InputOutputStream> m_restConnection;
+
+    /** Next request ID */
+    std::uint64_t m_requestId;
+
+    /** Stream which swallows query output */
+    std::ostream m_nullStream;
+
+    /** Latency histograms, indexed by operation type */
+    std::array<LatencyHistogram, kOperationTypeCount> m_latencyHistograms;
+
+    /** Error counters, indexed by operation type */
+    std::array<std::uint64_t, kOperationTypeCount> m_errorCounts;
+};
+
+}  // namespace siodb::siobench
@@ -47,8 +47,10 @@
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 // System headers
+#include <fcntl.h>
 #include <signal.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -122,6 +124,8 @@ extern "C" int siocliMain(int argc, char** argv)
         desc.add_options()("export-all,E", "Export all databases");
         desc.add_options()("output-file,o", boost::program_options::value<std::string>(),
                 "Output file for the exported data");
+        desc.add_options()("data-file,F", boost::program_options::value<std::string>(),
+                "Data file for COPY ... FROM STDIN commands");
         desc.add_options()("use-readline,r", "Use readline library for console input");
         desc.add_options()("help,h", "Print help message");
         desc.add_options()("nologo", "Do not print logo");
@@ -178,6 +182,7 @@ extern "C" int siocliMain(int argc, char** argv)
         params.m_verifyCertificates = vm.count("verify-certificates") > 0;
         if (vm.count("output-file") > 0) params.m_outputFile = vm["output-file"].as<std::string>();
         params.m_useReadline = vm.count("use-readline") > 0;
+        if (vm.count("data-file") > 0) params.m_dataFile = vm["data-file"].as<std::string>();
         params.m_noLogo = vm.count("nologo") > 0;
         params.m_printDebugMessages = vm.count("debug") > 0;
 
@@ -414,8 +419,28 @@ int commandPrompt(const ClientParameters& params)
 
             // Execute command
             if (!command->empty()) {
+                // Open COPY data source, if required
+                std::unique_ptr<siodb::io::FDStream> requestData;
+                if (isCopyFromStdinCommand(*command)) {
+                    if (!params.m_dataFile.empty()) {
+                        siodb::FDGuard fd(::open(params.m_dataFile.c_str(), O_RDONLY));
+                        if (!fd.isValidFd()) {
+                            stdext::throw_system_error(
+                                    "Can't open data file " + params.m_dataFile);
+                        }
+                        requestData = std::make_unique<siodb::io::FDStream>(fd.release(), true);
+                    } else if (singleCommand && !params.m_stdinIsTerminal) {
+                        requestData = std::make_unique<siodb::io::FDStream>(::fileno(stdin));
+                    } else {
+                        throw std::runtime_error(
+                                "COPY FROM STDIN requires data file or piped standard input "
+                                "with the single command");
+                    }
+                }
+
                 executeCommandOnServer(requestId++, std::move(*command), *connection, std::cout,
-                        singleCommand ? true : params.m_exitOnError, params.m_printDebugMessages);
+                        singleCommand ? true : params.m_exitOnError, params.m_printDebugMessages,
+                        requestData.get());
             }
         } catch (std::exception& ex) {
             std::cerr << "\nError: " << ex.what() << '.' << std::endl;
@@ -541,6 +566,21 @@ std::string loadUserIdentityKey(const char* path)
     return key;
 }
 
+bool isCopyFromStdinCommand(const std::string& command)
+{
+    std::vector<std::string> words;
+    boost::split(words, command, boost::is_any_of(" \t\r\n"), boost::token_compress_on);
+    words.erase(std::remove(words.begin(), words.end(), std::string()), words.end());
+    if (words.empty() || !boost::iequals(words.front(), "COPY")) return false;
+    for (std::size_t i = 1; i + 1 < words.size(); ++i) {
+        if (boost::iequals(words[i], "FROM")
+                && boost::istarts_with(words[i + 1], "STDIN")
+                && (words[i + 1].length() == 5 || words[i + 1][5] == kSqlDelimiter))
+            return true;
+    }
+    return false;
+}
+
 SingleWordCommandType decodeSingleWordCommand(const std::string& command) noexcept
 {
     if (command == "exit" || command == "quit")
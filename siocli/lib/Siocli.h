@@ -59,6 +59,9 @@ struct ClientParameters {
 
     /** Indicates that readline should be used for reading commands */
     bool m_useReadline = false;
+
+    /** Data file for the COPY ... FROM STDIN commands */
+    std::string m_dataFile;
 };
 
 /** Prints logo. */
@@ -85,6 +88,14 @@ int exportSqlDump(const ClientParameters& params);
  */
 std::string loadUserIdentityKey(const char* path);
 
+/**
+ * Checks if command is COPY ... FROM STDIN command, which requires data to be sent
+ * to the server after the command.
+ * @param command Command text.
+ * @return true if command requires data to be sent, false otherwise.
+ */
+bool isCopyFromStdinCommand(const std::string& command);
+
 /** Single word command types */
 enum class SingleWordCommandType {
     kUnknownCommand,
@@ -10,6 +10,7 @@
 #include <siodb/common/crt_ext/ct_string.h>
 #include <siodb/common/crypto/DigitalSignatureKey.h>
 #include <siodb/common/data/RawDateTime.h>
+#include <siodb/common/io/BufferedChunkedOutputStream.h>
 #include <siodb/common/io/FileIO.h>
 #include <siodb/common/io/StreamFormatGuard.h>
 #include <siodb/common/protobuf/ProtobufMessageIO.h>
@@ -42,7 +43,7 @@ namespace siodb::sql_client {
 
 void executeCommandOnServer(std::uint64_t requestId, std::string&& commandText,
         io::InputOutputStream& connection, std::ostream& os, bool stopOnError,
-        bool printDebugMessages)
+        bool printDebugMessages, io::InputStream* requestData)
 {
     auto startTime = std::chrono::steady_clock::now();
     // Send command to server as protobuf message
@@ -50,8 +51,24 @@ void executeCommandOnServer(std::uint64_t requestId, std::string&& commandText,
     client_protocol::Command command;
     command.set_request_id(requestId);
     command.set_text(std::move(commandText));
+    command.set_data_follows(requestData != nullptr);
     protobuf::writeMessage(protobuf::ProtocolMessageType::kCommand, command, connection);
 
+    // Send request data as chunked stream
+    if (requestData) {
+        if (printDebugMessages) std::clog << "debug: Sending request data to server" << std::endl;
+        io::BufferedChunkedOutputStream chunkedOutput(detail::kRequestDataChunkSize, connection);
+        stdext::buffer<std::uint8_t> buffer(detail::kRequestDataChunkSize);
+        while (true) {
+            const auto n = requestData->read(buffer.data(), buffer.size());
+            if (n == 0) break;
+            if (n < 0) stdext::throw_system_error("Request data read error");
+            if (chunkedOutput.write(buffer.data(), n) != n)
+                stdext::throw_system_error("Request data send error");
+        }
+        if (chunkedOutput.close() != 0) stdext::throw_system_error("Request data send error");
+    }
+
     std::size_t responseId = 0, responseCount = 0;
     do {
         // Read server response
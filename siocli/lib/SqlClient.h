@@ -24,13 +24,14 @@ namespace siodb::sql_client {
  * @param os Output stream.
  * @param stopOnError Indicates that execution should stop on SQL error.
  * @param printDebugMessages Indicates that debug messages should be outputted.
+ * @param requestData Data stream to be sent to the server after the command or nullptr.
  * @throw std::system_error if I/O errors happened.
  * @throw std::runtime_error if protocol error happened.
  * @throw std::runtime_error if @ref stopOnError is true and SQL error happened.
  */
 void executeCommandOnServer(std::uint64_t requestId, std::string&& commandText,
         io::InputOutputStream& connection, std::ostream& os, bool stopOnError,
-        bool printDebugMessages);
+        bool printDebugMessages, io::InputStream* requestData = nullptr);
 
 // Server connectioninformation
 struct ServerConnectionInfo {
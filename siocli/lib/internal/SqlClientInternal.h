@@ -49,6 +49,9 @@ constexpr std::size_t kUuidDefaultDataWidth = 32;
 // Read buffer size
 constexpr std::size_t kLobReadBufferSize = 4096;
 
+// Request data chunk size
+constexpr std::size_t kRequestDataChunkSize = 0x10000;
+
 /**
  * Returns column data width in characters for give data type and column name length.
  * @param type Column type.
@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+
+set -e
+
+if [[ $# == 0 ]]; then
+    echo "Usage: $0 NEW_VERSION"
+    exit 1
+fi
+
+_new_version=$1
+_current_version=$(ls | grep -E '^benchmark-.*\.tar\.xz$' | sed -e 's/^benchmark-//' -e 's/\.tar\.xz$//')
+
+echo "Current version is ${_current_version}"
+
+if [[ "$_current_version" == "$_new_version" ]]; then
+    echo "Already up-to-date."
+    exit 0
+fi
+
+# Downloads
+_dir=benchmark-${_new_version}
+if [[ -d ${_dir} ]]; then rm -rf ${_dir}; fi
+git clone https://github.com/google/benchmark ${_dir}
+cd ${_dir}
+git checkout v${_new_version}
+cp -f LICENSE ../LICENSE-${_new_version}.txt
+rm -rf .git
+cd ..
+tar cvf ${_dir}.tar ${_dir}
+xz -v9e ${_dir}.tar
+rm -rf ${_dir}
+
+# Remove old files
+if [[ -n "$_current_version" ]]; then
+    rm benchmark-${_current_version}.tar.xz
+    rm LICENSE-${_current_version}.txt
+fi
+
+# git
+git add .
+git commit -m "Update Google Benchmark to version ${_new_version}"
@@ -42,6 +42,7 @@ export SIODB_TP_ROOT=/opt/siodb/lib
 export SIODB_ANTLR4_PREFIX=${SIODB_TP_ROOT}/antlr-${SIODB_ANTLR4_VERSION}
 export SIODB_ANTLR4_CPP_RUNTIME_PREFIX=${SIODB_TP_ROOT}/antlr4-cpp-runtime-${SIODB_ANTLR4_CPP_RUNTIME_VERSION}
 export SIODB_LIBDATE_PREFIX=${SIODB_TP_ROOT}/date-${SIODB_LIBDATE_VERSION}
+export SIODB_GBENCHMARK_PREFIX=${SIODB_TP_ROOT}/benchmark-${SIODB_GBENCHMARK_VERSION}
 export SIODB_GTEST_PREFIX=${SIODB_TP_ROOT}/googletest-${SIODB_GTEST_VERSION}
 export SIODB_JSON_PREFIX=${SIODB_TP_ROOT}/json-${SIODB_JSON_VERSION}
 export SIODB_OPENSSL_PREFIX=${SIODB_TP_ROOT}/openssl-${SIODB_OPENSSL_VERSION}